@@ -0,0 +1,269 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumAudioEncoder_h__
+#define IndiciumAudioEncoder_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Largest Opus packet of a single frame
+    // 
+#define INDICIUM_AUDIO_PACKET_MAX_SIZE  1275
+
+    //
+    // Packet starts a new stream segment: first packet, or frames before it got lost. Decoders
+    // should be reset, the timeline continues at FirstFrame and Timestamp
+    // 
+#define INDICIUM_AUDIO_PACKET_FLAG_DISCONTINUITY    0x1
+
+    typedef struct _INDICIUM_AUDIO_PACKET
+    {
+        //
+        // Packet number since the encoder got started
+        // 
+        ULONGLONG Sequence;
+
+        //
+        // Mixdown frame index of the first frame in the packet
+        // 
+        ULONGLONG FirstFrame;
+
+        //
+        // Performance counter value at which the first frame got played by the host
+        // 
+        LONGLONG Timestamp;
+
+        //
+        // Frames per channel the packet decodes to
+        // 
+        UINT32 Frames;
+
+        //
+        // Frames per second of the encoded stream
+        // 
+        UINT32 SampleRate;
+
+        //
+        // INDICIUM_AUDIO_PACKET_FLAG_* values
+        // 
+        UINT32 Flags;
+
+        //
+        // Bytes used of Data
+        // 
+        UINT32 Size;
+
+        //
+        // Opus packet of one stereo frame
+        // 
+        BYTE Data[INDICIUM_AUDIO_PACKET_MAX_SIZE];
+
+    } INDICIUM_AUDIO_PACKET, *PINDICIUM_AUDIO_PACKET;
+
+    typedef struct _INDICIUM_AUDIO_ENCODER_CONFIG
+    {
+        //
+        // Duration of a packet in milliseconds, 10 or 20
+        // 
+        UINT32 FrameMs;
+
+        //
+        // Target bits per second
+        // 
+        UINT32 Bitrate;
+
+        //
+        // Encoder complexity from 0 (fastest) to 10 (best quality)
+        // 
+        UINT32 Complexity;
+
+        //
+        // TRUE for the restricted low-delay mode, which drops speech coding for 4 milliseconds
+        // less algorithmic delay
+        // 
+        BOOL LowDelay;
+
+        //
+        // Packets kept for readers; once full the oldest packet gets dropped
+        // 
+        UINT32 QueueCapacity;
+
+    } INDICIUM_AUDIO_ENCODER_CONFIG, *PINDICIUM_AUDIO_ENCODER_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_AUDIO_ENCODER_CONFIG_INIT( _Out_ PINDICIUM_AUDIO_ENCODER_CONFIG Config );
+     *
+     * \brief   Initializes an INDICIUM_AUDIO_ENCODER_CONFIG for low-delay packets of 10
+     *          milliseconds at 128 kbit/s, queueing up to two seconds.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config  The configuration.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_AUDIO_ENCODER_CONFIG_INIT(
+        _Out_ PINDICIUM_AUDIO_ENCODER_CONFIG Config
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_AUDIO_ENCODER_CONFIG));
+
+        Config->FrameMs = 10;
+        Config->Bitrate = 128000;
+        Config->Complexity = 5;
+        Config->LowDelay = TRUE;
+        Config->QueueCapacity = 200;
+    }
+
+    typedef struct _INDICIUM_AUDIO_ENCODER_STATISTICS
+    {
+        //
+        // Packets encoded since the encoder got started
+        // 
+        ULONGLONG Packets;
+
+        //
+        // Bytes of all encoded packets
+        // 
+        ULONGLONG Bytes;
+
+        //
+        // Packets dropped from a full queue
+        // 
+        ULONGLONG DroppedPackets;
+
+        //
+        // Mixed frames lost because the encoder thread fell behind or the mixdown rate changed
+        // to one Opus can't encode
+        // 
+        ULONGLONG DroppedFrames;
+
+        //
+        // Packets flagged INDICIUM_AUDIO_PACKET_FLAG_DISCONTINUITY
+        // 
+        ULONGLONG Discontinuities;
+
+        //
+        // Frames a decoder outputs ahead of the first encoded frame (the Opus pre-skip)
+        // 
+        UINT32 LookaheadFrames;
+
+        //
+        // Encoder thread time per second of encoded audio, 0.01 being 1% of a core
+        // 
+        double EncodeLoad;
+
+    } INDICIUM_AUDIO_ENCODER_STATISTICS, *PINDICIUM_AUDIO_ENCODER_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_AUDIO_ENCODER_CONFIG Config );
+     *
+     * \brief   Encodes the audio mixdown (IndiciumEngineAudioMixStart) into stereo Opus packets on
+     *          a thread of its own. Packets are numbered and carry the mixdown frame index and play
+     *          time of their first frame. Only the Opus rates 8, 12, 16, 24 and 48 kHz get encoded;
+     *          mixdowns at other rates can't be started while the encoder runs.
+     *          Starting again while running restarts the stream with the new configuration.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_AUDIO_ENCODER_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops encoding; packets still queued remain readable.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderRead( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_AUDIO_PACKET Packet, _In_ DWORD TimeoutMs );
+     *
+     * \brief   Takes the oldest queued packet, waiting up to TimeoutMs for one to arrive.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Packet      The packet.
+     * \param           TimeoutMs   Milliseconds to wait, 0 to return immediately.
+     *
+     * \returns INDICIUM_ERROR_WAIT_TIMEOUT if no packet was available, otherwise an INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderRead(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_AUDIO_PACKET Packet,
+        _In_
+        DWORD TimeoutMs
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetAudioEncoderStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_AUDIO_ENCODER_STATISTICS Statistics );
+     *
+     * \brief   Reports the state of the encoder since it got started.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Statistics  The statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetAudioEncoderStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_AUDIO_ENCODER_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumAudioEncoder_h__
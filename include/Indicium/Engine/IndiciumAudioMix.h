@@ -0,0 +1,245 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumAudioMix_h__
+#define IndiciumAudioMix_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Maximum number of render clients mixed at once
+    // 
+#define INDICIUM_AUDIO_MIX_MAX_CLIENTS  16
+
+    typedef struct _INDICIUM_AUDIO_MIX_BLOCK
+    {
+        //
+        // Engine instance the block got mixed by
+        // 
+        PINDICIUM_ENGINE Engine;
+
+        //
+        // Interleaved stereo samples (left, right) in the range -1 to 1
+        // 
+        const float* Samples;
+
+        //
+        // Number of stereo frames in Samples
+        // 
+        UINT32 Frames;
+
+        //
+        // Frames per second of the mixed stream
+        // 
+        UINT32 SampleRate;
+
+        //
+        // Index of the first frame since the mixdown got started
+        // 
+        ULONGLONG FirstFrame;
+
+        //
+        // Performance counter value at which the first frame got played by the host
+        // 
+        LONGLONG Timestamp;
+
+        //
+        // Render clients contributing to this block
+        // 
+        UINT32 ActiveClients;
+
+    } INDICIUM_AUDIO_MIX_BLOCK, *PINDICIUM_AUDIO_MIX_BLOCK;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_AUDIO_MIX)
+        VOID
+        EVT_INDICIUM_AUDIO_MIX(
+            const INDICIUM_AUDIO_MIX_BLOCK* Block,
+            PVOID Context
+        );
+
+    typedef EVT_INDICIUM_AUDIO_MIX *PFN_INDICIUM_AUDIO_MIX;
+
+    typedef struct _INDICIUM_AUDIO_MIX_CONFIG
+    {
+        //
+        // Receives every mixed block on the engine thread; samples are valid during the call only.
+        // May be NULL if the mixdown only feeds the engine's audio encoder
+        // 
+        PFN_INDICIUM_AUDIO_MIX EvtIndiciumAudioMix;
+
+        //
+        // Passed to EvtIndiciumAudioMix
+        // 
+        PVOID Context;
+
+        //
+        // Frames per second of the mixed stream, clients get resampled to it
+        // 
+        UINT32 SampleRate;
+
+        //
+        // Time between a frame being played by the host and being mixed in milliseconds; covers
+        // the uncertainty of the client clocks, blocks are late by at most this plus PeriodMs
+        // 
+        UINT32 LatencyMs;
+
+        //
+        // Interval between mixed blocks in milliseconds
+        // 
+        UINT32 PeriodMs;
+
+    } INDICIUM_AUDIO_MIX_CONFIG, *PINDICIUM_AUDIO_MIX_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_AUDIO_MIX_CONFIG_INIT( _Out_ PINDICIUM_AUDIO_MIX_CONFIG Config, _In_opt_ PFN_INDICIUM_AUDIO_MIX EvtIndiciumAudioMix );
+     *
+     * \brief   Initializes an INDICIUM_AUDIO_MIX_CONFIG mixing to 48 kHz in blocks of 10
+     *          milliseconds, 40 milliseconds behind playback.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config                  The configuration.
+     * \param   EvtIndiciumAudioMix     The block callback, or NULL.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_AUDIO_MIX_CONFIG_INIT(
+        _Out_ PINDICIUM_AUDIO_MIX_CONFIG Config,
+        _In_opt_ PFN_INDICIUM_AUDIO_MIX EvtIndiciumAudioMix
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_AUDIO_MIX_CONFIG));
+
+        Config->EvtIndiciumAudioMix = EvtIndiciumAudioMix;
+        Config->SampleRate = 48000;
+        Config->LatencyMs = 40;
+        Config->PeriodMs = 10;
+    }
+
+    typedef struct _INDICIUM_AUDIO_MIX_STATISTICS
+    {
+        //
+        // Render clients known to the mixer
+        // 
+        UINT32 Clients;
+
+        //
+        // Render clients which contributed to the latest block
+        // 
+        UINT32 ActiveClients;
+
+        //
+        // Frames mixed since the mixdown got started
+        // 
+        ULONGLONG FramesMixed;
+
+        //
+        // Client frames which weren't written yet or got overwritten when needed, mixed as silence
+        // 
+        ULONGLONG UnderrunFrames;
+
+        //
+        // Times a client position jumped instead of being steered, e.g. after a pause
+        // 
+        ULONGLONG Resyncs;
+
+        //
+        // Largest measured deviation of a client clock from its nominal rate in parts per million
+        // 
+        double MaximumDriftPpm;
+
+    } INDICIUM_AUDIO_MIX_STATISTICS, *PINDICIUM_AUDIO_MIX_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioMixStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_AUDIO_MIX_CONFIG Config );
+     *
+     * \brief   Mixes the output of all Audio Render Clients of the host into one stereo float
+     *          stream. Clients get aligned on the performance counter timeline by their buffer
+     *          positions, and deviations of their device clocks get compensated by resampling
+     *          slightly faster or slower. Requires Core Audio hooking; only clients initialized
+     *          after the hooks got applied are known to the mixer. Starting again while running
+     *          restarts the stream with the new configuration.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The configuration.
+     *
+     * \returns An INDICIUM_ERROR. INDICIUM_ERROR_UNSUPPORTED_FORMAT if an audio encoder is running
+     *          and the sample rate isn't one Opus encodes.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioMixStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_AUDIO_MIX_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioMixStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops mixing; no block gets delivered once this returns, unless called from the
+     *          block callback itself.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioMixStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetAudioMixStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_AUDIO_MIX_STATISTICS Statistics );
+     *
+     * \brief   Reports the state of the mixdown since it got started.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Statistics  The statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetAudioMixStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_AUDIO_MIX_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumAudioMix_h__
@@ -0,0 +1,288 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumBenchmark_h__
+#define IndiciumBenchmark_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Distribution of one metric over the measured frames
+    // 
+    typedef struct _INDICIUM_BENCHMARK_METRIC
+    {
+        ULONGLONG Samples;
+
+        DOUBLE Mean;
+
+        DOUBLE StandardDeviation;
+
+        DOUBLE Minimum;
+
+        DOUBLE Median;
+
+        DOUBLE Percentile95;
+
+        DOUBLE Percentile99;
+
+        DOUBLE Maximum;
+
+    } INDICIUM_BENCHMARK_METRIC, *PINDICIUM_BENCHMARK_METRIC;
+
+    //
+    // Outcome of comparing a metric against the stored baseline
+    // 
+    typedef struct _INDICIUM_BENCHMARK_COMPARISON
+    {
+        //
+        // FALSE if no baseline existed for this executable and engine version
+        // 
+        BOOL IsAvailable;
+
+        //
+        // Mean and sample count of the baseline run
+        // 
+        DOUBLE BaselineMean;
+
+        ULONGLONG BaselineSamples;
+
+        //
+        // (Mean - BaselineMean) / BaselineMean
+        // 
+        DOUBLE RelativeChange;
+
+        //
+        // One-sided p-value of Welch's t-test for the mean having increased
+        // 
+        DOUBLE PValue;
+
+        //
+        // TRUE if the increase is both significant and above the configured minimum change
+        // 
+        BOOL IsRegression;
+
+    } INDICIUM_BENCHMARK_COMPARISON, *PINDICIUM_BENCHMARK_COMPARISON;
+
+    typedef struct _INDICIUM_BENCHMARK_REPORT
+    {
+        //
+        // Length of the measured window (after warm-up) in seconds
+        // 
+        DOUBLE DurationSeconds;
+
+        //
+        // Frames excluded from the statistics at the beginning of the run
+        // 
+        ULONGLONG WarmupFrames;
+
+        //
+        // Time between consecutive frame boundaries in milliseconds
+        // 
+        INDICIUM_BENCHMARK_METRIC FrameTime;
+
+        //
+        // Time spent in Pre- and Post-Present callbacks per frame in microseconds
+        // 
+        INDICIUM_BENCHMARK_METRIC CallbackCost;
+
+        struct
+        {
+            //
+            // IAudioRenderClient::ReleaseBuffer calls during the measured window
+            // 
+            ULONGLONG BuffersReleased;
+
+            //
+            // Audio frames handed to the audio engine
+            // 
+            ULONGLONG FramesWritten;
+
+            //
+            // Buffers released with AUDCLNT_BUFFERFLAGS_SILENT
+            // 
+            ULONGLONG SilentBuffers;
+
+            //
+            // Failed ReleaseBuffer calls
+            // 
+            ULONGLONG Failures;
+
+        } Audio;
+
+        INDICIUM_BENCHMARK_COMPARISON FrameTimeComparison;
+
+        INDICIUM_BENCHMARK_COMPARISON CallbackCostComparison;
+
+        //
+        // TRUE if any of the comparisons flagged a regression
+        // 
+        BOOL IsRegression;
+
+        //
+        // Full path of the written report file, empty if writing failed
+        // 
+        CHAR ReportPath[MAX_PATH];
+
+    } INDICIUM_BENCHMARK_REPORT, *PINDICIUM_BENCHMARK_REPORT;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_BENCHMARK_COMPLETED)
+        VOID
+        EVT_INDICIUM_BENCHMARK_COMPLETED(
+            PINDICIUM_ENGINE                    Engine,
+            const INDICIUM_BENCHMARK_REPORT     *Report
+        );
+
+    typedef EVT_INDICIUM_BENCHMARK_COMPLETED *PFN_INDICIUM_BENCHMARK_COMPLETED;
+
+    typedef struct _INDICIUM_BENCHMARK_CONFIG
+    {
+        //
+        // Frames discarded after starting a run, e.g. to skip shader compilation stutter
+        // 
+        UINT32 WarmupFrames;
+
+        //
+        // Virtual key toggling a run from within the game, 0 to disable
+        // 
+        INT HotkeyVirtualKey;
+
+        //
+        // Directory for reports and baselines, NULL for
+        // "%LOCALAPPDATA%\Indicium-Supra\Benchmarks". Environment variables get expanded.
+        // 
+        PCSTR Directory;
+
+        //
+        // Significance level of the regression test
+        // 
+        DOUBLE Significance;
+
+        //
+        // Smallest relative increase of a mean reported as regression
+        // 
+        DOUBLE MinimumRelativeChange;
+
+        //
+        // TRUE to store every completed run as the new baseline, otherwise the baseline is only
+        // written if none exists yet
+        // 
+        BOOL ReplaceBaseline;
+
+        //
+        // Optional, invoked on the stopping thread once the report is written
+        // 
+        PFN_INDICIUM_BENCHMARK_COMPLETED EvtIndiciumBenchmarkCompleted;
+
+    } INDICIUM_BENCHMARK_CONFIG, *PINDICIUM_BENCHMARK_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_BENCHMARK_CONFIG_INIT( PINDICIUM_BENCHMARK_CONFIG Config )
+     *
+     * \brief   Initializes an INDICIUM_BENCHMARK_CONFIG struct.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config  The benchmark configuration.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_BENCHMARK_CONFIG_INIT(
+        PINDICIUM_BENCHMARK_CONFIG Config
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_BENCHMARK_CONFIG));
+
+        Config->WarmupFrames = 120;
+        Config->Significance = 0.01;
+        Config->MinimumRelativeChange = 0.02;
+    }
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkConfigure( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_BENCHMARK_CONFIG Config );
+     *
+     * \brief   Sets up benchmark runs. Required for the hotkey, optional when runs are started
+     *          through the API (defaults apply). Takes effect with the next run.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The benchmark configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkConfigure(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_BENCHMARK_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkStart( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Starts collecting frame time, callback cost and audio statistics.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns INDICIUM_ERROR_BENCHMARK_RUNNING if a run is in progress already.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkStart(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkStop( _In_ PINDICIUM_ENGINE Engine, _Out_opt_ PINDICIUM_BENCHMARK_REPORT Report );
+     *
+     * \brief   Ends the current run, writes the report, compares it against the baseline stored
+     *          for the game executable (by content hash) and engine build version and updates the
+     *          baseline according to the configuration.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine  The engine handle.
+     * \param [out]     Report  If non-null, receives the report.
+     *
+     * \returns INDICIUM_ERROR_BENCHMARK_NOT_RUNNING if no run is in progress.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkStop(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_opt_
+        PINDICIUM_BENCHMARK_REPORT Report
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumBenchmark_h__
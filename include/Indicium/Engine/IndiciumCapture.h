@@ -0,0 +1,391 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef IndiciumCapture_h__
+#define IndiciumCapture_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Maximum number of regions captured per swap chain or device
+    // 
+#define INDICIUM_CAPTURE_MAX_REGIONS    8
+
+    //
+    // Maximum number of frames a region may stay queued on the GPU before it gets read back
+    // 
+#define INDICIUM_CAPTURE_MAX_DEPTH      4
+
+    //
+    // Maximum number of frames a consumer may hold at once
+    // 
+#define INDICIUM_CAPTURE_MAX_OUTSTANDING    32
+
+    //
+    // Opaque handle to a registered capture consumer
+    // 
+    typedef struct _INDICIUM_CAPTURE_CONSUMER *PINDICIUM_CAPTURE_CONSUMER;
+
+    //
+    // Opaque handle to a consumer's reference on a captured frame
+    // 
+    typedef struct _INDICIUM_CAPTURE_FRAME_REFERENCE *PINDICIUM_CAPTURE_FRAME_REFERENCE;
+
+    typedef struct _INDICIUM_CAPTURE_REGION
+    {
+        //
+        // Position and size as fractions of the back buffer dimensions, between 0 and 1; the
+        // region follows the back buffer through ResizeBuffers and Reset
+        // 
+        float Left;
+        float Top;
+        float Width;
+        float Height;
+
+    } INDICIUM_CAPTURE_REGION, *PINDICIUM_CAPTURE_REGION;
+
+    typedef struct _INDICIUM_CAPTURED_FRAME
+    {
+        //
+        // The engine handle
+        // 
+        PINDICIUM_ENGINE Engine;
+
+        //
+        // Swap chain or device the region got captured from
+        // 
+        PVOID Presenter;
+
+        //
+        // Render API of the presenter
+        // 
+        INDICIUM_D3D_VERSION Version;
+
+        //
+        // Index of the region as passed to IndiciumEngineCaptureSetRegions
+        // 
+        UINT32 Region;
+
+        //
+        // Running number of the captured frame per presenter
+        // 
+        ULONGLONG FrameNumber;
+
+        //
+        // Performance counter value taken when the region got copied, right before Present
+        // 
+        LONGLONG Timestamp;
+
+        //
+        // Back buffer dimensions at the time of the copy
+        // 
+        UINT32 BackBufferWidth;
+        UINT32 BackBufferHeight;
+
+        //
+        // Captured pixel rectangle within the back buffer
+        // 
+        UINT32 Left;
+        UINT32 Top;
+        UINT32 Width;
+        UINT32 Height;
+
+        //
+        // DXGI_FORMAT for Direct3D 10/11, D3DFORMAT for Direct3D 9
+        // 
+        UINT32 Format;
+
+        //
+        // Bytes between two rows of Data
+        // 
+        UINT32 Pitch;
+
+        //
+        // Pixels of the region; valid for the duration of EvtIndiciumFrameCaptured, or until a
+        // consumer released its reference
+        // 
+        const BYTE *Data;
+
+    } INDICIUM_CAPTURED_FRAME, *PINDICIUM_CAPTURED_FRAME;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_FRAME_CAPTURED)
+        VOID
+        EVT_INDICIUM_FRAME_CAPTURED(
+            const INDICIUM_CAPTURED_FRAME   *Frame,
+            PVOID                           Context
+        );
+
+    typedef EVT_INDICIUM_FRAME_CAPTURED *PFN_INDICIUM_FRAME_CAPTURED;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_CAPTURE_CONSUMER_FRAME)
+        VOID
+        EVT_INDICIUM_CAPTURE_CONSUMER_FRAME(
+            PINDICIUM_CAPTURE_FRAME_REFERENCE   Reference,
+            const INDICIUM_CAPTURED_FRAME       *Frame,
+            PVOID                               Context
+        );
+
+    typedef EVT_INDICIUM_CAPTURE_CONSUMER_FRAME *PFN_INDICIUM_CAPTURE_CONSUMER_FRAME;
+
+    typedef struct _INDICIUM_CAPTURE_CONSUMER_STATISTICS
+    {
+        //
+        // Frames handed to the consumer
+        // 
+        ULONGLONG FramesDelivered;
+
+        //
+        // Frames skipped because the consumer held its maximum number of frames
+        // 
+        ULONGLONG FramesDropped;
+
+        //
+        // Frames currently held by the consumer
+        // 
+        UINT32 FramesOutstanding;
+
+        //
+        // Time from capture until the consumer released a frame in milliseconds
+        // 
+        double LastLagMs;
+        double AverageLagMs;
+        double MaximumLagMs;
+
+    } INDICIUM_CAPTURE_CONSUMER_STATISTICS, *PINDICIUM_CAPTURE_CONSUMER_STATISTICS;
+
+    typedef struct _INDICIUM_CAPTURE_CONFIG
+    {
+        //
+        // Invoked on the render thread for every region read back from the GPU, optional; the
+        // pixels are passed straight from the mapped staging resource without a copy
+        // 
+        PFN_INDICIUM_FRAME_CAPTURED EvtIndiciumFrameCaptured;
+
+        //
+        // Caller context passed to the callback
+        // 
+        PVOID Context;
+
+        //
+        // Capture every n-th frame, 0 or 1 for every frame
+        // 
+        UINT32 IntervalFrames;
+
+        //
+        // Copies in flight per region, up to INDICIUM_CAPTURE_MAX_DEPTH; deeper rings tolerate
+        // slower GPUs at the cost of delivering frames later
+        // 
+        UINT32 Depth;
+
+    } INDICIUM_CAPTURE_CONFIG, *PINDICIUM_CAPTURE_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_CAPTURE_CONFIG_INIT( _Out_ PINDICIUM_CAPTURE_CONFIG Config, _In_opt_ PFN_INDICIUM_FRAME_CAPTURED EvtIndiciumFrameCaptured, _In_opt_ PVOID Context );
+     *
+     * \brief   Initializes an INDICIUM_CAPTURE_CONFIG capturing every frame with three copies in
+     *          flight per region.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config                      The configuration.
+     * \param   EvtIndiciumFrameCaptured    The capture callback, NULL if only consumers get the frames.
+     * \param   Context                     The caller context.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_CAPTURE_CONFIG_INIT(
+        _Out_ PINDICIUM_CAPTURE_CONFIG Config,
+        _In_opt_ PFN_INDICIUM_FRAME_CAPTURED EvtIndiciumFrameCaptured,
+        _In_opt_ PVOID Context
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_CAPTURE_CONFIG));
+
+        Config->EvtIndiciumFrameCaptured = EvtIndiciumFrameCaptured;
+        Config->Context = Context;
+        Config->IntervalFrames = 1;
+        Config->Depth = 3;
+    }
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_CAPTURE_CONFIG Config );
+     *
+     * \brief   Starts capturing the configured regions of every Direct3D 9Ex, 10 and 11 presenter.
+     *          Regions get copied on the GPU right before Present and read back once the copy
+     *          completed, so only the requested pixels are transferred and the render thread
+     *          never waits for the GPU. Nothing gets copied while there is neither a callback
+     *          nor a consumer.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_CAPTURE_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops capturing; GPU resources get released at the next Present.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureSetRegions( _In_ PINDICIUM_ENGINE Engine, _In_opt_ PVOID Presenter, _In_opt_ const INDICIUM_CAPTURE_REGION* Regions, _In_ SIZE_T Count );
+     *
+     * \brief   Sets the regions captured from a swap chain or device. Presenters without regions
+     *          of their own use those set for a NULL presenter, or the whole back buffer.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine      The engine handle.
+     * \param   Presenter   The swap chain or device, NULL for the default.
+     * \param   Regions     The regions, NULL to remove those set before.
+     * \param   Count       Number of elements in Regions, up to INDICIUM_CAPTURE_MAX_REGIONS.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureSetRegions(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_opt_
+        PVOID Presenter,
+        _In_opt_
+        const INDICIUM_CAPTURE_REGION* Regions,
+        _In_
+        SIZE_T Count
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureAddConsumer( _In_ PINDICIUM_ENGINE Engine, _In_ PFN_INDICIUM_CAPTURE_CONSUMER_FRAME EvtIndiciumCaptureConsumerFrame, _In_opt_ PVOID Context, _In_ UINT32 MaxOutstanding, _Out_ PINDICIUM_CAPTURE_CONSUMER* Consumer );
+     *
+     * \brief   Registers a consumer of captured frames. Every region read back gets copied once
+     *          into a pooled buffer, each consumer receives its own reference to it on the render
+     *          thread and may keep it beyond the callback, e.g. to process it on another thread.
+     *          Buffers get recycled once every consumer released its reference.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine                          The engine handle.
+     * \param           EvtIndiciumCaptureConsumerFrame The frame callback.
+     * \param           Context                         Caller context passed to the callback.
+     * \param           MaxOutstanding                  Frames the consumer may hold before further
+     *                                                  ones get dropped for it, 1 up to
+     *                                                  INDICIUM_CAPTURE_MAX_OUTSTANDING.
+     * \param [out]     Consumer                        The consumer handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureAddConsumer(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PFN_INDICIUM_CAPTURE_CONSUMER_FRAME EvtIndiciumCaptureConsumerFrame,
+        _In_opt_
+        PVOID Context,
+        _In_
+        UINT32 MaxOutstanding,
+        _Out_
+        PINDICIUM_CAPTURE_CONSUMER* Consumer
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureRemoveConsumer( _In_ PINDICIUM_CAPTURE_CONSUMER Consumer );
+     *
+     * \brief   Removes a consumer; its callback isn't invoked anymore once this returns. Frames
+     *          it still holds remain valid until released.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Consumer    The consumer handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureRemoveConsumer(
+        _In_
+        PINDICIUM_CAPTURE_CONSUMER Consumer
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureReleaseFrame( _In_ PINDICIUM_CAPTURE_FRAME_REFERENCE Reference );
+     *
+     * \brief   Releases a consumer's reference on a captured frame; may be called from any thread.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Reference   The reference passed to the consumer callback.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureReleaseFrame(
+        _In_
+        PINDICIUM_CAPTURE_FRAME_REFERENCE Reference
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetCaptureConsumerStatistics( _In_ PINDICIUM_CAPTURE_CONSUMER Consumer, _Out_ PINDICIUM_CAPTURE_CONSUMER_STATISTICS Statistics );
+     *
+     * \brief   Reports how far a consumer lags behind the capture.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Consumer    The consumer handle.
+     * \param [out]     Statistics  The consumer statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetCaptureConsumerStatistics(
+        _In_
+        PINDICIUM_CAPTURE_CONSUMER Consumer,
+        _Out_
+        PINDICIUM_CAPTURE_CONSUMER_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumCapture_h__
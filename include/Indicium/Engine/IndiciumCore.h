@@ -52,6 +52,25 @@ extern "C" {
         INDICIUM_ERROR_REFERENCE_INCREMENT_FAILED = 0xE0000006,
         INDICIUM_ERROR_CONTEXT_ALLOCATION_FAILED = 0xE0000007,
 		INDICIUM_ERROR_CREATE_EVENT_FAILED = 0xE0000008,
+        INDICIUM_ERROR_INVALID_PARAMETER = 0xE0000009,
+        INDICIUM_ERROR_ALLOCATION_FAILED = 0xE000000A,
+        INDICIUM_ERROR_BUS_TOPIC_MISMATCH = 0xE000000B,
+        INDICIUM_ERROR_BUS_TOPIC_FULL = 0xE000000C,
+        INDICIUM_ERROR_WAIT_TIMEOUT = 0xE000000D,
+        INDICIUM_ERROR_BENCHMARK_RUNNING = 0xE000000E,
+        INDICIUM_ERROR_BENCHMARK_NOT_RUNNING = 0xE000000F,
+        INDICIUM_ERROR_BUFFER_TOO_SMALL = 0xE0000010,
+        INDICIUM_ERROR_SHARED_MEMORY_FAILED = 0xE0000011,
+        INDICIUM_ERROR_UNSUPPORTED_FORMAT = 0xE0000012,
+        INDICIUM_ERROR_FILE_WRITE_FAILED = 0xE0000013,
+        INDICIUM_ERROR_CORE_AUDIO_NOT_HOOKED = 0xE0000014,
+        INDICIUM_ERROR_ENCODER_FAILED = 0xE0000015,
+        INDICIUM_ERROR_RAW_INPUT_NOT_HOOKED = 0xE0000016,
+        INDICIUM_ERROR_XINPUT_NOT_HOOKED = 0xE0000017,
+        INDICIUM_ERROR_INPUT_REPLAY_BUSY = 0xE0000018,
+        INDICIUM_ERROR_FILE_READ_FAILED = 0xE0000019,
+        INDICIUM_ERROR_ALLOCATOR_IN_USE = 0xE000001A,
+        INDICIUM_ERROR_ENGINE_NOT_READY = 0xE000001B,
 
     } INDICIUM_ERROR;
 
@@ -76,6 +95,7 @@ extern "C" {
     typedef struct _INDICIUM_D3D11_EVENT_CALLBACKS *PINDICIUM_D3D11_EVENT_CALLBACKS;
     typedef struct _INDICIUM_D3D12_EVENT_CALLBACKS *PINDICIUM_D3D12_EVENT_CALLBACKS;
     typedef struct _INDICIUM_ARC_EVENT_CALLBACKS *PINDICIUM_ARC_EVENT_CALLBACKS;
+    typedef struct _INDICIUM_ARC_BATCH_CONFIG *PINDICIUM_ARC_BATCH_CONFIG;
 
     typedef struct _INDICIUM_EVT_PRE_EXTENSION
     {
@@ -187,6 +207,108 @@ extern "C" {
 
     typedef EVT_INDICIUM_GAME_EXIT *PFN_INDICIUM_GAME_EXIT;
 
+    //
+    // Engine subsystem an allocation is accounted to (see IndiciumMemory.h)
+    // 
+    typedef enum _INDICIUM_MEMORY_TAG
+    {
+        //
+        // Engine instance, hooks and everything not attributed to a subsystem below
+        // 
+        IndiciumMemoryTagEngine = 0,
+
+        //
+        // Custom contexts of the engine and of plugins
+        // 
+        IndiciumMemoryTagContext,
+
+        IndiciumMemoryTagLogging,
+
+        //
+        // Counters, frame overhead, CPU attribution, display tracking and benchmarks
+        // 
+        IndiciumMemoryTagStatistics,
+
+        IndiciumMemoryTagEventBus,
+
+        IndiciumMemoryTagPlugins,
+
+        //
+        // Worker pool and Post-Present tasks
+        // 
+        IndiciumMemoryTagTasks,
+
+        IndiciumMemoryTagPacing,
+
+        //
+        // Frame capture, shared frames and PNG encoding
+        // 
+        IndiciumMemoryTagCapture,
+
+        //
+        // Core Audio batching, mixdown and encoding
+        // 
+        IndiciumMemoryTagAudio,
+
+        //
+        // Raw input, XInput and input replay
+        // 
+        IndiciumMemoryTagInput,
+
+        //
+        // Replacement shader bytecode and the shader manifest
+        // 
+        IndiciumMemoryTagShaders,
+
+        IndiciumMemoryTagCount
+
+    } INDICIUM_MEMORY_TAG;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_ALLOCATE)
+        PVOID
+        EVT_INDICIUM_ALLOCATE(
+            SIZE_T Size,
+            SIZE_T Alignment,
+            INDICIUM_MEMORY_TAG Tag,
+            PVOID UserData
+        );
+
+    typedef EVT_INDICIUM_ALLOCATE *PFN_INDICIUM_ALLOCATE;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_FREE)
+        VOID
+        EVT_INDICIUM_FREE(
+            PVOID Block,
+            SIZE_T Size,
+            SIZE_T Alignment,
+            INDICIUM_MEMORY_TAG Tag,
+            PVOID UserData
+        );
+
+    typedef EVT_INDICIUM_FREE *PFN_INDICIUM_FREE;
+
+    typedef struct _INDICIUM_ALLOCATOR
+    {
+        //
+        // Returns Size bytes aligned to Alignment (a power of two, at least 16) or NULL.
+        // Called from any thread, including the game's render and input threads.
+        // 
+        PFN_INDICIUM_ALLOCATE EvtIndiciumAllocate;
+
+        //
+        // Releases a block returned by EvtIndiciumAllocate, gets the same Size, Alignment and Tag
+        // 
+        PFN_INDICIUM_FREE EvtIndiciumFree;
+
+        //
+        // Passed to both callbacks
+        // 
+        PVOID UserData;
+
+    } INDICIUM_ALLOCATOR, *PINDICIUM_ALLOCATOR;
+
     typedef struct _INDICIUM_ENGINE_CONFIG
     {
         //
@@ -256,6 +378,72 @@ extern "C" {
 
         } Logging;
 
+        struct
+        {
+            //
+            // TRUE to load plugin DLLs and dispatch events to them (see IndiciumPlugin.h)
+            // 
+            BOOL IsEnabled;
+
+            //
+            // Directory to load plugins from, NULL for the "Plugins" sub-directory next to the
+            // host library. Environment variables get expanded.
+            // 
+            PCSTR Directory;
+
+        } PluginHost;
+
+        struct
+        {
+            //
+            // Enables hooking GetRawInputData and GetRawInputBuffer (see IndiciumRawInput.h)
+            // 
+            BOOL HookRawInput;
+
+            //
+            // Enables hooking XInputGetState and XInputSetState of the XInput DLL the host loads, also
+            // when it gets loaded after engine start (see IndiciumXInput.h)
+            // 
+            BOOL HookXInput;
+
+        } Input;
+
+        //
+        // Serves every allocation of the engine library (the engine instance, subsystems,
+        // containers, logging, zlib and Opus) once the engine is created. Both callbacks NULL
+        // keeps the process heap. The allocator is shared by all engines of the process.
+        // 
+        INDICIUM_ALLOCATOR Allocator;
+
+        struct
+        {
+            //
+            // Enables hooking ID3D11Device::CreateVertexShader, CreatePixelShader and
+            // CreateComputeShader. Shaders are identified by the 16-byte checksum of their DXBC
+            // container, written as 32 lowercase hex digits; a file <hash>.cso in Directory
+            // gets created instead of the shader with that hash.
+            // 
+            BOOL HookDirect3D11;
+
+            //
+            // Directory holding replacement bytecode, NULL for the "Shaders" sub-directory next
+            // to the host library. Environment variables get expanded.
+            // 
+            PCSTR Directory;
+
+            //
+            // TRUE to list every distinct shader created in manifest.txt in Directory
+            // 
+            BOOL WriteManifest;
+
+            //
+            // TRUE to save the original bytecode of every distinct shader as <hash>.cso in the
+            // Dump sub-directory of Directory, ready to be edited and moved up
+            // 
+            BOOL DumpBytecode;
+
+        } Shaders;
+
     } INDICIUM_ENGINE_CONFIG, *PINDICIUM_ENGINE_CONFIG;
 
     /**
@@ -315,7 +503,8 @@ extern "C" {
      *
      * \param   HostInstance    The host instance.
      *
-     * \returns An INDICIUM_ERROR.
+     * \returns An INDICIUM_ERROR. INDICIUM_ERROR_WAIT_TIMEOUT if the engine thread didn't finish
+     *          within three seconds; resources stay allocated then, as hooks may still use them.
      */
     INDICIUM_API INDICIUM_ERROR IndiciumEngineDestroy(
         _In_ HMODULE HostInstance
@@ -381,6 +570,64 @@ extern "C" {
         PINDICIUM_ENGINE Engine
     );
 
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineWaitForReady( _In_ PINDICIUM_ENGINE Engine, _In_ DWORD Milliseconds );
+     *
+     * \brief   Blocks until the engine thread has finished probing and hooking the render
+     *          pipelines, so devices created afterwards are guaranteed to be intercepted. Returns
+     *          immediately when called on the engine thread itself (e.g. from code running while
+     *          the engine creates its probing devices).
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine          The engine handle.
+     * \param   Milliseconds    Timeout in milliseconds, INFINITE to wait without limit.
+     *
+     * \returns INDICIUM_ERROR_NONE once ready, INDICIUM_ERROR_ENGINE_NOT_READY right away if the
+     *          engine thread ended or shut down instead, INDICIUM_ERROR_WAIT_TIMEOUT otherwise.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineWaitForReady(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        DWORD Milliseconds
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineSuspend( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Bypasses the engine without removing any hooks. Present and EndScene hooks check
+     *          a single flag and call the original right away, so no engine work, callbacks or
+     *          plugins run per frame. Resize and reset callbacks keep firing so overlays can
+     *          release their back buffer references. Takes effect with the next frame.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineSuspend(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineResume( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Resumes dispatch after IndiciumEngineSuspend, starting with the next frame.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineResume(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
 #ifndef INDICIUM_NO_D3D9
 
     /**
@@ -486,6 +733,31 @@ extern "C" {
         PINDICIUM_ARC_EVENT_CALLBACKS Callbacks
     );
 
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineSetARCBatchConfig( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_ARC_BATCH_CONFIG Config );
+     *
+     * \brief   Enables batched delivery of Audio Render Client events. Instead of (or in addition
+     *          to) the per-buffer callbacks, the audio thread appends a compact record per call to
+     *          a lock-free buffer owned by the render client which gets handed to the batch
+     *          callback as a whole on the next Present or periodically on the engine thread.
+     *          Records which don't fit into a full buffer are dropped and accounted for. The
+     *          buffer capacity is fixed by the first call, subsequent calls only update callback
+     *          and delivery settings.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The batch configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineSetARCBatchConfig(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_ARC_BATCH_CONFIG Config
+    );
+
 #endif
 
     /**
@@ -568,6 +840,86 @@ extern "C" {
         ...
     );
 
+    typedef enum _INDICIUM_LOG_LEVEL
+    {
+        IndiciumLogLevelDebug,
+        IndiciumLogLevelInfo,
+        IndiciumLogLevelWarning,
+        IndiciumLogLevelError
+
+    } INDICIUM_LOG_LEVEL;
+
+    //
+    // Per-callsite logging limits, usually a function-local static (see INDICIUM_LOG_RATELIMITED)
+    // 
+    typedef struct _INDICIUM_LOG_CALLSITE
+    {
+        //
+        // Messages per second passing on average, 0 disables rate limiting
+        // 
+        UINT32 RatePerSecond;
+
+        //
+        // Messages passing in a burst before the rate applies, at least one
+        // 
+        UINT32 Burst;
+
+        //
+        // Only every n-th call (counted per thread) is considered, 0 or 1 for every call
+        // 
+        UINT32 SampleEvery;
+
+        //
+        // Engine-managed token bucket state, must be zero-initialized
+        // 
+        volatile LONG64 Bucket;
+
+        //
+        // Engine-managed count of calls dropped since the last logged one
+        // 
+        volatile LONG64 Suppressed;
+
+    } INDICIUM_LOG_CALLSITE, *PINDICIUM_LOG_CALLSITE;
+
+#define INDICIUM_LOG_CALLSITE_INIT(_rate_, _burst_, _sample_)   { (_rate_), (_burst_), (_sample_), 0, 0 }
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumEngineLogRateLimited( _In_ PINDICIUM_LOG_CALLSITE Callsite, _In_ INDICIUM_LOG_LEVEL Level, _In_ LPCSTR Format, _In_opt_ ... );
+     *
+     * \brief   Logs a message unless the callsite exceeded its sampling or rate limits. Dropped
+     *          calls return before the message gets formatted and are reported as a count with
+     *          the next message passing. Meant for paths running at frame rate.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Callsite    The callsite limits and state.
+     * \param   Level       The log level.
+     * \param   Format      Describes the format to use.
+     * \param   ...         The ...
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumEngineLogRateLimited(
+        _In_
+        PINDICIUM_LOG_CALLSITE Callsite,
+        _In_
+        INDICIUM_LOG_LEVEL Level,
+        _In_
+        LPCSTR Format,
+        _In_opt_
+        ...
+    );
+
+//
+// Logs at most _rate_ messages per second (bursts of _burst_) from the expanding callsite,
+// considering only every _sample_-th call
+//
+#define INDICIUM_LOG_RATELIMITED(_level_, _rate_, _burst_, _sample_, _format_, ...) \
+    do { \
+        static INDICIUM_LOG_CALLSITE _indicium_callsite_ = INDICIUM_LOG_CALLSITE_INIT(_rate_, _burst_, _sample_); \
+        IndiciumEngineLogRateLimited(&_indicium_callsite_, _level_, _format_, ##__VA_ARGS__); \
+    } while (0)
+
 #ifdef __cplusplus
 }
 #endif
@@ -95,4 +95,127 @@ VOID FORCEINLINE INDICIUM_ARC_EVENT_CALLBACKS_INIT(
     ZeroMemory(Callbacks, sizeof(INDICIUM_ARC_EVENT_CALLBACKS));
 }
 
+typedef enum _INDICIUM_ARC_EVENT_TYPE
+{
+    //
+    // IAudioRenderClient::GetBuffer has returned
+    // 
+    IndiciumARCEventGetBuffer = 0,
+
+    //
+    // IAudioRenderClient::ReleaseBuffer has returned
+    // 
+    IndiciumARCEventReleaseBuffer = 1
+
+} INDICIUM_ARC_EVENT_TYPE;
+
+//
+// Compact record of a single Audio Render Client call, queued by the audio thread
+// 
+typedef struct _INDICIUM_ARC_EVENT_RECORD
+{
+    //
+    // Render client instance the call was issued on
+    // 
+    IAudioRenderClient      *Client;
+
+    //
+    // QueryPerformanceCounter value at call completion
+    // 
+    LONGLONG                Timestamp;
+
+    //
+    // Frames requested (GetBuffer) or written (ReleaseBuffer)
+    // 
+    UINT32                  NumFrames;
+
+    //
+    // dwFlags passed to ReleaseBuffer, zero for GetBuffer
+    // 
+    DWORD                   Flags;
+
+    //
+    // Result returned by the native call
+    // 
+    HRESULT                 Result;
+
+    INDICIUM_ARC_EVENT_TYPE Type;
+
+} INDICIUM_ARC_EVENT_RECORD, *PINDICIUM_ARC_EVENT_RECORD;
+
+typedef
+_Function_class_(EVT_INDICIUM_ARC_EVENT_BATCH)
+VOID
+EVT_INDICIUM_ARC_EVENT_BATCH(
+    const INDICIUM_ARC_EVENT_RECORD *Records,
+    SIZE_T                          Count,
+    ULONGLONG                       DroppedRecords,
+    PINDICIUM_EVT_POST_EXTENSION    Extension
+);
+
+typedef EVT_INDICIUM_ARC_EVENT_BATCH *PFN_INDICIUM_ARC_EVENT_BATCH;
+
+typedef enum _INDICIUM_ARC_BATCH_DELIVERY
+{
+    //
+    // Batch gets delivered on the render thread right before the next Pre-Present callback
+    // 
+    IndiciumARCBatchDeliveryPresent = 0,
+
+    //
+    // Batch gets delivered periodically on the engine worker thread
+    // 
+    IndiciumARCBatchDeliveryWorker = 1
+
+} INDICIUM_ARC_BATCH_DELIVERY;
+
+typedef struct _INDICIUM_ARC_BATCH_CONFIG
+{
+    //
+    // Callback receiving all records queued since the last delivery
+    // 
+    PFN_INDICIUM_ARC_EVENT_BATCH    EvtIndiciumARCEventBatch;
+
+    //
+    // Where and when the batch gets delivered
+    // 
+    INDICIUM_ARC_BATCH_DELIVERY     Delivery;
+
+    //
+    // Capacity of the per render client record buffer (rounded up to a power of two)
+    // 
+    UINT32                          RecordsPerClient;
+
+    //
+    // Delivery period in milliseconds if Delivery is IndiciumARCBatchDeliveryWorker
+    // 
+    UINT32                          WorkerIntervalMs;
+
+} INDICIUM_ARC_BATCH_CONFIG, *PINDICIUM_ARC_BATCH_CONFIG;
+
+/**
+ * \fn  VOID FORCEINLINE INDICIUM_ARC_BATCH_CONFIG_INIT( _Out_ PINDICIUM_ARC_BATCH_CONFIG Config, _In_ PFN_INDICIUM_ARC_EVENT_BATCH EvtIndiciumARCEventBatch )
+ *
+ * \brief   Initializes an INDICIUM_ARC_BATCH_CONFIG struct with delivery on Present.
+ *
+ * \date    19.10.2026
+ *
+ * \param   Config                      The batch configuration.
+ * \param   EvtIndiciumARCEventBatch    The batch callback.
+ *
+ * \returns Nothing.
+ */
+VOID FORCEINLINE INDICIUM_ARC_BATCH_CONFIG_INIT(
+    _Out_ PINDICIUM_ARC_BATCH_CONFIG Config,
+    _In_ PFN_INDICIUM_ARC_EVENT_BATCH EvtIndiciumARCEventBatch
+)
+{
+    ZeroMemory(Config, sizeof(INDICIUM_ARC_BATCH_CONFIG));
+
+    Config->EvtIndiciumARCEventBatch = EvtIndiciumARCEventBatch;
+    Config->Delivery = IndiciumARCBatchDeliveryPresent;
+    Config->RecordsPerClient = 1024;
+    Config->WorkerIntervalMs = 16;
+}
+
 #endif // IndiciumCoreAudio_h__
@@ -0,0 +1,568 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumCoroutines_hpp__
+#define IndiciumCoroutines_hpp__
+
+//
+// Header-only C++20 coroutine layer on top of the event callbacks. Instead of spreading
+// multi-frame logic over static state in Pre-Present callbacks, a subscriber writes:
+//
+//     Indicium::Coroutines::Task Overlay(Indicium::Coroutines::D3D11Scheduler& engine, IDXGISwapChain* chain)
+//     {
+//         co_await engine.resize_settled(chain);
+//         // create resources once the swap chain is stable
+//
+//         for (;;)
+//         {
+//             co_await engine.next_present(chain);
+//             // draw
+//         }
+//     }
+//
+// and forwards its Present/ResizeBuffers callbacks to the scheduler:
+//
+//     scheduler.on_present(pSwapChain);    // from EvtIndiciumD3D11PrePresent
+//     scheduler.on_resize(pSwapChain);     // from EvtIndiciumD3D11PreResizeBuffers
+//
+// Waiting coroutines are resumed on the thread calling on_present/on_resize (the render
+// thread). Timed waits (co_await engine.after(500ms)) are resumed by on_tick; attach() has the
+// engine thread call it at every engine tick, waking the engine thread early when needed:
+//
+//     Indicium::Coroutines::attach(engine, scheduler);     // after IndiciumTasks.h
+//
+// Wait-list nodes live inside the coroutine frames and frames are recycled through a
+// size-bucketed pool, so steady-state suspension and resumption never touch the heap.
+//
+// The scheduler is a template over the presenter type and clock and has no Windows
+// dependencies, which allows driving it from a simulated dispatcher.
+//
+
+#if !defined(__cpp_impl_coroutine) && !(defined(_MSVC_LANG) && _MSVC_LANG > 201703L)
+#error IndiciumCoroutines.hpp requires C++20 coroutine support (e.g. /std:c++latest)
+#endif
+
+#include <chrono>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+namespace Indicium
+{
+    namespace Coroutines
+    {
+        /**
+         * \brief   Process-wide pool of coroutine frames. Frames are rounded up to 64 byte buckets
+         *          and returned to a per-bucket free list instead of the heap; frames larger than
+         *          the biggest bucket fall back to the global allocator.
+         */
+        class FramePool
+        {
+            static constexpr size_t granularity = 64;
+            static constexpr size_t buckets = 64;   // up to 4 KiB frames
+
+            struct alignas(std::max_align_t) header
+            {
+                size_t bucket;
+                header* next;
+            };
+
+            std::mutex lock_;
+            header* free_[buckets] = {};
+
+        public:
+            static FramePool& instance()
+            {
+                static FramePool pool;
+                return pool;
+            }
+
+            void* allocate(size_t size)
+            {
+                const auto bucket = (size + granularity - 1) / granularity;
+
+                if (bucket >= buckets)
+                {
+                    auto h = static_cast<header*>(::operator new(sizeof(header) + size));
+                    h->bucket = buckets;
+                    return h + 1;
+                }
+
+                {
+                    std::lock_guard<std::mutex> guard(lock_);
+
+                    if (auto h = free_[bucket])
+                    {
+                        free_[bucket] = h->next;
+                        return h + 1;
+                    }
+                }
+
+                auto h = static_cast<header*>(::operator new(sizeof(header) + bucket * granularity));
+                h->bucket = bucket;
+                return h + 1;
+            }
+
+            void deallocate(void* frame)
+            {
+                auto h = static_cast<header*>(frame) - 1;
+
+                if (h->bucket >= buckets)
+                {
+                    ::operator delete(h);
+                    return;
+                }
+
+                std::lock_guard<std::mutex> guard(lock_);
+
+                h->next = free_[h->bucket];
+                free_[h->bucket] = h;
+            }
+
+            ~FramePool()
+            {
+                for (auto& head : free_)
+                {
+                    while (head)
+                    {
+                        auto next = head->next;
+                        ::operator delete(head);
+                        head = next;
+                    }
+                }
+            }
+        };
+
+        /**
+         * \brief   Fire-and-forget coroutine type for subscribers. Starts executing immediately and
+         *          frees its frame (back into the FramePool) when it runs to completion.
+         */
+        struct Task
+        {
+            struct promise_type
+            {
+                static void* operator new(size_t size)
+                {
+                    return FramePool::instance().allocate(size);
+                }
+
+                static void operator delete(void* frame, size_t)
+                {
+                    FramePool::instance().deallocate(frame);
+                }
+
+                Task get_return_object() noexcept { return {}; }
+                std::suspend_never initial_suspend() noexcept { return {}; }
+                std::suspend_never final_suspend() noexcept { return {}; }
+                void return_void() noexcept { }
+
+                //
+                // Exceptions must never propagate into the host's render thread
+                //
+                void unhandled_exception() noexcept { }
+            };
+        };
+
+        /**
+         * \brief   Resumes coroutines at frame boundaries of a presenter (swap chain or device)
+         *          and after timeouts. on_present and on_resize come from the render thread,
+         *          on_tick from the engine thread; coroutines may wait on either from any thread
+         *          and resume on the thread whose notification ended the wait.
+         */
+        template <typename Presenter, typename Clock = std::chrono::steady_clock>
+        class Scheduler
+        {
+        public:
+            enum class wait_kind
+            {
+                present,
+                frames,
+                resize_settled,
+                timer
+            };
+
+            struct waiter
+            {
+                waiter* next = nullptr;
+                std::coroutine_handle<> handle;
+                Presenter presenter{};
+                wait_kind kind = wait_kind::present;
+                uint32_t remaining = 0;
+                uint32_t quiet = 0;
+                typename Clock::time_point due{};
+            };
+
+        private:
+            std::mutex lock_;
+            waiter* waiting_ = nullptr;
+            uint32_t settle_frames_;
+
+            //
+            // Called when a timed wait became the earliest, so ticks come sooner
+            //
+            void (*wake_)(void*) = nullptr;
+            void* wake_context_ = nullptr;
+
+            static bool matches(const waiter* w, Presenter presenter)
+            {
+                return w->presenter == Presenter{} || w->presenter == presenter;
+            }
+
+            void push(waiter* w)
+            {
+                w->next = waiting_;
+                waiting_ = w;
+            }
+
+            void enqueue(waiter* w)
+            {
+                bool earliest = w->kind == wait_kind::timer;
+                void (*wake)(void*);
+                void* context;
+
+                {
+                    std::lock_guard<std::mutex> guard(lock_);
+
+                    for (auto other = waiting_; earliest && other; other = other->next)
+                    {
+                        if (other->kind == wait_kind::timer && other->due <= w->due)
+                            earliest = false;
+                    }
+
+                    push(w);
+
+                    wake = wake_;
+                    context = wake_context_;
+                }
+
+                if (earliest && wake)
+                    wake(context);
+            }
+
+            struct awaiter : waiter
+            {
+                Scheduler* scheduler;
+
+                bool await_ready() const noexcept
+                {
+                    return (this->kind == wait_kind::frames && this->remaining == 0)
+                        || (this->kind == wait_kind::timer && this->due <= Clock::now());
+                }
+
+                void await_suspend(std::coroutine_handle<> h) noexcept
+                {
+                    this->handle = h;
+                    scheduler->enqueue(this);
+                }
+
+                void await_resume() const noexcept { }
+            };
+
+            awaiter make(wait_kind kind, Presenter presenter, uint32_t remaining)
+            {
+                awaiter a;
+                a.scheduler = this;
+                a.kind = kind;
+                a.presenter = presenter;
+                a.remaining = remaining;
+                return a;
+            }
+
+            template <typename Ready>
+            void resume_where(Ready&& ready)
+            {
+                //
+                // Take the ready ones out first; coroutines resumed below may wait again right
+                // away and must not be resumed twice in one frame
+                //
+                waiter* runnable = nullptr;
+
+                {
+                    std::lock_guard<std::mutex> guard(lock_);
+
+                    auto pending = waiting_;
+                    waiting_ = nullptr;
+
+                    while (pending)
+                    {
+                        auto w = pending;
+                        pending = pending->next;
+
+                        if (ready(w))
+                        {
+                            w->next = runnable;
+                            runnable = w;
+                        }
+                        else
+                        {
+                            push(w);
+                        }
+                    }
+                }
+
+                while (runnable)
+                {
+                    auto w = runnable;
+                    runnable = runnable->next;
+
+                    //
+                    // Frame (and the waiter in it) may be gone after this
+                    //
+                    w->handle.resume();
+                }
+            }
+
+        public:
+            explicit Scheduler(uint32_t settle_frames = 2) : settle_frames_(settle_frames) { }
+
+            Scheduler(const Scheduler&) = delete;
+            Scheduler& operator=(const Scheduler&) = delete;
+
+            ~Scheduler()
+            {
+                shutdown();
+            }
+
+            /**
+             * \brief   Suspends until the next Present of the given presenter (any if empty).
+             */
+            awaiter next_present(Presenter presenter = Presenter{})
+            {
+                return make(wait_kind::present, presenter, 0);
+            }
+
+            /**
+             * \brief   Suspends until count Presents of any presenter have happened.
+             */
+            awaiter frames(uint32_t count)
+            {
+                return make(wait_kind::frames, Presenter{}, count);
+            }
+
+            /**
+             * \brief   Suspends until the presenter went through the configured number of Presents
+             *          without being resized.
+             */
+            awaiter resize_settled(Presenter presenter = Presenter{})
+            {
+                return make(wait_kind::resize_settled, presenter, 0);
+            }
+
+            /**
+             * \brief   Suspends for at least the given time; resumed by on_tick.
+             */
+            template <typename Rep, typename Period>
+            awaiter after(std::chrono::duration<Rep, Period> delay)
+            {
+                auto a = make(wait_kind::timer, Presenter{}, 0);
+                a.due = Clock::now() + std::chrono::duration_cast<typename Clock::duration>(delay);
+                return a;
+            }
+
+            /**
+             * \brief   Frame boundary notification; call from the Pre-Present callback.
+             */
+            void on_present(Presenter presenter)
+            {
+                const auto settle = settle_frames_;
+
+                resume_where([presenter, settle](waiter* w)
+                {
+                    switch (w->kind)
+                    {
+                    case wait_kind::present:
+                        return matches(w, presenter);
+                    case wait_kind::frames:
+                        return --w->remaining == 0;
+                    case wait_kind::resize_settled:
+                        return matches(w, presenter) && ++w->quiet >= settle;
+                    case wait_kind::timer:
+                        return false;
+                    }
+
+                    return false;
+                });
+            }
+
+            /**
+             * \brief   Resumes the timed waits which are due; call from the engine thread.
+             */
+            void on_tick()
+            {
+                const auto now = Clock::now();
+
+                resume_where([now](waiter* w)
+                {
+                    return w->kind == wait_kind::timer && w->due <= now;
+                });
+            }
+
+            /**
+             * \brief   Milliseconds until the earliest timed wait is due, rounded up; the maximum
+             *          (INFINITE) without any.
+             */
+            uint32_t tick_interval()
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+
+                const auto now = Clock::now();
+                auto interval = UINT32_MAX;
+
+                for (auto w = waiting_; w; w = w->next)
+                {
+                    if (w->kind != wait_kind::timer)
+                        continue;
+
+                    if (w->due <= now)
+                        return 0;
+
+                    const auto ms = std::chrono::ceil<std::chrono::milliseconds>(w->due - now).count();
+
+                    if (uint64_t(ms) < interval)
+                        interval = uint32_t(ms);
+                }
+
+                return interval;
+            }
+
+            /**
+             * \brief   Sets the routine called when a timed wait moved the next tick forward.
+             */
+            void set_wake(void (*wake)(void*), void* context)
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+
+                wake_ = wake;
+                wake_context_ = context;
+            }
+
+            /**
+             * \brief   Resize notification; call from the Pre-ResizeBuffers callback.
+             */
+            void on_resize(Presenter presenter)
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+
+                for (auto w = waiting_; w; w = w->next)
+                {
+                    if (w->kind == wait_kind::resize_settled && matches(w, presenter))
+                        w->quiet = 0;
+                }
+            }
+
+            /**
+             * \brief   Destroys all suspended coroutines, e.g. before the render API gets unhooked.
+             *          Nothing may drive the scheduler meanwhile; detach it from the engine first.
+             */
+            void shutdown()
+            {
+                waiter* pending;
+
+                {
+                    std::lock_guard<std::mutex> guard(lock_);
+
+                    pending = waiting_;
+                    waiting_ = nullptr;
+                }
+
+                while (pending)
+                {
+                    auto w = pending;
+                    pending = pending->next;
+                    w->handle.destroy();
+                }
+            }
+
+            bool idle()
+            {
+                std::lock_guard<std::mutex> guard(lock_);
+
+                return waiting_ == nullptr;
+            }
+        };
+
+#ifdef IndiciumTasks_h__
+        template <typename Presenter, typename Clock>
+        DWORD engine_tick(PINDICIUM_ENGINE, PVOID context)
+        {
+            auto scheduler = static_cast<Scheduler<Presenter, Clock>*>(context);
+
+            scheduler->on_tick();
+
+            return scheduler->tick_interval();
+        }
+
+        /**
+         * \brief   Has the engine thread resume the timed waits of the scheduler. Detach before
+         *          the scheduler goes away.
+         */
+        template <typename Presenter, typename Clock>
+        INDICIUM_ERROR attach(PINDICIUM_ENGINE engine, Scheduler<Presenter, Clock>& scheduler)
+        {
+            scheduler.set_wake([](void* context)
+            {
+                IndiciumEngineRequestTick(static_cast<PINDICIUM_ENGINE>(context));
+            }, engine);
+
+            const auto result = IndiciumEngineAddTickHandler(engine, engine_tick<Presenter, Clock>, &scheduler);
+
+            if (result != INDICIUM_ERROR_NONE)
+                scheduler.set_wake(nullptr, nullptr);
+
+            return result;
+        }
+
+        template <typename Presenter, typename Clock>
+        INDICIUM_ERROR detach(PINDICIUM_ENGINE engine, Scheduler<Presenter, Clock>& scheduler)
+        {
+            const auto result = IndiciumEngineRemoveTickHandler(engine, engine_tick<Presenter, Clock>, &scheduler);
+
+            scheduler.set_wake(nullptr, nullptr);
+
+            return result;
+        }
+#endif
+
+#ifdef IndiciumDirect3D9_h__
+        typedef Scheduler<LPDIRECT3DDEVICE9> D3D9Scheduler;
+#endif
+
+#ifdef IndiciumDirect3D10_h__
+        typedef Scheduler<IDXGISwapChain*> D3D10Scheduler;
+#endif
+
+#ifdef IndiciumDirect3D11_h__
+        typedef Scheduler<IDXGISwapChain*> D3D11Scheduler;
+#endif
+
+#ifdef IndiciumDirect3D12_h__
+        typedef Scheduler<IDXGISwapChain*> D3D12Scheduler;
+#endif
+    };
+};
+
+#endif // IndiciumCoroutines_hpp__
@@ -0,0 +1,134 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef IndiciumCounters_h__
+#define IndiciumCounters_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Maximum length of a counter name including the terminating null character
+    // 
+#define INDICIUM_COUNTER_NAME_LENGTH    64
+
+    //
+    // Opaque handle to a named counter registered on an engine
+    // 
+    typedef struct _INDICIUM_COUNTER *PINDICIUM_COUNTER;
+
+    typedef struct _INDICIUM_COUNTER_VALUE
+    {
+        //
+        // Name the counter got registered with, e.g. "bus.overlay.published"
+        // 
+        CHAR Name[INDICIUM_COUNTER_NAME_LENGTH];
+
+        //
+        // Sum of all increments since the counter got registered
+        // 
+        ULONGLONG Value;
+
+    } INDICIUM_COUNTER_VALUE, *PINDICIUM_COUNTER_VALUE;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCounterRegister( _In_ PINDICIUM_ENGINE Engine, _In_ LPCSTR Name, _Out_ PINDICIUM_COUNTER* Counter );
+     *
+     * \brief   Registers a counter reported alongside the engine statistics. Registering an
+     *          existing name returns the same counter, so modules can share one. Names of engine
+     *          counters can't be taken.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine  The engine handle.
+     * \param           Name    The counter name, shorter than INDICIUM_COUNTER_NAME_LENGTH.
+     * \param [out]     Counter The counter handle, valid for the lifetime of the engine.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCounterRegister(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        LPCSTR Name,
+        _Out_
+        PINDICIUM_COUNTER* Counter
+    );
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumEngineCounterAdd( _In_ PINDICIUM_COUNTER Counter, _In_ ULONGLONG Value );
+     *
+     * \brief   Increments a counter. Lock-free and safe to call from any number of threads;
+     *          each thread updates its own shard of the counter.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Counter The counter handle.
+     * \param   Value   The increment.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumEngineCounterAdd(
+        _In_
+        PINDICIUM_COUNTER Counter,
+        _In_
+        ULONGLONG Value
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetCounters( _In_ PINDICIUM_ENGINE Engine, _Out_opt_ PINDICIUM_COUNTER_VALUE Values, _In_ SIZE_T Capacity, _Out_ PSIZE_T Count );
+     *
+     * \brief   Reads all registered counters, engine statistics included, in registration order.
+     *          Pass no buffer to query the number of counters. Values are summed on read and may
+     *          miss increments happening concurrently.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Values      If non-null, receives the counter values.
+     * \param           Capacity    Number of elements in Values.
+     * \param [out]     Count       The number of registered counters.
+     *
+     * \returns INDICIUM_ERROR_BUFFER_TOO_SMALL if Values can't hold all counters, in which case
+     *          the first Capacity ones are written.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetCounters(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_opt_
+        PINDICIUM_COUNTER_VALUE Values,
+        _In_
+        SIZE_T Capacity,
+        _Out_
+        PSIZE_T Count
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumCounters_h__
@@ -0,0 +1,288 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumEventBus_h__
+#define IndiciumEventBus_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Opaque handle to a named message topic hosted by an engine
+    // 
+    typedef struct _INDICIUM_BUS_TOPIC *PINDICIUM_BUS_TOPIC;
+
+    //
+    // Opaque handle to a topic subscription
+    // 
+    typedef struct _INDICIUM_BUS_SUBSCRIPTION *PINDICIUM_BUS_SUBSCRIPTION;
+
+    typedef enum _INDICIUM_BUS_DELIVERY
+    {
+        //
+        // Callback gets invoked synchronously on the publishing thread
+        // 
+        IndiciumBusDeliveryInline = 0,
+
+        //
+        // Messages get queued and delivered on the render thread at the next Pre-Present
+        // 
+        IndiciumBusDeliveryPrePresent = 1
+
+    } INDICIUM_BUS_DELIVERY;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_BUS_MESSAGE)
+        VOID
+        EVT_INDICIUM_BUS_MESSAGE(
+            PINDICIUM_BUS_TOPIC Topic,
+            const VOID          *Message,
+            SIZE_T              MessageSize,
+            PVOID               Context
+        );
+
+    typedef EVT_INDICIUM_BUS_MESSAGE *PFN_INDICIUM_BUS_MESSAGE;
+
+    typedef struct _INDICIUM_BUS_TOPIC_STATISTICS
+    {
+        //
+        // Messages accepted by the topic
+        // 
+        ULONGLONG Published;
+
+        //
+        // Messages refused because the backlog of a deferred subscriber was full
+        // 
+        ULONGLONG Rejected;
+
+        //
+        // Callback invocations on publishing threads
+        // 
+        ULONGLONG DeliveredInline;
+
+        //
+        // Callback invocations at Pre-Present
+        // 
+        ULONGLONG DeliveredDeferred;
+
+        //
+        // Messages still queued for the slowest deferred subscriber
+        // 
+        UINT32 Backlog;
+
+        //
+        // Number of message slots in the topic ring
+        // 
+        UINT32 Capacity;
+
+    } INDICIUM_BUS_TOPIC_STATISTICS, *PINDICIUM_BUS_TOPIC_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBusCreateTopic( _In_ PINDICIUM_ENGINE Engine, _In_ LPCSTR Name, _In_ SIZE_T MessageSize, _In_ UINT32 Capacity, _Out_ PINDICIUM_BUS_TOPIC* Topic );
+     *
+     * \brief   Creates or opens a named topic with fixed-size message slots. Modules sharing an
+     *          engine open the same topic by name; opening an existing topic with a different
+     *          message size fails.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param           Name        Unique topic name.
+     * \param           MessageSize Maximum size of a single message in bytes.
+     * \param           Capacity    Number of message slots (rounded up to a power of two).
+     *                              Ignored if the topic already exists.
+     * \param [out]     Topic       The topic handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBusCreateTopic(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        LPCSTR Name,
+        _In_
+        SIZE_T MessageSize,
+        _In_
+        UINT32 Capacity,
+        _Out_
+        PINDICIUM_BUS_TOPIC* Topic
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBusPublish( _In_ PINDICIUM_BUS_TOPIC Topic, _In_ const VOID* Message, _In_ SIZE_T MessageSize );
+     *
+     * \brief   Publishes a message. Never blocks; if a deferred subscriber hasn't consumed enough
+     *          of its backlog the message is refused with INDICIUM_ERROR_BUS_TOPIC_FULL and
+     *          accounted for as rejected. Safe to call from any thread.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Topic       The topic handle.
+     * \param   Message     The message payload.
+     * \param   MessageSize Size of the payload, must not exceed the topic message size.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBusPublish(
+        _In_
+        PINDICIUM_BUS_TOPIC Topic,
+        _In_
+        const VOID* Message,
+        _In_
+        SIZE_T MessageSize
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBusSubscribe( _In_ PINDICIUM_BUS_TOPIC Topic, _In_ PFN_INDICIUM_BUS_MESSAGE EvtIndiciumBusMessage, _In_opt_ PVOID Context, _In_ INDICIUM_BUS_DELIVERY Delivery, _Out_opt_ PINDICIUM_BUS_SUBSCRIPTION* Subscription );
+     *
+     * \brief   Subscribes to a topic. Deferred subscribers receive messages published after this
+     *          call on the render thread at the next Pre-Present.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Topic                   The topic handle.
+     * \param           EvtIndiciumBusMessage   The message callback.
+     * \param           Context                 Caller context passed to the callback.
+     * \param           Delivery                Inline or deferred delivery.
+     * \param [out]     Subscription            If non-null, the subscription handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBusSubscribe(
+        _In_
+        PINDICIUM_BUS_TOPIC Topic,
+        _In_
+        PFN_INDICIUM_BUS_MESSAGE EvtIndiciumBusMessage,
+        _In_opt_
+        PVOID Context,
+        _In_
+        INDICIUM_BUS_DELIVERY Delivery,
+        _Out_opt_
+        PINDICIUM_BUS_SUBSCRIPTION* Subscription
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBusUnsubscribe( _In_ PINDICIUM_BUS_SUBSCRIPTION Subscription );
+     *
+     * \brief   Cancels a subscription. The callback might still be invoked by deliveries already
+     *          in progress on other threads.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Subscription    The subscription handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBusUnsubscribe(
+        _In_
+        PINDICIUM_BUS_SUBSCRIPTION Subscription
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineBusGetTopicStatistics( _In_ PINDICIUM_BUS_TOPIC Topic, _Out_ PINDICIUM_BUS_TOPIC_STATISTICS Statistics );
+     *
+     * \brief   Reports throughput and back-pressure counters of a topic.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Topic       The topic handle.
+     * \param [out]     Statistics  The topic statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineBusGetTopicStatistics(
+        _In_
+        PINDICIUM_BUS_TOPIC Topic,
+        _Out_
+        PINDICIUM_BUS_TOPIC_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+
+#include <type_traits>
+
+namespace Indicium
+{
+    namespace Bus
+    {
+        /**
+         * \brief   Typed convenience wrapper around a bus topic carrying messages of type T.
+         */
+        template <typename T>
+        class Topic
+        {
+            static_assert(std::is_trivially_copyable<T>::value, "Bus messages are copied bytewise");
+
+            PINDICIUM_BUS_TOPIC topic_ = nullptr;
+
+            template <typename Handler>
+            static VOID Trampoline(PINDICIUM_BUS_TOPIC, const VOID* Message, SIZE_T, PVOID Context)
+            {
+                (*static_cast<Handler*>(Context))(*static_cast<const T*>(Message));
+            }
+
+        public:
+            INDICIUM_ERROR open(PINDICIUM_ENGINE Engine, LPCSTR Name, UINT32 Capacity = 256)
+            {
+                return IndiciumEngineBusCreateTopic(Engine, Name, sizeof(T), Capacity, &topic_);
+            }
+
+            INDICIUM_ERROR publish(const T& Message) const
+            {
+                return IndiciumEngineBusPublish(topic_, &Message, sizeof(T));
+            }
+
+            /**
+             * \brief   Subscribes a callable taking const T&; the callable must outlive the
+             *          subscription.
+             */
+            template <typename Handler>
+            INDICIUM_ERROR subscribe(
+                Handler& Callable,
+                INDICIUM_BUS_DELIVERY Delivery,
+                PINDICIUM_BUS_SUBSCRIPTION* Subscription = nullptr
+            ) const
+            {
+                return IndiciumEngineBusSubscribe(topic_, &Trampoline<Handler>, &Callable, Delivery, Subscription);
+            }
+
+            PINDICIUM_BUS_TOPIC handle() const
+            {
+                return topic_;
+            }
+        };
+    };
+};
+
+#endif
+
+#endif // IndiciumEventBus_h__
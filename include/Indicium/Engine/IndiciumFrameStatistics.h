@@ -0,0 +1,570 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef IndiciumFrameStatistics_h__
+#define IndiciumFrameStatistics_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Time the engine spent in a hooked Present compared to the original Present and the frame
+    // 
+    typedef struct _INDICIUM_FRAME_OVERHEAD
+    {
+        //
+        // Swap chain or device which presented
+        // 
+        PVOID Presenter;
+
+        //
+        // Render API the frames were presented with
+        // 
+        INDICIUM_D3D_VERSION Version;
+
+        //
+        // Number of frames accounted
+        // 
+        ULONGLONG Frames;
+
+        //
+        // Engine time of the latest frame in milliseconds: everything inside the Present hook
+        // except the original Present (engine work, callbacks, plugins, logging); only the
+        // one-time setup on the first calls and the suspended check come before the clock starts
+        // 
+        double LastEngineMs;
+
+        //
+        // Time spent in the original Present during the latest frame in milliseconds
+        // 
+        double LastPresentMs;
+
+        //
+        // Time between the latest two Presents in milliseconds
+        // 
+        double LastFrameMs;
+
+        //
+        // Engine time summed over all accounted frames in milliseconds
+        // 
+        double EngineMs;
+
+        //
+        // Original Present time summed over all accounted frames in milliseconds
+        // 
+        double PresentMs;
+
+        //
+        // Frame time summed over all accounted frames in milliseconds
+        // 
+        double FrameMs;
+
+        //
+        // Share of the frame time spent in engine code, in percent
+        // 
+        double EngineOfFramePercent;
+
+        //
+        // Share of the hooked Present call spent in engine code, in percent
+        // 
+        double EngineOfPresentPercent;
+
+    } INDICIUM_FRAME_OVERHEAD, *PINDICIUM_FRAME_OVERHEAD;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetFrameOverhead( _In_ PINDICIUM_ENGINE Engine, _Out_opt_ PINDICIUM_FRAME_OVERHEAD Values, _In_ SIZE_T Capacity, _Out_ PSIZE_T Count );
+     *
+     * \brief   Reports the engine overhead of every swap chain or device presenting, most
+     *          recently presenting first. Pass no buffer to query the number of presenters.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Values      If non-null, receives the overhead per presenter.
+     * \param           Capacity    Number of elements in Values.
+     * \param [out]     Count       The number of presenters tracked.
+     *
+     * \returns INDICIUM_ERROR_BUFFER_TOO_SMALL if Values can't hold all presenters, in which
+     *          case the first Capacity ones are written.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetFrameOverhead(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_opt_
+        PINDICIUM_FRAME_OVERHEAD Values,
+        _In_
+        SIZE_T Capacity,
+        _Out_
+        PSIZE_T Count
+    );
+
+    //
+    // Maximum number of threads listed individually per frame
+    // 
+#define INDICIUM_FRAME_CPU_MAX_THREADS  16
+
+    typedef struct _INDICIUM_THREAD_CPU_TIME
+    {
+        //
+        // Thread identifier within the host process
+        // 
+        DWORD ThreadId;
+
+        //
+        // TRUE for the thread which called Present
+        // 
+        BOOL IsRenderThread;
+
+        //
+        // TRUE for the engine thread doing the sampling
+        // 
+        BOOL IsEngineThread;
+
+        //
+        // CPU cycles the thread consumed during the frame
+        // 
+        ULONGLONG Cycles;
+
+        //
+        // Cycles converted to milliseconds at the time stamp counter rate
+        // 
+        double CpuMs;
+
+    } INDICIUM_THREAD_CPU_TIME, *PINDICIUM_THREAD_CPU_TIME;
+
+    //
+    // CPU time of the host process between two sampled Present boundaries, by thread
+    // 
+    typedef struct _INDICIUM_FRAME_CPU_TIMES
+    {
+        //
+        // Number of the first Present covered, counting from when sampling started
+        // 
+        ULONGLONG FirstFrame;
+
+        //
+        // Number of Presents covered; more than one if the engine thread fell behind
+        // 
+        UINT32 Frames;
+
+        //
+        // Wall clock time between the two boundaries in milliseconds
+        // 
+        double WallMs;
+
+        //
+        // CPU time of all threads in milliseconds
+        // 
+        double TotalCpuMs;
+
+        //
+        // CPU time of the threads not listed in Threads in milliseconds
+        // 
+        double OtherCpuMs;
+
+        //
+        // Number of threads not listed in Threads which were busy during the frame
+        // 
+        UINT32 OtherThreads;
+
+        //
+        // Number of valid elements in Threads
+        // 
+        UINT32 ThreadCount;
+
+        //
+        // Busiest threads of the frame, descending; the render thread is always included
+        // 
+        INDICIUM_THREAD_CPU_TIME Threads[INDICIUM_FRAME_CPU_MAX_THREADS];
+
+    } INDICIUM_FRAME_CPU_TIMES, *PINDICIUM_FRAME_CPU_TIMES;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCpuAttributionStart( _In_ PINDICIUM_ENGINE Engine, _In_ UINT32 HistoryFrames );
+     *
+     * \brief   Starts sampling the CPU time of every thread in the host process at each Present.
+     *          The engine thread takes the samples, the render thread only records the boundary.
+     *          Restarting discards the collected frames.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine          The engine handle.
+     * \param   HistoryFrames   Number of most recent frames to keep, 0 defaults to 256.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCpuAttributionStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        UINT32 HistoryFrames
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineCpuAttributionStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops sampling; collected frames stay available.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineCpuAttributionStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetFrameCpuTimes( _In_ PINDICIUM_ENGINE Engine, _Out_opt_ PINDICIUM_FRAME_CPU_TIMES Values, _In_ SIZE_T Capacity, _Out_ PSIZE_T Count );
+     *
+     * \brief   Copies the per-thread CPU breakdown of the collected frames, most recent first.
+     *          Pass no buffer to query the number of frames available.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Values      If non-null, receives the frames.
+     * \param           Capacity    Number of elements in Values.
+     * \param [out]     Count       The number of frames available.
+     *
+     * \returns INDICIUM_ERROR_BUFFER_TOO_SMALL if Values can't hold all frames, in which case
+     *          the most recent Capacity ones are written.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetFrameCpuTimes(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_opt_
+        PINDICIUM_FRAME_CPU_TIMES Values,
+        _In_
+        SIZE_T Capacity,
+        _Out_
+        PSIZE_T Count
+    );
+
+    //
+    // What the display made of the Presents of a swap chain or Direct3D 9Ex device, reconciled
+    // from the presentation statistics of the runtime and the Presents seen by the hooks
+    // 
+    typedef struct _INDICIUM_DISPLAY_STATISTICS
+    {
+        //
+        // Swap chain or device which presented
+        // 
+        PVOID Presenter;
+
+        //
+        // Render API the frames were presented with
+        // 
+        INDICIUM_D3D_VERSION Version;
+
+        //
+        // Presents seen by the hooks since tracking started
+        // 
+        ULONGLONG PresentsHooked;
+
+        //
+        // Frames reported as reaching the screen
+        // 
+        ULONGLONG FramesDisplayed;
+
+        //
+        // Presents which were replaced by a later one before reaching the screen
+        // 
+        ULONGLONG FramesDropped;
+
+        //
+        // Vertical refreshes which showed no new frame
+        // 
+        ULONGLONG MissedRefreshes;
+
+        //
+        // Queries failing because the runtime had no statistics, e.g. for windowed bit-block
+        // transfer swap chains or while the statistics were disjoint
+        // 
+        ULONGLONG Unavailable;
+
+        //
+        // Presents queued but not displayed yet at the latest query
+        // 
+        UINT32 QueueDepth;
+
+        //
+        // Time between the latest two displayed frames in milliseconds
+        // 
+        double LastDisplayedFrameMs;
+
+        //
+        // Average time between displayed frames in milliseconds
+        // 
+        double AverageDisplayedFrameMs;
+
+        //
+        // Time from the Present call to the vertical refresh showing the frame in milliseconds,
+        // latest and average
+        // 
+        double LastLatencyMs;
+        double AverageLatencyMs;
+
+    } INDICIUM_DISPLAY_STATISTICS, *PINDICIUM_DISPLAY_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineDisplayTrackingStart( _In_ PINDICIUM_ENGINE Engine, _In_ UINT32 QueryIntervalFrames );
+     *
+     * \brief   Starts querying the presentation statistics (GetFrameStatistics for DXGI swap
+     *          chains, GetPresentStats for Direct3D 9Ex) of every presenting swap chain or device.
+     *          Queries are made on the render thread right after Present. Restarting resets the
+     *          statistics.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine              The engine handle.
+     * \param   QueryIntervalFrames Number of Presents between queries, 0 defaults to every Present.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineDisplayTrackingStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        UINT32 QueryIntervalFrames
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineDisplayTrackingStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops querying presentation statistics; collected values stay available.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineDisplayTrackingStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetDisplayStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_opt_ PINDICIUM_DISPLAY_STATISTICS Values, _In_ SIZE_T Capacity, _Out_ PSIZE_T Count );
+     *
+     * \brief   Reports the display-side statistics of every tracked swap chain or device, most
+     *          recently presenting first. Pass no buffer to query the number of presenters.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Values      If non-null, receives the statistics per presenter.
+     * \param           Capacity    Number of elements in Values.
+     * \param [out]     Count       The number of presenters tracked.
+     *
+     * \returns INDICIUM_ERROR_BUFFER_TOO_SMALL if Values can't hold all presenters, in which
+     *          case the first Capacity ones are written.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetDisplayStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_opt_
+        PINDICIUM_DISPLAY_STATISTICS Values,
+        _In_
+        SIZE_T Capacity,
+        _Out_
+        PSIZE_T Count
+    );
+
+    typedef struct _INDICIUM_OVERHEAD_AB_CONFIG
+    {
+        //
+        // Presents per window of one variant, 0 defaults to 60
+        // 
+        UINT32 FramesPerWindow;
+
+        //
+        // Frame times left out at the start of every window while the render queue adapts to
+        // the switch, at least 1, 0 defaults to 3
+        // 
+        UINT32 SettleFrames;
+
+        //
+        // TRUE to also alternate windows leaving out the callbacks registered on the engine
+        // and, one at a time, each plugin
+        // 
+        BOOL MeasureSubscribers;
+
+        //
+        // Two-sided confidence level of the reported intervals, 0 defaults to 0.95
+        // 
+        double ConfidenceLevel;
+
+    } INDICIUM_OVERHEAD_AB_CONFIG, *PINDICIUM_OVERHEAD_AB_CONFIG;
+
+    typedef enum _INDICIUM_OVERHEAD_SUBJECT
+    {
+        //
+        // All engine work, callbacks and plugins; active windows versus suspended ones
+        // 
+        IndiciumOverheadSubjectEngine,
+
+        //
+        // Callbacks registered on the engine with the IndiciumEngineSet*EventCallbacks functions
+        // 
+        IndiciumOverheadSubjectHostCallbacks,
+
+        //
+        // Callbacks of one plugin
+        // 
+        IndiciumOverheadSubjectPlugin
+
+    } INDICIUM_OVERHEAD_SUBJECT;
+
+    //
+    // Longest plugin name reported by an overhead estimate, including the terminator
+    // 
+#define INDICIUM_OVERHEAD_NAME_LENGTH   64
+
+    //
+    // Frame time cost of a subject, estimated from windows with and without it
+    // 
+    typedef struct _INDICIUM_OVERHEAD_ESTIMATE
+    {
+        //
+        // What got measured
+        // 
+        INDICIUM_OVERHEAD_SUBJECT Subject;
+
+        //
+        // Plugin name for IndiciumOverheadSubjectPlugin, possibly truncated; empty otherwise
+        // 
+        CHAR Name[INDICIUM_OVERHEAD_NAME_LENGTH];
+
+        //
+        // Measured windows with and without the subject
+        // 
+        ULONGLONG WindowsWith;
+        ULONGLONG WindowsWithout;
+
+        //
+        // Mean frame time with and without the subject in milliseconds
+        // 
+        double FrameMsWith;
+        double FrameMsWithout;
+
+        //
+        // Difference of the two means in milliseconds, with the bounds of its confidence
+        // interval; zero until both sides have two windows
+        // 
+        double CostMs;
+        double CostLowerMs;
+        double CostUpperMs;
+
+        //
+        // Cost relative to the frame time without the subject, in percent
+        // 
+        double CostPercent;
+
+        //
+        // One-sided p-value of Welch's t-test for the subject making frames longer
+        // 
+        double PValue;
+
+    } INDICIUM_OVERHEAD_ESTIMATE, *PINDICIUM_OVERHEAD_ESTIMATE;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineOverheadABStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_OVERHEAD_AB_CONFIG Config );
+     *
+     * \brief   Starts alternating windows of frames in which the engine is suspended, fully
+     *          active and, if requested, active without one subscriber. The order of the
+     *          variants is shuffled every round so periodic load in the game doesn't line up
+     *          with one of them. The mean frame time of each window is one sample. Restarting
+     *          discards the collected windows. Frames while the engine is suspended through
+     *          IndiciumEngineSuspend are not measured.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The window configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineOverheadABStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_OVERHEAD_AB_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineOverheadABStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops alternating and restores full dispatch; collected windows stay available.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineOverheadABStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetOverheadEstimates( _In_ PINDICIUM_ENGINE Engine, _Out_opt_ PINDICIUM_OVERHEAD_ESTIMATE Values, _In_ SIZE_T Capacity, _Out_ PSIZE_T Count );
+     *
+     * \brief   Reports the estimated cost of the engine, followed by the callbacks registered
+     *          on the engine and every plugin if subscribers are measured. Pass no buffer to
+     *          query the number of estimates.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Values      If non-null, receives the estimates.
+     * \param           Capacity    Number of elements in Values.
+     * \param [out]     Count       The number of estimates available.
+     *
+     * \returns INDICIUM_ERROR_BUFFER_TOO_SMALL if Values can't hold all estimates, in which
+     *          case the first Capacity ones are written.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetOverheadEstimates(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_opt_
+        PINDICIUM_OVERHEAD_ESTIMATE Values,
+        _In_
+        SIZE_T Capacity,
+        _Out_
+        PSIZE_T Count
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumFrameStatistics_h__
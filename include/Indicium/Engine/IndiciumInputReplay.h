@@ -0,0 +1,198 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumInputReplay_h__
+#define IndiciumInputReplay_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum _INDICIUM_INPUT_REPLAY_MODE
+    {
+        //
+        // All input of a recorded frame gets injected right at the start of the same frame of
+        // the replay; identical input per frame regardless of frame times
+        // 
+        IndiciumInputReplayFrameAligned = 0,
+
+        //
+        // Input keeps its position within the recorded frame, scaled to the current frame time;
+        // closer to the original timing, but input may slip to the end of its frame
+        // 
+        IndiciumInputReplayTimed = 1
+
+    } INDICIUM_INPUT_REPLAY_MODE;
+
+    typedef enum _INDICIUM_INPUT_REPLAY_STATE
+    {
+        IndiciumInputReplayIdle = 0,
+        IndiciumInputReplayRecording = 1,
+        IndiciumInputReplayReplaying = 2,
+
+        //
+        // All recorded frames got replayed
+        // 
+        IndiciumInputReplayFinished = 3
+
+    } INDICIUM_INPUT_REPLAY_STATE;
+
+    typedef struct _INDICIUM_INPUT_REPLAY_STATUS
+    {
+        INDICIUM_INPUT_REPLAY_STATE State;
+
+        //
+        // Frames recorded, or replayed so far
+        // 
+        ULONGLONG Frame;
+
+        //
+        // Frames in the recording being replayed
+        // 
+        ULONGLONG Frames;
+
+        //
+        // Events recorded, or in the recording being replayed
+        // 
+        ULONGLONG Events;
+
+        //
+        // Events injected so far
+        // 
+        ULONGLONG Injected;
+
+        //
+        // Events injected at the end of their frame instead of their position (timed replays)
+        // 
+        ULONGLONG Late;
+
+    } INDICIUM_INPUT_REPLAY_STATUS, *PINDICIUM_INPUT_REPLAY_STATUS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineInputRecordStart( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Starts recording the keyboard and mouse input read through Raw Input and the
+     *          controller states read through XInput, relative to the Presents of the host.
+     *          Requires HookRawInput and/or HookXInput in the engine configuration; controllers
+     *          get recorded with the state they are in at the start.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineInputRecordStart(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineInputRecordStop( _In_ PINDICIUM_ENGINE Engine, _In_opt_ PCSTR Path );
+     *
+     * \brief   Stops recording and writes the recording to a file.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Path    The file to write, or NULL to discard the recording.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineInputRecordStop(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_opt_
+        PCSTR Path
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineInputReplayStart( _In_ PINDICIUM_ENGINE Engine, _In_ PCSTR Path, _In_ INDICIUM_INPUT_REPLAY_MODE Mode );
+     *
+     * \brief   Replays a recording starting with the next Present. Keyboard and mouse input gets
+     *          injected through SendInput and thus reaches window procedures, Raw Input and
+     *          DirectInput alike, as long as the host window has the focus. Recorded controllers
+     *          are reported to the host by the XInput hooks instead of the real ones until the
+     *          replay ends. Start a benchmark run along with the replay for repeatable passes.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Path    The recording written by IndiciumEngineInputRecordStop.
+     * \param   Mode    The timing of the injected input.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineInputReplayStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PCSTR Path,
+        _In_
+        INDICIUM_INPUT_REPLAY_MODE Mode
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineInputReplayStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops replaying and hands the controllers back to the host.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineInputReplayStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetInputReplayStatus( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_INPUT_REPLAY_STATUS Status );
+     *
+     * \brief   Reports the progress of the current recording or replay.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine  The engine handle.
+     * \param [out]     Status  The status.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetInputReplayStatus(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_INPUT_REPLAY_STATUS Status
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumInputReplay_h__
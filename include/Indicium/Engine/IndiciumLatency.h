@@ -0,0 +1,195 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef IndiciumLatency_h__
+#define IndiciumLatency_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct _INDICIUM_LOW_LATENCY_CONFIG
+    {
+        //
+        // Number of frames the runtime may queue, applied through IDXGISwapChain2 for swap chains
+        // created with a frame latency waitable object, IDXGIDevice1 for other Direct3D 10/11
+        // swap chains and IDirect3DDevice9Ex for Direct3D 9Ex devices
+        // 
+        UINT32 MaximumFrameLatency;
+
+        //
+        // Queueing deliberately left in place so the GPU never runs dry, in milliseconds
+        // 
+        double MarginMs;
+
+        //
+        // Fraction of the measured excess queueing corrected per frame, between 0 and 1
+        // 
+        double Gain;
+
+        //
+        // Upper bound of the delay inserted after Present in milliseconds, 0 for one frame
+        // 
+        double MaximumDelayMs;
+
+        //
+        // Waits on the frame latency waitable object of swap chains created with one; the object
+        // is a semaphore, so only enable this for games which don't wait on it themselves
+        // 
+        BOOL WaitForLatencyObject;
+
+    } INDICIUM_LOW_LATENCY_CONFIG, *PINDICIUM_LOW_LATENCY_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_LOW_LATENCY_CONFIG_INIT( _Out_ PINDICIUM_LOW_LATENCY_CONFIG Config );
+     *
+     * \brief   Initializes an INDICIUM_LOW_LATENCY_CONFIG with a frame latency of one, a margin
+     *          of half a millisecond and a gain of 0.25.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config  The configuration.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_LOW_LATENCY_CONFIG_INIT(
+        _Out_ PINDICIUM_LOW_LATENCY_CONFIG Config
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_LOW_LATENCY_CONFIG));
+
+        Config->MaximumFrameLatency = 1;
+        Config->MarginMs = 0.5;
+        Config->Gain = 0.25;
+    }
+
+    typedef struct _INDICIUM_LOW_LATENCY_STATISTICS
+    {
+        //
+        // TRUE while the mode is running
+        // 
+        BOOL IsActive;
+
+        //
+        // Frame latency applied to the current presenter, 0 if the runtime refused
+        // 
+        UINT32 AppliedFrameLatency;
+
+        //
+        // TRUE if the render thread waits on the swap chain's frame latency waitable object
+        // 
+        BOOL UsesWaitableObject;
+
+        //
+        // Frames paced since the mode got started
+        // 
+        ULONGLONG Frames;
+
+        //
+        // Delay currently inserted after Present in milliseconds
+        // 
+        double DelayMs;
+
+        //
+        // Average time the render thread was held after Present in milliseconds, waitable object
+        // included
+        // 
+        double AverageWaitMs;
+
+        //
+        // Time the latest original Present blocked in milliseconds
+        // 
+        double LastPresentBlockMs;
+
+        //
+        // Latest Present to display latency in milliseconds, negative while unknown
+        // 
+        double LastDisplayLatencyMs;
+
+    } INDICIUM_LOW_LATENCY_STATISTICS, *PINDICIUM_LOW_LATENCY_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineLowLatencyStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_LOW_LATENCY_CONFIG Config );
+     *
+     * \brief   Reduces the render queue and holds the render thread after every Present for as
+     *          long as the next frame would otherwise wait in the queue, so input gets sampled
+     *          later. The delay follows the measured Present blocking and Present to display
+     *          latency; display tracking gets started if it isn't running yet.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The configuration, applied from the next Present on.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineLowLatencyStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_LOW_LATENCY_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineLowLatencyStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops pacing; the original frame latency gets restored at the next Present.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineLowLatencyStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetLowLatencyStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_LOW_LATENCY_STATISTICS Statistics );
+     *
+     * \brief   Reports what the low-latency mode is currently doing.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Statistics  The statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetLowLatencyStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_LOW_LATENCY_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumLatency_h__
@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumMemory_h__
+#define IndiciumMemory_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct _INDICIUM_MEMORY_USAGE
+    {
+        //
+        // Bytes currently allocated, as requested by the engine (block headers excluded)
+        // 
+        ULONGLONG Current;
+
+        //
+        // Highest value of Current since the engine library got loaded or the peaks got reset.
+        // Threads report in steps of 64 KiB, so peaks of short-lived small allocations may come
+        // out lower by up to that much per thread.
+        // 
+        ULONGLONG Peak;
+
+        //
+        // Number of allocations and frees since the engine library got loaded
+        // 
+        ULONGLONG Allocations;
+
+        ULONGLONG Frees;
+
+    } INDICIUM_MEMORY_USAGE, *PINDICIUM_MEMORY_USAGE;
+
+    typedef struct _INDICIUM_MEMORY_REPORT
+    {
+        //
+        // All subsystems together; Total.Peak is the peak of the sum, not the sum of the peaks
+        // 
+        INDICIUM_MEMORY_USAGE Total;
+
+        //
+        // Per subsystem, indexed by INDICIUM_MEMORY_TAG
+        // 
+        INDICIUM_MEMORY_USAGE Subsystems[IndiciumMemoryTagCount];
+
+        //
+        // Bytes spent on block headers and alignment padding on top of Total.Current
+        // 
+        ULONGLONG Overhead;
+
+        //
+        // Live blocks served by the allocator of INDICIUM_ENGINE_CONFIG and by the process heap
+        // 
+        ULONGLONG CustomBlocks;
+
+        ULONGLONG HeapBlocks;
+
+    } INDICIUM_MEMORY_REPORT, *PINDICIUM_MEMORY_REPORT;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetMemoryUsage( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_MEMORY_REPORT Report );
+     *
+     * \brief   Reports the memory footprint of the engine library per subsystem. Counts every
+     *          allocation made by the library, whether served by the configured allocator or by
+     *          the process heap, including those made before the engine got created.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine  The engine handle.
+     * \param [out]     Report  The footprint; subsystems may be mid-allocation while it's taken.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetMemoryUsage(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_MEMORY_REPORT Report
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineResetMemoryPeaks( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Lowers every peak to the current usage, e.g. to measure the footprint of a single
+     *          benchmark run or capture session.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineResetMemoryPeaks(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumMemory_h__
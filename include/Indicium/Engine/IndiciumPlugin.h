@@ -0,0 +1,287 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumPlugin_h__
+#define IndiciumPlugin_h__
+
+//
+// Plugin ABI for engine host mode. With INDICIUM_ENGINE_CONFIG.PluginHost enabled a single
+// injected engine loads every DLL from the plugin directory exporting IndiciumPluginQuery
+// and IndiciumPluginLoad. All plugins share the engine's hooks; each one registers its own
+// callbacks and gets its own context slot, which is handed out in the Context member of
+// the event extensions.
+//
+// Plugins must link against the dynamic library build (INDICIUM_DYNAMIC) so they talk to
+// the hosting engine instead of an embedded copy.
+//
+
+#include "IndiciumCore.h"
+
+#define INDICIUM_PLUGIN_ABI_VERSION     1
+
+#define INDICIUM_PLUGIN_QUERY_EXPORT        "IndiciumPluginQuery"
+#define INDICIUM_PLUGIN_LOAD_EXPORT         "IndiciumPluginLoad"
+#define INDICIUM_PLUGIN_UNLOAD_EXPORT       "IndiciumPluginUnload"
+#define INDICIUM_PLUGIN_GAME_HOOKED_EXPORT  "IndiciumPluginGameHooked"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Opaque handle to a loaded plugin
+    // 
+    typedef struct _INDICIUM_PLUGIN *PINDICIUM_PLUGIN;
+
+    typedef struct _INDICIUM_PLUGIN_INFO
+    {
+        //
+        // Must be set to INDICIUM_PLUGIN_ABI_VERSION
+        // 
+        UINT32 AbiVersion;
+
+        //
+        // Display name used in log messages, must stay valid while the plugin is loaded
+        // 
+        LPCSTR Name;
+
+        //
+        // Plugin defined version number
+        // 
+        UINT32 Version;
+
+    } INDICIUM_PLUGIN_INFO, *PINDICIUM_PLUGIN_INFO;
+
+    //
+    // Exported as IndiciumPluginQuery; return FALSE to decline loading
+    // 
+    typedef
+        _Function_class_(EVT_INDICIUM_PLUGIN_QUERY)
+        BOOL
+        EVT_INDICIUM_PLUGIN_QUERY(
+            PINDICIUM_PLUGIN_INFO Info
+        );
+
+    typedef EVT_INDICIUM_PLUGIN_QUERY *PFN_INDICIUM_PLUGIN_QUERY;
+
+    //
+    // Exported as IndiciumPluginLoad; invoked on a dedicated thread, in parallel with the
+    // other plugins, before any render pipeline gets hooked
+    // 
+    typedef
+        _Function_class_(EVT_INDICIUM_PLUGIN_LOAD)
+        INDICIUM_ERROR
+        EVT_INDICIUM_PLUGIN_LOAD(
+            PINDICIUM_ENGINE Engine,
+            PINDICIUM_PLUGIN Plugin
+        );
+
+    typedef EVT_INDICIUM_PLUGIN_LOAD *PFN_INDICIUM_PLUGIN_LOAD;
+
+    //
+    // Optionally exported as IndiciumPluginUnload; invoked after all hooks have been removed
+    // 
+    typedef
+        _Function_class_(EVT_INDICIUM_PLUGIN_UNLOAD)
+        VOID
+        EVT_INDICIUM_PLUGIN_UNLOAD(
+            PINDICIUM_ENGINE Engine,
+            PINDICIUM_PLUGIN Plugin
+        );
+
+    typedef EVT_INDICIUM_PLUGIN_UNLOAD *PFN_INDICIUM_PLUGIN_UNLOAD;
+
+    //
+    // Optionally exported as IndiciumPluginGameHooked; plugin counterpart of EvtIndiciumGameHooked
+    // 
+    typedef
+        _Function_class_(EVT_INDICIUM_PLUGIN_GAME_HOOKED)
+        VOID
+        EVT_INDICIUM_PLUGIN_GAME_HOOKED(
+            PINDICIUM_PLUGIN Plugin,
+            const INDICIUM_D3D_VERSION GameVersion
+        );
+
+    typedef EVT_INDICIUM_PLUGIN_GAME_HOOKED *PFN_INDICIUM_PLUGIN_GAME_HOOKED;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumPluginAllocContext( _In_ PINDICIUM_PLUGIN Plugin, _Out_ PVOID* Context, _In_ size_t ContextSize );
+     *
+     * \brief   Allocates zeroed context memory owned by the plugin. It gets passed to the
+     *          plugin's callbacks via the event extensions and is freed on unload.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Plugin      The plugin handle.
+     * \param [out]     Context     The allocated context memory.
+     * \param           ContextSize Size of the context in bytes.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumPluginAllocContext(
+        _In_
+        PINDICIUM_PLUGIN Plugin,
+        _Out_
+        PVOID* Context,
+        _In_
+        size_t ContextSize
+    );
+
+    /**
+     * \fn  INDICIUM_API PVOID IndiciumPluginGetContext( _In_ PINDICIUM_PLUGIN Plugin );
+     *
+     * \brief   Gets the plugin's context memory, NULL if none was allocated.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Plugin  The plugin handle.
+     *
+     * \returns The context memory.
+     */
+    INDICIUM_API PVOID IndiciumPluginGetContext(
+        _In_
+        PINDICIUM_PLUGIN Plugin
+    );
+
+#ifndef INDICIUM_NO_D3D9
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumPluginSetD3D9EventCallbacks( _In_ PINDICIUM_PLUGIN Plugin, _In_ PINDICIUM_D3D9_EVENT_CALLBACKS Callbacks );
+     *
+     * \brief   Registers one or more Direct3D 9(Ex) render pipeline callbacks on behalf of a plugin.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Plugin      The plugin handle.
+     * \param   Callbacks   The callback collection to register.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumPluginSetD3D9EventCallbacks(
+        _In_
+        PINDICIUM_PLUGIN Plugin,
+        _In_
+        PINDICIUM_D3D9_EVENT_CALLBACKS Callbacks
+    );
+
+#endif
+
+#ifndef INDICIUM_NO_D3D10
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumPluginSetD3D10EventCallbacks( _In_ PINDICIUM_PLUGIN Plugin, _In_ PINDICIUM_D3D10_EVENT_CALLBACKS Callbacks );
+     *
+     * \brief   Registers one or more Direct3D 10 render pipeline callbacks on behalf of a plugin.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Plugin      The plugin handle.
+     * \param   Callbacks   The callback collection to register.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumPluginSetD3D10EventCallbacks(
+        _In_
+        PINDICIUM_PLUGIN Plugin,
+        _In_
+        PINDICIUM_D3D10_EVENT_CALLBACKS Callbacks
+    );
+
+#endif
+
+#ifndef INDICIUM_NO_D3D11
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumPluginSetD3D11EventCallbacks( _In_ PINDICIUM_PLUGIN Plugin, _In_ PINDICIUM_D3D11_EVENT_CALLBACKS Callbacks );
+     *
+     * \brief   Registers one or more Direct3D 11 render pipeline callbacks on behalf of a plugin.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Plugin      The plugin handle.
+     * \param   Callbacks   The callback collection to register.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumPluginSetD3D11EventCallbacks(
+        _In_
+        PINDICIUM_PLUGIN Plugin,
+        _In_
+        PINDICIUM_D3D11_EVENT_CALLBACKS Callbacks
+    );
+
+#endif
+
+#ifndef INDICIUM_NO_D3D12
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumPluginSetD3D12EventCallbacks( _In_ PINDICIUM_PLUGIN Plugin, _In_ PINDICIUM_D3D12_EVENT_CALLBACKS Callbacks );
+     *
+     * \brief   Registers one or more Direct3D 12 render pipeline callbacks on behalf of a plugin.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Plugin      The plugin handle.
+     * \param   Callbacks   The callback collection to register.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumPluginSetD3D12EventCallbacks(
+        _In_
+        PINDICIUM_PLUGIN Plugin,
+        _In_
+        PINDICIUM_D3D12_EVENT_CALLBACKS Callbacks
+    );
+
+#endif
+
+#ifndef INDICIUM_NO_COREAUDIO
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumPluginSetARCEventCallbacks( _In_ PINDICIUM_PLUGIN Plugin, _In_ PINDICIUM_ARC_EVENT_CALLBACKS Callbacks );
+     *
+     * \brief   Registers one or more Core Audio (Audio Render Client) callbacks on behalf of a plugin.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Plugin      The plugin handle.
+     * \param   Callbacks   The callback collection to register.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumPluginSetARCEventCallbacks(
+        _In_
+        PINDICIUM_PLUGIN Plugin,
+        _In_
+        PINDICIUM_ARC_EVENT_CALLBACKS Callbacks
+    );
+
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumPlugin_h__
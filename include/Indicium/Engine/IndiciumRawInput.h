@@ -0,0 +1,274 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumRawInput_h__
+#define IndiciumRawInput_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum _INDICIUM_RAW_INPUT_TYPE
+    {
+        //
+        // RIM_TYPEMOUSE
+        // 
+        IndiciumRawInputMouse = 0,
+
+        //
+        // RIM_TYPEKEYBOARD
+        // 
+        IndiciumRawInputKeyboard = 1,
+
+        //
+        // RIM_TYPEHID, only counted; the report data is not copied
+        // 
+        IndiciumRawInputHid = 2
+
+    } INDICIUM_RAW_INPUT_TYPE;
+
+    //
+    // One raw input event read by the host, or several mouse movements merged into one
+    // 
+    typedef struct _INDICIUM_RAW_INPUT_EVENT
+    {
+        //
+        // Device the input originated from (RAWINPUTHEADER::hDevice)
+        // 
+        HANDLE Device;
+
+        //
+        // QueryPerformanceCounter value at which the host read the first merged event
+        // 
+        LONGLONG FirstTimestamp;
+
+        //
+        // QueryPerformanceCounter value at which the host read the last merged event
+        // 
+        LONGLONG LastTimestamp;
+
+        INDICIUM_RAW_INPUT_TYPE Type;
+
+        //
+        // Number of events read by the host this one stands for, 1 if nothing got merged
+        // 
+        UINT32 Coalesced;
+
+        union
+        {
+            struct
+            {
+                //
+                // Summed relative motion, or the latest position if MOUSE_MOVE_ABSOLUTE is set in Flags
+                // 
+                LONG X;
+                LONG Y;
+
+                //
+                // RAWMOUSE::usFlags
+                // 
+                USHORT Flags;
+
+                //
+                // RAWMOUSE::usButtonFlags; events with button or wheel transitions are never merged
+                // 
+                USHORT ButtonFlags;
+
+                //
+                // RAWMOUSE::usButtonData, the wheel delta
+                // 
+                USHORT ButtonData;
+
+            } Mouse;
+
+            struct
+            {
+                //
+                // RAWKEYBOARD members; keyboard events are never merged
+                // 
+                USHORT MakeCode;
+                USHORT Flags;
+                USHORT VKey;
+                UINT Message;
+
+            } Keyboard;
+
+            struct
+            {
+                //
+                // RAWHID members of the last merged event
+                // 
+                DWORD SizeHid;
+                DWORD Count;
+
+            } Hid;
+        };
+
+    } INDICIUM_RAW_INPUT_EVENT, *PINDICIUM_RAW_INPUT_EVENT;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_RAW_INPUT_BATCH)
+        VOID
+        EVT_INDICIUM_RAW_INPUT_BATCH(
+            const INDICIUM_RAW_INPUT_EVENT *Events,
+            SIZE_T                          Count,
+            ULONGLONG                       DroppedEvents,
+            PINDICIUM_EVT_POST_EXTENSION    Extension
+        );
+
+    typedef EVT_INDICIUM_RAW_INPUT_BATCH *PFN_INDICIUM_RAW_INPUT_BATCH;
+
+    typedef struct _INDICIUM_RAW_INPUT_CONFIG
+    {
+        //
+        // Receives the events read since the previous frame on the render thread, right before
+        // the Pre-Present callbacks
+        // 
+        PFN_INDICIUM_RAW_INPUT_BATCH EvtIndiciumRawInputBatch;
+
+        //
+        // Merge consecutive motion-only events of the same mouse, and consecutive reports of
+        // the same HID device, into one event
+        // 
+        BOOL CoalesceMouseMotion;
+
+    } INDICIUM_RAW_INPUT_CONFIG, *PINDICIUM_RAW_INPUT_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_RAW_INPUT_CONFIG_INIT( _Out_ PINDICIUM_RAW_INPUT_CONFIG Config, _In_ PFN_INDICIUM_RAW_INPUT_BATCH EvtIndiciumRawInputBatch );
+     *
+     * \brief   Initializes an INDICIUM_RAW_INPUT_CONFIG struct with mouse motion coalescing.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config                      The configuration.
+     * \param   EvtIndiciumRawInputBatch    The batch callback.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_RAW_INPUT_CONFIG_INIT(
+        _Out_ PINDICIUM_RAW_INPUT_CONFIG Config,
+        _In_ PFN_INDICIUM_RAW_INPUT_BATCH EvtIndiciumRawInputBatch
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_RAW_INPUT_CONFIG));
+
+        Config->EvtIndiciumRawInputBatch = EvtIndiciumRawInputBatch;
+        Config->CoalesceMouseMotion = TRUE;
+    }
+
+    typedef struct _INDICIUM_RAW_INPUT_STATISTICS
+    {
+        //
+        // Events read by the host
+        // 
+        ULONGLONG Events;
+
+        //
+        // Events left after merging, whether the batch callback or input recording got them
+        // 
+        ULONGLONG Delivered;
+
+        //
+        // Events merged into a preceding one
+        // 
+        ULONGLONG Coalesced;
+
+        //
+        // Events lost to a full buffer
+        // 
+        ULONGLONG Dropped;
+
+        //
+        // Batch callback invocations
+        // 
+        ULONGLONG Batches;
+
+    } INDICIUM_RAW_INPUT_STATISTICS, *PINDICIUM_RAW_INPUT_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineRawInputStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_RAW_INPUT_CONFIG Config );
+     *
+     * \brief   Starts collecting the raw input the host reads through GetRawInputData (the usual
+     *          WM_INPUT handling) and GetRawInputBuffer, delivering it once per frame. Requires
+     *          HookRawInput in the engine configuration. Starting again while running replaces
+     *          the configuration.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineRawInputStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_RAW_INPUT_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineRawInputStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops collecting raw input; events still queued get discarded.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineRawInputStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetRawInputStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_RAW_INPUT_STATISTICS Statistics );
+     *
+     * \brief   Reports the raw input collected since it got started.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Statistics  The statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetRawInputStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_RAW_INPUT_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumRawInput_h__
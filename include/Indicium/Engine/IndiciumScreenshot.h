@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumScreenshot_h__
+#define IndiciumScreenshot_h__
+
+#include "IndiciumCore.h"
+#include "IndiciumCapture.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct _INDICIUM_PNG_CONFIG
+    {
+        //
+        // zlib compression level from 1 (fastest) to 9 (smallest)
+        // 
+        INT CompressionLevel;
+
+        //
+        // Rows compressed independently per job, 0 picks chunks of roughly 256 KiB
+        // 
+        UINT32 RowsPerChunk;
+
+    } INDICIUM_PNG_CONFIG, *PINDICIUM_PNG_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_PNG_CONFIG_INIT( _Out_ PINDICIUM_PNG_CONFIG Config );
+     *
+     * \brief   Initializes an INDICIUM_PNG_CONFIG with zlib's default compression level.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config  The configuration.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_PNG_CONFIG_INIT(
+        _Out_ PINDICIUM_PNG_CONFIG Config
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_PNG_CONFIG));
+
+        Config->CompressionLevel = 6;
+    }
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineEncodePng( _In_ PINDICIUM_ENGINE Engine, _In_ const INDICIUM_CAPTURED_FRAME* Frame, _In_ PINDICIUM_PNG_CONFIG Config, _Out_opt_ PVOID Buffer, _In_ SIZE_T Capacity, _Out_ PSIZE_T Size );
+     *
+     * \brief   Encodes a captured frame as an RGB PNG, dropping alpha. The image gets split into
+     *          chunks of rows which are filtered and deflated in parallel on the engine worker
+     *          threads and the calling thread, then joined into a single zlib stream. Each chunk
+     *          is primed with the end of the previous one, so the result is about as small as a
+     *          single-threaded encode. Blocks until done; call it with a frame reference held
+     *          by a capture consumer rather than on the render thread. Pass no buffer to query
+     *          the worst-case size.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param           Frame       The captured frame, 8 or 10 bits per channel RGB(A) or BGR(A).
+     * \param           Config      The configuration.
+     * \param [out]     Buffer      If non-null, receives the PNG file contents.
+     * \param           Capacity    Size of Buffer in bytes.
+     * \param [out]     Size        The PNG size, or the worst-case size if Buffer is NULL.
+     *
+     * \returns INDICIUM_ERROR_BUFFER_TOO_SMALL if Capacity is below the worst-case size,
+     *          INDICIUM_ERROR_UNSUPPORTED_FORMAT for other pixel formats.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineEncodePng(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        const INDICIUM_CAPTURED_FRAME* Frame,
+        _In_
+        PINDICIUM_PNG_CONFIG Config,
+        _Out_opt_
+        PVOID Buffer,
+        _In_
+        SIZE_T Capacity,
+        _Out_
+        PSIZE_T Size
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineSavePng( _In_ PINDICIUM_ENGINE Engine, _In_ const INDICIUM_CAPTURED_FRAME* Frame, _In_ PINDICIUM_PNG_CONFIG Config, _In_ PCSTR Path );
+     *
+     * \brief   Encodes a captured frame like IndiciumEngineEncodePng and writes it to a file.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Frame   The captured frame.
+     * \param   Config  The configuration.
+     * \param   Path    The file path, replaced if it exists.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineSavePng(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        const INDICIUM_CAPTURED_FRAME* Frame,
+        _In_
+        PINDICIUM_PNG_CONFIG Config,
+        _In_
+        PCSTR Path
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumScreenshot_h__
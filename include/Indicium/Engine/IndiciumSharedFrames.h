@@ -0,0 +1,126 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumSharedFrames_h__
+#define IndiciumSharedFrames_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef struct _INDICIUM_SHARED_FRAMES_CONFIG
+    {
+        //
+        // Name of the file mapping readers open, e.g. "Local\\MyGameFrames"
+        // 
+        PCSTR Name;
+
+        //
+        // Swap chain or device whose frames get published, NULL for any
+        // 
+        PVOID Presenter;
+
+        //
+        // Index of the captured region to publish
+        // 
+        UINT32 Region;
+
+        //
+        // Bytes of pixel data each of the three slots holds; larger frames are skipped
+        // 
+        ULONGLONG MaximumFrameSize;
+
+    } INDICIUM_SHARED_FRAMES_CONFIG, *PINDICIUM_SHARED_FRAMES_CONFIG;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_SHARED_FRAMES_CONFIG_INIT( _Out_ PINDICIUM_SHARED_FRAMES_CONFIG Config, _In_ PCSTR Name );
+     *
+     * \brief   Initializes an INDICIUM_SHARED_FRAMES_CONFIG publishing the first region of any
+     *          presenter, up to 3840x2160 pixels of four bytes.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Config  The configuration.
+     * \param   Name    The mapping name.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_SHARED_FRAMES_CONFIG_INIT(
+        _Out_ PINDICIUM_SHARED_FRAMES_CONFIG Config,
+        _In_ PCSTR Name
+    )
+    {
+        ZeroMemory(Config, sizeof(INDICIUM_SHARED_FRAMES_CONFIG));
+
+        Config->Name = Name;
+        Config->MaximumFrameSize = 3840ULL * 2160ULL * 4ULL;
+    }
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineSharedFramesStart( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_SHARED_FRAMES_CONFIG Config );
+     *
+     * \brief   Publishes captured frames to other processes through a named shared memory triple
+     *          buffer, readable with IndiciumSharedFrames.hpp. Frames come from the running
+     *          capture (IndiciumEngineCaptureStart) and get written on a thread of their own;
+     *          when the writer falls behind, only the latest frame is kept. Starting again while
+     *          running recreates the mapping with the new configuration.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   Config  The configuration.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineSharedFramesStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_SHARED_FRAMES_CONFIG Config
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineSharedFramesStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops publishing and marks the mapping closed for its readers.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineSharedFramesStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumSharedFrames_h__
@@ -0,0 +1,550 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumSharedFrames_hpp__
+#define IndiciumSharedFrames_hpp__
+
+//
+// Header-only transport of captured frames through named shared memory, written by the engine
+// (IndiciumEngineSharedFramesStart) and read by any other process without injecting anything:
+//
+//     Indicium::SharedFrames::Reader reader;
+//
+//     if (reader.open("Local\\MyGameFrames"))
+//     {
+//         std::vector<uint8_t> pixels(reader.slot_capacity());
+//         Indicium::SharedFrames::FrameInfo info;
+//
+//         if (reader.read(info, pixels.data(), pixels.size()) == Indicium::SharedFrames::ReadResult::frame)
+//             // info.width x info.height pixels of info.format, info.pitch bytes per row
+//     }
+//
+// The mapping holds a header followed by three frame slots. The writer fills the slot published
+// longest ago and then publishes its index; a reader copies the latest slot out and validates
+// it against the slot's sequence number, retrying if the writer came around to it meanwhile.
+// Neither side ever waits for the other and any number of readers may attach.
+//
+// Only the mapping itself is platform specific: file mappings on Windows, POSIX shared memory
+// (shm_open) elsewhere, so both ends can be exercised on Linux.
+//
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Indicium
+{
+    namespace SharedFrames
+    {
+        static constexpr uint32_t layout_magic = 0x46534449;   // "IDSF"
+        static constexpr uint32_t layout_version = 1;
+        static constexpr uint32_t slot_count = 3;
+        static constexpr size_t alignment = 64;
+
+        /**
+         * \brief   Description of a published frame.
+         */
+        struct FrameInfo
+        {
+            uint64_t frame_number;          // running number of published frames, starting at 1
+            uint64_t capture_frame;         // frame number of the presenter it got captured from
+            int64_t capture_timestamp;      // ticks when the region got copied, right before Present
+            int64_t publish_timestamp;      // ticks when the frame got written to shared memory
+            uint32_t width;
+            uint32_t height;
+            uint32_t format;                // DXGI_FORMAT for Direct3D 10/11, D3DFORMAT for Direct3D 9
+            uint32_t pitch;                 // bytes between two rows
+            uint32_t back_buffer_width;
+            uint32_t back_buffer_height;
+            uint32_t left;                  // position of the region within the back buffer
+            uint32_t top;
+            uint64_t size;                  // bytes of pixel data, pitch * height
+        };
+
+        /**
+         * \brief   Start of the mapping; everything but the atomics is written once at creation.
+         */
+        struct alignas(alignment) Header
+        {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t slots;
+            uint32_t writer_process;
+            uint64_t slot_capacity;         // bytes of pixel data a slot holds
+            uint64_t slot_stride;
+            uint64_t ticks_per_second;      // timestamp resolution
+
+            //
+            // Set once the writer went away; readers should reopen the mapping by name
+            //
+            std::atomic<uint32_t> closed;
+
+            //
+            // Latest published frame as (frame_number << 2) | slot, 0 before the first one
+            //
+            alignas(alignment) std::atomic<uint64_t> latest;
+        };
+
+        struct alignas(alignment) Slot
+        {
+            //
+            // Odd while the writer fills the slot
+            //
+            std::atomic<uint64_t> sequence;
+            FrameInfo info;
+        };
+
+        static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && sizeof(uint64_t) == sizeof(long long),
+            "shared atomics must be lock-free");
+
+        static constexpr size_t align_up(size_t value)
+        {
+            return (value + alignment - 1) & ~(alignment - 1);
+        }
+
+        static constexpr size_t slot_data_offset = align_up(sizeof(Slot));
+
+        static constexpr size_t mapping_size(uint64_t slot_capacity)
+        {
+            return align_up(sizeof(Header)) + slot_count * align_up(slot_data_offset + size_t(slot_capacity));
+        }
+
+        /**
+         * \brief   A named shared memory mapping; created read/write by the writer, opened
+         *          read-only by readers.
+         */
+        class Mapping
+        {
+#ifdef _WIN32
+            HANDLE handle_ = nullptr;
+#else
+            int fd_ = -1;
+            std::string owned_name_;
+#endif
+            void* view_ = nullptr;
+            size_t size_ = 0;
+
+#ifndef _WIN32
+            //
+            // POSIX object names are a single path component with a leading slash
+            //
+            static std::string object_name(const char* name)
+            {
+                return name[0] == '/' ? std::string(name) : '/' + std::string(name);
+            }
+#endif
+
+        public:
+            Mapping() = default;
+            Mapping(const Mapping&) = delete;
+            Mapping& operator=(const Mapping&) = delete;
+
+            ~Mapping()
+            {
+                close();
+            }
+
+            bool create(const char* name, size_t size)
+            {
+                close();
+#ifdef _WIN32
+                handle_ = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                    static_cast<DWORD>(uint64_t(size) >> 32), static_cast<DWORD>(size), name);
+
+                if (!handle_)
+                    return false;
+
+                //
+                // A reader may still hold the mapping of a previous writer; it fails here if too small
+                //
+                view_ = MapViewOfFile(handle_, FILE_MAP_WRITE, 0, 0, size);
+#else
+                owned_name_ = object_name(name);
+
+                //
+                // Start over with a fresh object, readers of a previous one keep theirs
+                //
+                shm_unlink(owned_name_.c_str());
+
+                fd_ = shm_open(owned_name_.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+
+                if (fd_ < 0 || ftruncate(fd_, static_cast<off_t>(size)) != 0)
+                {
+                    close();
+                    return false;
+                }
+
+                view_ = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+
+                if (view_ == MAP_FAILED)
+                    view_ = nullptr;
+#endif
+                if (!view_)
+                {
+                    close();
+                    return false;
+                }
+
+                size_ = size;
+                return true;
+            }
+
+            bool open(const char* name)
+            {
+                close();
+#ifdef _WIN32
+                handle_ = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+
+                if (!handle_)
+                    return false;
+
+                view_ = MapViewOfFile(handle_, FILE_MAP_READ, 0, 0, 0);
+
+                MEMORY_BASIC_INFORMATION info;
+
+                if (view_ && VirtualQuery(view_, &info, sizeof(info)))
+                    size_ = info.RegionSize;
+#else
+                fd_ = shm_open(object_name(name).c_str(), O_RDONLY, 0);
+
+                struct stat status;
+
+                if (fd_ < 0 || fstat(fd_, &status) != 0 || status.st_size <= 0)
+                {
+                    close();
+                    return false;
+                }
+
+                size_ = static_cast<size_t>(status.st_size);
+                view_ = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd_, 0);
+
+                if (view_ == MAP_FAILED)
+                    view_ = nullptr;
+#endif
+                if (!view_)
+                {
+                    close();
+                    return false;
+                }
+
+                return true;
+            }
+
+            void close()
+            {
+#ifdef _WIN32
+                if (view_)
+                    UnmapViewOfFile(view_);
+
+                if (handle_)
+                    CloseHandle(handle_);
+
+                handle_ = nullptr;
+#else
+                if (view_)
+                    munmap(view_, size_);
+
+                if (fd_ >= 0)
+                    ::close(fd_);
+
+                if (!owned_name_.empty())
+                    shm_unlink(owned_name_.c_str());
+
+                fd_ = -1;
+                owned_name_.clear();
+#endif
+                view_ = nullptr;
+                size_ = 0;
+            }
+
+            void* view() const
+            {
+                return view_;
+            }
+
+            size_t size() const
+            {
+                return size_;
+            }
+        };
+
+        /**
+         * \brief   Publishing end; a single thread writes.
+         */
+        class Writer
+        {
+            Mapping mapping_;
+            Header* header_ = nullptr;
+            uint64_t published_ = 0;
+            uint32_t slot_ = slot_count - 1;
+
+            Slot& slot(uint32_t index) const
+            {
+                return *reinterpret_cast<Slot*>(reinterpret_cast<uint8_t*>(header_)
+                    + align_up(sizeof(Header)) + index * header_->slot_stride);
+            }
+
+        public:
+            Writer() = default;
+            Writer(const Writer&) = delete;
+            Writer& operator=(const Writer&) = delete;
+
+            ~Writer()
+            {
+                close();
+            }
+
+            bool create(const char* name, uint64_t slot_capacity, uint64_t ticks_per_second, uint32_t process)
+            {
+                close();
+
+                if (!mapping_.create(name, mapping_size(slot_capacity)))
+                    return false;
+
+                header_ = static_cast<Header*>(mapping_.view());
+
+                //
+                // Keep slot sequences of a reused mapping moving forward so readers of the
+                // previous writer never validate a torn copy
+                //
+                for (uint32_t index = 0; index < slot_count; index++)
+                {
+                    auto& s = slot(index);
+                    s.sequence.store((s.sequence.load(std::memory_order_relaxed) + 2) & ~uint64_t(1),
+                        std::memory_order_relaxed);
+                }
+
+                header_->latest.store(0, std::memory_order_relaxed);
+                header_->closed.store(0, std::memory_order_relaxed);
+                header_->version = layout_version;
+                header_->slots = slot_count;
+                header_->writer_process = process;
+                header_->slot_capacity = slot_capacity;
+                header_->slot_stride = align_up(slot_data_offset + size_t(slot_capacity));
+                header_->ticks_per_second = ticks_per_second;
+
+                //
+                // Readers check the magic last, after everything else is in place
+                //
+                std::atomic_thread_fence(std::memory_order_release);
+                header_->magic = layout_magic;
+
+                published_ = 0;
+                slot_ = slot_count - 1;
+
+                return true;
+            }
+
+            /**
+             * \brief   Publishes a frame of info.size bytes; frame_number gets assigned here.
+             *          Fails if the frame exceeds the slot capacity.
+             */
+            bool publish(FrameInfo info, const void* data)
+            {
+                if (!header_ || info.size > header_->slot_capacity)
+                    return false;
+
+                slot_ = (slot_ + 1) % slot_count;
+                info.frame_number = ++published_;
+
+                auto& s = slot(slot_);
+                const auto sequence = s.sequence.load(std::memory_order_relaxed);
+
+                //
+                // Mark the slot busy before touching its contents
+                //
+                s.sequence.store(sequence + 1, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_release);
+
+                std::memcpy(&s.info, &info, sizeof(info));
+                std::memcpy(reinterpret_cast<uint8_t*>(&s) + slot_data_offset, data, size_t(info.size));
+
+                s.sequence.store(sequence + 2, std::memory_order_release);
+                header_->latest.store((published_ << 2) | slot_, std::memory_order_release);
+
+                return true;
+            }
+
+            void close()
+            {
+                if (header_)
+                    header_->closed.store(1, std::memory_order_release);
+
+                header_ = nullptr;
+                mapping_.close();
+            }
+
+            uint64_t slot_capacity() const
+            {
+                return header_ ? header_->slot_capacity : 0;
+            }
+        };
+
+        enum class ReadResult
+        {
+            nothing_new,        // no frame published since the last read
+            frame,              // info and pixels got copied
+            buffer_too_small,   // info got copied, the pixels need info.size bytes
+            closed              // the writer went away; reopen to attach to a new one
+        };
+
+        /**
+         * \brief   Reading end; each reader keeps track of the last frame it saw.
+         */
+        class Reader
+        {
+            Mapping mapping_;
+            const Header* header_ = nullptr;
+            uint64_t last_ = 0;
+
+            const Slot& slot(uint32_t index) const
+            {
+                return *reinterpret_cast<const Slot*>(reinterpret_cast<const uint8_t*>(header_)
+                    + align_up(sizeof(Header)) + index * header_->slot_stride);
+            }
+
+        public:
+            Reader() = default;
+            Reader(const Reader&) = delete;
+            Reader& operator=(const Reader&) = delete;
+
+            bool open(const char* name)
+            {
+                close();
+
+                if (!mapping_.open(name) || mapping_.size() < align_up(sizeof(Header)))
+                {
+                    close();
+                    return false;
+                }
+
+                const auto header = static_cast<const Header*>(mapping_.view());
+
+                if (header->magic != layout_magic)
+                {
+                    close();
+                    return false;
+                }
+
+                std::atomic_thread_fence(std::memory_order_acquire);
+
+                if (header->version != layout_version || header->slots != slot_count
+                    || mapping_.size() < mapping_size(header->slot_capacity))
+                {
+                    close();
+                    return false;
+                }
+
+                header_ = header;
+                return true;
+            }
+
+            void close()
+            {
+                header_ = nullptr;
+                last_ = 0;
+                mapping_.close();
+            }
+
+            bool is_open() const
+            {
+                return header_ != nullptr;
+            }
+
+            uint64_t slot_capacity() const
+            {
+                return header_ ? header_->slot_capacity : 0;
+            }
+
+            uint64_t ticks_per_second() const
+            {
+                return header_ ? header_->ticks_per_second : 0;
+            }
+
+            /**
+             * \brief   Copies the latest frame unless it was read before. Frames published in
+             *          between are skipped, only the newest one matters.
+             */
+            ReadResult read(FrameInfo& info, void* data, size_t capacity)
+            {
+                if (!header_)
+                    return ReadResult::closed;
+
+                for (int attempt = 0; attempt < 4; attempt++)
+                {
+                    const auto latest = header_->latest.load(std::memory_order_acquire);
+
+                    if ((latest >> 2) <= last_)
+                    {
+                        return header_->closed.load(std::memory_order_acquire)
+                            ? ReadResult::closed : ReadResult::nothing_new;
+                    }
+
+                    const auto& s = slot(uint32_t(latest & 3));
+                    const auto sequence = s.sequence.load(std::memory_order_acquire);
+
+                    //
+                    // The writer already came around to this slot again, look for a newer one
+                    //
+                    if (sequence & 1)
+                        continue;
+
+                    std::memcpy(&info, &s.info, sizeof(info));
+
+                    const auto fits = info.size <= capacity && info.size <= header_->slot_capacity;
+
+                    if (fits)
+                        std::memcpy(data, reinterpret_cast<const uint8_t*>(&s) + slot_data_offset, size_t(info.size));
+
+                    std::atomic_thread_fence(std::memory_order_acquire);
+
+                    if (s.sequence.load(std::memory_order_relaxed) != sequence)
+                        continue;
+
+                    if (!fits)
+                        return ReadResult::buffer_too_small;
+
+                    last_ = info.frame_number;
+                    return ReadResult::frame;
+                }
+
+                return ReadResult::nothing_new;
+            }
+        };
+    };
+};
+
+#endif // IndiciumSharedFrames_hpp__
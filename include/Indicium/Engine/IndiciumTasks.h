@@ -0,0 +1,303 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumTasks_h__
+#define IndiciumTasks_h__
+
+#include "IndiciumCore.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    //
+    // Identifies a registered Post-Present task
+    // 
+    typedef UINT32 INDICIUM_TASK_ID, *PINDICIUM_TASK_ID;
+
+    typedef struct _INDICIUM_POST_PRESENT_FRAME
+    {
+        //
+        // The engine handle
+        // 
+        PINDICIUM_ENGINE Engine;
+
+        //
+        // Running number of the presented frame
+        // 
+        ULONGLONG FrameNumber;
+
+        //
+        // Performance counter value taken when Present returned
+        // 
+        LONGLONG Timestamp;
+
+        //
+        // Render API the frame was presented with
+        // 
+        INDICIUM_D3D_VERSION Version;
+
+        //
+        // Value returned by the original Present call
+        // 
+        HRESULT PresentResult;
+
+        //
+        // Swap chain or device which presented; only valid for tasks using the device context
+        // 
+        PVOID Presenter;
+
+    } INDICIUM_POST_PRESENT_FRAME, *PINDICIUM_POST_PRESENT_FRAME;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_POST_PRESENT_TASK)
+        VOID
+        EVT_INDICIUM_POST_PRESENT_TASK(
+            const INDICIUM_POST_PRESENT_FRAME   *Frame,
+            PVOID                               Context
+        );
+
+    typedef EVT_INDICIUM_POST_PRESENT_TASK *PFN_INDICIUM_POST_PRESENT_TASK;
+
+    typedef struct _INDICIUM_POST_PRESENT_TASK
+    {
+        //
+        // Task routine invoked once per presented frame
+        // 
+        PFN_INDICIUM_POST_PRESENT_TASK EvtIndiciumPostPresentTask;
+
+        //
+        // Caller context passed to the task routine
+        // 
+        PVOID Context;
+
+        //
+        // TRUE if the task touches the device, its context or the swap chain. Such tasks run on
+        // the render thread right after Present; all others run on engine worker threads
+        // while the game continues with its next frame.
+        // 
+        BOOL UsesDeviceContext;
+
+        //
+        // Tasks which have to complete before this one starts; only previously added tasks
+        // can be referenced. Tasks using the device context can't depend on worker tasks.
+        // 
+        const INDICIUM_TASK_ID *Dependencies;
+
+        //
+        // Number of elements in Dependencies
+        // 
+        UINT32 DependencyCount;
+
+    } INDICIUM_POST_PRESENT_TASK, *PINDICIUM_POST_PRESENT_TASK;
+
+    /**
+     * \fn  VOID FORCEINLINE INDICIUM_POST_PRESENT_TASK_INIT( _Out_ PINDICIUM_POST_PRESENT_TASK Task, _In_ PFN_INDICIUM_POST_PRESENT_TASK EvtIndiciumPostPresentTask, _In_opt_ PVOID Context );
+     *
+     * \brief   Initializes an INDICIUM_POST_PRESENT_TASK for a worker task without dependencies.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Task                        The task description.
+     * \param   EvtIndiciumPostPresentTask  The task routine.
+     * \param   Context                     The caller context.
+     *
+     * \returns Nothing.
+     */
+    VOID FORCEINLINE INDICIUM_POST_PRESENT_TASK_INIT(
+        _Out_ PINDICIUM_POST_PRESENT_TASK Task,
+        _In_ PFN_INDICIUM_POST_PRESENT_TASK EvtIndiciumPostPresentTask,
+        _In_opt_ PVOID Context
+    )
+    {
+        ZeroMemory(Task, sizeof(INDICIUM_POST_PRESENT_TASK));
+
+        Task->EvtIndiciumPostPresentTask = EvtIndiciumPostPresentTask;
+        Task->Context = Context;
+    }
+
+    typedef struct _INDICIUM_POST_PRESENT_STATISTICS
+    {
+        //
+        // Frames for which the worker tasks were started
+        // 
+        ULONGLONG FramesDispatched;
+
+        //
+        // Frames for which the worker tasks were skipped because the previous frame's tasks
+        // were still running
+        // 
+        ULONGLONG FramesSkipped;
+
+        //
+        // Total number of task invocations
+        // 
+        ULONGLONG TasksExecuted;
+
+    } INDICIUM_POST_PRESENT_STATISTICS, *PINDICIUM_POST_PRESENT_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAddPostPresentTask( _In_ PINDICIUM_ENGINE Engine, _In_ PINDICIUM_POST_PRESENT_TASK Task, _Out_opt_ PINDICIUM_TASK_ID TaskId );
+     *
+     * \brief   Registers a task to run after every Present of any hooked render API.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine  The engine handle.
+     * \param           Task    The task description.
+     * \param [out]     TaskId  If non-null, the identifier to reference the task as dependency.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAddPostPresentTask(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PINDICIUM_POST_PRESENT_TASK Task,
+        _Out_opt_
+        PINDICIUM_TASK_ID TaskId
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineRemovePostPresentTask( _In_ PINDICIUM_ENGINE Engine, _In_ INDICIUM_TASK_ID TaskId );
+     *
+     * \brief   Removes a task. Waits for frames still running it, so the task routine doesn't run
+     *          anymore once this returns; can't be called from a task. Tasks depending on it keep
+     *          running as if it completed, and the identifiers of other tasks stay valid. Tasks
+     *          of a plugin get removed when it unloads.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     * \param   TaskId  The identifier returned when adding the task.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineRemovePostPresentTask(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        INDICIUM_TASK_ID TaskId
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetPostPresentStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_POST_PRESENT_STATISTICS Statistics );
+     *
+     * \brief   Reports how Post-Present tasks kept up with the frame rate.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Statistics  The task statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetPostPresentStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_POST_PRESENT_STATISTICS Statistics
+    );
+
+    typedef
+        _Function_class_(EVT_INDICIUM_ENGINE_TICK)
+        DWORD
+        EVT_INDICIUM_ENGINE_TICK(
+            PINDICIUM_ENGINE    EngineHandle,
+            PVOID               Context
+        );
+
+    typedef EVT_INDICIUM_ENGINE_TICK *PFN_INDICIUM_ENGINE_TICK;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineAddTickHandler( _In_ PINDICIUM_ENGINE Engine, _In_ PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick, _In_opt_ PVOID Context );
+     *
+     * \brief   Registers a handler run on the engine thread at every engine tick, the first time
+     *          right away. The handler returns the milliseconds until it needs to run again
+     *          (INFINITE if it has nothing scheduled); ticks come at least every 100 ms anyway.
+     *          Handlers can't add or remove handlers.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine                  The engine handle.
+     * \param   EvtIndiciumEngineTick   The handler.
+     * \param   Context                 The caller context passed to the handler.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineAddTickHandler(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick,
+        _In_opt_
+        PVOID Context
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineRemoveTickHandler( _In_ PINDICIUM_ENGINE Engine, _In_ PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick, _In_opt_ PVOID Context );
+     *
+     * \brief   Removes a handler added with the same routine and context. Waits for a tick in
+     *          progress, so the handler doesn't run anymore once this returns.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine                  The engine handle.
+     * \param   EvtIndiciumEngineTick   The handler.
+     * \param   Context                 The caller context it got added with.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineRemoveTickHandler(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick,
+        _In_opt_
+        PVOID Context
+    );
+
+    /**
+     * \fn  INDICIUM_API VOID IndiciumEngineRequestTick( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Wakes the engine thread for a tick before its next scheduled one, e.g. when a
+     *          handler's next deadline moved forward. Callable from any thread.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns Nothing.
+     */
+    INDICIUM_API VOID IndiciumEngineRequestTick(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumTasks_h__
@@ -0,0 +1,233 @@
+/*
+MIT License
+
+Copyright (c) 2018 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#ifndef IndiciumXInput_h__
+#define IndiciumXInput_h__
+
+#include "IndiciumCore.h"
+#include <Xinput.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+    typedef enum _INDICIUM_XINPUT_EVENT_TYPE
+    {
+        //
+        // XInputGetState succeeded for a controller which wasn't connected before; State is set
+        // 
+        IndiciumXInputEventConnected = 0,
+
+        //
+        // XInputGetState reported ERROR_DEVICE_NOT_CONNECTED for a connected controller
+        // 
+        IndiciumXInputEventDisconnected = 1,
+
+        //
+        // XInputGetState returned a new packet number; State is set
+        // 
+        IndiciumXInputEventState = 2,
+
+        //
+        // XInputSetState succeeded with different motor speeds; Vibration is set
+        // 
+        IndiciumXInputEventVibration = 3
+
+    } INDICIUM_XINPUT_EVENT_TYPE;
+
+    typedef struct _INDICIUM_XINPUT_EVENT
+    {
+        //
+        // Controller index, 0 to XUSER_MAX_COUNT - 1
+        // 
+        DWORD UserIndex;
+
+        INDICIUM_XINPUT_EVENT_TYPE Type;
+
+        //
+        // QueryPerformanceCounter value at which the host called XInput
+        // 
+        LONGLONG Timestamp;
+
+        union
+        {
+            XINPUT_STATE State;
+
+            XINPUT_VIBRATION Vibration;
+        };
+
+    } INDICIUM_XINPUT_EVENT, *PINDICIUM_XINPUT_EVENT;
+
+    typedef
+        _Function_class_(EVT_INDICIUM_XINPUT_BATCH)
+        VOID
+        EVT_INDICIUM_XINPUT_BATCH(
+            const INDICIUM_XINPUT_EVENT *Events,
+            SIZE_T                      Count,
+            ULONGLONG                   DroppedEvents,
+            PINDICIUM_EVT_POST_EXTENSION Extension
+        );
+
+    typedef EVT_INDICIUM_XINPUT_BATCH *PFN_INDICIUM_XINPUT_BATCH;
+
+    typedef struct _INDICIUM_XINPUT_SNAPSHOT
+    {
+        //
+        // TRUE if the latest XInputGetState call for this controller succeeded
+        // 
+        BOOL Connected;
+
+        //
+        // State returned by the latest successful XInputGetState call
+        // 
+        XINPUT_STATE State;
+
+        //
+        // Motor speeds of the latest successful XInputSetState call
+        // 
+        XINPUT_VIBRATION Vibration;
+
+        //
+        // QueryPerformanceCounter value of the latest change, zero if none was seen yet
+        // 
+        LONGLONG LastChange;
+
+        //
+        // QueryPerformanceCounter value of the latest XInputGetState call, zero if the host
+        // never polled this controller
+        // 
+        LONGLONG LastPoll;
+
+    } INDICIUM_XINPUT_SNAPSHOT, *PINDICIUM_XINPUT_SNAPSHOT;
+
+    typedef struct _INDICIUM_XINPUT_STATISTICS
+    {
+        //
+        // XInputGetState calls of the host
+        // 
+        ULONGLONG Polls;
+
+        //
+        // Events produced by these calls and XInputSetState, i.e. the polls which changed anything
+        // 
+        ULONGLONG Changes;
+
+        //
+        // Events handed to the batch callback
+        // 
+        ULONGLONG Delivered;
+
+        //
+        // Events lost to a full buffer
+        // 
+        ULONGLONG Dropped;
+
+    } INDICIUM_XINPUT_STATISTICS, *PINDICIUM_XINPUT_STATISTICS;
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineXInputStart( _In_ PINDICIUM_ENGINE Engine, _In_ PFN_INDICIUM_XINPUT_BATCH EvtIndiciumXInputBatch );
+     *
+     * \brief   Starts delivering controller changes seen in the XInput calls of the host, once
+     *          per frame on the render thread right before the Pre-Present callbacks. Polls
+     *          returning the same packet number produce no event. Requires HookXInput in the
+     *          engine configuration.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine                  The engine handle.
+     * \param   EvtIndiciumXInputBatch  The batch callback.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineXInputStart(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        PFN_INDICIUM_XINPUT_BATCH EvtIndiciumXInputBatch
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineXInputStop( _In_ PINDICIUM_ENGINE Engine );
+     *
+     * \brief   Stops delivering controller changes; snapshots stay available.
+     *
+     * \date    19.10.2026
+     *
+     * \param   Engine  The engine handle.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineXInputStop(
+        _In_
+        PINDICIUM_ENGINE Engine
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetXInputSnapshot( _In_ PINDICIUM_ENGINE Engine, _In_ DWORD UserIndex, _Out_ PINDICIUM_XINPUT_SNAPSHOT Snapshot );
+     *
+     * \brief   Gets the latest controller state seen by the hooks without calling XInput. May
+     *          be called from any thread at any time, no start is required.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param           UserIndex   Controller index, 0 to XUSER_MAX_COUNT - 1.
+     * \param [out]     Snapshot    The snapshot.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetXInputSnapshot(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _In_
+        DWORD UserIndex,
+        _Out_
+        PINDICIUM_XINPUT_SNAPSHOT Snapshot
+    );
+
+    /**
+     * \fn  INDICIUM_API INDICIUM_ERROR IndiciumEngineGetXInputStatistics( _In_ PINDICIUM_ENGINE Engine, _Out_ PINDICIUM_XINPUT_STATISTICS Statistics );
+     *
+     * \brief   Reports the XInput calls seen since the hooks got applied.
+     *
+     * \date    19.10.2026
+     *
+     * \param           Engine      The engine handle.
+     * \param [out]     Statistics  The statistics.
+     *
+     * \returns An INDICIUM_ERROR.
+     */
+    INDICIUM_API INDICIUM_ERROR IndiciumEngineGetXInputStatistics(
+        _In_
+        PINDICIUM_ENGINE Engine,
+        _Out_
+        PINDICIUM_XINPUT_STATISTICS Statistics
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // IndiciumXInput_h__
@@ -0,0 +1,34 @@
+<#
+.SYNOPSIS
+    Builds every proxy DLL variant of Indicium-Proxy.vcxproj.
+
+.DESCRIPTION
+    The proxy project produces one system library impersonation per build, selected by the
+    IndiciumProxyTarget property. This script builds all of them for the given configuration
+    and platform; the results end up in bin\<platform>\proxy\.
+
+.EXAMPLE
+    .\Build-Proxies.ps1 -Configuration Release -Platform x64
+#>
+param(
+    [string]$Configuration = "Release",
+    [string]$Platform = "x64",
+    [string[]]$Target = @("dxgi", "d3d9", "d3d11", "dinput8")
+)
+
+$ErrorActionPreference = "Stop"
+
+$project = Join-Path $PSScriptRoot "Indicium-Proxy.vcxproj"
+$solutionDir = (Resolve-Path (Join-Path $PSScriptRoot "..\..")).Path + "\"
+
+foreach ($name in $Target) {
+    msbuild $project /nologo /m /v:minimal `
+        "/p:Configuration=$Configuration" `
+        "/p:Platform=$Platform" `
+        "/p:SolutionDir=$solutionDir" `
+        "/p:IndiciumProxyTarget=$name"
+
+    if ($LASTEXITCODE -ne 0) {
+        throw "Building the $name proxy failed"
+    }
+}
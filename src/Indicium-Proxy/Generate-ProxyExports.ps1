@@ -0,0 +1,197 @@
+<#
+.SYNOPSIS
+    Generates the export forwarding stubs of the Indicium proxy DLLs.
+
+.DESCRIPTION
+    Reads exports\<target>.txt (one export name per line, '#' starts a comment, a leading
+    '!' marks creation functions which wait for the engine hooks) and writes to generated\:
+
+        <target>.def        module definition mapping every export to its stub
+        <target>.x86.asm    32-bit MASM stubs
+        <target>.x64.asm    64-bit MASM stubs
+        <target>.inc        export names in table order, included by dllmain.cpp
+
+    Every stub ends in a single indirect jump through IndiciumProxyTable. The table starts out
+    pointing at resolving stubs, which load the system DLL on the first call of any export
+    (outside the loader lock), let dllmain.cpp fill the table and continue with the export.
+    The arguments, return address and stack are left untouched, so the forwarded call behaves
+    exactly like a direct call into the system DLL.
+
+    The output is committed; re-run after changing an export list.
+
+.EXAMPLE
+    .\Generate-ProxyExports.ps1
+    .\Generate-ProxyExports.ps1 -Target dxgi
+#>
+param(
+    [string[]]$Target = @("dxgi", "d3d9", "d3d11", "dinput8")
+)
+
+$ErrorActionPreference = "Stop"
+
+$exportsDir = Join-Path $PSScriptRoot "exports"
+$outputDir = Join-Path $PSScriptRoot "generated"
+$header = "; Generated by Generate-ProxyExports.ps1 from exports\{0}.txt, do not edit"
+
+function Write-Lines([string]$Path, [string[]]$Lines) {
+    # LF line endings, no BOM, so regenerating never shows up as a whitespace diff
+    [IO.File]::WriteAllText($Path, (($Lines -join "`n") + "`n"))
+}
+
+foreach ($name in $Target) {
+    $exports = @(Get-Content (Join-Path $exportsDir "$name.txt") |
+        ForEach-Object { $_.Trim() } |
+        Where-Object { $_ -and -not $_.StartsWith("#") } |
+        ForEach-Object {
+            [pscustomobject]@{
+                Name  = $_.TrimStart("!")
+                Gated = $_.StartsWith("!")
+            }
+        })
+
+    #
+    # Module definition
+    #
+    $def = @(($header -f $name), "LIBRARY $name", "EXPORTS")
+    foreach ($export in $exports) {
+        # COM registration entry points must not end up in the import library
+        $private = if ($export.Name.StartsWith("Dll")) { " PRIVATE" } else { "" }
+        $def += "    $($export.Name)=IndiciumProxy_$($export.Name)$private"
+    }
+    Write-Lines (Join-Path $outputDir "$name.def") $def
+
+    #
+    # 32-bit stubs
+    #
+    $x86 = @(($header -f $name), ".686", ".model flat, C", "",
+        "PUBLIC IndiciumProxyTable", "EXTERN IndiciumProxyGate:PROC", "EXTERN IndiciumProxyResolve:PROC",
+        "", ".code", "")
+    for ($i = 0; $i -lt $exports.Count; $i++) {
+        $stub = "IndiciumProxy_$($exports[$i].Name)"
+        $x86 += "$stub PROC"
+        if ($exports[$i].Gated) {
+            # Stack arguments stay in place, ecx/edx are saved for fastcall and thiscall
+            $x86 += "    push ecx"
+            $x86 += "    push edx"
+            $x86 += "    call IndiciumProxyGate"
+            $x86 += "    pop edx"
+            $x86 += "    pop ecx"
+        }
+        $x86 += "    jmp dword ptr [IndiciumProxyTable + $i * 4]"
+        $x86 += "$stub ENDP"
+        $x86 += ""
+    }
+    # Register arguments survive the resolver, the table index travels in eax
+    $x86 += "IndiciumProxyResolveStub PROC"
+    $x86 += "    push ecx"
+    $x86 += "    push edx"
+    $x86 += "    push eax"
+    $x86 += "    call IndiciumProxyResolve"
+    $x86 += "    pop eax"
+    $x86 += "    pop edx"
+    $x86 += "    pop ecx"
+    $x86 += "    jmp dword ptr [IndiciumProxyTable + eax * 4]"
+    $x86 += "IndiciumProxyResolveStub ENDP"
+    $x86 += ""
+    for ($i = 0; $i -lt $exports.Count; $i++) {
+        $lazy = "IndiciumProxyLazy_$($exports[$i].Name)"
+        $x86 += "$lazy PROC"
+        $x86 += "    mov eax, $i"
+        $x86 += "    jmp IndiciumProxyResolveStub"
+        $x86 += "$lazy ENDP"
+        $x86 += ""
+    }
+    $x86 += ".data"
+    $x86 += ""
+    $x86 += "IndiciumProxyTable LABEL DWORD"
+    foreach ($export in $exports) {
+        $x86 += "    DWORD IndiciumProxyLazy_$($export.Name)"
+    }
+    $x86 += ""
+    $x86 += "END"
+    Write-Lines (Join-Path $outputDir "$name.x86.asm") $x86
+
+    #
+    # 64-bit stubs
+    #
+    $x64 = @(($header -f $name), "",
+        "PUBLIC IndiciumProxyTable", "EXTERN IndiciumProxyGate:PROC", "EXTERN IndiciumProxyResolve:PROC",
+        "", ".code", "")
+    for ($i = 0; $i -lt $exports.Count; $i++) {
+        $stub = "IndiciumProxy_$($exports[$i].Name)"
+        if ($exports[$i].Gated) {
+            # Spill the four integer register arguments around the gate, keeping rsp 16 byte
+            # aligned; gated exports take no floating point arguments, so xmm0-3 are not saved
+            $x64 += "$stub PROC FRAME"
+            foreach ($reg in "rcx", "rdx", "r8", "r9") {
+                $x64 += "    push $reg"
+                $x64 += "    .pushreg $reg"
+            }
+            $x64 += "    sub rsp, 28h"
+            $x64 += "    .allocstack 28h"
+            $x64 += "    .endprolog"
+            $x64 += "    call IndiciumProxyGate"
+            $x64 += "    add rsp, 28h"
+            foreach ($reg in "r9", "r8", "rdx", "rcx") {
+                $x64 += "    pop $reg"
+            }
+        }
+        else {
+            $x64 += "$stub PROC"
+        }
+        $x64 += "    jmp qword ptr [IndiciumProxyTable + $i * 8]"
+        $x64 += "$stub ENDP"
+        $x64 += ""
+    }
+    # Integer and floating point register arguments survive the resolver, the table index
+    # travels in rax; five pushes and 60h keep rsp 16 byte aligned at the call
+    $x64 += "IndiciumProxyResolveStub PROC FRAME"
+    foreach ($reg in "rcx", "rdx", "r8", "r9", "rax") {
+        $x64 += "    push $reg"
+        $x64 += "    .pushreg $reg"
+    }
+    $x64 += "    sub rsp, 60h"
+    $x64 += "    .allocstack 60h"
+    $x64 += "    .endprolog"
+    for ($r = 0; $r -lt 4; $r++) {
+        $x64 += "    movdqu xmmword ptr [rsp + $(2 + $r)0h], xmm$r"
+    }
+    $x64 += "    call IndiciumProxyResolve"
+    for ($r = 0; $r -lt 4; $r++) {
+        $x64 += "    movdqu xmm$r, xmmword ptr [rsp + $(2 + $r)0h]"
+    }
+    $x64 += "    add rsp, 60h"
+    foreach ($reg in "rax", "r9", "r8", "rdx", "rcx") {
+        $x64 += "    pop $reg"
+    }
+    $x64 += "    lea r10, IndiciumProxyTable"
+    $x64 += "    jmp qword ptr [r10 + rax * 8]"
+    $x64 += "IndiciumProxyResolveStub ENDP"
+    $x64 += ""
+    for ($i = 0; $i -lt $exports.Count; $i++) {
+        $lazy = "IndiciumProxyLazy_$($exports[$i].Name)"
+        $x64 += "$lazy PROC"
+        $x64 += "    mov eax, $i"
+        $x64 += "    jmp IndiciumProxyResolveStub"
+        $x64 += "$lazy ENDP"
+        $x64 += ""
+    }
+    $x64 += ".data"
+    $x64 += ""
+    $x64 += "IndiciumProxyTable LABEL QWORD"
+    foreach ($export in $exports) {
+        $x64 += "    QWORD IndiciumProxyLazy_$($export.Name)"
+    }
+    $x64 += ""
+    $x64 += "END"
+    Write-Lines (Join-Path $outputDir "$name.x64.asm") $x64
+
+    #
+    # Export names for GetProcAddress, in table order
+    #
+    $inc = @("// Generated by Generate-ProxyExports.ps1 from exports\$name.txt, do not edit")
+    $inc += $exports | ForEach-Object { "`"$($_.Name)`"," }
+    Write-Lines (Join-Path $outputDir "$name.inc") $inc
+
+    Write-Host "$name`: $($exports.Count) exports"
+}
@@ -0,0 +1,271 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Proxy loader: this DLL gets built under the name of a system library the game imports
+// (dxgi.dll, d3d9.dll, d3d11.dll or dinput8.dll, selected by the IndiciumProxyTarget MSBuild
+// property) and placed next to the game executable. Every export is a generated assembly stub
+// jumping through IndiciumProxyTable into the real system library, so forwarded calls cost
+// one indirect jump. The table starts out pointing at generated resolving stubs; the first
+// call of any export loads the system library, outside the loader lock, and fills it. Device
+// and factory creation exports additionally pass IndiciumProxyGate, which holds the caller
+// until the engine has its hooks in place.
+//
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#include <Indicium/Engine/IndiciumCore.h>
+
+#include <cstdio>
+
+#if defined(INDICIUM_PROXY_TARGET_dxgi)
+#define INDICIUM_PROXY_LIBRARY "dxgi.dll"
+#elif defined(INDICIUM_PROXY_TARGET_d3d9)
+#define INDICIUM_PROXY_LIBRARY "d3d9.dll"
+#elif defined(INDICIUM_PROXY_TARGET_d3d11)
+#define INDICIUM_PROXY_LIBRARY "d3d11.dll"
+#elif defined(INDICIUM_PROXY_TARGET_dinput8)
+#define INDICIUM_PROXY_LIBRARY "dinput8.dll"
+#else
+#error Unknown IndiciumProxyTarget, expected dxgi, d3d9, d3d11 or dinput8
+#endif
+
+//
+// Upper bound for holding back a creation call; a game must never hang on a failed hook
+//
+#define INDICIUM_PROXY_READY_TIMEOUT    5000
+
+//
+// STATUS_ENTRYPOINT_NOT_FOUND, ntstatus.h clashes with Windows.h
+//
+#define INDICIUM_PROXY_ENTRYPOINT_NOT_FOUND ((DWORD)0xC0000139L)
+
+static const char* const g_ProxyExportNames[] =
+{
+#if defined(INDICIUM_PROXY_TARGET_dxgi)
+#include "generated/dxgi.inc"
+#elif defined(INDICIUM_PROXY_TARGET_d3d9)
+#include "generated/d3d9.inc"
+#elif defined(INDICIUM_PROXY_TARGET_d3d11)
+#include "generated/d3d11.inc"
+#elif defined(INDICIUM_PROXY_TARGET_dinput8)
+#include "generated/dinput8.inc"
+#endif
+};
+
+extern "C"
+{
+	//
+	// Jump targets of the generated stubs, index matches g_ProxyExportNames; defined next to
+	// the stubs, pointing at the resolving ones until IndiciumProxyResolve ran
+	// 
+	extern FARPROC IndiciumProxyTable[ARRAYSIZE(g_ProxyExportNames)];
+
+	void IndiciumProxyGate();
+	void IndiciumProxyResolve();
+}
+
+static HMODULE g_SystemLibrary = nullptr;
+static PINDICIUM_ENGINE g_Engine = nullptr;
+static INIT_ONCE g_ResolveOnce = INIT_ONCE_STATIC_INIT;
+
+//
+// Set once the engine got ready, failed or timed out; later creation calls forward right away
+// 
+static volatile LONG g_GateOpen = FALSE;
+
+/**
+ * \fn	static void ProxyUnresolvedExport()
+ *
+ * \brief	Jump target for exports the installed system library doesn't provide (older Windows
+ * 			builds). The calling convention is unknown, so the only safe thing to do is raising
+ * 			the same error the loader would have raised for a missing import.
+ *
+ * \date	19.10.2026
+ */
+static void ProxyUnresolvedExport()
+{
+	RaiseException(INDICIUM_PROXY_ENTRYPOINT_NOT_FOUND, EXCEPTION_NONCONTINUABLE, 0, nullptr);
+}
+
+/**
+ * \fn	static BOOL ProxyLoadSystemLibrary()
+ *
+ * \brief	Loads the genuine library from the system directory and resolves all forwarded exports.
+ *
+ * \date	19.10.2026
+ *
+ * \returns	TRUE on success, FALSE if the system library couldn't be loaded.
+ */
+static BOOL ProxyLoadSystemLibrary()
+{
+	CHAR path[MAX_PATH];
+	const auto length = GetSystemDirectoryA(path, MAX_PATH);
+
+	if (length == 0 || length >= MAX_PATH) {
+		return FALSE;
+	}
+
+	if (sprintf_s(path + length, MAX_PATH - length, "\\%s", INDICIUM_PROXY_LIBRARY) < 0) {
+		return FALSE;
+	}
+
+	//
+	// Full path, otherwise the loader would hand us back our own module
+	// 
+	g_SystemLibrary = LoadLibraryA(path);
+
+	if (!g_SystemLibrary) {
+		return FALSE;
+	}
+
+	for (size_t i = 0; i < ARRAYSIZE(g_ProxyExportNames); i++)
+	{
+		const auto proc = GetProcAddress(g_SystemLibrary, g_ProxyExportNames[i]);
+
+		IndiciumProxyTable[i] = proc ? proc : reinterpret_cast<FARPROC>(ProxyUnresolvedExport);
+	}
+
+	return TRUE;
+}
+
+/**
+ * \fn	static BOOL CALLBACK ProxyResolveOnce(PINIT_ONCE, PVOID, PVOID*)
+ *
+ * \brief	Fills IndiciumProxyTable from the system library. Exports it lacks, or all of them if
+ * 			it can't be loaded, raise the error the loader raises for a missing import.
+ *
+ * \date	19.10.2026
+ *
+ * \returns	TRUE, the table is usable either way.
+ */
+static BOOL CALLBACK ProxyResolveOnce(PINIT_ONCE, PVOID, PVOID*)
+{
+	if (!ProxyLoadSystemLibrary())
+	{
+		for (size_t i = 0; i < ARRAYSIZE(g_ProxyExportNames); i++)
+			IndiciumProxyTable[i] = reinterpret_cast<FARPROC>(ProxyUnresolvedExport);
+	}
+
+	return TRUE;
+}
+
+/**
+ * \fn	void IndiciumProxyResolve()
+ *
+ * \brief	Called by the resolving stubs on the first call of every export until the table is
+ * 			filled; concurrent first calls wait for the one resolving.
+ *
+ * \date	19.10.2026
+ */
+void IndiciumProxyResolve()
+{
+	(void)InitOnceExecuteOnce(&g_ResolveOnce, ProxyResolveOnce, nullptr, nullptr);
+}
+
+/**
+ * \fn	void IndiciumProxyGate()
+ *
+ * \brief	Called by the stubs of creation exports before forwarding. Blocks until the engine
+ * 			has hooked the render pipelines so the device about to be created gets intercepted.
+ * 			The first wait settles it: ready, failed or timed out, later calls pass right away.
+ *
+ * \date	19.10.2026
+ */
+void IndiciumProxyGate()
+{
+	if (!g_Engine || g_GateOpen) {
+		return;
+	}
+
+	(void)IndiciumEngineWaitForReady(g_Engine, INDICIUM_PROXY_READY_TIMEOUT);
+
+	InterlockedExchange(&g_GateOpen, TRUE);
+}
+
+/**
+ * \fn	BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID)
+ *
+ * \brief	Bootstraps the engine. Plugins are loaded from the "Plugins" directory next to this
+ * 			DLL. Nothing here loads libraries or waits, the loader lock is held.
+ *
+ * \date	19.10.2026
+ *
+ * \param	hInstance 	The instance.
+ * \param	dwReason  	The reason.
+ * \param	parameter3	The third parameter.
+ *
+ * \returns	A WINAPI.
+ */
+BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID)
+{
+	switch (dwReason)
+	{
+	case DLL_PROCESS_ATTACH:
+	{
+		DisableThreadLibraryCalls(static_cast<HMODULE>(hInstance));
+
+		//
+		// The engine thread runs our code until the process exits; pinned, detaching only ever
+		// happens at process exit
+		// 
+		HMODULE pinned;
+		(void)GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_PIN,
+			reinterpret_cast<LPCSTR>(&DllMain), &pinned);
+
+		INDICIUM_ENGINE_CONFIG cfg;
+		INDICIUM_ENGINE_CONFIG_INIT(&cfg);
+
+		cfg.Direct3D.HookDirect3D9 = TRUE;
+		cfg.Direct3D.HookDirect3D10 = TRUE;
+		cfg.Direct3D.HookDirect3D11 = TRUE;
+		cfg.Direct3D.HookDirect3D12 = TRUE;
+		cfg.PluginHost.IsEnabled = TRUE;
+
+		//
+		// Engine thread starts once the loader lock is released, creation exports wait for it
+		// 
+		(void)IndiciumEngineCreate(
+			static_cast<HMODULE>(hInstance),
+			&cfg,
+			&g_Engine
+		);
+
+		break;
+	}
+	case DLL_PROCESS_DETACH:
+
+		//
+		// Process exit: other threads are gone already, and tearing down the engine would wait
+		// for its thread under the loader lock. The system library stays loaded as well.
+		// 
+		break;
+	default:
+		break;
+	}
+
+	return TRUE;
+}
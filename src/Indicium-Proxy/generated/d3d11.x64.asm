@@ -0,0 +1,597 @@
+; Generated by Generate-ProxyExports.ps1 from exports\d3d11.txt, do not edit
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_CreateDirect3D11DeviceFromDXGIDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 0 * 8]
+IndiciumProxy_CreateDirect3D11DeviceFromDXGIDevice ENDP
+
+IndiciumProxy_CreateDirect3D11SurfaceFromDXGISurface PROC
+    jmp qword ptr [IndiciumProxyTable + 1 * 8]
+IndiciumProxy_CreateDirect3D11SurfaceFromDXGISurface ENDP
+
+IndiciumProxy_D3D11CoreCreateDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 2 * 8]
+IndiciumProxy_D3D11CoreCreateDevice ENDP
+
+IndiciumProxy_D3D11CoreCreateLayeredDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 3 * 8]
+IndiciumProxy_D3D11CoreCreateLayeredDevice ENDP
+
+IndiciumProxy_D3D11CoreGetLayeredDeviceSize PROC
+    jmp qword ptr [IndiciumProxyTable + 4 * 8]
+IndiciumProxy_D3D11CoreGetLayeredDeviceSize ENDP
+
+IndiciumProxy_D3D11CoreRegisterLayers PROC
+    jmp qword ptr [IndiciumProxyTable + 5 * 8]
+IndiciumProxy_D3D11CoreRegisterLayers ENDP
+
+IndiciumProxy_D3D11CreateDevice PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 6 * 8]
+IndiciumProxy_D3D11CreateDevice ENDP
+
+IndiciumProxy_D3D11CreateDeviceAndSwapChain PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 7 * 8]
+IndiciumProxy_D3D11CreateDeviceAndSwapChain ENDP
+
+IndiciumProxy_D3D11On12CreateDevice PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 8 * 8]
+IndiciumProxy_D3D11On12CreateDevice ENDP
+
+IndiciumProxy_D3DKMTCloseAdapter PROC
+    jmp qword ptr [IndiciumProxyTable + 9 * 8]
+IndiciumProxy_D3DKMTCloseAdapter ENDP
+
+IndiciumProxy_D3DKMTCreateAllocation PROC
+    jmp qword ptr [IndiciumProxyTable + 10 * 8]
+IndiciumProxy_D3DKMTCreateAllocation ENDP
+
+IndiciumProxy_D3DKMTCreateContext PROC
+    jmp qword ptr [IndiciumProxyTable + 11 * 8]
+IndiciumProxy_D3DKMTCreateContext ENDP
+
+IndiciumProxy_D3DKMTCreateDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 12 * 8]
+IndiciumProxy_D3DKMTCreateDevice ENDP
+
+IndiciumProxy_D3DKMTCreateSynchronizationObject PROC
+    jmp qword ptr [IndiciumProxyTable + 13 * 8]
+IndiciumProxy_D3DKMTCreateSynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTDestroyAllocation PROC
+    jmp qword ptr [IndiciumProxyTable + 14 * 8]
+IndiciumProxy_D3DKMTDestroyAllocation ENDP
+
+IndiciumProxy_D3DKMTDestroyContext PROC
+    jmp qword ptr [IndiciumProxyTable + 15 * 8]
+IndiciumProxy_D3DKMTDestroyContext ENDP
+
+IndiciumProxy_D3DKMTDestroyDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 16 * 8]
+IndiciumProxy_D3DKMTDestroyDevice ENDP
+
+IndiciumProxy_D3DKMTDestroySynchronizationObject PROC
+    jmp qword ptr [IndiciumProxyTable + 17 * 8]
+IndiciumProxy_D3DKMTDestroySynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTEscape PROC
+    jmp qword ptr [IndiciumProxyTable + 18 * 8]
+IndiciumProxy_D3DKMTEscape ENDP
+
+IndiciumProxy_D3DKMTGetContextSchedulingPriority PROC
+    jmp qword ptr [IndiciumProxyTable + 19 * 8]
+IndiciumProxy_D3DKMTGetContextSchedulingPriority ENDP
+
+IndiciumProxy_D3DKMTGetDeviceState PROC
+    jmp qword ptr [IndiciumProxyTable + 20 * 8]
+IndiciumProxy_D3DKMTGetDeviceState ENDP
+
+IndiciumProxy_D3DKMTGetDisplayModeList PROC
+    jmp qword ptr [IndiciumProxyTable + 21 * 8]
+IndiciumProxy_D3DKMTGetDisplayModeList ENDP
+
+IndiciumProxy_D3DKMTGetMultisampleMethodList PROC
+    jmp qword ptr [IndiciumProxyTable + 22 * 8]
+IndiciumProxy_D3DKMTGetMultisampleMethodList ENDP
+
+IndiciumProxy_D3DKMTGetRuntimeData PROC
+    jmp qword ptr [IndiciumProxyTable + 23 * 8]
+IndiciumProxy_D3DKMTGetRuntimeData ENDP
+
+IndiciumProxy_D3DKMTGetSharedPrimaryHandle PROC
+    jmp qword ptr [IndiciumProxyTable + 24 * 8]
+IndiciumProxy_D3DKMTGetSharedPrimaryHandle ENDP
+
+IndiciumProxy_D3DKMTLock PROC
+    jmp qword ptr [IndiciumProxyTable + 25 * 8]
+IndiciumProxy_D3DKMTLock ENDP
+
+IndiciumProxy_D3DKMTOpenAdapterFromHdc PROC
+    jmp qword ptr [IndiciumProxyTable + 26 * 8]
+IndiciumProxy_D3DKMTOpenAdapterFromHdc ENDP
+
+IndiciumProxy_D3DKMTOpenResource PROC
+    jmp qword ptr [IndiciumProxyTable + 27 * 8]
+IndiciumProxy_D3DKMTOpenResource ENDP
+
+IndiciumProxy_D3DKMTPresent PROC
+    jmp qword ptr [IndiciumProxyTable + 28 * 8]
+IndiciumProxy_D3DKMTPresent ENDP
+
+IndiciumProxy_D3DKMTQueryAdapterInfo PROC
+    jmp qword ptr [IndiciumProxyTable + 29 * 8]
+IndiciumProxy_D3DKMTQueryAdapterInfo ENDP
+
+IndiciumProxy_D3DKMTQueryAllocationResidency PROC
+    jmp qword ptr [IndiciumProxyTable + 30 * 8]
+IndiciumProxy_D3DKMTQueryAllocationResidency ENDP
+
+IndiciumProxy_D3DKMTQueryResourceInfo PROC
+    jmp qword ptr [IndiciumProxyTable + 31 * 8]
+IndiciumProxy_D3DKMTQueryResourceInfo ENDP
+
+IndiciumProxy_D3DKMTRender PROC
+    jmp qword ptr [IndiciumProxyTable + 32 * 8]
+IndiciumProxy_D3DKMTRender ENDP
+
+IndiciumProxy_D3DKMTSetAllocationPriority PROC
+    jmp qword ptr [IndiciumProxyTable + 33 * 8]
+IndiciumProxy_D3DKMTSetAllocationPriority ENDP
+
+IndiciumProxy_D3DKMTSetContextSchedulingPriority PROC
+    jmp qword ptr [IndiciumProxyTable + 34 * 8]
+IndiciumProxy_D3DKMTSetContextSchedulingPriority ENDP
+
+IndiciumProxy_D3DKMTSetDisplayMode PROC
+    jmp qword ptr [IndiciumProxyTable + 35 * 8]
+IndiciumProxy_D3DKMTSetDisplayMode ENDP
+
+IndiciumProxy_D3DKMTSetDisplayPrivateDriverFormat PROC
+    jmp qword ptr [IndiciumProxyTable + 36 * 8]
+IndiciumProxy_D3DKMTSetDisplayPrivateDriverFormat ENDP
+
+IndiciumProxy_D3DKMTSetGammaRamp PROC
+    jmp qword ptr [IndiciumProxyTable + 37 * 8]
+IndiciumProxy_D3DKMTSetGammaRamp ENDP
+
+IndiciumProxy_D3DKMTSetVidPnSourceOwner PROC
+    jmp qword ptr [IndiciumProxyTable + 38 * 8]
+IndiciumProxy_D3DKMTSetVidPnSourceOwner ENDP
+
+IndiciumProxy_D3DKMTSignalSynchronizationObject PROC
+    jmp qword ptr [IndiciumProxyTable + 39 * 8]
+IndiciumProxy_D3DKMTSignalSynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTUnlock PROC
+    jmp qword ptr [IndiciumProxyTable + 40 * 8]
+IndiciumProxy_D3DKMTUnlock ENDP
+
+IndiciumProxy_D3DKMTWaitForSynchronizationObject PROC
+    jmp qword ptr [IndiciumProxyTable + 41 * 8]
+IndiciumProxy_D3DKMTWaitForSynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTWaitForVerticalBlankEvent PROC
+    jmp qword ptr [IndiciumProxyTable + 42 * 8]
+IndiciumProxy_D3DKMTWaitForVerticalBlankEvent ENDP
+
+IndiciumProxy_D3DPerformance_BeginEvent PROC
+    jmp qword ptr [IndiciumProxyTable + 43 * 8]
+IndiciumProxy_D3DPerformance_BeginEvent ENDP
+
+IndiciumProxy_D3DPerformance_EndEvent PROC
+    jmp qword ptr [IndiciumProxyTable + 44 * 8]
+IndiciumProxy_D3DPerformance_EndEvent ENDP
+
+IndiciumProxy_D3DPerformance_GetStatus PROC
+    jmp qword ptr [IndiciumProxyTable + 45 * 8]
+IndiciumProxy_D3DPerformance_GetStatus ENDP
+
+IndiciumProxy_D3DPerformance_SetMarker PROC
+    jmp qword ptr [IndiciumProxyTable + 46 * 8]
+IndiciumProxy_D3DPerformance_SetMarker ENDP
+
+IndiciumProxy_EnableFeatureLevelUpgrade PROC
+    jmp qword ptr [IndiciumProxyTable + 47 * 8]
+IndiciumProxy_EnableFeatureLevelUpgrade ENDP
+
+IndiciumProxy_OpenAdapter10 PROC
+    jmp qword ptr [IndiciumProxyTable + 48 * 8]
+IndiciumProxy_OpenAdapter10 ENDP
+
+IndiciumProxy_OpenAdapter10_2 PROC
+    jmp qword ptr [IndiciumProxyTable + 49 * 8]
+IndiciumProxy_OpenAdapter10_2 ENDP
+
+IndiciumProxyResolveStub PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    push rax
+    .pushreg rax
+    sub rsp, 60h
+    .allocstack 60h
+    .endprolog
+    movdqu xmmword ptr [rsp + 20h], xmm0
+    movdqu xmmword ptr [rsp + 30h], xmm1
+    movdqu xmmword ptr [rsp + 40h], xmm2
+    movdqu xmmword ptr [rsp + 50h], xmm3
+    call IndiciumProxyResolve
+    movdqu xmm0, xmmword ptr [rsp + 20h]
+    movdqu xmm1, xmmword ptr [rsp + 30h]
+    movdqu xmm2, xmmword ptr [rsp + 40h]
+    movdqu xmm3, xmmword ptr [rsp + 50h]
+    add rsp, 60h
+    pop rax
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    lea r10, IndiciumProxyTable
+    jmp qword ptr [r10 + rax * 8]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_CreateDirect3D11DeviceFromDXGIDevice PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDirect3D11DeviceFromDXGIDevice ENDP
+
+IndiciumProxyLazy_CreateDirect3D11SurfaceFromDXGISurface PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDirect3D11SurfaceFromDXGISurface ENDP
+
+IndiciumProxyLazy_D3D11CoreCreateDevice PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreCreateDevice ENDP
+
+IndiciumProxyLazy_D3D11CoreCreateLayeredDevice PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreCreateLayeredDevice ENDP
+
+IndiciumProxyLazy_D3D11CoreGetLayeredDeviceSize PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreGetLayeredDeviceSize ENDP
+
+IndiciumProxyLazy_D3D11CoreRegisterLayers PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreRegisterLayers ENDP
+
+IndiciumProxyLazy_D3D11CreateDevice PROC
+    mov eax, 6
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CreateDevice ENDP
+
+IndiciumProxyLazy_D3D11CreateDeviceAndSwapChain PROC
+    mov eax, 7
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CreateDeviceAndSwapChain ENDP
+
+IndiciumProxyLazy_D3D11On12CreateDevice PROC
+    mov eax, 8
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11On12CreateDevice ENDP
+
+IndiciumProxyLazy_D3DKMTCloseAdapter PROC
+    mov eax, 9
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCloseAdapter ENDP
+
+IndiciumProxyLazy_D3DKMTCreateAllocation PROC
+    mov eax, 10
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateAllocation ENDP
+
+IndiciumProxyLazy_D3DKMTCreateContext PROC
+    mov eax, 11
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateContext ENDP
+
+IndiciumProxyLazy_D3DKMTCreateDevice PROC
+    mov eax, 12
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateDevice ENDP
+
+IndiciumProxyLazy_D3DKMTCreateSynchronizationObject PROC
+    mov eax, 13
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateSynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTDestroyAllocation PROC
+    mov eax, 14
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroyAllocation ENDP
+
+IndiciumProxyLazy_D3DKMTDestroyContext PROC
+    mov eax, 15
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroyContext ENDP
+
+IndiciumProxyLazy_D3DKMTDestroyDevice PROC
+    mov eax, 16
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroyDevice ENDP
+
+IndiciumProxyLazy_D3DKMTDestroySynchronizationObject PROC
+    mov eax, 17
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroySynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTEscape PROC
+    mov eax, 18
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTEscape ENDP
+
+IndiciumProxyLazy_D3DKMTGetContextSchedulingPriority PROC
+    mov eax, 19
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetContextSchedulingPriority ENDP
+
+IndiciumProxyLazy_D3DKMTGetDeviceState PROC
+    mov eax, 20
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetDeviceState ENDP
+
+IndiciumProxyLazy_D3DKMTGetDisplayModeList PROC
+    mov eax, 21
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetDisplayModeList ENDP
+
+IndiciumProxyLazy_D3DKMTGetMultisampleMethodList PROC
+    mov eax, 22
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetMultisampleMethodList ENDP
+
+IndiciumProxyLazy_D3DKMTGetRuntimeData PROC
+    mov eax, 23
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetRuntimeData ENDP
+
+IndiciumProxyLazy_D3DKMTGetSharedPrimaryHandle PROC
+    mov eax, 24
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetSharedPrimaryHandle ENDP
+
+IndiciumProxyLazy_D3DKMTLock PROC
+    mov eax, 25
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTLock ENDP
+
+IndiciumProxyLazy_D3DKMTOpenAdapterFromHdc PROC
+    mov eax, 26
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTOpenAdapterFromHdc ENDP
+
+IndiciumProxyLazy_D3DKMTOpenResource PROC
+    mov eax, 27
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTOpenResource ENDP
+
+IndiciumProxyLazy_D3DKMTPresent PROC
+    mov eax, 28
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTPresent ENDP
+
+IndiciumProxyLazy_D3DKMTQueryAdapterInfo PROC
+    mov eax, 29
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTQueryAdapterInfo ENDP
+
+IndiciumProxyLazy_D3DKMTQueryAllocationResidency PROC
+    mov eax, 30
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTQueryAllocationResidency ENDP
+
+IndiciumProxyLazy_D3DKMTQueryResourceInfo PROC
+    mov eax, 31
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTQueryResourceInfo ENDP
+
+IndiciumProxyLazy_D3DKMTRender PROC
+    mov eax, 32
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTRender ENDP
+
+IndiciumProxyLazy_D3DKMTSetAllocationPriority PROC
+    mov eax, 33
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetAllocationPriority ENDP
+
+IndiciumProxyLazy_D3DKMTSetContextSchedulingPriority PROC
+    mov eax, 34
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetContextSchedulingPriority ENDP
+
+IndiciumProxyLazy_D3DKMTSetDisplayMode PROC
+    mov eax, 35
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetDisplayMode ENDP
+
+IndiciumProxyLazy_D3DKMTSetDisplayPrivateDriverFormat PROC
+    mov eax, 36
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetDisplayPrivateDriverFormat ENDP
+
+IndiciumProxyLazy_D3DKMTSetGammaRamp PROC
+    mov eax, 37
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetGammaRamp ENDP
+
+IndiciumProxyLazy_D3DKMTSetVidPnSourceOwner PROC
+    mov eax, 38
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetVidPnSourceOwner ENDP
+
+IndiciumProxyLazy_D3DKMTSignalSynchronizationObject PROC
+    mov eax, 39
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSignalSynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTUnlock PROC
+    mov eax, 40
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTUnlock ENDP
+
+IndiciumProxyLazy_D3DKMTWaitForSynchronizationObject PROC
+    mov eax, 41
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTWaitForSynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTWaitForVerticalBlankEvent PROC
+    mov eax, 42
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTWaitForVerticalBlankEvent ENDP
+
+IndiciumProxyLazy_D3DPerformance_BeginEvent PROC
+    mov eax, 43
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_BeginEvent ENDP
+
+IndiciumProxyLazy_D3DPerformance_EndEvent PROC
+    mov eax, 44
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_EndEvent ENDP
+
+IndiciumProxyLazy_D3DPerformance_GetStatus PROC
+    mov eax, 45
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_GetStatus ENDP
+
+IndiciumProxyLazy_D3DPerformance_SetMarker PROC
+    mov eax, 46
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_SetMarker ENDP
+
+IndiciumProxyLazy_EnableFeatureLevelUpgrade PROC
+    mov eax, 47
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_EnableFeatureLevelUpgrade ENDP
+
+IndiciumProxyLazy_OpenAdapter10 PROC
+    mov eax, 48
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_OpenAdapter10 ENDP
+
+IndiciumProxyLazy_OpenAdapter10_2 PROC
+    mov eax, 49
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_OpenAdapter10_2 ENDP
+
+.data
+
+IndiciumProxyTable LABEL QWORD
+    QWORD IndiciumProxyLazy_CreateDirect3D11DeviceFromDXGIDevice
+    QWORD IndiciumProxyLazy_CreateDirect3D11SurfaceFromDXGISurface
+    QWORD IndiciumProxyLazy_D3D11CoreCreateDevice
+    QWORD IndiciumProxyLazy_D3D11CoreCreateLayeredDevice
+    QWORD IndiciumProxyLazy_D3D11CoreGetLayeredDeviceSize
+    QWORD IndiciumProxyLazy_D3D11CoreRegisterLayers
+    QWORD IndiciumProxyLazy_D3D11CreateDevice
+    QWORD IndiciumProxyLazy_D3D11CreateDeviceAndSwapChain
+    QWORD IndiciumProxyLazy_D3D11On12CreateDevice
+    QWORD IndiciumProxyLazy_D3DKMTCloseAdapter
+    QWORD IndiciumProxyLazy_D3DKMTCreateAllocation
+    QWORD IndiciumProxyLazy_D3DKMTCreateContext
+    QWORD IndiciumProxyLazy_D3DKMTCreateDevice
+    QWORD IndiciumProxyLazy_D3DKMTCreateSynchronizationObject
+    QWORD IndiciumProxyLazy_D3DKMTDestroyAllocation
+    QWORD IndiciumProxyLazy_D3DKMTDestroyContext
+    QWORD IndiciumProxyLazy_D3DKMTDestroyDevice
+    QWORD IndiciumProxyLazy_D3DKMTDestroySynchronizationObject
+    QWORD IndiciumProxyLazy_D3DKMTEscape
+    QWORD IndiciumProxyLazy_D3DKMTGetContextSchedulingPriority
+    QWORD IndiciumProxyLazy_D3DKMTGetDeviceState
+    QWORD IndiciumProxyLazy_D3DKMTGetDisplayModeList
+    QWORD IndiciumProxyLazy_D3DKMTGetMultisampleMethodList
+    QWORD IndiciumProxyLazy_D3DKMTGetRuntimeData
+    QWORD IndiciumProxyLazy_D3DKMTGetSharedPrimaryHandle
+    QWORD IndiciumProxyLazy_D3DKMTLock
+    QWORD IndiciumProxyLazy_D3DKMTOpenAdapterFromHdc
+    QWORD IndiciumProxyLazy_D3DKMTOpenResource
+    QWORD IndiciumProxyLazy_D3DKMTPresent
+    QWORD IndiciumProxyLazy_D3DKMTQueryAdapterInfo
+    QWORD IndiciumProxyLazy_D3DKMTQueryAllocationResidency
+    QWORD IndiciumProxyLazy_D3DKMTQueryResourceInfo
+    QWORD IndiciumProxyLazy_D3DKMTRender
+    QWORD IndiciumProxyLazy_D3DKMTSetAllocationPriority
+    QWORD IndiciumProxyLazy_D3DKMTSetContextSchedulingPriority
+    QWORD IndiciumProxyLazy_D3DKMTSetDisplayMode
+    QWORD IndiciumProxyLazy_D3DKMTSetDisplayPrivateDriverFormat
+    QWORD IndiciumProxyLazy_D3DKMTSetGammaRamp
+    QWORD IndiciumProxyLazy_D3DKMTSetVidPnSourceOwner
+    QWORD IndiciumProxyLazy_D3DKMTSignalSynchronizationObject
+    QWORD IndiciumProxyLazy_D3DKMTUnlock
+    QWORD IndiciumProxyLazy_D3DKMTWaitForSynchronizationObject
+    QWORD IndiciumProxyLazy_D3DKMTWaitForVerticalBlankEvent
+    QWORD IndiciumProxyLazy_D3DPerformance_BeginEvent
+    QWORD IndiciumProxyLazy_D3DPerformance_EndEvent
+    QWORD IndiciumProxyLazy_D3DPerformance_GetStatus
+    QWORD IndiciumProxyLazy_D3DPerformance_SetMarker
+    QWORD IndiciumProxyLazy_EnableFeatureLevelUpgrade
+    QWORD IndiciumProxyLazy_OpenAdapter10
+    QWORD IndiciumProxyLazy_OpenAdapter10_2
+
+END
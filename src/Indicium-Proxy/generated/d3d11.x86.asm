@@ -0,0 +1,541 @@
+; Generated by Generate-ProxyExports.ps1 from exports\d3d11.txt, do not edit
+.686
+.model flat, C
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_CreateDirect3D11DeviceFromDXGIDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 0 * 4]
+IndiciumProxy_CreateDirect3D11DeviceFromDXGIDevice ENDP
+
+IndiciumProxy_CreateDirect3D11SurfaceFromDXGISurface PROC
+    jmp dword ptr [IndiciumProxyTable + 1 * 4]
+IndiciumProxy_CreateDirect3D11SurfaceFromDXGISurface ENDP
+
+IndiciumProxy_D3D11CoreCreateDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 2 * 4]
+IndiciumProxy_D3D11CoreCreateDevice ENDP
+
+IndiciumProxy_D3D11CoreCreateLayeredDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 3 * 4]
+IndiciumProxy_D3D11CoreCreateLayeredDevice ENDP
+
+IndiciumProxy_D3D11CoreGetLayeredDeviceSize PROC
+    jmp dword ptr [IndiciumProxyTable + 4 * 4]
+IndiciumProxy_D3D11CoreGetLayeredDeviceSize ENDP
+
+IndiciumProxy_D3D11CoreRegisterLayers PROC
+    jmp dword ptr [IndiciumProxyTable + 5 * 4]
+IndiciumProxy_D3D11CoreRegisterLayers ENDP
+
+IndiciumProxy_D3D11CreateDevice PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 6 * 4]
+IndiciumProxy_D3D11CreateDevice ENDP
+
+IndiciumProxy_D3D11CreateDeviceAndSwapChain PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 7 * 4]
+IndiciumProxy_D3D11CreateDeviceAndSwapChain ENDP
+
+IndiciumProxy_D3D11On12CreateDevice PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 8 * 4]
+IndiciumProxy_D3D11On12CreateDevice ENDP
+
+IndiciumProxy_D3DKMTCloseAdapter PROC
+    jmp dword ptr [IndiciumProxyTable + 9 * 4]
+IndiciumProxy_D3DKMTCloseAdapter ENDP
+
+IndiciumProxy_D3DKMTCreateAllocation PROC
+    jmp dword ptr [IndiciumProxyTable + 10 * 4]
+IndiciumProxy_D3DKMTCreateAllocation ENDP
+
+IndiciumProxy_D3DKMTCreateContext PROC
+    jmp dword ptr [IndiciumProxyTable + 11 * 4]
+IndiciumProxy_D3DKMTCreateContext ENDP
+
+IndiciumProxy_D3DKMTCreateDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 12 * 4]
+IndiciumProxy_D3DKMTCreateDevice ENDP
+
+IndiciumProxy_D3DKMTCreateSynchronizationObject PROC
+    jmp dword ptr [IndiciumProxyTable + 13 * 4]
+IndiciumProxy_D3DKMTCreateSynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTDestroyAllocation PROC
+    jmp dword ptr [IndiciumProxyTable + 14 * 4]
+IndiciumProxy_D3DKMTDestroyAllocation ENDP
+
+IndiciumProxy_D3DKMTDestroyContext PROC
+    jmp dword ptr [IndiciumProxyTable + 15 * 4]
+IndiciumProxy_D3DKMTDestroyContext ENDP
+
+IndiciumProxy_D3DKMTDestroyDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 16 * 4]
+IndiciumProxy_D3DKMTDestroyDevice ENDP
+
+IndiciumProxy_D3DKMTDestroySynchronizationObject PROC
+    jmp dword ptr [IndiciumProxyTable + 17 * 4]
+IndiciumProxy_D3DKMTDestroySynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTEscape PROC
+    jmp dword ptr [IndiciumProxyTable + 18 * 4]
+IndiciumProxy_D3DKMTEscape ENDP
+
+IndiciumProxy_D3DKMTGetContextSchedulingPriority PROC
+    jmp dword ptr [IndiciumProxyTable + 19 * 4]
+IndiciumProxy_D3DKMTGetContextSchedulingPriority ENDP
+
+IndiciumProxy_D3DKMTGetDeviceState PROC
+    jmp dword ptr [IndiciumProxyTable + 20 * 4]
+IndiciumProxy_D3DKMTGetDeviceState ENDP
+
+IndiciumProxy_D3DKMTGetDisplayModeList PROC
+    jmp dword ptr [IndiciumProxyTable + 21 * 4]
+IndiciumProxy_D3DKMTGetDisplayModeList ENDP
+
+IndiciumProxy_D3DKMTGetMultisampleMethodList PROC
+    jmp dword ptr [IndiciumProxyTable + 22 * 4]
+IndiciumProxy_D3DKMTGetMultisampleMethodList ENDP
+
+IndiciumProxy_D3DKMTGetRuntimeData PROC
+    jmp dword ptr [IndiciumProxyTable + 23 * 4]
+IndiciumProxy_D3DKMTGetRuntimeData ENDP
+
+IndiciumProxy_D3DKMTGetSharedPrimaryHandle PROC
+    jmp dword ptr [IndiciumProxyTable + 24 * 4]
+IndiciumProxy_D3DKMTGetSharedPrimaryHandle ENDP
+
+IndiciumProxy_D3DKMTLock PROC
+    jmp dword ptr [IndiciumProxyTable + 25 * 4]
+IndiciumProxy_D3DKMTLock ENDP
+
+IndiciumProxy_D3DKMTOpenAdapterFromHdc PROC
+    jmp dword ptr [IndiciumProxyTable + 26 * 4]
+IndiciumProxy_D3DKMTOpenAdapterFromHdc ENDP
+
+IndiciumProxy_D3DKMTOpenResource PROC
+    jmp dword ptr [IndiciumProxyTable + 27 * 4]
+IndiciumProxy_D3DKMTOpenResource ENDP
+
+IndiciumProxy_D3DKMTPresent PROC
+    jmp dword ptr [IndiciumProxyTable + 28 * 4]
+IndiciumProxy_D3DKMTPresent ENDP
+
+IndiciumProxy_D3DKMTQueryAdapterInfo PROC
+    jmp dword ptr [IndiciumProxyTable + 29 * 4]
+IndiciumProxy_D3DKMTQueryAdapterInfo ENDP
+
+IndiciumProxy_D3DKMTQueryAllocationResidency PROC
+    jmp dword ptr [IndiciumProxyTable + 30 * 4]
+IndiciumProxy_D3DKMTQueryAllocationResidency ENDP
+
+IndiciumProxy_D3DKMTQueryResourceInfo PROC
+    jmp dword ptr [IndiciumProxyTable + 31 * 4]
+IndiciumProxy_D3DKMTQueryResourceInfo ENDP
+
+IndiciumProxy_D3DKMTRender PROC
+    jmp dword ptr [IndiciumProxyTable + 32 * 4]
+IndiciumProxy_D3DKMTRender ENDP
+
+IndiciumProxy_D3DKMTSetAllocationPriority PROC
+    jmp dword ptr [IndiciumProxyTable + 33 * 4]
+IndiciumProxy_D3DKMTSetAllocationPriority ENDP
+
+IndiciumProxy_D3DKMTSetContextSchedulingPriority PROC
+    jmp dword ptr [IndiciumProxyTable + 34 * 4]
+IndiciumProxy_D3DKMTSetContextSchedulingPriority ENDP
+
+IndiciumProxy_D3DKMTSetDisplayMode PROC
+    jmp dword ptr [IndiciumProxyTable + 35 * 4]
+IndiciumProxy_D3DKMTSetDisplayMode ENDP
+
+IndiciumProxy_D3DKMTSetDisplayPrivateDriverFormat PROC
+    jmp dword ptr [IndiciumProxyTable + 36 * 4]
+IndiciumProxy_D3DKMTSetDisplayPrivateDriverFormat ENDP
+
+IndiciumProxy_D3DKMTSetGammaRamp PROC
+    jmp dword ptr [IndiciumProxyTable + 37 * 4]
+IndiciumProxy_D3DKMTSetGammaRamp ENDP
+
+IndiciumProxy_D3DKMTSetVidPnSourceOwner PROC
+    jmp dword ptr [IndiciumProxyTable + 38 * 4]
+IndiciumProxy_D3DKMTSetVidPnSourceOwner ENDP
+
+IndiciumProxy_D3DKMTSignalSynchronizationObject PROC
+    jmp dword ptr [IndiciumProxyTable + 39 * 4]
+IndiciumProxy_D3DKMTSignalSynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTUnlock PROC
+    jmp dword ptr [IndiciumProxyTable + 40 * 4]
+IndiciumProxy_D3DKMTUnlock ENDP
+
+IndiciumProxy_D3DKMTWaitForSynchronizationObject PROC
+    jmp dword ptr [IndiciumProxyTable + 41 * 4]
+IndiciumProxy_D3DKMTWaitForSynchronizationObject ENDP
+
+IndiciumProxy_D3DKMTWaitForVerticalBlankEvent PROC
+    jmp dword ptr [IndiciumProxyTable + 42 * 4]
+IndiciumProxy_D3DKMTWaitForVerticalBlankEvent ENDP
+
+IndiciumProxy_D3DPerformance_BeginEvent PROC
+    jmp dword ptr [IndiciumProxyTable + 43 * 4]
+IndiciumProxy_D3DPerformance_BeginEvent ENDP
+
+IndiciumProxy_D3DPerformance_EndEvent PROC
+    jmp dword ptr [IndiciumProxyTable + 44 * 4]
+IndiciumProxy_D3DPerformance_EndEvent ENDP
+
+IndiciumProxy_D3DPerformance_GetStatus PROC
+    jmp dword ptr [IndiciumProxyTable + 45 * 4]
+IndiciumProxy_D3DPerformance_GetStatus ENDP
+
+IndiciumProxy_D3DPerformance_SetMarker PROC
+    jmp dword ptr [IndiciumProxyTable + 46 * 4]
+IndiciumProxy_D3DPerformance_SetMarker ENDP
+
+IndiciumProxy_EnableFeatureLevelUpgrade PROC
+    jmp dword ptr [IndiciumProxyTable + 47 * 4]
+IndiciumProxy_EnableFeatureLevelUpgrade ENDP
+
+IndiciumProxy_OpenAdapter10 PROC
+    jmp dword ptr [IndiciumProxyTable + 48 * 4]
+IndiciumProxy_OpenAdapter10 ENDP
+
+IndiciumProxy_OpenAdapter10_2 PROC
+    jmp dword ptr [IndiciumProxyTable + 49 * 4]
+IndiciumProxy_OpenAdapter10_2 ENDP
+
+IndiciumProxyResolveStub PROC
+    push ecx
+    push edx
+    push eax
+    call IndiciumProxyResolve
+    pop eax
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + eax * 4]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_CreateDirect3D11DeviceFromDXGIDevice PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDirect3D11DeviceFromDXGIDevice ENDP
+
+IndiciumProxyLazy_CreateDirect3D11SurfaceFromDXGISurface PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDirect3D11SurfaceFromDXGISurface ENDP
+
+IndiciumProxyLazy_D3D11CoreCreateDevice PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreCreateDevice ENDP
+
+IndiciumProxyLazy_D3D11CoreCreateLayeredDevice PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreCreateLayeredDevice ENDP
+
+IndiciumProxyLazy_D3D11CoreGetLayeredDeviceSize PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreGetLayeredDeviceSize ENDP
+
+IndiciumProxyLazy_D3D11CoreRegisterLayers PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CoreRegisterLayers ENDP
+
+IndiciumProxyLazy_D3D11CreateDevice PROC
+    mov eax, 6
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CreateDevice ENDP
+
+IndiciumProxyLazy_D3D11CreateDeviceAndSwapChain PROC
+    mov eax, 7
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11CreateDeviceAndSwapChain ENDP
+
+IndiciumProxyLazy_D3D11On12CreateDevice PROC
+    mov eax, 8
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3D11On12CreateDevice ENDP
+
+IndiciumProxyLazy_D3DKMTCloseAdapter PROC
+    mov eax, 9
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCloseAdapter ENDP
+
+IndiciumProxyLazy_D3DKMTCreateAllocation PROC
+    mov eax, 10
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateAllocation ENDP
+
+IndiciumProxyLazy_D3DKMTCreateContext PROC
+    mov eax, 11
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateContext ENDP
+
+IndiciumProxyLazy_D3DKMTCreateDevice PROC
+    mov eax, 12
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateDevice ENDP
+
+IndiciumProxyLazy_D3DKMTCreateSynchronizationObject PROC
+    mov eax, 13
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTCreateSynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTDestroyAllocation PROC
+    mov eax, 14
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroyAllocation ENDP
+
+IndiciumProxyLazy_D3DKMTDestroyContext PROC
+    mov eax, 15
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroyContext ENDP
+
+IndiciumProxyLazy_D3DKMTDestroyDevice PROC
+    mov eax, 16
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroyDevice ENDP
+
+IndiciumProxyLazy_D3DKMTDestroySynchronizationObject PROC
+    mov eax, 17
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTDestroySynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTEscape PROC
+    mov eax, 18
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTEscape ENDP
+
+IndiciumProxyLazy_D3DKMTGetContextSchedulingPriority PROC
+    mov eax, 19
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetContextSchedulingPriority ENDP
+
+IndiciumProxyLazy_D3DKMTGetDeviceState PROC
+    mov eax, 20
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetDeviceState ENDP
+
+IndiciumProxyLazy_D3DKMTGetDisplayModeList PROC
+    mov eax, 21
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetDisplayModeList ENDP
+
+IndiciumProxyLazy_D3DKMTGetMultisampleMethodList PROC
+    mov eax, 22
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetMultisampleMethodList ENDP
+
+IndiciumProxyLazy_D3DKMTGetRuntimeData PROC
+    mov eax, 23
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetRuntimeData ENDP
+
+IndiciumProxyLazy_D3DKMTGetSharedPrimaryHandle PROC
+    mov eax, 24
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTGetSharedPrimaryHandle ENDP
+
+IndiciumProxyLazy_D3DKMTLock PROC
+    mov eax, 25
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTLock ENDP
+
+IndiciumProxyLazy_D3DKMTOpenAdapterFromHdc PROC
+    mov eax, 26
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTOpenAdapterFromHdc ENDP
+
+IndiciumProxyLazy_D3DKMTOpenResource PROC
+    mov eax, 27
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTOpenResource ENDP
+
+IndiciumProxyLazy_D3DKMTPresent PROC
+    mov eax, 28
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTPresent ENDP
+
+IndiciumProxyLazy_D3DKMTQueryAdapterInfo PROC
+    mov eax, 29
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTQueryAdapterInfo ENDP
+
+IndiciumProxyLazy_D3DKMTQueryAllocationResidency PROC
+    mov eax, 30
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTQueryAllocationResidency ENDP
+
+IndiciumProxyLazy_D3DKMTQueryResourceInfo PROC
+    mov eax, 31
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTQueryResourceInfo ENDP
+
+IndiciumProxyLazy_D3DKMTRender PROC
+    mov eax, 32
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTRender ENDP
+
+IndiciumProxyLazy_D3DKMTSetAllocationPriority PROC
+    mov eax, 33
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetAllocationPriority ENDP
+
+IndiciumProxyLazy_D3DKMTSetContextSchedulingPriority PROC
+    mov eax, 34
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetContextSchedulingPriority ENDP
+
+IndiciumProxyLazy_D3DKMTSetDisplayMode PROC
+    mov eax, 35
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetDisplayMode ENDP
+
+IndiciumProxyLazy_D3DKMTSetDisplayPrivateDriverFormat PROC
+    mov eax, 36
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetDisplayPrivateDriverFormat ENDP
+
+IndiciumProxyLazy_D3DKMTSetGammaRamp PROC
+    mov eax, 37
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetGammaRamp ENDP
+
+IndiciumProxyLazy_D3DKMTSetVidPnSourceOwner PROC
+    mov eax, 38
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSetVidPnSourceOwner ENDP
+
+IndiciumProxyLazy_D3DKMTSignalSynchronizationObject PROC
+    mov eax, 39
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTSignalSynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTUnlock PROC
+    mov eax, 40
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTUnlock ENDP
+
+IndiciumProxyLazy_D3DKMTWaitForSynchronizationObject PROC
+    mov eax, 41
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTWaitForSynchronizationObject ENDP
+
+IndiciumProxyLazy_D3DKMTWaitForVerticalBlankEvent PROC
+    mov eax, 42
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DKMTWaitForVerticalBlankEvent ENDP
+
+IndiciumProxyLazy_D3DPerformance_BeginEvent PROC
+    mov eax, 43
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_BeginEvent ENDP
+
+IndiciumProxyLazy_D3DPerformance_EndEvent PROC
+    mov eax, 44
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_EndEvent ENDP
+
+IndiciumProxyLazy_D3DPerformance_GetStatus PROC
+    mov eax, 45
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_GetStatus ENDP
+
+IndiciumProxyLazy_D3DPerformance_SetMarker PROC
+    mov eax, 46
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPerformance_SetMarker ENDP
+
+IndiciumProxyLazy_EnableFeatureLevelUpgrade PROC
+    mov eax, 47
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_EnableFeatureLevelUpgrade ENDP
+
+IndiciumProxyLazy_OpenAdapter10 PROC
+    mov eax, 48
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_OpenAdapter10 ENDP
+
+IndiciumProxyLazy_OpenAdapter10_2 PROC
+    mov eax, 49
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_OpenAdapter10_2 ENDP
+
+.data
+
+IndiciumProxyTable LABEL DWORD
+    DWORD IndiciumProxyLazy_CreateDirect3D11DeviceFromDXGIDevice
+    DWORD IndiciumProxyLazy_CreateDirect3D11SurfaceFromDXGISurface
+    DWORD IndiciumProxyLazy_D3D11CoreCreateDevice
+    DWORD IndiciumProxyLazy_D3D11CoreCreateLayeredDevice
+    DWORD IndiciumProxyLazy_D3D11CoreGetLayeredDeviceSize
+    DWORD IndiciumProxyLazy_D3D11CoreRegisterLayers
+    DWORD IndiciumProxyLazy_D3D11CreateDevice
+    DWORD IndiciumProxyLazy_D3D11CreateDeviceAndSwapChain
+    DWORD IndiciumProxyLazy_D3D11On12CreateDevice
+    DWORD IndiciumProxyLazy_D3DKMTCloseAdapter
+    DWORD IndiciumProxyLazy_D3DKMTCreateAllocation
+    DWORD IndiciumProxyLazy_D3DKMTCreateContext
+    DWORD IndiciumProxyLazy_D3DKMTCreateDevice
+    DWORD IndiciumProxyLazy_D3DKMTCreateSynchronizationObject
+    DWORD IndiciumProxyLazy_D3DKMTDestroyAllocation
+    DWORD IndiciumProxyLazy_D3DKMTDestroyContext
+    DWORD IndiciumProxyLazy_D3DKMTDestroyDevice
+    DWORD IndiciumProxyLazy_D3DKMTDestroySynchronizationObject
+    DWORD IndiciumProxyLazy_D3DKMTEscape
+    DWORD IndiciumProxyLazy_D3DKMTGetContextSchedulingPriority
+    DWORD IndiciumProxyLazy_D3DKMTGetDeviceState
+    DWORD IndiciumProxyLazy_D3DKMTGetDisplayModeList
+    DWORD IndiciumProxyLazy_D3DKMTGetMultisampleMethodList
+    DWORD IndiciumProxyLazy_D3DKMTGetRuntimeData
+    DWORD IndiciumProxyLazy_D3DKMTGetSharedPrimaryHandle
+    DWORD IndiciumProxyLazy_D3DKMTLock
+    DWORD IndiciumProxyLazy_D3DKMTOpenAdapterFromHdc
+    DWORD IndiciumProxyLazy_D3DKMTOpenResource
+    DWORD IndiciumProxyLazy_D3DKMTPresent
+    DWORD IndiciumProxyLazy_D3DKMTQueryAdapterInfo
+    DWORD IndiciumProxyLazy_D3DKMTQueryAllocationResidency
+    DWORD IndiciumProxyLazy_D3DKMTQueryResourceInfo
+    DWORD IndiciumProxyLazy_D3DKMTRender
+    DWORD IndiciumProxyLazy_D3DKMTSetAllocationPriority
+    DWORD IndiciumProxyLazy_D3DKMTSetContextSchedulingPriority
+    DWORD IndiciumProxyLazy_D3DKMTSetDisplayMode
+    DWORD IndiciumProxyLazy_D3DKMTSetDisplayPrivateDriverFormat
+    DWORD IndiciumProxyLazy_D3DKMTSetGammaRamp
+    DWORD IndiciumProxyLazy_D3DKMTSetVidPnSourceOwner
+    DWORD IndiciumProxyLazy_D3DKMTSignalSynchronizationObject
+    DWORD IndiciumProxyLazy_D3DKMTUnlock
+    DWORD IndiciumProxyLazy_D3DKMTWaitForSynchronizationObject
+    DWORD IndiciumProxyLazy_D3DKMTWaitForVerticalBlankEvent
+    DWORD IndiciumProxyLazy_D3DPerformance_BeginEvent
+    DWORD IndiciumProxyLazy_D3DPerformance_EndEvent
+    DWORD IndiciumProxyLazy_D3DPerformance_GetStatus
+    DWORD IndiciumProxyLazy_D3DPerformance_SetMarker
+    DWORD IndiciumProxyLazy_EnableFeatureLevelUpgrade
+    DWORD IndiciumProxyLazy_OpenAdapter10
+    DWORD IndiciumProxyLazy_OpenAdapter10_2
+
+END
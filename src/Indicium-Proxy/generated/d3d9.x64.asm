@@ -0,0 +1,284 @@
+; Generated by Generate-ProxyExports.ps1 from exports\d3d9.txt, do not edit
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_D3DPERF_BeginEvent PROC
+    jmp qword ptr [IndiciumProxyTable + 0 * 8]
+IndiciumProxy_D3DPERF_BeginEvent ENDP
+
+IndiciumProxy_D3DPERF_EndEvent PROC
+    jmp qword ptr [IndiciumProxyTable + 1 * 8]
+IndiciumProxy_D3DPERF_EndEvent ENDP
+
+IndiciumProxy_D3DPERF_GetStatus PROC
+    jmp qword ptr [IndiciumProxyTable + 2 * 8]
+IndiciumProxy_D3DPERF_GetStatus ENDP
+
+IndiciumProxy_D3DPERF_QueryRepeatFrame PROC
+    jmp qword ptr [IndiciumProxyTable + 3 * 8]
+IndiciumProxy_D3DPERF_QueryRepeatFrame ENDP
+
+IndiciumProxy_D3DPERF_SetMarker PROC
+    jmp qword ptr [IndiciumProxyTable + 4 * 8]
+IndiciumProxy_D3DPERF_SetMarker ENDP
+
+IndiciumProxy_D3DPERF_SetOptions PROC
+    jmp qword ptr [IndiciumProxyTable + 5 * 8]
+IndiciumProxy_D3DPERF_SetOptions ENDP
+
+IndiciumProxy_D3DPERF_SetRegion PROC
+    jmp qword ptr [IndiciumProxyTable + 6 * 8]
+IndiciumProxy_D3DPERF_SetRegion ENDP
+
+IndiciumProxy_DebugSetLevel PROC
+    jmp qword ptr [IndiciumProxyTable + 7 * 8]
+IndiciumProxy_DebugSetLevel ENDP
+
+IndiciumProxy_DebugSetMute PROC
+    jmp qword ptr [IndiciumProxyTable + 8 * 8]
+IndiciumProxy_DebugSetMute ENDP
+
+IndiciumProxy_Direct3D9EnableMaximizedWindowedModeShim PROC
+    jmp qword ptr [IndiciumProxyTable + 9 * 8]
+IndiciumProxy_Direct3D9EnableMaximizedWindowedModeShim ENDP
+
+IndiciumProxy_Direct3DCreate9 PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 10 * 8]
+IndiciumProxy_Direct3DCreate9 ENDP
+
+IndiciumProxy_Direct3DCreate9Ex PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 11 * 8]
+IndiciumProxy_Direct3DCreate9Ex ENDP
+
+IndiciumProxy_Direct3DCreate9On12 PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 12 * 8]
+IndiciumProxy_Direct3DCreate9On12 ENDP
+
+IndiciumProxy_Direct3DCreate9On12Ex PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 13 * 8]
+IndiciumProxy_Direct3DCreate9On12Ex ENDP
+
+IndiciumProxy_Direct3DShaderValidatorCreate9 PROC
+    jmp qword ptr [IndiciumProxyTable + 14 * 8]
+IndiciumProxy_Direct3DShaderValidatorCreate9 ENDP
+
+IndiciumProxy_PSGPError PROC
+    jmp qword ptr [IndiciumProxyTable + 15 * 8]
+IndiciumProxy_PSGPError ENDP
+
+IndiciumProxy_PSGPSampleTexture PROC
+    jmp qword ptr [IndiciumProxyTable + 16 * 8]
+IndiciumProxy_PSGPSampleTexture ENDP
+
+IndiciumProxyResolveStub PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    push rax
+    .pushreg rax
+    sub rsp, 60h
+    .allocstack 60h
+    .endprolog
+    movdqu xmmword ptr [rsp + 20h], xmm0
+    movdqu xmmword ptr [rsp + 30h], xmm1
+    movdqu xmmword ptr [rsp + 40h], xmm2
+    movdqu xmmword ptr [rsp + 50h], xmm3
+    call IndiciumProxyResolve
+    movdqu xmm0, xmmword ptr [rsp + 20h]
+    movdqu xmm1, xmmword ptr [rsp + 30h]
+    movdqu xmm2, xmmword ptr [rsp + 40h]
+    movdqu xmm3, xmmword ptr [rsp + 50h]
+    add rsp, 60h
+    pop rax
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    lea r10, IndiciumProxyTable
+    jmp qword ptr [r10 + rax * 8]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_D3DPERF_BeginEvent PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_BeginEvent ENDP
+
+IndiciumProxyLazy_D3DPERF_EndEvent PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_EndEvent ENDP
+
+IndiciumProxyLazy_D3DPERF_GetStatus PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_GetStatus ENDP
+
+IndiciumProxyLazy_D3DPERF_QueryRepeatFrame PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_QueryRepeatFrame ENDP
+
+IndiciumProxyLazy_D3DPERF_SetMarker PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_SetMarker ENDP
+
+IndiciumProxyLazy_D3DPERF_SetOptions PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_SetOptions ENDP
+
+IndiciumProxyLazy_D3DPERF_SetRegion PROC
+    mov eax, 6
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_SetRegion ENDP
+
+IndiciumProxyLazy_DebugSetLevel PROC
+    mov eax, 7
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DebugSetLevel ENDP
+
+IndiciumProxyLazy_DebugSetMute PROC
+    mov eax, 8
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DebugSetMute ENDP
+
+IndiciumProxyLazy_Direct3D9EnableMaximizedWindowedModeShim PROC
+    mov eax, 9
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3D9EnableMaximizedWindowedModeShim ENDP
+
+IndiciumProxyLazy_Direct3DCreate9 PROC
+    mov eax, 10
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9 ENDP
+
+IndiciumProxyLazy_Direct3DCreate9Ex PROC
+    mov eax, 11
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9Ex ENDP
+
+IndiciumProxyLazy_Direct3DCreate9On12 PROC
+    mov eax, 12
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9On12 ENDP
+
+IndiciumProxyLazy_Direct3DCreate9On12Ex PROC
+    mov eax, 13
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9On12Ex ENDP
+
+IndiciumProxyLazy_Direct3DShaderValidatorCreate9 PROC
+    mov eax, 14
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DShaderValidatorCreate9 ENDP
+
+IndiciumProxyLazy_PSGPError PROC
+    mov eax, 15
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PSGPError ENDP
+
+IndiciumProxyLazy_PSGPSampleTexture PROC
+    mov eax, 16
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PSGPSampleTexture ENDP
+
+.data
+
+IndiciumProxyTable LABEL QWORD
+    QWORD IndiciumProxyLazy_D3DPERF_BeginEvent
+    QWORD IndiciumProxyLazy_D3DPERF_EndEvent
+    QWORD IndiciumProxyLazy_D3DPERF_GetStatus
+    QWORD IndiciumProxyLazy_D3DPERF_QueryRepeatFrame
+    QWORD IndiciumProxyLazy_D3DPERF_SetMarker
+    QWORD IndiciumProxyLazy_D3DPERF_SetOptions
+    QWORD IndiciumProxyLazy_D3DPERF_SetRegion
+    QWORD IndiciumProxyLazy_DebugSetLevel
+    QWORD IndiciumProxyLazy_DebugSetMute
+    QWORD IndiciumProxyLazy_Direct3D9EnableMaximizedWindowedModeShim
+    QWORD IndiciumProxyLazy_Direct3DCreate9
+    QWORD IndiciumProxyLazy_Direct3DCreate9Ex
+    QWORD IndiciumProxyLazy_Direct3DCreate9On12
+    QWORD IndiciumProxyLazy_Direct3DCreate9On12Ex
+    QWORD IndiciumProxyLazy_Direct3DShaderValidatorCreate9
+    QWORD IndiciumProxyLazy_PSGPError
+    QWORD IndiciumProxyLazy_PSGPSampleTexture
+
+END
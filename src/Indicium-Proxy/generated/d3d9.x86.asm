@@ -0,0 +1,216 @@
+; Generated by Generate-ProxyExports.ps1 from exports\d3d9.txt, do not edit
+.686
+.model flat, C
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_D3DPERF_BeginEvent PROC
+    jmp dword ptr [IndiciumProxyTable + 0 * 4]
+IndiciumProxy_D3DPERF_BeginEvent ENDP
+
+IndiciumProxy_D3DPERF_EndEvent PROC
+    jmp dword ptr [IndiciumProxyTable + 1 * 4]
+IndiciumProxy_D3DPERF_EndEvent ENDP
+
+IndiciumProxy_D3DPERF_GetStatus PROC
+    jmp dword ptr [IndiciumProxyTable + 2 * 4]
+IndiciumProxy_D3DPERF_GetStatus ENDP
+
+IndiciumProxy_D3DPERF_QueryRepeatFrame PROC
+    jmp dword ptr [IndiciumProxyTable + 3 * 4]
+IndiciumProxy_D3DPERF_QueryRepeatFrame ENDP
+
+IndiciumProxy_D3DPERF_SetMarker PROC
+    jmp dword ptr [IndiciumProxyTable + 4 * 4]
+IndiciumProxy_D3DPERF_SetMarker ENDP
+
+IndiciumProxy_D3DPERF_SetOptions PROC
+    jmp dword ptr [IndiciumProxyTable + 5 * 4]
+IndiciumProxy_D3DPERF_SetOptions ENDP
+
+IndiciumProxy_D3DPERF_SetRegion PROC
+    jmp dword ptr [IndiciumProxyTable + 6 * 4]
+IndiciumProxy_D3DPERF_SetRegion ENDP
+
+IndiciumProxy_DebugSetLevel PROC
+    jmp dword ptr [IndiciumProxyTable + 7 * 4]
+IndiciumProxy_DebugSetLevel ENDP
+
+IndiciumProxy_DebugSetMute PROC
+    jmp dword ptr [IndiciumProxyTable + 8 * 4]
+IndiciumProxy_DebugSetMute ENDP
+
+IndiciumProxy_Direct3D9EnableMaximizedWindowedModeShim PROC
+    jmp dword ptr [IndiciumProxyTable + 9 * 4]
+IndiciumProxy_Direct3D9EnableMaximizedWindowedModeShim ENDP
+
+IndiciumProxy_Direct3DCreate9 PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 10 * 4]
+IndiciumProxy_Direct3DCreate9 ENDP
+
+IndiciumProxy_Direct3DCreate9Ex PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 11 * 4]
+IndiciumProxy_Direct3DCreate9Ex ENDP
+
+IndiciumProxy_Direct3DCreate9On12 PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 12 * 4]
+IndiciumProxy_Direct3DCreate9On12 ENDP
+
+IndiciumProxy_Direct3DCreate9On12Ex PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 13 * 4]
+IndiciumProxy_Direct3DCreate9On12Ex ENDP
+
+IndiciumProxy_Direct3DShaderValidatorCreate9 PROC
+    jmp dword ptr [IndiciumProxyTable + 14 * 4]
+IndiciumProxy_Direct3DShaderValidatorCreate9 ENDP
+
+IndiciumProxy_PSGPError PROC
+    jmp dword ptr [IndiciumProxyTable + 15 * 4]
+IndiciumProxy_PSGPError ENDP
+
+IndiciumProxy_PSGPSampleTexture PROC
+    jmp dword ptr [IndiciumProxyTable + 16 * 4]
+IndiciumProxy_PSGPSampleTexture ENDP
+
+IndiciumProxyResolveStub PROC
+    push ecx
+    push edx
+    push eax
+    call IndiciumProxyResolve
+    pop eax
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + eax * 4]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_D3DPERF_BeginEvent PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_BeginEvent ENDP
+
+IndiciumProxyLazy_D3DPERF_EndEvent PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_EndEvent ENDP
+
+IndiciumProxyLazy_D3DPERF_GetStatus PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_GetStatus ENDP
+
+IndiciumProxyLazy_D3DPERF_QueryRepeatFrame PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_QueryRepeatFrame ENDP
+
+IndiciumProxyLazy_D3DPERF_SetMarker PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_SetMarker ENDP
+
+IndiciumProxyLazy_D3DPERF_SetOptions PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_SetOptions ENDP
+
+IndiciumProxyLazy_D3DPERF_SetRegion PROC
+    mov eax, 6
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_D3DPERF_SetRegion ENDP
+
+IndiciumProxyLazy_DebugSetLevel PROC
+    mov eax, 7
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DebugSetLevel ENDP
+
+IndiciumProxyLazy_DebugSetMute PROC
+    mov eax, 8
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DebugSetMute ENDP
+
+IndiciumProxyLazy_Direct3D9EnableMaximizedWindowedModeShim PROC
+    mov eax, 9
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3D9EnableMaximizedWindowedModeShim ENDP
+
+IndiciumProxyLazy_Direct3DCreate9 PROC
+    mov eax, 10
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9 ENDP
+
+IndiciumProxyLazy_Direct3DCreate9Ex PROC
+    mov eax, 11
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9Ex ENDP
+
+IndiciumProxyLazy_Direct3DCreate9On12 PROC
+    mov eax, 12
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9On12 ENDP
+
+IndiciumProxyLazy_Direct3DCreate9On12Ex PROC
+    mov eax, 13
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DCreate9On12Ex ENDP
+
+IndiciumProxyLazy_Direct3DShaderValidatorCreate9 PROC
+    mov eax, 14
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_Direct3DShaderValidatorCreate9 ENDP
+
+IndiciumProxyLazy_PSGPError PROC
+    mov eax, 15
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PSGPError ENDP
+
+IndiciumProxyLazy_PSGPSampleTexture PROC
+    mov eax, 16
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PSGPSampleTexture ENDP
+
+.data
+
+IndiciumProxyTable LABEL DWORD
+    DWORD IndiciumProxyLazy_D3DPERF_BeginEvent
+    DWORD IndiciumProxyLazy_D3DPERF_EndEvent
+    DWORD IndiciumProxyLazy_D3DPERF_GetStatus
+    DWORD IndiciumProxyLazy_D3DPERF_QueryRepeatFrame
+    DWORD IndiciumProxyLazy_D3DPERF_SetMarker
+    DWORD IndiciumProxyLazy_D3DPERF_SetOptions
+    DWORD IndiciumProxyLazy_D3DPERF_SetRegion
+    DWORD IndiciumProxyLazy_DebugSetLevel
+    DWORD IndiciumProxyLazy_DebugSetMute
+    DWORD IndiciumProxyLazy_Direct3D9EnableMaximizedWindowedModeShim
+    DWORD IndiciumProxyLazy_Direct3DCreate9
+    DWORD IndiciumProxyLazy_Direct3DCreate9Ex
+    DWORD IndiciumProxyLazy_Direct3DCreate9On12
+    DWORD IndiciumProxyLazy_Direct3DCreate9On12Ex
+    DWORD IndiciumProxyLazy_Direct3DShaderValidatorCreate9
+    DWORD IndiciumProxyLazy_PSGPError
+    DWORD IndiciumProxyLazy_PSGPSampleTexture
+
+END
@@ -0,0 +1,123 @@
+; Generated by Generate-ProxyExports.ps1 from exports\dinput8.txt, do not edit
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_DirectInput8Create PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 0 * 8]
+IndiciumProxy_DirectInput8Create ENDP
+
+IndiciumProxy_DllCanUnloadNow PROC
+    jmp qword ptr [IndiciumProxyTable + 1 * 8]
+IndiciumProxy_DllCanUnloadNow ENDP
+
+IndiciumProxy_DllGetClassObject PROC
+    jmp qword ptr [IndiciumProxyTable + 2 * 8]
+IndiciumProxy_DllGetClassObject ENDP
+
+IndiciumProxy_DllRegisterServer PROC
+    jmp qword ptr [IndiciumProxyTable + 3 * 8]
+IndiciumProxy_DllRegisterServer ENDP
+
+IndiciumProxy_DllUnregisterServer PROC
+    jmp qword ptr [IndiciumProxyTable + 4 * 8]
+IndiciumProxy_DllUnregisterServer ENDP
+
+IndiciumProxy_GetdfDIJoystick PROC
+    jmp qword ptr [IndiciumProxyTable + 5 * 8]
+IndiciumProxy_GetdfDIJoystick ENDP
+
+IndiciumProxyResolveStub PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    push rax
+    .pushreg rax
+    sub rsp, 60h
+    .allocstack 60h
+    .endprolog
+    movdqu xmmword ptr [rsp + 20h], xmm0
+    movdqu xmmword ptr [rsp + 30h], xmm1
+    movdqu xmmword ptr [rsp + 40h], xmm2
+    movdqu xmmword ptr [rsp + 50h], xmm3
+    call IndiciumProxyResolve
+    movdqu xmm0, xmmword ptr [rsp + 20h]
+    movdqu xmm1, xmmword ptr [rsp + 30h]
+    movdqu xmm2, xmmword ptr [rsp + 40h]
+    movdqu xmm3, xmmword ptr [rsp + 50h]
+    add rsp, 60h
+    pop rax
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    lea r10, IndiciumProxyTable
+    jmp qword ptr [r10 + rax * 8]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_DirectInput8Create PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DirectInput8Create ENDP
+
+IndiciumProxyLazy_DllCanUnloadNow PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllCanUnloadNow ENDP
+
+IndiciumProxyLazy_DllGetClassObject PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllGetClassObject ENDP
+
+IndiciumProxyLazy_DllRegisterServer PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllRegisterServer ENDP
+
+IndiciumProxyLazy_DllUnregisterServer PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllUnregisterServer ENDP
+
+IndiciumProxyLazy_GetdfDIJoystick PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_GetdfDIJoystick ENDP
+
+.data
+
+IndiciumProxyTable LABEL QWORD
+    QWORD IndiciumProxyLazy_DirectInput8Create
+    QWORD IndiciumProxyLazy_DllCanUnloadNow
+    QWORD IndiciumProxyLazy_DllGetClassObject
+    QWORD IndiciumProxyLazy_DllRegisterServer
+    QWORD IndiciumProxyLazy_DllUnregisterServer
+    QWORD IndiciumProxyLazy_GetdfDIJoystick
+
+END
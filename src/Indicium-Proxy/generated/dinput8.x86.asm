@@ -0,0 +1,91 @@
+; Generated by Generate-ProxyExports.ps1 from exports\dinput8.txt, do not edit
+.686
+.model flat, C
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_DirectInput8Create PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 0 * 4]
+IndiciumProxy_DirectInput8Create ENDP
+
+IndiciumProxy_DllCanUnloadNow PROC
+    jmp dword ptr [IndiciumProxyTable + 1 * 4]
+IndiciumProxy_DllCanUnloadNow ENDP
+
+IndiciumProxy_DllGetClassObject PROC
+    jmp dword ptr [IndiciumProxyTable + 2 * 4]
+IndiciumProxy_DllGetClassObject ENDP
+
+IndiciumProxy_DllRegisterServer PROC
+    jmp dword ptr [IndiciumProxyTable + 3 * 4]
+IndiciumProxy_DllRegisterServer ENDP
+
+IndiciumProxy_DllUnregisterServer PROC
+    jmp dword ptr [IndiciumProxyTable + 4 * 4]
+IndiciumProxy_DllUnregisterServer ENDP
+
+IndiciumProxy_GetdfDIJoystick PROC
+    jmp dword ptr [IndiciumProxyTable + 5 * 4]
+IndiciumProxy_GetdfDIJoystick ENDP
+
+IndiciumProxyResolveStub PROC
+    push ecx
+    push edx
+    push eax
+    call IndiciumProxyResolve
+    pop eax
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + eax * 4]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_DirectInput8Create PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DirectInput8Create ENDP
+
+IndiciumProxyLazy_DllCanUnloadNow PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllCanUnloadNow ENDP
+
+IndiciumProxyLazy_DllGetClassObject PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllGetClassObject ENDP
+
+IndiciumProxyLazy_DllRegisterServer PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllRegisterServer ENDP
+
+IndiciumProxyLazy_DllUnregisterServer PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DllUnregisterServer ENDP
+
+IndiciumProxyLazy_GetdfDIJoystick PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_GetdfDIJoystick ENDP
+
+.data
+
+IndiciumProxyTable LABEL DWORD
+    DWORD IndiciumProxyLazy_DirectInput8Create
+    DWORD IndiciumProxyLazy_DllCanUnloadNow
+    DWORD IndiciumProxyLazy_DllGetClassObject
+    DWORD IndiciumProxyLazy_DllRegisterServer
+    DWORD IndiciumProxyLazy_DllUnregisterServer
+    DWORD IndiciumProxyLazy_GetdfDIJoystick
+
+END
@@ -0,0 +1,297 @@
+; Generated by Generate-ProxyExports.ps1 from exports\dxgi.txt, do not edit
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_ApplyCompatResolutionQuirking PROC
+    jmp qword ptr [IndiciumProxyTable + 0 * 8]
+IndiciumProxy_ApplyCompatResolutionQuirking ENDP
+
+IndiciumProxy_CompatString PROC
+    jmp qword ptr [IndiciumProxyTable + 1 * 8]
+IndiciumProxy_CompatString ENDP
+
+IndiciumProxy_CompatValue PROC
+    jmp qword ptr [IndiciumProxyTable + 2 * 8]
+IndiciumProxy_CompatValue ENDP
+
+IndiciumProxy_CreateDXGIFactory PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 3 * 8]
+IndiciumProxy_CreateDXGIFactory ENDP
+
+IndiciumProxy_CreateDXGIFactory1 PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 4 * 8]
+IndiciumProxy_CreateDXGIFactory1 ENDP
+
+IndiciumProxy_CreateDXGIFactory2 PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    sub rsp, 28h
+    .allocstack 28h
+    .endprolog
+    call IndiciumProxyGate
+    add rsp, 28h
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    jmp qword ptr [IndiciumProxyTable + 5 * 8]
+IndiciumProxy_CreateDXGIFactory2 ENDP
+
+IndiciumProxy_DXGID3D10CreateDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 6 * 8]
+IndiciumProxy_DXGID3D10CreateDevice ENDP
+
+IndiciumProxy_DXGID3D10CreateLayeredDevice PROC
+    jmp qword ptr [IndiciumProxyTable + 7 * 8]
+IndiciumProxy_DXGID3D10CreateLayeredDevice ENDP
+
+IndiciumProxy_DXGID3D10GetLayeredDeviceSize PROC
+    jmp qword ptr [IndiciumProxyTable + 8 * 8]
+IndiciumProxy_DXGID3D10GetLayeredDeviceSize ENDP
+
+IndiciumProxy_DXGID3D10RegisterLayers PROC
+    jmp qword ptr [IndiciumProxyTable + 9 * 8]
+IndiciumProxy_DXGID3D10RegisterLayers ENDP
+
+IndiciumProxy_DXGIDeclareAdapterRemovalSupport PROC
+    jmp qword ptr [IndiciumProxyTable + 10 * 8]
+IndiciumProxy_DXGIDeclareAdapterRemovalSupport ENDP
+
+IndiciumProxy_DXGIDisableVBlankVirtualization PROC
+    jmp qword ptr [IndiciumProxyTable + 11 * 8]
+IndiciumProxy_DXGIDisableVBlankVirtualization ENDP
+
+IndiciumProxy_DXGIDumpJournal PROC
+    jmp qword ptr [IndiciumProxyTable + 12 * 8]
+IndiciumProxy_DXGIDumpJournal ENDP
+
+IndiciumProxy_DXGIGetDebugInterface1 PROC
+    jmp qword ptr [IndiciumProxyTable + 13 * 8]
+IndiciumProxy_DXGIGetDebugInterface1 ENDP
+
+IndiciumProxy_DXGIReportAdapterConfiguration PROC
+    jmp qword ptr [IndiciumProxyTable + 14 * 8]
+IndiciumProxy_DXGIReportAdapterConfiguration ENDP
+
+IndiciumProxy_PIXBeginCapture PROC
+    jmp qword ptr [IndiciumProxyTable + 15 * 8]
+IndiciumProxy_PIXBeginCapture ENDP
+
+IndiciumProxy_PIXEndCapture PROC
+    jmp qword ptr [IndiciumProxyTable + 16 * 8]
+IndiciumProxy_PIXEndCapture ENDP
+
+IndiciumProxy_PIXGetCaptureState PROC
+    jmp qword ptr [IndiciumProxyTable + 17 * 8]
+IndiciumProxy_PIXGetCaptureState ENDP
+
+IndiciumProxy_SetAppCompatStringPointer PROC
+    jmp qword ptr [IndiciumProxyTable + 18 * 8]
+IndiciumProxy_SetAppCompatStringPointer ENDP
+
+IndiciumProxy_UpdateHMDEmulationStatus PROC
+    jmp qword ptr [IndiciumProxyTable + 19 * 8]
+IndiciumProxy_UpdateHMDEmulationStatus ENDP
+
+IndiciumProxyResolveStub PROC FRAME
+    push rcx
+    .pushreg rcx
+    push rdx
+    .pushreg rdx
+    push r8
+    .pushreg r8
+    push r9
+    .pushreg r9
+    push rax
+    .pushreg rax
+    sub rsp, 60h
+    .allocstack 60h
+    .endprolog
+    movdqu xmmword ptr [rsp + 20h], xmm0
+    movdqu xmmword ptr [rsp + 30h], xmm1
+    movdqu xmmword ptr [rsp + 40h], xmm2
+    movdqu xmmword ptr [rsp + 50h], xmm3
+    call IndiciumProxyResolve
+    movdqu xmm0, xmmword ptr [rsp + 20h]
+    movdqu xmm1, xmmword ptr [rsp + 30h]
+    movdqu xmm2, xmmword ptr [rsp + 40h]
+    movdqu xmm3, xmmword ptr [rsp + 50h]
+    add rsp, 60h
+    pop rax
+    pop r9
+    pop r8
+    pop rdx
+    pop rcx
+    lea r10, IndiciumProxyTable
+    jmp qword ptr [r10 + rax * 8]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_ApplyCompatResolutionQuirking PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_ApplyCompatResolutionQuirking ENDP
+
+IndiciumProxyLazy_CompatString PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CompatString ENDP
+
+IndiciumProxyLazy_CompatValue PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CompatValue ENDP
+
+IndiciumProxyLazy_CreateDXGIFactory PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDXGIFactory ENDP
+
+IndiciumProxyLazy_CreateDXGIFactory1 PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDXGIFactory1 ENDP
+
+IndiciumProxyLazy_CreateDXGIFactory2 PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDXGIFactory2 ENDP
+
+IndiciumProxyLazy_DXGID3D10CreateDevice PROC
+    mov eax, 6
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10CreateDevice ENDP
+
+IndiciumProxyLazy_DXGID3D10CreateLayeredDevice PROC
+    mov eax, 7
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10CreateLayeredDevice ENDP
+
+IndiciumProxyLazy_DXGID3D10GetLayeredDeviceSize PROC
+    mov eax, 8
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10GetLayeredDeviceSize ENDP
+
+IndiciumProxyLazy_DXGID3D10RegisterLayers PROC
+    mov eax, 9
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10RegisterLayers ENDP
+
+IndiciumProxyLazy_DXGIDeclareAdapterRemovalSupport PROC
+    mov eax, 10
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIDeclareAdapterRemovalSupport ENDP
+
+IndiciumProxyLazy_DXGIDisableVBlankVirtualization PROC
+    mov eax, 11
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIDisableVBlankVirtualization ENDP
+
+IndiciumProxyLazy_DXGIDumpJournal PROC
+    mov eax, 12
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIDumpJournal ENDP
+
+IndiciumProxyLazy_DXGIGetDebugInterface1 PROC
+    mov eax, 13
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIGetDebugInterface1 ENDP
+
+IndiciumProxyLazy_DXGIReportAdapterConfiguration PROC
+    mov eax, 14
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIReportAdapterConfiguration ENDP
+
+IndiciumProxyLazy_PIXBeginCapture PROC
+    mov eax, 15
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PIXBeginCapture ENDP
+
+IndiciumProxyLazy_PIXEndCapture PROC
+    mov eax, 16
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PIXEndCapture ENDP
+
+IndiciumProxyLazy_PIXGetCaptureState PROC
+    mov eax, 17
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PIXGetCaptureState ENDP
+
+IndiciumProxyLazy_SetAppCompatStringPointer PROC
+    mov eax, 18
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_SetAppCompatStringPointer ENDP
+
+IndiciumProxyLazy_UpdateHMDEmulationStatus PROC
+    mov eax, 19
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_UpdateHMDEmulationStatus ENDP
+
+.data
+
+IndiciumProxyTable LABEL QWORD
+    QWORD IndiciumProxyLazy_ApplyCompatResolutionQuirking
+    QWORD IndiciumProxyLazy_CompatString
+    QWORD IndiciumProxyLazy_CompatValue
+    QWORD IndiciumProxyLazy_CreateDXGIFactory
+    QWORD IndiciumProxyLazy_CreateDXGIFactory1
+    QWORD IndiciumProxyLazy_CreateDXGIFactory2
+    QWORD IndiciumProxyLazy_DXGID3D10CreateDevice
+    QWORD IndiciumProxyLazy_DXGID3D10CreateLayeredDevice
+    QWORD IndiciumProxyLazy_DXGID3D10GetLayeredDeviceSize
+    QWORD IndiciumProxyLazy_DXGID3D10RegisterLayers
+    QWORD IndiciumProxyLazy_DXGIDeclareAdapterRemovalSupport
+    QWORD IndiciumProxyLazy_DXGIDisableVBlankVirtualization
+    QWORD IndiciumProxyLazy_DXGIDumpJournal
+    QWORD IndiciumProxyLazy_DXGIGetDebugInterface1
+    QWORD IndiciumProxyLazy_DXGIReportAdapterConfiguration
+    QWORD IndiciumProxyLazy_PIXBeginCapture
+    QWORD IndiciumProxyLazy_PIXEndCapture
+    QWORD IndiciumProxyLazy_PIXGetCaptureState
+    QWORD IndiciumProxyLazy_SetAppCompatStringPointer
+    QWORD IndiciumProxyLazy_UpdateHMDEmulationStatus
+
+END
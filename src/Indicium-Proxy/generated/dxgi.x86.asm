@@ -0,0 +1,241 @@
+; Generated by Generate-ProxyExports.ps1 from exports\dxgi.txt, do not edit
+.686
+.model flat, C
+
+PUBLIC IndiciumProxyTable
+EXTERN IndiciumProxyGate:PROC
+EXTERN IndiciumProxyResolve:PROC
+
+.code
+
+IndiciumProxy_ApplyCompatResolutionQuirking PROC
+    jmp dword ptr [IndiciumProxyTable + 0 * 4]
+IndiciumProxy_ApplyCompatResolutionQuirking ENDP
+
+IndiciumProxy_CompatString PROC
+    jmp dword ptr [IndiciumProxyTable + 1 * 4]
+IndiciumProxy_CompatString ENDP
+
+IndiciumProxy_CompatValue PROC
+    jmp dword ptr [IndiciumProxyTable + 2 * 4]
+IndiciumProxy_CompatValue ENDP
+
+IndiciumProxy_CreateDXGIFactory PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 3 * 4]
+IndiciumProxy_CreateDXGIFactory ENDP
+
+IndiciumProxy_CreateDXGIFactory1 PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 4 * 4]
+IndiciumProxy_CreateDXGIFactory1 ENDP
+
+IndiciumProxy_CreateDXGIFactory2 PROC
+    push ecx
+    push edx
+    call IndiciumProxyGate
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + 5 * 4]
+IndiciumProxy_CreateDXGIFactory2 ENDP
+
+IndiciumProxy_DXGID3D10CreateDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 6 * 4]
+IndiciumProxy_DXGID3D10CreateDevice ENDP
+
+IndiciumProxy_DXGID3D10CreateLayeredDevice PROC
+    jmp dword ptr [IndiciumProxyTable + 7 * 4]
+IndiciumProxy_DXGID3D10CreateLayeredDevice ENDP
+
+IndiciumProxy_DXGID3D10GetLayeredDeviceSize PROC
+    jmp dword ptr [IndiciumProxyTable + 8 * 4]
+IndiciumProxy_DXGID3D10GetLayeredDeviceSize ENDP
+
+IndiciumProxy_DXGID3D10RegisterLayers PROC
+    jmp dword ptr [IndiciumProxyTable + 9 * 4]
+IndiciumProxy_DXGID3D10RegisterLayers ENDP
+
+IndiciumProxy_DXGIDeclareAdapterRemovalSupport PROC
+    jmp dword ptr [IndiciumProxyTable + 10 * 4]
+IndiciumProxy_DXGIDeclareAdapterRemovalSupport ENDP
+
+IndiciumProxy_DXGIDisableVBlankVirtualization PROC
+    jmp dword ptr [IndiciumProxyTable + 11 * 4]
+IndiciumProxy_DXGIDisableVBlankVirtualization ENDP
+
+IndiciumProxy_DXGIDumpJournal PROC
+    jmp dword ptr [IndiciumProxyTable + 12 * 4]
+IndiciumProxy_DXGIDumpJournal ENDP
+
+IndiciumProxy_DXGIGetDebugInterface1 PROC
+    jmp dword ptr [IndiciumProxyTable + 13 * 4]
+IndiciumProxy_DXGIGetDebugInterface1 ENDP
+
+IndiciumProxy_DXGIReportAdapterConfiguration PROC
+    jmp dword ptr [IndiciumProxyTable + 14 * 4]
+IndiciumProxy_DXGIReportAdapterConfiguration ENDP
+
+IndiciumProxy_PIXBeginCapture PROC
+    jmp dword ptr [IndiciumProxyTable + 15 * 4]
+IndiciumProxy_PIXBeginCapture ENDP
+
+IndiciumProxy_PIXEndCapture PROC
+    jmp dword ptr [IndiciumProxyTable + 16 * 4]
+IndiciumProxy_PIXEndCapture ENDP
+
+IndiciumProxy_PIXGetCaptureState PROC
+    jmp dword ptr [IndiciumProxyTable + 17 * 4]
+IndiciumProxy_PIXGetCaptureState ENDP
+
+IndiciumProxy_SetAppCompatStringPointer PROC
+    jmp dword ptr [IndiciumProxyTable + 18 * 4]
+IndiciumProxy_SetAppCompatStringPointer ENDP
+
+IndiciumProxy_UpdateHMDEmulationStatus PROC
+    jmp dword ptr [IndiciumProxyTable + 19 * 4]
+IndiciumProxy_UpdateHMDEmulationStatus ENDP
+
+IndiciumProxyResolveStub PROC
+    push ecx
+    push edx
+    push eax
+    call IndiciumProxyResolve
+    pop eax
+    pop edx
+    pop ecx
+    jmp dword ptr [IndiciumProxyTable + eax * 4]
+IndiciumProxyResolveStub ENDP
+
+IndiciumProxyLazy_ApplyCompatResolutionQuirking PROC
+    mov eax, 0
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_ApplyCompatResolutionQuirking ENDP
+
+IndiciumProxyLazy_CompatString PROC
+    mov eax, 1
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CompatString ENDP
+
+IndiciumProxyLazy_CompatValue PROC
+    mov eax, 2
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CompatValue ENDP
+
+IndiciumProxyLazy_CreateDXGIFactory PROC
+    mov eax, 3
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDXGIFactory ENDP
+
+IndiciumProxyLazy_CreateDXGIFactory1 PROC
+    mov eax, 4
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDXGIFactory1 ENDP
+
+IndiciumProxyLazy_CreateDXGIFactory2 PROC
+    mov eax, 5
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_CreateDXGIFactory2 ENDP
+
+IndiciumProxyLazy_DXGID3D10CreateDevice PROC
+    mov eax, 6
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10CreateDevice ENDP
+
+IndiciumProxyLazy_DXGID3D10CreateLayeredDevice PROC
+    mov eax, 7
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10CreateLayeredDevice ENDP
+
+IndiciumProxyLazy_DXGID3D10GetLayeredDeviceSize PROC
+    mov eax, 8
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10GetLayeredDeviceSize ENDP
+
+IndiciumProxyLazy_DXGID3D10RegisterLayers PROC
+    mov eax, 9
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGID3D10RegisterLayers ENDP
+
+IndiciumProxyLazy_DXGIDeclareAdapterRemovalSupport PROC
+    mov eax, 10
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIDeclareAdapterRemovalSupport ENDP
+
+IndiciumProxyLazy_DXGIDisableVBlankVirtualization PROC
+    mov eax, 11
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIDisableVBlankVirtualization ENDP
+
+IndiciumProxyLazy_DXGIDumpJournal PROC
+    mov eax, 12
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIDumpJournal ENDP
+
+IndiciumProxyLazy_DXGIGetDebugInterface1 PROC
+    mov eax, 13
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIGetDebugInterface1 ENDP
+
+IndiciumProxyLazy_DXGIReportAdapterConfiguration PROC
+    mov eax, 14
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_DXGIReportAdapterConfiguration ENDP
+
+IndiciumProxyLazy_PIXBeginCapture PROC
+    mov eax, 15
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PIXBeginCapture ENDP
+
+IndiciumProxyLazy_PIXEndCapture PROC
+    mov eax, 16
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PIXEndCapture ENDP
+
+IndiciumProxyLazy_PIXGetCaptureState PROC
+    mov eax, 17
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_PIXGetCaptureState ENDP
+
+IndiciumProxyLazy_SetAppCompatStringPointer PROC
+    mov eax, 18
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_SetAppCompatStringPointer ENDP
+
+IndiciumProxyLazy_UpdateHMDEmulationStatus PROC
+    mov eax, 19
+    jmp IndiciumProxyResolveStub
+IndiciumProxyLazy_UpdateHMDEmulationStatus ENDP
+
+.data
+
+IndiciumProxyTable LABEL DWORD
+    DWORD IndiciumProxyLazy_ApplyCompatResolutionQuirking
+    DWORD IndiciumProxyLazy_CompatString
+    DWORD IndiciumProxyLazy_CompatValue
+    DWORD IndiciumProxyLazy_CreateDXGIFactory
+    DWORD IndiciumProxyLazy_CreateDXGIFactory1
+    DWORD IndiciumProxyLazy_CreateDXGIFactory2
+    DWORD IndiciumProxyLazy_DXGID3D10CreateDevice
+    DWORD IndiciumProxyLazy_DXGID3D10CreateLayeredDevice
+    DWORD IndiciumProxyLazy_DXGID3D10GetLayeredDeviceSize
+    DWORD IndiciumProxyLazy_DXGID3D10RegisterLayers
+    DWORD IndiciumProxyLazy_DXGIDeclareAdapterRemovalSupport
+    DWORD IndiciumProxyLazy_DXGIDisableVBlankVirtualization
+    DWORD IndiciumProxyLazy_DXGIDumpJournal
+    DWORD IndiciumProxyLazy_DXGIGetDebugInterface1
+    DWORD IndiciumProxyLazy_DXGIReportAdapterConfiguration
+    DWORD IndiciumProxyLazy_PIXBeginCapture
+    DWORD IndiciumProxyLazy_PIXEndCapture
+    DWORD IndiciumProxyLazy_PIXGetCaptureState
+    DWORD IndiciumProxyLazy_SetAppCompatStringPointer
+    DWORD IndiciumProxyLazy_UpdateHMDEmulationStatus
+
+END
@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ArcEventBatcher.h"
+#include "Memory.h"
+
+//
+// Owner of a slot whose client got released, until its remaining records got delivered
+//
+static IAudioRenderClient* const SlotReleased = reinterpret_cast<IAudioRenderClient*>(1);
+
+Indicium::Core::Audio::ArcEventBatcher::ArcEventBatcher(
+	const INDICIUM_ARC_BATCH_CONFIG& config,
+	Stats::CounterRegistry& counters
+) :
+	records_per_client_(config.RecordsPerClient ? config.RecordsPerClient : 1024),
+	callback_(nullptr),
+	delivery_(IndiciumARCBatchDeliveryPresent),
+	worker_interval_(16),
+	reported_dropped_(0)
+{
+	//
+	// Room for a full ring of two clients per batch, remaining records stay queued for the next one
+	//
+	scratch_.resize(records_per_client_ * 2);
+
+	configure(config);
+
+	counters.attach("arc.batch.delivered", delivered_);
+	counters.attach("arc.batch.dropped", dropped_);
+}
+
+void Indicium::Core::Audio::ArcEventBatcher::configure(const INDICIUM_ARC_BATCH_CONFIG& config)
+{
+	worker_interval_ = config.WorkerIntervalMs ? config.WorkerIntervalMs : 16;
+	delivery_ = config.Delivery;
+	callback_ = config.EvtIndiciumARCEventBatch;
+}
+
+Indicium::Core::Audio::ArcEventBatcher::ClientSlot* Indicium::Core::Audio::ArcEventBatcher::slot_for(
+	IAudioRenderClient* client)
+{
+	//
+	// Fast path: client already owns a slot; released slots leave gaps, so look at all of them
+	//
+	for (auto& slot : slots_)
+	{
+		if (slot.client.load(std::memory_order_acquire) == client)
+			return &slot;
+	}
+
+	//
+	// Slow path, once per client: only claims turn a free slot into an owned one, so under the
+	// lock the client either owns a slot by now or the free one stays free
+	//
+	std::lock_guard<std::mutex> guard(claiming_);
+
+	ClientSlot* free = nullptr;
+
+	for (auto& slot : slots_)
+	{
+		const auto owner = slot.client.load(std::memory_order_acquire);
+
+		if (owner == client)
+			return &slot;
+
+		if (owner == nullptr && !free)
+			free = &slot;
+	}
+
+	if (!free)
+		return nullptr;
+
+	if (!free->ring)
+	{
+		try
+		{
+			Memory::Scope scope(IndiciumMemoryTagAudio);
+
+			free->ring = std::make_unique<Util::SpscRing<INDICIUM_ARC_EVENT_RECORD>>(records_per_client_);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return nullptr;
+		}
+	}
+
+	free->client.store(client, std::memory_order_release);
+
+	return free;
+}
+
+void Indicium::Core::Audio::ArcEventBatcher::on_released(IUnknown* object)
+{
+	//
+	// Either kind of object ends up here; the pointer only serves as a key
+	//
+	const auto client = reinterpret_cast<IAudioRenderClient*>(object);
+
+	for (auto& slot : slots_)
+	{
+		auto expected = client;
+
+		if (slot.client.compare_exchange_strong(expected, SlotReleased, std::memory_order_acq_rel))
+			return;
+	}
+}
+
+void Indicium::Core::Audio::ArcEventBatcher::record(
+	IAudioRenderClient* client,
+	INDICIUM_ARC_EVENT_TYPE type,
+	UINT32 frames,
+	DWORD flags,
+	HRESULT result
+)
+{
+	const auto slot = slot_for(client);
+
+	if (!slot)
+	{
+		dropped_.add();
+		return;
+	}
+
+	INDICIUM_ARC_EVENT_RECORD record;
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	record.Client = client;
+	record.Timestamp = now.QuadPart;
+	record.NumFrames = frames;
+	record.Flags = flags;
+	record.Result = result;
+	record.Type = type;
+
+	if (!slot->ring->try_push(record))
+	{
+		dropped_.add();
+	}
+}
+
+void Indicium::Core::Audio::ArcEventBatcher::deliver(PINDICIUM_ENGINE engine, INDICIUM_ARC_BATCH_DELIVERY origin)
+{
+	if (delivery_.load(std::memory_order_relaxed) != origin)
+		return;
+
+	//
+	// Never block the caller; if another thread is delivering we simply skip this round
+	//
+	if (draining_.test_and_set(std::memory_order_acquire))
+		return;
+
+	size_t count = 0;
+
+	for (auto& slot : slots_)
+	{
+		const auto owner = slot.client.load(std::memory_order_acquire);
+
+		if (owner == nullptr)
+			continue;
+
+		count += slot.ring->pop_bulk(scratch_.data() + count, scratch_.size() - count);
+
+		//
+		// Nothing pushes to a released slot anymore, free it once it ran empty
+		//
+		if (owner == SlotReleased && !slot.ring->size_approx())
+			slot.client.store(nullptr, std::memory_order_release);
+	}
+
+	//
+	// The counter keeps running for the snapshot, report only what was lost since last time
+	//
+	const auto dropped_total = dropped_.load();
+	const auto dropped = dropped_total - reported_dropped_;
+	reported_dropped_ = dropped_total;
+
+	delivered_.add(count);
+
+	const auto callback = callback_.load(std::memory_order_acquire);
+
+	if (callback && (count || dropped))
+	{
+		INDICIUM_EVT_POST_EXTENSION post;
+		INDICIUM_EVT_POST_EXTENSION_INIT(&post, engine, IndiciumEngineGetCustomContext(engine));
+
+		callback(scratch_.data(), count, dropped, &post);
+	}
+
+	draining_.clear(std::memory_order_release);
+}
+
+DWORD Indicium::Core::Audio::ArcEventBatcher::worker_interval() const
+{
+	if (delivery_.load(std::memory_order_relaxed) != IndiciumARCBatchDeliveryWorker)
+		return INFINITE;
+
+	return worker_interval_.load(std::memory_order_relaxed);
+}
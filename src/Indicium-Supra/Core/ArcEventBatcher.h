@@ -0,0 +1,124 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumCoreAudio.h"
+
+#include "Utils/SpscRing.h"
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Audio
+        {
+            /**
+             * \brief   Collects Audio Render Client call records on the audio thread(s) and hands
+             *          them out as one batch per Present (or worker tick).
+             *
+             *          Every render client gets its own single-producer/single-consumer ring, so
+             *          the audio thread never contends with other clients or the consumer. Slots
+             *          are claimed on first use and given back when the client gets released;
+             *          the consumer drains what the client recorded before the slot gets reused.
+             */
+            class ArcEventBatcher
+            {
+            public:
+                static const size_t MaxClients = 16;
+
+            private:
+                struct alignas(64) ClientSlot
+                {
+                    std::atomic<IAudioRenderClient*> client{ nullptr };
+
+                    //
+                    // Allocated by the first claim, reused by later clients
+                    //
+                    std::unique_ptr<Util::SpscRing<INDICIUM_ARC_EVENT_RECORD>> ring;
+                };
+
+                ClientSlot slots_[MaxClients];
+                size_t records_per_client_;
+
+                //
+                // Serializes claims, so a client racing itself ends up with a single slot
+                //
+                std::mutex claiming_;
+
+                //
+                // Records lost to a full ring or because every slot was taken by another client
+                //
+                Util::ShardedCounter dropped_;
+                Util::ShardedCounter delivered_;
+
+                std::atomic<PFN_INDICIUM_ARC_EVENT_BATCH> callback_;
+                std::atomic<INDICIUM_ARC_BATCH_DELIVERY> delivery_;
+                std::atomic<UINT32> worker_interval_;
+
+                //
+                // Consumer side; guarded by draining_
+                //
+                std::vector<INDICIUM_ARC_EVENT_RECORD> scratch_;
+                std::atomic_flag draining_ = ATOMIC_FLAG_INIT;
+                ULONGLONG reported_dropped_;
+
+                ClientSlot* slot_for(IAudioRenderClient* client);
+
+            public:
+                ArcEventBatcher(const INDICIUM_ARC_BATCH_CONFIG& config, Stats::CounterRegistry& counters);
+
+                void configure(const INDICIUM_ARC_BATCH_CONFIG& config);
+
+                void record(
+                    IAudioRenderClient* client,
+                    INDICIUM_ARC_EVENT_TYPE type,
+                    UINT32 frames,
+                    DWORD flags,
+                    HRESULT result
+                );
+
+                void deliver(PINDICIUM_ENGINE engine, INDICIUM_ARC_BATCH_DELIVERY origin);
+
+                /**
+                 * \brief   Gives back the slot of a render client going away.
+                 */
+                void on_released(IUnknown* object);
+
+                DWORD worker_interval() const;
+            };
+        };
+    };
+};
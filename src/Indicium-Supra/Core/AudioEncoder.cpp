@@ -0,0 +1,424 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "AudioEncoder.h"
+#include "Memory.h"
+
+#include <opus/opus.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <system_error>
+
+Indicium::Core::Audio::AudioEncoder::AudioEncoder(Stats::CounterRegistry& counters) :
+	segment_(false),
+	discontinuity_(true),
+	next_(0),
+	pending_(PendingFrames),
+	encoder_(nullptr),
+	encoder_rate_(0),
+	stopping_(false),
+	wake_(CreateEvent(nullptr, FALSE, FALSE, nullptr)),
+	lookahead_(0),
+	encode_ticks_(0),
+	encoded_frames_(0),
+	encoded_rate_(0),
+	head_(0),
+	count_(0),
+	sequence_(0),
+	started_packets_(0),
+	started_bytes_(0),
+	started_dropped_packets_(0),
+	started_dropped_frames_(0),
+	started_discontinuities_(0)
+{
+	ZeroMemory(&config_, sizeof(config_));
+	assembly_.frames = 0;
+	assembly_.rate = 0;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	frequency_ = double(frequency.QuadPart);
+
+	counters.attach("audio_encoder.packets", packets_);
+	counters.attach("audio_encoder.bytes", bytes_);
+	counters.attach("audio_encoder.dropped_packets", dropped_packets_);
+	counters.attach("audio_encoder.dropped_frames", dropped_frames_);
+	counters.attach("audio_encoder.discontinuities", discontinuities_);
+	counters.attach("audio_encoder.failures", failures_);
+}
+
+Indicium::Core::Audio::AudioEncoder::~AudioEncoder()
+{
+	//
+	// The mixer is either gone or detached from us by now, only the thread is left
+	//
+	stopping_.store(true);
+
+	if (thread_.joinable())
+	{
+		SetEvent(wake_);
+		thread_.join();
+	}
+
+	Memory::release(encoder_);
+
+	if (wake_)
+		CloseHandle(wake_);
+}
+
+bool Indicium::Core::Audio::AudioEncoder::supported_rate(UINT32 rate)
+{
+	return rate == 8000 || rate == 12000 || rate == 16000 || rate == 24000 || rate == 48000;
+}
+
+bool Indicium::Core::Audio::AudioEncoder::running() const
+{
+	return thread_.joinable();
+}
+
+INDICIUM_ERROR Indicium::Core::Audio::AudioEncoder::start(
+	AudioMixer& mixer,
+	const INDICIUM_AUDIO_ENCODER_CONFIG& config
+)
+{
+	if (!wake_)
+		return INDICIUM_ERROR_CREATE_EVENT_FAILED;
+
+	stop(mixer);
+
+	{
+		std::lock_guard<std::mutex> guard(queue_lock_);
+
+		try
+		{
+			queue_.assign(config.QueueCapacity, INDICIUM_AUDIO_PACKET());
+		}
+		catch (const std::bad_alloc&)
+		{
+			queue_.clear();
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+
+		head_ = 0;
+		count_ = 0;
+		sequence_ = 0;
+	}
+
+	//
+	// Settings only apply to a new encoder, it gets created with the first frame
+	//
+	Memory::release(encoder_);
+
+	encoder_ = nullptr;
+	encoder_rate_ = 0;
+
+	PcmFrame frame;
+	while (pending_.try_pop(frame))
+		;
+
+	config_ = config;
+	segment_ = false;
+	assembly_.frames = 0;
+
+	lookahead_.store(0);
+	encode_ticks_.store(0, std::memory_order_relaxed);
+	encoded_frames_.store(0, std::memory_order_relaxed);
+
+	started_packets_ = packets_.load();
+	started_bytes_ = bytes_.load();
+	started_dropped_packets_ = dropped_packets_.load();
+	started_dropped_frames_ = dropped_frames_.load();
+	started_discontinuities_ = discontinuities_.load();
+
+	stopping_.store(false);
+
+	try
+	{
+		thread_ = std::thread(&AudioEncoder::run, this);
+	}
+	catch (const std::system_error&)
+	{
+		return INDICIUM_ERROR_CREATE_THREAD_FAILED;
+	}
+
+	mixer.attach(this);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Audio::AudioEncoder::stop(AudioMixer& mixer)
+{
+	mixer.attach(nullptr);
+
+	if (!thread_.joinable())
+		return;
+
+	stopping_.store(true);
+	SetEvent(wake_);
+	thread_.join();
+}
+
+void Indicium::Core::Audio::AudioEncoder::on_mix(const INDICIUM_AUDIO_MIX_BLOCK& block)
+{
+	//
+	// Mixdown restarted at a rate Opus can't encode: counted as lost, the next supported block
+	// starts a new segment flagged as discontinuity
+	//
+	if (!supported_rate(block.SampleRate))
+	{
+		if (segment_)
+		{
+			dropped_frames_.add(assembly_.frames);
+			assembly_.frames = 0;
+			segment_ = false;
+		}
+
+		dropped_frames_.add(block.Frames);
+		return;
+	}
+
+	//
+	// Restarted mixdown, or one that skipped ahead by more than a second after a stall
+	//
+	if (segment_ && (block.SampleRate != assembly_.rate || block.FirstFrame < next_
+		|| block.FirstFrame - next_ > block.SampleRate))
+	{
+		dropped_frames_.add(assembly_.frames);
+		segment_ = false;
+	}
+
+	if (!segment_)
+	{
+		assembly_.frames = 0;
+		assembly_.rate = block.SampleRate;
+		next_ = block.FirstFrame;
+		discontinuity_ = true;
+		segment_ = true;
+	}
+
+	//
+	// Shorter gaps get filled with silence, so packet times keep following from their indices
+	//
+	if (block.FirstFrame > next_)
+		append(nullptr, UINT32(block.FirstFrame - next_), block);
+
+	append(block.Samples, block.Frames, block);
+}
+
+void Indicium::Core::Audio::AudioEncoder::append(
+	const float* samples,
+	UINT32 frames,
+	const INDICIUM_AUDIO_MIX_BLOCK& block
+)
+{
+	const auto frame_size = assembly_.rate * config_.FrameMs / 1000;
+
+	while (frames)
+	{
+		if (!assembly_.frames)
+		{
+			assembly_.first = next_;
+			assembly_.timestamp = block.Timestamp
+				+ LONGLONG((double(next_) - double(block.FirstFrame)) * frequency_ / block.SampleRate);
+		}
+
+		const auto count = (std::min)(frames, frame_size - assembly_.frames);
+		const auto target = assembly_.samples + assembly_.frames * 2;
+
+		if (samples)
+		{
+			memcpy(target, samples, count * 2 * sizeof(float));
+			samples += count * 2;
+		}
+		else
+			memset(target, 0, count * 2 * sizeof(float));
+
+		assembly_.frames += count;
+		next_ += count;
+		frames -= count;
+
+		if (assembly_.frames < frame_size)
+			continue;
+
+		assembly_.discontinuity = discontinuity_;
+
+		if (pending_.try_push(assembly_))
+		{
+			discontinuity_ = false;
+			SetEvent(wake_);
+		}
+		else
+		{
+			dropped_frames_.add(frame_size);
+			discontinuity_ = true;
+		}
+
+		assembly_.frames = 0;
+	}
+}
+
+void Indicium::Core::Audio::AudioEncoder::run()
+{
+	Memory::Scope scope(IndiciumMemoryTagAudio);
+
+	PcmFrame frame;
+
+	while (!stopping_.load())
+	{
+		WaitForSingleObject(wake_, INFINITE);
+
+		while (!stopping_.load() && pending_.try_pop(frame))
+			encode(frame);
+	}
+}
+
+void Indicium::Core::Audio::AudioEncoder::encode(PcmFrame& frame)
+{
+	if (!encoder_ || encoder_rate_ != frame.rate)
+	{
+		Memory::release(encoder_);
+
+		//
+		// Encoder state lives in engine memory, opus_encoder_create would take it from the CRT heap
+		//
+		encoder_ = static_cast<OpusEncoder*>(Memory::allocate(size_t(opus_encoder_get_size(2)), IndiciumMemoryTagAudio));
+
+		if (!encoder_ || opus_encoder_init(
+			encoder_,
+			opus_int32(frame.rate),
+			2,
+			config_.LowDelay ? OPUS_APPLICATION_RESTRICTED_LOWDELAY : OPUS_APPLICATION_AUDIO
+		) != OPUS_OK)
+		{
+			Memory::release(encoder_);
+			encoder_ = nullptr;
+			failures_.add();
+			return;
+		}
+
+		opus_encoder_ctl(encoder_, OPUS_SET_BITRATE(opus_int32(config_.Bitrate)));
+		opus_encoder_ctl(encoder_, OPUS_SET_COMPLEXITY(opus_int32(config_.Complexity)));
+
+		opus_int32 lookahead = 0;
+		opus_encoder_ctl(encoder_, OPUS_GET_LOOKAHEAD(&lookahead));
+
+		lookahead_.store(UINT32(lookahead));
+		encoder_rate_ = frame.rate;
+	}
+	else if (frame.discontinuity)
+		opus_encoder_ctl(encoder_, OPUS_RESET_STATE);
+
+	INDICIUM_AUDIO_PACKET packet;
+	LARGE_INTEGER begin, end;
+
+	QueryPerformanceCounter(&begin);
+
+	const auto size = opus_encode_float(encoder_, frame.samples, int(frame.frames),
+		packet.Data, opus_int32(sizeof(packet.Data)));
+
+	QueryPerformanceCounter(&end);
+
+	if (size < 0)
+	{
+		failures_.add();
+		return;
+	}
+
+	encode_ticks_.fetch_add(ULONGLONG(end.QuadPart - begin.QuadPart), std::memory_order_relaxed);
+	encoded_frames_.fetch_add(frame.frames, std::memory_order_relaxed);
+	encoded_rate_.store(frame.rate);
+
+	packet.FirstFrame = frame.first;
+	packet.Timestamp = frame.timestamp;
+	packet.Frames = frame.frames;
+	packet.SampleRate = frame.rate;
+	packet.Flags = frame.discontinuity ? INDICIUM_AUDIO_PACKET_FLAG_DISCONTINUITY : 0;
+	packet.Size = UINT32(size);
+
+	if (frame.discontinuity)
+		discontinuities_.add();
+
+	packets_.add();
+	bytes_.add(packet.Size);
+
+	enqueue(packet);
+}
+
+void Indicium::Core::Audio::AudioEncoder::enqueue(const INDICIUM_AUDIO_PACKET& packet)
+{
+	{
+		std::lock_guard<std::mutex> guard(queue_lock_);
+
+		const auto capacity = queue_.size();
+
+		if (count_ == capacity)
+		{
+			head_ = (head_ + 1) % capacity;
+			count_--;
+			dropped_packets_.add();
+		}
+
+		auto& slot = queue_[(head_ + count_) % capacity];
+		slot = packet;
+		slot.Sequence = sequence_++;
+		count_++;
+	}
+
+	queue_ready_.notify_one();
+}
+
+bool Indicium::Core::Audio::AudioEncoder::read(PINDICIUM_AUDIO_PACKET packet, DWORD timeout)
+{
+	std::unique_lock<std::mutex> guard(queue_lock_);
+
+	if (!queue_ready_.wait_for(guard, std::chrono::milliseconds(timeout), [this] { return count_ > 0; }))
+		return false;
+
+	*packet = queue_[head_];
+	head_ = (head_ + 1) % queue_.size();
+	count_--;
+
+	return true;
+}
+
+void Indicium::Core::Audio::AudioEncoder::statistics(PINDICIUM_AUDIO_ENCODER_STATISTICS statistics)
+{
+	ZeroMemory(statistics, sizeof(INDICIUM_AUDIO_ENCODER_STATISTICS));
+
+	statistics->Packets = packets_.load() - started_packets_;
+	statistics->Bytes = bytes_.load() - started_bytes_;
+	statistics->DroppedPackets = dropped_packets_.load() - started_dropped_packets_;
+	statistics->DroppedFrames = dropped_frames_.load() - started_dropped_frames_;
+	statistics->Discontinuities = discontinuities_.load() - started_discontinuities_;
+	statistics->LookaheadFrames = lookahead_.load();
+
+	const auto frames = encoded_frames_.load(std::memory_order_relaxed);
+	const auto rate = encoded_rate_.load();
+
+	if (frames && rate)
+		statistics->EncodeLoad = (double(encode_ticks_.load(std::memory_order_relaxed)) / frequency_) / (double(frames) / rate);
+}
@@ -0,0 +1,163 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumAudioMix.h"
+#include "Indicium/Engine/IndiciumAudioEncoder.h"
+
+#include "Utils/SpscRing.h"
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+#include "AudioMixer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct OpusEncoder;
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Audio
+        {
+            /**
+             * \brief   Encodes the mixdown into Opus packets.
+             *
+             *          The engine thread cuts mixed blocks into frames of the packet duration and
+             *          hands them to the encoder thread through a single-producer/single-consumer
+             *          ring; if the encoder falls behind, frames get dropped instead of delaying the
+             *          mixdown. Packets wait in a bounded queue for readers, dropping the oldest.
+             */
+            class AudioEncoder : public MixSink
+            {
+            public:
+                //
+                // 20 milliseconds at 48 kHz
+                //
+                static const UINT32 MaxFrameSize = 960;
+
+                //
+                // Frames queued towards the encoder thread
+                //
+                static const size_t PendingFrames = 16;
+
+                struct PcmFrame
+                {
+                    ULONGLONG first;
+                    LONGLONG timestamp;
+                    UINT32 rate;
+                    UINT32 frames;
+                    bool discontinuity;
+                    float samples[MaxFrameSize * 2];
+                };
+
+            private:
+                INDICIUM_AUDIO_ENCODER_CONFIG config_;
+                double frequency_;
+
+                //
+                // Engine thread side, assembling frames from mixed blocks
+                //
+                PcmFrame assembly_;
+                bool segment_;
+                bool discontinuity_;
+                ULONGLONG next_;
+
+                //
+                // Encoder thread side
+                //
+                Util::SpscRing<PcmFrame> pending_;
+                OpusEncoder* encoder_;
+                UINT32 encoder_rate_;
+                std::atomic<bool> stopping_;
+                HANDLE wake_;
+                std::thread thread_;
+                std::atomic<UINT32> lookahead_;
+                std::atomic<ULONGLONG> encode_ticks_;
+                std::atomic<ULONGLONG> encoded_frames_;
+                std::atomic<UINT32> encoded_rate_;
+
+                //
+                // Packets waiting for readers, oldest at head_
+                //
+                std::mutex queue_lock_;
+                std::condition_variable queue_ready_;
+                std::vector<INDICIUM_AUDIO_PACKET> queue_;
+                size_t head_;
+                size_t count_;
+                ULONGLONG sequence_;
+
+                Util::ShardedCounter packets_;
+                Util::ShardedCounter bytes_;
+                Util::ShardedCounter dropped_packets_;
+                Util::ShardedCounter dropped_frames_;
+                Util::ShardedCounter discontinuities_;
+                Util::ShardedCounter failures_;
+                ULONGLONG started_packets_;
+                ULONGLONG started_bytes_;
+                ULONGLONG started_dropped_packets_;
+                ULONGLONG started_dropped_frames_;
+                ULONGLONG started_discontinuities_;
+
+                void append(const float* samples, UINT32 frames, const INDICIUM_AUDIO_MIX_BLOCK& block);
+                void run();
+                void encode(PcmFrame& frame);
+                void enqueue(const INDICIUM_AUDIO_PACKET& packet);
+
+            public:
+                explicit AudioEncoder(Stats::CounterRegistry& counters);
+                ~AudioEncoder();
+
+                AudioEncoder(const AudioEncoder&) = delete;
+                AudioEncoder& operator=(const AudioEncoder&) = delete;
+
+                static bool supported_rate(UINT32 rate);
+
+                //
+                // Between start and stop; callers serialize this with them
+                //
+                bool running() const;
+
+                INDICIUM_ERROR start(AudioMixer& mixer, const INDICIUM_AUDIO_ENCODER_CONFIG& config);
+                void stop(AudioMixer& mixer);
+
+                void on_mix(const INDICIUM_AUDIO_MIX_BLOCK& block) override;
+
+                bool read(PINDICIUM_AUDIO_PACKET packet, DWORD timeout);
+
+                void statistics(PINDICIUM_AUDIO_ENCODER_STATISTICS statistics);
+            };
+        };
+    };
+};
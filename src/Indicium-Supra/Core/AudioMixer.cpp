@@ -0,0 +1,817 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "AudioMixer.h"
+#include "Memory.h"
+
+#include <mmreg.h>
+#include <ksmedia.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <new>
+#include <thread>
+
+//
+// Anchors are taken once per buffer, so this covers over a second of buffers between ticks
+//
+static const size_t AnchorsPerClient = 128;
+
+//
+// Anchor weight kept per buffer; about twenty seconds of history at common 10 ms periods
+//
+static const double ClockForgetting = 0.9995;
+
+//
+// Anchor off its clock by more than this means the stream paused or glitched
+//
+static const double ClockResetSeconds = 0.05;
+
+//
+// Client without a released buffer for this long stops contributing
+//
+static const double InactiveSeconds = 0.5;
+
+//
+// Steering of the read positions: +-0.2% at most (about 3.5 cents of pitch), settling within
+// a couple of seconds, jumping once off by more than 100 ms
+//
+static const Indicium::Core::Audio::DriftCompensator::Config DriftConfig = { 0.002, 0.5, 0.05, 0.1 };
+
+//
+// Stereo gains of the speaker positions in channel mask order, front left to top back right
+//
+static const float SpeakerGains[Indicium::Core::Audio::AudioMixer::MaxChannels][2] =
+{
+	{ 1.0f, 0.0f },         // FRONT_LEFT
+	{ 0.0f, 1.0f },         // FRONT_RIGHT
+	{ 0.7071f, 0.7071f },   // FRONT_CENTER
+	{ 0.0f, 0.0f },         // LOW_FREQUENCY
+	{ 0.7071f, 0.0f },      // BACK_LEFT
+	{ 0.0f, 0.7071f },      // BACK_RIGHT
+	{ 0.9239f, 0.3827f },   // FRONT_LEFT_OF_CENTER
+	{ 0.3827f, 0.9239f },   // FRONT_RIGHT_OF_CENTER
+	{ 0.5f, 0.5f },         // BACK_CENTER
+	{ 0.7071f, 0.0f },      // SIDE_LEFT
+	{ 0.0f, 0.7071f },      // SIDE_RIGHT
+	{ 0.5f, 0.5f },         // TOP_CENTER
+	{ 0.7071f, 0.0f },      // TOP_FRONT_LEFT
+	{ 0.5f, 0.5f },         // TOP_FRONT_CENTER
+	{ 0.0f, 0.7071f },      // TOP_FRONT_RIGHT
+	{ 0.7071f, 0.0f },      // TOP_BACK_LEFT
+	{ 0.5f, 0.5f },         // TOP_BACK_CENTER
+	{ 0.0f, 0.7071f },      // TOP_BACK_RIGHT
+};
+
+Indicium::Core::Audio::AudioMixer::AudioMixer(Stats::CounterRegistry& counters) :
+	active_(false),
+	sink_(nullptr),
+	origin_(0),
+	mixed_(0),
+	active_clients_(0),
+	maximum_drift_ppm_(0.0),
+	started_frames_(0),
+	started_underruns_(0),
+	started_resyncs_(0)
+{
+	ZeroMemory(&config_, sizeof(config_));
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	frequency_ = double(frequency.QuadPart);
+
+	counters.attach("audio_mix.frames", frames_);
+	counters.attach("audio_mix.underruns", underruns_);
+	counters.attach("audio_mix.resyncs", resyncs_);
+}
+
+Indicium::Core::Audio::AudioMixer::Format Indicium::Core::Audio::AudioMixer::parse_format(const WAVEFORMATEX* format)
+{
+	Format result;
+	ZeroMemory(&result, sizeof(result));
+
+	if (!format || !format->nChannels || format->nChannels > MaxChannels || !format->nSamplesPerSec)
+		return result;
+
+	auto tag = format->wFormatTag;
+	auto bits = format->wBitsPerSample;
+	DWORD mask = 0;
+
+	if (tag == WAVE_FORMAT_EXTENSIBLE && format->cbSize >= sizeof(WAVEFORMATEXTENSIBLE) - sizeof(WAVEFORMATEX))
+	{
+		const auto extensible = reinterpret_cast<const WAVEFORMATEXTENSIBLE*>(format);
+
+		//
+		// KSDATAFORMAT_SUBTYPE_PCM and _IEEE_FLOAT carry the format tag in their first field
+		//
+		if (extensible->SubFormat.Data2 != 0x0000 || extensible->SubFormat.Data3 != 0x0010)
+			return result;
+
+		tag = WORD(extensible->SubFormat.Data1);
+		mask = extensible->dwChannelMask;
+	}
+
+	//
+	// Samples get read by their container size, e.g. 24 valid bits in 32 are read as 32
+	//
+	const auto container = format->nBlockAlign / format->nChannels;
+
+	if (tag == WAVE_FORMAT_IEEE_FLOAT && container == 4)
+		result.type = SampleType::Float32;
+	else if (tag == WAVE_FORMAT_PCM && container == 1)
+		result.type = SampleType::UInt8;
+	else if (tag == WAVE_FORMAT_PCM && container == 2)
+		result.type = SampleType::Int16;
+	else if (tag == WAVE_FORMAT_PCM && container == 3)
+		result.type = SampleType::Int24;
+	else if (tag == WAVE_FORMAT_PCM && container == 4 && bits <= 32)
+		result.type = SampleType::Int32;
+	else
+		return result;
+
+	result.channels = format->nChannels;
+	result.rate = format->nSamplesPerSec;
+	result.block_align = format->nBlockAlign;
+
+	if (result.channels == 1 && (mask == 0 || mask == SPEAKER_FRONT_CENTER))
+	{
+		result.gains[0][0] = result.gains[0][1] = 1.0f;
+		return result;
+	}
+
+	if (mask == 0)
+	{
+		switch (result.channels)
+		{
+		case 6:
+			mask = KSAUDIO_SPEAKER_5POINT1;
+			break;
+		case 8:
+			mask = KSAUDIO_SPEAKER_7POINT1_SURROUND;
+			break;
+		default:
+			mask = (1UL << result.channels) - 1;
+			break;
+		}
+	}
+
+	//
+	// Channels are ordered by the speaker bits set in the mask, channels beyond it stay silent
+	//
+	UINT32 channel = 0;
+
+	for (UINT32 speaker = 0; speaker < MaxChannels && channel < result.channels; speaker++)
+	{
+		if (!(mask & (1UL << speaker)))
+			continue;
+
+		result.gains[channel][0] = SpeakerGains[speaker][0];
+		result.gains[channel][1] = SpeakerGains[speaker][1];
+		channel++;
+	}
+
+	return result;
+}
+
+void Indicium::Core::Audio::AudioMixer::to_stereo(const Format& format, const BYTE* data, UINT32 frames, float* out)
+{
+	const auto channels = format.channels;
+
+	for (UINT32 frame = 0; frame < frames; frame++, data += format.block_align, out += 2)
+	{
+		float left = 0.0f;
+		float right = 0.0f;
+
+		for (UINT32 channel = 0; channel < channels; channel++)
+		{
+			float sample;
+
+			switch (format.type)
+			{
+			case SampleType::UInt8:
+				sample = (float(data[channel]) - 128.0f) * (1.0f / 128.0f);
+				break;
+			case SampleType::Int16:
+			{
+				INT16 value;
+				memcpy(&value, data + channel * 2, sizeof(value));
+				sample = float(value) * (1.0f / 32768.0f);
+				break;
+			}
+			case SampleType::Int24:
+			{
+				const auto p = data + channel * 3;
+				const auto value = INT32(UINT32(p[0]) << 8 | UINT32(p[1]) << 16 | UINT32(p[2]) << 24) >> 8;
+				sample = float(value) * (1.0f / 8388608.0f);
+				break;
+			}
+			case SampleType::Int32:
+			{
+				INT32 value;
+				memcpy(&value, data + channel * 4, sizeof(value));
+				sample = float(value) * (1.0f / 2147483648.0f);
+				break;
+			}
+			case SampleType::Float32:
+				memcpy(&sample, data + channel * 4, sizeof(sample));
+				break;
+			default:
+				sample = 0.0f;
+				break;
+			}
+
+			left += format.gains[channel][0] * sample;
+			right += format.gains[channel][1] * sample;
+		}
+
+		out[0] = left;
+		out[1] = right;
+	}
+}
+
+void Indicium::Core::Audio::AudioMixer::interpolate(
+	const float* ring,
+	ULONGLONG mask,
+	double position,
+	float& left,
+	float& right
+)
+{
+	//
+	// Catmull-Rom spline through the two frames on either side
+	//
+	const auto index = ULONGLONG(std::floor(position));
+	const auto t = float(position - std::floor(position));
+
+	const auto y0 = ring + ((index - 1) & mask) * 2;
+	const auto y1 = ring + (index & mask) * 2;
+	const auto y2 = ring + ((index + 1) & mask) * 2;
+	const auto y3 = ring + ((index + 2) & mask) * 2;
+
+	float result[2];
+
+	for (int c = 0; c < 2; c++)
+	{
+		result[c] = y1[c] + 0.5f * t * (y2[c] - y0[c] + t * (2.0f * y0[c] - 5.0f * y1[c] + 4.0f * y2[c] - y3[c]
+			+ t * (3.0f * (y1[c] - y2[c]) + y3[c] - y0[c])));
+	}
+
+	left = result[0];
+	right = result[1];
+}
+
+Indicium::Core::Audio::AudioMixer::ClientSlot* Indicium::Core::Audio::AudioMixer::slot_for(IAudioRenderClient* render)
+{
+	//
+	// Slots get freed and reused, so all of them are looked at
+	//
+	for (auto& slot : slots_)
+	{
+		if (slot.render.load(std::memory_order_acquire) == render)
+			return &slot;
+	}
+
+	return nullptr;
+}
+
+Indicium::Core::Audio::AudioMixer::ClientSlot* Indicium::Core::Audio::AudioMixer::pin(IAudioRenderClient* render)
+{
+	const auto slot = slot_for(render);
+
+	if (!slot)
+		return nullptr;
+
+	slot->users.fetch_add(1);
+
+	//
+	// Reclaiming clears render before it waits for users, so either it sees this one or this
+	// one sees the slot gone
+	//
+	if (slot->render.load() != render)
+	{
+		unpin(slot);
+		return nullptr;
+	}
+
+	return slot;
+}
+
+void Indicium::Core::Audio::AudioMixer::unpin(ClientSlot* slot)
+{
+	slot->users.fetch_sub(1, std::memory_order_release);
+}
+
+void Indicium::Core::Audio::AudioMixer::reclaim(ClientSlot& slot)
+{
+	slot.render.store(nullptr);
+	slot.buffer.store(nullptr, std::memory_order_release);
+
+	//
+	// Only hooks of a render client at the same address, created right after the old one went
+	// away, can still be in here; they leave within a buffer copy
+	//
+	while (slot.users.load(std::memory_order_acquire))
+		std::this_thread::yield();
+
+	slot.ring.reset();
+	slot.client = nullptr;
+	slot.pending = nullptr;
+}
+
+void Indicium::Core::Audio::AudioMixer::reset(ClientSlot& slot)
+{
+	slot.clock = StreamClock(double(slot.format.rate), ClockForgetting);
+	slot.drift = DriftCompensator(DriftConfig);
+	slot.position = 0.0;
+	slot.playing = false;
+
+	Anchor anchor;
+	while (slot.anchors && slot.anchors->try_pop(anchor))
+		;
+}
+
+bool Indicium::Core::Audio::AudioMixer::allocate(ClientSlot& slot)
+{
+	if (slot.ring)
+		return true;
+
+	//
+	// At least two seconds, the older half is what the mixer may read
+	//
+	ULONGLONG frames = 1;
+	while (frames < ULONGLONG(slot.format.rate) * 2)
+		frames <<= 1;
+
+	Memory::Scope scope(IndiciumMemoryTagAudio);
+
+	slot.ring.reset(new (std::nothrow) float[size_t(frames) * 2]());
+
+	if (!slot.ring)
+		return false;
+
+	slot.ring_mask = frames - 1;
+	slot.buffer.store(slot.ring.get(), std::memory_order_release);
+
+	return true;
+}
+
+void Indicium::Core::Audio::AudioMixer::on_initialize(IAudioClient* client, const WAVEFORMATEX* format, HRESULT result)
+{
+	if (FAILED(result))
+		return;
+
+	const auto parsed = parse_format(format);
+
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	formats_[client] = parsed;
+}
+
+void Indicium::Core::Audio::AudioMixer::on_get_service(IAudioClient* client, REFIID riid, void** service, HRESULT result)
+{
+	if (FAILED(result) || !service || !*service || riid != __uuidof(IAudioRenderClient))
+		return;
+
+	const auto render = static_cast<IAudioRenderClient*>(*service);
+
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	const auto format = formats_.find(client);
+
+	//
+	// Clients initialized before the hooks were applied are unknown and can't be mixed
+	//
+	if (format == formats_.end() || format->second.type == SampleType::Unsupported)
+		return;
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	//
+	// The slot of an earlier render client at the same address, else a free one; slots only
+	// become free when their render client is released, paused streams keep theirs
+	//
+	auto target = slot_for(render);
+
+	if (target && target->client == client)
+		return;
+
+	//
+	// Same address but another audio client: the render client it belonged to is gone
+	//
+	if (target)
+		reclaim(*target);
+	else
+		target = slot_for(nullptr);
+
+	if (!target)
+		return;
+
+	target->client = client;
+	target->format = format->second;
+	target->pending = nullptr;
+	target->written.store(0, std::memory_order_relaxed);
+	target->last_release.store(now.QuadPart, std::memory_order_relaxed);
+
+	if (!target->anchors)
+	{
+		Memory::Scope scope(IndiciumMemoryTagAudio);
+
+		target->anchors.reset(new (std::nothrow) Util::SpscRing<Anchor>(AnchorsPerClient));
+	}
+
+	if (!target->anchors)
+		return;
+
+	reset(*target);
+
+	if (active_.load(std::memory_order_relaxed) && !allocate(*target))
+		return;
+
+	target->render.store(render, std::memory_order_release);
+}
+
+void Indicium::Core::Audio::AudioMixer::on_get_buffer(IAudioRenderClient* render, BYTE** data, HRESULT result)
+{
+	if (!active_.load(std::memory_order_relaxed) || FAILED(result) || !data)
+		return;
+
+	const auto slot = pin(render);
+
+	if (!slot)
+		return;
+
+	slot->pending = *data;
+
+	unpin(slot);
+}
+
+void Indicium::Core::Audio::AudioMixer::on_release_buffer(IAudioRenderClient* render, UINT32 frames, DWORD flags)
+{
+	if (!active_.load(std::memory_order_relaxed) || !frames)
+		return;
+
+	const auto slot = pin(render);
+
+	if (!slot)
+		return;
+
+	const auto ring = slot->buffer.load(std::memory_order_acquire);
+
+	//
+	// The mixer reads up to half the ring behind the newest frame, larger buffers would overlap it
+	//
+	if (!ring || frames > (slot->ring_mask + 1) / 2)
+	{
+		unpin(slot);
+		return;
+	}
+
+	const auto first = slot->written.load(std::memory_order_relaxed);
+	const auto silent = (flags & AUDCLNT_BUFFERFLAGS_SILENT) || !slot->pending;
+
+	for (UINT32 done = 0; done < frames;)
+	{
+		const auto index = (first + done) & slot->ring_mask;
+		const auto count = UINT32((std::min)(ULONGLONG(frames - done), slot->ring_mask + 1 - index));
+
+		if (silent)
+			memset(ring + index * 2, 0, count * 2 * sizeof(float));
+		else
+			to_stereo(slot->format, slot->pending + done * slot->format.block_align, count, ring + index * 2);
+
+		done += count;
+	}
+
+	unpin(slot);
+}
+
+void Indicium::Core::Audio::AudioMixer::on_buffer_released(IAudioRenderClient* render, UINT32 frames, HRESULT result)
+{
+	if (!active_.load(std::memory_order_relaxed))
+		return;
+
+	const auto slot = pin(render);
+
+	if (!slot)
+		return;
+
+	slot->pending = nullptr;
+
+	if (slot->buffer.load(std::memory_order_relaxed) && SUCCEEDED(result))
+	{
+		const auto written = slot->written.load(std::memory_order_relaxed) + frames;
+		slot->written.store(written, std::memory_order_release);
+
+		//
+		// Everything queued ahead of the newest frame is the padding, so the device is playing
+		// the frame right after it; the render client keeps its audio client alive
+		//
+		UINT32 padding;
+
+		if (SUCCEEDED(slot->client->GetCurrentPadding(&padding)) && padding <= written)
+		{
+			LARGE_INTEGER now;
+			QueryPerformanceCounter(&now);
+
+			Anchor anchor;
+			anchor.frame = written - padding;
+			anchor.timestamp = now.QuadPart;
+
+			slot->anchors->try_push(anchor);
+			slot->last_release.store(now.QuadPart, std::memory_order_relaxed);
+		}
+	}
+
+	unpin(slot);
+}
+
+void Indicium::Core::Audio::AudioMixer::on_released(IUnknown* object)
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	//
+	// Either kind of object ends up here; the pointer only serves as a key
+	//
+	const auto slot = slot_for(reinterpret_cast<IAudioRenderClient*>(object));
+
+	if (slot)
+		reclaim(*slot);
+
+	formats_.erase(reinterpret_cast<IAudioClient*>(object));
+}
+
+INDICIUM_ERROR Indicium::Core::Audio::AudioMixer::start(const INDICIUM_AUDIO_MIX_CONFIG& config)
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	active_.store(false, std::memory_order_relaxed);
+
+	//
+	// Room for one second at once, longer stalls of the engine thread get skipped
+	//
+	try
+	{
+		mix_.assign(size_t(config.SampleRate) * 2, 0.0f);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	for (auto& slot : slots_)
+	{
+		if (!slot.render.load(std::memory_order_relaxed))
+			continue;
+
+		if (!allocate(slot))
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+
+		reset(slot);
+	}
+
+	config_ = config;
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	origin_ = now.QuadPart;
+	mixed_ = 0;
+	active_clients_ = 0;
+	maximum_drift_ppm_ = 0.0;
+
+	started_frames_ = frames_.load();
+	started_underruns_ = underruns_.load();
+	started_resyncs_ = resyncs_.load();
+
+	active_.store(true, std::memory_order_release);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Audio::AudioMixer::stop()
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	active_.store(false, std::memory_order_relaxed);
+}
+
+void Indicium::Core::Audio::AudioMixer::attach(MixSink* sink)
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	sink_ = sink;
+}
+
+UINT32 Indicium::Core::Audio::AudioMixer::sample_rate()
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	return active_.load(std::memory_order_relaxed) ? config_.SampleRate : 0;
+}
+
+DWORD Indicium::Core::Audio::AudioMixer::tick_interval() const
+{
+	if (!active_.load(std::memory_order_relaxed))
+		return INFINITE;
+
+	return config_.PeriodMs;
+}
+
+void Indicium::Core::Audio::AudioMixer::mix_client(ClientSlot& slot, double start, UINT32 frames, LONGLONG now)
+{
+	Anchor anchor;
+
+	while (slot.anchors->try_pop(anchor))
+	{
+		const auto frame = double(anchor.frame);
+		const auto time = double(anchor.timestamp - origin_) / frequency_;
+
+		if (!slot.clock.empty() && std::fabs(slot.clock.time_of(frame) - time) > ClockResetSeconds)
+		{
+			slot.clock.reset();
+
+			if (slot.playing)
+				resyncs_.add();
+
+			slot.playing = false;
+		}
+
+		slot.clock.add(frame, time);
+	}
+
+	if (slot.clock.empty() || now - slot.last_release.load(std::memory_order_relaxed) > LONGLONG(InactiveSeconds * frequency_))
+	{
+		slot.playing = false;
+		return;
+	}
+
+	const auto rate = slot.clock.rate();
+	const auto target = slot.clock.frame_at(start);
+
+	if (!slot.playing)
+	{
+		slot.position = target;
+		slot.drift.reset();
+		slot.playing = true;
+	}
+	else if (!slot.drift.update((target - slot.position) / rate, double(frames) / config_.SampleRate))
+	{
+		slot.position = target;
+		resyncs_.add();
+	}
+
+	const auto step = rate / config_.SampleRate * (1.0 + slot.drift.correction());
+	const auto ring = slot.ring.get();
+
+	//
+	// Readable are the frames published and not yet about to be overwritten
+	//
+	const auto written = double(slot.written.load(std::memory_order_acquire));
+	const auto oldest = (std::max)(written - double((slot.ring_mask + 1) / 2), 0.0);
+
+	auto out = mix_.data();
+	ULONGLONG missing = 0;
+
+	for (UINT32 frame = 0; frame < frames; frame++, out += 2)
+	{
+		const auto position = slot.position + frame * step;
+
+		if (position - 1.0 < oldest || position + 2.0 >= written)
+		{
+			//
+			// Before the first frame the client simply wasn't playing yet
+			//
+			if (position >= 0.0)
+				missing++;
+
+			continue;
+		}
+
+		float left, right;
+		interpolate(ring, slot.ring_mask, position, left, right);
+
+		out[0] += left;
+		out[1] += right;
+	}
+
+	slot.position += frames * step;
+
+	if (missing)
+		underruns_.add(missing);
+
+	const auto drift = (rate / slot.format.rate - 1.0) * 1e6;
+
+	if (std::fabs(drift) > std::fabs(maximum_drift_ppm_))
+		maximum_drift_ppm_ = drift;
+
+	active_clients_++;
+}
+
+void Indicium::Core::Audio::AudioMixer::tick(PINDICIUM_ENGINE engine)
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	if (!active_.load(std::memory_order_relaxed))
+		return;
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	const auto rate = config_.SampleRate;
+	const auto elapsed = double(now.QuadPart - origin_) / frequency_ - config_.LatencyMs / 1000.0;
+
+	if (elapsed <= 0.0)
+		return;
+
+	const auto due = ULONGLONG(elapsed * rate);
+
+	if (due <= mixed_)
+		return;
+
+	const auto capacity = mix_.size() / 2;
+
+	if (due - mixed_ > capacity)
+		mixed_ = due - capacity;
+
+	const auto frames = UINT32(due - mixed_);
+	const auto start = double(mixed_) / rate;
+
+	std::fill(mix_.begin(), mix_.begin() + frames * 2, 0.0f);
+
+	active_clients_ = 0;
+	maximum_drift_ppm_ = 0.0;
+
+	for (auto& slot : slots_)
+	{
+		if (slot.render.load(std::memory_order_acquire) && slot.ring)
+			mix_client(slot, start, frames, now.QuadPart);
+	}
+
+	for (size_t i = 0; i < size_t(frames) * 2; i++)
+		mix_[i] = (std::min)((std::max)(mix_[i], -1.0f), 1.0f);
+
+	frames_.add(frames);
+
+	INDICIUM_AUDIO_MIX_BLOCK block;
+	block.Engine = engine;
+	block.Samples = mix_.data();
+	block.Frames = frames;
+	block.SampleRate = rate;
+	block.FirstFrame = mixed_;
+	block.Timestamp = origin_ + LONGLONG(start * frequency_);
+	block.ActiveClients = active_clients_;
+
+	//
+	// Advanced first, the callback may stop or restart the mixdown
+	//
+	mixed_ += frames;
+
+	if (sink_)
+		sink_->on_mix(block);
+
+	if (config_.EvtIndiciumAudioMix)
+		config_.EvtIndiciumAudioMix(&block, config_.Context);
+}
+
+void Indicium::Core::Audio::AudioMixer::statistics(PINDICIUM_AUDIO_MIX_STATISTICS statistics)
+{
+	std::lock_guard<std::recursive_mutex> guard(lock_);
+
+	ZeroMemory(statistics, sizeof(INDICIUM_AUDIO_MIX_STATISTICS));
+
+	for (auto& slot : slots_)
+	{
+		if (slot.render.load(std::memory_order_relaxed))
+			statistics->Clients++;
+	}
+
+	statistics->ActiveClients = active_clients_;
+	statistics->FramesMixed = frames_.load() - started_frames_;
+	statistics->UnderrunFrames = underruns_.load() - started_underruns_;
+	statistics->Resyncs = resyncs_.load() - started_resyncs_;
+	statistics->MaximumDriftPpm = maximum_drift_ppm_;
+}
@@ -0,0 +1,245 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+#include <mmdeviceapi.h>
+#include <Audioclient.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumAudioMix.h"
+
+#include "Utils/SpscRing.h"
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+#include "MixTimeline.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Audio
+        {
+            /**
+             * \brief   Engine-internal receiver of mixed blocks, called on the engine thread ahead of
+             *          the mixdown callback.
+             */
+            class MixSink
+            {
+            public:
+                virtual ~MixSink() = default;
+
+                virtual void on_mix(const INDICIUM_AUDIO_MIX_BLOCK& block) = 0;
+            };
+
+            /**
+             * \brief   Mixes all Audio Render Clients of the host into one stereo stream.
+             *
+             *          The audio threads convert every released buffer to stereo float into a ring
+             *          of their client and note which frame the device is playing right then. The
+             *          engine thread fits a clock per client from these notes and resamples each
+             *          ring onto a common performance counter timeline, slightly faster or slower
+             *          to follow the client's device. Audio threads never wait on the mixer.
+             */
+            class AudioMixer
+            {
+            public:
+                static const size_t MaxClients = INDICIUM_AUDIO_MIX_MAX_CLIENTS;
+
+                //
+                // Speaker positions of a channel mask (SPEAKER_FRONT_LEFT to SPEAKER_TOP_BACK_RIGHT)
+                //
+                static const UINT32 MaxChannels = 18;
+
+                enum class SampleType
+                {
+                    Unsupported,
+                    UInt8,
+                    Int16,
+                    Int24,
+                    Int32,
+                    Float32
+                };
+
+                struct Format
+                {
+                    SampleType type;
+                    UINT32 channels;
+                    UINT32 rate;
+                    UINT32 block_align;
+
+                    //
+                    // Left and right gain of every channel
+                    //
+                    float gains[MaxChannels][2];
+                };
+
+                static Format parse_format(const WAVEFORMATEX* format);
+
+                /**
+                 * \brief   Converts frames of the given format to interleaved stereo float.
+                 */
+                static void to_stereo(const Format& format, const BYTE* data, UINT32 frames, float* out);
+
+                /**
+                 * \brief   Reads a stereo frame at a fractional position with cubic interpolation.
+                 */
+                static void interpolate(const float* ring, ULONGLONG mask, double position, float& left, float& right);
+
+            private:
+                //
+                // Frame playing at a performance counter value, taken after ReleaseBuffer
+                //
+                struct Anchor
+                {
+                    ULONGLONG frame;
+                    LONGLONG timestamp;
+                };
+
+                struct alignas(64) ClientSlot
+                {
+                    std::atomic<IAudioRenderClient*> render{ nullptr };
+                    IAudioClient* client = nullptr;
+                    Format format{};
+
+                    //
+                    // Stereo ring of the converted frames, indexed by frame & ring_mask; allocated
+                    // while mixing and published to the audio thread through buffer
+                    //
+                    std::unique_ptr<float[]> ring;
+                    std::atomic<float*> buffer{ nullptr };
+                    ULONGLONG ring_mask = 0;
+
+                    //
+                    // Audio thread side
+                    //
+                    const BYTE* pending = nullptr;
+                    std::atomic<ULONGLONG> written{ 0 };
+
+                    //
+                    // Audio threads inside a hook working on the slot; it only gets reclaimed once
+                    // they all left
+                    //
+                    std::atomic<UINT32> users{ 0 };
+                    std::atomic<LONGLONG> last_release{ 0 };
+                    std::unique_ptr<Util::SpscRing<Anchor>> anchors;
+
+                    //
+                    // Engine thread side
+                    //
+                    StreamClock clock{ 48000.0, 0.999 };
+                    DriftCompensator drift{ DriftCompensator::Config() };
+                    double position = 0.0;
+                    bool playing = false;
+                };
+
+                ClientSlot slots_[MaxClients];
+
+                //
+                // Guards association of clients, configuration and mixing
+                //
+                std::recursive_mutex lock_;
+                std::unordered_map<IAudioClient*, Format> formats_;
+
+                std::atomic<bool> active_;
+                INDICIUM_AUDIO_MIX_CONFIG config_;
+                MixSink* sink_;
+                double frequency_;
+                LONGLONG origin_;
+                ULONGLONG mixed_;
+                std::vector<float> mix_;
+
+                UINT32 active_clients_;
+                double maximum_drift_ppm_;
+
+                Util::ShardedCounter frames_;
+                Util::ShardedCounter underruns_;
+                Util::ShardedCounter resyncs_;
+                ULONGLONG started_frames_;
+                ULONGLONG started_underruns_;
+                ULONGLONG started_resyncs_;
+
+                ClientSlot* slot_for(IAudioRenderClient* render);
+                ClientSlot* pin(IAudioRenderClient* render);
+                static void unpin(ClientSlot* slot);
+                void reclaim(ClientSlot& slot);
+                void reset(ClientSlot& slot);
+                bool allocate(ClientSlot& slot);
+                void mix_client(ClientSlot& slot, double start, UINT32 frames, LONGLONG now);
+
+            public:
+                explicit AudioMixer(Stats::CounterRegistry& counters);
+
+                AudioMixer(const AudioMixer&) = delete;
+                AudioMixer& operator=(const AudioMixer&) = delete;
+
+                //
+                // Hooked IAudioClient and IAudioRenderClient calls, on the host's threads
+                //
+                void on_initialize(IAudioClient* client, const WAVEFORMATEX* format, HRESULT result);
+                void on_get_service(IAudioClient* client, REFIID riid, void** service, HRESULT result);
+                void on_get_buffer(IAudioRenderClient* render, BYTE** data, HRESULT result);
+                void on_release_buffer(IAudioRenderClient* render, UINT32 frames, DWORD flags);
+                void on_buffer_released(IAudioRenderClient* render, UINT32 frames, HRESULT result);
+
+                /**
+                 * \brief   Final Release of an IAudioClient or IAudioRenderClient, called while the
+                 *          object is still alive; frees whatever the mixer kept for it.
+                 */
+                void on_released(IUnknown* object);
+
+                INDICIUM_ERROR start(const INDICIUM_AUDIO_MIX_CONFIG& config);
+                void stop();
+
+                /**
+                 * \brief   Sets the sink receiving blocks besides the callback, NULL to remove it. No
+                 *          block reaches a removed sink once this returns.
+                 */
+                void attach(MixSink* sink);
+
+                /**
+                 * \brief   Rate of the running mixdown, zero if stopped.
+                 */
+                UINT32 sample_rate();
+
+                /**
+                 * \brief   Mixes and delivers everything due; called on the engine thread.
+                 */
+                void tick(PINDICIUM_ENGINE engine);
+
+                DWORD tick_interval() const;
+
+                void statistics(PINDICIUM_AUDIO_MIX_STATISTICS statistics);
+            };
+        };
+    };
+};
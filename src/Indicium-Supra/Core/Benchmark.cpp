@@ -0,0 +1,625 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Benchmark.h"
+#include "Statistics.h"
+#include "Memory.h"
+#include "Global.h"
+
+#include <Audioclient.h>
+
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+#include <cstdio>
+#include <ctime>
+
+#pragma comment(lib, "version.lib")
+
+namespace
+{
+	//
+	// Callback timing of the Present hook currently executing on this thread
+	//
+	thread_local bool t_measured = false;
+	thread_local LONGLONG t_phase_start = 0;
+	thread_local LONGLONG t_callback_ticks = 0;
+}
+
+static LONGLONG now()
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	return counter.QuadPart;
+}
+
+static ULONGLONG fnv1a_file(const char* path)
+{
+	ULONGLONG hash = 14695981039346656037ULL;
+
+	const auto file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+		OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+
+	if (file == INVALID_HANDLE_VALUE)
+		return 0;
+
+	std::vector<BYTE> buffer(1 << 20);
+	DWORD read;
+
+	while (ReadFile(file, buffer.data(), static_cast<DWORD>(buffer.size()), &read, nullptr) && read)
+	{
+		for (DWORD i = 0; i < read; i++)
+		{
+			hash ^= buffer[i];
+			hash *= 1099511628211ULL;
+		}
+	}
+
+	CloseHandle(file);
+
+	return hash;
+}
+
+//
+// Module holding the engine code: the engine DLL, or the module linking the static library
+//
+static HMODULE engine_module()
+{
+	HMODULE module = nullptr;
+
+	GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		reinterpret_cast<LPCSTR>(&engine_module), &module);
+
+	return module;
+}
+
+static std::string module_version(HMODULE module)
+{
+	CHAR path[MAX_PATH];
+
+	if (!GetModuleFileNameA(module, path, MAX_PATH))
+		return "unknown";
+
+	DWORD handle;
+	const auto size = GetFileVersionInfoSizeA(path, &handle);
+
+	if (!size)
+		return "unknown";
+
+	std::vector<BYTE> data(size);
+	VS_FIXEDFILEINFO* info;
+	UINT length;
+
+	if (!GetFileVersionInfoA(path, 0, size, data.data())
+		|| !VerQueryValueA(data.data(), "\\", reinterpret_cast<LPVOID*>(&info), &length))
+		return "unknown";
+
+	CHAR version[64];
+	sprintf_s(version, "%u.%u.%u.%u",
+		HIWORD(info->dwFileVersionMS), LOWORD(info->dwFileVersionMS),
+		HIWORD(info->dwFileVersionLS), LOWORD(info->dwFileVersionLS));
+
+	return version;
+}
+
+static void create_directories(const std::string& path)
+{
+	for (auto pos = path.find('\\', 3); ; pos = path.find('\\', pos + 1))
+	{
+		CreateDirectoryA(path.substr(0, pos).c_str(), nullptr);
+
+		if (pos == std::string::npos)
+			break;
+	}
+}
+
+static double read_value(const std::string& file, const char* section, const char* key)
+{
+	CHAR value[64];
+	GetPrivateProfileStringA(section, key, "0", value, sizeof(value), file.c_str());
+	return strtod(value, nullptr);
+}
+
+static void fill_metric(const std::vector<double>& samples, INDICIUM_BENCHMARK_METRIC& metric)
+{
+	const auto d = Indicium::Core::Stats::describe(samples);
+
+	metric.Samples = static_cast<ULONGLONG>(d.moments.count);
+	metric.Mean = d.moments.mean;
+	metric.StandardDeviation = sqrt(d.moments.variance);
+	metric.Minimum = d.minimum;
+	metric.Median = d.median;
+	metric.Percentile95 = d.percentile95;
+	metric.Percentile99 = d.percentile99;
+	metric.Maximum = d.maximum;
+}
+
+static void compare(
+	const std::string& baseline,
+	const char* section,
+	const INDICIUM_BENCHMARK_METRIC& metric,
+	const INDICIUM_BENCHMARK_CONFIG& config,
+	INDICIUM_BENCHMARK_COMPARISON& result
+)
+{
+	const auto samples = read_value(baseline, section, "Samples");
+
+	if (samples < 2.0)
+		return;
+
+	const auto deviation = read_value(baseline, section, "StandardDeviation");
+
+	const Indicium::Core::Stats::Moments base = {
+		samples, read_value(baseline, section, "Mean"), deviation * deviation
+	};
+	const Indicium::Core::Stats::Moments current = {
+		static_cast<double>(metric.Samples), metric.Mean, metric.StandardDeviation * metric.StandardDeviation
+	};
+
+	result.IsAvailable = TRUE;
+	result.BaselineMean = base.mean;
+	result.BaselineSamples = static_cast<ULONGLONG>(samples);
+	result.RelativeChange = base.mean > 0.0 ? (current.mean - base.mean) / base.mean : 0.0;
+	result.PValue = Indicium::Core::Stats::welch(current, base).p_greater;
+	result.IsRegression = result.PValue < config.Significance
+		&& result.RelativeChange >= config.MinimumRelativeChange;
+}
+
+static void write_metric(FILE* file, const char* section, const INDICIUM_BENCHMARK_METRIC& metric)
+{
+	fprintf(file, "[%s]\n", section);
+	fprintf(file, "Samples=%llu\n", metric.Samples);
+	fprintf(file, "Mean=%.9g\n", metric.Mean);
+	fprintf(file, "StandardDeviation=%.9g\n", metric.StandardDeviation);
+	fprintf(file, "Minimum=%.9g\n", metric.Minimum);
+	fprintf(file, "Median=%.9g\n", metric.Median);
+	fprintf(file, "Percentile95=%.9g\n", metric.Percentile95);
+	fprintf(file, "Percentile99=%.9g\n", metric.Percentile99);
+	fprintf(file, "Maximum=%.9g\n\n", metric.Maximum);
+}
+
+static void write_comparison(FILE* file, const char* section, const INDICIUM_BENCHMARK_COMPARISON& comparison)
+{
+	if (!comparison.IsAvailable)
+		return;
+
+	fprintf(file, "[%s]\n", section);
+	fprintf(file, "BaselineMean=%.9g\n", comparison.BaselineMean);
+	fprintf(file, "BaselineSamples=%llu\n", comparison.BaselineSamples);
+	fprintf(file, "RelativeChange=%.9g\n", comparison.RelativeChange);
+	fprintf(file, "PValue=%.9g\n", comparison.PValue);
+	fprintf(file, "Regression=%d\n\n", comparison.IsRegression ? 1 : 0);
+}
+
+Indicium::Core::Bench::Benchmark::Benchmark(const INDICIUM_BENCHMARK_CONFIG& config, Stats::CounterRegistry& counters) :
+	running_(false),
+	measuring_(false),
+	warmup_remaining_(0),
+	previous_frame_(0),
+	first_measured_(0),
+	last_measured_(0),
+	frame_ring_(SampleRingCapacity),
+	cost_ring_(SampleRingCapacity),
+	hotkey_(0),
+	hotkey_down_(false)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ticks_per_ms_ = frequency.QuadPart / 1000.0;
+
+	configure(config);
+
+	counters.attach("benchmark.audio.buffers", audio_buffers_);
+	counters.attach("benchmark.audio.frames", audio_frames_);
+	counters.attach("benchmark.audio.silent", audio_silent_);
+	counters.attach("benchmark.audio.failures", audio_failures_);
+}
+
+void Indicium::Core::Bench::Benchmark::configure(const INDICIUM_BENCHMARK_CONFIG& config)
+{
+	std::lock_guard<std::mutex> guard(control_);
+
+	config_ = config;
+
+	directory_ = Util::expand_environment_variables(
+		config.Directory ? config.Directory : "%LOCALAPPDATA%\\Indicium-Supra\\Benchmarks");
+	directory_.resize(strlen(directory_.c_str()));
+
+	//
+	// Caller owns the string, we keep the expanded copy
+	//
+	config_.Directory = nullptr;
+
+	hotkey_.store(config.HotkeyVirtualKey, std::memory_order_relaxed);
+}
+
+INDICIUM_ERROR Indicium::Core::Bench::Benchmark::start()
+{
+	std::lock_guard<std::mutex> guard(control_);
+
+	if (running_.load(std::memory_order_relaxed))
+		return INDICIUM_ERROR_BENCHMARK_RUNNING;
+
+	acquire_producer();
+
+	warmup_remaining_ = config_.WarmupFrames;
+	previous_frame_ = 0;
+	first_measured_ = 0;
+	last_measured_ = 0;
+
+	producing_.clear(std::memory_order_release);
+
+	{
+		Memory::Scope scope(IndiciumMemoryTagStatistics);
+		std::lock_guard<std::mutex> drain(drain_);
+
+		frame_times_.clear();
+		callback_costs_.clear();
+
+		//
+		// Roughly ten minutes at 60 FPS before the engine thread has to grow the buffers
+		//
+		frame_times_.reserve(1 << 15);
+		callback_costs_.reserve(1 << 15);
+	}
+
+	lost_samples_.reset();
+	audio_buffers_.reset();
+	audio_frames_.reset();
+	audio_silent_.reset();
+	audio_failures_.reset();
+
+	running_.store(true, std::memory_order_release);
+
+	spdlog::get("indicium")->clone("benchmark")->info("Benchmark run started, discarding {} warm-up frames",
+		config_.WarmupFrames);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_ERROR Indicium::Core::Bench::Benchmark::stop(PINDICIUM_ENGINE engine, PINDICIUM_BENCHMARK_REPORT report)
+{
+	INDICIUM_BENCHMARK_REPORT local;
+	const auto result = report ? report : &local;
+	PFN_INDICIUM_BENCHMARK_COMPLETED completed;
+
+	{
+		std::lock_guard<std::mutex> guard(control_);
+
+		if (!running_.load(std::memory_order_relaxed))
+			return INDICIUM_ERROR_BENCHMARK_NOT_RUNNING;
+
+		std::vector<double> frames;
+		std::vector<double> costs;
+
+		ZeroMemory(result, sizeof(INDICIUM_BENCHMARK_REPORT));
+
+		running_.store(false, std::memory_order_relaxed);
+		measuring_.store(false, std::memory_order_relaxed);
+
+		//
+		// Once held, no render thread is recording anymore
+		//
+		acquire_producer();
+
+		result->WarmupFrames = config_.WarmupFrames - warmup_remaining_;
+		result->DurationSeconds = (last_measured_ - first_measured_) / ticks_per_ms_ / 1000.0;
+
+		producing_.clear(std::memory_order_release);
+
+		{
+			std::lock_guard<std::mutex> drain(drain_);
+
+			drain_locked();
+
+			frames.swap(frame_times_);
+			costs.swap(callback_costs_);
+		}
+
+		if (const auto lost = lost_samples_.load()) {
+			spdlog::get("indicium")->clone("benchmark")->warn("{} samples didn't fit into the sample rings and are missing", lost);
+		}
+
+		fill_metric(frames, result->FrameTime);
+		fill_metric(costs, result->CallbackCost);
+
+		result->Audio.BuffersReleased = audio_buffers_.load();
+		result->Audio.FramesWritten = audio_frames_.load();
+		result->Audio.SilentBuffers = audio_silent_.load();
+		result->Audio.Failures = audio_failures_.load();
+
+		write_report(result);
+
+		completed = config_.EvtIndiciumBenchmarkCompleted;
+	}
+
+	//
+	// Outside the lock so the callback may start the next run
+	//
+	if (completed) {
+		completed(engine, result);
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Bench::Benchmark::acquire_producer()
+{
+	//
+	// Render threads hold it for a few instructions only
+	//
+	while (producing_.test_and_set(std::memory_order_acquire))
+		YieldProcessor();
+}
+
+void Indicium::Core::Bench::Benchmark::drain_locked()
+{
+	Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+	double samples[256];
+	size_t count;
+
+	while ((count = frame_ring_.pop_bulk(samples, ARRAYSIZE(samples))) != 0)
+		frame_times_.insert(frame_times_.end(), samples, samples + count);
+
+	while ((count = cost_ring_.pop_bulk(samples, ARRAYSIZE(samples))) != 0)
+		callback_costs_.insert(callback_costs_.end(), samples, samples + count);
+}
+
+void Indicium::Core::Bench::Benchmark::write_report(PINDICIUM_BENCHMARK_REPORT report)
+{
+	auto logger = spdlog::get("indicium")->clone("benchmark");
+
+	CHAR executable[MAX_PATH];
+	const auto length = GetModuleFileNameA(nullptr, executable, MAX_PATH);
+	std::string name(executable, length);
+	name = name.substr(name.find_last_of('\\') + 1);
+
+	CHAR hash[17];
+	sprintf_s(hash, "%016llx", fnv1a_file(executable));
+
+	//
+	// Baselines belong to an engine build, runs of other builds don't get compared against them
+	//
+	const auto version = module_version(engine_module());
+	const auto key = directory_ + "\\" + name + "-" + hash;
+	const auto baseline = key + "-" + version + ".baseline.ini";
+
+	create_directories(directory_);
+
+	const auto has_baseline = GetFileAttributesA(baseline.c_str()) != INVALID_FILE_ATTRIBUTES;
+
+	if (has_baseline)
+	{
+		compare(baseline, "FrameTime", report->FrameTime, config_, report->FrameTimeComparison);
+		compare(baseline, "CallbackCost", report->CallbackCost, config_, report->CallbackCostComparison);
+	}
+
+	report->IsRegression = report->FrameTimeComparison.IsRegression
+		|| report->CallbackCostComparison.IsRegression;
+
+	const auto timestamp = time(nullptr);
+	tm local;
+	localtime_s(&local, &timestamp);
+
+	CHAR stamp[32];
+	strftime(stamp, sizeof(stamp), "%Y%m%d-%H%M%S", &local);
+
+	const auto path = key + "-" + stamp + ".ini";
+	FILE* file;
+
+	if (fopen_s(&file, path.c_str(), "w") || !file)
+	{
+		logger->error("Couldn't write benchmark report {}", path);
+	}
+	else
+	{
+		fprintf(file, "[Run]\n");
+		fprintf(file, "Executable=%s\n", executable);
+		fprintf(file, "ExecutableHash=%s\n", hash);
+		fprintf(file, "EngineVersion=%s\n", version.c_str());
+		fprintf(file, "DurationSeconds=%.3f\n", report->DurationSeconds);
+		fprintf(file, "WarmupFrames=%llu\n", report->WarmupFrames);
+		fprintf(file, "Regression=%d\n\n", report->IsRegression ? 1 : 0);
+
+		write_metric(file, "FrameTime", report->FrameTime);
+		write_metric(file, "CallbackCost", report->CallbackCost);
+
+		fprintf(file, "[Audio]\n");
+		fprintf(file, "BuffersReleased=%llu\n", report->Audio.BuffersReleased);
+		fprintf(file, "FramesWritten=%llu\n", report->Audio.FramesWritten);
+		fprintf(file, "SilentBuffers=%llu\n", report->Audio.SilentBuffers);
+		fprintf(file, "Failures=%llu\n\n", report->Audio.Failures);
+
+		write_comparison(file, "FrameTimeComparison", report->FrameTimeComparison);
+		write_comparison(file, "CallbackCostComparison", report->CallbackCostComparison);
+
+		fclose(file);
+
+		strcpy_s(report->ReportPath, path.c_str());
+
+		//
+		// The report doubles as baseline, comparisons only read the metric sections
+		//
+		if (!has_baseline || config_.ReplaceBaseline) {
+			CopyFileA(path.c_str(), baseline.c_str(), FALSE);
+		}
+	}
+
+	logger->info("Benchmark: {} frames in {:.1f}s, frame time {:.3f} ms (p99 {:.3f} ms), callbacks {:.1f} us per frame",
+		report->FrameTime.Samples, report->DurationSeconds, report->FrameTime.Mean,
+		report->FrameTime.Percentile99, report->CallbackCost.Mean);
+
+	if (report->IsRegression)
+	{
+		logger->warn("Benchmark regression against baseline {}: frame time {:+.1f}% (p={:.4f}), callbacks {:+.1f}% (p={:.4f})",
+			baseline,
+			report->FrameTimeComparison.RelativeChange * 100.0, report->FrameTimeComparison.PValue,
+			report->CallbackCostComparison.RelativeChange * 100.0, report->CallbackCostComparison.PValue);
+	}
+	else if (!has_baseline)
+	{
+		logger->info("Stored new benchmark baseline {}", baseline);
+	}
+}
+
+void Indicium::Core::Bench::Benchmark::on_frame()
+{
+	t_measured = false;
+
+	if (!running_.load(std::memory_order_acquire))
+		return;
+
+	const auto timestamp = now();
+
+	//
+	// Taken by another thread presenting at the same time or by start/stop; skip the frame
+	//
+	if (producing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	if (running_.load(std::memory_order_relaxed))
+	{
+		if (warmup_remaining_)
+		{
+			warmup_remaining_--;
+		}
+		else
+		{
+			if (first_measured_) {
+				if (!frame_ring_.try_push((timestamp - previous_frame_) / ticks_per_ms_)) {
+					lost_samples_.add();
+				}
+			}
+			else {
+				first_measured_ = timestamp;
+				measuring_.store(true, std::memory_order_relaxed);
+			}
+
+			last_measured_ = timestamp;
+			t_measured = true;
+		}
+
+		previous_frame_ = timestamp;
+	}
+
+	producing_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Bench::Benchmark::callbacks_begin()
+{
+	if (t_measured) {
+		t_callback_ticks = 0;
+		t_phase_start = now();
+	}
+}
+
+void Indicium::Core::Bench::Benchmark::present_begin()
+{
+	if (t_measured) {
+		t_callback_ticks += now() - t_phase_start;
+	}
+}
+
+void Indicium::Core::Bench::Benchmark::present_end()
+{
+	if (t_measured) {
+		t_phase_start = now();
+	}
+}
+
+void Indicium::Core::Bench::Benchmark::callbacks_end()
+{
+	if (!t_measured)
+		return;
+
+	t_measured = false;
+	t_callback_ticks += now() - t_phase_start;
+
+	if (producing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	if (running_.load(std::memory_order_relaxed) && !cost_ring_.try_push(t_callback_ticks * 1000.0 / ticks_per_ms_)) {
+		lost_samples_.add();
+	}
+
+	producing_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Bench::Benchmark::on_audio_buffer(UINT32 frames, DWORD flags, HRESULT result)
+{
+	if (!measuring_.load(std::memory_order_relaxed))
+		return;
+
+	if (FAILED(result)) {
+		audio_failures_.add();
+		return;
+	}
+
+	audio_buffers_.add();
+	audio_frames_.add(frames);
+
+	if (flags & AUDCLNT_BUFFERFLAGS_SILENT) {
+		audio_silent_.add();
+	}
+}
+
+void Indicium::Core::Bench::Benchmark::poll_hotkey(PINDICIUM_ENGINE engine)
+{
+	const auto key = hotkey_.load(std::memory_order_relaxed);
+
+	if (!key)
+		return;
+
+	const auto down = (GetAsyncKeyState(key) & 0x8000) != 0;
+
+	if (down && !hotkey_down_)
+	{
+		if (is_running())
+			(void)stop(engine, nullptr);
+		else
+			(void)start();
+	}
+
+	hotkey_down_ = down;
+}
+
+void Indicium::Core::Bench::Benchmark::aggregate()
+{
+	if (!running_.load(std::memory_order_relaxed))
+		return;
+
+	std::lock_guard<std::mutex> drain(drain_);
+
+	drain_locked();
+}
+
+DWORD Indicium::Core::Bench::Benchmark::tick_interval() const
+{
+	//
+	// Short enough not to miss a regular key press, or to overflow the sample rings
+	//
+	return hotkey_.load(std::memory_order_relaxed) || running_.load(std::memory_order_relaxed) ? 50 : INFINITE;
+}
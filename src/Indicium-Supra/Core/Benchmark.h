@@ -0,0 +1,164 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumBenchmark.h"
+
+#include "Utils/ShardedCounter.h"
+#include "Utils/SpscRing.h"
+#include "Counters.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Bench
+        {
+            /**
+             * \brief   Collects per-frame statistics between start() and stop() and turns them into
+             *          a report compared against a stored baseline.
+             *
+             *          Frame hooks only check an atomic flag while no run is active. During a run
+             *          the render thread writes its samples into preallocated rings, which the
+             *          engine thread moves into the run at every tick; the render thread neither
+             *          waits nor allocates.
+             */
+            class Benchmark
+            {
+                //
+                // Samples the render thread can record between two engine ticks; 50 ms at 40k FPS
+                //
+                static const size_t SampleRingCapacity = 2048;
+
+                std::mutex control_;
+                INDICIUM_BENCHMARK_CONFIG config_;
+                std::string directory_;
+
+                std::atomic<bool> running_;
+
+                //
+                // Set once warm-up is over
+                //
+                std::atomic<bool> measuring_;
+
+                //
+                // Render thread state; owned by the thread holding producing_, a render thread
+                // finding it taken skips its sample
+                //
+                std::atomic_flag producing_ = ATOMIC_FLAG_INIT;
+                UINT32 warmup_remaining_;
+                LONGLONG previous_frame_;
+                LONGLONG first_measured_;
+                LONGLONG last_measured_;
+                Util::SpscRing<double> frame_ring_;
+                Util::SpscRing<double> cost_ring_;
+                Util::ShardedCounter lost_samples_;
+
+                //
+                // Samples of the run, filled from the rings
+                //
+                std::mutex drain_;
+                std::vector<double> frame_times_;
+                std::vector<double> callback_costs_;
+
+                //
+                // Audio thread(s); cover the current or last run
+                //
+                Util::ShardedCounter audio_buffers_;
+                Util::ShardedCounter audio_frames_;
+                Util::ShardedCounter audio_silent_;
+                Util::ShardedCounter audio_failures_;
+
+                //
+                // Engine thread
+                //
+                std::atomic<INT> hotkey_;
+                bool hotkey_down_;
+
+                double ticks_per_ms_;
+
+                void acquire_producer();
+                void drain_locked();
+                void write_report(PINDICIUM_BENCHMARK_REPORT report);
+
+            public:
+                Benchmark(const INDICIUM_BENCHMARK_CONFIG& config, Stats::CounterRegistry& counters);
+
+                Benchmark(const Benchmark&) = delete;
+                Benchmark& operator=(const Benchmark&) = delete;
+
+                void configure(const INDICIUM_BENCHMARK_CONFIG& config);
+
+                INDICIUM_ERROR start();
+
+                INDICIUM_ERROR stop(PINDICIUM_ENGINE engine, PINDICIUM_BENCHMARK_REPORT report);
+
+                bool is_running() const
+                {
+                    return running_.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * \brief   Frame boundary, called before any engine work of the Present hook.
+                 */
+                void on_frame();
+
+                /**
+                 * \brief   Callback phases of a Present hook: Pre-Present callbacks run between
+                 *          callbacks_begin() and present_begin(), Post-Present callbacks between
+                 *          present_end() and callbacks_end().
+                 */
+                void callbacks_begin();
+                void present_begin();
+                void present_end();
+                void callbacks_end();
+
+                void on_audio_buffer(UINT32 frames, DWORD flags, HRESULT result);
+
+                /**
+                 * \brief   Toggles a run on hotkey press; called periodically on the engine thread.
+                 */
+                void poll_hotkey(PINDICIUM_ENGINE engine);
+
+                /**
+                 * \brief   Moves the samples recorded by the render thread into the run; called
+                 *          periodically on the engine thread.
+                 */
+                void aggregate();
+
+                DWORD tick_interval() const;
+            };
+        };
+    };
+};
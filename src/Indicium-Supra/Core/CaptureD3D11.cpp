@@ -0,0 +1,221 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef INDICIUM_NO_D3D11
+
+#include "FrameCapture.h"
+
+#include <d3d11.h>
+
+#include <new>
+
+namespace
+{
+	using namespace Indicium::Core::Capture;
+
+	class D3D11CaptureDevice : public CaptureDevice
+	{
+		struct Slot
+		{
+			ID3D11Texture2D* texture;
+			UINT width;
+			UINT height;
+			DXGI_FORMAT format;
+		};
+
+		ID3D11Device* device_ = nullptr;
+		ID3D11DeviceContext* context_ = nullptr;
+		ID3D11Texture2D* back_buffer_ = nullptr;
+		ID3D11Texture2D* resolved_ = nullptr;
+		ID3D11Texture2D* source_ = nullptr;
+		D3D11_TEXTURE2D_DESC desc_ = {};
+		Slot slots_[FrameCapture::MaxRegions * FrameCapture::MaxDepth] = {};
+
+		static void Release(ID3D11Texture2D*& texture)
+		{
+			if (texture)
+				texture->Release();
+
+			texture = nullptr;
+		}
+
+		//
+		// Multisampled back buffers can't be copied from directly, resolve them once per frame
+		//
+		bool resolve()
+		{
+			D3D11_TEXTURE2D_DESC desc = {};
+
+			if (resolved_)
+				resolved_->GetDesc(&desc);
+
+			if (!resolved_ || desc.Width != desc_.Width || desc.Height != desc_.Height || desc.Format != desc_.Format)
+			{
+				Release(resolved_);
+
+				desc = desc_;
+				desc.MipLevels = 1;
+				desc.ArraySize = 1;
+				desc.SampleDesc.Count = 1;
+				desc.SampleDesc.Quality = 0;
+				desc.Usage = D3D11_USAGE_DEFAULT;
+				desc.BindFlags = 0;
+				desc.CPUAccessFlags = 0;
+				desc.MiscFlags = 0;
+
+				if (FAILED(device_->CreateTexture2D(&desc, nullptr, &resolved_)))
+					return false;
+			}
+
+			context_->ResolveSubresource(resolved_, 0, back_buffer_, 0, desc_.Format);
+			source_ = resolved_;
+
+			return true;
+		}
+
+	public:
+		~D3D11CaptureDevice()
+		{
+			reset();
+
+			if (context_)
+				context_->Release();
+
+			if (device_)
+				device_->Release();
+		}
+
+		bool begin(PVOID presenter, BackBuffer* back_buffer) override
+		{
+			const auto chain = static_cast<IDXGISwapChain*>(presenter);
+
+			if (FAILED(chain->GetBuffer(0, __uuidof(ID3D11Texture2D), reinterpret_cast<void**>(&back_buffer_))))
+				return false;
+
+			if (!device_)
+			{
+				back_buffer_->GetDevice(&device_);
+				device_->GetImmediateContext(&context_);
+			}
+
+			back_buffer_->GetDesc(&desc_);
+			source_ = back_buffer_;
+
+			if (desc_.SampleDesc.Count > 1 && !resolve())
+			{
+				end();
+				return false;
+			}
+
+			back_buffer->width = desc_.Width;
+			back_buffer->height = desc_.Height;
+			back_buffer->format = desc_.Format;
+
+			return true;
+		}
+
+		bool copy(size_t index, const Rect& rect) override
+		{
+			auto& slot = slots_[index];
+
+			if (!slot.texture || slot.width != rect.width || slot.height != rect.height || slot.format != desc_.Format)
+			{
+				Release(slot.texture);
+
+				D3D11_TEXTURE2D_DESC desc = {};
+				desc.Width = rect.width;
+				desc.Height = rect.height;
+				desc.MipLevels = 1;
+				desc.ArraySize = 1;
+				desc.Format = desc_.Format;
+				desc.SampleDesc.Count = 1;
+				desc.Usage = D3D11_USAGE_STAGING;
+				desc.CPUAccessFlags = D3D11_CPU_ACCESS_READ;
+
+				if (FAILED(device_->CreateTexture2D(&desc, nullptr, &slot.texture)))
+					return false;
+
+				slot.width = rect.width;
+				slot.height = rect.height;
+				slot.format = desc_.Format;
+			}
+
+			D3D11_BOX box;
+			box.left = rect.left;
+			box.top = rect.top;
+			box.front = 0;
+			box.right = rect.left + rect.width;
+			box.bottom = rect.top + rect.height;
+			box.back = 1;
+
+			context_->CopySubresourceRegion(slot.texture, 0, 0, 0, 0, source_, 0, &box);
+
+			return true;
+		}
+
+		void end() override
+		{
+			Release(back_buffer_);
+			source_ = nullptr;
+		}
+
+		ReadState map(size_t index, const BYTE** data, UINT32* pitch) override
+		{
+			D3D11_MAPPED_SUBRESOURCE mapped;
+
+			const auto hr = context_->Map(slots_[index].texture, 0, D3D11_MAP_READ, D3D11_MAP_FLAG_DO_NOT_WAIT, &mapped);
+
+			if (hr == DXGI_ERROR_WAS_STILL_DRAWING)
+				return ReadState::pending;
+
+			if (FAILED(hr))
+				return ReadState::failed;
+
+			*data = static_cast<const BYTE*>(mapped.pData);
+			*pitch = mapped.RowPitch;
+
+			return ReadState::ready;
+		}
+
+		void unmap(size_t index) override
+		{
+			context_->Unmap(slots_[index].texture, 0);
+		}
+
+		void reset() override
+		{
+			for (auto& slot : slots_)
+				Release(slot.texture);
+
+			Release(resolved_);
+		}
+	};
+}
+
+Indicium::Core::Capture::CaptureDevice* Indicium::Core::Capture::CreateD3D11CaptureDevice()
+{
+	return new (std::nothrow) D3D11CaptureDevice();
+}
+
+#endif
@@ -0,0 +1,198 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#ifndef INDICIUM_NO_D3D9
+
+#include "FrameCapture.h"
+
+#include <d3d9.h>
+
+#include <new>
+
+namespace
+{
+	using namespace Indicium::Core::Capture;
+
+	template <typename T>
+	void Release(T*& object)
+	{
+		if (object)
+			object->Release();
+
+		object = nullptr;
+	}
+
+	/**
+	 * \brief   Regions get stretched into a render target on the GPU, the render target gets read
+	 *          into system memory once an event query reports the copy complete.
+	 */
+	class D3D9CaptureDevice : public CaptureDevice
+	{
+		struct Slot
+		{
+			IDirect3DSurface9* target;
+			IDirect3DSurface9* system;
+			IDirect3DQuery9* query;
+			UINT width;
+			UINT height;
+			D3DFORMAT format;
+		};
+
+		LPDIRECT3DDEVICE9 device_ = nullptr;
+		IDirect3DSurface9* back_buffer_ = nullptr;
+		D3DSURFACE_DESC desc_ = {};
+		Slot slots_[FrameCapture::MaxRegions * FrameCapture::MaxDepth] = {};
+
+		static void Release(Slot& slot)
+		{
+			::Release(slot.target);
+			::Release(slot.system);
+			::Release(slot.query);
+		}
+
+	public:
+		~D3D9CaptureDevice()
+		{
+			reset();
+		}
+
+		bool begin(PVOID presenter, BackBuffer* back_buffer) override
+		{
+			device_ = static_cast<LPDIRECT3DDEVICE9>(presenter);
+
+			if (FAILED(device_->GetBackBuffer(0, 0, D3DBACKBUFFER_TYPE_MONO, &back_buffer_)))
+				return false;
+
+			back_buffer_->GetDesc(&desc_);
+
+			back_buffer->width = desc_.Width;
+			back_buffer->height = desc_.Height;
+			back_buffer->format = desc_.Format;
+
+			return true;
+		}
+
+		bool copy(size_t index, const Rect& rect) override
+		{
+			auto& slot = slots_[index];
+
+			if (!slot.target || slot.width != rect.width || slot.height != rect.height || slot.format != desc_.Format)
+			{
+				Release(slot);
+
+				if (FAILED(device_->CreateRenderTarget(rect.width, rect.height, desc_.Format,
+					D3DMULTISAMPLE_NONE, 0, FALSE, &slot.target, nullptr)))
+					return false;
+
+				if (FAILED(device_->CreateOffscreenPlainSurface(rect.width, rect.height, desc_.Format,
+					D3DPOOL_SYSTEMMEM, &slot.system, nullptr)))
+				{
+					Release(slot);
+					return false;
+				}
+
+				//
+				// Without event queries the read waits for the copy instead
+				//
+				device_->CreateQuery(D3DQUERYTYPE_EVENT, &slot.query);
+
+				slot.width = rect.width;
+				slot.height = rect.height;
+				slot.format = desc_.Format;
+			}
+
+			RECT source;
+			source.left = rect.left;
+			source.top = rect.top;
+			source.right = rect.left + rect.width;
+			source.bottom = rect.top + rect.height;
+
+			//
+			// Also resolves multisampled back buffers
+			//
+			if (FAILED(device_->StretchRect(back_buffer_, &source, slot.target, nullptr, D3DTEXF_NONE)))
+				return false;
+
+			if (slot.query)
+				slot.query->Issue(D3DISSUE_END);
+
+			return true;
+		}
+
+		void end() override
+		{
+			::Release(back_buffer_);
+		}
+
+		ReadState map(size_t index, const BYTE** data, UINT32* pitch) override
+		{
+			auto& slot = slots_[index];
+
+			if (slot.query)
+			{
+				const auto hr = slot.query->GetData(nullptr, 0, D3DGETDATA_FLUSH);
+
+				if (hr == S_FALSE)
+					return ReadState::pending;
+
+				if (FAILED(hr))
+					return ReadState::failed;
+			}
+
+			if (FAILED(device_->GetRenderTargetData(slot.target, slot.system)))
+				return ReadState::failed;
+
+			D3DLOCKED_RECT locked;
+
+			if (FAILED(slot.system->LockRect(&locked, nullptr, D3DLOCK_READONLY)))
+				return ReadState::failed;
+
+			*data = static_cast<const BYTE*>(locked.pBits);
+			*pitch = locked.Pitch;
+
+			return ReadState::ready;
+		}
+
+		void unmap(size_t index) override
+		{
+			slots_[index].system->UnlockRect();
+		}
+
+		void reset() override
+		{
+			//
+			// Default pool render targets have to be gone before the device gets reset
+			//
+			for (auto& slot : slots_)
+				Release(slot);
+		}
+	};
+}
+
+Indicium::Core::Capture::CaptureDevice* Indicium::Core::Capture::CreateD3D9CaptureDevice()
+{
+	return new (std::nothrow) D3D9CaptureDevice();
+}
+
+#endif
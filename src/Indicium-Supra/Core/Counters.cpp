@@ -0,0 +1,137 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "Counters.h"
+#include "Memory.h"
+
+#include <cstring>
+#include <new>
+
+Indicium::Core::Stats::CounterRegistry::CounterRegistry() : count_(0)
+{
+}
+
+Indicium::Core::Stats::CounterRegistry::Entry* Indicium::Core::Stats::CounterRegistry::find(LPCSTR name)
+{
+	const auto count = count_.load(std::memory_order_relaxed);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (strcmp(entries_[i].name, name) == 0)
+			return &entries_[i];
+	}
+
+	return nullptr;
+}
+
+INDICIUM_ERROR Indicium::Core::Stats::CounterRegistry::append(LPCSTR name, Util::ShardedCounter* counter, bool owned)
+{
+	const auto count = count_.load(std::memory_order_relaxed);
+
+	if (count == MaxCounters)
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+
+	auto& entry = entries_[count];
+
+	strcpy_s(entry.name, name);
+	entry.counter = counter;
+	entry.owned = owned;
+
+	//
+	// Publish the entry before the count so readers never see a half-written one
+	//
+	count_.store(count + 1, std::memory_order_release);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_ERROR Indicium::Core::Stats::CounterRegistry::attach(LPCSTR name, Util::ShardedCounter& counter)
+{
+	if (strnlen(name, INDICIUM_COUNTER_NAME_LENGTH) == INDICIUM_COUNTER_NAME_LENGTH)
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	if (find(name))
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+
+	return append(name, &counter, false);
+}
+
+INDICIUM_ERROR Indicium::Core::Stats::CounterRegistry::create(LPCSTR name, _INDICIUM_COUNTER** counter)
+{
+	if (strnlen(name, INDICIUM_COUNTER_NAME_LENGTH) == INDICIUM_COUNTER_NAME_LENGTH)
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	if (const auto existing = find(name))
+	{
+		//
+		// Engine counters are read-only for API users
+		//
+		if (!existing->owned)
+			return INDICIUM_ERROR_INVALID_PARAMETER;
+
+		*counter = static_cast<_INDICIUM_COUNTER*>(existing->counter);
+		return INDICIUM_ERROR_NONE;
+	}
+
+	std::unique_ptr<_INDICIUM_COUNTER> created;
+
+	try
+	{
+		Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+		created = std::make_unique<_INDICIUM_COUNTER>();
+		owned_.reserve(owned_.size() + 1);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	const auto result = append(name, created.get(), true);
+
+	if (result != INDICIUM_ERROR_NONE)
+		return result;
+
+	*counter = created.get();
+	owned_.push_back(std::move(created));
+
+	return INDICIUM_ERROR_NONE;
+}
+
+size_t Indicium::Core::Stats::CounterRegistry::snapshot(PINDICIUM_COUNTER_VALUE values, size_t capacity) const
+{
+	const auto count = count_.load(std::memory_order_acquire);
+
+	for (size_t i = 0; i < count && i < capacity; i++)
+	{
+		strcpy_s(values[i].Name, entries_[i].name);
+		values[i].Value = entries_[i].counter->load();
+	}
+
+	return count;
+}
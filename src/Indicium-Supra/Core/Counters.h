@@ -0,0 +1,102 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumCounters.h"
+
+#include "Utils/ShardedCounter.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+//
+// Counters registered through the API; the handle is the counter itself
+//
+struct _INDICIUM_COUNTER : Indicium::Core::Util::ShardedCounter
+{
+};
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            /**
+             * \brief   Name to counter table of an engine. Engine subsystems attach the counters
+             *          they own when they get created, API users get counters owned by the
+             *          registry. Entries are append-only and published through the count, so
+             *          readers never lock.
+             */
+            class CounterRegistry
+            {
+            public:
+                static const size_t MaxCounters = 512;
+
+            private:
+                struct Entry
+                {
+                    CHAR name[INDICIUM_COUNTER_NAME_LENGTH];
+                    Util::ShardedCounter* counter;
+                    bool owned;
+                };
+
+                Entry entries_[MaxCounters];
+                std::atomic<size_t> count_;
+
+                std::mutex writer_lock_;
+                std::vector<std::unique_ptr<_INDICIUM_COUNTER>> owned_;
+
+                Entry* find(LPCSTR name);
+                INDICIUM_ERROR append(LPCSTR name, Util::ShardedCounter* counter, bool owned);
+
+            public:
+                CounterRegistry();
+
+                CounterRegistry(const CounterRegistry&) = delete;
+                CounterRegistry& operator=(const CounterRegistry&) = delete;
+
+                /**
+                 * \brief   Lists a counter owned by an engine subsystem. Entries are never removed,
+                 *          so the counter must outlive the registry; IndiciumEngineDestroy frees
+                 *          the registry before any subsystem.
+                 */
+                INDICIUM_ERROR attach(LPCSTR name, Util::ShardedCounter& counter);
+
+                INDICIUM_ERROR create(LPCSTR name, _INDICIUM_COUNTER** counter);
+
+                /**
+                 * \brief   Copies up to capacity values and returns the number of registered counters.
+                 */
+                size_t snapshot(PINDICIUM_COUNTER_VALUE values, size_t capacity) const;
+            };
+        };
+    };
+};
@@ -0,0 +1,318 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "CpuAttribution.h"
+
+#include <TlHelp32.h>
+#include <intrin.h>
+
+#include <algorithm>
+#include <functional>
+
+Indicium::Core::Stats::CpuAttribution::CpuAttribution() :
+	active_(false),
+	render_thread_(0),
+	presents_(0),
+	present_time_(0),
+	restart_(false),
+	last_scan_(0),
+	last_presents_(0),
+	last_present_time_(0),
+	tsc_origin_(0),
+	qpc_origin_(0),
+	history_next_(0),
+	history_count_(0)
+{
+	InitializeSRWLock(&history_lock_);
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	frequency_ = frequency.QuadPart;
+
+	//
+	// Sampling must not allocate once running
+	//
+	threads_.reserve(MaxThreads);
+	deltas_.reserve(MaxThreads);
+}
+
+Indicium::Core::Stats::CpuAttribution::~CpuAttribution()
+{
+	forget_threads();
+}
+
+void Indicium::Core::Stats::CpuAttribution::start(UINT32 history_frames)
+{
+	AcquireSRWLockExclusive(&history_lock_);
+
+	try
+	{
+		history_.assign(history_frames ? history_frames : DefaultHistory, INDICIUM_FRAME_CPU_TIMES{});
+	}
+	catch (...)
+	{
+		ReleaseSRWLockExclusive(&history_lock_);
+		throw;
+	}
+
+	history_next_ = 0;
+	history_count_ = 0;
+
+	ReleaseSRWLockExclusive(&history_lock_);
+
+	restart_.store(true, std::memory_order_relaxed);
+	active_.store(true, std::memory_order_release);
+}
+
+void Indicium::Core::Stats::CpuAttribution::stop()
+{
+	active_.store(false, std::memory_order_relaxed);
+}
+
+void Indicium::Core::Stats::CpuAttribution::on_present(HANDLE wake_event)
+{
+	if (!active_.load(std::memory_order_relaxed))
+		return;
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	render_thread_.store(GetCurrentThreadId(), std::memory_order_relaxed);
+	present_time_.store(now.QuadPart, std::memory_order_relaxed);
+	presents_.fetch_add(1, std::memory_order_release);
+
+	SetEvent(wake_event);
+}
+
+void Indicium::Core::Stats::CpuAttribution::scan_threads(LONGLONG now)
+{
+	last_scan_ = now;
+
+	const auto snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+
+	if (snapshot == INVALID_HANDLE_VALUE)
+		return;
+
+	const auto process = GetCurrentProcessId();
+	THREADENTRY32 entry;
+	entry.dwSize = sizeof(THREADENTRY32);
+
+	for (auto more = Thread32First(snapshot, &entry); more; more = Thread32Next(snapshot, &entry))
+	{
+		if (entry.th32OwnerProcessID != process)
+			continue;
+
+		if (threads_.size() == MaxThreads)
+			break;
+
+		const auto id = entry.th32ThreadID;
+
+		if (std::any_of(threads_.begin(), threads_.end(), [id](const Tracked& t) { return t.id == id; }))
+			continue;
+
+		const auto handle = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, id);
+
+		if (!handle)
+			continue;
+
+		//
+		// Cycles spent before discovery belong to no frame
+		//
+		ULONG64 cycles = 0;
+		QueryThreadCycleTime(handle, &cycles);
+
+		threads_.push_back({ id, handle, cycles, false });
+	}
+
+	CloseHandle(snapshot);
+}
+
+void Indicium::Core::Stats::CpuAttribution::forget_threads()
+{
+	for (const auto& thread : threads_)
+	{
+		CloseHandle(thread.handle);
+	}
+
+	threads_.clear();
+}
+
+double Indicium::Core::Stats::CpuAttribution::cycles_per_ms(LONGLONG now) const
+{
+	const auto elapsed_ms = (now - qpc_origin_) * 1000.0 / frequency_;
+
+	return elapsed_ms > 0.0 ? (__rdtsc() - tsc_origin_) / elapsed_ms : 0.0;
+}
+
+void Indicium::Core::Stats::CpuAttribution::sample()
+{
+	if (!active_.load(std::memory_order_acquire))
+		return;
+
+	const auto presents = presents_.load(std::memory_order_acquire);
+	const auto present_time = present_time_.load(std::memory_order_relaxed);
+
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+	const auto now = counter.QuadPart;
+
+	//
+	// Establish the baseline; the first frame starts at the next Present
+	//
+	if (restart_.exchange(false, std::memory_order_relaxed))
+	{
+		forget_threads();
+		scan_threads(now);
+
+		last_presents_ = presents;
+		last_present_time_ = present_time;
+		tsc_origin_ = __rdtsc();
+		qpc_origin_ = now;
+		return;
+	}
+
+	if (presents == last_presents_)
+		return;
+
+	if (now - last_scan_ > frequency_ / 4)
+		scan_threads(now);
+
+	const auto render_thread = render_thread_.load(std::memory_order_relaxed);
+	const auto engine_thread = GetCurrentThreadId();
+	ULONG64 total = 0;
+
+	deltas_.clear();
+
+	for (size_t i = 0; i < threads_.size(); i++)
+	{
+		auto& thread = threads_[i];
+		ULONG64 cycles;
+		DWORD code;
+
+		if (QueryThreadCycleTime(thread.handle, &cycles))
+		{
+			const auto delta = cycles - thread.cycles;
+			thread.cycles = cycles;
+			total += delta;
+
+			if (delta || thread.id == render_thread)
+				deltas_.emplace_back(delta, i);
+		}
+
+		thread.exited = !GetExitCodeThread(thread.handle, &code) || code != STILL_ACTIVE;
+	}
+
+	const auto listed = (std::min)(deltas_.size(), static_cast<size_t>(INDICIUM_FRAME_CPU_MAX_THREADS));
+
+	std::partial_sort(deltas_.begin(), deltas_.begin() + listed, deltas_.end(),
+		std::greater<std::pair<ULONG64, size_t>>());
+
+	//
+	// Keep the render thread in the list even on frames where others were busier
+	//
+	const auto render = std::find_if(deltas_.begin() + listed, deltas_.end(),
+		[this, render_thread](const std::pair<ULONG64, size_t>& d) { return threads_[d.second].id == render_thread; });
+
+	if (render != deltas_.end())
+		std::iter_swap(deltas_.begin() + listed - 1, render);
+
+	const auto per_ms = cycles_per_ms(now);
+	const auto ms = [per_ms](ULONG64 cycles) { return per_ms > 0.0 ? cycles / per_ms : 0.0; };
+
+	INDICIUM_FRAME_CPU_TIMES frame;
+	ZeroMemory(&frame, sizeof(INDICIUM_FRAME_CPU_TIMES));
+
+	frame.FirstFrame = last_presents_ + 1;
+	frame.Frames = static_cast<UINT32>(presents - last_presents_);
+	frame.WallMs = (present_time - last_present_time_) * 1000.0 / frequency_;
+	frame.TotalCpuMs = ms(total);
+	frame.ThreadCount = static_cast<UINT32>(listed);
+
+	ULONG64 listed_cycles = 0;
+
+	for (size_t i = 0; i < listed; i++)
+	{
+		const auto& thread = threads_[deltas_[i].second];
+		auto& entry = frame.Threads[i];
+
+		entry.ThreadId = thread.id;
+		entry.IsRenderThread = thread.id == render_thread;
+		entry.IsEngineThread = thread.id == engine_thread;
+		entry.Cycles = deltas_[i].first;
+		entry.CpuMs = ms(deltas_[i].first);
+
+		listed_cycles += deltas_[i].first;
+	}
+
+	for (size_t i = listed; i < deltas_.size(); i++)
+	{
+		if (deltas_[i].first)
+			frame.OtherThreads++;
+	}
+
+	frame.OtherCpuMs = ms(total - listed_cycles);
+
+	AcquireSRWLockExclusive(&history_lock_);
+
+	if (!history_.empty())
+	{
+		history_[history_next_] = frame;
+		history_next_ = (history_next_ + 1) % history_.size();
+		history_count_ = (std::min)(history_count_ + 1, history_.size());
+	}
+
+	ReleaseSRWLockExclusive(&history_lock_);
+
+	last_presents_ = presents;
+	last_present_time_ = present_time;
+
+	//
+	// Exited threads got their last cycles accounted above
+	//
+	for (size_t i = threads_.size(); i-- > 0;)
+	{
+		if (!threads_[i].exited)
+			continue;
+
+		CloseHandle(threads_[i].handle);
+		threads_[i] = threads_.back();
+		threads_.pop_back();
+	}
+}
+
+size_t Indicium::Core::Stats::CpuAttribution::frames(PINDICIUM_FRAME_CPU_TIMES values, size_t capacity)
+{
+	AcquireSRWLockShared(&history_lock_);
+
+	const auto count = history_count_;
+
+	for (size_t i = 0; i < count && i < capacity; i++)
+	{
+		values[i] = history_[(history_next_ + history_.size() - 1 - i) % history_.size()];
+	}
+
+	ReleaseSRWLockShared(&history_lock_);
+
+	return count;
+}
@@ -0,0 +1,122 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumFrameStatistics.h"
+
+#include <atomic>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            /**
+             * \brief   Per-thread CPU time of the host process between Present boundaries.
+             *
+             *          The render thread only stores the boundary and wakes the engine thread,
+             *          which reads the cycle time of every known thread and stores the deltas as
+             *          one frame. Threads are discovered by a periodic process snapshot. Memory is
+             *          bounded by the tracked thread limit and the frame history size.
+             */
+            class CpuAttribution
+            {
+            public:
+                static const size_t MaxThreads = 256;
+                static const UINT32 DefaultHistory = 256;
+
+            private:
+                struct Tracked
+                {
+                    DWORD id;
+                    HANDLE handle;
+                    ULONG64 cycles;
+                    bool exited;
+                };
+
+                //
+                // Render thread
+                //
+                std::atomic<bool> active_;
+                std::atomic<DWORD> render_thread_;
+                std::atomic<ULONGLONG> presents_;
+                std::atomic<LONGLONG> present_time_;
+
+                //
+                // Engine thread
+                //
+                std::atomic<bool> restart_;
+                std::vector<Tracked> threads_;
+                std::vector<std::pair<ULONG64, size_t>> deltas_;
+                LONGLONG frequency_;
+                LONGLONG last_scan_;
+                ULONGLONG last_presents_;
+                LONGLONG last_present_time_;
+                ULONGLONG tsc_origin_;
+                LONGLONG qpc_origin_;
+
+                //
+                // Frame history ring; guarded by history_lock_
+                //
+                SRWLOCK history_lock_;
+                std::vector<INDICIUM_FRAME_CPU_TIMES> history_;
+                size_t history_next_;
+                size_t history_count_;
+
+                void scan_threads(LONGLONG now);
+                void forget_threads();
+                double cycles_per_ms(LONGLONG now) const;
+
+            public:
+                CpuAttribution();
+                ~CpuAttribution();
+
+                CpuAttribution(const CpuAttribution&) = delete;
+                CpuAttribution& operator=(const CpuAttribution&) = delete;
+
+                void start(UINT32 history_frames);
+
+                void stop();
+
+                /**
+                 * \brief   Records a Present boundary and signals the engine thread; render thread only.
+                 */
+                void on_present(HANDLE wake_event);
+
+                /**
+                 * \brief   Takes a sample if a Present happened since the last one; engine thread only.
+                 */
+                void sample();
+
+                size_t frames(PINDICIUM_FRAME_CPU_TIMES values, size_t capacity);
+            };
+        };
+    };
+};
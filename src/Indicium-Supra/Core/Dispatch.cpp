@@ -0,0 +1,419 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+//
+// Public
+// 
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumDirect3D9.h"
+#include "Indicium/Engine/IndiciumDirect3D10.h"
+#include "Indicium/Engine/IndiciumDirect3D11.h"
+#include "Indicium/Engine/IndiciumDirect3D12.h"
+#include "Indicium/Engine/IndiciumCoreAudio.h"
+#include "Indicium/Engine/IndiciumEventBus.h"
+#include "Indicium/Engine/IndiciumTasks.h"
+#include "Indicium/Engine/IndiciumBenchmark.h"
+#include "Indicium/Engine/IndiciumCapture.h"
+#include "Indicium/Engine/IndiciumAudioMix.h"
+
+//
+// Internal
+// 
+#include "Engine.h"
+#include "Dispatch.h"
+#include "ArcEventBatcher.h"
+#include "AudioMixer.h"
+#include "RawInputBatcher.h"
+#include "XInputTracker.h"
+#include "InputReplay.h"
+#include "EventBus.h"
+#include "PluginHost.h"
+#include "WorkerPool.h"
+#include "PostPresentTasks.h"
+#include "TickHandlers.h"
+#include "Benchmark.h"
+#include "FrameOverhead.h"
+#include "CpuAttribution.h"
+#include "DisplayTracker.h"
+#include "LowLatency.h"
+#include "FrameCapture.h"
+#include "OverheadExperiment.h"
+#include "ShaderReplacement.h"
+#include "Counters.h"
+#include "Memory.h"
+#include "Global.h"
+#include "LogLimiter.h"
+
+//
+// Logging
+// 
+#include <spdlog/spdlog.h>
+
+//
+// STL
+// 
+#include <string>
+#include <new>
+
+//
+// Upper bound for the engine thread to stay idle so configuration changes get picked up
+// 
+static const DWORD EngineIdleTickInterval = 100;
+
+//
+// Directory configured for a subsystem, or the given sub-directory next to the host library
+// 
+static std::string SubsystemDirectory(PINDICIUM_ENGINE engine, PCSTR configured, PCSTR fallback)
+{
+	std::string directory;
+
+	if (configured) {
+		directory = Indicium::Core::Util::expand_environment_variables(configured);
+		directory.resize(strlen(directory.c_str()));
+	}
+	else {
+		CHAR path[MAX_PATH];
+		const auto length = GetModuleFileNameA(engine->HostInstance, path, MAX_PATH);
+
+		directory.assign(path, length);
+		directory = directory.substr(0, directory.find_last_of('\\')) + "\\" + fallback;
+	}
+
+	return directory;
+}
+
+void Indicium::Core::Dispatch::OnPrePresent(PINDICIUM_ENGINE engine)
+{
+	if (engine->PresentCalls) {
+		engine->PresentCalls->add();
+	}
+
+	//
+	// Same position in the hook as on the suspended path, so both measure the same span
+	// 
+	if (engine->Experiment) {
+		engine->Experiment->on_frame(engine);
+	}
+
+	Stats::FrameOverhead::frame_enter();
+
+	const auto benchmark = engine->Benchmark;
+
+	if (benchmark) {
+		benchmark->on_frame();
+	}
+
+	if (engine->ArcBatcher) {
+		engine->ArcBatcher->deliver(engine, IndiciumARCBatchDeliveryPresent);
+	}
+
+	if (engine->RawInput) {
+		engine->RawInput->deliver(engine);
+	}
+
+	if (engine->XInput) {
+		engine->XInput->deliver(engine);
+	}
+
+	//
+	// Frame boundary for recordings comes after their input of the ending frame
+	// 
+	if (engine->InputReplay && engine->InputReplay->on_present()) {
+		SetEvent(engine->EngineWakeEvent);
+	}
+
+	if (engine->Bus) {
+		engine->Bus->drain();
+	}
+
+	if (benchmark) {
+		benchmark->callbacks_begin();
+	}
+}
+
+void Indicium::Core::Dispatch::OnSuspendedPresent(PINDICIUM_ENGINE engine)
+{
+	if (engine->PresentCalls) {
+		engine->PresentCalls->add();
+	}
+
+	if (engine->Experiment) {
+		engine->Experiment->on_frame(engine);
+	}
+}
+
+void Indicium::Core::Dispatch::BeginOriginalPresent(
+	PINDICIUM_ENGINE engine,
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter
+)
+{
+	if (engine->Capture) {
+		engine->Capture->on_present(engine, version, presenter);
+	}
+
+	if (engine->Benchmark) {
+		engine->Benchmark->present_begin();
+	}
+
+	Stats::FrameOverhead::present_begin();
+
+	if (engine->LowLatency) {
+		Pacing::LowLatencyMode::present_begin();
+	}
+}
+
+void Indicium::Core::Dispatch::EndOriginalPresent(PINDICIUM_ENGINE engine)
+{
+	Stats::FrameOverhead::present_end();
+
+	if (engine->LowLatency) {
+		Pacing::LowLatencyMode::present_end();
+	}
+
+	if (engine->Benchmark) {
+		engine->Benchmark->present_end();
+	}
+}
+
+void Indicium::Core::Dispatch::OnPostPresent(
+	PINDICIUM_ENGINE engine,
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter,
+	HRESULT result
+)
+{
+	//
+	// Lost or removed devices fail every frame until the host recovers
+	//
+	if (FAILED(result)) {
+		INDICIUM_LOG_LIMITED(spdlog::get("indicium"), error, 1, 5,
+			"Present failed (version {}, HRESULT {:#x})", static_cast<int>(version), static_cast<ULONG>(result));
+	}
+
+	if (engine->Benchmark) {
+		engine->Benchmark->callbacks_end();
+	}
+
+	if (engine->PostPresentTasks) {
+		engine->PostPresentTasks->run(engine, version, presenter, result);
+	}
+
+	if (engine->Display) {
+		engine->Display->on_present(version, presenter);
+	}
+
+	if (engine->CpuAttribution) {
+		engine->CpuAttribution->on_present(engine->EngineWakeEvent);
+	}
+
+	engine->Overhead->frame_exit(version, presenter);
+
+	//
+	// Deliberate wait, kept out of the overhead accounting
+	//
+	if (engine->LowLatency) {
+		engine->LowLatency->on_present(version, presenter, engine->Display);
+	}
+}
+
+void Indicium::Core::Dispatch::OnPreResize(PINDICIUM_ENGINE engine, PVOID presenter)
+{
+	if (engine->ResizeCalls) {
+		engine->ResizeCalls->add();
+	}
+
+	if (engine->Capture) {
+		engine->Capture->on_resize(presenter);
+	}
+}
+
+void Indicium::Core::Dispatch::OnPostResize(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, HRESULT result)
+{
+	//
+	// Hosts retry a failing resize or reset every frame, e.g. while the device is lost
+	//
+	if (FAILED(result)) {
+		INDICIUM_LOG_LIMITED(spdlog::get("indicium"), error, 1, 5,
+			"Resize or reset failed (version {}, HRESULT {:#x})", static_cast<int>(version), static_cast<ULONG>(result));
+	}
+}
+
+void Indicium::Core::Dispatch::OnAudioObjectReleased(PINDICIUM_ENGINE engine, IUnknown* object)
+{
+	if (engine->AudioMix) {
+		engine->AudioMix->on_released(object);
+	}
+
+	if (engine->ArcBatcher) {
+		engine->ArcBatcher->on_released(object);
+	}
+}
+
+void Indicium::Core::Dispatch::OnEngineStart(PINDICIUM_ENGINE engine)
+{
+	//
+	// Render clients must be tracked from their creation on, long before a mixdown gets started
+	// 
+	if (engine->EngineConfig.CoreAudio.HookCoreAudio) {
+		Memory::Scope scope(IndiciumMemoryTagAudio);
+
+		engine->AudioMix = new (std::nothrow) Audio::AudioMixer(*engine->Counters);
+	}
+
+	try
+	{
+		Memory::Scope scope(IndiciumMemoryTagInput);
+
+		if (engine->EngineConfig.Input.HookRawInput) {
+			engine->RawInput = new Input::RawInputBatcher(*engine->Counters);
+		}
+
+		if (engine->EngineConfig.Input.HookXInput) {
+			engine->XInput = new Input::XInputTracker(*engine->Counters);
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+		spdlog::get("indicium")->clone("input")->error("Out of memory while creating input buffers");
+	}
+
+	//
+	// Replacements have to be in place before the hooks see the first shader
+	// 
+	if (engine->EngineConfig.Shaders.HookDirect3D11) {
+		const auto& shaders = engine->EngineConfig.Shaders;
+
+		Memory::Scope scope(IndiciumMemoryTagShaders);
+
+		try
+		{
+			engine->Shaders = new Shaders::ShaderReplacement(*engine->Counters);
+			engine->Shaders->load(
+				SubsystemDirectory(engine, shaders.Directory, "Shaders"),
+				shaders.WriteManifest != FALSE,
+				shaders.DumpBytecode != FALSE
+			);
+		}
+		catch (const std::bad_alloc&)
+		{
+			spdlog::get("indicium")->clone("shaders")->error("Out of memory while loading replacement shaders");
+		}
+	}
+
+	const auto& config = engine->EngineConfig.PluginHost;
+
+	if (!config.IsEnabled) {
+		return;
+	}
+
+	Memory::Scope scope(IndiciumMemoryTagPlugins);
+
+	try
+	{
+		engine->Plugins = new Plugins::PluginHost(engine);
+		engine->Plugins->load(SubsystemDirectory(engine, config.Directory, "Plugins"));
+	}
+	catch (const std::bad_alloc&)
+	{
+		spdlog::get("indicium")->clone("plugins")->error("Out of memory while loading plugins");
+	}
+}
+
+void Indicium::Core::Dispatch::OnEngineStop(PINDICIUM_ENGINE engine)
+{
+	//
+	// Let in-flight worker tasks finish before plugins owning them go away
+	// 
+	if (engine->Workers) {
+		engine->Workers->shutdown();
+	}
+
+	if (engine->EncodeWorkers) {
+		engine->EncodeWorkers->shutdown();
+	}
+
+	if (engine->Plugins) {
+		engine->Plugins->unload();
+	}
+}
+
+DWORD Indicium::Core::Dispatch::EngineTickInterval(PINDICIUM_ENGINE engine)
+{
+	DWORD interval = EngineIdleTickInterval;
+
+	if (engine->ArcBatcher && engine->ArcBatcher->worker_interval() < interval) {
+		interval = engine->ArcBatcher->worker_interval();
+	}
+
+	if (engine->Benchmark && engine->Benchmark->tick_interval() < interval) {
+		interval = engine->Benchmark->tick_interval();
+	}
+
+	if (engine->AudioMix && engine->AudioMix->tick_interval() < interval) {
+		interval = engine->AudioMix->tick_interval();
+	}
+
+	if (engine->InputReplay && engine->InputReplay->tick_interval() < interval) {
+		interval = engine->InputReplay->tick_interval();
+	}
+
+	if (engine->TickHandlers && engine->TickHandlers->interval() < interval) {
+		interval = engine->TickHandlers->interval();
+	}
+
+	return interval;
+}
+
+void Indicium::Core::Dispatch::OnEngineTick(PINDICIUM_ENGINE engine)
+{
+	if (engine->ArcBatcher) {
+		engine->ArcBatcher->deliver(engine, IndiciumARCBatchDeliveryWorker);
+	}
+
+	if (engine->Benchmark) {
+		engine->Benchmark->poll_hotkey(engine);
+		engine->Benchmark->aggregate();
+	}
+
+	if (engine->CpuAttribution) {
+		engine->CpuAttribution->sample();
+	}
+
+	if (engine->AudioMix) {
+		engine->AudioMix->tick(engine);
+	}
+
+	if (engine->InputReplay) {
+		engine->InputReplay->tick();
+	}
+
+	if (engine->TickHandlers) {
+		engine->TickHandlers->run(engine);
+	}
+}
@@ -0,0 +1,172 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Dispatch
+        {
+            /**
+             * \fn  void OnPrePresent(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Engine work due at every frame boundary, invoked by all Present hooks on the
+             *          render thread before the Pre-Present callbacks fire. Starts the overhead
+             *          accounting of the frame, so it has to come first in the hook.
+             *
+             * \param   engine  The engine handle.
+             */
+            void OnPrePresent(PINDICIUM_ENGINE engine);
+
+            /**
+             * \fn  void OnSuspendedPresent(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Replaces all engine work of a Present hook while INDICIUM_ENGINE::Suspended
+             *          is set; the hook calls the original Present right after.
+             *
+             * \param   engine  The engine handle.
+             */
+            void OnSuspendedPresent(PINDICIUM_ENGINE engine);
+
+            /**
+             * \fn  void BeginOriginalPresent(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, PVOID presenter);
+             *
+             * \brief   Invoked by all Present hooks right before calling the original Present,
+             *          after the Pre-Present callbacks fired. The back buffer holds the finished
+             *          frame, overlays included, so this is where it gets captured.
+             *
+             * \param   engine      The engine handle.
+             * \param   version     The render API about to present.
+             * \param   presenter   The presenting swap chain or device.
+             */
+            void BeginOriginalPresent(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, PVOID presenter);
+
+            /**
+             * \fn  void EndOriginalPresent(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Invoked by all Present hooks right after the original Present returned,
+             *          before the Post-Present callbacks fire.
+             *
+             * \param   engine  The engine handle.
+             */
+            void EndOriginalPresent(PINDICIUM_ENGINE engine);
+
+            /**
+             * \fn  void OnPostPresent(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, PVOID presenter, HRESULT result);
+             *
+             * \brief   Engine work due after every frame, invoked by all Present hooks on the render
+             *          thread after the Post-Present callbacks fired. Ends the overhead accounting
+             *          of the frame and applies the low-latency wait, so it has to come last in the
+             *          hook.
+             *
+             * \param   engine      The engine handle.
+             * \param   version     The render API which presented.
+             * \param   presenter   The presenting swap chain or device.
+             * \param   result      The value returned by the original Present.
+             */
+            void OnPostPresent(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, PVOID presenter, HRESULT result);
+
+            /**
+             * \fn  void OnPreResize(PINDICIUM_ENGINE engine, PVOID presenter);
+             *
+             * \brief   Invoked by the ResizeBuffers and Reset hooks before calling the original, so
+             *          engine resources depending on the back buffers get released in time.
+             *
+             * \param   engine      The engine handle.
+             * \param   presenter   The swap chain or device about to be resized or reset.
+             */
+            void OnPreResize(PINDICIUM_ENGINE engine, PVOID presenter);
+
+            /**
+             * \fn  void OnPostResize(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, HRESULT result);
+             *
+             * \brief   Invoked by the ResizeBuffers and Reset hooks after the original returned.
+             *
+             * \param   engine      The engine handle.
+             * \param   version     The render API which got resized or reset.
+             * \param   result      The value returned by the original function.
+             */
+            void OnPostResize(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, HRESULT result);
+
+            /**
+             * \fn  void OnAudioObjectReleased(PINDICIUM_ENGINE engine, IUnknown* object);
+             *
+             * \brief   Invoked by the IAudioRenderClient and IAudioClient Release hooks before the
+             *          last reference goes, so per-client state goes away with the client and
+             *          never outlives its address.
+             *
+             * \param   engine  The engine handle.
+             * \param   object  The render client or audio client; only serves as a key.
+             */
+            void OnAudioObjectReleased(PINDICIUM_ENGINE engine, IUnknown* object);
+
+            /**
+             * \fn  void OnEngineStart(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Engine set-up executed on the engine thread before any hooks get applied.
+             *
+             * \param   engine  The engine handle.
+             */
+            void OnEngineStart(PINDICIUM_ENGINE engine);
+
+            /**
+             * \fn  void OnEngineStop(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Engine tear-down executed on the engine thread after all hooks got removed.
+             *
+             * \param   engine  The engine handle.
+             */
+            void OnEngineStop(PINDICIUM_ENGINE engine);
+
+            /**
+             * \fn  DWORD EngineTickInterval(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Returns the period in milliseconds in which the engine thread needs to call
+             *          OnEngineTick.
+             *
+             * \param   engine  The engine handle.
+             *
+             * \returns Wait timeout for the engine thread.
+             */
+            DWORD EngineTickInterval(PINDICIUM_ENGINE engine);
+
+            /**
+             * \fn  void OnEngineTick(PINDICIUM_ENGINE engine);
+             *
+             * \brief   Periodic engine work executed on the engine thread, also run whenever the
+             *          engine wake event gets signaled.
+             *
+             * \param   engine  The engine handle.
+             */
+            void OnEngineTick(PINDICIUM_ENGINE engine);
+        };
+    };
+};
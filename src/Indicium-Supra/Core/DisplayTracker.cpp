@@ -0,0 +1,357 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "DisplayTracker.h"
+
+#include <dxgi.h>
+
+#ifndef INDICIUM_NO_D3D9
+#include <d3d9.h>
+#endif
+
+#include <algorithm>
+
+//
+// Reads the identifier of the latest Present and, if requested, the presentation statistics
+//
+static bool ReadPresentStatistics(
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter,
+	UINT* present_id,
+	Indicium::Core::Stats::DisplayTracker::Sample* sample
+)
+{
+	if (version == IndiciumDirect3DVersion9)
+	{
+#ifndef INDICIUM_NO_D3D9
+		IDirect3DSwapChain9* chain = nullptr;
+
+		if (FAILED(static_cast<LPDIRECT3DDEVICE9>(presenter)->GetSwapChain(0, &chain)))
+			return false;
+
+		//
+		// Only Direct3D 9Ex swap chains keep presentation statistics
+		//
+		IDirect3DSwapChain9Ex* chainEx = nullptr;
+		const auto hr = chain->QueryInterface(__uuidof(IDirect3DSwapChain9Ex), reinterpret_cast<void**>(&chainEx));
+		chain->Release();
+
+		if (FAILED(hr))
+			return false;
+
+		auto ok = SUCCEEDED(chainEx->GetLastPresentCount(present_id));
+
+		if (ok && sample)
+		{
+			D3DPRESENTSTATS stats;
+			ok = SUCCEEDED(chainEx->GetPresentStats(&stats));
+
+			sample->present_count = stats.PresentCount;
+			sample->sync_refresh_count = stats.SyncRefreshCount;
+			sample->sync_qpc = stats.SyncQPCTime.QuadPart;
+		}
+
+		chainEx->Release();
+
+		return ok;
+#else
+		return false;
+#endif
+	}
+
+	//
+	// Every other API presents through a DXGI swap chain
+	//
+	const auto chain = static_cast<IDXGISwapChain*>(presenter);
+
+	if (FAILED(chain->GetLastPresentCount(present_id)))
+		return false;
+
+	if (!sample)
+		return true;
+
+	DXGI_FRAME_STATISTICS stats;
+
+	if (FAILED(chain->GetFrameStatistics(&stats)))
+		return false;
+
+	sample->present_count = stats.PresentCount;
+	sample->sync_refresh_count = stats.SyncRefreshCount;
+	sample->sync_qpc = stats.SyncQPCTime.QuadPart;
+
+	return true;
+}
+
+Indicium::Core::Stats::DisplayTracker::DisplayTracker() :
+	active_(false),
+	restart_(false),
+	interval_(1),
+	owners_(0),
+	requested_interval_(1)
+{
+	ZeroMemory(slots_, sizeof(slots_));
+	ZeroMemory(published_, sizeof(published_));
+	ZeroMemory(recency_, sizeof(recency_));
+
+	InitializeSRWLock(&published_lock_);
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ticks_per_ms_ = frequency.QuadPart / 1000.0;
+}
+
+void Indicium::Core::Stats::DisplayTracker::start(Owner owner, UINT32 interval)
+{
+	//
+	// Explicit starts reset the statistics, pacing joining a running tracker leaves them alone
+	//
+	if (owner == OwnerApi || !owners_)
+		restart_.store(true, std::memory_order_relaxed);
+
+	if (owner == OwnerApi)
+		requested_interval_ = interval ? interval : 1;
+
+	owners_ |= owner;
+
+	apply_owners();
+}
+
+void Indicium::Core::Stats::DisplayTracker::stop(Owner owner)
+{
+	owners_ &= ~UINT32(owner);
+
+	apply_owners();
+}
+
+void Indicium::Core::Stats::DisplayTracker::apply_owners()
+{
+	interval_.store((owners_ & OwnerPacing) ? 1 : requested_interval_, std::memory_order_relaxed);
+	active_.store(owners_ != 0, std::memory_order_release);
+}
+
+Indicium::Core::Stats::DisplayTracker::Slot& Indicium::Core::Stats::DisplayTracker::slot_for(PVOID presenter)
+{
+	Slot* oldest = &slots_[0];
+
+	for (auto& slot : slots_)
+	{
+		if (slot.presenter == presenter)
+			return slot;
+
+		if (slot.presenter == nullptr || slot.last_seen < oldest->last_seen)
+			oldest = &slot;
+
+		if (slot.presenter == nullptr)
+			break;
+	}
+
+	//
+	// Take over a free slot or evict the presenter seen least recently
+	//
+	ZeroMemory(oldest, sizeof(Slot));
+	oldest->presenter = presenter;
+	oldest->stats.Presenter = presenter;
+
+	return *oldest;
+}
+
+void Indicium::Core::Stats::DisplayTracker::reconcile(Slot& slot, const Sample& sample)
+{
+	auto& stats = slot.stats;
+
+	//
+	// Nothing reached the screen yet
+	//
+	if (sample.present_count == 0)
+		return;
+
+	stats.QueueDepth = slot.last_present_id > sample.present_count ? slot.last_present_id - sample.present_count : 0;
+
+	if (slot.have_previous && sample.present_count != slot.previous.present_count)
+	{
+		const auto presents = sample.present_count - slot.previous.present_count;
+		const auto refreshes = sample.sync_refresh_count - slot.previous.sync_refresh_count;
+
+		//
+		// A refresh shows at most one new frame, the latest Present is known to be on screen;
+		// with tearing (no refresh in between) all of them count as displayed
+		//
+		const auto displayed = refreshes ? (std::min)(presents, refreshes) : presents;
+
+		stats.FramesDisplayed += displayed;
+		stats.FramesDropped += presents - displayed;
+		stats.MissedRefreshes += refreshes > displayed ? refreshes - displayed : 0;
+
+		const auto elapsed = sample.sync_qpc - slot.previous.sync_qpc;
+
+		if (elapsed > 0)
+		{
+			slot.displayed_ticks += elapsed;
+			slot.displayed_intervals += displayed;
+
+			stats.LastDisplayedFrameMs = elapsed / ticks_per_ms_ / displayed;
+			stats.AverageDisplayedFrameMs = slot.displayed_ticks / ticks_per_ms_ / slot.displayed_intervals;
+		}
+	}
+
+	for (const auto& pending : slot.pending)
+	{
+		if (pending.id != sample.present_count || pending.qpc == 0 || sample.sync_qpc < pending.qpc)
+			continue;
+
+		const auto latency = sample.sync_qpc - pending.qpc;
+
+		slot.latency_ticks += latency;
+		slot.latency_samples++;
+
+		stats.LastLatencyMs = latency / ticks_per_ms_;
+		stats.AverageLatencyMs = slot.latency_ticks / ticks_per_ms_ / slot.latency_samples;
+		break;
+	}
+
+	slot.previous = sample;
+	slot.have_previous = true;
+}
+
+void Indicium::Core::Stats::DisplayTracker::on_present(INDICIUM_D3D_VERSION version, PVOID presenter)
+{
+	if (!active_.load(std::memory_order_acquire))
+		return;
+
+	//
+	// Never block a render thread; another one presenting at the same time skips this frame
+	//
+	if (writing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	if (restart_.exchange(false, std::memory_order_relaxed))
+		ZeroMemory(slots_, sizeof(slots_));
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	auto& slot = slot_for(presenter);
+
+	slot.last_seen = now.QuadPart;
+	slot.stats.Version = version;
+	slot.stats.PresentsHooked++;
+
+	const auto query = slot.until_query == 0;
+	slot.until_query = query ? interval_.load(std::memory_order_relaxed) - 1 : slot.until_query - 1;
+
+	UINT present_id = 0;
+	Sample sample;
+
+	if (ReadPresentStatistics(version, presenter, &present_id, query ? &sample : nullptr))
+	{
+		//
+		// The Present returned already, so this is close to when the frame got queued
+		//
+		slot.pending[slot.pending_next++ % PendingPresents] = { present_id, now.QuadPart };
+		slot.last_present_id = present_id;
+
+		if (query)
+			reconcile(slot, sample);
+	}
+	else if (query)
+	{
+		slot.stats.Unavailable++;
+		slot.have_previous = false;
+	}
+
+	//
+	// Copying every slot keeps restarts and evictions visible without extra bookkeeping
+	//
+	if (TryAcquireSRWLockExclusive(&published_lock_))
+	{
+		for (size_t i = 0; i < MaxPresenters; i++)
+		{
+			published_[i] = slots_[i].stats;
+			recency_[i] = slots_[i].last_seen;
+		}
+
+		ReleaseSRWLockExclusive(&published_lock_);
+	}
+
+	writing_.clear(std::memory_order_release);
+}
+
+bool Indicium::Core::Stats::DisplayTracker::latest(PVOID presenter, double* latency_ms, double* interval_ms)
+{
+	if (!active_.load(std::memory_order_acquire))
+		return false;
+
+	if (writing_.test_and_set(std::memory_order_acquire))
+		return false;
+
+	auto found = false;
+
+	for (const auto& slot : slots_)
+	{
+		if (slot.presenter != presenter)
+			continue;
+
+		//
+		// Zero until the first Present got matched on screen
+		//
+		if (slot.latency_samples)
+		{
+			*latency_ms = slot.stats.LastLatencyMs;
+			*interval_ms = slot.stats.LastDisplayedFrameMs;
+			found = true;
+		}
+
+		break;
+	}
+
+	writing_.clear(std::memory_order_release);
+
+	return found;
+}
+
+size_t Indicium::Core::Stats::DisplayTracker::snapshot(PINDICIUM_DISPLAY_STATISTICS values, size_t capacity)
+{
+	size_t order[MaxPresenters];
+	size_t count = 0;
+
+	AcquireSRWLockShared(&published_lock_);
+
+	for (size_t i = 0; i < MaxPresenters; i++)
+	{
+		if (published_[i].Presenter)
+			order[count++] = i;
+	}
+
+	//
+	// Most recently presenting first
+	//
+	std::sort(order, order + count, [this](size_t a, size_t b) { return recency_[a] > recency_[b]; });
+
+	for (size_t i = 0; i < count && i < capacity; i++)
+		values[i] = published_[order[i]];
+
+	ReleaseSRWLockShared(&published_lock_);
+
+	return count;
+}
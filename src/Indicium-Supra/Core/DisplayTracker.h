@@ -0,0 +1,169 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumFrameStatistics.h"
+
+#include <atomic>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            /**
+             * \brief   Reconciles the presentation statistics of the runtime with the Presents seen
+             *          by the hooks, per swap chain or Direct3D 9Ex device.
+             *
+             *          All queries happen on the render thread right after Present, while the
+             *          presenter is guaranteed to be alive. Results are published to readers
+             *          with a try-lock, a reader holding the lock only delays publishing by a frame.
+             */
+            class DisplayTracker
+            {
+            public:
+                static const size_t MaxPresenters = 8;
+
+                //
+                // Present identifiers remembered to match against the displayed one
+                //
+                static const size_t PendingPresents = 64;
+
+                /**
+                 * \brief   Parties which started tracking; it stays active until all of them stopped.
+                 */
+                enum Owner : UINT32
+                {
+                    OwnerApi = 0x1,
+                    OwnerPacing = 0x2
+                };
+
+                /**
+                 * \brief   Presentation statistics common to DXGI and Direct3D 9Ex.
+                 */
+                struct Sample
+                {
+                    UINT present_count;
+                    UINT sync_refresh_count;
+                    LONGLONG sync_qpc;
+                };
+
+            private:
+                struct Pending
+                {
+                    UINT id;
+                    LONGLONG qpc;
+                };
+
+                struct Slot
+                {
+                    PVOID presenter;
+                    LONGLONG last_seen;
+                    UINT32 until_query;
+
+                    Pending pending[PendingPresents];
+                    size_t pending_next;
+                    UINT last_present_id;
+
+                    bool have_previous;
+                    Sample previous;
+
+                    LONGLONG displayed_ticks;
+                    ULONGLONG displayed_intervals;
+                    LONGLONG latency_ticks;
+                    ULONGLONG latency_samples;
+
+                    INDICIUM_DISPLAY_STATISTICS stats;
+                };
+
+                std::atomic<bool> active_;
+                std::atomic<bool> restart_;
+                std::atomic<UINT32> interval_;
+
+                //
+                // Owners and the interval asked for through the API; guarded by the engine's
+                // subsystem lock
+                //
+                UINT32 owners_;
+                UINT32 requested_interval_;
+
+                void apply_owners();
+
+                //
+                // Render thread; serializes the rare case of two threads presenting at once
+                //
+                std::atomic_flag writing_ = ATOMIC_FLAG_INIT;
+                Slot slots_[MaxPresenters];
+                double ticks_per_ms_;
+
+                //
+                // Copies handed out to readers; guarded by published_lock_
+                //
+                SRWLOCK published_lock_;
+                INDICIUM_DISPLAY_STATISTICS published_[MaxPresenters];
+                LONGLONG recency_[MaxPresenters];
+
+                Slot& slot_for(PVOID presenter);
+                void reconcile(Slot& slot, const Sample& sample);
+
+            public:
+                DisplayTracker();
+
+                DisplayTracker(const DisplayTracker&) = delete;
+                DisplayTracker& operator=(const DisplayTracker&) = delete;
+
+                /**
+                 * \brief   Starts tracking for owner; pacing always queries every frame, the API
+                 *          every interval frames.
+                 */
+                void start(Owner owner, UINT32 interval);
+
+                void stop(Owner owner);
+
+                bool is_active() const
+                {
+                    return active_.load(std::memory_order_relaxed);
+                }
+
+                /**
+                 * \brief   Records a Present and queries the statistics when due; render thread only.
+                 */
+                void on_present(INDICIUM_D3D_VERSION version, PVOID presenter);
+
+                /**
+                 * \brief   Latest Present to display latency and displayed frame time of a presenter
+                 *          in milliseconds, left untouched if unknown; render thread only.
+                 */
+                bool latest(PVOID presenter, double* latency_ms, double* interval_ms);
+
+                size_t snapshot(PINDICIUM_DISPLAY_STATISTICS values, size_t capacity);
+            };
+        };
+    };
+};
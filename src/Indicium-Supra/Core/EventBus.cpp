@@ -0,0 +1,323 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "EventBus.h"
+
+#include <cstdio>
+#include <cstring>
+#include <new>
+
+static ULONGLONG RoundUpPowerOfTwo(ULONGLONG value)
+{
+	ULONGLONG result = 2;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
+
+Indicium::Core::Bus::Topic::Topic(LPCSTR name, SIZE_T message_size, UINT32 capacity) :
+	name_(name),
+	message_size_(message_size),
+	stride_((sizeof(SlotHeader) + message_size + 63) & ~static_cast<SIZE_T>(63)),
+	mask_(RoundUpPowerOfTwo(capacity ? capacity : 256) - 1),
+	tail_(0),
+	subscribers_(nullptr)
+{
+	storage_.reset(new BYTE[stride_ * (mask_ + 1)]);
+
+	//
+	// Sequence 0 marks a slot as never written
+	//
+	for (ULONGLONG i = 0; i <= mask_; i++)
+	{
+		new (slot_at(i)) SlotHeader{ {0}, 0 };
+	}
+
+	lists_.push_back(std::make_unique<Subscribers>());
+	subscribers_.store(lists_.back().get(), std::memory_order_release);
+}
+
+Indicium::Core::Bus::Topic::~Topic() = default;
+
+Indicium::Core::Bus::Topic::SlotHeader* Indicium::Core::Bus::Topic::slot_at(ULONGLONG sequence) const
+{
+	return reinterpret_cast<SlotHeader*>(storage_.get() + stride_ * (sequence & mask_));
+}
+
+void Indicium::Core::Bus::Topic::replace_subscribers(std::unique_ptr<Subscribers> list)
+{
+	subscribers_.store(list.get(), std::memory_order_release);
+	lists_.push_back(std::move(list));
+}
+
+INDICIUM_ERROR Indicium::Core::Bus::Topic::publish(const VOID* message, SIZE_T size)
+{
+	if (size > message_size_)
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+
+	const auto list = subscribers_.load(std::memory_order_acquire);
+
+	if (!list->deferred.empty())
+	{
+		auto tail = tail_.load(std::memory_order_relaxed);
+
+		do
+		{
+			//
+			// Back-pressure: the slot about to be reused must be consumed by every deferred subscriber
+			//
+			for (const auto subscription : list->deferred)
+			{
+				if (tail - subscription->cursor.load(std::memory_order_acquire) > mask_)
+				{
+					rejected_.add();
+					return INDICIUM_ERROR_BUS_TOPIC_FULL;
+				}
+			}
+		} while (!tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_acq_rel, std::memory_order_relaxed));
+
+		const auto slot = slot_at(tail);
+
+		memcpy(reinterpret_cast<BYTE*>(slot + 1), message, size);
+		slot->size = size;
+		slot->sequence.store(tail + 1, std::memory_order_release);
+	}
+
+	published_.add();
+
+	for (const auto subscription : list->inline_)
+	{
+		subscription->callback(reinterpret_cast<PINDICIUM_BUS_TOPIC>(this), message, size, subscription->context);
+	}
+
+	if (!list->inline_.empty())
+		delivered_inline_.add(list->inline_.size());
+
+	return INDICIUM_ERROR_NONE;
+}
+
+Indicium::Core::Bus::Subscription* Indicium::Core::Bus::Topic::subscribe(
+	PFN_INDICIUM_BUS_MESSAGE callback,
+	PVOID context,
+	INDICIUM_BUS_DELIVERY delivery
+)
+{
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	auto subscription = std::make_unique<Subscription>();
+	subscription->topic = this;
+	subscription->callback = callback;
+	subscription->context = context;
+	subscription->delivery = delivery;
+	subscription->cursor.store(tail_.load(std::memory_order_acquire), std::memory_order_relaxed);
+
+	auto list = std::make_unique<Subscribers>(*subscribers_.load(std::memory_order_relaxed));
+
+	if (delivery == IndiciumBusDeliveryInline)
+		list->inline_.push_back(subscription.get());
+	else
+		list->deferred.push_back(subscription.get());
+
+	subscriptions_.push_back(std::move(subscription));
+	replace_subscribers(std::move(list));
+
+	return subscriptions_.back().get();
+}
+
+void Indicium::Core::Bus::Topic::unsubscribe(Subscription* subscription)
+{
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	auto list = std::make_unique<Subscribers>(*subscribers_.load(std::memory_order_relaxed));
+
+	for (auto subscribers : { &list->inline_, &list->deferred })
+	{
+		for (auto it = subscribers->begin(); it != subscribers->end(); ++it)
+		{
+			if (*it == subscription)
+			{
+				subscribers->erase(it);
+				break;
+			}
+		}
+	}
+
+	replace_subscribers(std::move(list));
+}
+
+void Indicium::Core::Bus::Topic::drain()
+{
+	const auto list = subscribers_.load(std::memory_order_acquire);
+
+	for (const auto subscription : list->deferred)
+	{
+		auto cursor = subscription->cursor.load(std::memory_order_relaxed);
+		const auto tail = tail_.load(std::memory_order_acquire);
+		ULONGLONG delivered = 0;
+
+		while (cursor != tail)
+		{
+			const auto slot = slot_at(cursor);
+
+			//
+			// Claimed but not yet written; keep ordering and pick it up next frame
+			//
+			if (slot->sequence.load(std::memory_order_acquire) != cursor + 1)
+				break;
+
+			subscription->callback(
+				reinterpret_cast<PINDICIUM_BUS_TOPIC>(this),
+				reinterpret_cast<const BYTE*>(slot + 1),
+				slot->size,
+				subscription->context
+			);
+
+			cursor++;
+			delivered++;
+		}
+
+		if (delivered)
+		{
+			subscription->cursor.store(cursor, std::memory_order_release);
+			delivered_deferred_.add(delivered);
+		}
+	}
+}
+
+void Indicium::Core::Bus::Topic::statistics(PINDICIUM_BUS_TOPIC_STATISTICS stats) const
+{
+	const auto list = subscribers_.load(std::memory_order_acquire);
+	const auto tail = tail_.load(std::memory_order_acquire);
+	ULONGLONG backlog = 0;
+
+	for (const auto subscription : list->deferred)
+	{
+		const auto pending = tail - subscription->cursor.load(std::memory_order_acquire);
+
+		if (pending > backlog)
+			backlog = pending;
+	}
+
+	stats->Published = published_.load();
+	stats->Rejected = rejected_.load();
+	stats->DeliveredInline = delivered_inline_.load();
+	stats->DeliveredDeferred = delivered_deferred_.load();
+	stats->Backlog = static_cast<UINT32>(backlog);
+	stats->Capacity = static_cast<UINT32>(mask_ + 1);
+}
+
+void Indicium::Core::Bus::Topic::register_counters(Stats::CounterRegistry& registry)
+{
+	const struct
+	{
+		LPCSTR suffix;
+		Util::ShardedCounter& counter;
+	} counters[] = {
+		{ "published", published_ },
+		{ "rejected", rejected_ },
+		{ "delivered_inline", delivered_inline_ },
+		{ "delivered_deferred", delivered_deferred_ }
+	};
+
+	//
+	// Topics with overly long names simply don't show up in the snapshot
+	//
+	for (const auto& entry : counters)
+	{
+		CHAR name[INDICIUM_COUNTER_NAME_LENGTH];
+
+		if (_snprintf_s(name, _TRUNCATE, "bus.%s.%s", name_.c_str(), entry.suffix) >= 0)
+			registry.attach(name, entry.counter);
+	}
+}
+
+Indicium::Core::Bus::EventBus::EventBus(Stats::CounterRegistry& counters) : count_(0), counters_(counters)
+{
+	for (auto& topic : topics_)
+	{
+		topic.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+Indicium::Core::Bus::EventBus::~EventBus()
+{
+	for (auto& topic : topics_)
+	{
+		delete topic.load(std::memory_order_relaxed);
+	}
+}
+
+INDICIUM_ERROR Indicium::Core::Bus::EventBus::open(LPCSTR name, SIZE_T message_size, UINT32 capacity, Topic** topic)
+{
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	const auto count = count_.load(std::memory_order_relaxed);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto existing = topics_[i].load(std::memory_order_relaxed);
+
+		if (existing->name() != name)
+			continue;
+
+		if (existing->message_size() != message_size)
+			return INDICIUM_ERROR_BUS_TOPIC_MISMATCH;
+
+		*topic = existing;
+		return INDICIUM_ERROR_NONE;
+	}
+
+	if (count == MaxTopics)
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+
+	try
+	{
+		*topic = new Topic(name, message_size, capacity);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	//
+	// Publish slot before the count so the render thread never sees an empty slot
+	//
+	topics_[count].store(*topic, std::memory_order_release);
+	count_.store(count + 1, std::memory_order_release);
+
+	(*topic)->register_counters(counters_);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Bus::EventBus::drain()
+{
+	const auto count = count_.load(std::memory_order_acquire);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		topics_[i].load(std::memory_order_acquire)->drain();
+	}
+}
@@ -0,0 +1,166 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumEventBus.h"
+
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Bus
+        {
+            class Topic;
+
+            struct Subscription
+            {
+                Topic* topic;
+                PFN_INDICIUM_BUS_MESSAGE callback;
+                PVOID context;
+                INDICIUM_BUS_DELIVERY delivery;
+
+                //
+                // Next sequence to deliver; written by the render thread only
+                //
+                alignas(64) std::atomic<ULONGLONG> cursor{ 0 };
+            };
+
+            /**
+             * \brief   Broadcast ring of fixed-size message slots. Any number of threads may publish
+             *          (slots are claimed with a CAS on the tail sequence), each deferred
+             *          subscriber owns a read cursor advanced on the render thread.
+             *
+             *          Publishers never overwrite a slot the slowest deferred subscriber hasn't
+             *          consumed yet; such messages are refused and counted as rejected instead.
+             *          The subscriber list is copy-on-write so publishing and draining never lock.
+             */
+            class Topic
+            {
+                struct SlotHeader
+                {
+                    std::atomic<ULONGLONG> sequence;
+                    SIZE_T size;
+                };
+
+                struct Subscribers
+                {
+                    std::vector<Subscription*> inline_;
+                    std::vector<Subscription*> deferred;
+                };
+
+                std::string name_;
+                SIZE_T message_size_;
+                SIZE_T stride_;
+                ULONGLONG mask_;
+                std::unique_ptr<BYTE[]> storage_;
+
+                alignas(64) std::atomic<ULONGLONG> tail_;
+
+                Util::ShardedCounter published_;
+                Util::ShardedCounter rejected_;
+                Util::ShardedCounter delivered_inline_;
+                Util::ShardedCounter delivered_deferred_;
+
+                std::atomic<Subscribers*> subscribers_;
+
+                //
+                // Writer side; replaced lists and cancelled subscriptions stay alive until the
+                // topic gets destroyed since readers might still hold them
+                //
+                std::mutex writer_lock_;
+                std::vector<std::unique_ptr<Subscribers>> lists_;
+                std::vector<std::unique_ptr<Subscription>> subscriptions_;
+
+                SlotHeader* slot_at(ULONGLONG sequence) const;
+                void replace_subscribers(std::unique_ptr<Subscribers> list);
+
+            public:
+                Topic(LPCSTR name, SIZE_T message_size, UINT32 capacity);
+                ~Topic();
+
+                Topic(const Topic&) = delete;
+                Topic& operator=(const Topic&) = delete;
+
+                const std::string& name() const { return name_; }
+                SIZE_T message_size() const { return message_size_; }
+
+                INDICIUM_ERROR publish(const VOID* message, SIZE_T size);
+
+                Subscription* subscribe(PFN_INDICIUM_BUS_MESSAGE callback, PVOID context, INDICIUM_BUS_DELIVERY delivery);
+
+                void unsubscribe(Subscription* subscription);
+
+                /**
+                 * \brief   Delivers queued messages to deferred subscribers; render thread only.
+                 */
+                void drain();
+
+                void statistics(PINDICIUM_BUS_TOPIC_STATISTICS stats) const;
+
+                void register_counters(Stats::CounterRegistry& registry);
+            };
+
+            /**
+             * \brief   Registry of topics owned by an engine. Topics live as long as the engine.
+             */
+            class EventBus
+            {
+            public:
+                static const size_t MaxTopics = 64;
+
+            private:
+                std::atomic<Topic*> topics_[MaxTopics];
+                std::atomic<size_t> count_;
+                std::mutex writer_lock_;
+
+                Stats::CounterRegistry& counters_;
+
+            public:
+                explicit EventBus(Stats::CounterRegistry& counters);
+                ~EventBus();
+
+                EventBus(const EventBus&) = delete;
+                EventBus& operator=(const EventBus&) = delete;
+
+                INDICIUM_ERROR open(LPCSTR name, SIZE_T message_size, UINT32 capacity, Topic** topic);
+
+                void drain();
+            };
+        };
+    };
+};
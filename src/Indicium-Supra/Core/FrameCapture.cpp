@@ -0,0 +1,480 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "FrameCapture.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+	//
+	// Presenter not seen for this long gets its slot and resources taken over
+	//
+	const LONGLONG AbandonMs = 1000;
+
+	const INDICIUM_CAPTURE_REGION FullFrame = { 0.0f, 0.0f, 1.0f, 1.0f };
+
+	LONGLONG Now()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	//
+	// Pixel rectangle of a region, at least one pixel and never beyond the back buffer
+	//
+	Indicium::Core::Capture::Rect ToPixels(
+		const INDICIUM_CAPTURE_REGION& region,
+		const Indicium::Core::Capture::BackBuffer& back_buffer
+	)
+	{
+		Indicium::Core::Capture::Rect rect;
+
+		rect.left = (std::min)(static_cast<UINT32>(std::floor(region.Left * back_buffer.width)), back_buffer.width - 1);
+		rect.top = (std::min)(static_cast<UINT32>(std::floor(region.Top * back_buffer.height)), back_buffer.height - 1);
+		rect.width = static_cast<UINT32>(std::lround(region.Width * back_buffer.width));
+		rect.height = static_cast<UINT32>(std::lround(region.Height * back_buffer.height));
+
+		rect.width = (std::max)((std::min)(rect.width, back_buffer.width - rect.left), 1u);
+		rect.height = (std::max)((std::min)(rect.height, back_buffer.height - rect.top), 1u);
+
+		return rect;
+	}
+}
+
+Indicium::Core::Capture::FrameCapture::FrameCapture(Stats::CounterRegistry& counters) :
+	generation_(1),
+	active_(false),
+	current_generation_(0)
+{
+	INDICIUM_CAPTURE_CONFIG_INIT(&config_, nullptr, nullptr);
+	current_ = config_;
+
+	for (auto& state : states_)
+	{
+		state.presenter = nullptr;
+		state.version = IndiciumDirect3DVersionUnknown;
+		state.last_seen = 0;
+		state.frame = 0;
+		state.until_capture = 0;
+		state.generation = 0;
+		state.region_count = 0;
+		ZeroMemory(state.targets, sizeof(state.targets));
+	}
+
+	counters.attach("capture.regions_copied", copied_);
+	counters.attach("capture.regions_delivered", delivered_);
+	counters.attach("capture.regions_dropped", dropped_);
+	counters.attach("capture.bytes_read", bytes_read_);
+}
+
+Indicium::Core::Capture::FrameCapture::~FrameCapture()
+{
+	//
+	// Staging resources hold their own device reference, releasing them is safe at any time
+	//
+	for (auto& state : states_)
+		release(state);
+}
+
+void Indicium::Core::Capture::FrameCapture::start(const INDICIUM_CAPTURE_CONFIG& config)
+{
+	{
+		std::lock_guard<std::mutex> guard(config_lock_);
+		config_ = config;
+	}
+
+	generation_.fetch_add(1, std::memory_order_release);
+	active_.store(true, std::memory_order_release);
+}
+
+void Indicium::Core::Capture::FrameCapture::stop()
+{
+	active_.store(false, std::memory_order_release);
+}
+
+bool Indicium::Core::Capture::FrameCapture::set_regions(
+	PVOID presenter,
+	const INDICIUM_CAPTURE_REGION* regions,
+	size_t count
+)
+{
+	if (count > MaxRegions || (!regions && count))
+		return false;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& region = regions[i];
+
+		//
+		// Fractions may carry rounding errors, the pixel rectangle gets clamped anyway
+		//
+		if (region.Left < 0.0f || region.Top < 0.0f || region.Width <= 0.0f || region.Height <= 0.0f
+			|| region.Left + region.Width > 1.001f || region.Top + region.Height > 1.001f)
+			return false;
+	}
+
+	std::lock_guard<std::mutex> guard(config_lock_);
+
+	const auto it = std::find_if(region_sets_.begin(), region_sets_.end(),
+		[presenter](const RegionSet& set) { return set.presenter == presenter; });
+
+	if (count == 0)
+	{
+		if (it != region_sets_.end())
+			region_sets_.erase(it);
+	}
+	else
+	{
+		RegionSet set;
+		set.presenter = presenter;
+		set.count = count;
+		std::copy(regions, regions + count, set.regions);
+
+		if (it != region_sets_.end())
+			*it = set;
+		else
+			region_sets_.push_back(set);
+	}
+
+	generation_.fetch_add(1, std::memory_order_release);
+
+	return true;
+}
+
+void Indicium::Core::Capture::FrameCapture::release(PresenterState& state)
+{
+	if (state.device)
+	{
+		for (auto& target : state.targets)
+		{
+			for (auto& staged : target.ring)
+				staged.pending = false;
+
+			target.next = target.read = 0;
+		}
+
+		state.device->reset();
+	}
+}
+
+Indicium::Core::Capture::FrameCapture::PresenterState* Indicium::Core::Capture::FrameCapture::state_for(
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter
+)
+{
+	const auto now = Now();
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	PresenterState* oldest = nullptr;
+
+	for (auto& state : states_)
+	{
+		if (state.presenter == presenter && state.version == version)
+			return &state;
+
+		if (!oldest || state.last_seen < oldest->last_seen)
+			oldest = &state;
+	}
+
+	if (oldest->presenter && now - oldest->last_seen < AbandonMs * frequency.QuadPart / 1000)
+		return nullptr;
+
+	release(*oldest);
+
+	Memory::Scope scope(IndiciumMemoryTagCapture);
+
+	CaptureDevice* device = nullptr;
+
+	switch (version)
+	{
+#ifndef INDICIUM_NO_D3D9
+	case IndiciumDirect3DVersion9:
+		device = CreateD3D9CaptureDevice();
+		break;
+#endif
+#ifndef INDICIUM_NO_D3D10
+	case IndiciumDirect3DVersion10:
+		device = CreateD3D10CaptureDevice();
+		break;
+#endif
+#ifndef INDICIUM_NO_D3D11
+	case IndiciumDirect3DVersion11:
+		device = CreateD3D11CaptureDevice();
+		break;
+#endif
+	default:
+		break;
+	}
+
+	if (!device)
+		return nullptr;
+
+	oldest->device.reset(device);
+	oldest->presenter = presenter;
+	oldest->version = version;
+	oldest->frame = 0;
+	oldest->until_capture = 0;
+	oldest->generation = 0;
+
+	return oldest;
+}
+
+void Indicium::Core::Capture::FrameCapture::refresh_regions(PresenterState& state)
+{
+	const auto generation = generation_.load(std::memory_order_acquire);
+
+	if (state.generation == generation)
+		return;
+
+	{
+		std::lock_guard<std::mutex> guard(config_lock_);
+
+		if (current_generation_ != generation)
+		{
+			current_ = config_;
+			current_generation_ = generation;
+		}
+
+		const RegionSet* match = nullptr;
+
+		for (const auto& set : region_sets_)
+		{
+			if (set.presenter == state.presenter)
+			{
+				match = &set;
+				break;
+			}
+
+			if (set.presenter == nullptr)
+				match = &set;
+		}
+
+		state.region_count = match ? match->count : 1;
+		std::copy(match ? match->regions : &FullFrame, (match ? match->regions : &FullFrame) + state.region_count, state.regions);
+	}
+
+	//
+	// Copies in flight belong to the old regions, delivering them would mislabel them
+	//
+	release(state);
+
+	state.generation = generation;
+}
+
+void Indicium::Core::Capture::FrameCapture::read_back(PINDICIUM_ENGINE engine, PresenterState& state)
+{
+	const auto depth = (std::min)((std::max)(current_.Depth, 1u), static_cast<UINT32>(MaxDepth));
+
+	for (size_t region = 0; region < state.region_count; region++)
+	{
+		auto& target = state.targets[region];
+
+		while (target.ring[target.read].pending)
+		{
+			auto& staged = target.ring[target.read];
+			const auto slot = region * MaxDepth + target.read;
+
+			const BYTE* data = nullptr;
+			UINT32 pitch = 0;
+			const auto read = state.device->map(slot, &data, &pitch);
+
+			if (read == ReadState::pending)
+				break;
+
+			if (read == ReadState::ready)
+			{
+				INDICIUM_CAPTURED_FRAME frame;
+
+				frame.Engine = engine;
+				frame.Presenter = state.presenter;
+				frame.Version = state.version;
+				frame.Region = static_cast<UINT32>(region);
+				frame.FrameNumber = staged.frame;
+				frame.Timestamp = staged.timestamp;
+				frame.BackBufferWidth = staged.back_buffer.width;
+				frame.BackBufferHeight = staged.back_buffer.height;
+				frame.Left = staged.rect.left;
+				frame.Top = staged.rect.top;
+				frame.Width = staged.rect.width;
+				frame.Height = staged.rect.height;
+				frame.Format = staged.back_buffer.format;
+				frame.Pitch = pitch;
+				frame.Data = data;
+
+				const auto callback = current_.EvtIndiciumFrameCaptured;
+
+				if (callback)
+					callback(&frame, current_.Context);
+
+				//
+				// Consumers get their own copy, the staging resource is only mapped until below
+				//
+				if (pool_.has_consumers())
+					pool_.publish(frame, static_cast<size_t>(pitch) * staged.rect.height);
+
+				state.device->unmap(slot);
+
+				delivered_.add();
+				bytes_read_.add(static_cast<uint64_t>(pitch) * staged.rect.height);
+			}
+			else
+			{
+				dropped_.add();
+			}
+
+			staged.pending = false;
+			target.read = (target.read + 1) % depth;
+		}
+	}
+}
+
+void Indicium::Core::Capture::FrameCapture::copy_regions(PresenterState& state)
+{
+	const auto depth = (std::min)((std::max)(current_.Depth, 1u), static_cast<UINT32>(MaxDepth));
+
+	BackBuffer back_buffer;
+
+	if (!state.device->begin(state.presenter, &back_buffer))
+	{
+		dropped_.add(state.region_count);
+		return;
+	}
+
+	const auto timestamp = Now();
+
+	for (size_t region = 0; region < state.region_count; region++)
+	{
+		auto& target = state.targets[region];
+		auto& staged = target.ring[target.next];
+
+		//
+		// Ring full, the GPU or the callback is falling behind
+		//
+		if (staged.pending)
+		{
+			dropped_.add();
+			continue;
+		}
+
+		const auto rect = ToPixels(state.regions[region], back_buffer);
+
+		if (!state.device->copy(region * MaxDepth + target.next, rect))
+		{
+			dropped_.add();
+			continue;
+		}
+
+		staged.pending = true;
+		staged.frame = state.frame;
+		staged.timestamp = timestamp;
+		staged.rect = rect;
+		staged.back_buffer = back_buffer;
+
+		target.next = (target.next + 1) % depth;
+
+		copied_.add();
+	}
+
+	state.device->end();
+}
+
+void Indicium::Core::Capture::FrameCapture::on_present(
+	PINDICIUM_ENGINE engine,
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter
+)
+{
+	const auto active = active_.load(std::memory_order_acquire);
+
+	//
+	// Never block a render thread on another one; it goes uncaptured for this frame
+	//
+	if (capturing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	if (!active)
+	{
+		//
+		// Resources only get released from a render thread after stopping
+		//
+		for (auto& state : states_)
+		{
+			if (state.presenter == presenter)
+			{
+				release(state);
+				state.device.reset();
+				state.presenter = nullptr;
+			}
+		}
+
+		capturing_.clear(std::memory_order_release);
+		return;
+	}
+
+	const auto state = state_for(version, presenter);
+
+	if (state)
+	{
+		state->last_seen = Now();
+
+		refresh_regions(*state);
+		read_back(engine, *state);
+
+		const auto wanted = current_.EvtIndiciumFrameCaptured || pool_.has_consumers();
+
+		if (state->until_capture == 0 && wanted)
+		{
+			copy_regions(*state);
+			state->frame++;
+		}
+
+		const auto interval = (std::max)(current_.IntervalFrames, 1u);
+		state->until_capture = state->until_capture ? state->until_capture - 1 : interval - 1;
+	}
+
+	capturing_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Capture::FrameCapture::on_resize(PVOID presenter)
+{
+	//
+	// Resizing must not proceed while a Present on another thread still copies from the chain
+	//
+	while (capturing_.test_and_set(std::memory_order_acquire))
+		YieldProcessor();
+
+	for (auto& state : states_)
+	{
+		if (state.presenter == presenter)
+			release(state);
+	}
+
+	capturing_.clear(std::memory_order_release);
+}
@@ -0,0 +1,226 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumCapture.h"
+
+#include "Counters.h"
+#include "FramePool.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Capture
+        {
+            struct Rect
+            {
+                UINT32 left;
+                UINT32 top;
+                UINT32 width;
+                UINT32 height;
+            };
+
+            struct BackBuffer
+            {
+                UINT32 width;
+                UINT32 height;
+                UINT32 format;
+            };
+
+            enum class ReadState
+            {
+                ready,
+                pending,
+                failed
+            };
+
+            /**
+             * \brief   Render API specific part of a capture. Copies back buffer regions into
+             *          staging slots on the GPU and maps them once the copy completed. Slots are
+             *          numbered by the caller and (re)created on demand at the size of the copy.
+             *
+             *          Render thread only; begin and end bracket all copies of one frame.
+             */
+            class CaptureDevice
+            {
+            public:
+                virtual ~CaptureDevice() = default;
+
+                /**
+                 * \brief   Acquires the current back buffer of the presenter.
+                 */
+                virtual bool begin(PVOID presenter, BackBuffer* back_buffer) = 0;
+
+                virtual bool copy(size_t slot, const Rect& rect) = 0;
+
+                /**
+                 * \brief   Releases the back buffer acquired by begin.
+                 */
+                virtual void end() = 0;
+
+                /**
+                 * \brief   Maps a slot without waiting for the GPU.
+                 */
+                virtual ReadState map(size_t slot, const BYTE** data, UINT32* pitch) = 0;
+
+                virtual void unmap(size_t slot) = 0;
+
+                /**
+                 * \brief   Releases all GPU resources, e.g. before the back buffers get resized.
+                 */
+                virtual void reset() = 0;
+            };
+
+            CaptureDevice* CreateD3D9CaptureDevice();
+            CaptureDevice* CreateD3D10CaptureDevice();
+            CaptureDevice* CreateD3D11CaptureDevice();
+
+            /**
+             * \brief   Captures regions of the back buffer through rings of staging resources per
+             *          presenter and region.
+             *
+             *          Everything happens on the render thread right before the original Present:
+             *          completed copies of earlier frames are read back and handed to the
+             *          callback and the consumers, then the regions of this frame get copied. A ring
+             *          which is still full drops the frame instead of stalling the render thread.
+             *          Nothing gets copied while nobody receives the frames.
+             */
+            class FrameCapture
+            {
+            public:
+                static const size_t MaxPresenters = 4;
+                static const size_t MaxRegions = INDICIUM_CAPTURE_MAX_REGIONS;
+                static const size_t MaxDepth = INDICIUM_CAPTURE_MAX_DEPTH;
+
+            private:
+                struct RegionSet
+                {
+                    PVOID presenter;
+                    INDICIUM_CAPTURE_REGION regions[MaxRegions];
+                    size_t count;
+                };
+
+                struct Staged
+                {
+                    bool pending;
+                    ULONGLONG frame;
+                    LONGLONG timestamp;
+                    Rect rect;
+                    BackBuffer back_buffer;
+                };
+
+                struct Target
+                {
+                    Staged ring[MaxDepth];
+                    size_t next;
+                    size_t read;
+                };
+
+                struct PresenterState
+                {
+                    PVOID presenter;
+                    INDICIUM_D3D_VERSION version;
+                    std::unique_ptr<CaptureDevice> device;
+                    LONGLONG last_seen;
+                    ULONGLONG frame;
+                    UINT32 until_capture;
+                    ULONG generation;
+                    INDICIUM_CAPTURE_REGION regions[MaxRegions];
+                    size_t region_count;
+                    Target targets[MaxRegions];
+                };
+
+                //
+                // Configuration and regions, written by API callers
+                //
+                std::mutex config_lock_;
+                INDICIUM_CAPTURE_CONFIG config_;
+                std::vector<RegionSet> region_sets_;
+                std::atomic<ULONG> generation_;
+                std::atomic<bool> active_;
+
+                //
+                // Render thread; serializes the rare case of two threads presenting at once
+                //
+                std::atomic_flag capturing_ = ATOMIC_FLAG_INIT;
+                INDICIUM_CAPTURE_CONFIG current_;
+                ULONG current_generation_;
+                PresenterState states_[MaxPresenters];
+
+                FramePool pool_;
+
+                Util::ShardedCounter copied_;
+                Util::ShardedCounter delivered_;
+                Util::ShardedCounter dropped_;
+                Util::ShardedCounter bytes_read_;
+
+                PresenterState* state_for(INDICIUM_D3D_VERSION version, PVOID presenter);
+                void release(PresenterState& state);
+                void refresh_regions(PresenterState& state);
+                void read_back(PINDICIUM_ENGINE engine, PresenterState& state);
+                void copy_regions(PresenterState& state);
+
+            public:
+                explicit FrameCapture(Stats::CounterRegistry& counters);
+                ~FrameCapture();
+
+                FrameCapture(const FrameCapture&) = delete;
+                FrameCapture& operator=(const FrameCapture&) = delete;
+
+                void start(const INDICIUM_CAPTURE_CONFIG& config);
+
+                void stop();
+
+                bool set_regions(PVOID presenter, const INDICIUM_CAPTURE_REGION* regions, size_t count);
+
+                FramePool& consumers()
+                {
+                    return pool_;
+                }
+
+                /**
+                 * \brief   Reads back and copies regions; render thread, right before the original
+                 *          Present.
+                 */
+                void on_present(PINDICIUM_ENGINE engine, INDICIUM_D3D_VERSION version, PVOID presenter);
+
+                /**
+                 * \brief   Drops the GPU resources of a presenter before its back buffers get resized
+                 *          or its device reset.
+                 */
+                void on_resize(PVOID presenter);
+            };
+        };
+    };
+};
@@ -0,0 +1,230 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "FrameOverhead.h"
+
+#include <intrin.h>
+
+#include <algorithm>
+
+namespace
+{
+	//
+	// Timestamps of the Present hook currently executing on this thread
+	//
+	thread_local UINT t_depth = 0;
+	thread_local ULONGLONG t_entry = 0;
+	thread_local ULONGLONG t_begin = 0;
+	thread_local ULONGLONG t_end = 0;
+}
+
+Indicium::Core::Stats::FrameOverhead::FrameOverhead()
+{
+	LARGE_INTEGER counter;
+	QueryPerformanceCounter(&counter);
+
+	tsc_origin_ = __rdtsc();
+	qpc_origin_ = counter.QuadPart;
+}
+
+void Indicium::Core::Stats::FrameOverhead::frame_enter()
+{
+	if (t_depth++ == 0) {
+		t_entry = __rdtsc();
+		t_begin = t_end = t_entry;
+	}
+}
+
+void Indicium::Core::Stats::FrameOverhead::present_begin()
+{
+	if (t_depth == 1) {
+		t_begin = __rdtsc();
+	}
+}
+
+void Indicium::Core::Stats::FrameOverhead::present_end()
+{
+	if (t_depth == 1) {
+		t_end = __rdtsc();
+	}
+}
+
+Indicium::Core::Stats::FrameOverhead::Slot& Indicium::Core::Stats::FrameOverhead::slot_for(PVOID presenter)
+{
+	Slot* oldest = &slots_[0];
+
+	for (auto& slot : slots_)
+	{
+		const auto owner = slot.presenter.load(std::memory_order_relaxed);
+
+		if (owner == presenter)
+			return slot;
+
+		if (owner == nullptr)
+			return slot;
+
+		if (slot.last_entry.load(std::memory_order_relaxed) < oldest->last_entry.load(std::memory_order_relaxed))
+			oldest = &slot;
+	}
+
+	return *oldest;
+}
+
+void Indicium::Core::Stats::FrameOverhead::frame_exit(INDICIUM_D3D_VERSION version, PVOID presenter)
+{
+	if (t_depth == 0 || --t_depth != 0)
+		return;
+
+	const auto exit = __rdtsc();
+
+	//
+	// Never block a render thread; another one presenting at the same time loses this frame
+	//
+	if (writing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	auto& slot = slot_for(presenter);
+	const auto sequence = slot.sequence.load(std::memory_order_relaxed);
+
+	slot.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	if (slot.presenter.load(std::memory_order_relaxed) != presenter)
+	{
+		slot.presenter.store(presenter, std::memory_order_relaxed);
+		slot.frames.store(0, std::memory_order_relaxed);
+		slot.engine_ticks.store(0, std::memory_order_relaxed);
+		slot.present_ticks.store(0, std::memory_order_relaxed);
+		slot.frame_ticks.store(0, std::memory_order_relaxed);
+		slot.last_entry.store(0, std::memory_order_relaxed);
+	}
+
+	const auto present = t_end - t_begin;
+	const auto engine = (exit - t_entry) - present;
+	const auto previous = slot.last_entry.load(std::memory_order_relaxed);
+
+	slot.version.store(version, std::memory_order_relaxed);
+	slot.last_engine.store(engine, std::memory_order_relaxed);
+	slot.last_present.store(present, std::memory_order_relaxed);
+	slot.last_entry.store(t_entry, std::memory_order_relaxed);
+
+	//
+	// Totals only cover frames with a known frame time, so the percentages stay consistent
+	//
+	if (previous)
+	{
+		const auto frame = t_entry - previous;
+
+		slot.last_frame.store(frame, std::memory_order_relaxed);
+		slot.frames.store(slot.frames.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		slot.engine_ticks.store(slot.engine_ticks.load(std::memory_order_relaxed) + engine, std::memory_order_relaxed);
+		slot.present_ticks.store(slot.present_ticks.load(std::memory_order_relaxed) + present, std::memory_order_relaxed);
+		slot.frame_ticks.store(slot.frame_ticks.load(std::memory_order_relaxed) + frame, std::memory_order_relaxed);
+	}
+
+	slot.sequence.store(sequence + 2, std::memory_order_release);
+
+	writing_.clear(std::memory_order_release);
+}
+
+size_t Indicium::Core::Stats::FrameOverhead::snapshot(PINDICIUM_FRAME_OVERHEAD values, size_t capacity) const
+{
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	const auto tsc = __rdtsc();
+	const auto elapsed_ms = (counter.QuadPart - qpc_origin_) * 1000.0 / frequency.QuadPart;
+	const auto ticks_per_ms = elapsed_ms > 0.0 ? (tsc - tsc_origin_) / elapsed_ms : 0.0;
+	const auto ms = [ticks_per_ms](ULONGLONG ticks) { return ticks_per_ms > 0.0 ? ticks / ticks_per_ms : 0.0; };
+
+	INDICIUM_FRAME_OVERHEAD all[MaxPresenters];
+	ULONGLONG recency[MaxPresenters];
+	size_t count = 0;
+
+	for (const auto& slot : slots_)
+	{
+		INDICIUM_FRAME_OVERHEAD value;
+		ULONGLONG last_entry, engine, present, frame, last_engine, last_present, last_frame;
+		ULONG before;
+
+		do
+		{
+			before = slot.sequence.load(std::memory_order_acquire);
+
+			if (before & 1)
+				continue;
+
+			ZeroMemory(&value, sizeof(INDICIUM_FRAME_OVERHEAD));
+			value.Presenter = slot.presenter.load(std::memory_order_relaxed);
+			value.Version = static_cast<INDICIUM_D3D_VERSION>(slot.version.load(std::memory_order_relaxed));
+			value.Frames = slot.frames.load(std::memory_order_relaxed);
+			engine = slot.engine_ticks.load(std::memory_order_relaxed);
+			present = slot.present_ticks.load(std::memory_order_relaxed);
+			frame = slot.frame_ticks.load(std::memory_order_relaxed);
+			last_engine = slot.last_engine.load(std::memory_order_relaxed);
+			last_present = slot.last_present.load(std::memory_order_relaxed);
+			last_frame = slot.last_frame.load(std::memory_order_relaxed);
+			last_entry = slot.last_entry.load(std::memory_order_relaxed);
+
+			std::atomic_thread_fence(std::memory_order_acquire);
+
+		} while ((before & 1) || slot.sequence.load(std::memory_order_relaxed) != before);
+
+		if (!value.Presenter)
+			continue;
+
+		value.LastEngineMs = ms(last_engine);
+		value.LastPresentMs = ms(last_present);
+		value.LastFrameMs = ms(last_frame);
+		value.EngineMs = ms(engine);
+		value.PresentMs = ms(present);
+		value.FrameMs = ms(frame);
+
+		if (frame)
+			value.EngineOfFramePercent = engine * 100.0 / frame;
+
+		if (engine + present)
+			value.EngineOfPresentPercent = engine * 100.0 / (engine + present);
+
+		all[count] = value;
+		recency[count] = last_entry;
+		count++;
+	}
+
+	//
+	// Most recently presenting first
+	//
+	size_t order[MaxPresenters];
+
+	for (size_t i = 0; i < count; i++)
+		order[i] = i;
+
+	std::sort(order, order + count, [&recency](size_t a, size_t b) { return recency[a] > recency[b]; });
+
+	for (size_t i = 0; i < count && i < capacity; i++)
+		values[i] = all[order[i]];
+
+	return count;
+}
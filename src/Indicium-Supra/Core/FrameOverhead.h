@@ -0,0 +1,113 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumFrameStatistics.h"
+
+#include <atomic>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            /**
+             * \brief   Splits every hooked Present into engine time and time spent in the original
+             *          Present, per swap chain or device. A frame costs four TSC reads on the
+             *          render thread; conversion to milliseconds happens when reading.
+             *
+             *          Slots are written by the presenting thread under a seqlock so readers on
+             *          other threads never block it. Once all slots are in use, the presenter
+             *          which presented least recently gets evicted.
+             */
+            class FrameOverhead
+            {
+            public:
+                static const size_t MaxPresenters = 8;
+
+            private:
+                struct alignas(64) Slot
+                {
+                    std::atomic<ULONG> sequence{ 0 };
+                    std::atomic<PVOID> presenter{ nullptr };
+                    std::atomic<INT> version{ IndiciumDirect3DVersionUnknown };
+                    std::atomic<ULONGLONG> frames{ 0 };
+                    std::atomic<ULONGLONG> engine_ticks{ 0 };
+                    std::atomic<ULONGLONG> present_ticks{ 0 };
+                    std::atomic<ULONGLONG> frame_ticks{ 0 };
+                    std::atomic<ULONGLONG> last_engine{ 0 };
+                    std::atomic<ULONGLONG> last_present{ 0 };
+                    std::atomic<ULONGLONG> last_frame{ 0 };
+                    std::atomic<ULONGLONG> last_entry{ 0 };
+                };
+
+                Slot slots_[MaxPresenters];
+
+                //
+                // Serializes writers in the rare case of two threads presenting at once
+                //
+                std::atomic_flag writing_ = ATOMIC_FLAG_INIT;
+
+                //
+                // Reference point to calibrate the TSC against the performance counter
+                //
+                ULONGLONG tsc_origin_;
+                LONGLONG qpc_origin_;
+
+                Slot& slot_for(PVOID presenter);
+
+            public:
+                FrameOverhead();
+
+                FrameOverhead(const FrameOverhead&) = delete;
+                FrameOverhead& operator=(const FrameOverhead&) = delete;
+
+                /**
+                 * \brief   Marks entry into a Present hook; nested Presents are attributed to the
+                 *          outermost one.
+                 */
+                static void frame_enter();
+
+                static void present_begin();
+
+                static void present_end();
+
+                /**
+                 * \brief   Marks leaving the Present hook and accounts the frame.
+                 */
+                void frame_exit(INDICIUM_D3D_VERSION version, PVOID presenter);
+
+                /**
+                 * \brief   Copies up to capacity presenters and returns the number tracked.
+                 */
+                size_t snapshot(PINDICIUM_FRAME_OVERHEAD values, size_t capacity) const;
+            };
+        };
+    };
+};
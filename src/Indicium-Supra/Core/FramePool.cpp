@@ -0,0 +1,333 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "FramePool.h"
+
+#include <bitset>
+#include <cstring>
+#include <new>
+
+namespace
+{
+	//
+	// Set while this thread hands out frames, consumers may remove themselves from their callback
+	//
+	thread_local bool t_delivering = false;
+
+	LONGLONG Now()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	UINT32 ReferenceMask(UINT32 count)
+	{
+		return count >= 32 ? 0xFFFFFFFF : (1u << count) - 1;
+	}
+}
+
+Indicium::Core::Capture::FramePool::FramePool() :
+	free_(nullptr),
+	active_(0),
+	delivering_(false)
+{
+	for (auto& consumer : consumers_)
+	{
+		consumer.pool = this;
+		consumer.state.store(_INDICIUM_CAPTURE_CONSUMER::Free, std::memory_order_relaxed);
+		consumer.callback = nullptr;
+		consumer.context = nullptr;
+		consumer.max_outstanding = 0;
+		consumer.free_references.store(0, std::memory_order_relaxed);
+
+		for (auto& reference : consumer.references)
+		{
+			reference.consumer = &consumer;
+			reference.buffer.store(nullptr, std::memory_order_relaxed);
+		}
+	}
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ticks_per_ms_ = frequency.QuadPart / 1000.0;
+}
+
+PINDICIUM_CAPTURE_CONSUMER Indicium::Core::Capture::FramePool::add(
+	PFN_INDICIUM_CAPTURE_CONSUMER_FRAME callback,
+	PVOID context,
+	UINT32 max_outstanding
+)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	for (auto& consumer : consumers_)
+	{
+		const auto state = consumer.state.load(std::memory_order_acquire);
+
+		//
+		// Removed consumers are only reused once they released every frame
+		//
+		if (state == _INDICIUM_CAPTURE_CONSUMER::Active
+			|| (state == _INDICIUM_CAPTURE_CONSUMER::Retiring
+				&& consumer.free_references.load(std::memory_order_acquire) != ReferenceMask(consumer.max_outstanding)))
+			continue;
+
+		consumer.callback = callback;
+		consumer.context = context;
+		consumer.max_outstanding = max_outstanding;
+		consumer.free_references.store(ReferenceMask(max_outstanding), std::memory_order_relaxed);
+		consumer.delivered.store(0, std::memory_order_relaxed);
+		consumer.dropped.store(0, std::memory_order_relaxed);
+		consumer.released.store(0, std::memory_order_relaxed);
+		consumer.lag_ticks.store(0, std::memory_order_relaxed);
+		consumer.last_lag_ticks.store(0, std::memory_order_relaxed);
+		consumer.max_lag_ticks.store(0, std::memory_order_relaxed);
+
+		consumer.state.store(_INDICIUM_CAPTURE_CONSUMER::Active, std::memory_order_release);
+		active_.fetch_add(1, std::memory_order_relaxed);
+
+		return &consumer;
+	}
+
+	return nullptr;
+}
+
+bool Indicium::Core::Capture::FramePool::remove(PINDICIUM_CAPTURE_CONSUMER consumer)
+{
+	auto expected = static_cast<int>(_INDICIUM_CAPTURE_CONSUMER::Active);
+
+	if (!consumer->state.compare_exchange_strong(expected, _INDICIUM_CAPTURE_CONSUMER::Retiring))
+		return false;
+
+	const auto pool = consumer->pool;
+	pool->active_.fetch_sub(1, std::memory_order_relaxed);
+
+	//
+	// The render thread checks the state after raising the flag, so once it's down again the
+	// callback won't be invoked anymore
+	//
+	if (!t_delivering)
+	{
+		while (pool->delivering_.load())
+			YieldProcessor();
+	}
+
+	return true;
+}
+
+Indicium::Core::Capture::FrameBuffer* Indicium::Core::Capture::FramePool::acquire(size_t size)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	FrameBuffer** link = &free_;
+
+	for (auto buffer = free_; buffer; buffer = buffer->next_free)
+	{
+		if (buffer->capacity >= size)
+		{
+			*link = buffer->next_free;
+			return buffer;
+		}
+
+		link = &buffer->next_free;
+	}
+
+	try
+	{
+		//
+		// Below the limit a new buffer gets added, above it a free one too small gets regrown
+		//
+		if (buffers_.size() < MaxBuffers)
+		{
+			std::unique_ptr<FrameBuffer> buffer(new FrameBuffer());
+
+			buffer->pool = this;
+			buffer->data.reset(new BYTE[size]);
+			buffer->capacity = size;
+			buffer->next_free = nullptr;
+
+			buffers_.push_back(std::move(buffer));
+
+			return buffers_.back().get();
+		}
+
+		if (free_)
+		{
+			const auto buffer = free_;
+
+			buffer->data.reset(new BYTE[size]);
+			buffer->capacity = size;
+			free_ = buffer->next_free;
+
+			return buffer;
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+	}
+
+	return nullptr;
+}
+
+void Indicium::Core::Capture::FramePool::recycle(FrameBuffer* buffer)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	buffer->next_free = free_;
+	free_ = buffer;
+}
+
+void Indicium::Core::Capture::FramePool::release_buffer(FrameBuffer* buffer)
+{
+	if (buffer->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		buffer->pool->recycle(buffer);
+}
+
+void Indicium::Core::Capture::FramePool::publish(const INDICIUM_CAPTURED_FRAME& frame, size_t size)
+{
+	delivering_.store(true);
+	t_delivering = true;
+
+	FrameBuffer* buffer = nullptr;
+
+	for (auto& consumer : consumers_)
+	{
+		if (consumer.state.load() != _INDICIUM_CAPTURE_CONSUMER::Active)
+			continue;
+
+		//
+		// Claim one of the consumer's free references before copying anything
+		//
+		auto free = consumer.free_references.load(std::memory_order_acquire);
+		UINT32 index = 0;
+
+		do
+		{
+			if (!free)
+				break;
+
+			index = 0;
+
+			while (!(free & (1u << index)))
+				index++;
+
+		} while (!consumer.free_references.compare_exchange_weak(free, free & ~(1u << index), std::memory_order_acq_rel));
+
+		if (!free)
+		{
+			consumer.dropped.fetch_add(1, std::memory_order_relaxed);
+			continue;
+		}
+
+		if (!buffer)
+		{
+			buffer = acquire(size);
+
+			if (!buffer)
+			{
+				consumer.free_references.fetch_or(1u << index, std::memory_order_release);
+				consumer.dropped.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+
+			//
+			// One reference for the pool while handing out, consumers releasing early can't
+			// recycle the buffer under the loop
+			//
+			buffer->references.store(1, std::memory_order_relaxed);
+			buffer->frame = frame;
+			buffer->frame.Data = buffer->data.get();
+
+			memcpy(buffer->data.get(), frame.Data, size);
+		}
+
+		auto& reference = consumer.references[index];
+
+		buffer->references.fetch_add(1, std::memory_order_relaxed);
+		reference.buffer.store(buffer, std::memory_order_release);
+
+		consumer.delivered.fetch_add(1, std::memory_order_relaxed);
+		consumer.callback(&reference, &buffer->frame, consumer.context);
+	}
+
+	t_delivering = false;
+	delivering_.store(false);
+
+	if (buffer)
+		release_buffer(buffer);
+}
+
+bool Indicium::Core::Capture::FramePool::release(PINDICIUM_CAPTURE_FRAME_REFERENCE reference)
+{
+	const auto buffer = reference->buffer.exchange(nullptr, std::memory_order_acq_rel);
+
+	//
+	// Released twice
+	//
+	if (!buffer)
+		return false;
+
+	const auto consumer = reference->consumer;
+	const auto lag = Now() - buffer->frame.Timestamp;
+
+	consumer->released.fetch_add(1, std::memory_order_relaxed);
+	consumer->lag_ticks.fetch_add(static_cast<ULONGLONG>(lag), std::memory_order_relaxed);
+	consumer->last_lag_ticks.store(lag, std::memory_order_relaxed);
+
+	auto max = consumer->max_lag_ticks.load(std::memory_order_relaxed);
+
+	while (lag > max && !consumer->max_lag_ticks.compare_exchange_weak(max, lag, std::memory_order_relaxed))
+	{
+	}
+
+	release_buffer(buffer);
+
+	const auto index = static_cast<UINT32>(reference - consumer->references);
+	consumer->free_references.fetch_or(1u << index, std::memory_order_release);
+
+	return true;
+}
+
+bool Indicium::Core::Capture::FramePool::statistics(
+	PINDICIUM_CAPTURE_CONSUMER consumer,
+	PINDICIUM_CAPTURE_CONSUMER_STATISTICS statistics
+)
+{
+	if (consumer->state.load(std::memory_order_acquire) == _INDICIUM_CAPTURE_CONSUMER::Free)
+		return false;
+
+	const auto ticks_per_ms = consumer->pool->ticks_per_ms_;
+	const auto held = ReferenceMask(consumer->max_outstanding) & ~consumer->free_references.load(std::memory_order_relaxed);
+	const auto released = consumer->released.load(std::memory_order_relaxed);
+
+	statistics->FramesDelivered = consumer->delivered.load(std::memory_order_relaxed);
+	statistics->FramesDropped = consumer->dropped.load(std::memory_order_relaxed);
+	statistics->FramesOutstanding = static_cast<UINT32>(std::bitset<32>(held).count());
+	statistics->LastLagMs = consumer->last_lag_ticks.load(std::memory_order_relaxed) / ticks_per_ms;
+	statistics->AverageLagMs = released ? static_cast<LONGLONG>(consumer->lag_ticks.load(std::memory_order_relaxed)) / ticks_per_ms / released : 0.0;
+	statistics->MaximumLagMs = consumer->max_lag_ticks.load(std::memory_order_relaxed) / ticks_per_ms;
+
+	return true;
+}
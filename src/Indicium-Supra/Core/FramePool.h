@@ -0,0 +1,174 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumCapture.h"
+
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Capture
+        {
+            class FramePool;
+
+            /**
+             * \brief   Pooled copy of one captured region, shared by all consumers.
+             */
+            struct FrameBuffer
+            {
+                FramePool* pool;
+                std::atomic<LONG> references;
+                INDICIUM_CAPTURED_FRAME frame;
+                std::unique_ptr<BYTE[]> data;
+                size_t capacity;
+                FrameBuffer* next_free;
+            };
+        };
+    };
+};
+
+//
+// A consumer's reference on a frame buffer; each consumer owns a fixed set of them
+//
+struct _INDICIUM_CAPTURE_FRAME_REFERENCE
+{
+    _INDICIUM_CAPTURE_CONSUMER* consumer;
+    std::atomic<Indicium::Core::Capture::FrameBuffer*> buffer;
+};
+
+struct _INDICIUM_CAPTURE_CONSUMER
+{
+    enum State
+    {
+        Free,
+        Active,
+        Retiring
+    };
+
+    Indicium::Core::Capture::FramePool* pool;
+    std::atomic<int> state;
+
+    PFN_INDICIUM_CAPTURE_CONSUMER_FRAME callback;
+    PVOID context;
+    UINT32 max_outstanding;
+
+    //
+    // Bit set for every reference not held by the consumer
+    //
+    std::atomic<UINT32> free_references;
+    _INDICIUM_CAPTURE_FRAME_REFERENCE references[INDICIUM_CAPTURE_MAX_OUTSTANDING];
+
+    //
+    // Delivered and dropped are only bumped by the render thread, released and lag by the
+    // consumer, once per frame each
+    //
+    std::atomic<ULONGLONG> delivered;
+    std::atomic<ULONGLONG> dropped;
+    std::atomic<ULONGLONG> released;
+    std::atomic<ULONGLONG> lag_ticks;
+    std::atomic<LONGLONG> last_lag_ticks;
+    std::atomic<LONGLONG> max_lag_ticks;
+};
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Capture
+        {
+            /**
+             * \brief   Fans captured regions out to any number of consumers with a single copy.
+             *
+             *          Buffers are reference counted: the pool holds one reference while handing
+             *          the buffer out and every consumer gets its own, which it releases whenever
+             *          it is done, from any thread. The last release puts the buffer back on the
+             *          free list. Consumers are limited in the frames they may hold, frames beyond
+             *          that are dropped for them only.
+             */
+            class FramePool
+            {
+            public:
+                static const size_t MaxConsumers = 16;
+                static const size_t MaxBuffers = 64;
+
+            private:
+                //
+                // Guards the free list and consumer registration
+                //
+                std::mutex lock_;
+                std::vector<std::unique_ptr<FrameBuffer>> buffers_;
+                FrameBuffer* free_;
+
+                _INDICIUM_CAPTURE_CONSUMER consumers_[MaxConsumers];
+                std::atomic<UINT32> active_;
+                std::atomic<bool> delivering_;
+                double ticks_per_ms_;
+
+                FrameBuffer* acquire(size_t size);
+                void recycle(FrameBuffer* buffer);
+                static void release_buffer(FrameBuffer* buffer);
+
+            public:
+                FramePool();
+
+                FramePool(const FramePool&) = delete;
+                FramePool& operator=(const FramePool&) = delete;
+
+                bool has_consumers() const
+                {
+                    return active_.load(std::memory_order_relaxed) != 0;
+                }
+
+                PINDICIUM_CAPTURE_CONSUMER add(
+                    PFN_INDICIUM_CAPTURE_CONSUMER_FRAME callback,
+                    PVOID context,
+                    UINT32 max_outstanding
+                );
+
+                static bool remove(PINDICIUM_CAPTURE_CONSUMER consumer);
+
+                /**
+                 * \brief   Copies a region into a pooled buffer and hands it to every consumer;
+                 *          render thread only.
+                 */
+                void publish(const INDICIUM_CAPTURED_FRAME& frame, size_t size);
+
+                static bool release(PINDICIUM_CAPTURE_FRAME_REFERENCE reference);
+
+                static bool statistics(PINDICIUM_CAPTURE_CONSUMER consumer, PINDICIUM_CAPTURE_CONSUMER_STATISTICS statistics);
+            };
+        };
+    };
+};
@@ -0,0 +1,596 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "InputReplay.h"
+#include "Memory.h"
+
+#include <cstdio>
+
+//
+// Inputs a frame or tick sends before the buffers have to grow
+//
+static const size_t ReservedInputs = 64;
+
+//
+// Raw Input button transitions and their SendInput counterparts
+//
+static const struct
+{
+	USHORT raw;
+	DWORD flag;
+	DWORD data;
+
+} MouseButtons[] = {
+	{ RI_MOUSE_LEFT_BUTTON_DOWN, MOUSEEVENTF_LEFTDOWN, 0 },
+	{ RI_MOUSE_LEFT_BUTTON_UP, MOUSEEVENTF_LEFTUP, 0 },
+	{ RI_MOUSE_RIGHT_BUTTON_DOWN, MOUSEEVENTF_RIGHTDOWN, 0 },
+	{ RI_MOUSE_RIGHT_BUTTON_UP, MOUSEEVENTF_RIGHTUP, 0 },
+	{ RI_MOUSE_MIDDLE_BUTTON_DOWN, MOUSEEVENTF_MIDDLEDOWN, 0 },
+	{ RI_MOUSE_MIDDLE_BUTTON_UP, MOUSEEVENTF_MIDDLEUP, 0 },
+	{ RI_MOUSE_BUTTON_4_DOWN, MOUSEEVENTF_XDOWN, XBUTTON1 },
+	{ RI_MOUSE_BUTTON_4_UP, MOUSEEVENTF_XUP, XBUTTON1 },
+	{ RI_MOUSE_BUTTON_5_DOWN, MOUSEEVENTF_XDOWN, XBUTTON2 },
+	{ RI_MOUSE_BUTTON_5_UP, MOUSEEVENTF_XUP, XBUTTON2 }
+};
+
+Indicium::Core::Input::InputReplay::InputReplay() :
+	state_(IndiciumInputReplayIdle),
+	injected_(0),
+	raw_input_(nullptr),
+	xinput_(nullptr),
+	overriding_(false)
+{
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	frequency_ = frequency.QuadPart;
+
+	ZeroMemory(pads_, sizeof(pads_));
+}
+
+Indicium::Core::Input::InputReplay::~InputReplay()
+{
+	detach();
+}
+
+int64_t Indicium::Core::Input::InputReplay::to_us(LONGLONG counter) const
+{
+	return counter / frequency_ * 1000000 + counter % frequency_ * 1000000 / frequency_;
+}
+
+int64_t Indicium::Core::Input::InputReplay::now_us() const
+{
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	return to_us(now.QuadPart);
+}
+
+void Indicium::Core::Input::InputReplay::detach()
+{
+	if (raw_input_)
+		raw_input_->attach(nullptr);
+
+	if (xinput_)
+		xinput_->attach(nullptr);
+
+	raw_input_ = nullptr;
+	xinput_ = nullptr;
+}
+
+INDICIUM_ERROR Indicium::Core::Input::InputReplay::record_start(RawInputBatcher* raw_input, XInputTracker* xinput)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		const auto state = state_.load();
+
+		if (state == IndiciumInputReplayRecording || state == IndiciumInputReplayReplaying)
+			return INDICIUM_ERROR_INPUT_REPLAY_BUSY;
+
+		const auto now = now_us();
+
+		recorder_.begin(now);
+		player_.reset();
+
+		//
+		// Only changes get recorded, start out with the controllers as they are
+		//
+		for (DWORD index = 0; xinput && index < XUSER_MAX_COUNT; index++)
+		{
+			INDICIUM_XINPUT_SNAPSHOT snapshot;
+			xinput->snapshot(index, &snapshot);
+
+			if (!snapshot.LastPoll)
+				continue;
+
+			Recorded input;
+			ZeroMemory(&input, sizeof(Recorded));
+
+			input.Source = SourceXInput;
+			input.UserIndex = index;
+			input.Connected = snapshot.Connected;
+			input.State = snapshot.State;
+
+			recorder_.add(now, input);
+		}
+
+		raw_input_ = raw_input;
+		xinput_ = xinput;
+
+		state_ = IndiciumInputReplayRecording;
+	}
+
+	//
+	// Sinks get called with the batcher locks released, attaching outside of ours is enough
+	//
+	if (raw_input)
+		raw_input->attach(this);
+
+	if (xinput)
+		xinput->attach(this);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_ERROR Indicium::Core::Input::InputReplay::record_stop(PCSTR path)
+{
+	if (state_.load() != IndiciumInputReplayRecording)
+		return INDICIUM_ERROR_NONE;
+
+	detach();
+
+	std::vector<uint8_t> blob;
+
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		timeline_ = recorder_.finish(now_us());
+		state_ = IndiciumInputReplayIdle;
+
+		if (!path)
+			return INDICIUM_ERROR_NONE;
+
+		blob = timeline_.save();
+	}
+
+	FILE* file = nullptr;
+
+	if (fopen_s(&file, path, "wb") || !file)
+		return INDICIUM_ERROR_FILE_WRITE_FAILED;
+
+	const auto written = fwrite(blob.data(), 1, blob.size(), file);
+
+	if (fclose(file) || written != blob.size())
+		return INDICIUM_ERROR_FILE_WRITE_FAILED;
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_ERROR Indicium::Core::Input::InputReplay::replay_start(
+	PCSTR path,
+	INDICIUM_INPUT_REPLAY_MODE mode,
+	XInputTracker* xinput
+)
+{
+	std::vector<uint8_t> blob;
+	FILE* file = nullptr;
+
+	if (fopen_s(&file, path, "rb") || !file)
+		return INDICIUM_ERROR_FILE_READ_FAILED;
+
+	uint8_t chunk[64 * 1024];
+	size_t read;
+
+	while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+		blob.insert(blob.end(), chunk, chunk + read);
+
+	const auto failed = ferror(file) != 0;
+	fclose(file);
+
+	if (failed)
+		return INDICIUM_ERROR_FILE_READ_FAILED;
+
+	std::lock_guard<std::mutex> guard(lock_);
+
+	const auto state = state_.load();
+
+	if (state == IndiciumInputReplayRecording || state == IndiciumInputReplayReplaying)
+		return INDICIUM_ERROR_INPUT_REPLAY_BUSY;
+
+	player_.reset();
+
+	if (!timeline_.load(blob.data(), blob.size()))
+		return INDICIUM_ERROR_UNSUPPORTED_FORMAT;
+
+	ZeroMemory(pads_, sizeof(pads_));
+
+	for (const auto& event : timeline_.events())
+	{
+		if (event.payload.Source == SourceXInput && event.payload.UserIndex < XUSER_MAX_COUNT)
+			pads_[event.payload.UserIndex].replayed = true;
+	}
+
+	//
+	// Controllers stay as the host saw them last until the first Present; packet numbers continue
+	// from there, so the first replayed state counts as new
+	//
+	for (DWORD index = 0; xinput && index < XUSER_MAX_COUNT; index++)
+	{
+		INDICIUM_XINPUT_SNAPSHOT snapshot;
+		xinput->snapshot(index, &snapshot);
+
+		pads_[index].connected = snapshot.Connected != FALSE;
+		pads_[index].state = snapshot.State;
+		pads_[index].packet = snapshot.State.dwPacketNumber;
+	}
+
+	player_.reset(new TimelinePlayer<Recorded>(timeline_, mode == IndiciumInputReplayTimed));
+	injected_ = 0;
+
+	//
+	// Rotates through the senders' buffers, after the first frames nothing gets reallocated
+	//
+	inputs_.reserve(ReservedInputs);
+
+	state_ = IndiciumInputReplayReplaying;
+	overriding_ = true;
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Input::InputReplay::replay_stop()
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	if (state_.load() != IndiciumInputReplayReplaying)
+		return;
+
+	overriding_ = false;
+	state_ = IndiciumInputReplayIdle;
+}
+
+void Indicium::Core::Input::InputReplay::on_raw_input(const INDICIUM_RAW_INPUT_EVENT* events, size_t count)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	if (state_.load(std::memory_order_relaxed) != IndiciumInputReplayRecording)
+		return;
+
+	Memory::Scope scope(IndiciumMemoryTagInput);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& event = events[i];
+
+		Recorded input;
+		ZeroMemory(&input, sizeof(Recorded));
+
+		switch (event.Type)
+		{
+		case IndiciumRawInputMouse:
+			input.Source = SourceMouse;
+			input.X = event.Mouse.X;
+			input.Y = event.Mouse.Y;
+			input.MouseFlags = event.Mouse.Flags;
+			input.ButtonFlags = event.Mouse.ButtonFlags;
+			input.ButtonData = event.Mouse.ButtonData;
+			break;
+		case IndiciumRawInputKeyboard:
+			input.Source = SourceKeyboard;
+			input.MakeCode = event.Keyboard.MakeCode;
+			input.KeyFlags = event.Keyboard.Flags;
+			input.VKey = event.Keyboard.VKey;
+			break;
+		default:
+			//
+			// No way to inject HID reports
+			//
+			continue;
+		}
+
+		recorder_.add(to_us(event.FirstTimestamp), input);
+	}
+}
+
+void Indicium::Core::Input::InputReplay::on_xinput(const INDICIUM_XINPUT_EVENT* events, size_t count)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	if (state_.load(std::memory_order_relaxed) != IndiciumInputReplayRecording)
+		return;
+
+	Memory::Scope scope(IndiciumMemoryTagInput);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const auto& event = events[i];
+
+		//
+		// Vibration is output of the host, it follows from the replayed input
+		//
+		if (event.Type == IndiciumXInputEventVibration)
+			continue;
+
+		Recorded input;
+		ZeroMemory(&input, sizeof(Recorded));
+
+		input.Source = SourceXInput;
+		input.UserIndex = event.UserIndex;
+		input.Connected = event.Type != IndiciumXInputEventDisconnected;
+
+		if (input.Connected)
+			input.State = event.State;
+
+		recorder_.add(to_us(event.Timestamp), input);
+	}
+}
+
+void Indicium::Core::Input::InputReplay::apply(const Recorded& input)
+{
+	INPUT injected;
+	ZeroMemory(&injected, sizeof(INPUT));
+
+	switch (input.Source)
+	{
+	case SourceMouse:
+	{
+		injected.type = INPUT_MOUSE;
+
+		const auto absolute = (input.MouseFlags & MOUSE_MOVE_ABSOLUTE) != 0;
+
+		if (input.X || input.Y || absolute)
+		{
+			injected.mi.dx = input.X;
+			injected.mi.dy = input.Y;
+			injected.mi.dwFlags = MOUSEEVENTF_MOVE
+				| (absolute ? MOUSEEVENTF_ABSOLUTE : 0)
+				| ((input.MouseFlags & MOUSE_VIRTUAL_DESKTOP) ? MOUSEEVENTF_VIRTUALDESK : 0);
+
+			inputs_.push_back(injected);
+		}
+
+		injected.mi.dx = 0;
+		injected.mi.dy = 0;
+
+		//
+		// One input per transition, X buttons and wheels share mouseData
+		//
+		for (const auto& button : MouseButtons)
+		{
+			if (!(input.ButtonFlags & button.raw))
+				continue;
+
+			injected.mi.dwFlags = button.flag;
+			injected.mi.mouseData = button.data;
+			inputs_.push_back(injected);
+		}
+
+		if (input.ButtonFlags & RI_MOUSE_WHEEL)
+		{
+			injected.mi.dwFlags = MOUSEEVENTF_WHEEL;
+			injected.mi.mouseData = static_cast<DWORD>(static_cast<SHORT>(input.ButtonData));
+			inputs_.push_back(injected);
+		}
+
+		if (input.ButtonFlags & RI_MOUSE_HWHEEL)
+		{
+			injected.mi.dwFlags = MOUSEEVENTF_HWHEEL;
+			injected.mi.mouseData = static_cast<DWORD>(static_cast<SHORT>(input.ButtonData));
+			inputs_.push_back(injected);
+		}
+
+		break;
+	}
+	case SourceKeyboard:
+	{
+		injected.type = INPUT_KEYBOARD;
+
+		//
+		// Scan codes reach DirectInput and games reading make codes; Pause and keys without a
+		// scan code go by virtual key
+		//
+		if (input.MakeCode && !(input.KeyFlags & RI_KEY_E1))
+		{
+			injected.ki.wScan = input.MakeCode;
+			injected.ki.dwFlags = KEYEVENTF_SCANCODE | ((input.KeyFlags & RI_KEY_E0) ? KEYEVENTF_EXTENDEDKEY : 0);
+		}
+		else
+		{
+			injected.ki.wVk = input.VKey;
+		}
+
+		if (input.KeyFlags & RI_KEY_BREAK)
+			injected.ki.dwFlags |= KEYEVENTF_KEYUP;
+
+		inputs_.push_back(injected);
+		break;
+	}
+	case SourceXInput:
+	{
+		if (input.UserIndex >= XUSER_MAX_COUNT)
+			break;
+
+		auto& pad = pads_[input.UserIndex];
+
+		pad.connected = input.Connected != 0;
+
+		if (pad.connected)
+		{
+			pad.state = input.State;
+			pad.state.dwPacketNumber = ++pad.packet;
+		}
+
+		break;
+	}
+	}
+
+	injected_++;
+}
+
+void Indicium::Core::Input::InputReplay::send(std::vector<INPUT>& inputs)
+{
+	if (inputs.empty())
+		return;
+
+	SendInput(static_cast<UINT>(inputs.size()), inputs.data(), sizeof(INPUT));
+
+	inputs.clear();
+}
+
+bool Indicium::Core::Input::InputReplay::on_present()
+{
+	const auto state = state_.load(std::memory_order_relaxed);
+
+	if (state != IndiciumInputReplayRecording && state != IndiciumInputReplayReplaying)
+		return false;
+
+	//
+	// Never block a render thread on another one; its inputs go out with the next frame
+	//
+	if (sending_.test_and_set(std::memory_order_acquire))
+		return false;
+
+	Memory::Scope scope(IndiciumMemoryTagInput);
+
+	bool waiting = false;
+
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		const auto now = now_us();
+
+		if (state_.load(std::memory_order_relaxed) == IndiciumInputReplayRecording)
+		{
+			recorder_.frame(now);
+		}
+		else if (state_.load(std::memory_order_relaxed) == IndiciumInputReplayReplaying)
+		{
+			player_->on_frame(now, [this](const Recorded& input) { apply(input); });
+
+			if (player_->finished())
+			{
+				overriding_ = false;
+				state_ = IndiciumInputReplayFinished;
+			}
+
+			waiting = player_->next_due() != (std::numeric_limits<int64_t>::max)();
+		}
+
+		presented_.swap(inputs_);
+	}
+
+	send(presented_);
+
+	sending_.clear(std::memory_order_release);
+
+	return waiting;
+}
+
+void Indicium::Core::Input::InputReplay::tick()
+{
+	if (state_.load(std::memory_order_relaxed) != IndiciumInputReplayReplaying)
+		return;
+
+	Memory::Scope scope(IndiciumMemoryTagInput);
+
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		if (state_.load(std::memory_order_relaxed) != IndiciumInputReplayReplaying)
+			return;
+
+		player_->poll(now_us(), [this](const Recorded& input) { apply(input); });
+
+		ticked_.swap(inputs_);
+	}
+
+	send(ticked_);
+}
+
+DWORD Indicium::Core::Input::InputReplay::tick_interval()
+{
+	if (state_.load(std::memory_order_relaxed) != IndiciumInputReplayReplaying)
+		return INFINITE;
+
+	std::lock_guard<std::mutex> guard(lock_);
+
+	if (!player_)
+		return INFINITE;
+
+	const auto due = player_->next_due();
+
+	if (due == (std::numeric_limits<int64_t>::max)())
+		return INFINITE;
+
+	const auto remaining = due - now_us();
+
+	return remaining > 0 ? static_cast<DWORD>((remaining + 999) / 1000) : 0;
+}
+
+DWORD Indicium::Core::Input::InputReplay::override_xinput(DWORD user_index, XINPUT_STATE* state, DWORD result)
+{
+	if (!overriding_.load(std::memory_order_relaxed) || user_index >= XUSER_MAX_COUNT)
+		return result;
+
+	std::lock_guard<std::mutex> guard(lock_);
+
+	const auto& pad = pads_[user_index];
+
+	if (!overriding_.load(std::memory_order_relaxed) || !pad.replayed)
+		return result;
+
+	if (!pad.connected)
+		return ERROR_DEVICE_NOT_CONNECTED;
+
+	if (!state)
+		return result;
+
+	*state = pad.state;
+
+	return ERROR_SUCCESS;
+}
+
+void Indicium::Core::Input::InputReplay::status(PINDICIUM_INPUT_REPLAY_STATUS status)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	ZeroMemory(status, sizeof(INDICIUM_INPUT_REPLAY_STATUS));
+
+	status->State = state_.load();
+
+	if (status->State == IndiciumInputReplayRecording)
+	{
+		status->Frame = recorder_.frames();
+		status->Events = recorder_.events();
+	}
+	else if (player_)
+	{
+		status->Frame = (std::min)(player_->frame(), static_cast<uint64_t>(timeline_.durations().size()));
+		status->Frames = timeline_.durations().size();
+		status->Events = timeline_.events().size();
+		status->Injected = injected_;
+		status->Late = player_->late();
+	}
+}
@@ -0,0 +1,168 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+#include <Xinput.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumInputReplay.h"
+
+#include "InputTimeline.h"
+#include "RawInputBatcher.h"
+#include "XInputTracker.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Input
+        {
+            /**
+             * \brief   Records the input seen by the Raw Input and XInput hooks per frame and
+             *          replays it aligned to the Presents of the host.
+             *
+             *          Keyboard and mouse input gets injected through SendInput, which feeds the
+             *          system input queue and thus every way the host may read it. XInput has no
+             *          such entry point, so replayed controller states are returned by the
+             *          XInputGetState hook in place of the real ones.
+             */
+            class InputReplay : public RawInputSink, public XInputSink
+            {
+            public:
+                //
+                // Fixed layout without pointers, so recordings work across 32 and 64 bit builds
+                //
+                struct Recorded
+                {
+                    UINT32 Source;
+                    UINT32 UserIndex;
+                    INT32 X;
+                    INT32 Y;
+                    UINT16 MouseFlags;
+                    UINT16 ButtonFlags;
+                    UINT16 ButtonData;
+                    UINT16 MakeCode;
+                    UINT16 KeyFlags;
+                    UINT16 VKey;
+                    UINT32 Connected;
+                    XINPUT_STATE State;
+                };
+
+            private:
+                enum Source : UINT32
+                {
+                    SourceMouse = 0,
+                    SourceKeyboard = 1,
+                    SourceXInput = 2
+                };
+
+                struct Pad
+                {
+                    bool replayed;
+                    bool connected;
+                    DWORD packet;
+                    XINPUT_STATE state;
+                };
+
+                std::mutex lock_;
+                std::atomic<INDICIUM_INPUT_REPLAY_STATE> state_;
+                LONGLONG frequency_;
+
+                TimelineRecorder<Recorded> recorder_;
+                InputTimeline<Recorded> timeline_;
+                std::unique_ptr<TimelinePlayer<Recorded>> player_;
+                ULONGLONG injected_;
+
+                RawInputBatcher* raw_input_;
+                XInputTracker* xinput_;
+
+                //
+                // Replayed controllers, read by the XInputGetState hook while overriding_ is set
+                //
+                Pad pads_[XUSER_MAX_COUNT];
+                std::atomic<bool> overriding_;
+
+                //
+                // Built under lock_ and swapped with the sender's buffer, which is sent outside
+                // of it; all of them keep their capacity
+                //
+                std::vector<INPUT> inputs_;
+
+                //
+                // Render thread side, held through sending_; engine thread side
+                //
+                std::atomic_flag sending_ = ATOMIC_FLAG_INIT;
+                std::vector<INPUT> presented_;
+                std::vector<INPUT> ticked_;
+
+                int64_t to_us(LONGLONG counter) const;
+                int64_t now_us() const;
+
+                void apply(const Recorded& input);
+                void send(std::vector<INPUT>& inputs);
+                void detach();
+
+            public:
+                InputReplay();
+                ~InputReplay();
+
+                InputReplay(const InputReplay&) = delete;
+                InputReplay& operator=(const InputReplay&) = delete;
+
+                INDICIUM_ERROR record_start(RawInputBatcher* raw_input, XInputTracker* xinput);
+                INDICIUM_ERROR record_stop(PCSTR path);
+
+                INDICIUM_ERROR replay_start(PCSTR path, INDICIUM_INPUT_REPLAY_MODE mode, XInputTracker* xinput);
+                void replay_stop();
+
+                void on_raw_input(const INDICIUM_RAW_INPUT_EVENT* events, size_t count) override;
+                void on_xinput(const INDICIUM_XINPUT_EVENT* events, size_t count) override;
+
+                /**
+                 * \brief   Frame boundary, called on the render thread before the Pre-Present
+                 *          callbacks. Returns true if input of the new frame waits for tick().
+                 */
+                bool on_present();
+
+                void tick();
+                DWORD tick_interval();
+
+                /**
+                 * \brief   Called by the XInputGetState hook with the result of the real call.
+                 */
+                DWORD override_xinput(DWORD user_index, XINPUT_STATE* state, DWORD result);
+
+                void status(PINDICIUM_INPUT_REPLAY_STATUS status);
+            };
+        };
+    };
+};
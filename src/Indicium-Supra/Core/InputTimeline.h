@@ -0,0 +1,381 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Input
+        {
+            /**
+             * \brief   Recorded input on a timeline of frames: every event belongs to the frame
+             *          (interval between two Presents) it happened in, at an offset from the
+             *          frame's start. Replays can thus follow the Present count of the host
+             *          instead of wall clock time.
+             *
+             *          Serializes to a flat little-endian blob; Payload must be trivially
+             *          copyable and have the same layout in 32 and 64 bit builds.
+             */
+            template <typename Payload>
+            class InputTimeline
+            {
+                static_assert(std::is_trivially_copyable<Payload>::value, "Payload gets stored as is");
+
+            public:
+                struct Event
+                {
+                    uint64_t frame;
+                    uint32_t offset_us;
+                    uint32_t reserved;
+                    Payload payload;
+                };
+
+            private:
+                struct Header
+                {
+                    uint32_t magic;
+                    uint32_t version;
+                    uint32_t payload_size;
+                    uint32_t reserved;
+                    uint64_t frames;
+                    uint64_t events;
+                };
+
+                static const uint32_t Magic = 0x50524449;   // "IDRP"
+                static const uint32_t Version = 1;
+
+                std::vector<uint32_t> durations_;
+                std::vector<Event> events_;
+
+            public:
+                InputTimeline() = default;
+
+                InputTimeline(std::vector<uint32_t> durations, std::vector<Event> events) :
+                    durations_(std::move(durations)),
+                    events_(std::move(events))
+                {
+                }
+
+                //
+                // Length of every recorded frame in microseconds
+                //
+                const std::vector<uint32_t>& durations() const { return durations_; }
+
+                //
+                // Sorted by frame and offset
+                //
+                const std::vector<Event>& events() const { return events_; }
+
+                std::vector<uint8_t> save() const
+                {
+                    Header header = { Magic, Version, uint32_t(sizeof(Payload)), 0,
+                        uint64_t(durations_.size()), uint64_t(events_.size()) };
+
+                    std::vector<uint8_t> blob(sizeof(Header)
+                        + durations_.size() * sizeof(uint32_t) + events_.size() * sizeof(Event));
+
+                    auto out = blob.data();
+
+                    memcpy(out, &header, sizeof(Header));
+                    out += sizeof(Header);
+
+                    if (!durations_.empty())
+                        memcpy(out, durations_.data(), durations_.size() * sizeof(uint32_t));
+                    out += durations_.size() * sizeof(uint32_t);
+
+                    if (!events_.empty())
+                        memcpy(out, events_.data(), events_.size() * sizeof(Event));
+
+                    return blob;
+                }
+
+                bool load(const uint8_t* data, size_t size)
+                {
+                    Header header;
+
+                    if (size < sizeof(Header))
+                        return false;
+
+                    memcpy(&header, data, sizeof(Header));
+
+                    if (header.magic != Magic || header.version != Version || header.payload_size != sizeof(Payload)
+                        || !header.frames)
+                        return false;
+
+                    //
+                    // Counts come from a file, check them before multiplying
+                    //
+                    const auto remaining = size - sizeof(Header);
+
+                    if (header.frames > remaining / sizeof(uint32_t))
+                        return false;
+
+                    const auto frames_size = size_t(header.frames) * sizeof(uint32_t);
+
+                    if (header.events > (remaining - frames_size) / sizeof(Event)
+                        || frames_size + size_t(header.events) * sizeof(Event) != remaining)
+                        return false;
+
+                    durations_.resize(size_t(header.frames));
+                    events_.resize(size_t(header.events));
+
+                    if (frames_size)
+                        memcpy(durations_.data(), data + sizeof(Header), frames_size);
+
+                    if (!events_.empty())
+                        memcpy(events_.data(), data + sizeof(Header) + frames_size, events_.size() * sizeof(Event));
+
+                    for (size_t i = 0; i < events_.size(); i++)
+                    {
+                        if (events_[i].frame >= header.frames
+                            || (i && events_[i].frame < events_[i - 1].frame))
+                            return false;
+                    }
+
+                    return true;
+                }
+            };
+
+            /**
+             * \brief   Builds an InputTimeline from Present times and event timestamps, both in
+             *          microseconds of the same clock. Events may arrive after the Present
+             *          following them, e.g. when delivered in batches.
+             */
+            template <typename Payload>
+            class TimelineRecorder
+            {
+                typedef typename InputTimeline<Payload>::Event Event;
+
+                std::vector<int64_t> starts_;
+                std::vector<Event> events_;
+
+            public:
+                void begin(int64_t now_us)
+                {
+                    starts_.assign(1, now_us);
+                    events_.clear();
+                }
+
+                void frame(int64_t now_us)
+                {
+                    starts_.push_back((std::max)(now_us, starts_.back()));
+                }
+
+                void add(int64_t timestamp_us, const Payload& payload)
+                {
+                    //
+                    // Latest frame starting at or before the event; usually the last one
+                    //
+                    auto frame = size_t(std::upper_bound(starts_.begin(), starts_.end(), timestamp_us) - starts_.begin());
+                    frame = frame ? frame - 1 : 0;
+
+                    Event event;
+                    event.frame = frame;
+                    event.offset_us = uint32_t((std::min<int64_t>)((std::max<int64_t>)(timestamp_us - starts_[frame], 0),
+                        (std::numeric_limits<uint32_t>::max)()));
+                    event.reserved = 0;
+                    event.payload = payload;
+
+                    events_.push_back(event);
+                }
+
+                size_t frames() const
+                {
+                    return starts_.size();
+                }
+
+                size_t events() const
+                {
+                    return events_.size();
+                }
+
+                InputTimeline<Payload> finish(int64_t now_us)
+                {
+                    std::vector<uint32_t> durations(starts_.size());
+
+                    for (size_t i = 0; i < starts_.size(); i++)
+                    {
+                        const auto end = i + 1 < starts_.size() ? starts_[i + 1] : (std::max)(now_us, starts_[i]);
+                        durations[i] = uint32_t((std::min<int64_t>)(end - starts_[i], (std::numeric_limits<uint32_t>::max)()));
+                    }
+
+                    std::stable_sort(events_.begin(), events_.end(), [](const Event& lhs, const Event& rhs)
+                    {
+                        return lhs.frame < rhs.frame || (lhs.frame == rhs.frame && lhs.offset_us < rhs.offset_us);
+                    });
+
+                    InputTimeline<Payload> timeline(std::move(durations), std::move(events_));
+
+                    starts_.clear();
+                    events_.clear();
+
+                    return timeline;
+                }
+            };
+
+            /**
+             * \brief   Replays an InputTimeline against the Presents of the host. Replay frame n
+             *          starts at the (n + 1)-th Present after begin().
+             *
+             *          Frame-aligned replays hand out all events of a frame right at its start,
+             *          so the host sees them before it samples input for that frame no matter
+             *          how long frames take. Timed replays keep the relative position of every
+             *          event within its frame, scaled to the length of the previous replayed
+             *          frame; events still pending at the next Present are handed out then and
+             *          counted as late. Either way no event leaves its frame.
+             */
+            template <typename Payload>
+            class TimelinePlayer
+            {
+                typedef typename InputTimeline<Payload>::Event Event;
+
+                const InputTimeline<Payload>* timeline_;
+                bool timed_;
+
+                //
+                // Frames started so far, the current one is started_ - 1
+                //
+                uint64_t started_;
+                size_t next_;
+                int64_t frame_start_;
+                int64_t estimate_us_;
+                uint64_t late_;
+
+                int64_t due_at(const Event& event) const
+                {
+                    const auto recorded = timeline_->durations()[size_t(event.frame)];
+
+                    if (!recorded)
+                        return frame_start_;
+
+                    return frame_start_ + int64_t(double(event.offset_us) * double(estimate_us_) / double(recorded));
+                }
+
+                template <typename Output>
+                void emit_until(uint64_t frame, int64_t now_us, bool by_time, bool late, Output& out)
+                {
+                    const auto& events = timeline_->events();
+
+                    while (next_ < events.size() && events[next_].frame <= frame)
+                    {
+                        if (by_time && events[next_].frame == frame && due_at(events[next_]) > now_us)
+                            break;
+
+                        if (late)
+                            late_++;
+
+                        out(events[next_].payload);
+                        next_++;
+                    }
+                }
+
+            public:
+                TimelinePlayer(const InputTimeline<Payload>& timeline, bool timed) :
+                    timeline_(&timeline),
+                    timed_(timed),
+                    started_(0),
+                    next_(0),
+                    frame_start_(0),
+                    estimate_us_(0),
+                    late_(0)
+                {
+                }
+
+                /**
+                 * \brief   Present of the host; out receives the payloads due right now.
+                 */
+                template <typename Output>
+                void on_frame(int64_t now_us, Output&& out)
+                {
+                    if (finished())
+                        return;
+
+                    if (started_)
+                    {
+                        emit_until(started_ - 1, now_us, false, timed_, out);
+                        estimate_us_ = now_us - frame_start_;
+                    }
+                    else
+                    {
+                        estimate_us_ = timeline_->durations()[0];
+                    }
+
+                    frame_start_ = now_us;
+                    started_++;
+
+                    if (!finished())
+                        emit_until(started_ - 1, now_us, timed_, false, out);
+                }
+
+                /**
+                 * \brief   Hands out the events of the current frame which became due (timed replays).
+                 */
+                template <typename Output>
+                void poll(int64_t now_us, Output&& out)
+                {
+                    if (timed_ && started_ && !finished())
+                        emit_until(started_ - 1, now_us, true, false, out);
+                }
+
+                /**
+                 * \brief   Time the next event of the current frame becomes due, or the maximum
+                 *          if there's none before the next Present.
+                 */
+                int64_t next_due() const
+                {
+                    const auto& events = timeline_->events();
+
+                    if (!timed_ || !started_ || finished() || next_ >= events.size() || events[next_].frame != started_ - 1)
+                        return (std::numeric_limits<int64_t>::max)();
+
+                    return due_at(events[next_]);
+                }
+
+                bool finished() const
+                {
+                    return started_ > timeline_->durations().size();
+                }
+
+                //
+                // Replay frames started so far
+                //
+                uint64_t frame() const { return started_; }
+
+                size_t emitted() const { return next_; }
+
+                uint64_t late() const { return late_; }
+            };
+        };
+    };
+};
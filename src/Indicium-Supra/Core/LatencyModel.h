@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <algorithm>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Pacing
+        {
+            /**
+             * \brief   Decides how long to hold the render thread after Present, before the game
+             *          starts simulating its next frame.
+             *
+             *          Time the game spends blocked inside Present, or frames spend queued beyond
+             *          one display interval, is latency added after input got sampled. The model
+             *          moves that wait in front of the frame instead: every frame the delay grows
+             *          by a fraction of the observed excess and shrinks while there is none, until
+             *          only the configured margin is left in the queue so the GPU never starves.
+             *
+             *          Pure arithmetic without platform dependencies, so it can be driven by a
+             *          simulated render queue.
+             */
+            class LatencyModel
+            {
+            public:
+                struct Config
+                {
+                    //
+                    // Queueing deliberately left in place, in milliseconds
+                    //
+                    double margin_ms;
+
+                    //
+                    // Fraction of the error applied per frame
+                    //
+                    double gain;
+
+                    //
+                    // Upper bound of the delay in milliseconds, 0 for one display interval
+                    //
+                    double max_delay_ms;
+                };
+
+            private:
+                Config config_;
+                double delay_ms_;
+
+            public:
+                explicit LatencyModel(const Config& config) : config_(config), delay_ms_(0.0) { }
+
+                void configure(const Config& config)
+                {
+                    config_ = config;
+                }
+
+                void reset()
+                {
+                    delay_ms_ = 0.0;
+                }
+
+                double delay_ms() const
+                {
+                    return delay_ms_;
+                }
+
+                /**
+                 * \brief   Feeds the measurements of the frame just presented and returns the delay
+                 *          to apply before the next one.
+                 *
+                 * \param   present_block_ms    Time the original Present (and latency wait) blocked.
+                 * \param   display_latency_ms  Present to display latency, negative if unknown.
+                 * \param   display_interval_ms Time between displayed frames, negative if unknown.
+                 *
+                 * \returns The delay in milliseconds.
+                 */
+                double update(double present_block_ms, double display_latency_ms, double display_interval_ms)
+                {
+                    auto excess = present_block_ms;
+
+                    //
+                    // Anything beyond scanning out the frame itself is time spent in the queue
+                    //
+                    if (display_latency_ms >= 0.0 && display_interval_ms > 0.0)
+                        excess = (std::max)(excess, display_latency_ms - display_interval_ms);
+
+                    delay_ms_ += config_.gain * (excess - config_.margin_ms);
+
+                    auto limit = config_.max_delay_ms;
+
+                    if (limit <= 0.0)
+                        limit = display_interval_ms > 0.0 ? display_interval_ms : 0.0;
+
+                    delay_ms_ = (std::min)((std::max)(delay_ms_, 0.0), limit);
+
+                    return delay_ms_;
+                }
+            };
+        };
+    };
+};
@@ -0,0 +1,133 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "LogLimiter.h"
+
+#include <algorithm>
+
+//
+// Token bucket packed into one 64-bit value for a single compare-exchange:
+// upper 40 bits last refill tick (ms), lower 24 bits tokens in thousandths
+//
+static const ULONGLONG TokenScale = 1000;
+static const ULONGLONG TokenBits = 24;
+static const ULONGLONG TokenMask = (1ULL << TokenBits) - 1;
+
+namespace
+{
+	//
+	// Per-thread view of a callsite; evicting an entry only loses the cached state
+	//
+	struct CachedCallsite
+	{
+		PINDICIUM_LOG_CALLSITE callsite;
+		ULONGLONG blocked_until;
+		UINT32 sample;
+	};
+
+	thread_local CachedCallsite t_callsites[8];
+}
+
+static bool take_token(PINDICIUM_LOG_CALLSITE callsite, ULONGLONG now, ULONGLONG& blocked_until)
+{
+	const ULONGLONG rate = callsite->RatePerSecond;
+	const ULONGLONG burst = callsite->Burst ? callsite->Burst : 1;
+	const auto capacity = (std::min)(burst * TokenScale, TokenMask);
+
+	auto current = static_cast<ULONGLONG>(callsite->Bucket);
+
+	for (;;)
+	{
+		ULONGLONG tokens = capacity;
+
+		//
+		// Zero means untouched, which starts out with a full bucket
+		//
+		if (current)
+		{
+			const auto stamp = current >> TokenBits;
+			const auto elapsed = (std::min)(now > stamp ? now - stamp : 0ULL, capacity);
+
+			tokens = (std::min)((current & TokenMask) + elapsed * rate, capacity);
+		}
+
+		if (tokens < TokenScale)
+		{
+			blocked_until = now + (TokenScale - tokens + rate - 1) / rate;
+			return false;
+		}
+
+		const auto next = (now << TokenBits) | (tokens - TokenScale);
+		const auto previous = static_cast<ULONGLONG>(InterlockedCompareExchange64(
+			&callsite->Bucket,
+			static_cast<LONG64>(next),
+			static_cast<LONG64>(current)
+		));
+
+		if (previous == current)
+			return true;
+
+		current = previous;
+	}
+}
+
+bool Indicium::Core::Logging::admit(PINDICIUM_LOG_CALLSITE callsite)
+{
+	auto& cached = t_callsites[(reinterpret_cast<ULONG_PTR>(callsite) >> 4) & (ARRAYSIZE(t_callsites) - 1)];
+
+	if (cached.callsite != callsite)
+	{
+		cached.callsite = callsite;
+		cached.blocked_until = 0;
+		cached.sample = 0;
+	}
+
+	if (callsite->SampleEvery > 1 && cached.sample++ % callsite->SampleEvery != 0)
+	{
+		InterlockedIncrement64(&callsite->Suppressed);
+		return false;
+	}
+
+	if (callsite->RatePerSecond == 0)
+		return true;
+
+	const auto now = GetTickCount64();
+
+	//
+	// Bucket was empty when this thread last looked and can't have refilled yet
+	//
+	if (now < cached.blocked_until || !take_token(callsite, now, cached.blocked_until))
+	{
+		InterlockedIncrement64(&callsite->Suppressed);
+		return false;
+	}
+
+	return true;
+}
+
+ULONGLONG Indicium::Core::Logging::take_suppressed(PINDICIUM_LOG_CALLSITE callsite)
+{
+	return static_cast<ULONGLONG>(InterlockedExchange64(&callsite->Suppressed, 0));
+}
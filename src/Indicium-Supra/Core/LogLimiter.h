@@ -0,0 +1,78 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Logging
+        {
+            /**
+             * \fn  bool admit(PINDICIUM_LOG_CALLSITE callsite);
+             *
+             * \brief   Decides whether the current call at the callsite gets logged. Calls dropped
+             *          by sampling or while the token bucket is known to be empty are answered from
+             *          a small thread-local cache without touching shared state except for the
+             *          suppressed counter.
+             *
+             * \param   callsite    The callsite limits and state.
+             *
+             * \returns True if the message should be logged.
+             */
+            bool admit(PINDICIUM_LOG_CALLSITE callsite);
+
+            /**
+             * \fn  ULONGLONG take_suppressed(PINDICIUM_LOG_CALLSITE callsite);
+             *
+             * \brief   Returns and resets the number of calls dropped since the last admitted one.
+             *
+             * \param   callsite    The callsite limits and state.
+             *
+             * \returns The suppressed call count.
+             */
+            ULONGLONG take_suppressed(PINDICIUM_LOG_CALLSITE callsite);
+        };
+    };
+};
+
+//
+// Rate-limited variant of _logger_->_level_(...) for engine-internal per-frame paths
+//
+#define INDICIUM_LOG_LIMITED(_logger_, _level_, _rate_, _burst_, ...) \
+    do { \
+        static INDICIUM_LOG_CALLSITE _callsite_ = INDICIUM_LOG_CALLSITE_INIT(_rate_, _burst_, 0); \
+        if (Indicium::Core::Logging::admit(&_callsite_)) { \
+            const auto _suppressed_ = Indicium::Core::Logging::take_suppressed(&_callsite_); \
+            if (_suppressed_) \
+                _logger_->_level_("{} similar messages suppressed", _suppressed_); \
+            _logger_->_level_(__VA_ARGS__); \
+        } \
+    } while (0)
@@ -0,0 +1,405 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include "LowLatency.h"
+#include "DisplayTracker.h"
+
+#include <dxgi1_3.h>
+
+#ifndef INDICIUM_NO_D3D9
+#include <d3d9.h>
+#endif
+
+#include <algorithm>
+
+#ifndef CREATE_WAITABLE_TIMER_HIGH_RESOLUTION
+#define CREATE_WAITABLE_TIMER_HIGH_RESOLUTION 0x00000002
+#endif
+
+namespace
+{
+	//
+	// Original Present currently executing on this thread
+	//
+	thread_local LONGLONG t_begin = 0;
+	thread_local LONGLONG t_end = 0;
+
+	//
+	// Last stretch of a delay gets spun instead of slept, timers are not that precise
+	//
+	const double SpinMs = 0.5;
+
+	//
+	// Presenter not seen for this long gets replaced by the next one presenting
+	//
+	const LONGLONG AbandonMs = 1000;
+
+	LONGLONG Now()
+	{
+		LARGE_INTEGER counter;
+		QueryPerformanceCounter(&counter);
+		return counter.QuadPart;
+	}
+
+	//
+	// Direct3D 10/11 swap chains without a waitable object, through the device
+	//
+	bool DeviceFrameLatency(IDXGISwapChain* chain, UINT latency, UINT* previous)
+	{
+		IDXGIDevice1* device = nullptr;
+
+		if (FAILED(chain->GetDevice(__uuidof(IDXGIDevice1), reinterpret_cast<void**>(&device))))
+			return false;
+
+		auto ok = true;
+
+		if (previous)
+			ok = SUCCEEDED(device->GetMaximumFrameLatency(previous));
+
+		ok = ok && SUCCEEDED(device->SetMaximumFrameLatency(latency));
+
+		device->Release();
+
+		return ok;
+	}
+}
+
+Indicium::Core::Pacing::LowLatencyMode::LowLatencyMode() :
+	active_(false),
+	reconfigure_(false),
+	model_({ 0.5, 0.25, 0.0 }),
+	presenter_(nullptr),
+	version_(IndiciumDirect3DVersionUnknown),
+	previous_latency_(0),
+	latency_object_(nullptr),
+	last_seen_(0),
+	wait_ticks_(0),
+	applied_latency_(0),
+	uses_latency_object_(false),
+	frames_(0),
+	delay_ms_(0.0),
+	average_wait_ms_(0.0),
+	last_block_ms_(0.0),
+	last_latency_ms_(-1.0)
+{
+	INDICIUM_LOW_LATENCY_CONFIG_INIT(&config_);
+	current_ = config_;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ticks_per_ms_ = frequency.QuadPart / 1000.0;
+
+	//
+	// High resolution timers need Windows 10 1803, older systems get the regular one
+	//
+	timer_ = CreateWaitableTimerExW(nullptr, nullptr, CREATE_WAITABLE_TIMER_HIGH_RESOLUTION, TIMER_ALL_ACCESS);
+
+	if (!timer_)
+		timer_ = CreateWaitableTimerExW(nullptr, nullptr, 0, TIMER_ALL_ACCESS);
+}
+
+Indicium::Core::Pacing::LowLatencyMode::~LowLatencyMode()
+{
+	release();
+
+	if (timer_)
+		CloseHandle(timer_);
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::start(const INDICIUM_LOW_LATENCY_CONFIG& config)
+{
+	{
+		std::lock_guard<std::mutex> guard(config_lock_);
+		config_ = config;
+	}
+
+	reconfigure_.store(true, std::memory_order_release);
+	active_.store(true, std::memory_order_release);
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::stop()
+{
+	active_.store(false, std::memory_order_release);
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::present_begin()
+{
+	t_begin = Now();
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::present_end()
+{
+	t_end = Now();
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::release()
+{
+	if (latency_object_)
+		CloseHandle(latency_object_);
+
+	latency_object_ = nullptr;
+	presenter_ = nullptr;
+	previous_latency_ = 0;
+
+	applied_latency_.store(0, std::memory_order_relaxed);
+	uses_latency_object_.store(false, std::memory_order_relaxed);
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::apply(INDICIUM_D3D_VERSION version, PVOID presenter)
+{
+	presenter_ = presenter;
+	version_ = version;
+	model_.reset();
+
+	const auto latency = (std::max)(current_.MaximumFrameLatency, 1u);
+	auto applied = false;
+
+	if (version == IndiciumDirect3DVersion9)
+	{
+#ifndef INDICIUM_NO_D3D9
+		//
+		// Only Direct3D 9Ex devices have a frame latency
+		//
+		IDirect3DDevice9Ex* device = nullptr;
+
+		if (SUCCEEDED(static_cast<LPDIRECT3DDEVICE9>(presenter)->QueryInterface(
+			__uuidof(IDirect3DDevice9Ex), reinterpret_cast<void**>(&device))))
+		{
+			applied = SUCCEEDED(device->GetMaximumFrameLatency(&previous_latency_))
+				&& SUCCEEDED(device->SetMaximumFrameLatency(latency));
+
+			device->Release();
+		}
+#endif
+	}
+	else
+	{
+		const auto chain = static_cast<IDXGISwapChain*>(presenter);
+		IDXGISwapChain2* chain2 = nullptr;
+
+		//
+		// Swap chains created with a waitable object only accept the latency on the swap chain
+		//
+		if (SUCCEEDED(chain->QueryInterface(__uuidof(IDXGISwapChain2), reinterpret_cast<void**>(&chain2))))
+		{
+			if (SUCCEEDED(chain2->GetMaximumFrameLatency(&previous_latency_))
+				&& SUCCEEDED(chain2->SetMaximumFrameLatency(latency)))
+			{
+				applied = true;
+
+				if (current_.WaitForLatencyObject)
+					latency_object_ = chain2->GetFrameLatencyWaitableObject();
+			}
+
+			chain2->Release();
+		}
+
+		if (!applied)
+			applied = DeviceFrameLatency(chain, latency, &previous_latency_);
+	}
+
+	if (!applied)
+		previous_latency_ = 0;
+
+	applied_latency_.store(applied ? latency : 0, std::memory_order_relaxed);
+	uses_latency_object_.store(latency_object_ != nullptr, std::memory_order_relaxed);
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::restore()
+{
+	//
+	// Nothing to put back if the runtime refused the latency in the first place
+	//
+	if (previous_latency_)
+	{
+		if (version_ == IndiciumDirect3DVersion9)
+		{
+#ifndef INDICIUM_NO_D3D9
+			IDirect3DDevice9Ex* device = nullptr;
+
+			if (SUCCEEDED(static_cast<LPDIRECT3DDEVICE9>(presenter_)->QueryInterface(
+				__uuidof(IDirect3DDevice9Ex), reinterpret_cast<void**>(&device))))
+			{
+				device->SetMaximumFrameLatency(previous_latency_);
+				device->Release();
+			}
+#endif
+		}
+		else
+		{
+			const auto chain = static_cast<IDXGISwapChain*>(presenter_);
+			IDXGISwapChain2* chain2 = nullptr;
+			auto restored = false;
+
+			if (SUCCEEDED(chain->QueryInterface(__uuidof(IDXGISwapChain2), reinterpret_cast<void**>(&chain2))))
+			{
+				restored = SUCCEEDED(chain2->SetMaximumFrameLatency(previous_latency_));
+				chain2->Release();
+			}
+
+			if (!restored)
+				DeviceFrameLatency(chain, previous_latency_, nullptr);
+		}
+	}
+
+	release();
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::wait_until(LONGLONG deadline)
+{
+	const auto sleep_until = deadline - static_cast<LONGLONG>(SpinMs * ticks_per_ms_);
+
+	if (timer_ && Now() < sleep_until)
+	{
+		//
+		// Relative due time in 100 ns units
+		//
+		LARGE_INTEGER due;
+		due.QuadPart = -static_cast<LONGLONG>((sleep_until - Now()) / ticks_per_ms_ * 10000.0);
+
+		if (due.QuadPart < 0 && SetWaitableTimer(timer_, &due, 0, nullptr, nullptr, FALSE))
+			WaitForSingleObject(timer_, INFINITE);
+	}
+
+	while (Now() < deadline)
+		YieldProcessor();
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::on_present(
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter,
+	Stats::DisplayTracker* display
+)
+{
+	const auto active = active_.load(std::memory_order_acquire);
+
+	if (!active && !presenter_)
+		return;
+
+	//
+	// Never block a render thread on another one; it goes unpaced for this frame
+	//
+	if (pacing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	const auto now = Now();
+
+	if (presenter != presenter_)
+	{
+		//
+		// The paced presenter may be gone, it never gets called into outside its own Present
+		//
+		if (presenter_ && now - last_seen_ < static_cast<LONGLONG>(AbandonMs * ticks_per_ms_))
+		{
+			pacing_.clear(std::memory_order_release);
+			return;
+		}
+
+		release();
+	}
+
+	const auto frame_ms = presenter_ ? (now - last_seen_) / ticks_per_ms_ : -1.0;
+	last_seen_ = now;
+
+	if (!active)
+	{
+		restore();
+		pacing_.clear(std::memory_order_release);
+		return;
+	}
+
+	if (reconfigure_.exchange(false, std::memory_order_acquire))
+	{
+		{
+			std::lock_guard<std::mutex> guard(config_lock_);
+			current_ = config_;
+		}
+
+		model_.configure({ current_.MarginMs, current_.Gain, current_.MaximumDelayMs });
+
+		//
+		// Frame latency may have changed, apply it again from scratch
+		//
+		if (presenter_)
+			restore();
+
+		frames_.store(0, std::memory_order_relaxed);
+		wait_ticks_ = 0;
+	}
+
+	if (!presenter_)
+		apply(version, presenter);
+
+	auto block = t_end - t_begin;
+
+	if (latency_object_)
+	{
+		const auto before = Now();
+		WaitForSingleObject(latency_object_, 1000);
+		block += Now() - before;
+	}
+
+	auto latency_ms = -1.0;
+	auto interval_ms = -1.0;
+
+	if (display)
+		display->latest(presenter, &latency_ms, &interval_ms);
+
+	//
+	// Without display statistics the frame time is the best guess for one display interval
+	//
+	if (interval_ms <= 0.0)
+		interval_ms = frame_ms;
+
+	const auto block_ms = block / ticks_per_ms_;
+	const auto delay_ms = model_.update(block_ms, latency_ms, interval_ms);
+
+	if (delay_ms > 0.0)
+		wait_until(Now() + static_cast<LONGLONG>(delay_ms * ticks_per_ms_));
+
+	wait_ticks_ += Now() - now;
+
+	const auto frames = frames_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+	delay_ms_.store(delay_ms, std::memory_order_relaxed);
+	average_wait_ms_.store(wait_ticks_ / ticks_per_ms_ / frames, std::memory_order_relaxed);
+	last_block_ms_.store(block_ms, std::memory_order_relaxed);
+	last_latency_ms_.store(latency_ms, std::memory_order_relaxed);
+
+	pacing_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Pacing::LowLatencyMode::statistics(PINDICIUM_LOW_LATENCY_STATISTICS statistics) const
+{
+	ZeroMemory(statistics, sizeof(INDICIUM_LOW_LATENCY_STATISTICS));
+
+	statistics->IsActive = active_.load(std::memory_order_relaxed);
+	statistics->AppliedFrameLatency = applied_latency_.load(std::memory_order_relaxed);
+	statistics->UsesWaitableObject = uses_latency_object_.load(std::memory_order_relaxed);
+	statistics->Frames = frames_.load(std::memory_order_relaxed);
+	statistics->DelayMs = delay_ms_.load(std::memory_order_relaxed);
+	statistics->AverageWaitMs = average_wait_ms_.load(std::memory_order_relaxed);
+	statistics->LastPresentBlockMs = last_block_ms_.load(std::memory_order_relaxed);
+	statistics->LastDisplayLatencyMs = last_latency_ms_.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,125 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumLatency.h"
+
+#include "LatencyModel.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            class DisplayTracker;
+        };
+
+        namespace Pacing
+        {
+            /**
+             * \brief   Low-latency mode: caps the render queue of one presenter and holds the render
+             *          thread after Present for the delay the LatencyModel computes.
+             *
+             *          Runtime objects are only touched from inside the Present of the paced
+             *          presenter, where it is guaranteed to be alive; stopping restores the original
+             *          frame latency there. A presenter which stops presenting for a second gets
+             *          replaced by the next one without being touched again.
+             */
+            class LowLatencyMode
+            {
+                //
+                // Configuration handed over to the render thread
+                //
+                std::mutex config_lock_;
+                INDICIUM_LOW_LATENCY_CONFIG config_;
+                std::atomic<bool> active_;
+                std::atomic<bool> reconfigure_;
+
+                //
+                // Render thread; serializes the rare case of two threads presenting at once
+                //
+                std::atomic_flag pacing_ = ATOMIC_FLAG_INIT;
+                INDICIUM_LOW_LATENCY_CONFIG current_;
+                LatencyModel model_;
+                PVOID presenter_;
+                INDICIUM_D3D_VERSION version_;
+                UINT previous_latency_;
+                HANDLE latency_object_;
+                HANDLE timer_;
+                LONGLONG last_seen_;
+                LONGLONG wait_ticks_;
+                double ticks_per_ms_;
+
+                //
+                // Published statistics
+                //
+                std::atomic<UINT32> applied_latency_;
+                std::atomic<bool> uses_latency_object_;
+                std::atomic<ULONGLONG> frames_;
+                std::atomic<double> delay_ms_;
+                std::atomic<double> average_wait_ms_;
+                std::atomic<double> last_block_ms_;
+                std::atomic<double> last_latency_ms_;
+
+                void apply(INDICIUM_D3D_VERSION version, PVOID presenter);
+                void restore();
+                void release();
+                void wait_until(LONGLONG deadline);
+
+            public:
+                LowLatencyMode();
+                ~LowLatencyMode();
+
+                LowLatencyMode(const LowLatencyMode&) = delete;
+                LowLatencyMode& operator=(const LowLatencyMode&) = delete;
+
+                void start(const INDICIUM_LOW_LATENCY_CONFIG& config);
+
+                void stop();
+
+                /**
+                 * \brief   Brackets the original Present on the calling thread.
+                 */
+                static void present_begin();
+                static void present_end();
+
+                /**
+                 * \brief   Applies the frame latency and waits; render thread only, after all other
+                 *          Post-Present work so the wait is the last thing before the game resumes.
+                 */
+                void on_present(INDICIUM_D3D_VERSION version, PVOID presenter, Stats::DisplayTracker* display);
+
+                void statistics(PINDICIUM_LOW_LATENCY_STATISTICS statistics) const;
+            };
+        };
+    };
+};
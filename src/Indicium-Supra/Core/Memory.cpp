@@ -0,0 +1,639 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Memory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+//
+// Everything below is constant-initialized; operator new gets called by the CRT and by other
+// translation units before dynamic initialization of this one has happened
+//
+namespace
+{
+	enum Backend : uint16_t
+	{
+		BackendHeap = 0,
+		BackendAlignedHeap,
+		BackendCustom       // + index into g_Allocators
+	};
+
+	//
+	// Stored directly in front of every block
+	//
+	struct BlockHeader
+	{
+		uint64_t size;
+		uint32_t offset;    // from the start of the backend block
+		uint16_t tag;
+		uint16_t backend;
+	};
+
+	static_assert(sizeof(BlockHeader) == 16, "Block header must keep 16 byte alignment");
+
+	const size_t DefaultAlignment = alignof(std::max_align_t);
+
+	//
+	// Net bytes a thread moves a tag by before the shared peak tracking hears about it
+	//
+	const int64_t PeakQuantum = 64 * 1024;
+
+	//
+	// Accounting of one thread. Only the owner writes (load + store, no interlocked operation),
+	// report() reads all of them. Blocks freed by another thread than the allocating one make
+	// single ledgers go negative, their sum is exact.
+	//
+	struct Ledger
+	{
+		std::atomic<int64_t> bytes[IndiciumMemoryTagCount];
+		std::atomic<int64_t> allocations[IndiciumMemoryTagCount];
+		std::atomic<int64_t> frees[IndiciumMemoryTagCount];
+		std::atomic<int64_t> overhead;
+		std::atomic<int64_t> heap_blocks;
+		std::atomic<int64_t> custom_blocks;
+
+		//
+		// Bytes not yet added to g_Coarse, owner only
+		//
+		int64_t pending[IndiciumMemoryTagCount];
+
+		Ledger* next;
+		Ledger* previous;
+	};
+
+	enum LedgerState : uint8_t
+	{
+		LedgerDetached = 0,
+		LedgerAttaching,
+		LedgerAttached,
+		LedgerRetired
+	};
+
+	//
+	// Flushed bytes per tag plus the total at the end, lagging the ledgers by less than
+	// PeakQuantum per thread and tag; peaks are taken from these
+	//
+	struct alignas(64) Coarse
+	{
+		std::atomic<int64_t> current;
+		std::atomic<int64_t> peak;
+	};
+
+	Coarse g_Coarse[IndiciumMemoryTagCount + 1];
+
+	//
+	// Ledgers of live threads, and the sum of those of exited threads plus the operations of
+	// threads without a ledger (updated with interlocked operations)
+	//
+	SRWLOCK g_LedgerLock = SRWLOCK_INIT;
+	Ledger* g_Ledgers;
+	Ledger g_Shared;
+
+	thread_local Ledger t_Ledger;
+	thread_local LedgerState t_LedgerState;
+
+	//
+	// Installed allocators are never replaced, so a block can find its backend at any time
+	// without synchronizing with install()
+	//
+	const size_t MaxAllocators = 8;
+
+	INDICIUM_ALLOCATOR g_Allocators[MaxAllocators];
+	std::atomic<size_t> g_AllocatorCount;
+
+	//
+	// Index + 1 of the allocator serving new blocks, 0 for the heap
+	//
+	std::atomic<size_t> g_Active;
+
+	SRWLOCK g_InstallLock = SRWLOCK_INIT;
+
+	thread_local INDICIUM_MEMORY_TAG t_Tag = IndiciumMemoryTagEngine;
+
+	void raise(std::atomic<int64_t>& peak, int64_t value)
+	{
+		auto seen = peak.load(std::memory_order_relaxed);
+
+		while (value > seen && !peak.compare_exchange_weak(seen, value, std::memory_order_relaxed))
+			;
+	}
+
+	void flush(size_t tag, int64_t bytes)
+	{
+		raise(g_Coarse[tag].peak, g_Coarse[tag].current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+
+		auto& total = g_Coarse[IndiciumMemoryTagCount];
+		raise(total.peak, total.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+	}
+
+	void bump(std::atomic<int64_t>& value, int64_t delta)
+	{
+		value.store(value.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+	}
+
+	void fold(Ledger& ledger)
+	{
+		for (size_t tag = 0; tag < IndiciumMemoryTagCount; tag++)
+		{
+			g_Shared.bytes[tag].fetch_add(ledger.bytes[tag].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			g_Shared.allocations[tag].fetch_add(ledger.allocations[tag].load(std::memory_order_relaxed), std::memory_order_relaxed);
+			g_Shared.frees[tag].fetch_add(ledger.frees[tag].load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			if (ledger.pending[tag])
+				flush(tag, ledger.pending[tag]);
+		}
+
+		g_Shared.overhead.fetch_add(ledger.overhead.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		g_Shared.heap_blocks.fetch_add(ledger.heap_blocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+		g_Shared.custom_blocks.fetch_add(ledger.custom_blocks.load(std::memory_order_relaxed), std::memory_order_relaxed);
+	}
+
+	//
+	// Links the ledger of its thread on creation and folds it into g_Shared on thread exit
+	//
+	struct LedgerOwner
+	{
+		LedgerOwner()
+		{
+			AcquireSRWLockExclusive(&g_LedgerLock);
+
+			t_Ledger.next = g_Ledgers;
+			t_Ledger.previous = nullptr;
+
+			if (g_Ledgers)
+				g_Ledgers->previous = &t_Ledger;
+
+			g_Ledgers = &t_Ledger;
+
+			ReleaseSRWLockExclusive(&g_LedgerLock);
+		}
+
+		~LedgerOwner()
+		{
+			AcquireSRWLockExclusive(&g_LedgerLock);
+
+			if (t_Ledger.previous)
+				t_Ledger.previous->next = t_Ledger.next;
+			else
+				g_Ledgers = t_Ledger.next;
+
+			if (t_Ledger.next)
+				t_Ledger.next->previous = t_Ledger.previous;
+
+			fold(t_Ledger);
+
+			ReleaseSRWLockExclusive(&g_LedgerLock);
+
+			//
+			// Frees by destructors running after this one go to g_Shared
+			//
+			t_LedgerState = LedgerRetired;
+		}
+	};
+
+	Ledger* ledger()
+	{
+		if (t_LedgerState == LedgerAttached)
+			return &t_Ledger;
+
+		if (t_LedgerState != LedgerDetached)
+			return nullptr;
+
+		//
+		// The runtime may allocate while registering the destructor, that goes to g_Shared
+		//
+		t_LedgerState = LedgerAttaching;
+
+		thread_local LedgerOwner owner;
+		(void)owner;
+
+		t_LedgerState = LedgerAttached;
+
+		return &t_Ledger;
+	}
+
+	void account(size_t tag, int64_t bytes, int64_t overhead, uint16_t backend)
+	{
+		const auto allocation = overhead > 0;
+		const auto blocks = backend >= BackendCustom ? &Ledger::custom_blocks : &Ledger::heap_blocks;
+
+		if (const auto own = ledger())
+		{
+			bump(own->bytes[tag], bytes);
+			bump(allocation ? own->allocations[tag] : own->frees[tag], 1);
+			bump(own->overhead, overhead);
+			bump(own->*blocks, allocation ? 1 : -1);
+
+			own->pending[tag] += bytes;
+
+			if (own->pending[tag] >= PeakQuantum || own->pending[tag] <= -PeakQuantum)
+			{
+				flush(tag, own->pending[tag]);
+				own->pending[tag] = 0;
+			}
+
+			return;
+		}
+
+		g_Shared.bytes[tag].fetch_add(bytes, std::memory_order_relaxed);
+		(allocation ? g_Shared.allocations[tag] : g_Shared.frees[tag]).fetch_add(1, std::memory_order_relaxed);
+		g_Shared.overhead.fetch_add(overhead, std::memory_order_relaxed);
+		(g_Shared.*blocks).fetch_add(allocation ? 1 : -1, std::memory_order_relaxed);
+
+		flush(tag, bytes);
+	}
+
+	bool same(const INDICIUM_ALLOCATOR& a, const INDICIUM_ALLOCATOR& b)
+	{
+		return a.EvtIndiciumAllocate == b.EvtIndiciumAllocate
+			&& a.EvtIndiciumFree == b.EvtIndiciumFree
+			&& a.UserData == b.UserData;
+	}
+}
+
+bool Indicium::Core::Memory::install(const INDICIUM_ALLOCATOR& allocator)
+{
+	if (!allocator.EvtIndiciumAllocate || !allocator.EvtIndiciumFree)
+	{
+		g_Active.store(0, std::memory_order_release);
+		return true;
+	}
+
+	AcquireSRWLockExclusive(&g_InstallLock);
+
+	const auto count = g_AllocatorCount.load(std::memory_order_relaxed);
+	auto index = count;
+
+	for (size_t i = 0; i < count; i++)
+	{
+		if (same(g_Allocators[i], allocator))
+		{
+			index = i;
+			break;
+		}
+	}
+
+	if (index == count)
+	{
+		if (count == MaxAllocators)
+		{
+			ReleaseSRWLockExclusive(&g_InstallLock);
+			return false;
+		}
+
+		g_Allocators[count] = allocator;
+		g_AllocatorCount.store(count + 1, std::memory_order_release);
+	}
+
+	g_Active.store(index + 1, std::memory_order_release);
+
+	ReleaseSRWLockExclusive(&g_InstallLock);
+
+	return true;
+}
+
+bool Indicium::Core::Memory::is_active(const INDICIUM_ALLOCATOR& allocator)
+{
+	const auto active = g_Active.load(std::memory_order_acquire);
+
+	if (!allocator.EvtIndiciumAllocate || !allocator.EvtIndiciumFree)
+		return active == 0;
+
+	return active != 0 && same(g_Allocators[active - 1], allocator);
+}
+
+void* Indicium::Core::Memory::allocate(size_t size, INDICIUM_MEMORY_TAG tag, size_t alignment) noexcept
+{
+	if (alignment < DefaultAlignment)
+		alignment = DefaultAlignment;
+
+	if (unsigned(tag) >= IndiciumMemoryTagCount)
+		tag = IndiciumMemoryTagEngine;
+
+	//
+	// Header sits in the padding in front of the block, which is one alignment unit (at least
+	// the header size) so the block itself lands aligned
+	//
+	const auto prefix = alignment > sizeof(BlockHeader) ? alignment : sizeof(BlockHeader);
+
+	if (size > SIZE_MAX - prefix)
+		return nullptr;
+
+	const auto active = g_Active.load(std::memory_order_acquire);
+
+	BYTE* base;
+	uint16_t backend;
+
+	if (active)
+	{
+		const auto& allocator = g_Allocators[active - 1];
+
+		base = static_cast<BYTE*>(allocator.EvtIndiciumAllocate(size + prefix, prefix, tag, allocator.UserData));
+		backend = uint16_t(BackendCustom + active - 1);
+	}
+	else if (alignment == DefaultAlignment)
+	{
+		base = static_cast<BYTE*>(malloc(size + prefix));
+		backend = BackendHeap;
+	}
+	else
+	{
+		base = static_cast<BYTE*>(_aligned_malloc(size + prefix, prefix));
+		backend = BackendAlignedHeap;
+	}
+
+	if (!base)
+		return nullptr;
+
+	const auto block = base + prefix;
+	const auto header = reinterpret_cast<BlockHeader*>(block) - 1;
+
+	header->size = size;
+	header->offset = uint32_t(prefix);
+	header->tag = uint16_t(tag);
+	header->backend = backend;
+
+	account(tag, int64_t(size), int64_t(prefix), backend);
+
+	return block;
+}
+
+void Indicium::Core::Memory::release(void* block) noexcept
+{
+	if (!block)
+		return;
+
+	const auto header = *(static_cast<BlockHeader*>(block) - 1);
+	const auto base = static_cast<BYTE*>(block) - header.offset;
+
+	account(header.tag, -int64_t(header.size), -int64_t(header.offset), header.backend);
+
+	switch (header.backend)
+	{
+	case BackendHeap:
+		free(base);
+		break;
+	case BackendAlignedHeap:
+		_aligned_free(base);
+		break;
+	default:
+	{
+		const auto& allocator = g_Allocators[header.backend - BackendCustom];
+
+		allocator.EvtIndiciumFree(
+			base,
+			SIZE_T(header.size + header.offset),
+			header.offset,
+			INDICIUM_MEMORY_TAG(header.tag),
+			allocator.UserData
+		);
+		break;
+	}
+	}
+}
+
+void Indicium::Core::Memory::report(INDICIUM_MEMORY_REPORT* report)
+{
+	ZeroMemory(report, sizeof(INDICIUM_MEMORY_REPORT));
+
+	int64_t bytes[IndiciumMemoryTagCount] = {};
+	int64_t allocations[IndiciumMemoryTagCount] = {};
+	int64_t frees[IndiciumMemoryTagCount] = {};
+	int64_t overhead = 0, heap_blocks = 0, custom_blocks = 0;
+
+	const auto sum = [&](const Ledger& ledger)
+	{
+		for (size_t tag = 0; tag < IndiciumMemoryTagCount; tag++)
+		{
+			bytes[tag] += ledger.bytes[tag].load(std::memory_order_relaxed);
+			allocations[tag] += ledger.allocations[tag].load(std::memory_order_relaxed);
+			frees[tag] += ledger.frees[tag].load(std::memory_order_relaxed);
+		}
+
+		overhead += ledger.overhead.load(std::memory_order_relaxed);
+		heap_blocks += ledger.heap_blocks.load(std::memory_order_relaxed);
+		custom_blocks += ledger.custom_blocks.load(std::memory_order_relaxed);
+	};
+
+	AcquireSRWLockShared(&g_LedgerLock);
+
+	for (auto ledger = g_Ledgers; ledger; ledger = ledger->next)
+		sum(*ledger);
+
+	sum(g_Shared);
+
+	ReleaseSRWLockShared(&g_LedgerLock);
+
+	//
+	// Ledgers are read one after another while their threads go on, clamp what doesn't add up
+	//
+	const auto clamp = [](int64_t value) { return ULONGLONG(value > 0 ? value : 0); };
+
+	int64_t total = 0;
+
+	for (size_t tag = 0; tag < IndiciumMemoryTagCount; tag++)
+	{
+		auto& usage = report->Subsystems[tag];
+
+		usage.Current = clamp(bytes[tag]);
+		usage.Peak = (std::max)(usage.Current, clamp(g_Coarse[tag].peak.load(std::memory_order_relaxed)));
+		usage.Allocations = clamp(allocations[tag]);
+		usage.Frees = clamp(frees[tag]);
+
+		report->Total.Allocations += usage.Allocations;
+		report->Total.Frees += usage.Frees;
+		total += bytes[tag];
+	}
+
+	report->Total.Current = clamp(total);
+	report->Total.Peak = (std::max)(report->Total.Current,
+		clamp(g_Coarse[IndiciumMemoryTagCount].peak.load(std::memory_order_relaxed)));
+
+	report->Overhead = clamp(overhead);
+	report->HeapBlocks = clamp(heap_blocks);
+	report->CustomBlocks = clamp(custom_blocks);
+}
+
+void Indicium::Core::Memory::reset_peaks()
+{
+	//
+	// Racing allocations raise the peaks again right away, racing frees leave them slightly high
+	//
+	for (auto& coarse : g_Coarse)
+		coarse.peak.store(coarse.current.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+INDICIUM_MEMORY_TAG Indicium::Core::Memory::current_tag()
+{
+	return t_Tag;
+}
+
+Indicium::Core::Memory::Scope::Scope(INDICIUM_MEMORY_TAG tag) : previous_(t_Tag)
+{
+	t_Tag = tag;
+}
+
+Indicium::Core::Memory::Scope::~Scope()
+{
+	t_Tag = previous_;
+}
+
+#ifdef INDICIUM_DYNAMIC
+
+//
+// Replacing the global operators routes every C++ allocation of the library (containers,
+// spdlog and the subsystems) through the above. With the CRT operators linked per module this
+// only covers the engine DLL; static library builds leave the operators of the host alone and
+// only route the explicit allocations (engine instance, contexts, plugins, zlib and Opus).
+//
+namespace
+{
+	void* allocate_or_throw(size_t size, size_t alignment)
+	{
+		for (;;)
+		{
+			if (const auto block = Indicium::Core::Memory::allocate(size, t_Tag, alignment))
+				return block;
+
+			const auto handler = std::get_new_handler();
+
+			if (!handler)
+				throw std::bad_alloc();
+
+			handler();
+		}
+	}
+}
+
+void* operator new(size_t size)
+{
+	return allocate_or_throw(size, 0);
+}
+
+void* operator new[](size_t size)
+{
+	return allocate_or_throw(size, 0);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return Indicium::Core::Memory::allocate(size, t_Tag);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return Indicium::Core::Memory::allocate(size, t_Tag);
+}
+
+void operator delete(void* block) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete[](void* block) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete(void* block, size_t) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete[](void* block, size_t) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete(void* block, const std::nothrow_t&) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete[](void* block, const std::nothrow_t&) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+#ifdef __cpp_aligned_new
+
+void* operator new(size_t size, std::align_val_t alignment)
+{
+	return allocate_or_throw(size, size_t(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment)
+{
+	return allocate_or_throw(size, size_t(alignment));
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return Indicium::Core::Memory::allocate(size, t_Tag, size_t(alignment));
+}
+
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept
+{
+	return Indicium::Core::Memory::allocate(size, t_Tag, size_t(alignment));
+}
+
+void operator delete(void* block, std::align_val_t) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete[](void* block, std::align_val_t) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete(void* block, size_t, std::align_val_t) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete[](void* block, size_t, std::align_val_t) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete(void* block, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+void operator delete[](void* block, std::align_val_t, const std::nothrow_t&) noexcept
+{
+	Indicium::Core::Memory::release(block);
+}
+
+#endif
+
+#endif
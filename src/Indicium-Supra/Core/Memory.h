@@ -0,0 +1,91 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumMemory.h"
+
+#include <cstddef>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Memory
+        {
+            /**
+             * \brief   Makes allocator the backend of all following allocations; both callbacks
+             *          NULL switches back to the process heap. Blocks remember the backend they
+             *          came from, so blocks allocated before stay valid. Returns false once too
+             *          many distinct allocators got installed during the process lifetime.
+             */
+            bool install(const INDICIUM_ALLOCATOR& allocator);
+
+            /**
+             * \brief   True if allocator is the one serving new allocations (or both are the heap).
+             */
+            bool is_active(const INDICIUM_ALLOCATOR& allocator);
+
+            /**
+             * \brief   Allocates from the active backend and accounts the block to tag. Alignment
+             *          0 means the default alignment of operator new. Returns nullptr on failure.
+             */
+            void* allocate(size_t size, INDICIUM_MEMORY_TAG tag, size_t alignment = 0) noexcept;
+
+            /**
+             * \brief   Frees a block of allocate (or of the library's operator new), NULL is ignored.
+             */
+            void release(void* block) noexcept;
+
+            void report(INDICIUM_MEMORY_REPORT* report);
+
+            void reset_peaks();
+
+            /**
+             * \brief   Tag of allocations of the calling thread which don't pass one explicitly.
+             */
+            INDICIUM_MEMORY_TAG current_tag();
+
+            /**
+             * \brief   Accounts the untagged allocations of the calling thread to a subsystem while
+             *          alive, e.g. containers grown inside a subsystem. Scopes nest.
+             */
+            class Scope
+            {
+                INDICIUM_MEMORY_TAG previous_;
+
+            public:
+                explicit Scope(INDICIUM_MEMORY_TAG tag);
+                ~Scope();
+
+                Scope(const Scope&) = delete;
+                Scope& operator=(const Scope&) = delete;
+            };
+        };
+    };
+};
@@ -0,0 +1,279 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Audio
+        {
+            /**
+             * \brief   Maps frame indices of a render stream to the time they get played.
+             *
+             *          Every buffer a client releases yields an anchor: the index of its first
+             *          frame and the time it will be played, derived from the padding queued ahead
+             *          of it. Anchors are noisy by up to one audio engine period, so the mapping is
+             *          a least-squares line over them with exponential forgetting; its slope is the
+             *          stream's true rate measured against the performance counter, which is what
+             *          drifts between devices. Until the anchors span enough time the nominal rate
+             *          is used and only the offset gets fitted.
+             *
+             *          Pure arithmetic without platform dependencies, so it can be driven by
+             *          simulated streams.
+             */
+            class StreamClock
+            {
+                double nominal_rate_;
+                double forgetting_;
+
+                //
+                // Weighted sums over anchors relative to the origin (n0_, t0_)
+                //
+                double n0_;
+                double t0_;
+                double sw_;
+                double sx_;
+                double sy_;
+                double sxx_;
+                double sxy_;
+                unsigned long count_;
+
+                //
+                // Keeps the sums small, so the variance doesn't cancel out over long streams
+                //
+                void recenter(double x, double y)
+                {
+                    sxx_ += x * (x * sw_ - 2.0 * sx_);
+                    sxy_ += x * (y * sw_ - sy_) - y * sx_;
+                    sx_ -= x * sw_;
+                    sy_ -= y * sw_;
+                    n0_ += x;
+                    t0_ += y;
+                }
+
+                double slope() const
+                {
+                    const auto nominal = 1.0 / nominal_rate_;
+
+                    if (count_ < 2)
+                        return nominal;
+
+                    const auto spread = sxx_ * sw_ - sx_ * sx_;
+
+                    //
+                    // Anchors must cover about two seconds before the slope beats period jitter
+                    //
+                    const auto span = 2.0 * nominal_rate_;
+
+                    if (spread <= span * span * sw_ * sw_ / 12.0)
+                        return nominal;
+
+                    const auto fitted = (sxy_ * sw_ - sx_ * sy_) / spread;
+
+                    //
+                    // Beyond half a percent something else than drift is going on
+                    //
+                    if (std::fabs(fitted / nominal - 1.0) > 0.005)
+                        return nominal;
+
+                    return fitted;
+                }
+
+            public:
+                /**
+                 * \param   nominal_rate    Frames per second the stream got initialized with.
+                 * \param   forgetting      Weight kept per anchor, e.g. 0.999 for a window of
+                 *                          about a thousand buffers.
+                 */
+                StreamClock(double nominal_rate, double forgetting) :
+                    nominal_rate_(nominal_rate), forgetting_(forgetting)
+                {
+                    reset();
+                }
+
+                void reset()
+                {
+                    n0_ = t0_ = 0.0;
+                    sw_ = sx_ = sy_ = sxx_ = sxy_ = 0.0;
+                    count_ = 0;
+                }
+
+                bool empty() const
+                {
+                    return count_ == 0;
+                }
+
+                /**
+                 * \brief   Adds an anchor: frame index n gets played at time t in seconds.
+                 */
+                void add(double n, double t)
+                {
+                    if (count_ == 0)
+                    {
+                        n0_ = n;
+                        t0_ = t;
+                    }
+
+                    sw_ *= forgetting_;
+                    sx_ *= forgetting_;
+                    sy_ *= forgetting_;
+                    sxx_ *= forgetting_;
+                    sxy_ *= forgetting_;
+
+                    const auto x = n - n0_;
+                    const auto y = t - t0_;
+
+                    sw_ += 1.0;
+                    sx_ += x;
+                    sy_ += y;
+                    sxx_ += x * x;
+                    sxy_ += x * y;
+                    count_++;
+
+                    if (std::fabs(x) > 16.0 * nominal_rate_)
+                        recenter(sx_ / sw_, sy_ / sw_);
+                }
+
+                /**
+                 * \brief   Measured frames per second.
+                 */
+                double rate() const
+                {
+                    return 1.0 / slope();
+                }
+
+                /**
+                 * \brief   Time in seconds at which frame n gets played.
+                 */
+                double time_of(double n) const
+                {
+                    const auto b = slope();
+                    const auto a = count_ ? (sy_ - b * sx_) / sw_ : 0.0;
+
+                    return t0_ + a + b * (n - n0_);
+                }
+
+                /**
+                 * \brief   Frame index played at time t in seconds.
+                 */
+                double frame_at(double t) const
+                {
+                    const auto b = slope();
+                    const auto a = count_ ? (sy_ - b * sx_) / sw_ : 0.0;
+
+                    return n0_ + (t - t0_ - a) / b;
+                }
+            };
+
+            /**
+             * \brief   Steers the read position of a stream towards where its clock says it should
+             *          be, by stretching or squeezing the resampling ratio slightly. Corrections are
+             *          limited to a fraction of a percent, far below audible pitch changes; errors
+             *          too large for that are fixed by jumping instead.
+             */
+            class DriftCompensator
+            {
+            public:
+                struct Config
+                {
+                    //
+                    // Largest relative change of the resampling ratio
+                    //
+                    double max_correction;
+
+                    //
+                    // Correction per second of position error, and per second of accumulated error
+                    //
+                    double proportional;
+                    double integral;
+
+                    //
+                    // Position error in seconds beyond which the position jumps
+                    //
+                    double resync_seconds;
+                };
+
+            private:
+                Config config_;
+                double integral_;
+                double correction_;
+
+            public:
+                explicit DriftCompensator(const Config& config) :
+                    config_(config), integral_(0.0), correction_(0.0)
+                {
+                }
+
+                void reset()
+                {
+                    integral_ = 0.0;
+                    correction_ = 0.0;
+                }
+
+                double correction() const
+                {
+                    return correction_;
+                }
+
+                /**
+                 * \brief   Feeds the position error of a block.
+                 *
+                 * \param   error_seconds   Target minus actual read position, in seconds.
+                 * \param   block_seconds   Duration of the block about to be produced.
+                 *
+                 * \returns false if the position has to jump to the target instead.
+                 */
+                bool update(double error_seconds, double block_seconds)
+                {
+                    if (std::fabs(error_seconds) > config_.resync_seconds)
+                    {
+                        reset();
+                        return false;
+                    }
+
+                    const auto limit = config_.max_correction;
+
+                    integral_ += error_seconds * block_seconds;
+
+                    //
+                    // Anti-windup: the integral alone never asks for more than the limit
+                    //
+                    if (config_.integral > 0.0)
+                        integral_ = (std::min)((std::max)(integral_, -limit / config_.integral), limit / config_.integral);
+
+                    correction_ = config_.proportional * error_seconds + config_.integral * integral_;
+                    correction_ = (std::min)((std::max)(correction_, -limit), limit);
+
+                    return true;
+                }
+            };
+        };
+    };
+};
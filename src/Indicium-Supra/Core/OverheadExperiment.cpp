@@ -0,0 +1,377 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+//
+// Public
+// 
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumDirect3D9.h"
+#include "Indicium/Engine/IndiciumDirect3D10.h"
+#include "Indicium/Engine/IndiciumDirect3D11.h"
+#include "Indicium/Engine/IndiciumDirect3D12.h"
+#include "Indicium/Engine/IndiciumCoreAudio.h"
+
+//
+// Internal
+// 
+#include "Engine.h"
+#include "OverheadExperiment.h"
+#include "Statistics.h"
+#include "PluginHost.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+//
+// Room for the windows of a long session before the render thread has to reallocate
+//
+static const size_t ReservedWindows = 1024;
+
+Indicium::Core::Stats::OverheadExperiment::OverheadExperiment() :
+	running_(false),
+	epoch_(0),
+	frames_per_window_(60),
+	settle_frames_(3),
+	confidence_(0.95),
+	position_(0),
+	frame_epoch_(0),
+	window_length_(60),
+	settle_length_(3),
+	previous_(0),
+	frame_(0),
+	window_ticks_(0),
+	window_frames_(0)
+{
+	InitializeSRWLock(&samples_);
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+	ticks_per_ms_ = frequency.QuadPart / 1000.0;
+
+	LARGE_INTEGER seed;
+	QueryPerformanceCounter(&seed);
+	random_ = static_cast<ULONGLONG>(seed.QuadPart) | 1;
+}
+
+void Indicium::Core::Stats::OverheadExperiment::shuffle()
+{
+	//
+	// Fisher-Yates driven by xorshift64*, good enough to break up periodic load
+	//
+	for (auto i = order_.size(); i > 1; i--)
+	{
+		random_ ^= random_ >> 12;
+		random_ ^= random_ << 25;
+		random_ ^= random_ >> 27;
+
+		const auto j = static_cast<size_t>((random_ * 2685821657736338717ULL) % i);
+
+		std::swap(order_[i - 1], order_[j]);
+	}
+}
+
+void Indicium::Core::Stats::OverheadExperiment::apply(PINDICIUM_ENGINE engine, const Arm* arm)
+{
+	const auto variant = arm ? arm->variant : Variant::Active;
+
+	if (variant == Variant::Suspended)
+		InterlockedOr(&engine->Suspended, INDICIUM_SUSPEND_EXPERIMENT);
+	else
+		InterlockedAnd(&engine->Suspended, ~INDICIUM_SUSPEND_EXPERIMENT);
+
+	InterlockedExchange(&engine->SkipHostCallbacks, variant == Variant::WithoutHost);
+
+	const auto plugins = engine->Plugins ? engine->Plugins->plugins() : nullptr;
+
+	if (!plugins)
+		return;
+
+	for (const auto plugin : *plugins)
+		InterlockedExchange(&plugin->Skipped, variant == Variant::WithoutPlugin && arm->plugin == plugin);
+}
+
+void Indicium::Core::Stats::OverheadExperiment::start(PINDICIUM_ENGINE engine, const INDICIUM_OVERHEAD_AB_CONFIG& config)
+{
+	std::lock_guard<std::mutex> guard(control_);
+
+	//
+	// Suspended and fully active come first, estimates rely on it
+	//
+	std::vector<Arm> arms;
+	arms.push_back({ Variant::Suspended, nullptr, {}, {} });
+	arms.push_back({ Variant::Active, nullptr, {}, {} });
+
+	if (config.MeasureSubscribers)
+	{
+		arms.push_back({ Variant::WithoutHost, nullptr, {}, {} });
+
+		const auto plugins = engine->Plugins ? engine->Plugins->plugins() : nullptr;
+
+		if (plugins)
+		{
+			for (const auto plugin : *plugins)
+				arms.push_back({ Variant::WithoutPlugin, plugin, plugin->Info.Name ? plugin->Info.Name : "", {} });
+		}
+	}
+
+	for (auto& arm : arms)
+		arm.windows.reserve(ReservedWindows);
+
+	std::vector<size_t> order(arms.size());
+
+	for (size_t i = 0; i < order.size(); i++)
+		order[i] = i;
+
+	AcquireSRWLockExclusive(&samples_);
+
+	frames_per_window_ = config.FramesPerWindow ? config.FramesPerWindow : 60;
+	settle_frames_ = config.SettleFrames ? config.SettleFrames : 3;
+
+	//
+	// The first frame time of a window still spans the switch
+	//
+	if (settle_frames_ >= frames_per_window_)
+		frames_per_window_ = settle_frames_ + 1;
+
+	confidence_ = (config.ConfidenceLevel > 0.0 && config.ConfidenceLevel < 1.0) ? config.ConfidenceLevel : 0.95;
+
+	arms_.swap(arms);
+	order_.swap(order);
+	shuffle();
+	position_ = 0;
+
+	epoch_.fetch_add(1, std::memory_order_release);
+
+	apply(engine, &arms_[order_[position_]]);
+	running_.store(true, std::memory_order_release);
+
+	ReleaseSRWLockExclusive(&samples_);
+}
+
+void Indicium::Core::Stats::OverheadExperiment::stop(PINDICIUM_ENGINE engine)
+{
+	std::lock_guard<std::mutex> guard(control_);
+
+	AcquireSRWLockExclusive(&samples_);
+
+	running_.store(false, std::memory_order_relaxed);
+	apply(engine, nullptr);
+
+	ReleaseSRWLockExclusive(&samples_);
+}
+
+void Indicium::Core::Stats::OverheadExperiment::reset_window()
+{
+	previous_ = 0;
+	frame_ = 0;
+	window_ticks_ = 0;
+	window_frames_ = 0;
+}
+
+void Indicium::Core::Stats::OverheadExperiment::on_frame(PINDICIUM_ENGINE engine)
+{
+	if (!running_.load(std::memory_order_acquire))
+		return;
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	//
+	// Never block a render thread on another one; the frame goes unmeasured
+	//
+	if (framing_.test_and_set(std::memory_order_acquire))
+		return;
+
+	//
+	// Restarted since the last frame, pick up the new window length and start over
+	//
+	if (epoch_.load(std::memory_order_acquire) != frame_epoch_)
+	{
+		AcquireSRWLockShared(&samples_);
+
+		frame_epoch_ = epoch_.load(std::memory_order_relaxed);
+		window_length_ = frames_per_window_;
+		settle_length_ = settle_frames_;
+
+		ReleaseSRWLockShared(&samples_);
+
+		reset_window();
+	}
+
+	//
+	// Frames suspended through the API belong to no variant, the window starts over once resumed
+	//
+	if (engine->Suspended & INDICIUM_SUSPEND_API)
+	{
+		reset_window();
+
+		framing_.clear(std::memory_order_release);
+		return;
+	}
+
+	if (previous_)
+	{
+		if (frame_ >= settle_length_)
+		{
+			window_ticks_ += now.QuadPart - previous_;
+			window_frames_++;
+		}
+
+		frame_++;
+	}
+
+	previous_ = now.QuadPart;
+
+	if (frame_ >= window_length_)
+	{
+		//
+		// Windows outgrowing the reserved room get reallocated on the render thread
+		//
+		Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+		AcquireSRWLockExclusive(&samples_);
+
+		//
+		// Stopped or restarted during the window, it belongs to none of the current arms
+		//
+		if (running_.load(std::memory_order_relaxed) && epoch_.load(std::memory_order_relaxed) == frame_epoch_)
+		{
+			arms_[order_[position_]].windows.push_back(window_ticks_ / ticks_per_ms_ / window_frames_);
+
+			if (++position_ == order_.size())
+			{
+				shuffle();
+				position_ = 0;
+			}
+
+			apply(engine, &arms_[order_[position_]]);
+		}
+
+		ReleaseSRWLockExclusive(&samples_);
+
+		frame_ = 0;
+		window_ticks_ = 0;
+		window_frames_ = 0;
+	}
+
+	framing_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Stats::OverheadExperiment::estimate(
+	const Arm& with,
+	const Arm& without,
+	double confidence,
+	INDICIUM_OVERHEAD_SUBJECT subject,
+	PINDICIUM_OVERHEAD_ESTIMATE result
+)
+{
+	ZeroMemory(result, sizeof(INDICIUM_OVERHEAD_ESTIMATE));
+
+	const auto a = describe(with.windows).moments;
+	const auto b = describe(without.windows).moments;
+
+	result->Subject = subject;
+	strncpy_s(result->Name, without.name.c_str(), _TRUNCATE);
+	result->WindowsWith = static_cast<ULONGLONG>(a.count);
+	result->WindowsWithout = static_cast<ULONGLONG>(b.count);
+	result->FrameMsWith = a.mean;
+	result->FrameMsWithout = b.mean;
+	result->PValue = 1.0;
+
+	if (a.count < 2.0 || b.count < 2.0)
+		return;
+
+	const auto cost = a.mean - b.mean;
+	const auto test = welch(a, b);
+
+	result->CostMs = cost;
+	result->CostLowerMs = cost;
+	result->CostUpperMs = cost;
+	result->CostPercent = b.mean > 0.0 ? cost / b.mean * 100.0 : 0.0;
+	result->PValue = test.p_greater;
+
+	const auto se = std::sqrt(a.variance / a.count + b.variance / b.count);
+
+	if (se > 0.0)
+	{
+		const auto margin = student_t_quantile(0.5 + confidence / 2.0, test.df) * se;
+
+		result->CostLowerMs = cost - margin;
+		result->CostUpperMs = cost + margin;
+	}
+}
+
+size_t Indicium::Core::Stats::OverheadExperiment::estimates(PINDICIUM_OVERHEAD_ESTIMATE values, size_t capacity)
+{
+	Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+	std::vector<Arm> arms;
+	double confidence;
+
+	//
+	// Only copy under the lock, the render thread waits on it at every window end
+	//
+	AcquireSRWLockShared(&samples_);
+
+	try
+	{
+		arms = arms_;
+		confidence = confidence_;
+	}
+	catch (...)
+	{
+		ReleaseSRWLockShared(&samples_);
+		throw;
+	}
+
+	ReleaseSRWLockShared(&samples_);
+
+	//
+	// The engine against suspended windows, every subscriber against fully active ones
+	//
+	const auto count = arms.empty() ? 0 : arms.size() - 1;
+
+	for (size_t i = 0; values && i < (std::min)(count, capacity); i++)
+	{
+		if (i == 0)
+		{
+			estimate(arms[1], arms[0], confidence, IndiciumOverheadSubjectEngine, &values[i]);
+			continue;
+		}
+
+		const auto& without = arms[i + 1];
+
+		estimate(arms[1], without, confidence,
+			without.variant == Variant::WithoutHost ? IndiciumOverheadSubjectHostCallbacks : IndiciumOverheadSubjectPlugin,
+			&values[i]);
+	}
+
+	return count;
+}
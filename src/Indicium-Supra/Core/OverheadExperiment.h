@@ -0,0 +1,156 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumFrameStatistics.h"
+#include "Indicium/Engine/IndiciumPlugin.h"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            /**
+             * \brief   Estimates the frame time cost of the engine and its subscribers by switching
+             *          them off and on in alternating windows of frames.
+             *
+             *          The render thread takes one timestamp per Present, on the suspended path
+             *          as well, and only takes the SRW lock when a window ends to append its
+             *          mean and switch variants. Switching only flips flags the hooks read
+             *          anyway. Readers copy the windows under the shared lock and do the
+             *          statistics after releasing it.
+             */
+            class OverheadExperiment
+            {
+                enum class Variant
+                {
+                    Suspended,
+                    Active,
+                    WithoutHost,
+                    WithoutPlugin
+                };
+
+                struct Arm
+                {
+                    Variant variant;
+                    PINDICIUM_PLUGIN plugin;
+
+                    //
+                    // Copied, the plugin may get unloaded while estimates are still read
+                    //
+                    std::string name;
+
+                    //
+                    // Mean frame time of every measured window in milliseconds
+                    //
+                    std::vector<double> windows;
+                };
+
+                std::mutex control_;
+                std::atomic<bool> running_;
+
+                //
+                // Bumped by every start, the render thread starts its window over
+                //
+                std::atomic<UINT32> epoch_;
+
+                //
+                // Guarded by samples_
+                //
+                SRWLOCK samples_;
+                UINT32 frames_per_window_;
+                UINT32 settle_frames_;
+                double confidence_;
+                std::vector<Arm> arms_;
+                std::vector<size_t> order_;
+                size_t position_;
+                ULONGLONG random_;
+
+                //
+                // Render thread state; guarded by framing_
+                //
+                std::atomic_flag framing_ = ATOMIC_FLAG_INIT;
+                UINT32 frame_epoch_;
+                UINT32 window_length_;
+                UINT32 settle_length_;
+                LONGLONG previous_;
+                UINT32 frame_;
+                LONGLONG window_ticks_;
+                UINT32 window_frames_;
+
+                double ticks_per_ms_;
+
+                void shuffle();
+
+                /**
+                 * \brief   Sets the flags the hooks check for the variant of the arm; exclusive
+                 *          samples_ lock held.
+                 */
+                static void apply(PINDICIUM_ENGINE engine, const Arm* arm);
+
+                void reset_window();
+
+                static void estimate(const Arm& with, const Arm& without, double confidence,
+                    INDICIUM_OVERHEAD_SUBJECT subject, PINDICIUM_OVERHEAD_ESTIMATE result);
+
+            public:
+                OverheadExperiment();
+
+                OverheadExperiment(const OverheadExperiment&) = delete;
+                OverheadExperiment& operator=(const OverheadExperiment&) = delete;
+
+                void start(PINDICIUM_ENGINE engine, const INDICIUM_OVERHEAD_AB_CONFIG& config);
+
+                /**
+                 * \brief   Stops alternating and restores full dispatch.
+                 */
+                void stop(PINDICIUM_ENGINE engine);
+
+                /**
+                 * \brief   Frame boundary, called first thing in every Present hook whether the
+                 *          engine is suspended or not.
+                 */
+                void on_frame(PINDICIUM_ENGINE engine);
+
+                /**
+                 * \brief   Writes up to capacity estimates and returns how many are available.
+                 *
+                 * \exception std::bad_alloc  Copying the windows failed.
+                 */
+                size_t estimates(PINDICIUM_OVERHEAD_ESTIMATE values, size_t capacity);
+            };
+        };
+    };
+};
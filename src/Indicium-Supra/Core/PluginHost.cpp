@@ -0,0 +1,251 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "PluginHost.h"
+#include "PostPresentTasks.h"
+#include "Memory.h"
+
+#include <spdlog/spdlog.h>
+
+#include <thread>
+#include <system_error>
+
+Indicium::Core::Plugins::PluginHost::PluginHost(PINDICIUM_ENGINE engine) :
+	engine_(engine),
+	active_(nullptr)
+{
+}
+
+Indicium::Core::Plugins::PluginHost::~PluginHost()
+{
+	//
+	// Regular unloading happens on the engine thread; if that never ran we might be
+	// inside DllMain and must not call into FreeLibrary, the process is going away
+	// 
+	for (const auto plugin : plugins_)
+	{
+		Memory::release(plugin->Context);
+		Memory::release(plugin);
+	}
+}
+
+PINDICIUM_PLUGIN Indicium::Core::Plugins::PluginHost::open(const std::string& path)
+{
+	auto logger = spdlog::get("indicium")->clone("plugins");
+
+	const auto module = LoadLibraryExA(path.c_str(), nullptr, LOAD_WITH_ALTERED_SEARCH_PATH);
+
+	if (!module) {
+		logger->error("Couldn't load {}: {}", path, GetLastError());
+		return nullptr;
+	}
+
+	const auto query = reinterpret_cast<PFN_INDICIUM_PLUGIN_QUERY>(
+		GetProcAddress(module, INDICIUM_PLUGIN_QUERY_EXPORT));
+	const auto load = reinterpret_cast<PFN_INDICIUM_PLUGIN_LOAD>(
+		GetProcAddress(module, INDICIUM_PLUGIN_LOAD_EXPORT));
+
+	//
+	// Not a plugin (e.g. a dependency placed next to one)
+	// 
+	if (!query || !load) {
+		logger->debug("{} doesn't export the plugin ABI, skipping", path);
+		FreeLibrary(module);
+		return nullptr;
+	}
+
+	INDICIUM_PLUGIN_INFO info;
+	ZeroMemory(&info, sizeof(INDICIUM_PLUGIN_INFO));
+
+	if (!query(&info)) {
+		logger->info("{} declined loading", path);
+		FreeLibrary(module);
+		return nullptr;
+	}
+
+	if (info.AbiVersion != INDICIUM_PLUGIN_ABI_VERSION) {
+		logger->error("{} targets plugin ABI {}, expected {}", path, info.AbiVersion, INDICIUM_PLUGIN_ABI_VERSION);
+		FreeLibrary(module);
+		return nullptr;
+	}
+
+	const auto plugin = static_cast<PINDICIUM_PLUGIN>(Memory::allocate(sizeof(INDICIUM_PLUGIN), IndiciumMemoryTagPlugins));
+
+	if (!plugin) {
+		FreeLibrary(module);
+		return nullptr;
+	}
+
+	ZeroMemory(plugin, sizeof(INDICIUM_PLUGIN));
+	plugin->Module = module;
+	plugin->Engine = engine_;
+	plugin->Info = info;
+	plugin->Load = load;
+	plugin->Unload = reinterpret_cast<PFN_INDICIUM_PLUGIN_UNLOAD>(
+		GetProcAddress(module, INDICIUM_PLUGIN_UNLOAD_EXPORT));
+	plugin->GameHooked = reinterpret_cast<PFN_INDICIUM_PLUGIN_GAME_HOOKED>(
+		GetProcAddress(module, INDICIUM_PLUGIN_GAME_HOOKED_EXPORT));
+
+	if (!plugin->Info.Name) {
+		plugin->Info.Name = "<unnamed>";
+	}
+
+	return plugin;
+}
+
+void Indicium::Core::Plugins::PluginHost::release(PINDICIUM_PLUGIN plugin)
+{
+	FreeLibrary(plugin->Module);
+	Memory::release(plugin->Context);
+	Memory::release(plugin);
+}
+
+void Indicium::Core::Plugins::PluginHost::load(const std::string& directory)
+{
+	auto logger = spdlog::get("indicium")->clone("plugins");
+
+	logger->info("Loading plugins from {}", directory);
+
+	//
+	// LoadLibrary serializes on the loader lock anyway, so map all candidates first
+	// 
+	WIN32_FIND_DATAA data;
+	const auto find = FindFirstFileA((directory + "\\*.dll").c_str(), &data);
+
+	if (find == INVALID_HANDLE_VALUE) {
+		logger->info("No plugins found");
+		return;
+	}
+
+	std::vector<PINDICIUM_PLUGIN> candidates;
+
+	do
+	{
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			continue;
+
+		const auto plugin = open(directory + "\\" + data.cFileName);
+
+		if (!plugin)
+			continue;
+
+		//
+		// Host library placed in its own plugin directory
+		// 
+		if (plugin->Module == engine_->HostInstance) {
+			release(plugin);
+			continue;
+		}
+
+		candidates.push_back(plugin);
+
+	} while (FindNextFileA(find, &data));
+
+	FindClose(find);
+
+	//
+	// Run the plugin initialization routines in parallel
+	// 
+	std::vector<std::thread> loaders;
+
+	for (const auto plugin : candidates)
+	{
+		const auto run = [plugin]()
+		{
+			plugin->LoadResult = plugin->Load(plugin->Engine, plugin);
+		};
+
+		try
+		{
+			loaders.emplace_back(run);
+		}
+		catch (const std::system_error&)
+		{
+			run();
+		}
+	}
+
+	for (auto& loader : loaders)
+	{
+		loader.join();
+	}
+
+	for (const auto plugin : candidates)
+	{
+		if (plugin->LoadResult != INDICIUM_ERROR_NONE) {
+			logger->error("Plugin {} failed to load: 0x{:X}", plugin->Info.Name, plugin->LoadResult);
+			release(plugin);
+			continue;
+		}
+
+		logger->info("Plugin {} (version {}) loaded", plugin->Info.Name, plugin->Info.Version);
+		plugins_.push_back(plugin);
+	}
+
+	//
+	// Hooks aren't active yet, but publish properly regardless
+	// 
+	active_.store(&plugins_, std::memory_order_release);
+}
+
+void Indicium::Core::Plugins::PluginHost::unload()
+{
+	active_.store(nullptr, std::memory_order_release);
+
+	for (auto it = plugins_.rbegin(); it != plugins_.rend(); ++it)
+	{
+		const auto plugin = *it;
+
+		if (plugin->Unload) {
+			plugin->Unload(plugin->Engine, plugin);
+		}
+
+		//
+		// Present hooks outlive the plugins, drop what they left behind before the code is gone
+		// 
+		if (engine_->PostPresentTasks) {
+			engine_->PostPresentTasks->remove_module(plugin->Module);
+		}
+
+		release(plugin);
+	}
+
+	plugins_.clear();
+}
+
+void Indicium::Core::Plugins::PluginHost::on_game_hooked(INDICIUM_D3D_VERSION version) const
+{
+	const auto plugins = active_.load(std::memory_order_acquire);
+
+	if (!plugins)
+		return;
+
+	for (const auto plugin : *plugins)
+	{
+		if (plugin->GameHooked) {
+			plugin->GameHooked(plugin, version);
+		}
+	}
+}
@@ -0,0 +1,210 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumDirect3D9.h"
+#include "Indicium/Engine/IndiciumDirect3D10.h"
+#include "Indicium/Engine/IndiciumDirect3D11.h"
+#include "Indicium/Engine/IndiciumDirect3D12.h"
+#include "Indicium/Engine/IndiciumCoreAudio.h"
+#include "Indicium/Engine/IndiciumPlugin.h"
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+//
+// Internal plugin instance properties
+//
+typedef struct _INDICIUM_PLUGIN
+{
+    //
+    // Plugin library handle
+    // 
+    HMODULE Module;
+
+    //
+    // Hosting engine
+    // 
+    PINDICIUM_ENGINE Engine;
+
+    //
+    // Information reported by the plugin
+    // 
+    INDICIUM_PLUGIN_INFO Info;
+
+    //
+    // Plugin exports
+    // 
+    PFN_INDICIUM_PLUGIN_LOAD Load;
+    PFN_INDICIUM_PLUGIN_UNLOAD Unload;
+    PFN_INDICIUM_PLUGIN_GAME_HOOKED GameHooked;
+
+    //
+    // Result of the plugin's load routine
+    // 
+    INDICIUM_ERROR LoadResult;
+
+    //
+    // Plugin owned context memory, passed along in event extensions
+    // 
+    PVOID Context;
+
+    //
+    // Plugin specific callbacks
+    // 
+    INDICIUM_D3D9_EVENT_CALLBACKS EventsD3D9;
+    INDICIUM_D3D10_EVENT_CALLBACKS EventsD3D10;
+    INDICIUM_D3D11_EVENT_CALLBACKS EventsD3D11;
+    INDICIUM_D3D12_EVENT_CALLBACKS EventsD3D12;
+    INDICIUM_ARC_EVENT_CALLBACKS EventsARC;
+
+    //
+    // Nonzero while the plugin's callbacks are left out of dispatch
+    // 
+    volatile LONG Skipped;
+
+} INDICIUM_PLUGIN;
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Plugins
+        {
+            /**
+             * \brief   Loads plugin libraries and fans engine events out to them.
+             *
+             *          Plugins get loaded on the engine thread before hooking; their load routines
+             *          run in parallel. The list of successfully loaded plugins is published once
+             *          and never modified while hooks are active, so dispatch on the render thread
+             *          is a plain array walk.
+             */
+            class PluginHost
+            {
+                PINDICIUM_ENGINE engine_;
+
+                std::vector<PINDICIUM_PLUGIN> plugins_;
+                std::atomic<const std::vector<PINDICIUM_PLUGIN>*> active_;
+
+                static const INDICIUM_D3D9_EVENT_CALLBACKS& events(const INDICIUM_PLUGIN* plugin, const INDICIUM_D3D9_EVENT_CALLBACKS*) { return plugin->EventsD3D9; }
+                static const INDICIUM_D3D10_EVENT_CALLBACKS& events(const INDICIUM_PLUGIN* plugin, const INDICIUM_D3D10_EVENT_CALLBACKS*) { return plugin->EventsD3D10; }
+                static const INDICIUM_D3D11_EVENT_CALLBACKS& events(const INDICIUM_PLUGIN* plugin, const INDICIUM_D3D11_EVENT_CALLBACKS*) { return plugin->EventsD3D11; }
+                static const INDICIUM_D3D12_EVENT_CALLBACKS& events(const INDICIUM_PLUGIN* plugin, const INDICIUM_D3D12_EVENT_CALLBACKS*) { return plugin->EventsD3D12; }
+                static const INDICIUM_ARC_EVENT_CALLBACKS& events(const INDICIUM_PLUGIN* plugin, const INDICIUM_ARC_EVENT_CALLBACKS*) { return plugin->EventsARC; }
+
+                //
+                // Event extensions get passed as copies carrying the context of the plugin invoked
+                //
+                template <typename T>
+                static T scoped(T arg, PVOID, INDICIUM_EVT_PRE_EXTENSION&, INDICIUM_EVT_POST_EXTENSION&)
+                {
+                    return arg;
+                }
+
+                static PINDICIUM_EVT_PRE_EXTENSION scoped(
+                    PINDICIUM_EVT_PRE_EXTENSION extension,
+                    PVOID context,
+                    INDICIUM_EVT_PRE_EXTENSION& pre,
+                    INDICIUM_EVT_POST_EXTENSION&
+                )
+                {
+                    INDICIUM_EVT_PRE_EXTENSION_INIT(&pre, extension->Engine, context);
+                    return &pre;
+                }
+
+                static PINDICIUM_EVT_POST_EXTENSION scoped(
+                    PINDICIUM_EVT_POST_EXTENSION extension,
+                    PVOID context,
+                    INDICIUM_EVT_PRE_EXTENSION&,
+                    INDICIUM_EVT_POST_EXTENSION& post
+                )
+                {
+                    INDICIUM_EVT_POST_EXTENSION_INIT(&post, extension->Engine, context);
+                    return &post;
+                }
+
+                PINDICIUM_PLUGIN open(const std::string& path);
+                void release(PINDICIUM_PLUGIN plugin);
+
+            public:
+                explicit PluginHost(PINDICIUM_ENGINE engine);
+                ~PluginHost();
+
+                PluginHost(const PluginHost&) = delete;
+                PluginHost& operator=(const PluginHost&) = delete;
+
+                /**
+                 * \brief   Loads all plugins found in directory; engine thread only.
+                 */
+                void load(const std::string& directory);
+
+                /**
+                 * \brief   Unloads all plugins; engine thread only, after hooks are removed.
+                 */
+                void unload();
+
+                void on_game_hooked(INDICIUM_D3D_VERSION version) const;
+
+                /**
+                 * \brief   The successfully loaded plugins, NULL before loading and after unloading.
+                 */
+                const std::vector<PINDICIUM_PLUGIN>* plugins() const
+                {
+                    return active_.load(std::memory_order_acquire);
+                }
+
+                /**
+                 * \brief   Invokes the given callback of every plugin which registered it.
+                 */
+                template <typename Callbacks, typename Callback, typename... Args>
+                void invoke(Callback Callbacks::* member, Args... args) const
+                {
+                    const auto plugins = active_.load(std::memory_order_acquire);
+
+                    if (!plugins)
+                        return;
+
+                    for (const auto plugin : *plugins)
+                    {
+                        const auto callback = events(plugin, static_cast<const Callbacks*>(nullptr)).*member;
+
+                        if (!callback || plugin->Skipped)
+                            continue;
+
+                        INDICIUM_EVT_PRE_EXTENSION pre;
+                        INDICIUM_EVT_POST_EXTENSION post;
+
+                        callback(scoped(args, plugin->Context, pre, post)...);
+                    }
+                }
+            };
+        };
+    };
+};
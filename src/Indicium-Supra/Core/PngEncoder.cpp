@@ -0,0 +1,717 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "PngEncoder.h"
+#include "WorkerPool.h"
+#include "Memory.h"
+
+#include <emmintrin.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+
+namespace
+{
+	const size_t BytesPerPixel = 3;
+
+	//
+	// Rows are converted behind this many zero bytes, so the left neighbours of the first
+	// pixel can be loaded like any other
+	//
+	const size_t RowPadding = 16;
+
+	const size_t WindowSize = 32768;
+	const size_t TargetChunkSize = 256 * 1024;
+
+	enum FilterType : BYTE
+	{
+		FilterNone = 0,
+		FilterSub = 1,
+		FilterUp = 2,
+		FilterAverage = 3,
+		FilterPaeth = 4
+	};
+
+	/**
+	 * \brief   Runs body(context, index) for every index on the calling thread and up to one job
+	 *          per engine worker; returns once every job left, so the state may live on the stack.
+	 *
+	 *          The caller works through the indices itself and takes helpers which did not
+	 *          start by then back off the queue, so it never depends on a worker being free:
+	 *          called from a worker, or with the pool shut down, everything runs inline.
+	 */
+	class ParallelFor
+	{
+		typedef void(*Body)(void* context, size_t index);
+
+		Body body_;
+		void* context_;
+		size_t count_;
+		std::atomic<size_t> next_;
+
+		std::mutex lock_;
+		std::condition_variable idle_;
+		size_t running_;
+
+		//
+		// Helpers account their allocations like the calling thread
+		//
+		INDICIUM_MEMORY_TAG tag_;
+
+		void work()
+		{
+			for (auto index = next_++; index < count_; index = next_++)
+				body_(context_, index);
+		}
+
+		static void job(void* argument, size_t)
+		{
+			const auto self = static_cast<ParallelFor*>(argument);
+
+			{
+				Indicium::Core::Memory::Scope scope(self->tag_);
+
+				self->work();
+			}
+
+			std::lock_guard<std::mutex> guard(self->lock_);
+
+			if (--self->running_ == 0)
+				self->idle_.notify_one();
+		}
+
+	public:
+		ParallelFor(Body body, void* context, size_t count) :
+			body_(body), context_(context), count_(count), next_(0), running_(0),
+			tag_(Indicium::Core::Memory::current_tag())
+		{
+		}
+
+		void run(Indicium::Core::Tasks::WorkerPool* workers)
+		{
+			if (!workers || count_ < 2 || workers->is_worker_thread())
+			{
+				work();
+				return;
+			}
+
+			const auto helpers = (std::min)(workers->size(), count_ - 1);
+
+			running_ = helpers;
+
+			for (size_t i = 0; i < helpers; i++)
+			{
+				if (!workers->submit(job, this, i))
+				{
+					std::lock_guard<std::mutex> guard(lock_);
+					running_ -= helpers - i;
+					break;
+				}
+			}
+
+			work();
+
+			//
+			// Helpers still queued would only find the work done
+			//
+			const auto cancelled = workers->cancel(job, this);
+
+			std::unique_lock<std::mutex> guard(lock_);
+
+			running_ -= cancelled;
+			idle_.wait(guard, [this]() { return running_ == 0; });
+		}
+	};
+
+	//
+	// Per-byte |x| of the filtered bytes taken as signed, summed; the usual PNG filter heuristic
+	//
+	inline __m128i AbsoluteSum(__m128i sum, __m128i value)
+	{
+		const auto zero = _mm_setzero_si128();
+		const auto magnitude = _mm_min_epu8(value, _mm_sub_epi8(zero, value));
+
+		return _mm_add_epi64(sum, _mm_sad_epu8(magnitude, zero));
+	}
+
+	inline size_t Total(__m128i sum)
+	{
+		return static_cast<size_t>(_mm_cvtsi128_si32(sum))
+			+ static_cast<size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sum, 8)));
+	}
+
+	inline size_t Magnitude(BYTE value)
+	{
+		return value < 128 ? value : 256 - value;
+	}
+
+	inline BYTE PaethPredictor(int a, int b, int c)
+	{
+		const auto pa = abs(b - c);
+		const auto pb = abs(a - c);
+		const auto pc = abs(a + b - 2 * c);
+
+		if (pa <= pb && pa <= pc)
+			return static_cast<BYTE>(a);
+
+		return static_cast<BYTE>(pb <= pc ? b : c);
+	}
+
+	//
+	// Filters below read cur[-3] and prev[-3], which the row padding provides
+	//
+
+	size_t SumNone(const BYTE* cur, size_t length)
+	{
+		auto sum = _mm_setzero_si128();
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+			sum = AbsoluteSum(sum, _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i)));
+
+		auto total = Total(sum);
+
+		for (; i < length; i++)
+			total += Magnitude(cur[i]);
+
+		return total;
+	}
+
+	size_t FilterRowSub(const BYTE* cur, const BYTE*, BYTE* out, size_t length)
+	{
+		auto sum = _mm_setzero_si128();
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+		{
+			const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i));
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i - BytesPerPixel));
+			const auto filtered = _mm_sub_epi8(x, a);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), filtered);
+			sum = AbsoluteSum(sum, filtered);
+		}
+
+		auto total = Total(sum);
+
+		for (; i < length; i++)
+		{
+			out[i] = static_cast<BYTE>(cur[i] - cur[i - BytesPerPixel]);
+			total += Magnitude(out[i]);
+		}
+
+		return total;
+	}
+
+	size_t FilterRowUp(const BYTE* cur, const BYTE* prev, BYTE* out, size_t length)
+	{
+		auto sum = _mm_setzero_si128();
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+		{
+			const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+			const auto filtered = _mm_sub_epi8(x, b);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), filtered);
+			sum = AbsoluteSum(sum, filtered);
+		}
+
+		auto total = Total(sum);
+
+		for (; i < length; i++)
+		{
+			out[i] = static_cast<BYTE>(cur[i] - prev[i]);
+			total += Magnitude(out[i]);
+		}
+
+		return total;
+	}
+
+	size_t FilterRowAverage(const BYTE* cur, const BYTE* prev, BYTE* out, size_t length)
+	{
+		const auto one = _mm_set1_epi8(1);
+		auto sum = _mm_setzero_si128();
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+		{
+			const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i));
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i - BytesPerPixel));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+
+			//
+			// pavgb rounds up, PNG rounds down
+			//
+			const auto average = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+			const auto filtered = _mm_sub_epi8(x, average);
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), filtered);
+			sum = AbsoluteSum(sum, filtered);
+		}
+
+		auto total = Total(sum);
+
+		for (; i < length; i++)
+		{
+			out[i] = static_cast<BYTE>(cur[i] - ((cur[i - BytesPerPixel] + prev[i]) >> 1));
+			total += Magnitude(out[i]);
+		}
+
+		return total;
+	}
+
+	inline __m128i PaethPredictor16(__m128i a, __m128i b, __m128i c)
+	{
+		const auto zero = _mm_setzero_si128();
+		const auto bc = _mm_sub_epi16(b, c);
+		const auto ac = _mm_sub_epi16(a, c);
+		const auto sum = _mm_add_epi16(bc, ac);
+
+		const auto pa = _mm_max_epi16(bc, _mm_sub_epi16(zero, bc));
+		const auto pb = _mm_max_epi16(ac, _mm_sub_epi16(zero, ac));
+		const auto pc = _mm_max_epi16(sum, _mm_sub_epi16(zero, sum));
+
+		const auto not_a = _mm_or_si128(_mm_cmpgt_epi16(pa, pb), _mm_cmpgt_epi16(pa, pc));
+		const auto not_b = _mm_cmpgt_epi16(pb, pc);
+
+		const auto use_a = _mm_andnot_si128(not_a, a);
+		const auto use_b = _mm_andnot_si128(not_b, b);
+		const auto use_c = _mm_and_si128(not_b, c);
+
+		//
+		// b or c where a loses, picked by not_b
+		//
+		return _mm_or_si128(use_a, _mm_and_si128(not_a, _mm_or_si128(use_b, use_c)));
+	}
+
+	size_t FilterRowPaeth(const BYTE* cur, const BYTE* prev, BYTE* out, size_t length)
+	{
+		const auto zero = _mm_setzero_si128();
+		auto sum = _mm_setzero_si128();
+		size_t i = 0;
+
+		for (; i + 16 <= length; i += 16)
+		{
+			const auto x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i));
+			const auto a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cur + i - BytesPerPixel));
+			const auto b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i));
+			const auto c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(prev + i - BytesPerPixel));
+
+			const auto low = PaethPredictor16(
+				_mm_unpacklo_epi8(a, zero), _mm_unpacklo_epi8(b, zero), _mm_unpacklo_epi8(c, zero));
+			const auto high = PaethPredictor16(
+				_mm_unpackhi_epi8(a, zero), _mm_unpackhi_epi8(b, zero), _mm_unpackhi_epi8(c, zero));
+
+			const auto filtered = _mm_sub_epi8(x, _mm_packus_epi16(low, high));
+
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), filtered);
+			sum = AbsoluteSum(sum, filtered);
+		}
+
+		auto total = Total(sum);
+
+		for (; i < length; i++)
+		{
+			out[i] = static_cast<BYTE>(cur[i] - PaethPredictor(
+				cur[i - BytesPerPixel], prev[i], prev[i - BytesPerPixel]));
+			total += Magnitude(out[i]);
+		}
+
+		return total;
+	}
+
+	void WriteBigEndian(std::vector<BYTE>& out, UINT32 value)
+	{
+		const BYTE bytes[] = {
+			static_cast<BYTE>(value >> 24),
+			static_cast<BYTE>(value >> 16),
+			static_cast<BYTE>(value >> 8),
+			static_cast<BYTE>(value)
+		};
+
+		out.insert(out.end(), bytes, bytes + sizeof(bytes));
+	}
+
+	void WriteChunk(std::vector<BYTE>& out, const char* type, const BYTE* data, size_t size)
+	{
+		WriteBigEndian(out, static_cast<UINT32>(size));
+
+		const auto start = out.size();
+		out.insert(out.end(), type, type + 4);
+		out.insert(out.end(), data, data + size);
+
+		WriteBigEndian(out, crc32(0, out.data() + start, static_cast<uInt>(out.size() - start)));
+	}
+}
+
+Indicium::Core::Capture::PngEncoder::PngEncoder(
+	const INDICIUM_CAPTURED_FRAME& frame,
+	Layout layout,
+	const INDICIUM_PNG_CONFIG& config
+) :
+	frame_(frame),
+	layout_(layout),
+	level_((std::max)(1, (std::min)(9, config.CompressionLevel))),
+	row_bytes_(static_cast<size_t>(frame.Width) * BytesPerPixel)
+{
+	const auto rows = rows_per_chunk(frame.Width, frame.Height, config);
+
+	chunks_.resize((frame.Height + rows - 1) / rows);
+
+	for (size_t i = 0; i < chunks_.size(); i++)
+	{
+		auto& chunk = chunks_[i];
+
+		chunk.first_row = static_cast<UINT32>(i * rows);
+		chunk.rows = (std::min)(rows, frame.Height - chunk.first_row);
+		chunk.deflated_size = 0;
+		chunk.adler = 0;
+		chunk.crc = 0;
+		chunk.failed = false;
+	}
+}
+
+UINT32 Indicium::Core::Capture::PngEncoder::rows_per_chunk(
+	UINT32 width,
+	UINT32 height,
+	const INDICIUM_PNG_CONFIG& config
+)
+{
+	if (config.RowsPerChunk)
+		return (std::min)(config.RowsPerChunk, (std::max)(height, 1u));
+
+	const auto filtered_row = static_cast<size_t>(width) * BytesPerPixel + 1;
+
+	return static_cast<UINT32>((std::max)(size_t(8), TargetChunkSize / filtered_row));
+}
+
+size_t Indicium::Core::Capture::PngEncoder::chunk_bound(size_t filtered_size)
+{
+	//
+	// Sync flush and zlib header on top of zlib's own worst case
+	//
+	return compressBound(static_cast<uLong>(filtered_size)) + 16;
+}
+
+bool Indicium::Core::Capture::PngEncoder::layout_of(const INDICIUM_CAPTURED_FRAME& frame, Layout* layout)
+{
+	if (frame.Version == IndiciumDirect3DVersion9)
+	{
+		switch (frame.Format)
+		{
+		case 21:    // D3DFMT_A8R8G8B8
+		case 22:    // D3DFMT_X8R8G8B8
+			*layout = Layout::bgra8;
+			return true;
+		case 32:    // D3DFMT_A8B8G8R8
+		case 33:    // D3DFMT_X8B8G8R8
+			*layout = Layout::rgba8;
+			return true;
+		case 31:    // D3DFMT_A2B10G10R10
+			*layout = Layout::rgb10a2;
+			return true;
+		case 35:    // D3DFMT_A2R10G10B10
+			*layout = Layout::bgr10a2;
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	switch (frame.Format)
+	{
+	case 24:    // DXGI_FORMAT_R10G10B10A2_UNORM
+		*layout = Layout::rgb10a2;
+		return true;
+	case 28:    // DXGI_FORMAT_R8G8B8A8_UNORM
+	case 29:    // DXGI_FORMAT_R8G8B8A8_UNORM_SRGB
+		*layout = Layout::rgba8;
+		return true;
+	case 87:    // DXGI_FORMAT_B8G8R8A8_UNORM
+	case 88:    // DXGI_FORMAT_B8G8R8X8_UNORM
+	case 91:    // DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
+	case 93:    // DXGI_FORMAT_B8G8R8X8_UNORM_SRGB
+		*layout = Layout::bgra8;
+		return true;
+	default:
+		return false;
+	}
+}
+
+size_t Indicium::Core::Capture::PngEncoder::bound(const INDICIUM_CAPTURED_FRAME& frame, const INDICIUM_PNG_CONFIG& config)
+{
+	const auto rows = rows_per_chunk(frame.Width, frame.Height, config);
+	const auto filtered_row = static_cast<size_t>(frame.Width) * BytesPerPixel + 1;
+
+	//
+	// Signature, IHDR, IEND and the Adler-32 trailer
+	//
+	size_t size = 8 + 25 + 12 + 4;
+
+	for (UINT32 row = 0; row < frame.Height; row += rows)
+	{
+		const auto chunk_rows = (std::min)(rows, frame.Height - row);
+		size += chunk_bound(chunk_rows * filtered_row) + 12;
+	}
+
+	return size;
+}
+
+void Indicium::Core::Capture::PngEncoder::convert_row(UINT32 row, BYTE* rgb) const
+{
+	const auto source = frame_.Data + static_cast<size_t>(row) * frame_.Pitch;
+
+	switch (layout_)
+	{
+	case Layout::rgba8:
+		for (UINT32 x = 0; x < frame_.Width; x++, rgb += 3)
+		{
+			rgb[0] = source[x * 4];
+			rgb[1] = source[x * 4 + 1];
+			rgb[2] = source[x * 4 + 2];
+		}
+		break;
+	case Layout::bgra8:
+		for (UINT32 x = 0; x < frame_.Width; x++, rgb += 3)
+		{
+			rgb[0] = source[x * 4 + 2];
+			rgb[1] = source[x * 4 + 1];
+			rgb[2] = source[x * 4];
+		}
+		break;
+	case Layout::rgb10a2:
+	case Layout::bgr10a2:
+	{
+		const auto swap = layout_ == Layout::bgr10a2;
+
+		for (UINT32 x = 0; x < frame_.Width; x++, rgb += 3)
+		{
+			UINT32 pixel;
+			memcpy(&pixel, source + x * 4, sizeof(pixel));
+
+			const auto first = static_cast<BYTE>((pixel & 0x3FF) >> 2);
+			const auto last = static_cast<BYTE>(((pixel >> 20) & 0x3FF) >> 2);
+
+			rgb[0] = swap ? last : first;
+			rgb[1] = static_cast<BYTE>(((pixel >> 10) & 0x3FF) >> 2);
+			rgb[2] = swap ? first : last;
+		}
+		break;
+	}
+	}
+}
+
+void Indicium::Core::Capture::PngEncoder::filter_chunk(size_t index)
+{
+	auto& chunk = chunks_[index];
+
+	//
+	// Rows live behind zero padding, the row above the image is all zeros too
+	//
+	std::vector<BYTE> rows(2 * (RowPadding + row_bytes_), 0);
+	std::vector<BYTE> candidates(4 * row_bytes_);
+
+	auto prev = rows.data() + RowPadding;
+	auto cur = prev + row_bytes_ + RowPadding;
+
+	if (chunk.first_row > 0)
+		convert_row(chunk.first_row - 1, prev);
+
+	chunk.filtered.resize(chunk.rows * (row_bytes_ + 1));
+	auto out = chunk.filtered.data();
+
+	for (UINT32 row = chunk.first_row; row < chunk.first_row + chunk.rows; row++)
+	{
+		convert_row(row, cur);
+
+		BYTE* const filtered[] = {
+			candidates.data(),
+			candidates.data() + row_bytes_,
+			candidates.data() + 2 * row_bytes_,
+			candidates.data() + 3 * row_bytes_
+		};
+
+		const size_t sums[] = {
+			SumNone(cur, row_bytes_),
+			FilterRowSub(cur, prev, filtered[0], row_bytes_),
+			FilterRowUp(cur, prev, filtered[1], row_bytes_),
+			FilterRowAverage(cur, prev, filtered[2], row_bytes_),
+			FilterRowPaeth(cur, prev, filtered[3], row_bytes_)
+		};
+
+		const auto best = std::min_element(sums, sums + 5) - sums;
+
+		*out++ = static_cast<BYTE>(best);
+		memcpy(out, best == FilterNone ? cur : filtered[best - 1], row_bytes_);
+		out += row_bytes_;
+
+		std::swap(prev, cur);
+	}
+}
+
+void Indicium::Core::Capture::PngEncoder::deflate_chunk(size_t index)
+{
+	auto& chunk = chunks_[index];
+	const auto last = index + 1 == chunks_.size();
+
+	chunk.adler = adler32(adler32(0, Z_NULL, 0), chunk.filtered.data(), static_cast<uInt>(chunk.filtered.size()));
+	chunk.deflated.resize(chunk_bound(chunk.filtered.size()));
+
+	size_t offset = 0;
+
+	if (index == 0)
+	{
+		const BYTE method = 0x78;   // deflate, 32 KiB window
+		BYTE flags = static_cast<BYTE>((level_ < 2 ? 0 : level_ < 6 ? 1 : level_ == 6 ? 2 : 3) << 6);
+		flags += static_cast<BYTE>((31 - (method * 256 + flags) % 31) % 31);
+
+		chunk.deflated[offset++] = method;
+		chunk.deflated[offset++] = flags;
+	}
+
+	z_stream stream;
+	memset(&stream, 0, sizeof(stream));
+
+	stream.zalloc = [](voidpf, uInt items, uInt size) -> voidpf
+	{
+		return Memory::allocate(size_t(items) * size, IndiciumMemoryTagCapture);
+	};
+	stream.zfree = [](voidpf, voidpf block)
+	{
+		Memory::release(block);
+	};
+
+	if (deflateInit2(&stream, level_, Z_DEFLATED, -15, 8, Z_FILTERED) != Z_OK)
+	{
+		chunk.failed = true;
+		return;
+	}
+
+	if (index > 0)
+	{
+		const auto& previous = chunks_[index - 1].filtered;
+		const auto window = (std::min)(previous.size(), WindowSize);
+
+		deflateSetDictionary(&stream, previous.data() + previous.size() - window, static_cast<uInt>(window));
+	}
+
+	stream.next_in = chunk.filtered.data();
+	stream.avail_in = static_cast<uInt>(chunk.filtered.size());
+	stream.next_out = chunk.deflated.data() + offset;
+	stream.avail_out = static_cast<uInt>(chunk.deflated.size() - offset);
+
+	const auto result = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+
+	chunk.failed = last
+		? result != Z_STREAM_END
+		: result != Z_OK || stream.avail_in != 0 || stream.avail_out == 0;
+
+	chunk.deflated_size = offset + stream.total_out;
+
+	deflateEnd(&stream);
+
+	//
+	// The last chunk gets the Adler-32 trailer appended once all checksums are in
+	//
+	const BYTE type[] = { 'I', 'D', 'A', 'T' };
+	chunk.crc = crc32(crc32(0, type, sizeof(type)), chunk.deflated.data(), static_cast<uInt>(chunk.deflated_size));
+}
+
+INDICIUM_ERROR Indicium::Core::Capture::PngEncoder::encode(Tasks::WorkerPool* workers, std::vector<BYTE>& png)
+{
+	ParallelFor filtering([](void* context, size_t index)
+	{
+		static_cast<PngEncoder*>(context)->filter_chunk(index);
+	}, this, chunks_.size());
+
+	filtering.run(workers);
+
+	ParallelFor compression([](void* context, size_t index)
+	{
+		static_cast<PngEncoder*>(context)->deflate_chunk(index);
+	}, this, chunks_.size());
+
+	compression.run(workers);
+
+	auto adler = adler32(0, Z_NULL, 0);
+
+	for (const auto& chunk : chunks_)
+	{
+		if (chunk.failed)
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+
+		adler = adler32_combine(adler, chunk.adler, static_cast<z_off_t>(chunk.filtered.size()));
+	}
+
+	png.clear();
+
+	static const BYTE signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	png.insert(png.end(), signature, signature + sizeof(signature));
+
+	//
+	// 8 bits per channel truecolor, no interlacing
+	//
+	std::vector<BYTE> header;
+	WriteBigEndian(header, frame_.Width);
+	WriteBigEndian(header, frame_.Height);
+	header.insert(header.end(), { 8, 2, 0, 0, 0 });
+	WriteChunk(png, "IHDR", header.data(), header.size());
+
+	for (size_t i = 0; i < chunks_.size(); i++)
+	{
+		const auto& chunk = chunks_[i];
+		const auto last = i + 1 == chunks_.size();
+
+		WriteBigEndian(png, static_cast<UINT32>(chunk.deflated_size + (last ? 4 : 0)));
+		png.insert(png.end(), { 'I', 'D', 'A', 'T' });
+		png.insert(png.end(), chunk.deflated.data(), chunk.deflated.data() + chunk.deflated_size);
+
+		auto crc = chunk.crc;
+
+		if (last)
+		{
+			const BYTE trailer[] = {
+				static_cast<BYTE>(adler >> 24),
+				static_cast<BYTE>(adler >> 16),
+				static_cast<BYTE>(adler >> 8),
+				static_cast<BYTE>(adler)
+			};
+
+			png.insert(png.end(), trailer, trailer + sizeof(trailer));
+			crc = crc32(crc, trailer, sizeof(trailer));
+		}
+
+		WriteBigEndian(png, static_cast<UINT32>(crc));
+	}
+
+	WriteChunk(png, "IEND", nullptr, 0);
+
+	return INDICIUM_ERROR_NONE;
+}
@@ -0,0 +1,115 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumCapture.h"
+#include "Indicium/Engine/IndiciumScreenshot.h"
+
+#include <zlib.h>
+
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Tasks
+        {
+            class WorkerPool;
+        };
+
+        namespace Capture
+        {
+            /**
+             * \brief   PNG encoder for captured frames, splitting the image into chunks of rows.
+             *
+             *          Every chunk is filtered and then deflated on its own, in two parallel passes
+             *          over the encode workers and the calling thread. The second pass primes each
+             *          chunk with the last 32 KiB of the previous one and ends it with a sync flush,
+             *          so the raw deflate streams concatenate into one valid zlib stream; Adler-32
+             *          checksums of the chunks get combined at the end.
+             */
+            class PngEncoder
+            {
+            public:
+                enum class Layout
+                {
+                    rgba8,
+                    bgra8,
+                    rgb10a2,
+                    bgr10a2
+                };
+
+            private:
+                struct Chunk
+                {
+                    UINT32 first_row;
+                    UINT32 rows;
+                    std::vector<BYTE> filtered;
+                    std::vector<BYTE> deflated;
+                    size_t deflated_size;
+                    uLong adler;
+                    uLong crc;
+                    bool failed;
+                };
+
+                const INDICIUM_CAPTURED_FRAME& frame_;
+                Layout layout_;
+                int level_;
+                size_t row_bytes_;
+                std::vector<Chunk> chunks_;
+
+                void convert_row(UINT32 row, BYTE* rgb) const;
+                void filter_chunk(size_t index);
+                void deflate_chunk(size_t index);
+
+                static UINT32 rows_per_chunk(UINT32 width, UINT32 height, const INDICIUM_PNG_CONFIG& config);
+                static size_t chunk_bound(size_t filtered_size);
+
+            public:
+                PngEncoder(const INDICIUM_CAPTURED_FRAME& frame, Layout layout, const INDICIUM_PNG_CONFIG& config);
+
+                PngEncoder(const PngEncoder&) = delete;
+                PngEncoder& operator=(const PngEncoder&) = delete;
+
+                /**
+                 * \brief   Encodes the frame; workers may be NULL to encode on the calling thread only.
+                 */
+                INDICIUM_ERROR encode(Tasks::WorkerPool* workers, std::vector<BYTE>& png);
+
+                static bool layout_of(const INDICIUM_CAPTURED_FRAME& frame, Layout* layout);
+
+                /**
+                 * \brief   Largest PNG encode may produce for the frame.
+                 */
+                static size_t bound(const INDICIUM_CAPTURED_FRAME& frame, const INDICIUM_PNG_CONFIG& config);
+            };
+        };
+    };
+};
@@ -0,0 +1,368 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "PostPresentTasks.h"
+
+#include <algorithm>
+
+Indicium::Core::Tasks::PostPresentTasks::PostPresentTasks(WorkerPool& pool, Stats::CounterRegistry& counters) :
+	pool_(pool),
+	graph_(nullptr),
+	rendering_(nullptr),
+	current_(nullptr),
+	outstanding_(0),
+	running_(false),
+	frame_number_(0)
+{
+	ZeroMemory(&frame_, sizeof(INDICIUM_POST_PRESENT_FRAME));
+
+	counters.attach("tasks.frames_dispatched", dispatched_);
+	counters.attach("tasks.frames_skipped", skipped_);
+	counters.attach("tasks.executed", executed_);
+}
+
+INDICIUM_ERROR Indicium::Core::Tasks::PostPresentTasks::add(const INDICIUM_POST_PRESENT_TASK& task, INDICIUM_TASK_ID* id)
+{
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	const auto previous = graph_.load(std::memory_order_relaxed);
+	const auto index = previous ? static_cast<UINT32>(previous->nodes.size()) : 0;
+
+	auto graph = std::make_unique<Graph>();
+
+	if (previous)
+		graph->nodes = previous->nodes;
+
+	Node node;
+	node.routine = task.EvtIndiciumPostPresentTask;
+	node.context = task.Context;
+	node.uses_device = task.UsesDeviceContext != FALSE;
+	node.module = nullptr;
+	node.dependencies = 0;
+
+	GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+		reinterpret_cast<LPCSTR>(node.routine), &node.module);
+
+	for (UINT32 i = 0; i < task.DependencyCount; i++)
+	{
+		const auto dependency = task.Dependencies[i];
+
+		if (dependency >= index)
+			return INDICIUM_ERROR_INVALID_PARAMETER;
+
+		auto& parent = graph->nodes[dependency];
+
+		//
+		// Render thread tasks run before any worker task starts, so such dependencies are
+		// always satisfied; the reverse would stall the render thread
+		//
+		if (parent.uses_device)
+			continue;
+
+		if (node.uses_device)
+			return INDICIUM_ERROR_INVALID_PARAMETER;
+
+		parent.dependents.push_back(index);
+		node.dependencies++;
+	}
+
+	graph->nodes.push_back(node);
+
+	publish(std::move(graph));
+
+	if (id)
+		*id = index;
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_ERROR Indicium::Core::Tasks::PostPresentTasks::remove(INDICIUM_TASK_ID id)
+{
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	const auto previous = graph_.load(std::memory_order_relaxed);
+
+	if (!previous || id >= previous->nodes.size() || !previous->nodes[id].routine)
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+
+	auto graph = std::make_unique<Graph>();
+	graph->nodes = previous->nodes;
+
+	//
+	// Dependents keep running, the removed task counts as completed for them
+	//
+	graph->nodes[id].routine = nullptr;
+
+	publish(std::move(graph));
+	quiesce();
+	reclaim();
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::remove_module(HMODULE module)
+{
+	std::lock_guard<std::mutex> guard(writer_lock_);
+
+	const auto previous = graph_.load(std::memory_order_relaxed);
+
+	//
+	// Routines whose module couldn't be determined have none
+	//
+	if (!previous || !module)
+		return;
+
+	auto graph = std::make_unique<Graph>();
+	graph->nodes = previous->nodes;
+
+	size_t removed = 0;
+
+	for (auto& node : graph->nodes)
+	{
+		if (node.routine && node.module == module)
+		{
+			node.routine = nullptr;
+			removed++;
+		}
+	}
+
+	if (!removed)
+		return;
+
+	publish(std::move(graph));
+	quiesce();
+	reclaim();
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::publish(std::unique_ptr<Graph> graph)
+{
+	graph->workers = 0;
+
+	for (UINT32 i = 0; i < graph->nodes.size(); i++)
+	{
+		const auto& current = graph->nodes[i];
+
+		if (current.uses_device)
+		{
+			if (current.routine)
+				graph->inline_.push_back(i);
+
+			continue;
+		}
+
+		//
+		// Removed worker tasks stay in the graph as no-ops, their dependents wait for them
+		//
+		graph->workers++;
+
+		if (current.dependencies == 0)
+			graph->roots.push_back(i);
+	}
+
+	graph->pending.reset(new std::atomic<UINT32>[graph->nodes.size()]);
+
+	graph_.store(graph.get(), std::memory_order_seq_cst);
+	graphs_.push_back(std::move(graph));
+
+	reclaim();
+}
+
+bool Indicium::Core::Tasks::PostPresentTasks::in_use(const Graph* graph) const
+{
+	//
+	// The render thread clears rendering_ only after handing the graph to running_
+	//
+	if (rendering_.load(std::memory_order_seq_cst) == graph)
+		return true;
+
+	return running_.load(std::memory_order_acquire) && current_.load(std::memory_order_relaxed) == graph;
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::quiesce() const
+{
+	const auto latest = graph_.load(std::memory_order_relaxed);
+
+	for (;;)
+	{
+		const auto rendering = rendering_.load(std::memory_order_seq_cst);
+
+		if ((!rendering || rendering == latest)
+			&& (!running_.load(std::memory_order_acquire) || current_.load(std::memory_order_relaxed) == latest))
+			return;
+
+		Sleep(1);
+	}
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::reclaim()
+{
+	const auto latest = graph_.load(std::memory_order_relaxed);
+
+	graphs_.erase(std::remove_if(graphs_.begin(), graphs_.end(), [&](const std::unique_ptr<Graph>& graph)
+	{
+		return graph.get() != latest && !in_use(graph.get());
+	}), graphs_.end());
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::execute(void* argument, size_t index)
+{
+	const auto self = static_cast<PostPresentTasks*>(argument);
+	const auto graph = self->current_.load(std::memory_order_relaxed);
+	const auto& node = graph->nodes[index];
+
+	if (node.routine)
+	{
+		node.routine(&self->frame_, node.context);
+		self->executed_.add();
+	}
+
+	for (const auto dependent : node.dependents)
+	{
+		if (graph->pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			self->submit(graph, dependent);
+	}
+
+	self->complete();
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::submit(Graph* graph, UINT32 index)
+{
+	//
+	// Fails once the pool shuts down, the frame has to end regardless
+	//
+	if (!pool_.submit(&PostPresentTasks::execute, this, index))
+		abandon(graph, index);
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::abandon(Graph* graph, UINT32 index)
+{
+	for (const auto dependent : graph->nodes[index].dependents)
+	{
+		if (graph->pending[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+			abandon(graph, dependent);
+	}
+
+	complete();
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::complete()
+{
+	if (outstanding_.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		running_.store(false, std::memory_order_release);
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::run(
+	PINDICIUM_ENGINE engine,
+	INDICIUM_D3D_VERSION version,
+	PVOID presenter,
+	HRESULT result
+)
+{
+	auto graph = graph_.load(std::memory_order_seq_cst);
+
+	//
+	// Announce the graph before using it; a writer replacing it in between either sees the
+	// announcement or gets seen by the check
+	//
+	for (;;)
+	{
+		if (!graph)
+			return;
+
+		rendering_.store(graph, std::memory_order_seq_cst);
+
+		const auto latest = graph_.load(std::memory_order_seq_cst);
+
+		if (latest == graph)
+			break;
+
+		graph = latest;
+	}
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	INDICIUM_POST_PRESENT_FRAME frame;
+	frame.Engine = engine;
+	frame.FrameNumber = frame_number_++;
+	frame.Timestamp = now.QuadPart;
+	frame.Version = version;
+	frame.PresentResult = result;
+	frame.Presenter = presenter;
+
+	dispatch(graph, frame);
+
+	rendering_.store(nullptr, std::memory_order_seq_cst);
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::dispatch(Graph* graph, INDICIUM_POST_PRESENT_FRAME& frame)
+{
+	for (const auto index : graph->inline_)
+	{
+		const auto& node = graph->nodes[index];
+		node.routine(&frame, node.context);
+	}
+
+	executed_.add(graph->inline_.size());
+
+	if (!graph->workers)
+		return;
+
+	if (running_.load(std::memory_order_acquire))
+	{
+		skipped_.add();
+		return;
+	}
+
+	//
+	// Workers must not get hold of the device
+	//
+	frame.Presenter = nullptr;
+
+	current_.store(graph, std::memory_order_relaxed);
+	frame_ = frame;
+
+	for (size_t i = 0; i < graph->nodes.size(); i++)
+	{
+		graph->pending[i].store(graph->nodes[i].dependencies, std::memory_order_relaxed);
+	}
+
+	outstanding_.store(graph->workers, std::memory_order_relaxed);
+	running_.store(true, std::memory_order_release);
+
+	dispatched_.add();
+
+	for (const auto root : graph->roots)
+	{
+		submit(graph, root);
+	}
+}
+
+void Indicium::Core::Tasks::PostPresentTasks::statistics(PINDICIUM_POST_PRESENT_STATISTICS stats) const
+{
+	stats->FramesDispatched = dispatched_.load();
+	stats->FramesSkipped = skipped_.load();
+	stats->TasksExecuted = executed_.load();
+}
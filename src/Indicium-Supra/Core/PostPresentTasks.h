@@ -0,0 +1,195 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumTasks.h"
+
+#include "WorkerPool.h"
+#include "Counters.h"
+
+#include "Utils/ShardedCounter.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Tasks
+        {
+            /**
+             * \brief   Runs the registered Post-Present tasks once per frame. Tasks using the device
+             *          context run inline on the render thread in registration order; all others
+             *          are fanned out to the worker pool, each starting as soon as its
+             *          dependencies completed.
+             *
+             *          Only one frame's worker tasks are in flight at any time; if they are still
+             *          running at the next Present the frame is skipped for them and counted.
+             *
+             *          Every change publishes a new immutable graph. The render thread announces
+             *          the graph it dispatches in rendering_, so replaced graphs get freed once
+             *          neither it nor a frame in flight uses them.
+             */
+            class PostPresentTasks
+            {
+                struct Node
+                {
+                    //
+                    // NULL once removed; the identifiers of later tasks stay valid
+                    //
+                    PFN_INDICIUM_POST_PRESENT_TASK routine;
+                    PVOID context;
+                    bool uses_device;
+
+                    //
+                    // Module containing the routine, to drop the tasks of unloaded plugins
+                    //
+                    HMODULE module;
+
+                    //
+                    // Number of worker tasks this one waits for
+                    //
+                    UINT32 dependencies;
+
+                    //
+                    // Worker tasks waiting for this one
+                    //
+                    std::vector<UINT32> dependents;
+                };
+
+                //
+                // Immutable snapshot of the registered tasks
+                //
+                struct Graph
+                {
+                    std::vector<Node> nodes;
+                    std::vector<UINT32> inline_;
+                    std::vector<UINT32> roots;
+                    UINT32 workers;
+                    std::unique_ptr<std::atomic<UINT32>[]> pending;
+                };
+
+                WorkerPool& pool_;
+
+                std::atomic<Graph*> graph_;
+
+                //
+                // Graph the render thread is dispatching right now
+                //
+                std::atomic<Graph*> rendering_;
+
+                //
+                // State of the frame in flight; owned by the workers while running_ is set
+                //
+                std::atomic<Graph*> current_;
+                INDICIUM_POST_PRESENT_FRAME frame_;
+                std::atomic<UINT32> outstanding_;
+                std::atomic<bool> running_;
+
+                ULONGLONG frame_number_;
+
+                Util::ShardedCounter dispatched_;
+                Util::ShardedCounter skipped_;
+                Util::ShardedCounter executed_;
+
+                //
+                // Writer side; replaced graphs stay alive until no thread uses them anymore
+                //
+                std::mutex writer_lock_;
+                std::vector<std::unique_ptr<Graph>> graphs_;
+
+                static void execute(void* argument, size_t index);
+
+                void submit(Graph* graph, UINT32 index);
+
+                /**
+                 * \brief   Accounts a task which couldn't be queued as done, together with the
+                 *          tasks depending on it.
+                 */
+                void abandon(Graph* graph, UINT32 index);
+
+                void complete();
+
+                void dispatch(Graph* graph, INDICIUM_POST_PRESENT_FRAME& frame);
+
+                /**
+                 * \brief   Builds the derived tables of graph and makes it the current one; writer
+                 *          lock held.
+                 */
+                void publish(std::unique_ptr<Graph> graph);
+
+                bool in_use(const Graph* graph) const;
+
+                /**
+                 * \brief   Waits until only the current graph is in use; writer lock held.
+                 */
+                void quiesce() const;
+
+                /**
+                 * \brief   Frees replaced graphs nobody uses anymore; writer lock held.
+                 */
+                void reclaim();
+
+            public:
+                PostPresentTasks(WorkerPool& pool, Stats::CounterRegistry& counters);
+
+                PostPresentTasks(const PostPresentTasks&) = delete;
+                PostPresentTasks& operator=(const PostPresentTasks&) = delete;
+
+                INDICIUM_ERROR add(const INDICIUM_POST_PRESENT_TASK& task, INDICIUM_TASK_ID* id);
+
+                /**
+                 * \brief   Removes a task and waits until no thread runs it anymore; not callable
+                 *          from tasks.
+                 */
+                INDICIUM_ERROR remove(INDICIUM_TASK_ID id);
+
+                /**
+                 * \brief   Removes the tasks whose routines live in module, before it gets unloaded.
+                 */
+                void remove_module(HMODULE module);
+
+                /**
+                 * \brief   Starts this frame's tasks; render thread only.
+                 */
+                void run(
+                    PINDICIUM_ENGINE engine,
+                    INDICIUM_D3D_VERSION version,
+                    PVOID presenter,
+                    HRESULT result
+                );
+
+                void statistics(PINDICIUM_POST_PRESENT_STATISTICS stats) const;
+            };
+        };
+    };
+};
@@ -0,0 +1,402 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "RawInputBatcher.h"
+#include "Memory.h"
+
+//
+// Placeholder stored in a slot while its ring buffer is being allocated; thread IDs are
+// multiples of four, so this never collides with a real one
+//
+static const DWORD SlotClaiming = 0xFFFFFFFF;
+
+//
+// Bound to a reference by make_unique, so it needs a definition
+//
+const size_t Indicium::Core::Input::RawInputBatcher::EventsPerThread;
+
+Indicium::Core::Input::RawInputBatcher::RawInputBatcher(Stats::CounterRegistry& counters) :
+	started_(false),
+	active_(false),
+	callback_(nullptr),
+	sink_(nullptr),
+	coalesce_(true),
+	started_events_(0),
+	started_delivered_(0),
+	started_merged_(0),
+	started_dropped_(0),
+	started_batches_(0),
+	reported_dropped_(0),
+	buffer_header_padding_(0)
+{
+	//
+	// Room for two full rings per batch, remaining events stay queued for the next one
+	//
+	scratch_.resize(EventsPerThread * 2);
+
+#ifdef _M_IX86
+	BOOL wow64 = FALSE;
+
+	if (IsWow64Process(GetCurrentProcess(), &wow64) && wow64)
+		buffer_header_padding_ = 8;
+#endif
+
+	counters.attach("raw_input.events", events_);
+	counters.attach("raw_input.delivered", delivered_);
+	counters.attach("raw_input.coalesced", merged_);
+	counters.attach("raw_input.dropped", dropped_);
+}
+
+void Indicium::Core::Input::RawInputBatcher::start(const INDICIUM_RAW_INPUT_CONFIG& config)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	started_events_ = events_.load();
+	started_delivered_ = delivered_.load();
+	started_merged_ = merged_.load();
+	started_dropped_ = dropped_.load();
+	started_batches_ = batches_.load();
+
+	coalesce_ = config.CoalesceMouseMotion != FALSE;
+	callback_ = config.EvtIndiciumRawInputBatch;
+	started_ = true;
+	active_.store(true, std::memory_order_release);
+}
+
+void Indicium::Core::Input::RawInputBatcher::stop()
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	started_ = false;
+	callback_ = nullptr;
+	active_.store(sink_.load() != nullptr, std::memory_order_release);
+}
+
+void Indicium::Core::Input::RawInputBatcher::attach(RawInputSink* sink)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	sink_ = sink;
+	active_.store(started_ || sink, std::memory_order_release);
+}
+
+Indicium::Core::Input::RawInputBatcher::ThreadSlot* Indicium::Core::Input::RawInputBatcher::slot_for_current_thread()
+{
+	const auto thread = GetCurrentThreadId();
+
+	//
+	// Fast path: thread already owns a slot
+	//
+	for (auto& slot : slots_)
+	{
+		const auto owner = slot.thread.load(std::memory_order_acquire);
+
+		if (owner == thread)
+			return &slot;
+
+		if (owner == 0)
+			break;
+	}
+
+	//
+	// Slow path: claim the first free slot (happens once per thread reading raw input)
+	//
+	for (auto& slot : slots_)
+	{
+		DWORD expected = 0;
+
+		if (!slot.thread.compare_exchange_strong(expected, SlotClaiming, std::memory_order_acq_rel))
+		{
+			if (expected == thread)
+				return &slot;
+
+			continue;
+		}
+
+		try
+		{
+			Memory::Scope scope(IndiciumMemoryTagInput);
+
+			slot.ring = std::make_unique<Util::SpscRing<INDICIUM_RAW_INPUT_EVENT>>(EventsPerThread);
+		}
+		catch (const std::bad_alloc&)
+		{
+			slot.thread.store(0, std::memory_order_release);
+			return nullptr;
+		}
+
+		slot.thread.store(thread, std::memory_order_release);
+
+		return &slot;
+	}
+
+	return nullptr;
+}
+
+void Indicium::Core::Input::RawInputBatcher::push(
+	ThreadSlot* slot,
+	const RAWINPUTHEADER& header,
+	const BYTE* data,
+	LONGLONG timestamp
+)
+{
+	INDICIUM_RAW_INPUT_EVENT event;
+	ZeroMemory(&event, sizeof(INDICIUM_RAW_INPUT_EVENT));
+
+	event.Device = header.hDevice;
+	event.FirstTimestamp = timestamp;
+	event.LastTimestamp = timestamp;
+	event.Coalesced = 1;
+
+	switch (header.dwType)
+	{
+	case RIM_TYPEMOUSE:
+	{
+		const auto mouse = reinterpret_cast<const RAWMOUSE*>(data);
+
+		event.Type = IndiciumRawInputMouse;
+		event.Mouse.X = mouse->lLastX;
+		event.Mouse.Y = mouse->lLastY;
+		event.Mouse.Flags = mouse->usFlags;
+		event.Mouse.ButtonFlags = mouse->usButtonFlags;
+		event.Mouse.ButtonData = mouse->usButtonData;
+		break;
+	}
+	case RIM_TYPEKEYBOARD:
+	{
+		const auto keyboard = reinterpret_cast<const RAWKEYBOARD*>(data);
+
+		event.Type = IndiciumRawInputKeyboard;
+		event.Keyboard.MakeCode = keyboard->MakeCode;
+		event.Keyboard.Flags = keyboard->Flags;
+		event.Keyboard.VKey = keyboard->VKey;
+		event.Keyboard.Message = keyboard->Message;
+		break;
+	}
+	default:
+	{
+		const auto hid = reinterpret_cast<const RAWHID*>(data);
+
+		event.Type = IndiciumRawInputHid;
+		event.Hid.SizeHid = hid->dwSizeHid;
+		event.Hid.Count = hid->dwCount;
+		break;
+	}
+	}
+
+	events_.add();
+
+	if (!slot->ring->try_push(event))
+		dropped_.add();
+}
+
+void Indicium::Core::Input::RawInputBatcher::on_get_data(UINT command, LPVOID data, UINT result)
+{
+	if (!active_.load(std::memory_order_relaxed))
+		return;
+
+	//
+	// Size and header queries and failed calls return no input. Handles get reused for later
+	// input, so every read counts.
+	//
+	if (command != RID_INPUT || !data || result == static_cast<UINT>(-1) || result < sizeof(RAWINPUTHEADER))
+		return;
+
+	const auto slot = slot_for_current_thread();
+
+	if (!slot)
+	{
+		dropped_.add();
+		return;
+	}
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	const auto input = static_cast<const RAWINPUT*>(data);
+
+	push(slot, input->header, reinterpret_cast<const BYTE*>(&input->data), now.QuadPart);
+}
+
+void Indicium::Core::Input::RawInputBatcher::on_get_buffer(PRAWINPUT data, UINT result)
+{
+	if (!active_.load(std::memory_order_relaxed))
+		return;
+
+	if (!data || !result || result == static_cast<UINT>(-1))
+		return;
+
+	const auto slot = slot_for_current_thread();
+
+	if (!slot)
+	{
+		dropped_.add(result);
+		return;
+	}
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	//
+	// Same walk as NEXTRAWINPUTBLOCK, except that blocks of the 64-bit layout are QWORD aligned
+	//
+	const auto alignment = buffer_header_padding_ ? sizeof(ULONGLONG) : sizeof(ULONG_PTR);
+	auto block = reinterpret_cast<const BYTE*>(data);
+
+	for (UINT i = 0; i < result; i++)
+	{
+		const auto input = reinterpret_cast<const RAWINPUT*>(block);
+
+		push(slot, input->header,
+			reinterpret_cast<const BYTE*>(&input->data) + buffer_header_padding_, now.QuadPart);
+
+		const auto next = reinterpret_cast<ULONG_PTR>(block) + input->header.dwSize;
+		block = reinterpret_cast<const BYTE*>((next + alignment - 1) & ~(alignment - 1));
+	}
+}
+
+size_t Indicium::Core::Input::RawInputBatcher::coalesce(INDICIUM_RAW_INPUT_EVENT* events, size_t count) const
+{
+	if (!coalesce_.load(std::memory_order_relaxed) || count < 2)
+		return count;
+
+	size_t out = 1;
+
+	for (size_t i = 1; i < count; i++)
+	{
+		auto& last = events[out - 1];
+		const auto& event = events[i];
+
+		bool merged = false;
+
+		if (event.Type == last.Type && event.Device == last.Device)
+		{
+			if (event.Type == IndiciumRawInputMouse
+				&& !last.Mouse.ButtonFlags && !event.Mouse.ButtonFlags
+				&& last.Mouse.Flags == event.Mouse.Flags)
+			{
+				if (event.Mouse.Flags & MOUSE_MOVE_ABSOLUTE)
+				{
+					last.Mouse.X = event.Mouse.X;
+					last.Mouse.Y = event.Mouse.Y;
+				}
+				else
+				{
+					last.Mouse.X += event.Mouse.X;
+					last.Mouse.Y += event.Mouse.Y;
+				}
+
+				merged = true;
+			}
+			else if (event.Type == IndiciumRawInputHid)
+			{
+				last.Hid.SizeHid = event.Hid.SizeHid;
+				last.Hid.Count += event.Hid.Count;
+
+				merged = true;
+			}
+		}
+
+		if (merged)
+		{
+			last.Coalesced += event.Coalesced;
+			last.LastTimestamp = event.LastTimestamp;
+		}
+		else
+		{
+			events[out++] = event;
+		}
+	}
+
+	return out;
+}
+
+void Indicium::Core::Input::RawInputBatcher::deliver(PINDICIUM_ENGINE engine)
+{
+	//
+	// Never block the render thread; if another thread is delivering we simply skip this round
+	//
+	if (draining_.test_and_set(std::memory_order_acquire))
+		return;
+
+	size_t count = 0;
+	size_t read = 0;
+
+	for (auto& slot : slots_)
+	{
+		const auto owner = slot.thread.load(std::memory_order_acquire);
+
+		if (owner == 0 || owner == SlotClaiming)
+			continue;
+
+		//
+		// Events of different threads have no common order, only merge within one thread
+		//
+		const auto popped = slot.ring->pop_bulk(scratch_.data() + count, scratch_.size() - count);
+
+		read += popped;
+		count += coalesce(scratch_.data() + count, popped);
+	}
+
+	const auto dropped_total = dropped_.load();
+	const auto dropped = dropped_total - reported_dropped_;
+	reported_dropped_ = dropped_total;
+
+	//
+	// Counted whoever gets the batch, the replay sink alone reads input as well
+	//
+	merged_.add(read - count);
+	delivered_.add(count);
+
+	const auto callback = callback_.load(std::memory_order_acquire);
+	const auto sink = sink_.load(std::memory_order_acquire);
+
+	if (sink && count)
+		sink->on_raw_input(scratch_.data(), count);
+
+	//
+	// Anything still queued after a stop is discarded
+	//
+	if (callback && active_.load(std::memory_order_acquire) && (count || dropped))
+	{
+		batches_.add();
+
+		INDICIUM_EVT_POST_EXTENSION post;
+		INDICIUM_EVT_POST_EXTENSION_INIT(&post, engine, IndiciumEngineGetCustomContext(engine));
+
+		callback(scratch_.data(), count, dropped, &post);
+	}
+
+	draining_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Input::RawInputBatcher::statistics(PINDICIUM_RAW_INPUT_STATISTICS statistics) const
+{
+	statistics->Events = events_.load() - started_events_;
+	statistics->Delivered = delivered_.load() - started_delivered_;
+	statistics->Coalesced = merged_.load() - started_merged_;
+	statistics->Dropped = dropped_.load() - started_dropped_;
+	statistics->Batches = batches_.load() - started_batches_;
+}
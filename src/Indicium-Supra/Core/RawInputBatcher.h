@@ -0,0 +1,157 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumRawInput.h"
+
+#include "Utils/SpscRing.h"
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Input
+        {
+            /**
+             * \brief   Engine-internal receiver of raw input batches, called on the render thread
+             *          ahead of the batch callback.
+             */
+            class RawInputSink
+            {
+            public:
+                virtual ~RawInputSink() = default;
+
+                virtual void on_raw_input(const INDICIUM_RAW_INPUT_EVENT* events, size_t count) = 0;
+            };
+
+            /**
+             * \brief   Collects the raw input read by the host on its window thread(s) and hands
+             *          it out as one batch per Present.
+             *
+             *          The hooks only copy the few fields of interest into a per-thread
+             *          single-producer/single-consumer ring; merging of mouse motion happens on
+             *          the render thread at delivery, so an 8 kHz mouse costs the window thread a
+             *          single ring push per WM_INPUT.
+             */
+            class RawInputBatcher
+            {
+            public:
+                static const size_t MaxThreads = 16;
+
+                //
+                // One second of an 8 kHz mouse per thread
+                //
+                static const size_t EventsPerThread = 8192;
+
+            private:
+                struct alignas(64) ThreadSlot
+                {
+                    std::atomic<DWORD> thread{ 0 };
+                    std::unique_ptr<Util::SpscRing<INDICIUM_RAW_INPUT_EVENT>> ring;
+                };
+
+                ThreadSlot slots_[MaxThreads];
+
+                //
+                // Producers record while started or a sink is attached; guarded by lock_
+                //
+                std::mutex lock_;
+                bool started_;
+                std::atomic<bool> active_;
+                std::atomic<PFN_INDICIUM_RAW_INPUT_BATCH> callback_;
+                std::atomic<RawInputSink*> sink_;
+                std::atomic<bool> coalesce_;
+
+                Util::ShardedCounter events_;
+                Util::ShardedCounter delivered_;
+                Util::ShardedCounter merged_;
+                Util::ShardedCounter dropped_;
+                Util::ShardedCounter batches_;
+
+                ULONGLONG started_events_;
+                ULONGLONG started_delivered_;
+                ULONGLONG started_merged_;
+                ULONGLONG started_dropped_;
+                ULONGLONG started_batches_;
+
+                //
+                // Consumer side; guarded by draining_
+                //
+                std::vector<INDICIUM_RAW_INPUT_EVENT> scratch_;
+                std::atomic_flag draining_ = ATOMIC_FLAG_INIT;
+                ULONGLONG reported_dropped_;
+
+                //
+                // GetRawInputBuffer of a 32-bit process on 64-bit Windows returns 64-bit headers
+                //
+                size_t buffer_header_padding_;
+
+                ThreadSlot* slot_for_current_thread();
+
+                void push(ThreadSlot* slot, const RAWINPUTHEADER& header, const BYTE* data, LONGLONG timestamp);
+
+                size_t coalesce(INDICIUM_RAW_INPUT_EVENT* events, size_t count) const;
+
+            public:
+                explicit RawInputBatcher(Stats::CounterRegistry& counters);
+
+                void start(const INDICIUM_RAW_INPUT_CONFIG& config);
+
+                void stop();
+
+                /**
+                 * \brief   Sets the sink receiving batches besides the callback, NULL to remove it.
+                 *          A batch being delivered while removing may still reach the old sink.
+                 */
+                void attach(RawInputSink* sink);
+
+                //
+                // Hook side, called after the original function returned
+                //
+                void on_get_data(UINT command, LPVOID data, UINT result);
+
+                void on_get_buffer(PRAWINPUT data, UINT result);
+
+                //
+                // Render thread side
+                //
+                void deliver(PINDICIUM_ENGINE engine);
+
+                void statistics(PINDICIUM_RAW_INPUT_STATISTICS statistics) const;
+            };
+        };
+    };
+};
@@ -0,0 +1,309 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "ShaderReplacement.h"
+#include "Memory.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstring>
+
+//
+// DXBC container: magic, 16-byte checksum, version, total size, chunk count
+//
+static const size_t ContainerHeaderSize = 32;
+static const size_t ChecksumOffset = 4;
+
+static const char* const StageNames[] = { "vs", "ps", "cs" };
+
+static bool is_container(const void* bytecode, SIZE_T length)
+{
+	return bytecode && length >= ContainerHeaderSize && memcmp(bytecode, "DXBC", 4) == 0;
+}
+
+static bool parse_hash(const char* text, Indicium::Core::Shaders::ShaderHash& hash)
+{
+	BYTE bytes[16];
+
+	for (size_t i = 0; i < 32; i++)
+	{
+		const auto c = text[i];
+		BYTE nibble;
+
+		if (c >= '0' && c <= '9')
+			nibble = BYTE(c - '0');
+		else if (c >= 'a' && c <= 'f')
+			nibble = BYTE(c - 'a' + 10);
+		else if (c >= 'A' && c <= 'F')
+			nibble = BYTE(c - 'A' + 10);
+		else
+			return false;
+
+		if (i % 2)
+			bytes[i / 2] |= nibble;
+		else
+			bytes[i / 2] = BYTE(nibble << 4);
+	}
+
+	memcpy(&hash.low, bytes, sizeof(UINT64));
+	memcpy(&hash.high, bytes + sizeof(UINT64), sizeof(UINT64));
+
+	return true;
+}
+
+Indicium::Core::Shaders::ShaderReplacement::ShaderReplacement(Stats::CounterRegistry& counters) :
+	mask_(0),
+	dump_(false),
+	manifest_(nullptr)
+{
+	counters.attach("shaders.created", created_);
+	counters.attach("shaders.replaced", replaced_);
+	counters.attach("shaders.rejected", rejected_);
+}
+
+Indicium::Core::Shaders::ShaderReplacement::~ShaderReplacement()
+{
+	if (manifest_)
+		fclose(manifest_);
+}
+
+Indicium::Core::Shaders::ShaderHash Indicium::Core::Shaders::ShaderReplacement::hash(const void* bytecode, SIZE_T length)
+{
+	ShaderHash result;
+
+	if (is_container(bytecode, length))
+	{
+		const auto checksum = static_cast<const BYTE*>(bytecode) + ChecksumOffset;
+
+		memcpy(&result.low, checksum, sizeof(UINT64));
+		memcpy(&result.high, checksum + sizeof(UINT64), sizeof(UINT64));
+
+		return result;
+	}
+
+	//
+	// Not produced by the HLSL compiler; two FNV-1a lanes with different offset bases
+	//
+	const auto bytes = static_cast<const BYTE*>(bytecode);
+
+	result.low = 14695981039346656037ULL;
+	result.high = 0x6C62272E07BB0142ULL;
+
+	for (SIZE_T i = 0; i < length; i++)
+	{
+		result.low = (result.low ^ bytes[i]) * 1099511628211ULL;
+		result.high = (result.high ^ bytes[i]) * 1099511628211ULL;
+	}
+
+	return result;
+}
+
+void Indicium::Core::Shaders::ShaderReplacement::format(const ShaderHash& hash, char (&text)[33])
+{
+	static const char digits[] = "0123456789abcdef";
+
+	BYTE bytes[16];
+	memcpy(bytes, &hash.low, sizeof(UINT64));
+	memcpy(bytes + sizeof(UINT64), &hash.high, sizeof(UINT64));
+
+	for (size_t i = 0; i < 16; i++)
+	{
+		text[i * 2] = digits[bytes[i] >> 4];
+		text[i * 2 + 1] = digits[bytes[i] & 0xF];
+	}
+
+	text[32] = '\0';
+}
+
+void Indicium::Core::Shaders::ShaderReplacement::load(const std::string& directory, bool manifest, bool dump)
+{
+	auto logger = spdlog::get("indicium")->clone("shaders");
+
+	directory_ = directory;
+	dump_ = dump;
+
+	std::vector<ShaderHash> hashes;
+	WIN32_FIND_DATAA data;
+	const auto find = FindFirstFileA((directory + "\\*.cso").c_str(), &data);
+
+	if (find != INVALID_HANDLE_VALUE)
+	{
+		do
+		{
+			ShaderHash hash;
+
+			if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+				|| strlen(data.cFileName) != 36 || !parse_hash(data.cFileName, hash))
+				continue;
+
+			const auto path = directory + "\\" + data.cFileName;
+			std::vector<BYTE> bytecode;
+			FILE* file = nullptr;
+
+			if (fopen_s(&file, path.c_str(), "rb") || !file)
+			{
+				logger->error("Couldn't open {}", path);
+				continue;
+			}
+
+			BYTE chunk[64 * 1024];
+			size_t read;
+
+			while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+				bytecode.insert(bytecode.end(), chunk, chunk + read);
+
+			const auto failed = ferror(file) != 0;
+			fclose(file);
+
+			if (failed || !is_container(bytecode.data(), bytecode.size()))
+			{
+				logger->error("{} is no compiled shader, skipping", path);
+				continue;
+			}
+
+			hashes.push_back(hash);
+			replacements_.push_back(std::move(bytecode));
+
+		} while (FindNextFileA(find, &data));
+
+		FindClose(find);
+	}
+
+	//
+	// At most half full, so every probe sequence ends in an empty slot
+	//
+	if (!replacements_.empty())
+	{
+		size_t capacity = 16;
+
+		while (capacity < replacements_.size() * 2)
+			capacity *= 2;
+
+		table_.assign(capacity, Slot{ {}, nullptr });
+		mask_ = capacity - 1;
+
+		for (size_t i = 0; i < replacements_.size(); i++)
+		{
+			auto index = static_cast<size_t>(hashes[i].low) & mask_;
+
+			while (table_[index].bytecode && !(table_[index].hash == hashes[i]))
+				index = (index + 1) & mask_;
+
+			table_[index] = Slot{ hashes[i], &replacements_[i] };
+		}
+	}
+
+	logger->info("{} replacement shaders loaded from {}", replacements_.size(), directory);
+
+	if (manifest || dump)
+		CreateDirectoryA(directory.c_str(), nullptr);
+
+	if (dump)
+		CreateDirectoryA((directory + "\\Dump").c_str(), nullptr);
+
+	if (manifest)
+	{
+		const auto path = directory + "\\manifest.txt";
+
+		if (fopen_s(&manifest_, path.c_str(), "w") || !manifest_)
+		{
+			manifest_ = nullptr;
+			logger->error("Couldn't create {}", path);
+		}
+		else
+		{
+			fprintf(manifest_, "# hash stage bytes outcome\n");
+			fflush(manifest_);
+		}
+	}
+}
+
+const std::vector<BYTE>* Indicium::Core::Shaders::ShaderReplacement::find(const ShaderHash& hash) const
+{
+	if (table_.empty())
+		return nullptr;
+
+	for (auto index = static_cast<size_t>(hash.low) & mask_;; index = (index + 1) & mask_)
+	{
+		const auto& slot = table_[index];
+
+		if (!slot.bytecode)
+			return nullptr;
+
+		if (slot.hash == hash)
+			return slot.bytecode;
+	}
+}
+
+void Indicium::Core::Shaders::ShaderReplacement::record(
+	Stage stage,
+	const ShaderHash& hash,
+	const void* bytecode,
+	SIZE_T length,
+	Outcome outcome
+)
+{
+	if (!manifest_ && !dump_)
+		return;
+
+	Memory::Scope scope(IndiciumMemoryTagShaders);
+	std::lock_guard<std::mutex> guard(manifest_lock_);
+
+	//
+	// Runs inside the game's shader creation, nothing may escape
+	//
+	try
+	{
+		if (!seen_.insert(hash).second)
+			return;
+
+		char name[33];
+		format(hash, name);
+
+		if (manifest_)
+		{
+			static const char* const outcomes[] = { "original", "replaced", "rejected" };
+
+			fprintf(manifest_, "%s %s %zu %s\n",
+				name, StageNames[static_cast<int>(stage)], static_cast<size_t>(length), outcomes[static_cast<int>(outcome)]);
+			fflush(manifest_);
+		}
+
+		if (dump_)
+		{
+			const auto path = directory_ + "\\Dump\\" + name + ".cso";
+			FILE* file = nullptr;
+
+			if (fopen_s(&file, path.c_str(), "wb") || !file)
+				return;
+
+			fwrite(bytecode, 1, length, file);
+			fclose(file);
+		}
+	}
+	catch (const std::bad_alloc&)
+	{
+	}
+}
@@ -0,0 +1,179 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Shaders
+        {
+            enum class Stage
+            {
+                Vertex,
+                Pixel,
+                Compute
+            };
+
+            /**
+             * \brief   Identity of a shader: the 16-byte checksum of its DXBC container.
+             */
+            struct ShaderHash
+            {
+                UINT64 low;
+                UINT64 high;
+
+                bool operator==(const ShaderHash& other) const
+                {
+                    return low == other.low && high == other.high;
+                }
+            };
+
+            /**
+             * \brief   Substitutes shader bytecode at creation with replacements loaded from a
+             *          directory and optionally lists and dumps every distinct shader created.
+             *
+             *          Replacements are read once on the engine thread before hooking and put in
+             *          an open addressing table which is never modified afterwards, so the hooks
+             *          look up without locking. Hashing reads the checksum the compiler already
+             *          stored in the container. Only the manifest and dumps take a lock, once
+             *          per distinct shader.
+             */
+            class ShaderReplacement
+            {
+                struct Slot
+                {
+                    ShaderHash hash;
+                    const std::vector<BYTE>* bytecode;
+                };
+
+                struct Hasher
+                {
+                    size_t operator()(const ShaderHash& hash) const
+                    {
+                        return static_cast<size_t>(hash.low);
+                    }
+                };
+
+                std::vector<std::vector<BYTE>> replacements_;
+                std::vector<Slot> table_;
+                size_t mask_;
+
+                std::string directory_;
+                bool dump_;
+
+                std::mutex manifest_lock_;
+                std::unordered_set<ShaderHash, Hasher> seen_;
+                FILE* manifest_;
+
+                Util::ShardedCounter created_;
+                Util::ShardedCounter replaced_;
+                Util::ShardedCounter rejected_;
+
+                enum class Outcome
+                {
+                    Original,
+                    Replaced,
+                    Rejected
+                };
+
+                const std::vector<BYTE>* find(const ShaderHash& hash) const;
+
+                void record(Stage stage, const ShaderHash& hash, const void* bytecode, SIZE_T length, Outcome outcome);
+
+            public:
+                explicit ShaderReplacement(Stats::CounterRegistry& counters);
+                ~ShaderReplacement();
+
+                ShaderReplacement(const ShaderReplacement&) = delete;
+                ShaderReplacement& operator=(const ShaderReplacement&) = delete;
+
+                /**
+                 * \brief   Reads the replacements from directory; engine thread only, before the
+                 *          shader hooks get applied.
+                 */
+                void load(const std::string& directory, bool manifest, bool dump);
+
+                /**
+                 * \brief   Checksum of a DXBC container, or a 128-bit FNV-1a hash of anything else.
+                 */
+                static ShaderHash hash(const void* bytecode, SIZE_T length);
+
+                /**
+                 * \brief   Formats the hash as 32 lowercase hex digits, the file name of its
+                 *          replacement.
+                 */
+                static void format(const ShaderHash& hash, char (&text)[33]);
+
+                /**
+                 * \brief   Calls create with the replacement of the bytecode if there is one, and
+                 *          again with the original bytecode if the device rejects it.
+                 */
+                template <typename Create>
+                HRESULT create(Stage stage, const void* bytecode, SIZE_T length, Create create)
+                {
+                    created_.add();
+
+                    const auto key = hash(bytecode, length);
+                    const auto replacement = find(key);
+
+                    if (!replacement)
+                    {
+                        record(stage, key, bytecode, length, Outcome::Original);
+                        return create(bytecode, length);
+                    }
+
+                    const auto result = create(replacement->data(), replacement->size());
+
+                    if (SUCCEEDED(result))
+                    {
+                        replaced_.add();
+                        record(stage, key, bytecode, length, Outcome::Replaced);
+                        return result;
+                    }
+
+                    rejected_.add();
+                    record(stage, key, bytecode, length, Outcome::Rejected);
+
+                    return create(bytecode, length);
+                }
+            };
+        };
+    };
+};
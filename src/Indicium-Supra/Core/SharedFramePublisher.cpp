@@ -0,0 +1,193 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "SharedFramePublisher.h"
+#include "Memory.h"
+
+#include <cstring>
+#include <system_error>
+
+//
+// One frame being written, one pending and one arriving while the previous is replaced
+//
+static const UINT32 PublisherOutstanding = 3;
+
+Indicium::Core::Capture::SharedFramePublisher::SharedFramePublisher(Stats::CounterRegistry& counters) :
+	consumer_(nullptr),
+	presenter_(nullptr),
+	region_(0),
+	pending_(nullptr),
+	stopping_(false),
+	wake_(CreateEvent(nullptr, FALSE, FALSE, nullptr))
+{
+	counters.attach("shared_frames.published", published_);
+	counters.attach("shared_frames.replaced", replaced_);
+	counters.attach("shared_frames.oversized", oversized_);
+}
+
+Indicium::Core::Capture::SharedFramePublisher::~SharedFramePublisher()
+{
+	stop();
+
+	if (wake_)
+		CloseHandle(wake_);
+}
+
+INDICIUM_ERROR Indicium::Core::Capture::SharedFramePublisher::start(
+	FramePool& pool,
+	const INDICIUM_SHARED_FRAMES_CONFIG& config
+)
+{
+	stop();
+
+	if (!wake_)
+		return INDICIUM_ERROR_CREATE_EVENT_FAILED;
+
+	LARGE_INTEGER frequency;
+	QueryPerformanceFrequency(&frequency);
+
+	if (!writer_.create(config.Name, config.MaximumFrameSize, frequency.QuadPart, GetCurrentProcessId()))
+		return INDICIUM_ERROR_SHARED_MEMORY_FAILED;
+
+	presenter_ = config.Presenter;
+	region_ = config.Region;
+	stopping_.store(false, std::memory_order_relaxed);
+
+	try
+	{
+		thread_ = std::thread(&SharedFramePublisher::run, this);
+	}
+	catch (const std::system_error&)
+	{
+		writer_.close();
+		return INDICIUM_ERROR_CREATE_THREAD_FAILED;
+	}
+
+	consumer_ = pool.add(on_frame, this, PublisherOutstanding);
+
+	if (!consumer_)
+	{
+		stop();
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+void Indicium::Core::Capture::SharedFramePublisher::stop()
+{
+	//
+	// No callback runs anymore once removed, the pending slot only shrinks from here on
+	//
+	if (consumer_)
+	{
+		FramePool::remove(consumer_);
+		consumer_ = nullptr;
+	}
+
+	if (thread_.joinable())
+	{
+		stopping_.store(true, std::memory_order_release);
+		SetEvent(wake_);
+		thread_.join();
+	}
+
+	if (const auto reference = pending_.exchange(nullptr, std::memory_order_acquire))
+		FramePool::release(reference);
+
+	writer_.close();
+}
+
+void Indicium::Core::Capture::SharedFramePublisher::on_frame(
+	PINDICIUM_CAPTURE_FRAME_REFERENCE reference,
+	const INDICIUM_CAPTURED_FRAME* frame,
+	PVOID context
+)
+{
+	const auto publisher = static_cast<SharedFramePublisher*>(context);
+
+	if (frame->Region != publisher->region_
+		|| (publisher->presenter_ && frame->Presenter != publisher->presenter_))
+	{
+		FramePool::release(reference);
+		return;
+	}
+
+	//
+	// Only the latest frame matters to readers, an unwritten one gets dropped
+	//
+	if (const auto previous = publisher->pending_.exchange(reference, std::memory_order_acq_rel))
+	{
+		FramePool::release(previous);
+		publisher->replaced_.add();
+	}
+
+	SetEvent(publisher->wake_);
+}
+
+void Indicium::Core::Capture::SharedFramePublisher::run()
+{
+	Memory::Scope scope(IndiciumMemoryTagCapture);
+
+	while (WaitForSingleObject(wake_, INFINITE) == WAIT_OBJECT_0)
+	{
+		if (stopping_.load(std::memory_order_acquire))
+			break;
+
+		if (const auto reference = pending_.exchange(nullptr, std::memory_order_acq_rel))
+			write(reference);
+	}
+}
+
+void Indicium::Core::Capture::SharedFramePublisher::write(PINDICIUM_CAPTURE_FRAME_REFERENCE reference)
+{
+	const auto& frame = reference->buffer.load(std::memory_order_acquire)->frame;
+
+	SharedFrames::FrameInfo info;
+	std::memset(&info, 0, sizeof(info));
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	info.capture_frame = frame.FrameNumber;
+	info.capture_timestamp = frame.Timestamp;
+	info.publish_timestamp = now.QuadPart;
+	info.width = frame.Width;
+	info.height = frame.Height;
+	info.format = frame.Format;
+	info.pitch = frame.Pitch;
+	info.back_buffer_width = frame.BackBufferWidth;
+	info.back_buffer_height = frame.BackBufferHeight;
+	info.left = frame.Left;
+	info.top = frame.Top;
+	info.size = static_cast<uint64_t>(frame.Pitch) * frame.Height;
+
+	if (writer_.publish(info, frame.Data))
+		published_.add();
+	else
+		oversized_.add();
+
+	FramePool::release(reference);
+}
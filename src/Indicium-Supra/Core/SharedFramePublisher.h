@@ -0,0 +1,92 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumSharedFrames.h"
+#include "Indicium/Engine/IndiciumSharedFrames.hpp"
+
+#include "Counters.h"
+#include "FramePool.h"
+
+#include <atomic>
+#include <thread>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Capture
+        {
+            /**
+             * \brief   Capture consumer writing frames of one presenter region into a shared memory
+             *          triple buffer for other processes.
+             *
+             *          The render thread only parks its frame reference in a single pending slot,
+             *          replacing (and releasing) one the writer thread didn't get to yet, so a slow
+             *          copy into shared memory never holds up Present or the other consumers.
+             */
+            class SharedFramePublisher
+            {
+                SharedFrames::Writer writer_;
+                PINDICIUM_CAPTURE_CONSUMER consumer_;
+                PVOID presenter_;
+                UINT32 region_;
+
+                std::atomic<PINDICIUM_CAPTURE_FRAME_REFERENCE> pending_;
+                std::atomic<bool> stopping_;
+                HANDLE wake_;
+                std::thread thread_;
+
+                Util::ShardedCounter published_;
+                Util::ShardedCounter replaced_;
+                Util::ShardedCounter oversized_;
+
+                static void on_frame(
+                    PINDICIUM_CAPTURE_FRAME_REFERENCE reference,
+                    const INDICIUM_CAPTURED_FRAME* frame,
+                    PVOID context
+                );
+
+                void run();
+                void write(PINDICIUM_CAPTURE_FRAME_REFERENCE reference);
+
+            public:
+                explicit SharedFramePublisher(Stats::CounterRegistry& counters);
+                ~SharedFramePublisher();
+
+                SharedFramePublisher(const SharedFramePublisher&) = delete;
+                SharedFramePublisher& operator=(const SharedFramePublisher&) = delete;
+
+                INDICIUM_ERROR start(FramePool& pool, const INDICIUM_SHARED_FRAMES_CONFIG& config);
+
+                void stop();
+            };
+        };
+    };
+};
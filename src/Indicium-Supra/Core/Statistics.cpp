@@ -0,0 +1,216 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Statistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+//
+// Regularized incomplete beta function I_x(a, b) via Lentz's continued fraction
+//
+static double beta_continued_fraction(double a, double b, double x)
+{
+	const int max_iterations = 300;
+	const double epsilon = 1e-14;
+	const double tiny = 1e-300;
+
+	const auto qab = a + b;
+	const auto qap = a + 1.0;
+	const auto qam = a - 1.0;
+
+	auto c = 1.0;
+	auto d = 1.0 - qab * x / qap;
+
+	if (std::fabs(d) < tiny)
+		d = tiny;
+
+	d = 1.0 / d;
+	auto h = d;
+
+	for (int m = 1; m <= max_iterations; m++)
+	{
+		const auto m2 = 2.0 * m;
+
+		auto aa = m * (b - m) * x / ((qam + m2) * (a + m2));
+
+		d = 1.0 + aa * d;
+		if (std::fabs(d) < tiny)
+			d = tiny;
+		c = 1.0 + aa / c;
+		if (std::fabs(c) < tiny)
+			c = tiny;
+		d = 1.0 / d;
+		h *= d * c;
+
+		aa = -(a + m) * (qab + m) * x / ((a + m2) * (qap + m2));
+
+		d = 1.0 + aa * d;
+		if (std::fabs(d) < tiny)
+			d = tiny;
+		c = 1.0 + aa / c;
+		if (std::fabs(c) < tiny)
+			c = tiny;
+		d = 1.0 / d;
+
+		const auto delta = d * c;
+		h *= delta;
+
+		if (std::fabs(delta - 1.0) < epsilon)
+			break;
+	}
+
+	return h;
+}
+
+static double regularized_beta(double a, double b, double x)
+{
+	if (x <= 0.0)
+		return 0.0;
+
+	if (x >= 1.0)
+		return 1.0;
+
+	const auto front = std::exp(
+		std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x));
+
+	if (x < (a + 1.0) / (a + b + 2.0))
+		return front * beta_continued_fraction(a, b, x) / a;
+
+	return 1.0 - front * beta_continued_fraction(b, a, 1.0 - x) / b;
+}
+
+static double percentile(const std::vector<double>& sorted, double p)
+{
+	//
+	// Linear interpolation between closest ranks
+	//
+	const auto rank = p * (sorted.size() - 1);
+	const auto lower = static_cast<size_t>(rank);
+	const auto upper = (std::min)(lower + 1, sorted.size() - 1);
+
+	return sorted[lower] + (sorted[upper] - sorted[lower]) * (rank - lower);
+}
+
+Indicium::Core::Stats::Distribution Indicium::Core::Stats::describe(std::vector<double> samples)
+{
+	Distribution result = {};
+
+	if (samples.empty())
+		return result;
+
+	std::sort(samples.begin(), samples.end());
+
+	//
+	// Welford's algorithm, numerically stable for long runs
+	//
+	double mean = 0.0;
+	double m2 = 0.0;
+	double n = 0.0;
+
+	for (const auto value : samples)
+	{
+		n += 1.0;
+		const auto delta = value - mean;
+		mean += delta / n;
+		m2 += delta * (value - mean);
+	}
+
+	result.moments.count = n;
+	result.moments.mean = mean;
+	result.moments.variance = n > 1.0 ? m2 / (n - 1.0) : 0.0;
+	result.minimum = samples.front();
+	result.median = percentile(samples, 0.5);
+	result.percentile95 = percentile(samples, 0.95);
+	result.percentile99 = percentile(samples, 0.99);
+	result.maximum = samples.back();
+
+	return result;
+}
+
+double Indicium::Core::Stats::student_t_sf(double t, double df)
+{
+	const auto tail = 0.5 * regularized_beta(df / 2.0, 0.5, df / (df + t * t));
+
+	return t > 0.0 ? tail : 1.0 - tail;
+}
+
+double Indicium::Core::Stats::student_t_quantile(double p, double df)
+{
+	if (p <= 0.0 || p >= 1.0 || df <= 0.0)
+		return p < 0.5 ? -HUGE_VAL : HUGE_VAL;
+
+	if (p < 0.5)
+		return -student_t_quantile(1.0 - p, df);
+
+	//
+	// Bracket the upper tail, then bisect; the survival function is monotonic
+	//
+	const auto tail = 1.0 - p;
+	auto lower = 0.0;
+	auto upper = 1.0;
+
+	while (student_t_sf(upper, df) > tail && upper < 1e12)
+		upper *= 2.0;
+
+	for (int i = 0; i < 100 && upper - lower > 1e-12 * upper; i++)
+	{
+		const auto middle = 0.5 * (lower + upper);
+
+		if (student_t_sf(middle, df) > tail)
+			lower = middle;
+		else
+			upper = middle;
+	}
+
+	return 0.5 * (lower + upper);
+}
+
+Indicium::Core::Stats::WelchTest Indicium::Core::Stats::welch(const Moments& a, const Moments& b)
+{
+	WelchTest result = { 0.0, 0.0, 1.0 };
+
+	if (a.count < 2.0 || b.count < 2.0)
+		return result;
+
+	const auto va = a.variance / a.count;
+	const auto vb = b.variance / b.count;
+	const auto se2 = va + vb;
+
+	if (se2 <= 0.0)
+	{
+		//
+		// Constant samples; any difference is certain
+		//
+		result.p_greater = a.mean > b.mean ? 0.0 : 1.0;
+		return result;
+	}
+
+	result.t = (a.mean - b.mean) / std::sqrt(se2);
+	result.df = se2 * se2 / (va * va / (a.count - 1.0) + vb * vb / (b.count - 1.0));
+	result.p_greater = student_t_sf(result.t, result.df);
+
+	return result;
+}
@@ -0,0 +1,105 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Stats
+        {
+            /**
+             * \brief   Sample size, mean and (unbiased) sample variance of a metric.
+             */
+            struct Moments
+            {
+                double count;
+                double mean;
+                double variance;
+            };
+
+            /**
+             * \brief   Order statistics of a metric, computed from all samples.
+             */
+            struct Distribution
+            {
+                Moments moments;
+                double minimum;
+                double median;
+                double percentile95;
+                double percentile99;
+                double maximum;
+            };
+
+            /**
+             * \fn  Distribution describe(std::vector<double> samples);
+             *
+             * \brief   Summarizes the samples; an empty vector yields all zeros.
+             */
+            Distribution describe(std::vector<double> samples);
+
+            /**
+             * \fn  double student_t_sf(double t, double df);
+             *
+             * \brief   Survival function P(T > t) of Student's t-distribution with df degrees of
+             *          freedom.
+             */
+            double student_t_sf(double t, double df);
+
+            /**
+             * \fn  double student_t_quantile(double p, double df);
+             *
+             * \brief   Inverse of the cumulative distribution function of Student's t-distribution,
+             *          the t for which P(T <= t) equals p.
+             */
+            double student_t_quantile(double p, double df);
+
+            /**
+             * \brief   Welch's unequal variances t-test statistic and degrees of freedom.
+             */
+            struct WelchTest
+            {
+                double t;
+                double df;
+
+                //
+                // One-sided p-value for the mean of the first sample being greater
+                //
+                double p_greater;
+            };
+
+            /**
+             * \fn  WelchTest welch(const Moments& a, const Moments& b);
+             *
+             * \brief   Tests whether the mean of a is greater than the mean of b. Both samples need
+             *          at least two elements, otherwise p_greater is 1.
+             */
+            WelchTest welch(const Moments& a, const Moments& b);
+        };
+    };
+};
@@ -0,0 +1,86 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "TickHandlers.h"
+
+Indicium::Core::Tasks::TickHandlers::TickHandlers() :
+	count_(0),
+	interval_(INFINITE)
+{
+	ZeroMemory(handlers_, sizeof(handlers_));
+}
+
+INDICIUM_ERROR Indicium::Core::Tasks::TickHandlers::add(PFN_INDICIUM_ENGINE_TICK callback, PVOID context)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	if (count_ == MaxHandlers)
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+
+	handlers_[count_++] = { callback, context };
+
+	//
+	// New handler gets its first tick right away
+	//
+	interval_.store(0, std::memory_order_relaxed);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_ERROR Indicium::Core::Tasks::TickHandlers::remove(PFN_INDICIUM_ENGINE_TICK callback, PVOID context)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	for (size_t i = 0; i < count_; i++)
+	{
+		if (handlers_[i].callback == callback && handlers_[i].context == context)
+		{
+			for (; i + 1 < count_; i++)
+				handlers_[i] = handlers_[i + 1];
+
+			count_--;
+			return INDICIUM_ERROR_NONE;
+		}
+	}
+
+	return INDICIUM_ERROR_INVALID_PARAMETER;
+}
+
+void Indicium::Core::Tasks::TickHandlers::run(PINDICIUM_ENGINE engine)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	DWORD interval = INFINITE;
+
+	for (size_t i = 0; i < count_; i++)
+	{
+		const auto requested = handlers_[i].callback(engine, handlers_[i].context);
+
+		if (requested < interval)
+			interval = requested;
+	}
+
+	interval_.store(interval, std::memory_order_relaxed);
+}
@@ -0,0 +1,92 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumTasks.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Tasks
+        {
+            /**
+             * \brief   Handlers run on the engine thread at every engine tick. Each returns the
+             *          milliseconds until it needs the next tick; the engine thread waits no
+             *          longer than the shortest of them.
+             *
+             *          Handlers run under the lock remove() takes, so a handler is never running
+             *          anymore once removed. Handlers can't add or remove handlers themselves.
+             */
+            class TickHandlers
+            {
+            public:
+                static const size_t MaxHandlers = 32;
+
+            private:
+                struct Handler
+                {
+                    PFN_INDICIUM_ENGINE_TICK callback;
+                    PVOID context;
+                };
+
+                std::mutex lock_;
+                Handler handlers_[MaxHandlers];
+                size_t count_;
+                std::atomic<DWORD> interval_;
+
+            public:
+                TickHandlers();
+
+                TickHandlers(const TickHandlers&) = delete;
+                TickHandlers& operator=(const TickHandlers&) = delete;
+
+                INDICIUM_ERROR add(PFN_INDICIUM_ENGINE_TICK callback, PVOID context);
+
+                INDICIUM_ERROR remove(PFN_INDICIUM_ENGINE_TICK callback, PVOID context);
+
+                /**
+                 * \brief   Runs every handler; engine thread only.
+                 */
+                void run(PINDICIUM_ENGINE engine);
+
+                /**
+                 * \brief   Shortest interval requested by the last run, zero after an add.
+                 */
+                DWORD interval() const
+                {
+                    return interval_.load(std::memory_order_relaxed);
+                }
+            };
+        };
+    };
+};
@@ -0,0 +1,153 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "WorkerPool.h"
+#include "Memory.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace
+{
+	//
+	// Pool the calling thread works for, if any
+	//
+	thread_local const Indicium::Core::Tasks::WorkerPool* t_pool = nullptr;
+}
+
+Indicium::Core::Tasks::WorkerPool::WorkerPool(size_t threads) : stopping_(false)
+{
+	for (size_t i = 0; i < threads; i++)
+	{
+		try
+		{
+			threads_.emplace_back(&WorkerPool::run, this);
+		}
+		catch (const std::system_error&)
+		{
+			break;
+		}
+	}
+
+	if (threads_.empty())
+	{
+		throw std::system_error(std::make_error_code(std::errc::resource_unavailable_try_again));
+	}
+}
+
+Indicium::Core::Tasks::WorkerPool::~WorkerPool()
+{
+	shutdown();
+}
+
+void Indicium::Core::Tasks::WorkerPool::run()
+{
+	Memory::Scope scope(IndiciumMemoryTagTasks);
+
+	t_pool = this;
+
+	for (;;)
+	{
+		Job job;
+
+		{
+			std::unique_lock<std::mutex> guard(lock_);
+
+			signal_.wait(guard, [this]() { return stopping_ || !queue_.empty(); });
+
+			//
+			// Drain the queue before exiting so in-flight task graphs complete
+			//
+			if (queue_.empty())
+				return;
+
+			job = queue_.front();
+			queue_.pop_front();
+		}
+
+		job.routine(job.argument, job.index);
+	}
+}
+
+bool Indicium::Core::Tasks::WorkerPool::submit(JobRoutine routine, void* argument, size_t index)
+{
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+
+		if (stopping_)
+			return false;
+
+		queue_.push_back({ routine, argument, index });
+	}
+
+	signal_.notify_one();
+
+	return true;
+}
+
+size_t Indicium::Core::Tasks::WorkerPool::cancel(JobRoutine routine, void* argument)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	const auto size = queue_.size();
+
+	queue_.erase(std::remove_if(queue_.begin(), queue_.end(), [=](const Job& job)
+	{
+		return job.routine == routine && job.argument == argument;
+	}), queue_.end());
+
+	return size - queue_.size();
+}
+
+bool Indicium::Core::Tasks::WorkerPool::is_worker_thread() const
+{
+	return t_pool == this;
+}
+
+void Indicium::Core::Tasks::WorkerPool::shutdown()
+{
+	{
+		std::lock_guard<std::mutex> guard(lock_);
+		stopping_ = true;
+	}
+
+	signal_.notify_all();
+
+	for (auto& thread : threads_)
+	{
+		if (thread.joinable())
+			thread.join();
+	}
+}
+
+size_t Indicium::Core::Tasks::WorkerPool::default_size()
+{
+	const auto cores = std::thread::hardware_concurrency();
+
+	if (cores < 4)
+		return 1;
+
+	return cores / 4 < 4 ? cores / 4 : 4;
+}
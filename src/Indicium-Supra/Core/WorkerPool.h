@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Tasks
+        {
+            /**
+             * \brief   Fixed set of engine worker threads executing submitted jobs in FIFO order.
+             *          Jobs are plain function/argument pairs so submitting never allocates
+             *          beyond the queue's own storage.
+             */
+            class WorkerPool
+            {
+            public:
+                typedef void(*JobRoutine)(void* argument, size_t index);
+
+            private:
+                struct Job
+                {
+                    JobRoutine routine;
+                    void* argument;
+                    size_t index;
+                };
+
+                std::vector<std::thread> threads_;
+                std::deque<Job> queue_;
+                std::mutex lock_;
+                std::condition_variable signal_;
+                bool stopping_;
+
+                void run();
+
+            public:
+                explicit WorkerPool(size_t threads);
+                ~WorkerPool();
+
+                WorkerPool(const WorkerPool&) = delete;
+                WorkerPool& operator=(const WorkerPool&) = delete;
+
+                /**
+                 * \brief   Queues a job; fails once the pool got shut down, nothing runs it then.
+                 */
+                bool submit(JobRoutine routine, void* argument, size_t index);
+
+                /**
+                 * \brief   Takes the jobs of routine and argument off the queue which did not start
+                 *          yet and returns how many.
+                 */
+                size_t cancel(JobRoutine routine, void* argument);
+
+                /**
+                 * \brief   Whether the calling thread is one of this pool's workers.
+                 */
+                bool is_worker_thread() const;
+
+                /**
+                 * \brief   Finishes all queued jobs and joins the threads; engine thread only.
+                 */
+                void shutdown();
+
+                size_t size() const
+                {
+                    return threads_.size();
+                }
+
+                /**
+                 * \brief   Default pool size, leaving most cores to the game.
+                 */
+                static size_t default_size();
+            };
+        };
+    };
+};
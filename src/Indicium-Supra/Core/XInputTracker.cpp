@@ -0,0 +1,286 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "XInputTracker.h"
+
+#include <algorithm>
+
+Indicium::Core::Input::XInputTracker::XInputTracker(Stats::CounterRegistry& counters) :
+	started_(false),
+	active_(false),
+	callback_(nullptr),
+	sink_(nullptr),
+	reported_dropped_(0)
+{
+	for (auto& pad : pads_)
+	{
+		pad.gamepad[0].store(0, std::memory_order_relaxed);
+		pad.gamepad[1].store(0, std::memory_order_relaxed);
+		pad.ring = std::make_unique<Util::SpscRing<INDICIUM_XINPUT_EVENT>>(EventsPerController);
+	}
+
+	scratch_.resize(EventsPerController * MaxControllers);
+
+	counters.attach("xinput.polls", polls_);
+	counters.attach("xinput.changes", changes_);
+	counters.attach("xinput.delivered", delivered_);
+	counters.attach("xinput.dropped", dropped_);
+}
+
+void Indicium::Core::Input::XInputTracker::start(PFN_INDICIUM_XINPUT_BATCH callback)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	callback_ = callback;
+	started_ = true;
+	active_.store(true, std::memory_order_release);
+}
+
+void Indicium::Core::Input::XInputTracker::stop()
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	started_ = false;
+	callback_ = nullptr;
+	active_.store(sink_.load() != nullptr, std::memory_order_release);
+}
+
+void Indicium::Core::Input::XInputTracker::attach(XInputSink* sink)
+{
+	std::lock_guard<std::mutex> guard(lock_);
+
+	sink_ = sink;
+	active_.store(started_ || sink, std::memory_order_release);
+}
+
+void Indicium::Core::Input::XInputTracker::publish(Pad& pad, const INDICIUM_XINPUT_EVENT& event)
+{
+	if (pad.writing.test_and_set(std::memory_order_acquire))
+		return;
+
+	const auto sequence = pad.sequence.load(std::memory_order_relaxed);
+
+	pad.sequence.store(sequence + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	switch (event.Type)
+	{
+	case IndiciumXInputEventConnected:
+	case IndiciumXInputEventState:
+	{
+		ULONGLONG words[2] = { 0, 0 };
+		memcpy(words, &event.State.Gamepad, sizeof(XINPUT_GAMEPAD));
+
+		pad.connected.store(true, std::memory_order_relaxed);
+		pad.packet.store(event.State.dwPacketNumber, std::memory_order_relaxed);
+		pad.gamepad[0].store(words[0], std::memory_order_relaxed);
+		pad.gamepad[1].store(words[1], std::memory_order_relaxed);
+		break;
+	}
+	case IndiciumXInputEventDisconnected:
+		pad.connected.store(false, std::memory_order_relaxed);
+		break;
+	case IndiciumXInputEventVibration:
+	{
+		DWORD speeds;
+		memcpy(&speeds, &event.Vibration, sizeof(XINPUT_VIBRATION));
+
+		pad.vibration.store(speeds, std::memory_order_relaxed);
+		break;
+	}
+	}
+
+	pad.last_change.store(event.Timestamp, std::memory_order_relaxed);
+
+	pad.sequence.store(sequence + 2, std::memory_order_release);
+
+	changes_.add();
+
+	if (active_.load(std::memory_order_relaxed) && !pad.ring->try_push(event))
+		dropped_.add();
+
+	pad.writing.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Input::XInputTracker::on_get_state(DWORD user_index, const XINPUT_STATE* state, DWORD result)
+{
+	polls_.add();
+
+	if (user_index >= MaxControllers)
+		return;
+
+	auto& pad = pads_[user_index];
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	pad.last_poll.store(now.QuadPart, std::memory_order_relaxed);
+
+	const auto connected = pad.connected.load(std::memory_order_relaxed);
+
+	INDICIUM_XINPUT_EVENT event;
+	ZeroMemory(&event, sizeof(INDICIUM_XINPUT_EVENT));
+
+	if (result == ERROR_SUCCESS && state)
+	{
+		//
+		// The packet number only changes along with the state, by far the most common case
+		//
+		if (connected && pad.packet.load(std::memory_order_relaxed) == state->dwPacketNumber)
+			return;
+
+		event.Type = connected ? IndiciumXInputEventState : IndiciumXInputEventConnected;
+		event.State = *state;
+	}
+	else if (result == ERROR_DEVICE_NOT_CONNECTED && connected)
+	{
+		event.Type = IndiciumXInputEventDisconnected;
+	}
+	else
+	{
+		return;
+	}
+
+	event.UserIndex = user_index;
+	event.Timestamp = now.QuadPart;
+
+	publish(pad, event);
+}
+
+void Indicium::Core::Input::XInputTracker::on_set_state(DWORD user_index, const XINPUT_VIBRATION* vibration, DWORD result)
+{
+	if (user_index >= MaxControllers || result != ERROR_SUCCESS || !vibration)
+		return;
+
+	auto& pad = pads_[user_index];
+
+	DWORD speeds;
+	memcpy(&speeds, vibration, sizeof(XINPUT_VIBRATION));
+
+	//
+	// Games tend to set the motors every frame; they are off until told otherwise
+	//
+	if (pad.vibration.load(std::memory_order_relaxed) == speeds)
+		return;
+
+	INDICIUM_XINPUT_EVENT event;
+	ZeroMemory(&event, sizeof(INDICIUM_XINPUT_EVENT));
+
+	LARGE_INTEGER now;
+	QueryPerformanceCounter(&now);
+
+	event.UserIndex = user_index;
+	event.Type = IndiciumXInputEventVibration;
+	event.Timestamp = now.QuadPart;
+	event.Vibration = *vibration;
+
+	publish(pad, event);
+}
+
+void Indicium::Core::Input::XInputTracker::deliver(PINDICIUM_ENGINE engine)
+{
+	//
+	// Never block the render thread; if another thread is delivering we simply skip this round
+	//
+	if (draining_.test_and_set(std::memory_order_acquire))
+		return;
+
+	size_t count = 0;
+
+	for (auto& pad : pads_)
+		count += pad.ring->pop_bulk(scratch_.data() + count, scratch_.size() - count);
+
+	//
+	// Rings are per controller, restore the order of the calls across controllers
+	//
+	std::stable_sort(scratch_.begin(), scratch_.begin() + count,
+		[](const INDICIUM_XINPUT_EVENT& lhs, const INDICIUM_XINPUT_EVENT& rhs)
+	{
+		return lhs.Timestamp < rhs.Timestamp;
+	});
+
+	const auto dropped_total = dropped_.load();
+	const auto dropped = dropped_total - reported_dropped_;
+	reported_dropped_ = dropped_total;
+
+	const auto callback = callback_.load(std::memory_order_acquire);
+	const auto sink = sink_.load(std::memory_order_acquire);
+
+	if (sink && count)
+		sink->on_xinput(scratch_.data(), count);
+
+	if (callback && active_.load(std::memory_order_acquire) && (count || dropped))
+	{
+		delivered_.add(count);
+
+		INDICIUM_EVT_POST_EXTENSION post;
+		INDICIUM_EVT_POST_EXTENSION_INIT(&post, engine, IndiciumEngineGetCustomContext(engine));
+
+		callback(scratch_.data(), count, dropped, &post);
+	}
+
+	draining_.clear(std::memory_order_release);
+}
+
+void Indicium::Core::Input::XInputTracker::snapshot(DWORD user_index, PINDICIUM_XINPUT_SNAPSHOT snapshot) const
+{
+	const auto& pad = pads_[user_index];
+
+	ULONG before;
+	ULONGLONG words[2];
+	DWORD speeds;
+
+	do
+	{
+		before = pad.sequence.load(std::memory_order_acquire);
+
+		if (before & 1)
+			continue;
+
+		ZeroMemory(snapshot, sizeof(INDICIUM_XINPUT_SNAPSHOT));
+		snapshot->Connected = pad.connected.load(std::memory_order_relaxed) ? TRUE : FALSE;
+		snapshot->State.dwPacketNumber = pad.packet.load(std::memory_order_relaxed);
+		words[0] = pad.gamepad[0].load(std::memory_order_relaxed);
+		words[1] = pad.gamepad[1].load(std::memory_order_relaxed);
+		speeds = pad.vibration.load(std::memory_order_relaxed);
+		snapshot->LastChange = pad.last_change.load(std::memory_order_relaxed);
+
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+	} while ((before & 1) || pad.sequence.load(std::memory_order_relaxed) != before);
+
+	memcpy(&snapshot->State.Gamepad, words, sizeof(XINPUT_GAMEPAD));
+	memcpy(&snapshot->Vibration, &speeds, sizeof(XINPUT_VIBRATION));
+
+	snapshot->LastPoll = pad.last_poll.load(std::memory_order_relaxed);
+}
+
+void Indicium::Core::Input::XInputTracker::statistics(PINDICIUM_XINPUT_STATISTICS statistics) const
+{
+	statistics->Polls = polls_.load();
+	statistics->Changes = changes_.load();
+	statistics->Delivered = delivered_.load();
+	statistics->Dropped = dropped_.load();
+}
@@ -0,0 +1,154 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <Windows.h>
+#include <Xinput.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumXInput.h"
+
+#include "Utils/SpscRing.h"
+#include "Utils/ShardedCounter.h"
+#include "Counters.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Input
+        {
+            /**
+             * \brief   Engine-internal receiver of controller changes, called on the render thread
+             *          ahead of the batch callback.
+             */
+            class XInputSink
+            {
+            public:
+                virtual ~XInputSink() = default;
+
+                virtual void on_xinput(const INDICIUM_XINPUT_EVENT* events, size_t count) = 0;
+            };
+
+            /**
+             * \brief   Keeps the latest XInput state of every controller as seen in the calls of
+             *          the host and turns the calls which changed anything into events.
+             *
+             *          The hooks compare the packet number against the cached one, so the usual
+             *          unchanged poll costs a load and a compare. Snapshots are published through
+             *          a sequence counter per controller and can be read from any thread; changes
+             *          go into a single-producer ring per controller and are delivered as one
+             *          batch per Present.
+             */
+            class XInputTracker
+            {
+            public:
+                static const DWORD MaxControllers = XUSER_MAX_COUNT;
+
+                static const size_t EventsPerController = 256;
+
+            private:
+                struct alignas(64) Pad
+                {
+                    //
+                    // Serializes the producers of this controller; a poll racing another one of
+                    // the same controller is not recorded
+                    //
+                    std::atomic_flag writing = ATOMIC_FLAG_INIT;
+
+                    std::atomic<ULONG> sequence{ 0 };
+                    std::atomic<bool> connected{ false };
+                    std::atomic<DWORD> packet{ 0 };
+                    std::atomic<ULONGLONG> gamepad[2];
+                    std::atomic<DWORD> vibration{ 0 };
+                    std::atomic<LONGLONG> last_change{ 0 };
+                    std::atomic<LONGLONG> last_poll{ 0 };
+
+                    std::unique_ptr<Util::SpscRing<INDICIUM_XINPUT_EVENT>> ring;
+                };
+
+                Pad pads_[MaxControllers];
+
+                //
+                // Changes get queued while started or a sink is attached; guarded by lock_
+                //
+                std::mutex lock_;
+                bool started_;
+                std::atomic<bool> active_;
+                std::atomic<PFN_INDICIUM_XINPUT_BATCH> callback_;
+                std::atomic<XInputSink*> sink_;
+
+                Util::ShardedCounter polls_;
+                Util::ShardedCounter changes_;
+                Util::ShardedCounter delivered_;
+                Util::ShardedCounter dropped_;
+
+                //
+                // Consumer side; guarded by draining_
+                //
+                std::vector<INDICIUM_XINPUT_EVENT> scratch_;
+                std::atomic_flag draining_ = ATOMIC_FLAG_INIT;
+                ULONGLONG reported_dropped_;
+
+                void publish(Pad& pad, const INDICIUM_XINPUT_EVENT& event);
+
+            public:
+                explicit XInputTracker(Stats::CounterRegistry& counters);
+
+                void start(PFN_INDICIUM_XINPUT_BATCH callback);
+
+                void stop();
+
+                /**
+                 * \brief   Sets the sink receiving changes besides the callback, NULL to remove it.
+                 *          A batch being delivered while removing may still reach the old sink.
+                 */
+                void attach(XInputSink* sink);
+
+                //
+                // Hook side, called after the original function returned
+                //
+                void on_get_state(DWORD user_index, const XINPUT_STATE* state, DWORD result);
+
+                void on_set_state(DWORD user_index, const XINPUT_VIBRATION* vibration, DWORD result);
+
+                //
+                // Render thread side
+                //
+                void deliver(PINDICIUM_ENGINE engine);
+
+                void snapshot(DWORD user_index, PINDICIUM_XINPUT_SNAPSHOT snapshot) const;
+
+                void statistics(PINDICIUM_XINPUT_STATISTICS statistics) const;
+            };
+        };
+    };
+};
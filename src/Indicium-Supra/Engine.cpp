@@ -36,6 +36,22 @@ SOFTWARE.
 #include "Indicium/Engine/IndiciumDirect3D11.h"
 #include "Indicium/Engine/IndiciumDirect3D12.h"
 #include "Indicium/Engine/IndiciumCoreAudio.h"
+#include "Indicium/Engine/IndiciumEventBus.h"
+#include "Indicium/Engine/IndiciumPlugin.h"
+#include "Indicium/Engine/IndiciumTasks.h"
+#include "Indicium/Engine/IndiciumBenchmark.h"
+#include "Indicium/Engine/IndiciumCounters.h"
+#include "Indicium/Engine/IndiciumFrameStatistics.h"
+#include "Indicium/Engine/IndiciumLatency.h"
+#include "Indicium/Engine/IndiciumCapture.h"
+#include "Indicium/Engine/IndiciumSharedFrames.h"
+#include "Indicium/Engine/IndiciumScreenshot.h"
+#include "Indicium/Engine/IndiciumAudioMix.h"
+#include "Indicium/Engine/IndiciumAudioEncoder.h"
+#include "Indicium/Engine/IndiciumRawInput.h"
+#include "Indicium/Engine/IndiciumXInput.h"
+#include "Indicium/Engine/IndiciumInputReplay.h"
+#include "Indicium/Engine/IndiciumMemory.h"
 
 //
 // Internal
@@ -43,6 +59,30 @@ SOFTWARE.
 #include "Engine.h"
 #include "Game/Game.h"
 #include "Global.h"
+#include "Core/ArcEventBatcher.h"
+#include "Core/EventBus.h"
+#include "Core/PluginHost.h"
+#include "Core/WorkerPool.h"
+#include "Core/PostPresentTasks.h"
+#include "Core/TickHandlers.h"
+#include "Core/LogLimiter.h"
+#include "Core/Benchmark.h"
+#include "Core/Counters.h"
+#include "Core/FrameOverhead.h"
+#include "Core/CpuAttribution.h"
+#include "Core/DisplayTracker.h"
+#include "Core/OverheadExperiment.h"
+#include "Core/LowLatency.h"
+#include "Core/FrameCapture.h"
+#include "Core/SharedFramePublisher.h"
+#include "Core/PngEncoder.h"
+#include "Core/AudioMixer.h"
+#include "Core/AudioEncoder.h"
+#include "Core/RawInputBatcher.h"
+#include "Core/XInputTracker.h"
+#include "Core/InputReplay.h"
+#include "Core/ShaderReplacement.h"
+#include "Core/Memory.h"
 
 //
 // Logging
@@ -53,13 +93,23 @@ SOFTWARE.
 //
 // STL
 // 
+#include <cstdio>
 #include <map>
+#include <mutex>
+#include <new>
+#include <system_error>
+#include <vector>
 
 //
 // Keep track of HINSTANCE/HANDLE to engine handle association
 // 
 static std::map<HMODULE, PINDICIUM_ENGINE> g_EngineHostInstances;
 
+//
+// Serializes on-demand creation of engine sub-systems
+// 
+static std::mutex g_EngineSubsystemLock;
+
 
 INDICIUM_API INDICIUM_ERROR IndiciumEngineCreate(HMODULE HostInstance, PINDICIUM_ENGINE_CONFIG EngineConfig, PINDICIUM_ENGINE * Engine)
 {
@@ -70,6 +120,17 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineCreate(HMODULE HostInstance, PINDICIUM
 		return INDICIUM_ERROR_ENGINE_ALREADY_ALLOCATED;
 	}
 
+	//
+	// The allocator is process-wide, another live engine keeps the one it got created with
+	// 
+	if (!g_EngineHostInstances.empty() && !Indicium::Core::Memory::is_active(EngineConfig->Allocator)) {
+		return INDICIUM_ERROR_ALLOCATOR_IN_USE;
+	}
+
+	if (!Indicium::Core::Memory::install(EngineConfig->Allocator)) {
+		return INDICIUM_ERROR_ALLOCATOR_IN_USE;
+	}
+
 	//
 	// Increase host DLL reference count
 	// 
@@ -80,7 +141,8 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineCreate(HMODULE HostInstance, PINDICIUM
 		return INDICIUM_ERROR_REFERENCE_INCREMENT_FAILED;
 	}
 
-	const auto engine = static_cast<PINDICIUM_ENGINE>(malloc(sizeof(INDICIUM_ENGINE)));
+	const auto engine = static_cast<PINDICIUM_ENGINE>(
+		Indicium::Core::Memory::allocate(sizeof(INDICIUM_ENGINE), IndiciumMemoryTagEngine));
 
 	if (!engine) {
 		return INDICIUM_ERROR_ENGINE_ALLOCATION_FAILED;
@@ -93,9 +155,36 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineCreate(HMODULE HostInstance, PINDICIUM
 	engine->HostInstance = HostInstance;
 	CopyMemory(&engine->EngineConfig, EngineConfig, sizeof(INDICIUM_ENGINE_CONFIG));
 
+	//
+	// Subsystems attach their counters on creation, so the registry has to exist first
+	// 
+	{
+		Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+		engine->Counters = new (std::nothrow) Indicium::Core::Stats::CounterRegistry();
+		engine->Overhead = new (std::nothrow) Indicium::Core::Stats::FrameOverhead();
+
+		//
+		// Hooks skip counting if these fail
+		// 
+		if (engine->Counters) {
+			engine->Counters->create("hooks.present", &engine->PresentCalls);
+			engine->Counters->create("hooks.resize", &engine->ResizeCalls);
+		}
+	}
+
+	if (!engine->Counters || !engine->Overhead) {
+		delete engine->Counters;
+		delete engine->Overhead;
+		Indicium::Core::Memory::release(engine);
+		return INDICIUM_ERROR_ENGINE_ALLOCATION_FAILED;
+	}
+
 	//
 	// Set up logging
 	//
+	Indicium::Core::Memory::Scope logging(IndiciumMemoryTagLogging);
+
 	auto logger = spdlog::basic_logger_mt(
 		"indicium",
 		Indicium::Core::Util::expand_environment_variables(EngineConfig->Logging.FilePath)
@@ -130,6 +219,36 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineCreate(HMODULE HostInstance, PINDICIUM
 		return INDICIUM_ERROR_CREATE_EVENT_FAILED;
 	}
 
+	//
+	// Event to notify waiters about hooks being in place
+	// 
+	engine->EngineReadyEvent = CreateEvent(
+		nullptr,
+		TRUE, // Manual-reset event
+		FALSE, // Initial state non-signaled
+		NULL // Named unique event
+	);
+
+	if (engine->EngineReadyEvent == NULL) {
+		logger->error("Failed to create the Engine Ready Event: {}", GetLastError());
+		return INDICIUM_ERROR_CREATE_EVENT_FAILED;
+	}
+
+	//
+	// Event to wake the engine thread ahead of its next tick
+	// 
+	engine->EngineWakeEvent = CreateEvent(
+		nullptr,
+		FALSE, // Auto-reset event
+		FALSE, // Initial state non-signaled
+		NULL // Named unique event
+	);
+
+	if (engine->EngineWakeEvent == NULL) {
+		logger->error("Failed to create the Engine Wake Event: {}", GetLastError());
+		return INDICIUM_ERROR_CREATE_EVENT_FAILED;
+	}
+
 	logger->info("Indicium engine initialized, attempting to launch main thread");
 
 	//
@@ -170,9 +289,105 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineDestroy(HMODULE HostInstance)
 	const auto& engine = g_EngineHostInstances[HostInstance];
 	auto logger = spdlog::get("indicium")->clone("api");
 
+	//
+	// Hooks and the engine thread call into every subsystem below, so the thread has to
+	// be gone and the hooks removed before anything gets freed. On process exit the thread
+	// got terminated already, otherwise it's asked to unhook and finish.
+	// 
+	if (WaitForSingleObject(engine->EngineThread, 0) == WAIT_TIMEOUT) {
+		SetEvent(engine->EngineCancellationEvent);
+
+		if (WaitForSingleObject(engine->EngineThread, 3000) != WAIT_OBJECT_0) {
+			logger->error("Engine thread didn't finish, leaving resources allocated");
+			return INDICIUM_ERROR_WAIT_TIMEOUT;
+		}
+	}
+
+	IndiciumMainThreadUnhook();
+
 	logger->info("Freeing remaining resources");
 
+	//
+	// Points into the subsystems below, so it goes before any of them
+	// 
+	delete engine->Counters;
+	engine->Counters = nullptr;
+
+	delete engine->ArcBatcher;
+	engine->ArcBatcher = nullptr;
+
+	//
+	// Encoder is a sink of the mixer and goes first
+	// 
+	delete engine->AudioEncoder;
+	engine->AudioEncoder = nullptr;
+
+	delete engine->AudioMix;
+	engine->AudioMix = nullptr;
+
+	//
+	// Replay is a sink of the input subsystems and goes first
+	// 
+	delete engine->InputReplay;
+	engine->InputReplay = nullptr;
+
+	delete engine->RawInput;
+	engine->RawInput = nullptr;
+
+	delete engine->XInput;
+	engine->XInput = nullptr;
+
+	delete engine->Bus;
+	engine->Bus = nullptr;
+
+	delete engine->Plugins;
+	engine->Plugins = nullptr;
+
+	delete engine->PostPresentTasks;
+	engine->PostPresentTasks = nullptr;
+
+	delete engine->TickHandlers;
+	engine->TickHandlers = nullptr;
+
+	delete engine->Workers;
+	engine->Workers = nullptr;
+
+	delete engine->EncodeWorkers;
+	engine->EncodeWorkers = nullptr;
+
+	delete engine->Benchmark;
+	engine->Benchmark = nullptr;
+
+	delete engine->Overhead;
+	engine->Overhead = nullptr;
+
+	delete engine->CpuAttribution;
+	engine->CpuAttribution = nullptr;
+
+	delete engine->Display;
+	engine->Display = nullptr;
+
+	delete engine->Experiment;
+	engine->Experiment = nullptr;
+
+	delete engine->LowLatency;
+	engine->LowLatency = nullptr;
+
+	//
+	// Publisher is a consumer of the capture and goes first
+	// 
+	delete engine->SharedFrames;
+	engine->SharedFrames = nullptr;
+
+	delete engine->Capture;
+	engine->Capture = nullptr;
+
+	delete engine->Shaders;
+	engine->Shaders = nullptr;
+
 	CloseHandle(engine->EngineCancellationEvent);
+	CloseHandle(engine->EngineReadyEvent);
+	CloseHandle(engine->EngineWakeEvent);
 	CloseHandle(engine->EngineThread);
 
 	const auto it = g_EngineHostInstances.find(HostInstance);
@@ -194,7 +409,7 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineAllocCustomContext(PINDICIUM_ENGINE En
 		IndiciumEngineFreeCustomContext(Engine);
 	}
 
-	Engine->CustomContext = malloc(ContextSize);
+	Engine->CustomContext = Indicium::Core::Memory::allocate(ContextSize, IndiciumMemoryTagContext);
 
 	if (!Engine->CustomContext) {
 		return INDICIUM_ERROR_CONTEXT_ALLOCATION_FAILED;
@@ -213,7 +428,7 @@ INDICIUM_API INDICIUM_ERROR IndiciumEngineFreeCustomContext(PINDICIUM_ENGINE Eng
 	}
 
 	if (Engine->CustomContext) {
-		free(Engine->CustomContext);
+		Indicium::Core::Memory::release(Engine->CustomContext);
 	}
 
 	return INDICIUM_ERROR_NONE;
@@ -228,6 +443,55 @@ INDICIUM_API PVOID IndiciumEngineGetCustomContext(PINDICIUM_ENGINE Engine)
 	return Engine->CustomContext;
 }
 
+INDICIUM_API INDICIUM_ERROR IndiciumEngineWaitForReady(PINDICIUM_ENGINE Engine, DWORD Milliseconds)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	//
+	// The engine thread itself creates devices while probing; waiting there would deadlock
+	// 
+	if (GetThreadId(Engine->EngineThread) == GetCurrentThreadId()) {
+		return INDICIUM_ERROR_NONE;
+	}
+
+	//
+	// The engine thread ending without signaling (terminated, crashed) counts as failure too
+	// 
+	const HANDLE waitHandles[] = { Engine->EngineReadyEvent, Engine->EngineThread };
+
+	switch (WaitForMultipleObjects(ARRAYSIZE(waitHandles), waitHandles, FALSE, Milliseconds)) {
+	case WAIT_OBJECT_0:
+	case WAIT_OBJECT_0 + 1:
+		return Engine->EngineHooked ? INDICIUM_ERROR_NONE : INDICIUM_ERROR_ENGINE_NOT_READY;
+	default:
+		return INDICIUM_ERROR_WAIT_TIMEOUT;
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineSuspend(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	InterlockedOr(&Engine->Suspended, INDICIUM_SUSPEND_API);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineResume(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	InterlockedAnd(&Engine->Suspended, ~INDICIUM_SUSPEND_API);
+
+	return INDICIUM_ERROR_NONE;
+}
+
 #ifndef INDICIUM_NO_D3D9
 
 INDICIUM_API VOID IndiciumEngineSetD3D9EventCallbacks(PINDICIUM_ENGINE Engine, PINDICIUM_D3D9_EVENT_CALLBACKS Callbacks)
@@ -309,6 +573,43 @@ INDICIUM_API VOID IndiciumEngineSetARCEventCallbacks(PINDICIUM_ENGINE Engine, PI
 	}
 }
 
+INDICIUM_API INDICIUM_ERROR IndiciumEngineSetARCBatchConfig(PINDICIUM_ENGINE Engine, PINDICIUM_ARC_BATCH_CONFIG Config)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagAudio);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (Engine->ArcBatcher) {
+		Engine->ArcBatcher->configure(*Config);
+		return INDICIUM_ERROR_NONE;
+	}
+
+	Indicium::Core::Audio::ArcEventBatcher* batcher;
+
+	try
+	{
+		batcher = new Indicium::Core::Audio::ArcEventBatcher(*Config, *Engine->Counters);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	//
+	// Audio thread might be reading this already, publish fully constructed instance only
+	// 
+	InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->ArcBatcher), batcher);
+
+	return INDICIUM_ERROR_NONE;
+}
+
 #endif
 
 INDICIUM_API VOID IndiciumEngineLogDebug(LPCSTR Format, ...)
@@ -354,3 +655,1650 @@ INDICIUM_API VOID IndiciumEngineLogError(LPCSTR Format, ...)
 	va_end(args);
 	logger->error(buf);
 }
+
+INDICIUM_API VOID IndiciumEngineLogRateLimited(PINDICIUM_LOG_CALLSITE Callsite, INDICIUM_LOG_LEVEL Level, LPCSTR Format, ...)
+{
+	//
+	// Dropped calls must stay cheap, decide before formatting anything
+	// 
+	if (!Callsite || !Indicium::Core::Logging::admit(Callsite)) {
+		return;
+	}
+
+	spdlog::level::level_enum level;
+
+	switch (Level)
+	{
+	case IndiciumLogLevelDebug:
+		level = spdlog::level::debug;
+		break;
+	case IndiciumLogLevelInfo:
+		level = spdlog::level::info;
+		break;
+	case IndiciumLogLevelWarning:
+		level = spdlog::level::warn;
+		break;
+	default:
+		level = spdlog::level::err;
+		break;
+	}
+
+	auto logger = spdlog::get("indicium")->clone("host");
+	va_list args;
+	char buf[1000];
+	va_start(args, Format);
+	vsnprintf(buf, sizeof(buf), Format, args);
+	va_end(args);
+
+	const auto suppressed = Indicium::Core::Logging::take_suppressed(Callsite);
+
+	if (suppressed) {
+		logger->log(level, "{} similar messages suppressed", suppressed);
+	}
+
+	logger->log(level, "{}", buf);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBusCreateTopic(
+	PINDICIUM_ENGINE Engine,
+	LPCSTR Name,
+	SIZE_T MessageSize,
+	UINT32 Capacity,
+	PINDICIUM_BUS_TOPIC* Topic
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Name || !MessageSize || !Topic) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagEventBus);
+
+	if (!Engine->Bus) {
+		Indicium::Core::Bus::EventBus* bus;
+
+		try
+		{
+			bus = new Indicium::Core::Bus::EventBus(*Engine->Counters);
+		}
+		catch (const std::bad_alloc&)
+		{
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+
+		//
+		// Two modules might race creating their first topic, keep the winner
+		// 
+		if (InterlockedCompareExchangePointer(
+			reinterpret_cast<PVOID volatile*>(&Engine->Bus), bus, nullptr) != nullptr) {
+			delete bus;
+		}
+	}
+
+	Indicium::Core::Bus::Topic* topic;
+	const auto result = Engine->Bus->open(Name, MessageSize, Capacity, &topic);
+
+	if (result == INDICIUM_ERROR_NONE) {
+		*Topic = reinterpret_cast<PINDICIUM_BUS_TOPIC>(topic);
+	}
+
+	return result;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBusPublish(
+	PINDICIUM_BUS_TOPIC Topic,
+	const VOID* Message,
+	SIZE_T MessageSize
+)
+{
+	if (!Topic || !Message) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return reinterpret_cast<Indicium::Core::Bus::Topic*>(Topic)->publish(Message, MessageSize);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBusSubscribe(
+	PINDICIUM_BUS_TOPIC Topic,
+	PFN_INDICIUM_BUS_MESSAGE EvtIndiciumBusMessage,
+	PVOID Context,
+	INDICIUM_BUS_DELIVERY Delivery,
+	PINDICIUM_BUS_SUBSCRIPTION* Subscription
+)
+{
+	if (!Topic || !EvtIndiciumBusMessage) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagEventBus);
+	Indicium::Core::Bus::Subscription* subscription;
+
+	try
+	{
+		subscription = reinterpret_cast<Indicium::Core::Bus::Topic*>(Topic)->subscribe(
+			EvtIndiciumBusMessage,
+			Context,
+			Delivery
+		);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	if (Subscription) {
+		*Subscription = reinterpret_cast<PINDICIUM_BUS_SUBSCRIPTION>(subscription);
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBusUnsubscribe(PINDICIUM_BUS_SUBSCRIPTION Subscription)
+{
+	if (!Subscription) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	const auto subscription = reinterpret_cast<Indicium::Core::Bus::Subscription*>(Subscription);
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagEventBus);
+
+	try
+	{
+		subscription->topic->unsubscribe(subscription);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBusGetTopicStatistics(
+	PINDICIUM_BUS_TOPIC Topic,
+	PINDICIUM_BUS_TOPIC_STATISTICS Statistics
+)
+{
+	if (!Topic || !Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	reinterpret_cast<Indicium::Core::Bus::Topic*>(Topic)->statistics(Statistics);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumPluginAllocContext(PINDICIUM_PLUGIN Plugin, PVOID* Context, size_t ContextSize)
+{
+	if (!Plugin || !Context) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::release(Plugin->Context);
+
+	Plugin->Context = Indicium::Core::Memory::allocate(ContextSize, IndiciumMemoryTagContext);
+
+	if (!Plugin->Context) {
+		return INDICIUM_ERROR_CONTEXT_ALLOCATION_FAILED;
+	}
+
+	ZeroMemory(Plugin->Context, ContextSize);
+	*Context = Plugin->Context;
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API PVOID IndiciumPluginGetContext(PINDICIUM_PLUGIN Plugin)
+{
+	return Plugin ? Plugin->Context : nullptr;
+}
+
+#ifndef INDICIUM_NO_D3D9
+
+INDICIUM_API VOID IndiciumPluginSetD3D9EventCallbacks(PINDICIUM_PLUGIN Plugin, PINDICIUM_D3D9_EVENT_CALLBACKS Callbacks)
+{
+	if (Plugin) {
+		Plugin->EventsD3D9 = *Callbacks;
+	}
+}
+
+#endif
+
+#ifndef INDICIUM_NO_D3D10
+
+INDICIUM_API VOID IndiciumPluginSetD3D10EventCallbacks(PINDICIUM_PLUGIN Plugin, PINDICIUM_D3D10_EVENT_CALLBACKS Callbacks)
+{
+	if (Plugin) {
+		Plugin->EventsD3D10 = *Callbacks;
+	}
+}
+
+#endif
+
+#ifndef INDICIUM_NO_D3D11
+
+INDICIUM_API VOID IndiciumPluginSetD3D11EventCallbacks(PINDICIUM_PLUGIN Plugin, PINDICIUM_D3D11_EVENT_CALLBACKS Callbacks)
+{
+	if (Plugin) {
+		Plugin->EventsD3D11 = *Callbacks;
+	}
+}
+
+#endif
+
+#ifndef INDICIUM_NO_D3D12
+
+INDICIUM_API VOID IndiciumPluginSetD3D12EventCallbacks(PINDICIUM_PLUGIN Plugin, PINDICIUM_D3D12_EVENT_CALLBACKS Callbacks)
+{
+	if (Plugin) {
+		Plugin->EventsD3D12 = *Callbacks;
+	}
+}
+
+#endif
+
+#ifndef INDICIUM_NO_COREAUDIO
+
+INDICIUM_API VOID IndiciumPluginSetARCEventCallbacks(PINDICIUM_PLUGIN Plugin, PINDICIUM_ARC_EVENT_CALLBACKS Callbacks)
+{
+	if (Plugin) {
+		Plugin->EventsARC = *Callbacks;
+	}
+}
+
+#endif
+
+//
+// Creates the worker threads on first use; caller holds g_EngineSubsystemLock
+// 
+static Indicium::Core::Tasks::WorkerPool* EnsureWorkers(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine->Workers) {
+		Indicium::Core::Memory::Scope scope(IndiciumMemoryTagTasks);
+
+		Engine->Workers = new Indicium::Core::Tasks::WorkerPool(
+			Indicium::Core::Tasks::WorkerPool::default_size());
+	}
+
+	return Engine->Workers;
+}
+
+//
+// Creates the PNG encode threads on first use; caller holds g_EngineSubsystemLock
+// 
+static Indicium::Core::Tasks::WorkerPool* EnsureEncodeWorkers(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine->EncodeWorkers) {
+		Indicium::Core::Memory::Scope scope(IndiciumMemoryTagCapture);
+
+		Engine->EncodeWorkers = new Indicium::Core::Tasks::WorkerPool(
+			Indicium::Core::Tasks::WorkerPool::default_size());
+	}
+
+	return Engine->EncodeWorkers;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAddPostPresentTask(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_POST_PRESENT_TASK Task,
+	PINDICIUM_TASK_ID TaskId
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Task || !Task->EvtIndiciumPostPresentTask || (Task->DependencyCount && !Task->Dependencies)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagTasks);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	try
+	{
+		if (!Engine->PostPresentTasks) {
+			const auto tasks = new Indicium::Core::Tasks::PostPresentTasks(*EnsureWorkers(Engine), *Engine->Counters);
+
+			//
+			// Render thread might be dispatching already
+			// 
+			InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->PostPresentTasks), tasks);
+		}
+
+		return Engine->PostPresentTasks->add(*Task, TaskId);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+	catch (const std::system_error&)
+	{
+		return INDICIUM_ERROR_CREATE_THREAD_FAILED;
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineRemovePostPresentTask(
+	PINDICIUM_ENGINE Engine,
+	INDICIUM_TASK_ID TaskId
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Engine->PostPresentTasks) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return Engine->PostPresentTasks->remove(TaskId);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAddTickHandler(
+	PINDICIUM_ENGINE Engine,
+	PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick,
+	PVOID Context
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!EvtIndiciumEngineTick) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagTasks);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (!Engine->TickHandlers) {
+		const auto handlers = new (std::nothrow) Indicium::Core::Tasks::TickHandlers();
+
+		if (!handlers) {
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+
+		//
+		// Engine thread might be ticking already
+		// 
+		InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->TickHandlers), handlers);
+	}
+
+	const auto result = Engine->TickHandlers->add(EvtIndiciumEngineTick, Context);
+
+	if (result == INDICIUM_ERROR_NONE) {
+		SetEvent(Engine->EngineWakeEvent);
+	}
+
+	return result;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineRemoveTickHandler(
+	PINDICIUM_ENGINE Engine,
+	PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick,
+	PVOID Context
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Engine->TickHandlers) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return Engine->TickHandlers->remove(EvtIndiciumEngineTick, Context);
+}
+
+INDICIUM_API VOID IndiciumEngineRequestTick(
+	PINDICIUM_ENGINE Engine
+)
+{
+	if (Engine) {
+		SetEvent(Engine->EngineWakeEvent);
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetPostPresentStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_POST_PRESENT_STATISTICS Statistics
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!Engine->PostPresentTasks) {
+		ZeroMemory(Statistics, sizeof(INDICIUM_POST_PRESENT_STATISTICS));
+		return INDICIUM_ERROR_NONE;
+	}
+
+	Engine->PostPresentTasks->statistics(Statistics);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+static Indicium::Core::Bench::Benchmark* EngineBenchmark(PINDICIUM_ENGINE Engine)
+{
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (!Engine->Benchmark) {
+		INDICIUM_BENCHMARK_CONFIG config;
+		INDICIUM_BENCHMARK_CONFIG_INIT(&config);
+
+		const auto benchmark = new Indicium::Core::Bench::Benchmark(config, *Engine->Counters);
+
+		//
+		// Present hooks check the pointer without locking
+		// 
+		InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->Benchmark), benchmark);
+	}
+
+	return Engine->Benchmark;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkConfigure(PINDICIUM_ENGINE Engine, PINDICIUM_BENCHMARK_CONFIG Config)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config || Config->Significance <= 0.0 || Config->Significance >= 1.0) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+	try
+	{
+		EngineBenchmark(Engine)->configure(*Config);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkStart(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+	try
+	{
+		return EngineBenchmark(Engine)->start();
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineBenchmarkStop(PINDICIUM_ENGINE Engine, PINDICIUM_BENCHMARK_REPORT Report)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Engine->Benchmark) {
+		return INDICIUM_ERROR_BENCHMARK_NOT_RUNNING;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+
+	try
+	{
+		return Engine->Benchmark->stop(Engine, Report);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCounterRegister(PINDICIUM_ENGINE Engine, LPCSTR Name, PINDICIUM_COUNTER* Counter)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Name || !*Name || !Counter) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return Engine->Counters->create(Name, Counter);
+}
+
+INDICIUM_API VOID IndiciumEngineCounterAdd(PINDICIUM_COUNTER Counter, ULONGLONG Value)
+{
+	if (Counter) {
+		Counter->add(Value);
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetCounters(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_COUNTER_VALUE Values,
+	SIZE_T Capacity,
+	PSIZE_T Count
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Count || (!Values && Capacity)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	*Count = Engine->Counters->snapshot(Values, Capacity);
+
+	return (Values && *Count > Capacity) ? INDICIUM_ERROR_BUFFER_TOO_SMALL : INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetFrameOverhead(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_FRAME_OVERHEAD Values,
+	SIZE_T Capacity,
+	PSIZE_T Count
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Count || (!Values && Capacity)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	*Count = Engine->Overhead->snapshot(Values, Capacity);
+
+	return (Values && *Count > Capacity) ? INDICIUM_ERROR_BUFFER_TOO_SMALL : INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCpuAttributionStart(PINDICIUM_ENGINE Engine, UINT32 HistoryFrames)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	try
+	{
+		if (!Engine->CpuAttribution) {
+			const auto attribution = new Indicium::Core::Stats::CpuAttribution();
+
+			//
+			// Present hooks check the pointer without locking
+			// 
+			InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->CpuAttribution), attribution);
+		}
+
+		Engine->CpuAttribution->start(HistoryFrames);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCpuAttributionStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->CpuAttribution) {
+		Engine->CpuAttribution->stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetFrameCpuTimes(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_FRAME_CPU_TIMES Values,
+	SIZE_T Capacity,
+	PSIZE_T Count
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Count || (!Values && Capacity)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	*Count = Engine->CpuAttribution ? Engine->CpuAttribution->frames(Values, Capacity) : 0;
+
+	return (Values && *Count > Capacity) ? INDICIUM_ERROR_BUFFER_TOO_SMALL : INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineDisplayTrackingStart(PINDICIUM_ENGINE Engine, UINT32 QueryIntervalFrames)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (!Engine->Display) {
+		const auto display = new (std::nothrow) Indicium::Core::Stats::DisplayTracker();
+
+		if (!display) {
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+
+		//
+		// Present hooks check the pointer without locking
+		// 
+		InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->Display), display);
+	}
+
+	Engine->Display->start(Indicium::Core::Stats::DisplayTracker::OwnerApi, QueryIntervalFrames);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineDisplayTrackingStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (Engine->Display) {
+		Engine->Display->stop(Indicium::Core::Stats::DisplayTracker::OwnerApi);
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetDisplayStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_DISPLAY_STATISTICS Values,
+	SIZE_T Capacity,
+	PSIZE_T Count
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Count || (!Values && Capacity)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	*Count = Engine->Display ? Engine->Display->snapshot(Values, Capacity) : 0;
+
+	return (Values && *Count > Capacity) ? INDICIUM_ERROR_BUFFER_TOO_SMALL : INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineOverheadABStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_OVERHEAD_AB_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	try
+	{
+		if (!Engine->Experiment) {
+			const auto experiment = new Indicium::Core::Stats::OverheadExperiment();
+
+			//
+			// Present hooks check the pointer without locking
+			// 
+			InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->Experiment), experiment);
+		}
+
+		Engine->Experiment->start(Engine, *Config);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineOverheadABStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->Experiment) {
+		Engine->Experiment->stop(Engine);
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetOverheadEstimates(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_OVERHEAD_ESTIMATE Values,
+	SIZE_T Capacity,
+	PSIZE_T Count
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Count || (!Values && Capacity)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	try
+	{
+		*Count = Engine->Experiment ? Engine->Experiment->estimates(Values, Capacity) : 0;
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return (Values && *Count > Capacity) ? INDICIUM_ERROR_BUFFER_TOO_SMALL : INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineLowLatencyStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_LOW_LATENCY_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	//
+	// The delay follows the measured display latency, which needs the statistics of every frame
+	//
+	if (!Engine->Display) {
+		Indicium::Core::Memory::Scope scope(IndiciumMemoryTagStatistics);
+		const auto display = new (std::nothrow) Indicium::Core::Stats::DisplayTracker();
+
+		if (!display) {
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+
+		InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->Display), display);
+	}
+
+	Engine->Display->start(Indicium::Core::Stats::DisplayTracker::OwnerPacing, 1);
+
+	if (!Engine->LowLatency) {
+		Indicium::Core::Memory::Scope scope(IndiciumMemoryTagPacing);
+		const auto pacing = new (std::nothrow) Indicium::Core::Pacing::LowLatencyMode();
+
+		if (!pacing) {
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+
+		//
+		// Present hooks check the pointer without locking
+		// 
+		InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->LowLatency), pacing);
+	}
+
+	Engine->LowLatency->start(*Config);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineLowLatencyStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (Engine->LowLatency) {
+		Engine->LowLatency->stop();
+	}
+
+	//
+	// Tracking keeps running if it was started through the API as well
+	//
+	if (Engine->Display) {
+		Engine->Display->stop(Indicium::Core::Stats::DisplayTracker::OwnerPacing);
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetLowLatencyStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_LOW_LATENCY_STATISTICS Statistics
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (Engine->LowLatency) {
+		Engine->LowLatency->statistics(Statistics);
+	}
+	else {
+		ZeroMemory(Statistics, sizeof(INDICIUM_LOW_LATENCY_STATISTICS));
+		Statistics->LastDisplayLatencyMs = -1.0;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+//
+// Creates the capture subsystem on first use; caller holds g_EngineSubsystemLock
+//
+static INDICIUM_ERROR EnsureFrameCapture(PINDICIUM_ENGINE Engine)
+{
+	if (Engine->Capture) {
+		return INDICIUM_ERROR_NONE;
+	}
+
+	const auto capture = new (std::nothrow) Indicium::Core::Capture::FrameCapture(*Engine->Counters);
+
+	if (!capture) {
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	//
+	// Present hooks check the pointer without locking
+	// 
+	InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->Capture), capture);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_CAPTURE_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config || Config->Depth > INDICIUM_CAPTURE_MAX_DEPTH) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagCapture);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	const auto error = EnsureFrameCapture(Engine);
+
+	if (error != INDICIUM_ERROR_NONE) {
+		return error;
+	}
+
+	Engine->Capture->start(*Config);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->Capture) {
+		Engine->Capture->stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureSetRegions(
+	PINDICIUM_ENGINE Engine,
+	PVOID Presenter,
+	const INDICIUM_CAPTURE_REGION* Regions,
+	SIZE_T Count
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagCapture);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	const auto error = EnsureFrameCapture(Engine);
+
+	if (error != INDICIUM_ERROR_NONE) {
+		return error;
+	}
+
+	if (!Engine->Capture->set_regions(Presenter, Regions, Count)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureAddConsumer(
+	PINDICIUM_ENGINE Engine,
+	PFN_INDICIUM_CAPTURE_CONSUMER_FRAME EvtIndiciumCaptureConsumerFrame,
+	PVOID Context,
+	UINT32 MaxOutstanding,
+	PINDICIUM_CAPTURE_CONSUMER* Consumer
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!EvtIndiciumCaptureConsumerFrame || !Consumer
+		|| MaxOutstanding == 0 || MaxOutstanding > INDICIUM_CAPTURE_MAX_OUTSTANDING) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagCapture);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	const auto error = EnsureFrameCapture(Engine);
+
+	if (error != INDICIUM_ERROR_NONE) {
+		return error;
+	}
+
+	*Consumer = Engine->Capture->consumers().add(EvtIndiciumCaptureConsumerFrame, Context, MaxOutstanding);
+
+	return *Consumer ? INDICIUM_ERROR_NONE : INDICIUM_ERROR_ALLOCATION_FAILED;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureRemoveConsumer(PINDICIUM_CAPTURE_CONSUMER Consumer)
+{
+	if (!Consumer || !Indicium::Core::Capture::FramePool::remove(Consumer)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineCaptureReleaseFrame(PINDICIUM_CAPTURE_FRAME_REFERENCE Reference)
+{
+	if (!Reference || !Indicium::Core::Capture::FramePool::release(Reference)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetCaptureConsumerStatistics(
+	PINDICIUM_CAPTURE_CONSUMER Consumer,
+	PINDICIUM_CAPTURE_CONSUMER_STATISTICS Statistics
+)
+{
+	if (!Consumer || !Statistics || !Indicium::Core::Capture::FramePool::statistics(Consumer, Statistics)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineSharedFramesStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_SHARED_FRAMES_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config || !Config->Name || !Config->MaximumFrameSize || Config->Region >= INDICIUM_CAPTURE_MAX_REGIONS) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagCapture);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	const auto error = EnsureFrameCapture(Engine);
+
+	if (error != INDICIUM_ERROR_NONE) {
+		return error;
+	}
+
+	if (!Engine->SharedFrames) {
+		Engine->SharedFrames = new (std::nothrow) Indicium::Core::Capture::SharedFramePublisher(*Engine->Counters);
+
+		if (!Engine->SharedFrames) {
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+	}
+
+	return Engine->SharedFrames->start(Engine->Capture->consumers(), *Config);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineSharedFramesStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (Engine->SharedFrames) {
+		Engine->SharedFrames->stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+//
+// Encodes on the encode workers, or on the calling thread alone if they can't be started
+// 
+static INDICIUM_ERROR EncodePng(
+	PINDICIUM_ENGINE Engine,
+	const INDICIUM_CAPTURED_FRAME* Frame,
+	PINDICIUM_PNG_CONFIG Config,
+	std::vector<BYTE>& Png
+)
+{
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagCapture);
+	Indicium::Core::Capture::PngEncoder::Layout layout;
+
+	if (!Indicium::Core::Capture::PngEncoder::layout_of(*Frame, &layout)) {
+		return INDICIUM_ERROR_UNSUPPORTED_FORMAT;
+	}
+
+	Indicium::Core::Tasks::WorkerPool* workers = nullptr;
+
+	try
+	{
+		std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+		workers = EnsureEncodeWorkers(Engine);
+	}
+	catch (const std::bad_alloc&)
+	{
+	}
+	catch (const std::system_error&)
+	{
+	}
+
+	try
+	{
+		Indicium::Core::Capture::PngEncoder encoder(*Frame, layout, *Config);
+
+		return encoder.encode(workers, Png);
+	}
+	catch (const std::bad_alloc&)
+	{
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineEncodePng(
+	PINDICIUM_ENGINE Engine,
+	const INDICIUM_CAPTURED_FRAME* Frame,
+	PINDICIUM_PNG_CONFIG Config,
+	PVOID Buffer,
+	SIZE_T Capacity,
+	PSIZE_T Size
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Frame || !Frame->Data || !Frame->Width || !Frame->Height || !Config || !Size) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	const auto bound = Indicium::Core::Capture::PngEncoder::bound(*Frame, *Config);
+
+	if (!Buffer) {
+		*Size = bound;
+		return INDICIUM_ERROR_NONE;
+	}
+
+	if (Capacity < bound) {
+		*Size = bound;
+		return INDICIUM_ERROR_BUFFER_TOO_SMALL;
+	}
+
+	std::vector<BYTE> png;
+	const auto error = EncodePng(Engine, Frame, Config, png);
+
+	if (error != INDICIUM_ERROR_NONE) {
+		return error;
+	}
+
+	memcpy(Buffer, png.data(), png.size());
+	*Size = png.size();
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineSavePng(
+	PINDICIUM_ENGINE Engine,
+	const INDICIUM_CAPTURED_FRAME* Frame,
+	PINDICIUM_PNG_CONFIG Config,
+	PCSTR Path
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Frame || !Frame->Data || !Frame->Width || !Frame->Height || !Config || !Path) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	std::vector<BYTE> png;
+	const auto error = EncodePng(Engine, Frame, Config, png);
+
+	if (error != INDICIUM_ERROR_NONE) {
+		return error;
+	}
+
+	FILE* file;
+
+	if (fopen_s(&file, Path, "wb") || !file) {
+		return INDICIUM_ERROR_FILE_WRITE_FAILED;
+	}
+
+	const auto written = fwrite(png.data(), 1, png.size(), file);
+
+	if (fclose(file) || written != png.size()) {
+		return INDICIUM_ERROR_FILE_WRITE_FAILED;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioMixStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_AUDIO_MIX_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config
+		|| Config->SampleRate < 8000 || Config->SampleRate > 192000
+		|| !Config->PeriodMs || Config->PeriodMs > 1000 || Config->LatencyMs > 1000) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	//
+	// Created on the engine thread before the hooks get applied, absent without Core Audio hooks
+	// 
+	if (!Engine->AudioMix) {
+		return INDICIUM_ERROR_CORE_AUDIO_NOT_HOOKED;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagAudio);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	//
+	// A running encoder would have to drop a mixdown at a rate Opus can't encode
+	// 
+	if (Engine->AudioEncoder && Engine->AudioEncoder->running()
+		&& !Indicium::Core::Audio::AudioEncoder::supported_rate(Config->SampleRate)) {
+		return INDICIUM_ERROR_UNSUPPORTED_FORMAT;
+	}
+
+	const auto error = Engine->AudioMix->start(*Config);
+
+	if (error == INDICIUM_ERROR_NONE) {
+		SetEvent(Engine->EngineWakeEvent);
+	}
+
+	return error;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioMixStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->AudioMix) {
+		Engine->AudioMix->stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetAudioMixStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_AUDIO_MIX_STATISTICS Statistics
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (Engine->AudioMix) {
+		Engine->AudioMix->statistics(Statistics);
+	}
+	else {
+		ZeroMemory(Statistics, sizeof(INDICIUM_AUDIO_MIX_STATISTICS));
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_AUDIO_ENCODER_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config || (Config->FrameMs != 10 && Config->FrameMs != 20)
+		|| !Config->Bitrate || Config->Complexity > 10 || !Config->QueueCapacity) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!Engine->AudioMix) {
+		return INDICIUM_ERROR_CORE_AUDIO_NOT_HOOKED;
+	}
+
+	const auto rate = Engine->AudioMix->sample_rate();
+
+	if (rate && !Indicium::Core::Audio::AudioEncoder::supported_rate(rate)) {
+		return INDICIUM_ERROR_UNSUPPORTED_FORMAT;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagAudio);
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (!Engine->AudioEncoder) {
+		Engine->AudioEncoder = new (std::nothrow) Indicium::Core::Audio::AudioEncoder(*Engine->Counters);
+
+		if (!Engine->AudioEncoder) {
+			return INDICIUM_ERROR_ALLOCATION_FAILED;
+		}
+	}
+
+	return Engine->AudioEncoder->start(*Engine->AudioMix, *Config);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (Engine->AudioEncoder) {
+		Engine->AudioEncoder->stop(*Engine->AudioMix);
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAudioEncoderRead(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_AUDIO_PACKET Packet,
+	DWORD TimeoutMs
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Packet) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!Engine->AudioEncoder || !Engine->AudioEncoder->read(Packet, TimeoutMs)) {
+		return INDICIUM_ERROR_WAIT_TIMEOUT;
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetAudioEncoderStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_AUDIO_ENCODER_STATISTICS Statistics
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (Engine->AudioEncoder) {
+		Engine->AudioEncoder->statistics(Statistics);
+	}
+	else {
+		ZeroMemory(Statistics, sizeof(INDICIUM_AUDIO_ENCODER_STATISTICS));
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineRawInputStart(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_RAW_INPUT_CONFIG Config
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Config || !Config->EvtIndiciumRawInputBatch) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	//
+	// Created on the engine thread before the hooks get applied, absent without raw input hooks
+	// 
+	if (!Engine->RawInput) {
+		return INDICIUM_ERROR_RAW_INPUT_NOT_HOOKED;
+	}
+
+	Engine->RawInput->start(*Config);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineRawInputStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->RawInput) {
+		Engine->RawInput->stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetRawInputStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_RAW_INPUT_STATISTICS Statistics
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (Engine->RawInput) {
+		Engine->RawInput->statistics(Statistics);
+	}
+	else {
+		ZeroMemory(Statistics, sizeof(INDICIUM_RAW_INPUT_STATISTICS));
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineXInputStart(
+	PINDICIUM_ENGINE Engine,
+	PFN_INDICIUM_XINPUT_BATCH EvtIndiciumXInputBatch
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!EvtIndiciumXInputBatch) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!Engine->XInput) {
+		return INDICIUM_ERROR_XINPUT_NOT_HOOKED;
+	}
+
+	Engine->XInput->start(EvtIndiciumXInputBatch);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineXInputStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->XInput) {
+		Engine->XInput->stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetXInputSnapshot(
+	PINDICIUM_ENGINE Engine,
+	DWORD UserIndex,
+	PINDICIUM_XINPUT_SNAPSHOT Snapshot
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Snapshot || UserIndex >= XUSER_MAX_COUNT) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (!Engine->XInput) {
+		return INDICIUM_ERROR_XINPUT_NOT_HOOKED;
+	}
+
+	Engine->XInput->snapshot(UserIndex, Snapshot);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetXInputStatistics(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_XINPUT_STATISTICS Statistics
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Statistics) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (Engine->XInput) {
+		Engine->XInput->statistics(Statistics);
+	}
+	else {
+		ZeroMemory(Statistics, sizeof(INDICIUM_XINPUT_STATISTICS));
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+static Indicium::Core::Input::InputReplay* EngineInputReplay(PINDICIUM_ENGINE Engine)
+{
+	std::lock_guard<std::mutex> guard(g_EngineSubsystemLock);
+
+	if (!Engine->InputReplay) {
+		Indicium::Core::Memory::Scope scope(IndiciumMemoryTagInput);
+
+		const auto replay = new (std::nothrow) Indicium::Core::Input::InputReplay();
+
+		//
+		// Present and XInput hooks check the pointer without locking
+		// 
+		InterlockedExchangePointer(reinterpret_cast<PVOID volatile*>(&Engine->InputReplay), replay);
+	}
+
+	return Engine->InputReplay;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineInputRecordStart(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Engine->RawInput && !Engine->XInput) {
+		return INDICIUM_ERROR_RAW_INPUT_NOT_HOOKED;
+	}
+
+	const auto replay = EngineInputReplay(Engine);
+
+	if (!replay) {
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	return replay->record_start(Engine->RawInput, Engine->XInput);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineInputRecordStop(PINDICIUM_ENGINE Engine, PCSTR Path)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Engine->InputReplay) {
+		return INDICIUM_ERROR_NONE;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagInput);
+
+	return Engine->InputReplay->record_stop(Path);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineInputReplayStart(
+	PINDICIUM_ENGINE Engine,
+	PCSTR Path,
+	INDICIUM_INPUT_REPLAY_MODE Mode
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Path || (Mode != IndiciumInputReplayFrameAligned && Mode != IndiciumInputReplayTimed)) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	const auto replay = EngineInputReplay(Engine);
+
+	if (!replay) {
+		return INDICIUM_ERROR_ALLOCATION_FAILED;
+	}
+
+	Indicium::Core::Memory::Scope scope(IndiciumMemoryTagInput);
+
+	return replay->replay_start(Path, Mode, Engine->XInput);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineInputReplayStop(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (Engine->InputReplay) {
+		Engine->InputReplay->replay_stop();
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetInputReplayStatus(
+	PINDICIUM_ENGINE Engine,
+	PINDICIUM_INPUT_REPLAY_STATUS Status
+)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Status) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	if (Engine->InputReplay) {
+		Engine->InputReplay->status(Status);
+	}
+	else {
+		ZeroMemory(Status, sizeof(INDICIUM_INPUT_REPLAY_STATUS));
+	}
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineGetMemoryUsage(PINDICIUM_ENGINE Engine, PINDICIUM_MEMORY_REPORT Report)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	if (!Report) {
+		return INDICIUM_ERROR_INVALID_PARAMETER;
+	}
+
+	Indicium::Core::Memory::report(Report);
+
+	return INDICIUM_ERROR_NONE;
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineResetMemoryPeaks(PINDICIUM_ENGINE Engine)
+{
+	if (!Engine) {
+		return INDICIUM_ERROR_INVALID_ENGINE_HANDLE;
+	}
+
+	Indicium::Core::Memory::reset_peaks();
+
+	return INDICIUM_ERROR_NONE;
+}
@@ -26,6 +26,79 @@ SOFTWARE.
 #pragma once
 
 
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Audio
+        {
+            class ArcEventBatcher;
+            class AudioMixer;
+            class AudioEncoder;
+        };
+
+        namespace Bus
+        {
+            class EventBus;
+        };
+
+        namespace Plugins
+        {
+            class PluginHost;
+        };
+
+        namespace Tasks
+        {
+            class WorkerPool;
+            class PostPresentTasks;
+            class TickHandlers;
+        };
+
+        namespace Bench
+        {
+            class Benchmark;
+        };
+
+        namespace Stats
+        {
+            class CounterRegistry;
+            class FrameOverhead;
+            class CpuAttribution;
+            class DisplayTracker;
+            class OverheadExperiment;
+        };
+
+        namespace Pacing
+        {
+            class LowLatencyMode;
+        };
+
+        namespace Capture
+        {
+            class FrameCapture;
+            class SharedFramePublisher;
+        };
+
+        namespace Input
+        {
+            class RawInputBatcher;
+            class XInputTracker;
+            class InputReplay;
+        };
+
+        namespace Shaders
+        {
+            class ShaderReplacement;
+        };
+    };
+};
+
+//
+// Reasons for the Present hooks to bypass the engine, combined in INDICIUM_ENGINE::Suspended
+//
+#define INDICIUM_SUSPEND_API            0x1
+#define INDICIUM_SUSPEND_EXPERIMENT     0x2
+
 //
 // Internal engine instance properties
 //
@@ -81,11 +154,36 @@ typedef struct _INDICIUM_ENGINE
     //
     HANDLE EngineCancellationEvent;
 
+    //
+    // Manual-reset event signaled once the engine thread is done setting up hooks or shuts down
+    //
+    HANDLE EngineReadyEvent;
+
+    //
+    // TRUE while all hooks are in place, valid once EngineReadyEvent is signaled
+    //
+    volatile LONG EngineHooked;
+
+    //
+    // Auto-reset event waking the engine thread for work due before its next tick
+    //
+    HANDLE EngineWakeEvent;
+
     //
     // Custom context data traveling along with this instance
     // 
     PVOID CustomContext;
 
+    //
+    // INDICIUM_SUSPEND_* reasons; while nonzero, Present hooks call the original right away
+    // 
+    volatile LONG Suspended;
+
+    //
+    // Nonzero while the callbacks registered on the engine are left out of dispatch
+    // 
+    volatile LONG SkipHostCallbacks;
+
     union
     {
         IDXGISwapChain* pSwapChain;
@@ -102,34 +200,172 @@ typedef struct _INDICIUM_ENGINE
 
     } CoreAudio;
 
+    //
+    // Batched Audio Render Client event delivery, NULL unless requested
+    // 
+    Indicium::Core::Audio::ArcEventBatcher *ArcBatcher;
+
+    //
+    // Mixdown of all render clients, created along with the Core Audio hooks
+    // 
+    Indicium::Core::Audio::AudioMixer *AudioMix;
+
+    //
+    // Opus packets of the mixdown, NULL until started
+    // 
+    Indicium::Core::Audio::AudioEncoder *AudioEncoder;
+
+    //
+    // Raw input read by the host, created along with the raw input hooks
+    // 
+    Indicium::Core::Input::RawInputBatcher *RawInput;
+
+    //
+    // Latest controller states seen by the XInput hooks, created along with them
+    // 
+    Indicium::Core::Input::XInputTracker *XInput;
+
+    //
+    // Input recording and replay, NULL until first used
+    // 
+    Indicium::Core::Input::InputReplay *InputReplay;
+
+    //
+    // Inter-module publish/subscribe bus, created on first topic
+    // 
+    Indicium::Core::Bus::EventBus *Bus;
+
+    //
+    // Loaded plugins receiving events alongside the callbacks above, NULL unless enabled
+    // 
+    Indicium::Core::Plugins::PluginHost *Plugins;
+
+    //
+    // Engine worker threads, created on demand
+    // 
+    Indicium::Core::Tasks::WorkerPool *Workers;
+
+    //
+    // Threads for PNG encodes, created on demand; kept apart so encodes never hold up
+    // Post-Present tasks
+    // 
+    Indicium::Core::Tasks::WorkerPool *EncodeWorkers;
+
+    //
+    // Tasks executed after every Present, NULL until the first one gets added
+    // 
+    Indicium::Core::Tasks::PostPresentTasks *PostPresentTasks;
+
+    //
+    // Handlers run at every engine tick, NULL until the first one gets added
+    // 
+    Indicium::Core::Tasks::TickHandlers *TickHandlers;
+
+    //
+    // Benchmark runs, NULL until configured or started
+    // 
+    Indicium::Core::Bench::Benchmark *Benchmark;
+
+    //
+    // Named counters of the engine subsystems and API users
+    // 
+    Indicium::Core::Stats::CounterRegistry *Counters;
+
+    //
+    // Present and resize hook calls, registered in Counters as hooks.present and hooks.resize
+    // 
+    struct _INDICIUM_COUNTER *PresentCalls;
+    struct _INDICIUM_COUNTER *ResizeCalls;
+
+    //
+    // Engine time versus original Present time per presenter
+    // 
+    Indicium::Core::Stats::FrameOverhead *Overhead;
+
+    //
+    // Per-thread CPU time sampling at Present boundaries, NULL until started
+    // 
+    Indicium::Core::Stats::CpuAttribution *CpuAttribution;
+
+    //
+    // Display-side presentation statistics, NULL until started
+    // 
+    Indicium::Core::Stats::DisplayTracker *Display;
+
+    //
+    // Alternating suspended and active frame windows, NULL until started
+    // 
+    Indicium::Core::Stats::OverheadExperiment *Experiment;
+
+    //
+    // Render queue reduction and pacing, NULL until started
+    // 
+    Indicium::Core::Pacing::LowLatencyMode *LowLatency;
+
+    //
+    // Back buffer region capture, NULL until started or regions get set
+    // 
+    Indicium::Core::Capture::FrameCapture *Capture;
+
+    //
+    // Captured frames published to shared memory, NULL until started
+    // 
+    Indicium::Core::Capture::SharedFramePublisher *SharedFrames;
+
+    //
+    // Shader bytecode substitution, created along with the shader hooks
+    // 
+    Indicium::Core::Shaders::ShaderReplacement *Shaders;
+
 } INDICIUM_ENGINE;
 
+//
+// Callbacks registered on the engine fire first, followed by those of loaded plugins
+//
 #define INVOKE_INDICIUM_GAME_HOOKED(_engine_, _version_)    \
-                                    (_engine_->EngineConfig.EvtIndiciumGameHooked ? \
+                                    ((_engine_->EngineConfig.EvtIndiciumGameHooked ? \
                                     _engine_->EngineConfig.EvtIndiciumGameHooked(_engine_, _version_) : \
-                                    (void)0)
+                                    (void)0), \
+                                    (_engine_->Plugins ? \
+                                    _engine_->Plugins->on_game_hooked(_version_) : \
+                                    (void)0))
 
 #define INVOKE_D3D9_CALLBACK(_engine_, _callback_, ...)     \
-                            (_engine_->EventsD3D9._callback_ ? \
+                            ((_engine_->EventsD3D9._callback_ && !_engine_->SkipHostCallbacks ? \
                             _engine_->EventsD3D9._callback_(##__VA_ARGS__) : \
-                            (void)0)
+                            (void)0), \
+                            (_engine_->Plugins ? \
+                            _engine_->Plugins->invoke(&INDICIUM_D3D9_EVENT_CALLBACKS::_callback_, __VA_ARGS__) : \
+                            (void)0))
 
 #define INVOKE_D3D10_CALLBACK(_engine_, _callback_, ...)     \
-                             (_engine_->EventsD3D10._callback_ ? \
+                             ((_engine_->EventsD3D10._callback_ && !_engine_->SkipHostCallbacks ? \
                              _engine_->EventsD3D10._callback_(##__VA_ARGS__) : \
-                             (void)0)
+                             (void)0), \
+                             (_engine_->Plugins ? \
+                             _engine_->Plugins->invoke(&INDICIUM_D3D10_EVENT_CALLBACKS::_callback_, __VA_ARGS__) : \
+                             (void)0))
 
 #define INVOKE_D3D11_CALLBACK(_engine_, _callback_, ...)     \
-                             (_engine_->EventsD3D11._callback_ ? \
+                             ((_engine_->EventsD3D11._callback_ && !_engine_->SkipHostCallbacks ? \
                              _engine_->EventsD3D11._callback_(##__VA_ARGS__) : \
-                             (void)0)
+                             (void)0), \
+                             (_engine_->Plugins ? \
+                             _engine_->Plugins->invoke(&INDICIUM_D3D11_EVENT_CALLBACKS::_callback_, __VA_ARGS__) : \
+                             (void)0))
 
 #define INVOKE_D3D12_CALLBACK(_engine_, _callback_, ...)     \
-                             (_engine_->EventsD3D12._callback_ ? \
+                             ((_engine_->EventsD3D12._callback_ && !_engine_->SkipHostCallbacks ? \
                              _engine_->EventsD3D12._callback_(##__VA_ARGS__) : \
-                             (void)0)
+                             (void)0), \
+                             (_engine_->Plugins ? \
+                             _engine_->Plugins->invoke(&INDICIUM_D3D12_EVENT_CALLBACKS::_callback_, __VA_ARGS__) : \
+                             (void)0))
 
 #define INVOKE_ARC_CALLBACK(_engine_, _callback_, ...)     \
-                             (_engine_->EventsARC._callback_ ? \
+                             ((_engine_->EventsARC._callback_ && !_engine_->SkipHostCallbacks ? \
                              _engine_->EventsARC._callback_(##__VA_ARGS__) : \
-                             (void)0)
+                             (void)0), \
+                             (_engine_->Plugins ? \
+                             _engine_->Plugins->invoke(&INDICIUM_ARC_EVENT_CALLBACKS::_callback_, __VA_ARGS__) : \
+                             (void)0))
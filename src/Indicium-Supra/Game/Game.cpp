@@ -53,11 +53,24 @@ using namespace Indicium::Core::Exceptions;
 #include "Indicium/Engine/IndiciumDirect3D11.h"
 #include "Indicium/Engine/IndiciumDirect3D12.h"
 #include "Indicium/Engine/IndiciumCoreAudio.h"
+#include "Indicium/Engine/IndiciumAudioMix.h"
+#include "Indicium/Engine/IndiciumRawInput.h"
+#include "Indicium/Engine/IndiciumXInput.h"
 
 //
 // Internal
 // 
 #include "Engine.h"
+#include "Core/Dispatch.h"
+#include "Core/ArcEventBatcher.h"
+#include "Core/AudioMixer.h"
+#include "Core/RawInputBatcher.h"
+#include "Core/XInputTracker.h"
+#include "Core/InputReplay.h"
+#include "Core/PluginHost.h"
+#include "Core/LogLimiter.h"
+#include "Core/ShaderReplacement.h"
+#include "Core/Benchmark.h"
 
 //
 // STL
@@ -84,6 +97,19 @@ Hook<CallConvention::stdcall_t, HRESULT, LPDIRECTINPUTDEVICE8, LPDIDEVICEOBJECTI
 void HookDInput8(size_t* vtable8);
 #endif
 
+//
+// Set by the engine thread before it installs any hook
+// 
+static void (*g_RemoveHooks)() = nullptr;
+
+void IndiciumMainThreadUnhook()
+{
+    if (g_RemoveHooks)
+    {
+        g_RemoveHooks();
+    }
+}
+
 /**
  * \fn  void IndiciumMainThread(LPVOID Params)
  *
@@ -104,6 +130,8 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 
     logger->info("Library enabled");
 
+    Indicium::Core::Dispatch::OnEngineStart(engine);
+
     // 
     // D3D9 Hooks
     // 
@@ -139,6 +167,9 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
     static Hook<CallConvention::stdcall_t, HRESULT, IDXGISwapChain*, UINT, UINT> swapChainPresent11Hook;
     static Hook<CallConvention::stdcall_t, HRESULT, IDXGISwapChain*, const DXGI_MODE_DESC*> swapChainResizeTarget11Hook;
     static Hook<CallConvention::stdcall_t, HRESULT, IDXGISwapChain*, UINT, UINT, UINT, DXGI_FORMAT, UINT> swapChainResizeBuffers11Hook;
+    static Hook<CallConvention::stdcall_t, HRESULT, ID3D11Device*, const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11VertexShader**> createVertexShader11Hook;
+    static Hook<CallConvention::stdcall_t, HRESULT, ID3D11Device*, const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11PixelShader**> createPixelShader11Hook;
+    static Hook<CallConvention::stdcall_t, HRESULT, ID3D11Device*, const void*, SIZE_T, ID3D11ClassLinkage*, ID3D11ComputeShader**> createComputeShader11Hook;
 #else
     logger->info("Direct3D 11 hooking disabled at compile time");
 #endif
@@ -160,16 +191,97 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 #ifndef INDICIUM_NO_COREAUDIO
     static Hook<CallConvention::stdcall_t, HRESULT, IAudioRenderClient*, UINT32, BYTE**> arcGetBufferHook;
     static Hook<CallConvention::stdcall_t, HRESULT, IAudioRenderClient*, UINT32, DWORD> arcReleaseBufferHook;
+    static Hook<CallConvention::stdcall_t, HRESULT, IAudioClient*, AUDCLNT_SHAREMODE, DWORD,
+        REFERENCE_TIME, REFERENCE_TIME, const WAVEFORMATEX*, LPCGUID> audioClientInitializeHook;
+    static Hook<CallConvention::stdcall_t, HRESULT, IAudioClient*, REFIID, void**> audioClientGetServiceHook;
+    static Hook<CallConvention::stdcall_t, ULONG, IUnknown*> arcReleaseHook;
+    static Hook<CallConvention::stdcall_t, ULONG, IUnknown*> audioClientReleaseHook;
 #else
     logger->info("Core Audio hooking disabled at compile time");
 #endif
 
+    //
+    // Raw Input Hooks
+    // 
+    static Hook<CallConvention::stdcall_t, UINT, HRAWINPUT, UINT, LPVOID, PUINT, UINT> getRawInputDataHook;
+    static Hook<CallConvention::stdcall_t, UINT, PRAWINPUT, PUINT, UINT> getRawInputBufferHook;
+
+    //
+    // XInput Hooks
+    // 
+    static Hook<CallConvention::stdcall_t, DWORD, DWORD, XINPUT_STATE*> xinputGetStateHook;
+    static Hook<CallConvention::stdcall_t, DWORD, DWORD, XINPUT_VIBRATION*> xinputSetStateHook;
+
     //
     // Internal flow-control hooks
     // 
     static Hook<CallConvention::stdcall_t, VOID, UINT> exitProcessHook;
 	static Hook<CallConvention::stdcall_t, void, int> postQuitMessageHook;
 
+    //
+    // Hooks live in here, the engine thread and IndiciumEngineDestroy remove them through this
+    // 
+    g_RemoveHooks = []()
+    {
+        try
+        {
+#ifndef INDICIUM_NO_D3D9
+            present9Hook.remove();
+            reset9Hook.remove();
+            endScene9Hook.remove();
+            present9ExHook.remove();
+            reset9ExHook.remove();
+#endif
+
+#ifndef INDICIUM_NO_D3D10
+            swapChainPresent10Hook.remove();
+            swapChainResizeTarget10Hook.remove();
+            swapChainResizeBuffers10Hook.remove();
+#endif
+
+#ifndef INDICIUM_NO_D3D11
+            swapChainPresent11Hook.remove();
+            swapChainResizeTarget11Hook.remove();
+            swapChainResizeBuffers11Hook.remove();
+            createVertexShader11Hook.remove();
+            createPixelShader11Hook.remove();
+            createComputeShader11Hook.remove();
+#endif
+
+#ifndef INDICIUM_NO_D3D12
+            swapChainPresent12Hook.remove();
+            swapChainResizeTarget12Hook.remove();
+            swapChainResizeBuffers12Hook.remove();
+#endif
+
+#ifndef INDICIUM_NO_COREAUDIO
+            arcGetBufferHook.remove();
+            arcReleaseBufferHook.remove();
+            audioClientInitializeHook.remove();
+            audioClientGetServiceHook.remove();
+            arcReleaseHook.remove();
+            audioClientReleaseHook.remove();
+#endif
+
+            getRawInputDataHook.remove();
+            getRawInputBufferHook.remove();
+            xinputGetStateHook.remove();
+            xinputSetStateHook.remove();
+
+            //
+            // Exit hooks may be running right now, they continue into the original function
+            // 
+            exitProcessHook.remove();
+            postQuitMessageHook.remove();
+
+            spdlog::get("indicium")->clone("game")->info("Hooks disabled");
+        }
+        catch (DetourException& pex)
+        {
+            spdlog::get("indicium")->clone("game")->error("Unhooking failed: {}", pex.what());
+        }
+    };
+
     /*
      * This is a bit of a gamble but ExitProcess is expected to be implicitly called
      * _before_ the injected DLL gets unloaded (without proper call to FreeLibrary)
@@ -409,12 +521,28 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     INVOKE_INDICIUM_GAME_HOOKED(engine, IndiciumDirect3DVersion9);
                 });
 
+                //
+                // Suspended engine: one flag check, then straight to the original
+                // 
+                if (engine->Suspended) {
+                    Indicium::Core::Dispatch::OnSuspendedPresent(engine);
+                    return present9Hook.call_orig(dev, a1, a2, a3, a4);
+                }
+
+                Indicium::Core::Dispatch::OnPrePresent(engine);
+
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PrePresent, dev, a1, a2, a3, a4);
 
+                Indicium::Core::Dispatch::BeginOriginalPresent(engine, IndiciumDirect3DVersion9, dev);
+
                 const auto ret = present9Hook.call_orig(dev, a1, a2, a3, a4);
 
+                Indicium::Core::Dispatch::EndOriginalPresent(engine);
+
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PostPresent, dev, a1, a2, a3, a4);
 
+                Indicium::Core::Dispatch::OnPostPresent(engine, IndiciumDirect3DVersion9, dev, ret);
+
                 return ret;
             });
 
@@ -433,10 +561,14 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PreReset, dev, pp);
 
+                Indicium::Core::Dispatch::OnPreResize(engine, dev);
+
                 const auto ret = reset9Hook.call_orig(dev, pp);
 
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PostReset, dev, pp);
 
+                Indicium::Core::Dispatch::OnPostResize(engine, IndiciumDirect3DVersion9, ret);
+
                 return ret;
             });
 
@@ -452,6 +584,10 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     spdlog::get("indicium")->clone("d3d9")->info("++ IDirect3DDevice9Ex::EndScene called");
                 });
 
+                if (engine->Suspended) {
+                    return endScene9Hook.call_orig(dev);
+                }
+
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PreEndScene, dev);
 
                 const auto ret = endScene9Hook.call_orig(dev);
@@ -482,12 +618,25 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     INVOKE_INDICIUM_GAME_HOOKED(engine, IndiciumDirect3DVersion9);
                 });
 
+                if (engine->Suspended) {
+                    Indicium::Core::Dispatch::OnSuspendedPresent(engine);
+                    return present9ExHook.call_orig(dev, a1, a2, a3, a4, a5);
+                }
+
+                Indicium::Core::Dispatch::OnPrePresent(engine);
+
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PrePresentEx, dev, a1, a2, a3, a4, a5);
 
+                Indicium::Core::Dispatch::BeginOriginalPresent(engine, IndiciumDirect3DVersion9, dev);
+
                 const auto ret = present9ExHook.call_orig(dev, a1, a2, a3, a4, a5);
 
+                Indicium::Core::Dispatch::EndOriginalPresent(engine);
+
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PostPresentEx, dev, a1, a2, a3, a4, a5);
 
+                Indicium::Core::Dispatch::OnPostPresent(engine, IndiciumDirect3DVersion9, dev, ret);
+
                 return ret;
             });
 
@@ -507,10 +656,14 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PreResetEx, dev, pp, ppp);
 
+                Indicium::Core::Dispatch::OnPreResize(engine, dev);
+
                 const auto ret = reset9ExHook.call_orig(dev, pp, ppp);
 
                 INVOKE_D3D9_CALLBACK(engine, EvtIndiciumD3D9PostResetEx, dev, pp, ppp);
 
+                Indicium::Core::Dispatch::OnPostResize(engine, IndiciumDirect3DVersion9, ret);
+
                 return ret;
             });
         }
@@ -554,34 +707,42 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                 ) -> HRESULT
             {
                 static std::once_flag flag;
-                std::call_once(flag, [&pChain = chain]()
+                std::call_once(flag, []()
                 {
-                    auto l = spdlog::get("indicium")->clone("d3d10");
-                    l->info("++ IDXGISwapChain::Present called");
+                    spdlog::get("indicium")->clone("d3d10")->info("++ IDXGISwapChain::Present called");
+                });
 
+                //
+                // Retried every frame until the chain hands out a device
+                // 
+                if (deviceVersion == IndiciumDirect3DVersionUnknown) {
                     ID3D10Device *pp10Device = nullptr;
                     ID3D11Device *pp11Device = nullptr;
 
-                    auto ret = pChain->GetDevice(__uuidof(ID3D10Device), reinterpret_cast<PVOID*>(&pp10Device));
-
-                    if (SUCCEEDED(ret)) {
-                        l->debug("ID3D10Device object acquired");
+                    if (SUCCEEDED(chain->GetDevice(__uuidof(ID3D10Device), reinterpret_cast<PVOID*>(&pp10Device)))) {
+                        pp10Device->Release();
+                        spdlog::get("indicium")->clone("d3d10")->debug("ID3D10Device object acquired");
                         deviceVersion = IndiciumDirect3DVersion10;
                         INVOKE_INDICIUM_GAME_HOOKED(engine, deviceVersion);
-                        return;
                     }
-
-                    ret = pChain->GetDevice(__uuidof(ID3D11Device), reinterpret_cast<PVOID*>(&pp11Device));
-
-                    if (SUCCEEDED(ret)) {
-                        l->debug("ID3D11Device object acquired");
+                    else if (SUCCEEDED(chain->GetDevice(__uuidof(ID3D11Device), reinterpret_cast<PVOID*>(&pp11Device)))) {
+                        pp11Device->Release();
+                        spdlog::get("indicium")->clone("d3d10")->debug("ID3D11Device object acquired");
                         deviceVersion = IndiciumDirect3DVersion11;
                         INVOKE_INDICIUM_GAME_HOOKED(engine, deviceVersion);
-                        return;
                     }
+                    else {
+                        INDICIUM_LOG_LIMITED(spdlog::get("indicium")->clone("d3d10"), error, 1, 5,
+                            "Could not fetch device pointer");
+                    }
+                }
 
-                    l->error("Could not fetch device pointer");
-                });
+                if (engine->Suspended) {
+                    Indicium::Core::Dispatch::OnSuspendedPresent(engine);
+                    return swapChainPresent10Hook.call_orig(chain, SyncInterval, Flags);
+                }
+
+                Indicium::Core::Dispatch::OnPrePresent(engine);
 
                 INDICIUM_EVT_PRE_EXTENSION pre;
                 INDICIUM_EVT_PRE_EXTENSION_INIT(&pre, engine, engine->CustomContext);
@@ -597,8 +758,12 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                         SyncInterval, Flags, &pre);
                 }
 
+                Indicium::Core::Dispatch::BeginOriginalPresent(engine, deviceVersion, chain);
+
                 const auto ret = swapChainPresent10Hook.call_orig(chain, SyncInterval, Flags);
 
+                Indicium::Core::Dispatch::EndOriginalPresent(engine);
+
                 if (deviceVersion == IndiciumDirect3DVersion10) {
                     INVOKE_D3D10_CALLBACK(engine, EvtIndiciumD3D10PostPresent, chain, SyncInterval, Flags);
                 }
@@ -608,6 +773,8 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                         SyncInterval, Flags, &post);
                 }
 
+                Indicium::Core::Dispatch::OnPostPresent(engine, deviceVersion, chain, ret);
+
                 return ret;
             });
 
@@ -696,6 +863,8 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                         BufferCount, Width, Height, NewFormat, SwapChainFlags, &pre);
                 }
 
+                Indicium::Core::Dispatch::OnPreResize(engine, chain);
+
                 const auto ret = swapChainResizeBuffers10Hook.call_orig(chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags);
 
@@ -709,6 +878,8 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                         BufferCount, Width, Height, NewFormat, SwapChainFlags, &post);
                 }
 
+                Indicium::Core::Dispatch::OnPostResize(engine, deviceVersion, ret);
+
                 return ret;
             });
         }
@@ -759,6 +930,13 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     INVOKE_INDICIUM_GAME_HOOKED(engine, IndiciumDirect3DVersion11);
                 });
 
+                if (engine->Suspended) {
+                    Indicium::Core::Dispatch::OnSuspendedPresent(engine);
+                    return swapChainPresent11Hook.call_orig(chain, SyncInterval, Flags);
+                }
+
+                Indicium::Core::Dispatch::OnPrePresent(engine);
+
                 INDICIUM_EVT_PRE_EXTENSION pre;
                 INDICIUM_EVT_PRE_EXTENSION_INIT(&pre, engine, engine->CustomContext);
                 INDICIUM_EVT_POST_EXTENSION post;
@@ -773,8 +951,12 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     &pre
                 );
 
+                Indicium::Core::Dispatch::BeginOriginalPresent(engine, IndiciumDirect3DVersion11, chain);
+
                 const auto ret = swapChainPresent11Hook.call_orig(chain, SyncInterval, Flags);
 
+                Indicium::Core::Dispatch::EndOriginalPresent(engine);
+
                 INVOKE_D3D11_CALLBACK(
                     engine,
                     EvtIndiciumD3D11PostPresent,
@@ -784,6 +966,8 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     &post
                 );
 
+                Indicium::Core::Dispatch::OnPostPresent(engine, IndiciumDirect3DVersion11, chain, ret);
+
                 return ret;
             });
 
@@ -851,14 +1035,95 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                 INVOKE_D3D11_CALLBACK(engine, EvtIndiciumD3D11PreResizeBuffers, chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags, &pre);
 
+                Indicium::Core::Dispatch::OnPreResize(engine, chain);
+
                 const auto ret = swapChainResizeBuffers11Hook.call_orig(chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags);
 
                 INVOKE_D3D11_CALLBACK(engine, EvtIndiciumD3D11PostResizeBuffers, chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags, &post);
 
+                Indicium::Core::Dispatch::OnPostResize(engine, IndiciumDirect3DVersion11, ret);
+
                 return ret;
             });
+
+            //
+            // Device hooks only exist with a loaded replacement table
+            // 
+            if (config.Shaders.HookDirect3D11 && engine->Shaders)
+            {
+                const auto device = d3d11->device_vtable();
+
+                logger->info("Hooking ID3D11Device::CreateVertexShader");
+
+                createVertexShader11Hook.apply(device[Direct3D11Hooking::CreateVertexShader], [](
+                    ID3D11Device* pDevice,
+                    const void* pShaderBytecode,
+                    SIZE_T BytecodeLength,
+                    ID3D11ClassLinkage* pClassLinkage,
+                    ID3D11VertexShader** ppVertexShader
+                    ) -> HRESULT
+                {
+                    static std::once_flag flag;
+                    std::call_once(flag, []()
+                    {
+                        spdlog::get("indicium")->clone("d3d11")->info("++ ID3D11Device::CreateVertexShader called");
+                    });
+
+                    return engine->Shaders->create(Indicium::Core::Shaders::Stage::Vertex, pShaderBytecode, BytecodeLength,
+                        [&](const void* code, SIZE_T length)
+                    {
+                        return createVertexShader11Hook.call_orig(pDevice, code, length, pClassLinkage, ppVertexShader);
+                    });
+                });
+
+                logger->info("Hooking ID3D11Device::CreatePixelShader");
+
+                createPixelShader11Hook.apply(device[Direct3D11Hooking::CreatePixelShader], [](
+                    ID3D11Device* pDevice,
+                    const void* pShaderBytecode,
+                    SIZE_T BytecodeLength,
+                    ID3D11ClassLinkage* pClassLinkage,
+                    ID3D11PixelShader** ppPixelShader
+                    ) -> HRESULT
+                {
+                    static std::once_flag flag;
+                    std::call_once(flag, []()
+                    {
+                        spdlog::get("indicium")->clone("d3d11")->info("++ ID3D11Device::CreatePixelShader called");
+                    });
+
+                    return engine->Shaders->create(Indicium::Core::Shaders::Stage::Pixel, pShaderBytecode, BytecodeLength,
+                        [&](const void* code, SIZE_T length)
+                    {
+                        return createPixelShader11Hook.call_orig(pDevice, code, length, pClassLinkage, ppPixelShader);
+                    });
+                });
+
+                logger->info("Hooking ID3D11Device::CreateComputeShader");
+
+                createComputeShader11Hook.apply(device[Direct3D11Hooking::CreateComputeShader], [](
+                    ID3D11Device* pDevice,
+                    const void* pShaderBytecode,
+                    SIZE_T BytecodeLength,
+                    ID3D11ClassLinkage* pClassLinkage,
+                    ID3D11ComputeShader** ppComputeShader
+                    ) -> HRESULT
+                {
+                    static std::once_flag flag;
+                    std::call_once(flag, []()
+                    {
+                        spdlog::get("indicium")->clone("d3d11")->info("++ ID3D11Device::CreateComputeShader called");
+                    });
+
+                    return engine->Shaders->create(Indicium::Core::Shaders::Stage::Compute, pShaderBytecode, BytecodeLength,
+                        [&](const void* code, SIZE_T length)
+                    {
+                        return createComputeShader11Hook.call_orig(pDevice, code, length, pClassLinkage, ppComputeShader);
+                    });
+                });
+            }
         }
         catch (DetourException& ex)
         {
@@ -905,12 +1170,25 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                     INVOKE_INDICIUM_GAME_HOOKED(engine, IndiciumDirect3DVersion12);
                 });
 
+                if (engine->Suspended) {
+                    Indicium::Core::Dispatch::OnSuspendedPresent(engine);
+                    return swapChainPresent12Hook.call_orig(chain, SyncInterval, Flags);
+                }
+
+                Indicium::Core::Dispatch::OnPrePresent(engine);
+
                 INVOKE_D3D12_CALLBACK(engine, EvtIndiciumD3D12PrePresent, chain, SyncInterval, Flags);
 
+                Indicium::Core::Dispatch::BeginOriginalPresent(engine, IndiciumDirect3DVersion12, chain);
+
                 const auto ret = swapChainPresent12Hook.call_orig(chain, SyncInterval, Flags);
 
+                Indicium::Core::Dispatch::EndOriginalPresent(engine);
+
                 INVOKE_D3D12_CALLBACK(engine, EvtIndiciumD3D12PostPresent, chain, SyncInterval, Flags);
 
+                Indicium::Core::Dispatch::OnPostPresent(engine, IndiciumDirect3DVersion12, chain, ret);
+
                 return ret;
             });
 
@@ -956,12 +1234,16 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                 INVOKE_D3D12_CALLBACK(engine, EvtIndiciumD3D12PreResizeBuffers, chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags);
 
+                Indicium::Core::Dispatch::OnPreResize(engine, chain);
+
                 const auto ret = swapChainResizeBuffers12Hook.call_orig(chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags);
 
                 INVOKE_D3D12_CALLBACK(engine, EvtIndiciumD3D12PostResizeBuffers, chain,
                     BufferCount, Width, Height, NewFormat, SwapChainFlags);
 
+                Indicium::Core::Dispatch::OnPostResize(engine, IndiciumDirect3DVersion12, ret);
+
                 return ret;
             });
         }
@@ -1019,6 +1301,15 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 
                 const auto ret = arcGetBufferHook.call_orig(client, NumFramesRequested, ppData);
 
+                if (engine->ArcBatcher) {
+                    engine->ArcBatcher->record(client, IndiciumARCEventGetBuffer,
+                        NumFramesRequested, 0, ret);
+                }
+
+                if (engine->AudioMix) {
+                    engine->AudioMix->on_get_buffer(client, ppData, ret);
+                }
+
                 INVOKE_ARC_CALLBACK(engine, EvtIndiciumARCPostGetBuffer, client, 
                     NumFramesRequested, ppData, &post);
 
@@ -1047,13 +1338,123 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
                 INVOKE_ARC_CALLBACK(engine, EvtIndiciumARCPreReleaseBuffer, client, 
                     NumFramesWritten, dwFlags, &pre);
 
+                //
+                // The buffer may get overwritten by the device once released
+                // 
+                if (engine->AudioMix) {
+                    engine->AudioMix->on_release_buffer(client, NumFramesWritten, dwFlags);
+                }
+
                 const auto ret = arcReleaseBufferHook.call_orig(client, NumFramesWritten, dwFlags);
 
+                if (engine->AudioMix) {
+                    engine->AudioMix->on_buffer_released(client, NumFramesWritten, ret);
+                }
+
+                if (engine->ArcBatcher) {
+                    engine->ArcBatcher->record(client, IndiciumARCEventReleaseBuffer,
+                        NumFramesWritten, dwFlags, ret);
+                }
+
+                if (engine->Benchmark) {
+                    engine->Benchmark->on_audio_buffer(NumFramesWritten, dwFlags, ret);
+                }
+
                 INVOKE_ARC_CALLBACK(engine, EvtIndiciumARCPostReleaseBuffer, client, 
                     NumFramesWritten, dwFlags, &post);
 
                 return ret;
             });
+
+            //
+            // Stream formats and render client ownership for the mixdown
+            // 
+            logger->info("Hooking IAudioClient::Initialize");
+
+            audioClientInitializeHook.apply(arc->client_vtable()[CoreAudioHooking::Initialize], [](
+                IAudioClient* client,
+                AUDCLNT_SHAREMODE ShareMode,
+                DWORD StreamFlags,
+                REFERENCE_TIME hnsBufferDuration,
+                REFERENCE_TIME hnsPeriodicity,
+                const WAVEFORMATEX* pFormat,
+                LPCGUID AudioSessionGuid
+                ) -> HRESULT
+            {
+                const auto ret = audioClientInitializeHook.call_orig(client, ShareMode, StreamFlags,
+                    hnsBufferDuration, hnsPeriodicity, pFormat, AudioSessionGuid);
+
+                if (engine->AudioMix) {
+                    engine->AudioMix->on_initialize(client, pFormat, ret);
+                }
+
+                return ret;
+            });
+
+            logger->info("Hooking IAudioClient::GetService");
+
+            audioClientGetServiceHook.apply(arc->client_vtable()[CoreAudioHooking::GetService], [](
+                IAudioClient* client,
+                REFIID riid,
+                void** ppv
+                ) -> HRESULT
+            {
+                const auto ret = audioClientGetServiceHook.call_orig(client, riid, ppv);
+
+                if (engine->AudioMix) {
+                    engine->AudioMix->on_get_service(client, riid, ppv, ret);
+                }
+
+                return ret;
+            });
+
+            //
+            // The mixer and the batcher keep state per client, which may only go away with the
+            // client itself; the batcher can still get created later on. The state goes before
+            // the last reference, once that's gone the address may belong to a new client already.
+            // Our own AddRef tells whether the caller holds the last one, which no other thread
+            // can duplicate then.
+            // 
+            {
+                const auto renderRelease = arc->vtable()[CoreAudioHooking::Release];
+                const auto clientRelease = arc->client_vtable()[CoreAudioHooking::ClientRelease];
+
+                logger->info("Hooking IAudioRenderClient::Release");
+
+                arcReleaseHook.apply(renderRelease, [](IUnknown* object) -> ULONG
+                {
+                    const auto last = object->AddRef() == 2;
+
+                    arcReleaseHook.call_orig(object);
+
+                    if (last) {
+                        Indicium::Core::Dispatch::OnAudioObjectReleased(engine, object);
+                    }
+
+                    return arcReleaseHook.call_orig(object);
+                });
+
+                //
+                // Both interfaces may share one implementation, which the hook above covers
+                // 
+                if (clientRelease != renderRelease)
+                {
+                    logger->info("Hooking IAudioClient::Release");
+
+                    audioClientReleaseHook.apply(clientRelease, [](IUnknown* object) -> ULONG
+                    {
+                        const auto last = object->AddRef() == 2;
+
+                        audioClientReleaseHook.call_orig(object);
+
+                        if (last) {
+                            Indicium::Core::Dispatch::OnAudioObjectReleased(engine, object);
+                        }
+
+                        return audioClientReleaseHook.call_orig(object);
+                    });
+                }
+            }
         }
         catch (DetourException& ex)
         {
@@ -1074,6 +1475,177 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 
 #pragma endregion
 
+#pragma region Raw Input
+
+    if (config.Input.HookRawInput)
+    {
+        try
+        {
+            //
+            // WM_INPUT carries only a handle, the input itself gets read through this call
+            // 
+            logger->info("Hooking GetRawInputData");
+
+            getRawInputDataHook.apply((size_t)GetRawInputData, [](
+                HRAWINPUT hRawInput,
+                UINT uiCommand,
+                LPVOID pData,
+                PUINT pcbSize,
+                UINT cbSizeHeader
+                ) -> UINT
+            {
+                static std::once_flag flag;
+                std::call_once(flag, []()
+                {
+                    spdlog::get("indicium")->clone("input")->info("++ GetRawInputData called");
+                });
+
+                const auto ret = getRawInputDataHook.call_orig(hRawInput, uiCommand, pData, pcbSize, cbSizeHeader);
+
+                if (engine->RawInput) {
+                    engine->RawInput->on_get_data(uiCommand, pData, ret);
+                }
+
+                return ret;
+            });
+
+            logger->info("Hooking GetRawInputBuffer");
+
+            getRawInputBufferHook.apply((size_t)GetRawInputBuffer, [](
+                PRAWINPUT pData,
+                PUINT pcbSize,
+                UINT cbSizeHeader
+                ) -> UINT
+            {
+                static std::once_flag flag;
+                std::call_once(flag, []()
+                {
+                    spdlog::get("indicium")->clone("input")->info("++ GetRawInputBuffer called");
+                });
+
+                const auto ret = getRawInputBufferHook.call_orig(pData, pcbSize, cbSizeHeader);
+
+                if (engine->RawInput) {
+                    engine->RawInput->on_get_buffer(pData, ret);
+                }
+
+                return ret;
+            });
+        }
+        catch (DetourException& ex)
+        {
+            logger->error("Hooking Raw Input failed: {}", ex.what());
+        }
+    }
+
+#pragma endregion
+
+#pragma region XInput
+
+    //
+    // Hooks the XInput version the host loaded, newest first. Hosts may load XInput only once
+    // they look for controllers, so the engine tick retries until a module shows up.
+    // 
+    const auto hookXInput = [&logger]() -> bool
+    {
+        static const LPCSTR xinputModules[] = {
+            "xinput1_4.dll", "xinput1_3.dll", "xinput9_1_0.dll", "xinput1_2.dll", "xinput1_1.dll"
+        };
+
+        HMODULE xinput = nullptr;
+        LPCSTR xinputName = nullptr;
+
+        for (const auto name : xinputModules)
+        {
+            xinput = GetModuleHandleA(name);
+
+            if (xinput)
+            {
+                xinputName = name;
+                break;
+            }
+        }
+
+        const auto getState = xinput ? GetProcAddress(xinput, "XInputGetState") : nullptr;
+        const auto setState = xinput ? GetProcAddress(xinput, "XInputSetState") : nullptr;
+
+        if (!getState || !setState)
+        {
+            return false;
+        }
+
+        try
+        {
+            logger->info("Hooking XInputGetState of {}", xinputName);
+
+            xinputGetStateHook.apply((size_t)getState, [](
+                DWORD dwUserIndex,
+                XINPUT_STATE* pState
+                ) -> DWORD
+            {
+                static std::once_flag flag;
+                std::call_once(flag, []()
+                {
+                    spdlog::get("indicium")->clone("xinput")->info("++ XInputGetState called");
+                });
+
+                auto ret = xinputGetStateHook.call_orig(dwUserIndex, pState);
+
+                //
+                // Replayed controllers replace the real ones, subscribers see what the host sees
+                // 
+                if (engine->InputReplay) {
+                    ret = engine->InputReplay->override_xinput(dwUserIndex, pState, ret);
+                }
+
+                if (engine->XInput) {
+                    engine->XInput->on_get_state(dwUserIndex, pState, ret);
+                }
+
+                return ret;
+            });
+
+            logger->info("Hooking XInputSetState of {}", xinputName);
+
+            xinputSetStateHook.apply((size_t)setState, [](
+                DWORD dwUserIndex,
+                XINPUT_VIBRATION* pVibration
+                ) -> DWORD
+            {
+                const auto ret = xinputSetStateHook.call_orig(dwUserIndex, pVibration);
+
+                if (engine->XInput) {
+                    engine->XInput->on_set_state(dwUserIndex, pVibration, ret);
+                }
+
+                return ret;
+            });
+        }
+        catch (DetourException& ex)
+        {
+            logger->error("Hooking XInput failed: {}", ex.what());
+        }
+
+        return true;
+    };
+
+    //
+    // Done once hooked, failed or not wanted
+    // 
+    bool xinputSettled = !config.Input.HookXInput;
+
+    if (!xinputSettled)
+    {
+        xinputSettled = hookXInput();
+
+        if (!xinputSettled)
+        {
+            logger->info("No XInput module loaded by host yet, hooking it once it gets loaded");
+        }
+    }
+
+#pragma endregion
+
 #ifdef HOOK_DINPUT8
     //
     // TODO: legacy, fix me up!
@@ -1104,10 +1676,29 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
 
     logger->info("Library initialized successfully");
 
+    InterlockedExchange(&engine->EngineHooked, TRUE);
+    SetEvent(engine->EngineReadyEvent);
+
     //
-    // Wait until cancellation requested
+    // Wait until cancellation requested, servicing periodic and requested engine work in between
     // 
-    const auto result = WaitForSingleObject(engine->EngineCancellationEvent, INFINITE);
+    const HANDLE waitEvents[] = { engine->EngineCancellationEvent, engine->EngineWakeEvent };
+
+    DWORD result;
+    while ((result = WaitForMultipleObjects(
+        ARRAYSIZE(waitEvents),
+        waitEvents,
+        FALSE,
+        Indicium::Core::Dispatch::EngineTickInterval(engine)
+    )) == WAIT_TIMEOUT || result == WAIT_OBJECT_0 + 1)
+    {
+        if (!xinputSettled)
+        {
+            xinputSettled = hookXInput();
+        }
+
+        Indicium::Core::Dispatch::OnEngineTick(engine);
+    }
     logger->info("Shutting down hooks... (result: {}, error: {})", result, GetLastError());
     switch (result)
     {
@@ -1127,6 +1718,11 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
         logger->info("Shutting down hooks... Unexpected return value, terminating");
         break;
     }
+    //
+    // Waiters arriving from now on must not expect hooks
+    // 
+    InterlockedExchange(&engine->EngineHooked, FALSE);
+
     //
     // Notify host that we are about to release all render pipeline hooks
     // 
@@ -1135,45 +1731,7 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
         engine->EngineConfig.EvtIndiciumGamePreUnhook(engine);
     }
 
-    try
-    {
-#ifndef INDICIUM_NO_D3D9
-        present9Hook.remove();
-        reset9Hook.remove();
-        endScene9Hook.remove();
-        present9ExHook.remove();
-        reset9ExHook.remove();
-#endif
-
-#ifndef INDICIUM_NO_D3D10
-        swapChainPresent10Hook.remove();
-        swapChainResizeTarget10Hook.remove();
-        swapChainResizeBuffers10Hook.remove();
-#endif
-
-#ifndef INDICIUM_NO_D3D11
-        swapChainPresent11Hook.remove();
-        swapChainResizeTarget11Hook.remove();
-        swapChainResizeBuffers11Hook.remove();
-#endif
-
-#ifndef INDICIUM_NO_D3D12
-        swapChainPresent12Hook.remove();
-        swapChainResizeTarget12Hook.remove();
-        swapChainResizeBuffers12Hook.remove();
-#endif
-
-#ifndef INDICIUM_NO_COREAUDIO
-        arcGetBufferHook.remove();
-        arcReleaseBufferHook.remove();
-#endif
-
-        logger->info("Hooks disabled");
-    }
-    catch (DetourException& pex)
-    {
-        logger->error("Unhooking failed: {}", pex.what());
-    }
+    IndiciumMainThreadUnhook();
 
     //
     // Notify host that we released all render pipeline hooks
@@ -1183,6 +1741,8 @@ DWORD WINAPI IndiciumMainThread(LPVOID Params)
         engine->EngineConfig.EvtIndiciumGamePostUnhook(engine);
     }
 
+    Indicium::Core::Dispatch::OnEngineStop(engine);
+
     logger->info("Exiting worker thread");
 
     //
@@ -25,3 +25,8 @@ SOFTWARE.
 #pragma once
 
 DWORD WINAPI IndiciumMainThread(LPVOID Params);
+
+//
+// Removes every hook of the engine thread, does nothing for hooks already removed
+//
+void IndiciumMainThreadUnhook();
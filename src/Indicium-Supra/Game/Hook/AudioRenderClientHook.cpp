@@ -129,3 +129,8 @@ std::vector<size_t> CoreAudioHooking::AudioRenderClientHook::vtable() const
 {
 	return std::vector<size_t>(*reinterpret_cast<size_t**>(arc), *reinterpret_cast<size_t**>(arc) + VTableElements);
 }
+
+std::vector<size_t> CoreAudioHooking::AudioRenderClientHook::client_vtable() const
+{
+	return std::vector<size_t>(*reinterpret_cast<size_t**>(client), *reinterpret_cast<size_t**>(client) + ClientVTableElements);
+}
@@ -43,6 +43,28 @@ namespace CoreAudioHooking
         ReleaseBuffer = 4
     };
 
+    enum AudioClientVTbl : short
+    {
+        // IUnknown
+        ClientQueryInterface = 0,
+        ClientAddRef = 1,
+        ClientRelease = 2,
+
+        // IAudioClient
+        Initialize = 3,
+        GetBufferSize = 4,
+        GetStreamLatency = 5,
+        GetCurrentPadding = 6,
+        IsFormatSupported = 7,
+        GetMixFormat = 8,
+        GetDevicePeriod = 9,
+        Start = 10,
+        Stop = 11,
+        Reset = 12,
+        SetEventHandle = 13,
+        GetService = 14
+    };
+
     class AudioRenderClientHook
     {
         IMMDeviceEnumerator *enumerator{};
@@ -56,7 +78,9 @@ namespace CoreAudioHooking
         ~AudioRenderClientHook();
 
         static const int VTableElements = 5;
+        static const int ClientVTableElements = 15;
 
         std::vector<size_t> vtable() const;
+        std::vector<size_t> client_vtable() const;
     };
 };
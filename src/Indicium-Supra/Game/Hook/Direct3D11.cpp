@@ -119,6 +119,12 @@ std::vector<size_t> Direct3D11Hooking::Direct3D11::vtable() const
 	                           *reinterpret_cast<size_t**>(pSwapChain) + DXGIHooking::DXGI::SwapChainVTableElements);
 }
 
+std::vector<size_t> Direct3D11Hooking::Direct3D11::device_vtable() const
+{
+	return std::vector<size_t>(*reinterpret_cast<size_t**>(pd3dDevice),
+	                           *reinterpret_cast<size_t**>(pd3dDevice) + VTableElements);
+}
+
 Direct3D11Hooking::Direct3D11::~Direct3D11()
 {
 	if (pSwapChain)
@@ -93,5 +93,6 @@ namespace Direct3D11Hooking
         static const int VTableElements = 43;
 
         std::vector<size_t> vtable() const override;
+        std::vector<size_t> device_vtable() const;
     };
 }
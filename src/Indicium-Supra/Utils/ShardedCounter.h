@@ -0,0 +1,106 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Util
+        {
+            /**
+             * \brief   Monotonic event counter split into cache-line sized shards. Every thread
+             *          increments the shard it got assigned on first use, so threads bumping the
+             *          same counter (publishers, audio and worker threads) never bounce a shared
+             *          cache line; readers sum all shards.
+             *
+             *          Threads are assigned round-robin, the first Shards threads touching any
+             *          counter each get a private shard, later ones share. Shards are still
+             *          updated atomically, so sharing only costs speed, never counts.
+             */
+            class ShardedCounter
+            {
+            public:
+                static constexpr size_t Shards = 16;
+
+            private:
+                static constexpr size_t cache_line = 64;
+
+                struct alignas(cache_line) Shard
+                {
+                    std::atomic<uint64_t> value{ 0 };
+                };
+
+                Shard shards_[Shards];
+
+                static size_t shard_index()
+                {
+                    static std::atomic<size_t> next{ 0 };
+                    thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed) % Shards;
+
+                    return index;
+                }
+
+            public:
+                ShardedCounter() = default;
+
+                ShardedCounter(const ShardedCounter&) = delete;
+                ShardedCounter& operator=(const ShardedCounter&) = delete;
+
+                void add(uint64_t value = 1)
+                {
+                    shards_[shard_index()].value.fetch_add(value, std::memory_order_relaxed);
+                }
+
+                /**
+                 * \brief   Sum of all shards. Not a snapshot across shards; concurrent increments
+                 *          may or may not be included.
+                 */
+                uint64_t load() const
+                {
+                    uint64_t sum = 0;
+
+                    for (const auto& shard : shards_)
+                        sum += shard.value.load(std::memory_order_relaxed);
+
+                    return sum;
+                }
+
+                /**
+                 * \brief   Zeroes all shards; increments racing with the reset may get lost.
+                 */
+                void reset()
+                {
+                    for (auto& shard : shards_)
+                        shard.value.store(0, std::memory_order_relaxed);
+                }
+            };
+        };
+    };
+};
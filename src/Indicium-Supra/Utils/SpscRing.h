@@ -0,0 +1,131 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <type_traits>
+
+namespace Indicium
+{
+    namespace Core
+    {
+        namespace Util
+        {
+            /**
+             * \brief   Bounded, wait-free single-producer/single-consumer ring buffer. Exactly one
+             *          thread may push and exactly one (other) thread may pop at any given time.
+             *          Capacity gets rounded up to the next power of two.
+             */
+            template <typename T>
+            class SpscRing
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "SpscRing requires trivially copyable elements");
+
+                static constexpr size_t cache_line = 64;
+
+                std::unique_ptr<T[]> slots_;
+                size_t mask_;
+
+                alignas(cache_line) std::atomic<size_t> head_;   // written by consumer
+                alignas(cache_line) std::atomic<size_t> tail_;   // written by producer
+
+                static size_t round_up(size_t value)
+                {
+                    size_t result = 2;
+                    while (result < value)
+                        result <<= 1;
+                    return result;
+                }
+
+            public:
+                explicit SpscRing(size_t capacity) :
+                    slots_(new T[round_up(capacity)]), mask_(round_up(capacity) - 1), head_(0), tail_(0)
+                { }
+
+                SpscRing(const SpscRing&) = delete;
+                SpscRing& operator=(const SpscRing&) = delete;
+
+                size_t capacity() const
+                {
+                    return mask_ + 1;
+                }
+
+                bool try_push(const T& item)
+                {
+                    const auto tail = tail_.load(std::memory_order_relaxed);
+
+                    if (tail - head_.load(std::memory_order_acquire) > mask_)
+                        return false;
+
+                    slots_[tail & mask_] = item;
+                    tail_.store(tail + 1, std::memory_order_release);
+
+                    return true;
+                }
+
+                bool try_pop(T& item)
+                {
+                    const auto head = head_.load(std::memory_order_relaxed);
+
+                    if (head == tail_.load(std::memory_order_acquire))
+                        return false;
+
+                    item = slots_[head & mask_];
+                    head_.store(head + 1, std::memory_order_release);
+
+                    return true;
+                }
+
+                /**
+                 * \brief   Pops up to max elements into out, returns the number of elements copied.
+                 */
+                size_t pop_bulk(T* out, size_t max)
+                {
+                    const auto head = head_.load(std::memory_order_relaxed);
+                    const auto tail = tail_.load(std::memory_order_acquire);
+                    auto count = tail - head;
+
+                    if (count > max)
+                        count = max;
+
+                    for (size_t i = 0; i < count; i++)
+                        out[i] = slots_[(head + i) & mask_];
+
+                    head_.store(head + count, std::memory_order_release);
+
+                    return count;
+                }
+
+                size_t size_approx() const
+                {
+                    return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed);
+                }
+            };
+        };
+    };
+};
@@ -0,0 +1,217 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// CPU cost of one Opus stream of the audio encoder, with libopus and the encoder thread of
+// the engine, plus checks of its packet numbering and of mixdown rate changes:
+//
+//     AudioEncoderBenchmark [seconds]
+//
+// Mixed blocks of one packet each get fed in lockstep with the reader, so nothing is dropped
+// and the load reported is that of encoding alone.
+// 
+
+#include "AudioEncoder.h"
+#include "AudioMixer.h"
+#include "Counters.h"
+
+#include "Check.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+using Indicium::Core::Audio::AudioEncoder;
+using Indicium::Core::Audio::AudioMixer;
+using Indicium::Core::Stats::CounterRegistry;
+
+namespace
+{
+	//
+	// Chords with vibrato and a bit of noise, so the encoder has to work like on game audio
+	//
+	std::vector<float> Generate(UINT32 rate, UINT32 frames)
+	{
+		static const double Pi = 3.14159265358979323846;
+		static const double Notes[] = { 220.0, 277.18, 329.63, 440.0, 554.37 };
+
+		std::vector<float> samples(size_t(frames) * 2);
+		std::mt19937 random(7);
+		std::uniform_real_distribution<float> noise(-0.02f, 0.02f);
+
+		for (UINT32 i = 0; i < frames; i++)
+		{
+			const auto t = double(i) / rate;
+			const auto vibrato = 1.0 + 0.003 * sin(2 * Pi * 5 * t);
+			double left = 0, right = 0;
+
+			for (size_t n = 0; n < ARRAYSIZE(Notes); n++)
+			{
+				const auto phase = 2 * Pi * Notes[n] * vibrato * t;
+				const auto envelope = 0.5 + 0.5 * sin(2 * Pi * (0.25 + 0.1 * n) * t);
+
+				left += 0.12 * envelope * sin(phase);
+				right += 0.12 * envelope * sin(phase + 0.3 * n);
+			}
+
+			samples[i * 2] = float(left) + noise(random);
+			samples[i * 2 + 1] = float(right) + noise(random);
+		}
+
+		return samples;
+	}
+
+	INDICIUM_AUDIO_MIX_BLOCK Block(const std::vector<float>& samples, UINT32 rate, ULONGLONG first, UINT32 frames)
+	{
+		INDICIUM_AUDIO_MIX_BLOCK block;
+		ZeroMemory(&block, sizeof(block));
+
+		block.Samples = samples.data() + (first * 2) % (samples.size() - frames * 2);
+		block.Frames = frames;
+		block.SampleRate = rate;
+		block.FirstFrame = first;
+		block.Timestamp = LONGLONG(double(first) * 1e9 / rate);
+
+		return block;
+	}
+
+	void Measure(const char* name, const INDICIUM_AUDIO_ENCODER_CONFIG& config, double seconds)
+	{
+		const UINT32 rate = 48000;
+		const auto samples = Generate(rate, rate * 2);
+		const auto frames = rate * config.FrameMs / 1000;
+		const auto packets = ULONGLONG(seconds * 1000 / config.FrameMs);
+
+		CounterRegistry counters;
+		AudioMixer mixer(counters);
+		AudioEncoder encoder(counters);
+
+		CHECK(encoder.start(mixer, config) == INDICIUM_ERROR_NONE);
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (ULONGLONG i = 0; i < packets; i++)
+		{
+			encoder.on_mix(Block(samples, rate, i * frames, frames));
+
+			INDICIUM_AUDIO_PACKET packet;
+			CHECK(encoder.read(&packet, 5000));
+			CHECK(packet.Sequence == i);
+			CHECK(packet.FirstFrame == i * frames && packet.Frames == frames);
+			CHECK(packet.Size > 0);
+		}
+
+		const auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		INDICIUM_AUDIO_ENCODER_STATISTICS statistics;
+		encoder.statistics(&statistics);
+		encoder.stop(mixer);
+
+		CHECK(statistics.Packets == packets);
+		CHECK(statistics.DroppedFrames == 0 && statistics.DroppedPackets == 0);
+		CHECK(statistics.LookaheadFrames > 0);
+		CHECK(statistics.EncodeLoad > 0);
+
+		printf("%-34s %6.2f %% of a core per stream (%5.0f streams per core), %4.0f kbit/s, %6.1f us per packet wall\n",
+			name, 100 * statistics.EncodeLoad, 1 / statistics.EncodeLoad,
+			statistics.Bytes * 8 / seconds / 1000, wall * 1e6 / packets);
+	}
+
+	//
+	// A mixdown restarted at 44.1 kHz gets dropped and counted, the following 48 kHz audio
+	// starts over with a discontinuity
+	//
+	void CheckRateChange()
+	{
+		INDICIUM_AUDIO_ENCODER_CONFIG config;
+		INDICIUM_AUDIO_ENCODER_CONFIG_INIT(&config);
+
+		const auto samples = Generate(48000, 48000);
+
+		CounterRegistry counters;
+		AudioMixer mixer(counters);
+		AudioEncoder encoder(counters);
+
+		CHECK(encoder.start(mixer, config) == INDICIUM_ERROR_NONE);
+
+		INDICIUM_AUDIO_PACKET packet;
+
+		encoder.on_mix(Block(samples, 48000, 0, 480));
+		CHECK(encoder.read(&packet, 5000));
+		CHECK(packet.Flags & INDICIUM_AUDIO_PACKET_FLAG_DISCONTINUITY);
+
+		//
+		// Half a packet pending when the rate changes
+		//
+		encoder.on_mix(Block(samples, 48000, 480, 240));
+
+		for (ULONGLONG first = 0; first < 4410; first += 441)
+			encoder.on_mix(Block(samples, 44100, first, 441));
+
+		CHECK(!encoder.read(&packet, 100));
+
+		encoder.on_mix(Block(samples, 48000, 0, 480));
+		CHECK(encoder.read(&packet, 5000));
+		CHECK(packet.Flags & INDICIUM_AUDIO_PACKET_FLAG_DISCONTINUITY);
+		CHECK(packet.FirstFrame == 0 && packet.Sequence == 1);
+
+		INDICIUM_AUDIO_ENCODER_STATISTICS statistics;
+		encoder.statistics(&statistics);
+		encoder.stop(mixer);
+
+		CHECK(statistics.DroppedFrames == 240 + 4410);
+		CHECK(statistics.Discontinuities == 2);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const auto seconds = argc > 1 ? atof(argv[1]) : 10.0;
+
+	CheckRateChange();
+
+	INDICIUM_AUDIO_ENCODER_CONFIG config;
+
+	INDICIUM_AUDIO_ENCODER_CONFIG_INIT(&config);
+	Measure("default (10 ms, low delay, c5)", config, seconds);
+
+	config.Complexity = 0;
+	Measure("10 ms, low delay, c0", config, seconds);
+
+	config.Complexity = 10;
+	Measure("10 ms, low delay, c10", config, seconds);
+
+	INDICIUM_AUDIO_ENCODER_CONFIG_INIT(&config);
+	config.FrameMs = 20;
+	config.LowDelay = FALSE;
+	Measure("20 ms, audio, c5", config, seconds);
+
+	config.Bitrate = 64000;
+	Measure("20 ms, audio, c5, 64 kbit/s", config, seconds);
+
+	return 0;
+}
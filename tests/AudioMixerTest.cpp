@@ -0,0 +1,248 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Render client slots of the audio mixer over the life of their clients: slots are given back
+// by the final Release, the way the Release hooks hand it over, and get reused for new render
+// clients, also at the address of a released one while an audio thread keeps writing.
+//
+//     AudioMixerTest [cycles]
+//
+
+#include <Windows.h>
+#include <Audioclient.h>
+
+#include "AudioMixer.h"
+#include "Counters.h"
+
+#include "Check.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <thread>
+#include <vector>
+
+using Indicium::Core::Audio::AudioMixer;
+using Indicium::Core::Stats::CounterRegistry;
+
+namespace
+{
+	struct FakeAudioClient : IAudioClient
+	{
+		ULONG references = 1;
+
+		HRESULT QueryInterface(REFIID, void**) override { return E_FAIL; }
+		ULONG AddRef() override { return ++references; }
+		ULONG Release() override { return --references; }
+
+		HRESULT GetCurrentPadding(UINT32* padding) override
+		{
+			*padding = 0;
+			return S_OK;
+		}
+	};
+
+	struct FakeRenderClient : IAudioRenderClient
+	{
+		ULONG references = 1;
+
+		HRESULT QueryInterface(REFIID, void**) override { return E_FAIL; }
+		ULONG AddRef() override { return ++references; }
+		ULONG Release() override { return --references; }
+
+		HRESULT GetBuffer(UINT32, BYTE**) override { return E_FAIL; }
+		HRESULT ReleaseBuffer(UINT32, DWORD) override { return E_FAIL; }
+	};
+
+	//
+	// What the Release hooks do: the mixer hears of the final Release while the object lives
+	//
+	ULONG HookedRelease(AudioMixer& mixer, IUnknown* object)
+	{
+		const auto last = object->AddRef() == 2;
+
+		object->Release();
+
+		if (last)
+			mixer.on_released(object);
+
+		return object->Release();
+	}
+
+	void Initialize(AudioMixer& mixer, FakeAudioClient& client)
+	{
+		WAVEFORMATEX format;
+		ZeroMemory(&format, sizeof(format));
+
+		format.wFormatTag = WAVE_FORMAT_PCM;
+		format.nChannels = 2;
+		format.nSamplesPerSec = 48000;
+		format.wBitsPerSample = 16;
+		format.nBlockAlign = 4;
+		format.nAvgBytesPerSec = 48000 * 4;
+
+		mixer.on_initialize(&client, &format, S_OK);
+	}
+
+	void GetService(AudioMixer& mixer, FakeAudioClient& client, IAudioRenderClient* render)
+	{
+		void* service = render;
+		mixer.on_get_service(&client, __uuidof(IAudioRenderClient), &service, S_OK);
+	}
+
+	UINT32 Clients(AudioMixer& mixer)
+	{
+		INDICIUM_AUDIO_MIX_STATISTICS statistics;
+		mixer.statistics(&statistics);
+
+		return statistics.Clients;
+	}
+
+	//
+	// A client beyond the slots isn't mixed until one gets released, a released audio client
+	// takes its format along
+	//
+	void CheckSlotReuse()
+	{
+		CounterRegistry counters;
+		AudioMixer mixer(counters);
+
+		FakeAudioClient clients[AudioMixer::MaxClients + 1];
+		FakeRenderClient renders[AudioMixer::MaxClients + 2];
+
+		for (size_t i = 0; i < AudioMixer::MaxClients; i++)
+		{
+			Initialize(mixer, clients[i]);
+			GetService(mixer, clients[i], &renders[i]);
+		}
+
+		CHECK(Clients(mixer) == AudioMixer::MaxClients);
+
+		auto& extra = clients[AudioMixer::MaxClients];
+
+		Initialize(mixer, extra);
+		GetService(mixer, extra, &renders[AudioMixer::MaxClients]);
+		CHECK(Clients(mixer) == AudioMixer::MaxClients);
+
+		//
+		// Releases short of the last one keep the slot
+		//
+		renders[3].AddRef();
+		CHECK(HookedRelease(mixer, &renders[3]) == 1);
+		CHECK(Clients(mixer) == AudioMixer::MaxClients);
+
+		CHECK(HookedRelease(mixer, &renders[3]) == 0);
+		CHECK(Clients(mixer) == AudioMixer::MaxClients - 1);
+
+		GetService(mixer, extra, &renders[AudioMixer::MaxClients]);
+		CHECK(Clients(mixer) == AudioMixer::MaxClients);
+
+		//
+		// The render client goes first, its audio client follows and is forgotten
+		//
+		CHECK(HookedRelease(mixer, &renders[5]) == 0);
+		CHECK(HookedRelease(mixer, &clients[5]) == 0);
+		CHECK(Clients(mixer) == AudioMixer::MaxClients - 1);
+
+		GetService(mixer, clients[5], &renders[AudioMixer::MaxClients + 1]);
+		CHECK(Clients(mixer) == AudioMixer::MaxClients - 1);
+	}
+
+	//
+	// Render clients released and created again at the same address, for alternating audio
+	// clients, while an audio thread keeps writing through that address and the engine thread
+	// mixes; meant to be run under a sanitizer as well, with fewer cycles for the slower ones
+	//
+	void CheckRecycling(int cycles)
+	{
+		const UINT32 Frames = 480;
+
+		CounterRegistry counters;
+		AudioMixer mixer(counters);
+
+		INDICIUM_AUDIO_MIX_CONFIG config;
+		INDICIUM_AUDIO_MIX_CONFIG_INIT(&config, nullptr);
+		CHECK(mixer.start(config) == INDICIUM_ERROR_NONE);
+
+		FakeAudioClient clients[2];
+		Initialize(mixer, clients[0]);
+		Initialize(mixer, clients[1]);
+
+		alignas(FakeRenderClient) unsigned char storage[sizeof(FakeRenderClient)];
+		const auto address = reinterpret_cast<IAudioRenderClient*>(storage);
+
+		auto render = new (storage) FakeRenderClient();
+		GetService(mixer, clients[0], render);
+
+		std::atomic<bool> stopping{ false };
+
+		std::thread audio([&]
+		{
+			std::vector<INT16> pcm(Frames * 2, 1000);
+
+			while (!stopping.load())
+			{
+				auto data = reinterpret_cast<BYTE*>(pcm.data());
+
+				mixer.on_get_buffer(address, &data, S_OK);
+				mixer.on_release_buffer(address, Frames, 0);
+				mixer.on_buffer_released(address, Frames, S_OK);
+			}
+		});
+
+		for (int i = 0; i < cycles; i++)
+		{
+			CHECK(HookedRelease(mixer, render) == 0);
+			render->~FakeRenderClient();
+
+			render = new (storage) FakeRenderClient();
+			GetService(mixer, clients[(i + 1) % 2], render);
+
+			if (i % 100 == 0)
+				mixer.tick(nullptr);
+		}
+
+		stopping = true;
+		audio.join();
+
+		CHECK(Clients(mixer) == 1);
+
+		mixer.stop();
+		render->~FakeRenderClient();
+	}
+}
+
+int main(int argc, char** argv)
+{
+	CheckSlotReuse();
+	CheckRecycling(argc > 1 ? atoi(argv[1]) : 20000);
+
+	printf("audio mixer client slots: ok\n");
+
+	return 0;
+}
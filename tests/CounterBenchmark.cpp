@@ -0,0 +1,202 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Increments of one counter from many writer threads at once, sharded against a single shared
+// atomic, plus checks that no increment gets lost and that readers of the counter registry
+// never see a counter go backwards:
+//
+//     CounterBenchmark [threads [increments per thread]]
+//
+// Defaults to twice the shard count of threads; gains need as many cores as possible.
+// 
+
+#include "Counters.h"
+
+#include "Check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+using Indicium::Core::Stats::CounterRegistry;
+using Indicium::Core::Util::ShardedCounter;
+
+namespace
+{
+	//
+	// Runs body(thread index) on every thread at once and returns the wall time in seconds
+	//
+	template <typename Body>
+	double Run(size_t threads, Body body)
+	{
+		std::atomic<size_t> ready{ 0 };
+		std::atomic<bool> go{ false };
+		std::vector<std::thread> writers;
+
+		for (size_t i = 0; i < threads; i++)
+		{
+			writers.emplace_back([&, i]()
+			{
+				ready.fetch_add(1);
+
+				while (!go.load())
+					std::this_thread::yield();
+
+				body(i);
+			});
+		}
+
+		while (ready.load() != threads)
+			std::this_thread::yield();
+
+		const auto begin = std::chrono::steady_clock::now();
+		go.store(true);
+
+		for (auto& writer : writers)
+			writer.join();
+
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+
+	void Report(const char* name, size_t threads, size_t increments, double seconds)
+	{
+		const auto total = double(threads) * double(increments);
+
+		printf("%-16s %3zu threads: %8.1f M increments/s, %6.2f ns per increment and thread\n",
+			name, threads, total / seconds / 1e6, seconds * 1e9 / double(increments));
+	}
+
+	//
+	// Writers on a registered counter while a reader keeps taking snapshots
+	//
+	void CheckRegistry(size_t threads, size_t increments)
+	{
+		CounterRegistry registry;
+		ShardedCounter attached;
+		_INDICIUM_COUNTER* created = nullptr;
+
+		CHECK(registry.attach("bench.attached", attached) == INDICIUM_ERROR_NONE);
+		CHECK(registry.create("bench.created", &created) == INDICIUM_ERROR_NONE);
+		CHECK(registry.attach("bench.created", attached) == INDICIUM_ERROR_INVALID_PARAMETER);
+
+		std::atomic<bool> done{ false };
+		size_t snapshots = 0;
+
+		std::thread reader([&]()
+		{
+			INDICIUM_COUNTER_VALUE values[2];
+			ULONGLONG previous[2] = { 0, 0 };
+
+			while (!done.load())
+			{
+				CHECK(registry.snapshot(values, 2) == 2);
+
+				for (size_t i = 0; i < 2; i++)
+				{
+					CHECK(values[i].Value >= previous[i]);
+					previous[i] = values[i].Value;
+				}
+
+				snapshots++;
+			}
+		});
+
+		Run(threads, [&](size_t index)
+		{
+			for (size_t i = 0; i < increments; i++)
+			{
+				attached.add();
+				created->add(index + 1);
+			}
+		});
+
+		done.store(true);
+		reader.join();
+
+		INDICIUM_COUNTER_VALUE values[2];
+
+		CHECK(registry.snapshot(values, 2) == 2);
+		CHECK(!strcmp(values[0].Name, "bench.attached") && !strcmp(values[1].Name, "bench.created"));
+		CHECK(values[0].Value == threads * increments);
+		CHECK(values[1].Value == threads * (threads + 1) / 2 * increments);
+
+		printf("Registry: %zu snapshots taken while writing, none went backwards\n", snapshots);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const auto threads = argc > 1 ? size_t(strtoul(argv[1], nullptr, 10)) : ShardedCounter::Shards * 2;
+	const auto increments = argc > 2 ? size_t(strtoul(argv[2], nullptr, 10)) : size_t(1000000);
+
+	CHECK(threads > 0 && increments > 0);
+
+	printf("%u hardware threads\n", std::thread::hardware_concurrency());
+
+	std::vector<size_t> counts;
+
+	for (size_t count = 1; count < threads; count *= 2)
+		counts.push_back(count);
+
+	counts.push_back(threads);
+
+	for (const auto count : counts)
+	{
+		std::atomic<uint64_t> shared{ 0 };
+
+		const auto shared_seconds = Run(count, [&](size_t)
+		{
+			for (size_t i = 0; i < increments; i++)
+				shared.fetch_add(1, std::memory_order_relaxed);
+		});
+
+		CHECK(shared.load() == count * increments);
+
+		ShardedCounter sharded;
+
+		const auto sharded_seconds = Run(count, [&](size_t)
+		{
+			for (size_t i = 0; i < increments; i++)
+				sharded.add();
+		});
+
+		CHECK(sharded.load() == count * increments);
+
+		Report("Shared atomic", count, increments, shared_seconds);
+		Report("ShardedCounter", count, increments, sharded_seconds);
+
+		sharded.reset();
+		CHECK(sharded.load() == 0);
+	}
+
+	CheckRegistry(threads, increments / 10);
+
+	return 0;
+}
@@ -0,0 +1,245 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "InputTimeline.h"
+
+#include "Check.h"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <utility>
+#include <vector>
+
+using namespace Indicium::Core::Input;
+
+namespace
+{
+	struct Payload
+	{
+		uint32_t id;
+		int32_t value;
+	};
+
+	struct Recording
+	{
+		InputTimeline<Payload> timeline;
+		std::vector<int64_t> starts;
+		std::vector<int64_t> timestamps;
+	};
+
+	//
+	// 300 frames of 14 to 20 ms with 1 kHz input, delivered in batches at the Presents; every
+	// fifth batch is held back until after the next Present, like a late WM_INPUT drain
+	//
+	Recording Record(std::mt19937& rng)
+	{
+		std::uniform_int_distribution<int64_t> frame_length(14000, 20000);
+
+		Recording recording;
+		TimelineRecorder<Payload> recorder;
+
+		int64_t now = 1000000;
+		int64_t next_event = now + 500;
+		std::vector<std::pair<int64_t, Payload>> held;
+
+		recorder.begin(now);
+		recording.starts.push_back(now);
+
+		for (int f = 0; f < 300; f++)
+		{
+			const auto end = now + frame_length(rng);
+			std::vector<std::pair<int64_t, Payload>> batch;
+
+			for (; next_event < end; next_event += 1000)
+			{
+				const auto id = uint32_t(recording.timestamps.size());
+
+				batch.push_back({ next_event, Payload{ id, int32_t(id) * 3 } });
+				recording.timestamps.push_back(next_event);
+			}
+
+			if (f % 5 == 0)
+			{
+				recorder.frame(end);
+
+				for (const auto& event : held)
+					recorder.add(event.first, event.second);
+
+				held = std::move(batch);
+			}
+			else
+			{
+				for (const auto& event : held)
+					recorder.add(event.first, event.second);
+
+				for (const auto& event : batch)
+					recorder.add(event.first, event.second);
+
+				held.clear();
+				recorder.frame(end);
+			}
+
+			now = end;
+			recording.starts.push_back(end);
+		}
+
+		for (const auto& event : held)
+			recorder.add(event.first, event.second);
+
+		recording.timeline = recorder.finish(now + 5000);
+
+		return recording;
+	}
+
+	void CheckRecording(const Recording& recording)
+	{
+		const auto& timeline = recording.timeline;
+
+		CHECK(timeline.durations().size() == recording.starts.size());
+		CHECK(timeline.events().size() == recording.timestamps.size());
+
+		uint64_t last_frame = 0;
+
+		for (const auto& event : timeline.events())
+		{
+			const auto timestamp = recording.timestamps[event.payload.id];
+			const auto frame = size_t(event.frame);
+
+			CHECK(frame + 1 < recording.starts.size());
+			CHECK(recording.starts[frame] <= timestamp && timestamp < recording.starts[frame + 1]);
+			CHECK(recording.starts[frame] + event.offset_us == timestamp);
+			CHECK(event.frame >= last_frame);
+
+			last_frame = event.frame;
+		}
+	}
+
+	void CheckSerialization(const InputTimeline<Payload>& timeline)
+	{
+		auto blob = timeline.save();
+
+		InputTimeline<Payload> loaded;
+		CHECK(loaded.load(blob.data(), blob.size()));
+		CHECK(loaded.durations() == timeline.durations());
+		CHECK(loaded.events().size() == timeline.events().size());
+
+		for (size_t i = 0; i < loaded.events().size(); i++)
+		{
+			CHECK(loaded.events()[i].frame == timeline.events()[i].frame);
+			CHECK(loaded.events()[i].offset_us == timeline.events()[i].offset_us);
+			CHECK(loaded.events()[i].payload.id == timeline.events()[i].payload.id);
+			CHECK(loaded.events()[i].payload.value == timeline.events()[i].payload.value);
+		}
+
+		blob.pop_back();
+
+		InputTimeline<Payload> truncated;
+		CHECK(!truncated.load(blob.data(), blob.size()));
+	}
+
+	//
+	// Replays at a different frame rate with the host polling every millisecond
+	//
+	void CheckReplay(const InputTimeline<Payload>& timeline, bool timed, double frame_ms, std::mt19937& rng)
+	{
+		std::uniform_real_distribution<double> jitter(0.9, 1.1);
+		const auto& events = timeline.events();
+
+		TimelinePlayer<Payload> player(timeline, timed);
+
+		int64_t now = 5000000;
+		size_t emitted = 0;
+		double position_error = 0;
+		size_t polled = 0;
+
+		while (!player.finished())
+		{
+			const auto frame = player.frame();
+			const auto frame_start = now;
+			const auto length = int64_t(frame_ms * 1000 * jitter(rng));
+
+			player.on_frame(now, [&](const Payload& payload)
+			{
+				const auto& event = events[payload.id];
+
+				CHECK(payload.id == emitted);
+				CHECK(event.frame == frame || (timed && event.frame + 1 == frame));
+
+				emitted++;
+			});
+
+			for (auto poll = now + 1000; poll < now + length; poll += 1000)
+			{
+				player.poll(poll, [&](const Payload& payload)
+				{
+					const auto& event = events[payload.id];
+
+					CHECK(timed);
+					CHECK(payload.id == emitted);
+					CHECK(event.frame == frame);
+
+					const auto recorded = timeline.durations()[size_t(event.frame)];
+
+					position_error += std::fabs(double(poll - frame_start) / double(length)
+						- double(event.offset_us) / double(recorded));
+					polled++;
+					emitted++;
+				});
+			}
+
+			now += length;
+		}
+
+		CHECK(emitted == events.size());
+
+		if (!timed)
+			CHECK(player.late() == 0);
+		else
+			CHECK(polled && position_error / double(polled) < 0.15);
+
+		printf("%s replay, %4.0f ms frames: %zu events, %llu late, mean position error %.3f\n",
+			timed ? "timed  " : "aligned", frame_ms, emitted, (unsigned long long)player.late(),
+			polled ? position_error / double(polled) : 0.0);
+	}
+}
+
+int main()
+{
+	std::mt19937 rng(1);
+
+	const auto recording = Record(rng);
+
+	CheckRecording(recording);
+	CheckSerialization(recording.timeline);
+
+	for (const auto timed : { false, true })
+	{
+		for (const auto frame_ms : { 8.0, 16.0, 33.0 })
+			CheckReplay(recording.timeline, timed, frame_ms, rng);
+	}
+
+	return 0;
+}
@@ -0,0 +1,205 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "LatencyModel.h"
+
+#include "Check.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+
+using Indicium::Core::Pacing::LatencyModel;
+
+namespace
+{
+	struct Outcome
+	{
+		double frame_ms;
+		double input_latency_ms;
+		double delay_ms;
+		double present_block_ms;
+	};
+
+	/**
+	 * \brief   Game loop in front of a GPU render queue, in milliseconds of simulated time.
+	 *
+	 *          The game samples input, simulates for cpu_ms and presents. Present blocks while
+	 *          queue_depth frames are still waiting for the GPU, which renders one frame after
+	 *          the other in gpu_ms each. A frame is displayed when the GPU completes it. With
+	 *          a model the game thread waits for its delay after every Present, like the hook.
+	 */
+	Outcome Simulate(double cpu_ms, double gpu_ms, size_t queue_depth, LatencyModel* model, int frames)
+	{
+		std::deque<double> queued;
+		double now = 0.0, gpu_free = 0.0, last_display = 0.0, delay = 0.0;
+
+		Outcome outcome = {};
+		const auto measured_from = frames / 2;
+		double first_display = 0.0;
+
+		for (int i = 0; i < frames; i++)
+		{
+			now += delay;
+
+			const auto input = now;
+			now += cpu_ms;
+
+			//
+			// Present: wait for a free slot in the queue
+			//
+			while (!queued.empty() && queued.front() <= now)
+				queued.pop_front();
+
+			double block = 0.0;
+
+			if (queued.size() >= queue_depth)
+			{
+				block = queued[queued.size() - queue_depth] - now;
+				now += block;
+			}
+
+			const auto display = (std::max)(now, gpu_free) + gpu_ms;
+			gpu_free = display;
+			queued.push_back(display);
+
+			const auto latency = display - now;
+			const auto interval = display - last_display;
+			last_display = display;
+
+			if (model)
+				delay = model->update(block, latency, i ? interval : -1.0);
+
+			if (i == measured_from)
+				first_display = display;
+
+			if (i > measured_from)
+			{
+				outcome.input_latency_ms += display - input;
+				outcome.present_block_ms += block;
+			}
+		}
+
+		const auto measured = double(frames - measured_from - 1);
+
+		outcome.frame_ms = (last_display - first_display) / measured;
+		outcome.input_latency_ms /= measured;
+		outcome.present_block_ms /= measured;
+		outcome.delay_ms = delay;
+
+		return outcome;
+	}
+
+	LatencyModel::Config Defaults()
+	{
+		LatencyModel::Config config;
+		config.margin_ms = 0.5;
+		config.gain = 0.25;
+		config.max_delay_ms = 0.0;
+
+		return config;
+	}
+
+	void Report(const char* name, const Outcome& outcome)
+	{
+		printf("%-28s frame %6.2f ms, input to display %6.2f ms, blocked %5.2f ms, delay %5.2f ms\n",
+			name, outcome.frame_ms, outcome.input_latency_ms, outcome.present_block_ms, outcome.delay_ms);
+	}
+}
+
+int main()
+{
+	//
+	// GPU bound: the queue fills up and every frame waits in it
+	//
+	{
+		LatencyModel model(Defaults());
+
+		const auto unpaced = Simulate(4.0, 10.0, 3, nullptr, 2000);
+		const auto paced = Simulate(4.0, 10.0, 3, &model, 2000);
+
+		Report("GPU bound, unpaced", unpaced);
+		Report("GPU bound, paced", paced);
+
+		CHECK(unpaced.input_latency_ms > 30.0);
+		CHECK(paced.input_latency_ms < unpaced.input_latency_ms * 0.6);
+
+		//
+		// The GPU must not starve: the frame rate stays within 2 %
+		//
+		CHECK(paced.frame_ms < unpaced.frame_ms * 1.02);
+		CHECK(paced.present_block_ms < 1.0);
+		CHECK(paced.delay_ms > 0.0 && paced.delay_ms <= 10.0);
+	}
+
+	//
+	// CPU bound: nothing queues up, so there is nothing to take out
+	//
+	{
+		LatencyModel model(Defaults());
+
+		const auto unpaced = Simulate(12.0, 6.0, 3, nullptr, 2000);
+		const auto paced = Simulate(12.0, 6.0, 3, &model, 2000);
+
+		Report("CPU bound, unpaced", unpaced);
+		Report("CPU bound, paced", paced);
+
+		CHECK(paced.delay_ms == 0.0);
+		CHECK(paced.frame_ms < unpaced.frame_ms * 1.001);
+	}
+
+	//
+	// The load changes from GPU to CPU bound; the delay has to fall back instead of
+	// holding a CPU bound game back
+	//
+	{
+		LatencyModel model(Defaults());
+
+		Simulate(4.0, 10.0, 3, &model, 1000);
+		const auto after = Simulate(12.0, 6.0, 3, &model, 1000);
+
+		Report("GPU then CPU bound, paced", after);
+
+		CHECK(after.delay_ms == 0.0);
+		CHECK(after.frame_ms < 12.0 * 1.01);
+	}
+
+	//
+	// An explicit upper bound is honoured
+	//
+	{
+		auto config = Defaults();
+		config.max_delay_ms = 2.0;
+
+		LatencyModel model(config);
+		const auto paced = Simulate(4.0, 10.0, 3, &model, 2000);
+
+		Report("GPU bound, delay <= 2 ms", paced);
+
+		CHECK(paced.delay_ms <= 2.0);
+	}
+
+	return 0;
+}
@@ -0,0 +1,55 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+//
+// Audio client interfaces for tests, with the methods engine sources call
+// 
+
+#include "Unknwn.h"
+#include "mmreg.h"
+
+#define AUDCLNT_BUFFERFLAGS_DATA_DISCONTINUITY 0x1
+#define AUDCLNT_BUFFERFLAGS_SILENT 0x2
+
+struct IAudioClient : IUnknown
+{
+    virtual HRESULT GetCurrentPadding(UINT32* padding) = 0;
+};
+
+struct IAudioRenderClient : IUnknown
+{
+    virtual HRESULT GetBuffer(UINT32 frames, BYTE** data) = 0;
+    virtual HRESULT ReleaseBuffer(UINT32 frames, DWORD flags) = 0;
+};
+
+template <>
+inline const IID& IndiciumUuidOf<IAudioRenderClient>()
+{
+    static const IID iid = { 0xF294ACFC, 0x3146, 0x4483, { 0xA7, 0xBF, 0xAD, 0xDC, 0xA7, 0xC2, 0x60, 0xE2 } };
+
+    return iid;
+}
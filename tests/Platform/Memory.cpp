@@ -0,0 +1,67 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Engine allocations in tests go straight to the C++ runtime, tags are only passed along
+// 
+
+#include "Memory.h"
+
+#include <cstdlib>
+
+namespace
+{
+	thread_local INDICIUM_MEMORY_TAG t_tag = IndiciumMemoryTagEngine;
+}
+
+void* Indicium::Core::Memory::allocate(size_t size, INDICIUM_MEMORY_TAG, size_t alignment) noexcept
+{
+	if (alignment <= alignof(std::max_align_t))
+		return malloc(size);
+
+	void* block = nullptr;
+
+	return posix_memalign(&block, alignment, size) ? nullptr : block;
+}
+
+void Indicium::Core::Memory::release(void* block) noexcept
+{
+	free(block);
+}
+
+INDICIUM_MEMORY_TAG Indicium::Core::Memory::current_tag()
+{
+	return t_tag;
+}
+
+Indicium::Core::Memory::Scope::Scope(INDICIUM_MEMORY_TAG tag) : previous_(t_tag)
+{
+	t_tag = tag;
+}
+
+Indicium::Core::Memory::Scope::~Scope()
+{
+	t_tag = previous_;
+}
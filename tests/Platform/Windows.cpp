@@ -0,0 +1,147 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Events, performance counter, threads and modules of the Windows API for tests, on top of the
+// C++ runtime. Only what the engine sources under test use: auto and manual reset events,
+// waited on one at a time, thread identifiers and looking up the module of an address.
+// 
+
+#include "Windows.h"
+
+#include <dlfcn.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace
+{
+	struct Event
+	{
+		std::mutex lock;
+		std::condition_variable changed;
+		bool manual_reset;
+		bool signaled;
+	};
+}
+
+HANDLE CreateEvent(PVOID, BOOL manual_reset, BOOL initial_state, LPCSTR)
+{
+	const auto event = new Event;
+
+	event->manual_reset = manual_reset != FALSE;
+	event->signaled = initial_state != FALSE;
+
+	return event;
+}
+
+BOOL SetEvent(HANDLE handle)
+{
+	const auto event = static_cast<Event*>(handle);
+
+	{
+		std::lock_guard<std::mutex> guard(event->lock);
+		event->signaled = true;
+	}
+
+	event->changed.notify_all();
+
+	return TRUE;
+}
+
+BOOL CloseHandle(HANDLE handle)
+{
+	delete static_cast<Event*>(handle);
+
+	return TRUE;
+}
+
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds)
+{
+	const auto event = static_cast<Event*>(handle);
+	std::unique_lock<std::mutex> guard(event->lock);
+
+	if (milliseconds == INFINITE)
+		event->changed.wait(guard, [event] { return event->signaled; });
+	else if (!event->changed.wait_for(guard, std::chrono::milliseconds(milliseconds), [event] { return event->signaled; }))
+		return WAIT_TIMEOUT;
+
+	if (!event->manual_reset)
+		event->signaled = false;
+
+	return WAIT_OBJECT_0;
+}
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count)
+{
+	count->QuadPart = std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+
+	return TRUE;
+}
+
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency)
+{
+	frequency->QuadPart = 1000000000;
+
+	return TRUE;
+}
+
+DWORD GetCurrentThreadId()
+{
+	//
+	// Windows thread IDs are non-zero multiples of four
+	//
+	static std::atomic<DWORD> next{ 4 };
+	thread_local const DWORD id = next.fetch_add(4);
+
+	return id;
+}
+
+BOOL GetModuleHandleExA(DWORD, LPCSTR name, HMODULE* module)
+{
+	Dl_info info;
+
+	//
+	// Callers here always pass GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS
+	//
+	if (!dladdr(name, &info))
+	{
+		*module = nullptr;
+		return FALSE;
+	}
+
+	*module = info.dli_fbase;
+
+	return TRUE;
+}
+
+VOID Sleep(DWORD milliseconds)
+{
+	std::this_thread::sleep_for(std::chrono::milliseconds(milliseconds));
+}
@@ -0,0 +1,210 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#pragma once
+
+//
+// Just enough of the Windows headers to build platform independent engine sources on Linux
+// for tests and benchmarks. Nothing in here talks to a real Windows API.
+// 
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+typedef void VOID;
+typedef void* PVOID;
+typedef void* LPVOID;
+typedef void* HANDLE;
+typedef void* HMODULE;
+typedef void* HWND;
+typedef int BOOL;
+typedef char CHAR;
+typedef unsigned char BYTE;
+typedef unsigned short WORD;
+typedef short SHORT;
+typedef unsigned short USHORT;
+typedef int INT;
+typedef unsigned int UINT;
+typedef int32_t LONG;
+typedef uint32_t ULONG;
+typedef uint32_t DWORD;
+typedef int16_t INT16;
+typedef int32_t INT32;
+typedef uint32_t UINT32;
+typedef int64_t INT64;
+typedef uint64_t UINT64;
+typedef int64_t LONGLONG;
+typedef uint64_t ULONGLONG;
+typedef int64_t LONG64;
+typedef uintptr_t ULONG_PTR;
+typedef uintptr_t WPARAM;
+typedef size_t SIZE_T;
+typedef size_t* PSIZE_T;
+typedef int32_t HRESULT;
+typedef const char* PCSTR;
+typedef const char* LPCSTR;
+typedef char* PSTR;
+typedef const wchar_t* LPCWSTR;
+
+#define TRUE 1
+#define FALSE 0
+#define INFINITE 0xFFFFFFFF
+#define MAX_PATH 260
+#define WAIT_OBJECT_0 0
+#define WAIT_TIMEOUT 258
+
+#define GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT 0x00000002
+#define GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS 0x00000004
+
+#define S_OK ((HRESULT)0)
+#define E_FAIL ((HRESULT)0x80004005)
+#define SUCCEEDED(hr) (((HRESULT)(hr)) >= 0)
+#define FAILED(hr) (((HRESULT)(hr)) < 0)
+
+#define FORCEINLINE inline
+#define ARRAYSIZE(a) (sizeof(a) / sizeof((a)[0]))
+#define ZeroMemory(destination, length) memset((destination), 0, (length))
+#define __declspec(x)
+
+#define _In_
+#define _In_opt_
+#define _Out_
+#define _Out_opt_
+#define _Inout_
+#define _Inout_opt_
+#define _Function_class_(x)
+
+typedef union _LARGE_INTEGER
+{
+    LONGLONG QuadPart;
+} LARGE_INTEGER;
+
+//
+// Raw Input as returned by GetRawInputData and GetRawInputBuffer
+// 
+#define RID_INPUT 0x10000003
+
+#define RIM_TYPEMOUSE 0
+#define RIM_TYPEKEYBOARD 1
+#define RIM_TYPEHID 2
+
+#define MOUSE_MOVE_RELATIVE 0x00
+#define MOUSE_MOVE_ABSOLUTE 0x01
+
+#define RI_MOUSE_LEFT_BUTTON_DOWN 0x0001
+#define RI_MOUSE_LEFT_BUTTON_UP 0x0002
+
+#define RI_KEY_MAKE 0
+#define RI_KEY_BREAK 1
+
+typedef struct tagRAWINPUTHEADER
+{
+    DWORD dwType;
+    DWORD dwSize;
+    HANDLE hDevice;
+    WPARAM wParam;
+} RAWINPUTHEADER;
+
+typedef struct tagRAWMOUSE
+{
+    USHORT usFlags;
+    union
+    {
+        ULONG ulButtons;
+        struct
+        {
+            USHORT usButtonFlags;
+            USHORT usButtonData;
+        };
+    };
+    ULONG ulRawButtons;
+    LONG lLastX;
+    LONG lLastY;
+    ULONG ulExtraInformation;
+} RAWMOUSE;
+
+typedef struct tagRAWKEYBOARD
+{
+    USHORT MakeCode;
+    USHORT Flags;
+    USHORT Reserved;
+    USHORT VKey;
+    UINT Message;
+    ULONG ExtraInformation;
+} RAWKEYBOARD;
+
+typedef struct tagRAWHID
+{
+    DWORD dwSizeHid;
+    DWORD dwCount;
+    BYTE bRawData[1];
+} RAWHID;
+
+typedef struct tagRAWINPUT
+{
+    RAWINPUTHEADER header;
+    union
+    {
+        RAWMOUSE mouse;
+        RAWKEYBOARD keyboard;
+        RAWHID hid;
+    } data;
+} RAWINPUT, *PRAWINPUT;
+
+//
+// Implemented in Windows.cpp on top of the C++ runtime: events, the performance counter (in
+// nanoseconds), thread identifiers, module lookup by address, sleeping and the secure CRT
+// string functions the engine sources use
+// 
+
+HANDLE CreateEvent(PVOID attributes, BOOL manual_reset, BOOL initial_state, LPCSTR name);
+BOOL SetEvent(HANDLE event);
+BOOL CloseHandle(HANDLE handle);
+DWORD WaitForSingleObject(HANDLE handle, DWORD milliseconds);
+
+BOOL QueryPerformanceCounter(LARGE_INTEGER* count);
+BOOL QueryPerformanceFrequency(LARGE_INTEGER* frequency);
+
+DWORD GetCurrentThreadId();
+
+BOOL GetModuleHandleExA(DWORD flags, LPCSTR name, HMODULE* module);
+VOID Sleep(DWORD milliseconds);
+
+template <size_t Size>
+inline int strcpy_s(char (&destination)[Size], const char* source)
+{
+    const auto length = strlen(source);
+
+    if (length >= Size)
+    {
+        destination[0] = 0;
+        return 34;
+    }
+
+    memcpy(destination, source, length + 1);
+    return 0;
+}
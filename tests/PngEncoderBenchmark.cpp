@@ -0,0 +1,350 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Validity and deadlock checks of the parallel PNG encoder plus its throughput and compression
+// ratio per worker count:
+//
+//     PngEncoderBenchmark [width height]
+//
+// Defaults to a small frame for ctest; run with 3840 2160 for the 4K numbers.
+// 
+
+#include "PngEncoder.h"
+#include "WorkerPool.h"
+
+#include "Check.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Indicium::Core::Capture::PngEncoder;
+using Indicium::Core::Tasks::WorkerPool;
+
+namespace
+{
+	UINT32 BigEndian(const BYTE* p)
+	{
+		return (UINT32(p[0]) << 24) | (UINT32(p[1]) << 16) | (UINT32(p[2]) << 8) | p[3];
+	}
+
+	int Paeth(int a, int b, int c)
+	{
+		const auto p = a + b - c, pa = abs(p - a), pb = abs(p - b), pc = abs(p - c);
+
+		return (pa <= pb && pa <= pc) ? a : (pb <= pc ? b : c);
+	}
+
+	//
+	// Reference decoder: checks every chunk CRC, inflates the IDAT stream as one and undoes
+	// the filters
+	//
+	bool Decode(const std::vector<BYTE>& png, UINT32* width, UINT32* height, std::vector<BYTE>& rgb)
+	{
+		static const BYTE signature[8] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+		if (png.size() < 8 || memcmp(png.data(), signature, 8))
+			return false;
+
+		std::vector<BYTE> stream;
+
+		for (size_t position = 8; position + 12 <= png.size();)
+		{
+			const auto length = BigEndian(&png[position]);
+			const auto type = &png[position + 4];
+
+			if (crc32(0, type, length + 4) != BigEndian(type + 4 + length))
+				return false;
+
+			if (!memcmp(type, "IHDR", 4))
+			{
+				*width = BigEndian(type + 4);
+				*height = BigEndian(type + 8);
+			}
+
+			if (!memcmp(type, "IDAT", 4))
+				stream.insert(stream.end(), type + 4, type + 4 + length);
+
+			position += 12 + length;
+		}
+
+		const size_t row = size_t(*width) * 3;
+		std::vector<BYTE> raw((row + 1) * *height);
+		auto raw_size = uLongf(raw.size());
+
+		if (uncompress(raw.data(), &raw_size, stream.data(), uLong(stream.size())) != Z_OK || raw_size != raw.size())
+			return false;
+
+		rgb.assign(row * *height, 0);
+		const std::vector<BYTE> zero(row, 0);
+
+		for (size_t y = 0; y < *height; y++)
+		{
+			const auto filter = raw[y * (row + 1)];
+			const auto source = &raw[y * (row + 1) + 1];
+			const auto target = &rgb[y * row];
+			const auto previous = y ? &rgb[(y - 1) * row] : zero.data();
+
+			for (size_t i = 0; i < row; i++)
+			{
+				const int a = i >= 3 ? target[i - 3] : 0, b = previous[i], c = i >= 3 ? previous[i - 3] : 0;
+				int value = source[i];
+
+				switch (filter)
+				{
+				case 0: break;
+				case 1: value += a; break;
+				case 2: value += b; break;
+				case 3: value += (a + b) / 2; break;
+				case 4: value += Paeth(a, b, c); break;
+				default: return false;
+				}
+
+				target[i] = BYTE(value);
+			}
+		}
+
+		return true;
+	}
+
+	//
+	// Gradients, a checker board, sparse highlights and noisy patches, roughly like game frames
+	//
+	struct Image
+	{
+		UINT32 width;
+		UINT32 height;
+		std::vector<BYTE> bgra;
+		std::vector<BYTE> rgb;
+		INDICIUM_CAPTURED_FRAME frame;
+	};
+
+	void Generate(Image& image, UINT32 width, UINT32 height)
+	{
+		std::mt19937 rng(1);
+
+		image.width = width;
+		image.height = height;
+		image.bgra.assign(size_t(width) * 4 * height, 0);
+		image.rgb.assign(size_t(width) * 3 * height, 0);
+
+		for (UINT32 y = 0; y < height; y++)
+		{
+			for (UINT32 x = 0; x < width; x++)
+			{
+				int r = int(x * 255 / width), g = int(y * 255 / height), b = ((x / 64 + y / 64) & 1) * 200;
+
+				if ((x * 7 + y * 3) % 97 < 3)
+					r = g = b = 255;
+
+				if ((x / 300 + y / 200) % 5 == 0)
+				{
+					r = (r + int(rng() % 24)) & 255;
+					g ^= int(rng() % 8);
+				}
+
+				const auto pixel = &image.bgra[(size_t(y) * width + x) * 4];
+				pixel[0] = BYTE(b);
+				pixel[1] = BYTE(g);
+				pixel[2] = BYTE(r);
+				pixel[3] = BYTE(rng());
+
+				const auto expected = &image.rgb[(size_t(y) * width + x) * 3];
+				expected[0] = BYTE(r);
+				expected[1] = BYTE(g);
+				expected[2] = BYTE(b);
+			}
+		}
+
+		image.frame = INDICIUM_CAPTURED_FRAME();
+		image.frame.Version = IndiciumDirect3DVersion11;
+		image.frame.Format = 87;
+		image.frame.Width = width;
+		image.frame.Height = height;
+		image.frame.Pitch = width * 4;
+		image.frame.Data = image.bgra.data();
+	}
+
+	void Encode(const Image& image, WorkerPool* workers, const INDICIUM_PNG_CONFIG& config, std::vector<BYTE>& png)
+	{
+		PngEncoder::Layout layout;
+		CHECK(PngEncoder::layout_of(image.frame, &layout));
+
+		PngEncoder encoder(image.frame, layout, config);
+		CHECK(encoder.encode(workers, png) == INDICIUM_ERROR_NONE);
+	}
+
+	void CheckValid(const Image& image, const std::vector<BYTE>& png)
+	{
+		UINT32 width = 0, height = 0;
+		std::vector<BYTE> rgb;
+
+		CHECK(Decode(png, &width, &height, rgb));
+		CHECK(width == image.width && height == image.height);
+		CHECK(rgb == image.rgb);
+	}
+
+	//
+	// Encoding must finish on its own however the pool is doing
+	//
+	void CheckNoDeadlock(const Image& image)
+	{
+		INDICIUM_PNG_CONFIG config;
+		INDICIUM_PNG_CONFIG_INIT(&config);
+		config.RowsPerChunk = 16;
+
+		//
+		// From the only worker of the pool, like a Post-Present task saving a screenshot
+		//
+		{
+			WorkerPool pool(1);
+
+			struct Context
+			{
+				const Image* image;
+				WorkerPool* pool;
+				const INDICIUM_PNG_CONFIG* config;
+				std::vector<BYTE> png;
+				std::atomic<bool> done;
+			} context = { &image, &pool, &config, {}, { false } };
+
+			CHECK(pool.submit([](void* argument, size_t)
+			{
+				const auto self = static_cast<Context*>(argument);
+
+				Encode(*self->image, self->pool, *self->config, self->png);
+				self->done = true;
+			}, &context, 0));
+
+			const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+
+			while (!context.done && std::chrono::steady_clock::now() < deadline)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+			CHECK(context.done);
+			CheckValid(image, context.png);
+		}
+
+		//
+		// With the pool shut down, as after the engine stopped
+		//
+		{
+			WorkerPool pool(2);
+			pool.shutdown();
+
+			std::vector<BYTE> png;
+			Encode(image, &pool, config, png);
+			CheckValid(image, png);
+		}
+
+		//
+		// With every worker busy for longer than the encode takes
+		//
+		{
+			WorkerPool pool(2);
+			std::atomic<bool> release(false);
+
+			for (size_t i = 0; i < pool.size(); i++)
+			{
+				CHECK(pool.submit([](void* argument, size_t)
+				{
+					while (!static_cast<std::atomic<bool>*>(argument)->load())
+						std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}, &release, i));
+			}
+
+			std::vector<BYTE> png;
+			Encode(image, &pool, config, png);
+			release = true;
+
+			CheckValid(image, png);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	const auto width = UINT32(argc > 2 ? atoi(argv[1]) : 640);
+	const auto height = UINT32(argc > 2 ? atoi(argv[2]) : 360);
+
+	Image image;
+	Generate(image, width, height);
+
+	CheckNoDeadlock(image);
+
+	const size_t raw = size_t(width) * 3 * height;
+
+	for (const auto level : { 1, 6 })
+	{
+		INDICIUM_PNG_CONFIG config;
+		INDICIUM_PNG_CONFIG_INIT(&config);
+		config.CompressionLevel = level;
+
+		//
+		// One chunk and no workers: what a plain single-threaded encoder does
+		//
+		{
+			auto single = config;
+			single.RowsPerChunk = height;
+
+			std::vector<BYTE> png;
+			const auto begin = std::chrono::steady_clock::now();
+			Encode(image, nullptr, single, png);
+			const auto ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+			CheckValid(image, png);
+
+			printf("%ux%u level %d, single stream:  %8.1f ms %8.1f MB/s, ratio %5.2f %%\n",
+				width, height, level, ms, raw / 1e3 / ms, 100.0 * png.size() / raw);
+		}
+
+		for (const size_t threads : { 0, 1, 3, 7 })
+		{
+			std::unique_ptr<WorkerPool> pool(threads ? new WorkerPool(threads) : nullptr);
+			std::vector<BYTE> png;
+			double best = 1e30;
+
+			for (int repeat = 0; repeat < 3; repeat++)
+			{
+				const auto begin = std::chrono::steady_clock::now();
+				Encode(image, pool.get(), config, png);
+				best = (std::min)(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count());
+			}
+
+			CheckValid(image, png);
+			CHECK(png.size() <= PngEncoder::bound(image.frame, config));
+
+			printf("%ux%u level %d, %zu workers + caller: %6.1f ms %8.1f MB/s, ratio %5.2f %%\n",
+				width, height, level, threads, best, raw / 1e3 / best, 100.0 * png.size() / raw);
+		}
+	}
+
+	return 0;
+}
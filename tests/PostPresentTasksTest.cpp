@@ -0,0 +1,274 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Post-Present task graphs run the way the Present hooks run them: frames dispatched from a
+// simulated render thread onto a worker pool, with tasks removed while frames are in flight
+// and the pool shut down in the middle of a frame.
+//
+
+#include <Windows.h>
+
+#include "PostPresentTasks.h"
+
+#include "Check.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+using Indicium::Core::Stats::CounterRegistry;
+using Indicium::Core::Tasks::PostPresentTasks;
+using Indicium::Core::Tasks::WorkerPool;
+
+namespace
+{
+	struct Task
+	{
+		std::atomic<int> runs{ 0 };
+
+		//
+		// Runs which found their dependency's run missing
+		//
+		std::atomic<int> out_of_order{ 0 };
+
+		Task* after = nullptr;
+		std::atomic<bool>* gate = nullptr;
+	};
+
+	VOID EvtTask(const INDICIUM_POST_PRESENT_FRAME*, PVOID Context)
+	{
+		const auto task = static_cast<Task*>(Context);
+
+		if (task->gate)
+		{
+			while (!task->gate->load())
+				std::this_thread::yield();
+		}
+
+		if (task->after && task->after->runs.load() <= task->runs.load())
+			task->out_of_order++;
+
+		task->runs++;
+	}
+
+	INDICIUM_TASK_ID Add(PostPresentTasks& tasks, Task& task, bool uses_device, const INDICIUM_TASK_ID* dependency = nullptr)
+	{
+		INDICIUM_POST_PRESENT_TASK description;
+		INDICIUM_POST_PRESENT_TASK_INIT(&description, EvtTask, &task);
+
+		description.UsesDeviceContext = uses_device;
+		description.Dependencies = dependency;
+		description.DependencyCount = dependency ? 1 : 0;
+
+		INDICIUM_TASK_ID id;
+		CHECK(tasks.add(description, &id) == INDICIUM_ERROR_NONE);
+
+		return id;
+	}
+
+	INDICIUM_POST_PRESENT_STATISTICS Statistics(const PostPresentTasks& tasks)
+	{
+		INDICIUM_POST_PRESENT_STATISTICS stats;
+		tasks.statistics(&stats);
+
+		return stats;
+	}
+
+	//
+	// Presents until the frame's worker tasks got dispatched and completed
+	//
+	void Frame(PostPresentTasks& tasks, ULONGLONG executed)
+	{
+		const auto dispatched = Statistics(tasks).FramesDispatched;
+
+		while (Statistics(tasks).FramesDispatched == dispatched)
+			tasks.run(nullptr, IndiciumDirect3DVersion11, nullptr, S_OK);
+
+		while (Statistics(tasks).TasksExecuted < executed)
+			std::this_thread::yield();
+	}
+
+	void CheckDependencies()
+	{
+		CounterRegistry counters;
+		WorkerPool pool(4);
+		PostPresentTasks tasks(pool, counters);
+
+		Task device, first, second;
+		second.after = &first;
+
+		Add(tasks, device, true);
+		const auto id = Add(tasks, first, false);
+		Add(tasks, second, false, &id);
+
+		for (ULONGLONG frame = 1; frame <= 100; frame++)
+			Frame(tasks, frame * 3);
+
+		//
+		// As the engine does before tearing down the tasks
+		//
+		pool.shutdown();
+
+		CHECK(first.runs == 100 && second.runs == 100 && second.out_of_order == 0);
+		CHECK(device.runs >= 100);
+	}
+
+	void CheckRemove()
+	{
+		CounterRegistry counters;
+		WorkerPool pool(4);
+		PostPresentTasks tasks(pool, counters);
+
+		Task device, first, second;
+
+		const auto inline_id = Add(tasks, device, true);
+		const auto id = Add(tasks, first, false);
+		Add(tasks, second, false, &id);
+
+		CHECK(tasks.remove(id + 5) == INDICIUM_ERROR_INVALID_PARAMETER);
+
+		//
+		// Frames keep coming while tasks get removed; once remove returns they never run again
+		//
+		std::atomic<bool> stop{ false };
+
+		std::thread render([&]()
+		{
+			while (!stop)
+				tasks.run(nullptr, IndiciumDirect3DVersion11, nullptr, S_OK);
+		});
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		CHECK(tasks.remove(id) == INDICIUM_ERROR_NONE);
+		const auto first_runs = first.runs.load();
+
+		CHECK(tasks.remove(inline_id) == INDICIUM_ERROR_NONE);
+		const auto device_runs = device.runs.load();
+
+		CHECK(tasks.remove(id) == INDICIUM_ERROR_INVALID_PARAMETER);
+
+		const auto second_runs = second.runs.load();
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+		stop = true;
+		render.join();
+
+		pool.shutdown();
+
+		CHECK(first.runs == first_runs && device.runs == device_runs);
+
+		//
+		// The dependent task still runs, its removed dependency counts as completed
+		//
+		CHECK(second.runs > second_runs);
+	}
+
+	void CheckRemoveModule()
+	{
+		CounterRegistry counters;
+		WorkerPool pool(2);
+		PostPresentTasks tasks(pool, counters);
+
+		Task device, worker;
+
+		Add(tasks, device, true);
+		Add(tasks, worker, false);
+
+		Frame(tasks, 2);
+
+		HMODULE module;
+		CHECK(GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+			reinterpret_cast<LPCSTR>(&EvtTask), &module));
+
+		tasks.remove_module(module);
+
+		const auto executed = Statistics(tasks).TasksExecuted;
+
+		for (int i = 0; i < 10; i++)
+			tasks.run(nullptr, IndiciumDirect3DVersion11, nullptr, S_OK);
+
+		pool.shutdown();
+
+		CHECK(Statistics(tasks).TasksExecuted == executed);
+		CHECK(device.runs == 1 && worker.runs == 1);
+	}
+
+	void CheckShutdown()
+	{
+		CounterRegistry counters;
+		WorkerPool pool(2);
+		PostPresentTasks tasks(pool, counters);
+
+		std::atomic<bool> gate{ false };
+		Task first, second, third;
+		first.gate = &gate;
+
+		const auto id = Add(tasks, first, false);
+		const auto next = Add(tasks, second, false, &id);
+		Add(tasks, third, false, &next);
+
+		tasks.run(nullptr, IndiciumDirect3DVersion11, nullptr, S_OK);
+
+		//
+		// The first task finishes after the pool stopped taking jobs, its dependents can't be
+		// queued anymore
+		//
+		std::thread stopping([&]() { pool.shutdown(); });
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		gate = true;
+
+		stopping.join();
+
+		CHECK(first.runs == 1 && second.runs == 0 && third.runs == 0);
+
+		//
+		// No frame is left in flight, later frames aren't skipped for it
+		//
+		for (int i = 0; i < 10; i++)
+			tasks.run(nullptr, IndiciumDirect3DVersion11, nullptr, S_OK);
+
+		const auto stats = Statistics(tasks);
+
+		CHECK(stats.FramesSkipped == 0 && stats.FramesDispatched == 11);
+		CHECK(first.runs == 1);
+	}
+}
+
+int main()
+{
+	CheckDependencies();
+	CheckRemove();
+	CheckRemoveModule();
+	CheckShutdown();
+
+	printf("Post-Present tasks: dependencies, removal and pool shutdown behave\n");
+
+	return 0;
+}
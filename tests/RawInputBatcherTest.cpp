@@ -0,0 +1,332 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Raw input batching the way the GetRawInputData and GetRawInputBuffer hooks drive it: events
+// recorded on a window thread, merged and handed out once per frame on the render thread, plus
+// the cost per event of a high rate mouse:
+//
+//     RawInputBatcherTest [frames]
+//
+
+#include <Windows.h>
+
+#include "RawInputBatcher.h"
+#include "Counters.h"
+
+#include "Check.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+using Indicium::Core::Input::RawInputBatcher;
+using Indicium::Core::Input::RawInputSink;
+using Indicium::Core::Stats::CounterRegistry;
+
+//
+// Batch callbacks ask for the context of the engine, there is none here
+//
+PVOID IndiciumEngineGetCustomContext(PINDICIUM_ENGINE)
+{
+	return nullptr;
+}
+
+namespace
+{
+	HANDLE const Mouse = reinterpret_cast<HANDLE>(0x10);
+	HANDLE const Keyboard = reinterpret_cast<HANDLE>(0x20);
+
+	std::vector<INDICIUM_RAW_INPUT_EVENT> g_Batch;
+	ULONGLONG g_Dropped;
+	size_t g_Batches;
+
+	VOID EvtBatch(const INDICIUM_RAW_INPUT_EVENT* Events, SIZE_T Count, ULONGLONG DroppedEvents, PINDICIUM_EVT_POST_EXTENSION)
+	{
+		g_Batch.assign(Events, Events + Count);
+		g_Dropped = DroppedEvents;
+		g_Batches++;
+	}
+
+	struct Sink : RawInputSink
+	{
+		size_t events = 0;
+
+		void on_raw_input(const INDICIUM_RAW_INPUT_EVENT*, size_t count) override
+		{
+			events += count;
+		}
+	};
+
+	RAWINPUT Move(LONG x, LONG y, USHORT buttons = 0)
+	{
+		RAWINPUT input;
+		ZeroMemory(&input, sizeof(input));
+
+		input.header.dwType = RIM_TYPEMOUSE;
+		input.header.dwSize = sizeof(RAWINPUT);
+		input.header.hDevice = Mouse;
+		input.data.mouse.usFlags = MOUSE_MOVE_RELATIVE;
+		input.data.mouse.usButtonFlags = buttons;
+		input.data.mouse.lLastX = x;
+		input.data.mouse.lLastY = y;
+
+		return input;
+	}
+
+	RAWINPUT Key(USHORT vkey, USHORT flags)
+	{
+		RAWINPUT input;
+		ZeroMemory(&input, sizeof(input));
+
+		input.header.dwType = RIM_TYPEKEYBOARD;
+		input.header.dwSize = sizeof(RAWINPUT);
+		input.header.hDevice = Keyboard;
+		input.data.keyboard.VKey = vkey;
+		input.data.keyboard.Flags = flags;
+
+		return input;
+	}
+
+	//
+	// What the GetRawInputData hook sees for a WM_INPUT read with RID_INPUT
+	//
+	void Read(RawInputBatcher& batcher, RAWINPUT input)
+	{
+		batcher.on_get_data(RID_INPUT, &input, input.header.dwSize);
+	}
+
+	void Deliver(RawInputBatcher& batcher)
+	{
+		g_Batch.clear();
+		batcher.deliver(nullptr);
+	}
+
+	INDICIUM_RAW_INPUT_STATISTICS Statistics(const RawInputBatcher& batcher)
+	{
+		INDICIUM_RAW_INPUT_STATISTICS statistics;
+		batcher.statistics(&statistics);
+
+		return statistics;
+	}
+
+	//
+	// Motion merges into one event per frame with the summed deltas; buttons and keys split it
+	// and arrive in order
+	//
+	void CheckCoalescing()
+	{
+		CounterRegistry counters;
+		RawInputBatcher batcher(counters);
+
+		INDICIUM_RAW_INPUT_CONFIG config;
+		INDICIUM_RAW_INPUT_CONFIG_INIT(&config, EvtBatch);
+		batcher.start(config);
+
+		//
+		// An 8 kHz mouse at 30 frames per second
+		//
+		for (int i = 0; i < 266; i++)
+			Read(batcher, Move(i % 3 - 1, 2));
+
+		Deliver(batcher);
+
+		CHECK(g_Batch.size() == 1);
+		CHECK(g_Batch[0].Type == IndiciumRawInputMouse && g_Batch[0].Coalesced == 266);
+		CHECK(g_Batch[0].Mouse.X == -1 && g_Batch[0].Mouse.Y == 532);
+		CHECK(g_Batch[0].FirstTimestamp <= g_Batch[0].LastTimestamp);
+
+		Read(batcher, Move(1, 1));
+		Read(batcher, Move(1, 1));
+		Read(batcher, Move(0, 0, RI_MOUSE_LEFT_BUTTON_DOWN));
+		Read(batcher, Key('W', RI_KEY_MAKE));
+		Read(batcher, Move(3, 0));
+		Read(batcher, Move(3, 0));
+		Read(batcher, Move(0, 0, RI_MOUSE_LEFT_BUTTON_UP));
+
+		Deliver(batcher);
+
+		CHECK(g_Batch.size() == 5);
+		CHECK(g_Batch[0].Coalesced == 2 && g_Batch[0].Mouse.X == 2);
+		CHECK(g_Batch[1].Mouse.ButtonFlags == RI_MOUSE_LEFT_BUTTON_DOWN);
+		CHECK(g_Batch[2].Type == IndiciumRawInputKeyboard && g_Batch[2].Keyboard.VKey == 'W');
+		CHECK(g_Batch[3].Coalesced == 2 && g_Batch[3].Mouse.X == 6);
+		CHECK(g_Batch[4].Mouse.ButtonFlags == RI_MOUSE_LEFT_BUTTON_UP);
+
+		//
+		// The same input read twice gets recorded twice, handles are reused by Windows
+		//
+		auto input = Move(0, 0, RI_MOUSE_LEFT_BUTTON_DOWN);
+		batcher.on_get_data(RID_INPUT, &input, input.header.dwSize);
+		batcher.on_get_data(RID_INPUT, &input, input.header.dwSize);
+
+		Deliver(batcher);
+		CHECK(g_Batch.size() == 2);
+
+		const auto statistics = Statistics(batcher);
+
+		CHECK(statistics.Events == 266 + 7 + 2);
+		CHECK(statistics.Delivered == 1 + 5 + 2);
+		CHECK(statistics.Coalesced == 265 + 2);
+		CHECK(statistics.Batches == 3);
+		CHECK(statistics.Dropped == 0);
+	}
+
+	//
+	// GetRawInputBuffer hands out pointer aligned blocks, all of them get recorded
+	//
+	void CheckBuffer()
+	{
+		CounterRegistry counters;
+		RawInputBatcher batcher(counters);
+
+		INDICIUM_RAW_INPUT_CONFIG config;
+		INDICIUM_RAW_INPUT_CONFIG_INIT(&config, EvtBatch);
+		config.CoalesceMouseMotion = FALSE;
+		batcher.start(config);
+
+		const RAWINPUT inputs[] = { Move(1, 0), Key('A', RI_KEY_MAKE), Move(2, 0), Key('A', RI_KEY_BREAK) };
+
+		std::vector<RAWINPUT> buffer(ARRAYSIZE(inputs));
+
+		for (size_t i = 0; i < ARRAYSIZE(inputs); i++)
+			buffer[i] = inputs[i];
+
+		batcher.on_get_buffer(buffer.data(), ARRAYSIZE(inputs));
+
+		Deliver(batcher);
+
+		CHECK(g_Batch.size() == ARRAYSIZE(inputs));
+		CHECK(g_Batch[0].Mouse.X == 1 && g_Batch[2].Mouse.X == 2);
+		CHECK(g_Batch[1].Keyboard.Flags == RI_KEY_MAKE && g_Batch[3].Keyboard.Flags == RI_KEY_BREAK);
+	}
+
+	//
+	// Recording alone, without a batch callback, still shows up in the statistics
+	//
+	void CheckSinkOnly()
+	{
+		CounterRegistry counters;
+		RawInputBatcher batcher(counters);
+		Sink sink;
+
+		batcher.attach(&sink);
+
+		for (int i = 0; i < 10; i++)
+			Read(batcher, Move(1, 0));
+
+		const auto batches = g_Batches;
+
+		Deliver(batcher);
+
+		CHECK(sink.events == 1);
+		CHECK(g_Batches == batches);
+
+		const auto statistics = Statistics(batcher);
+
+		CHECK(statistics.Events == 10);
+		CHECK(statistics.Delivered == 1);
+		CHECK(statistics.Coalesced == 9);
+		CHECK(statistics.Batches == 0);
+
+		batcher.attach(nullptr);
+	}
+
+	//
+	// A window thread reading an 8 kHz mouse while the render thread delivers at 30 fps
+	//
+	void Measure(int frames)
+	{
+		const int PerFrame = 266;
+
+		CounterRegistry counters;
+		RawInputBatcher batcher(counters);
+
+		INDICIUM_RAW_INPUT_CONFIG config;
+		INDICIUM_RAW_INPUT_CONFIG_INIT(&config, EvtBatch);
+		batcher.start(config);
+
+		//
+		// The frames are handed back and forth, so every batch holds exactly one frame of input
+		//
+		std::atomic<int> requested{ 0 };
+		std::atomic<int> read{ 0 };
+
+		std::thread window([&]
+		{
+			for (int frame = 1; frame <= frames; frame++)
+			{
+				while (requested.load() < frame)
+					std::this_thread::yield();
+
+				for (int i = 0; i < PerFrame; i++)
+					Read(batcher, Move(1, 0));
+
+				read.store(frame);
+			}
+		});
+
+		LONG sum = 0;
+
+		const auto begin = std::chrono::steady_clock::now();
+
+		for (int frame = 1; frame <= frames; frame++)
+		{
+			requested.store(frame);
+
+			while (read.load() < frame)
+				std::this_thread::yield();
+
+			Deliver(batcher);
+
+			CHECK(g_Batch.size() == 1);
+			sum += g_Batch[0].Mouse.X;
+		}
+
+		const auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+
+		window.join();
+
+		CHECK(sum == LONG(frames) * PerFrame);
+		CHECK(Statistics(batcher).Dropped == 0);
+
+		printf("%d events per frame coalesced into one, %.0f ns per event including delivery\n",
+			PerFrame, wall * 1e9 / (double(frames) * PerFrame));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	CheckCoalescing();
+	CheckBuffer();
+	CheckSinkOnly();
+
+	Measure(argc > 1 ? atoi(argv[1]) : 3000);
+
+	return 0;
+}
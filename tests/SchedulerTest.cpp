@@ -0,0 +1,314 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+//
+// Behaviour of the coroutine scheduler driven the way the engine drives it: Presents and
+// resizes from a simulated render thread, timed waits from engine ticks run through the tick
+// handlers of the engine, with a clock the test advances by hand.
+//
+
+#include <Windows.h>
+
+#include "Indicium/Engine/IndiciumCore.h"
+#include "Indicium/Engine/IndiciumTasks.h"
+#include "Indicium/Engine/IndiciumCoroutines.hpp"
+
+#include "TickHandlers.h"
+
+#include "Check.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace
+{
+	struct ManualClock
+	{
+		typedef std::chrono::nanoseconds duration;
+		typedef duration::rep rep;
+		typedef duration::period period;
+		typedef std::chrono::time_point<ManualClock> time_point;
+
+		static constexpr bool is_steady = true;
+		static inline time_point current{};
+
+		static time_point now() { return current; }
+	};
+
+	typedef Indicium::Coroutines::Scheduler<int*, ManualClock> Scheduler;
+	typedef Indicium::Coroutines::Task Task;
+
+	//
+	// Stand-in for the engine behind the tick handler API
+	//
+	Indicium::Core::Tasks::TickHandlers* g_Handlers;
+	size_t g_TickRequests;
+
+	//
+	// What the engine thread does between two waits
+	//
+	DWORD EngineTick()
+	{
+		g_Handlers->run(nullptr);
+		return g_Handlers->interval();
+	}
+
+	struct Destroyed
+	{
+		int* count;
+		~Destroyed() { ++*count; }
+	};
+
+	Task WaitPresents(Scheduler& scheduler, int* chain, std::vector<int>& log, int id, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			co_await scheduler.next_present(chain);
+			log.push_back(id);
+		}
+	}
+
+	Task WaitFrames(Scheduler& scheduler, uint32_t frames, bool& done)
+	{
+		co_await scheduler.frames(frames);
+		done = true;
+	}
+
+	Task WaitSettled(Scheduler& scheduler, int* chain, bool& done)
+	{
+		co_await scheduler.resize_settled(chain);
+		done = true;
+	}
+
+	Task Sleep(Scheduler& scheduler, std::chrono::milliseconds delay, int& stage)
+	{
+		co_await scheduler.after(delay);
+		stage = 1;
+
+		//
+		// Back from the engine thread to the render thread
+		//
+		co_await scheduler.next_present();
+		stage = 2;
+	}
+
+	Task Forever(Scheduler& scheduler, int& destroyed)
+	{
+		Destroyed guard{ &destroyed };
+
+		for (;;)
+			co_await scheduler.next_present();
+	}
+
+	void CheckPresents()
+	{
+		Scheduler scheduler;
+		int first = 0, second = 0;
+		std::vector<int> log;
+
+		WaitPresents(scheduler, &first, log, 1, 2);
+		WaitPresents(scheduler, &second, log, 2, 1);
+		WaitPresents(scheduler, nullptr, log, 3, 3);
+
+		scheduler.on_present(&first);
+		CHECK((log == std::vector<int>{ 1, 3 }) || (log == std::vector<int>{ 3, 1 }));
+
+		//
+		// Waiting again right after being resumed means the next Present, not this one
+		//
+		log.clear();
+		scheduler.on_present(&second);
+		CHECK((log == std::vector<int>{ 2, 3 }) || (log == std::vector<int>{ 3, 2 }));
+
+		log.clear();
+		scheduler.on_present(&first);
+		CHECK((log == std::vector<int>{ 1, 3 }) || (log == std::vector<int>{ 3, 1 }));
+		CHECK(scheduler.idle());
+	}
+
+	void CheckFrames()
+	{
+		Scheduler scheduler;
+		int chain = 0;
+		bool now = false, later = false;
+
+		WaitFrames(scheduler, 0, now);
+		CHECK(now);
+
+		WaitFrames(scheduler, 3, later);
+
+		scheduler.on_present(&chain);
+		scheduler.on_present(nullptr);
+		CHECK(!later);
+
+		scheduler.on_present(&chain);
+		CHECK(later && scheduler.idle());
+	}
+
+	void CheckResize()
+	{
+		Scheduler scheduler(2);
+		int chain = 0, other = 0;
+		bool done = false;
+
+		WaitSettled(scheduler, &chain, done);
+
+		scheduler.on_present(&chain);
+		scheduler.on_resize(&chain);
+		scheduler.on_present(&chain);
+		CHECK(!done);
+
+		//
+		// Neither Presents nor resizes of other swap chains count
+		//
+		scheduler.on_resize(&other);
+		scheduler.on_present(&other);
+		CHECK(!done);
+
+		scheduler.on_present(&chain);
+		CHECK(done);
+	}
+
+	void CheckTicks()
+	{
+		Indicium::Core::Tasks::TickHandlers handlers;
+		g_Handlers = &handlers;
+		g_TickRequests = 0;
+
+		Scheduler scheduler;
+		int stage = 0, early = 0;
+
+		CHECK(handlers.interval() == INFINITE);
+		CHECK(Indicium::Coroutines::attach(nullptr, scheduler) == INDICIUM_ERROR_NONE);
+		CHECK(handlers.interval() == 0);
+		CHECK(EngineTick() == INFINITE);
+
+		Sleep(scheduler, 250ms, stage);
+		CHECK(g_TickRequests == 1);
+
+		//
+		// Later timers don't need an earlier tick, earlier ones do
+		//
+		Sleep(scheduler, 400ms, early);
+		CHECK(g_TickRequests == 1);
+
+		CHECK(EngineTick() == 250);
+
+		ManualClock::current += 249ms + 500us;
+		CHECK(EngineTick() == 1);
+		CHECK(stage == 0);
+
+		ManualClock::current += 500us;
+		CHECK(EngineTick() == 150);
+		CHECK(stage == 1 && early == 0);
+
+		int resumed_on_tick = 0;
+		Sleep(scheduler, 10ms, resumed_on_tick);
+		CHECK(g_TickRequests == 2);
+		CHECK(EngineTick() == 10);
+
+		scheduler.on_present(nullptr);
+		CHECK(stage == 2 && resumed_on_tick == 0);
+
+		//
+		// Ticks come from the engine thread while the render thread presents
+		//
+		ManualClock::current += 500ms;
+
+		std::thread engine([]() { EngineTick(); });
+		engine.join();
+
+		CHECK(early == 1 && resumed_on_tick == 1);
+
+		scheduler.on_present(nullptr);
+		CHECK(early == 2 && resumed_on_tick == 2 && scheduler.idle());
+
+		CHECK(Indicium::Coroutines::detach(nullptr, scheduler) == INDICIUM_ERROR_NONE);
+		CHECK(Indicium::Coroutines::detach(nullptr, scheduler) == INDICIUM_ERROR_INVALID_PARAMETER);
+		CHECK(EngineTick() == INFINITE);
+
+		//
+		// Detached schedulers don't request ticks anymore
+		//
+		int detached = 0;
+		Sleep(scheduler, 1ms, detached);
+		CHECK(g_TickRequests == 2);
+		scheduler.shutdown();
+
+		g_Handlers = nullptr;
+	}
+
+	void CheckShutdown()
+	{
+		int destroyed = 0;
+
+		{
+			Scheduler scheduler;
+
+			Forever(scheduler, destroyed);
+			Forever(scheduler, destroyed);
+
+			scheduler.on_present(nullptr);
+			CHECK(destroyed == 0);
+		}
+
+		CHECK(destroyed == 2);
+	}
+}
+
+//
+// The engine's side of the tick handler API, backed by the handlers above
+//
+INDICIUM_API INDICIUM_ERROR IndiciumEngineAddTickHandler(PINDICIUM_ENGINE, PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick, PVOID Context)
+{
+	return g_Handlers->add(EvtIndiciumEngineTick, Context);
+}
+
+INDICIUM_API INDICIUM_ERROR IndiciumEngineRemoveTickHandler(PINDICIUM_ENGINE, PFN_INDICIUM_ENGINE_TICK EvtIndiciumEngineTick, PVOID Context)
+{
+	return g_Handlers->remove(EvtIndiciumEngineTick, Context);
+}
+
+INDICIUM_API VOID IndiciumEngineRequestTick(PINDICIUM_ENGINE)
+{
+	g_TickRequests++;
+}
+
+int main()
+{
+	CheckPresents();
+	CheckFrames();
+	CheckResize();
+	CheckTicks();
+	CheckShutdown();
+
+	printf("Scheduler: presents, frames, resizes, engine ticks and shutdown behave\n");
+
+	return 0;
+}
@@ -0,0 +1,173 @@
+/*
+MIT License
+
+Copyright (c) 2018-2019 Benjamin Höglinger
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+
+#include "Indicium/Engine/IndiciumSharedFrames.hpp"
+
+#include "Check.h"
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace Indicium::SharedFrames;
+
+namespace
+{
+	const char* const MappingName = "indicium_shared_frames_test";
+	const size_t SlotCapacity = 1 << 20;
+	const uint64_t Frames = 200000;
+
+	//
+	// Every frame is filled with its frame number, so a torn copy shows up as mixed bytes
+	//
+	FrameInfo Describe(uint64_t n)
+	{
+		FrameInfo info = {};
+		info.width = uint32_t(64 + n % 128);
+		info.height = uint32_t(100 + n % 50);
+		info.pitch = info.width * 4;
+		info.size = uint64_t(info.pitch) * info.height;
+
+		return info;
+	}
+
+	//
+	// Child process; exits with the number of broken frames, capped
+	//
+	int ReadUntilClosed(bool small_buffer)
+	{
+		Reader reader;
+
+		if (!reader.open(MappingName))
+			return 100;
+
+		std::vector<uint8_t> pixels(small_buffer ? 1000 : size_t(reader.slot_capacity()));
+		FrameInfo info;
+		uint64_t last = 0, frames = 0;
+		int broken = 0;
+
+		for (;;)
+		{
+			const auto result = reader.read(info, pixels.data(), pixels.size());
+
+			if (result == ReadResult::closed)
+				break;
+
+			if (result == ReadResult::buffer_too_small)
+			{
+				pixels.resize(size_t(info.size));
+				continue;
+			}
+
+			if (result != ReadResult::frame)
+				continue;
+
+			frames++;
+
+			const auto expected = Describe(info.frame_number);
+
+			if (info.frame_number <= last || info.size != expected.size || info.width != expected.width)
+				broken++;
+
+			for (size_t i = 0; i < info.size; i += 97)
+			{
+				if (pixels[i] != uint8_t(info.frame_number))
+				{
+					broken++;
+					break;
+				}
+			}
+
+			last = info.frame_number;
+		}
+
+		printf("reader (%s buffer): %llu frames, %d broken\n",
+			small_buffer ? "small" : "full", (unsigned long long)frames, broken);
+
+		return frames == 0 ? 101 : (broken < 100 ? broken : 99);
+	}
+}
+
+int main()
+{
+	Writer writer;
+
+	CHECK(writer.create(MappingName, SlotCapacity, 1000000000, uint32_t(getpid())));
+
+	std::vector<pid_t> readers;
+
+	for (int small = 0; small < 2; small++)
+	{
+		const auto pid = fork();
+
+		if (pid == 0)
+		{
+			fflush(stdout);
+			_exit(ReadUntilClosed(small != 0));
+		}
+
+		CHECK(pid > 0);
+		readers.push_back(pid);
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	std::vector<uint8_t> pixels(SlotCapacity);
+
+	for (uint64_t n = 1; n <= Frames; n++)
+	{
+		const auto info = Describe(n);
+
+		memset(pixels.data(), uint8_t(n), size_t(info.size));
+		CHECK(writer.publish(info, pixels.data()));
+	}
+
+	FrameInfo oversized = {};
+	oversized.size = SlotCapacity + 1;
+
+	CHECK(!writer.publish(oversized, pixels.data()));
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+	writer.close();
+
+	for (const auto pid : readers)
+	{
+		int status = 0;
+
+		CHECK(waitpid(pid, &status, 0) == pid);
+		CHECK(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+	}
+
+	Reader late;
+
+	CHECK(!late.open(MappingName));
+
+	return 0;
+}